@@ -24,6 +24,7 @@
 #include "Assignment.h"
 #include "AssignmentClient.h"
 #include "AssignmentClientMonitor.h"
+#include "playback/PlaybackServer.h"
 
 AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
     QCoreApplication(argc, argv)
@@ -96,6 +97,11 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
     const QCommandLineOption parentPIDOption(PARENT_PID_OPTION, "PID of the parent process", "parent-pid");
     parser.addOption(parentPIDOption);
 
+    const QCommandLineOption playbackManifestOption(ASSIGNMENT_PLAYBACK_MANIFEST_OPTION,
+                                                    "play the recordings of a manifest as avatars in the domain at -a, "
+                                                    "instead of taking assignments", "manifest-file");
+    parser.addOption(playbackManifestOption);
+
     if (!parser.parse(QCoreApplication::arguments())) {
         qCritical() << parser.errorText() << endl;
         parser.showHelp();
@@ -226,7 +232,13 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
 
     DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
 
-    if (numForks || minForks || maxForks) {
+    if (parser.isSet(playbackManifestOption)) {
+        QString domainServerHostname = assignmentServerHostname.isEmpty() ? "localhost" : assignmentServerHostname;
+        PlaybackServer* server = new PlaybackServer(parser.value(playbackManifestOption), domainServerHostname,
+                                                    assignmentServerPort, listenPort);
+        server->setParent(this);
+        connect(this, &QCoreApplication::aboutToQuit, server, &PlaybackServer::aboutToQuit);
+    } else if (numForks || minForks || maxForks) {
         AssignmentClientMonitor* monitor =  new AssignmentClientMonitor(numForks, minForks, maxForks,
                                                                         requestAssignmentType, assignmentPool,
                                                                         listenPort, walletUUID, assignmentServerHostname,
@@ -0,0 +1,190 @@
+//
+//  AssetMemoryCache.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetMemoryCache.h"
+
+#include <algorithm>
+#include <limits>
+
+const qint64 AssetMemoryCache::DEFAULT_MAX_SIZE = 256LL * 1024 * 1024;
+
+void FrequencySketch::resize(int expectedItems) {
+    const int MIN_WIDTH = 1024;
+    _width = MIN_WIDTH;
+    while (_width < expectedItems) {
+        _width *= 2;
+    }
+    _counters.assign(NUM_ROWS * _width, 0);
+    _additions = 0;
+    // a sample large enough that the counts of popular items saturate before they are halved
+    const int SAMPLES_PER_COUNTER = 10;
+    _sampleSize = SAMPLES_PER_COUNTER * _width;
+}
+
+int FrequencySketch::indexOf(const AssetUtils::AssetHash& hash, int row) const {
+    static const uint ROW_SEEDS[NUM_ROWS] = { 0x97cb3127, 0x3c6ef372, 0xb492b66f, 0x5bd1e995 };
+    return row * _width + (int)(qHash(hash, ROW_SEEDS[row]) & (uint)(_width - 1));
+}
+
+void FrequencySketch::increment(const AssetUtils::AssetHash& hash) {
+    if (_width == 0) {
+        return;
+    }
+    for (int row = 0; row < NUM_ROWS; ++row) {
+        uint8_t& counter = _counters[indexOf(hash, row)];
+        if (counter < MAX_COUNT) {
+            ++counter;
+        }
+    }
+    if (++_additions >= _sampleSize) {
+        age();
+    }
+}
+
+int FrequencySketch::estimate(const AssetUtils::AssetHash& hash) const {
+    if (_width == 0) {
+        return 0;
+    }
+    int count = MAX_COUNT;
+    for (int row = 0; row < NUM_ROWS; ++row) {
+        count = std::min(count, (int)_counters[indexOf(hash, row)]);
+    }
+    return count;
+}
+
+void FrequencySketch::age() {
+    for (auto& counter : _counters) {
+        counter >>= 1;
+    }
+    _additions /= 2;
+}
+
+AssetMemoryCache::AssetMemoryCache() {
+    setMaxSize(DEFAULT_MAX_SIZE);
+}
+
+void AssetMemoryCache::setMaxSize(qint64 maxSize) {
+    QMutexLocker lock(&_mutex);
+    _maxSize = maxSize;
+    while (!_lru.empty() && _size > _maxSize) {
+        auto itr = _entries.find(_lru.back());
+        _size -= itr->data.size();
+        _entries.erase(itr);
+        _lru.pop_back();
+    }
+
+    // track several times more assets than can be resident so candidates can build up a history
+    const qint64 TYPICAL_ASSET_SIZE = 256 * 1024;
+    const int TRACKED_PER_RESIDENT = 4;
+    _sketch.resize((int)std::min<qint64>(TRACKED_PER_RESIDENT * (maxSize / TYPICAL_ASSET_SIZE), 1 << 24));
+}
+
+QByteArray AssetMemoryCache::get(const AssetUtils::AssetHash& hash) {
+    QMutexLocker lock(&_mutex);
+    if (_maxSize == 0) {
+        return QByteArray();
+    }
+    _sketch.increment(hash);
+    auto itr = _entries.find(hash);
+    if (itr == _entries.end()) {
+        ++_misses;
+        return QByteArray();
+    }
+    ++_hits;
+    _lru.splice(_lru.begin(), _lru, itr->lruPosition);
+    return itr->data;
+}
+
+bool AssetMemoryCache::getSize(const AssetUtils::AssetHash& hash, qint64& size) const {
+    QMutexLocker lock(&_mutex);
+    auto itr = _entries.find(hash);
+    if (itr == _entries.end()) {
+        return false;
+    }
+    size = itr->data.size();
+    return true;
+}
+
+int AssetMemoryCache::computeVictims(const AssetUtils::AssetHash& hash, qint64 size) const {
+    // a single asset may not take over the cache, and empty assets aren't worth an entry
+    const qint64 MAX_ENTRY_FRACTION = 4;
+    const qint64 MAX_ENTRY_SIZE = std::numeric_limits<int>::max(); // QByteArray limit
+    if (size <= 0 || size > _maxSize / MAX_ENTRY_FRACTION || size > MAX_ENTRY_SIZE || _entries.contains(hash)) {
+        return -1;
+    }
+    int candidateFrequency = _sketch.estimate(hash);
+    qint64 freeSize = _maxSize - _size;
+    int numVictims = 0;
+    auto victim = _lru.rbegin();
+    while (freeSize < size) {
+        if (_sketch.estimate(*victim) >= candidateFrequency) {
+            // the candidate is not more popular than what it would replace
+            return -1;
+        }
+        freeSize += _entries.find(*victim)->data.size();
+        ++numVictims;
+        ++victim;
+    }
+    return numVictims;
+}
+
+void AssetMemoryCache::offer(const AssetUtils::AssetHash& hash, const char* data, qint64 size) {
+    {
+        QMutexLocker lock(&_mutex);
+        if (computeVictims(hash, size) < 0) {
+            return;
+        }
+    }
+
+    // copy without holding the lock, the decision is checked again below
+    QByteArray copy(data, (int)size);
+
+    QMutexLocker lock(&_mutex);
+    int numVictims = computeVictims(hash, size);
+    if (numVictims < 0) {
+        return;
+    }
+    for (int i = 0; i < numVictims; ++i) {
+        auto itr = _entries.find(_lru.back());
+        _size -= itr->data.size();
+        _entries.erase(itr);
+        _lru.pop_back();
+    }
+    _lru.push_front(hash);
+    _entries.insert(hash, { copy, _lru.begin() });
+    _size += size;
+}
+
+void AssetMemoryCache::remove(const AssetUtils::AssetHash& hash) {
+    QMutexLocker lock(&_mutex);
+    auto itr = _entries.find(hash);
+    if (itr != _entries.end()) {
+        _size -= itr->data.size();
+        _lru.erase(itr->lruPosition);
+        _entries.erase(itr);
+    }
+}
+
+void AssetMemoryCache::clear() {
+    QMutexLocker lock(&_mutex);
+    _entries.clear();
+    _lru.clear();
+    _size = 0;
+}
+
+int AssetMemoryCache::getNumEntries() const {
+    QMutexLocker lock(&_mutex);
+    return _entries.size();
+}
+
+qint64 AssetMemoryCache::getSize() const {
+    QMutexLocker lock(&_mutex);
+    return _size;
+}
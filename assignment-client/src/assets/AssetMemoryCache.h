@@ -0,0 +1,105 @@
+//
+//  AssetMemoryCache.h
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetMemoryCache_h
+#define hifi_AssetMemoryCache_h
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+
+#include <AssetUtils.h>
+
+// FrequencySketch is a count-min sketch of recent request counts with small saturating counters.
+// Every counter is halved once a sample's worth of requests have been recorded, so the estimates follow
+// what is popular now rather than what was popular at startup.
+class FrequencySketch {
+public:
+    void resize(int expectedItems);
+    void increment(const AssetUtils::AssetHash& hash);
+    int estimate(const AssetUtils::AssetHash& hash) const;
+
+private:
+    static const int NUM_ROWS = 4;
+    static const uint8_t MAX_COUNT = 15;
+
+    int indexOf(const AssetUtils::AssetHash& hash, int row) const;
+    void age();
+
+    std::vector<uint8_t> _counters; // NUM_ROWS rows of _width counters
+    int _width { 0 };
+    int _additions { 0 };
+    int _sampleSize { 0 };
+};
+
+// AssetMemoryCache keeps the content of the most requested assets in memory, keyed by hash.
+// Admission follows TinyLFU: on a miss the asset is only let in if it has been requested more often recently
+// than every entry it would push out, so a burst of one-off downloads can't flush the assets everyone wants.
+// Residents are evicted in LRU order.
+class AssetMemoryCache {
+public:
+    static const qint64 DEFAULT_MAX_SIZE;
+
+    AssetMemoryCache();
+
+    // a max size of zero disables the cache
+    void setMaxSize(qint64 maxSize);
+
+    // records a request for hash and returns its content, or a null QByteArray if it isn't resident
+    QByteArray get(const AssetUtils::AssetHash& hash);
+
+    // returns true and sets size if hash is resident, without counting as a request
+    bool getSize(const AssetUtils::AssetHash& hash, qint64& size) const;
+
+    // offers the content of hash after a miss, it is copied in only if the admission policy accepts it
+    void offer(const AssetUtils::AssetHash& hash, const char* data, qint64 size);
+
+    void remove(const AssetUtils::AssetHash& hash);
+    void clear();
+
+    void recordBytesServed(qint64 bytes) { _bytesServed += bytes; }
+
+    uint64_t getHits() const { return _hits; }
+    uint64_t getMisses() const { return _misses; }
+    uint64_t getBytesServed() const { return _bytesServed; }
+    int getNumEntries() const;
+    qint64 getSize() const;
+
+private:
+    class Entry {
+    public:
+        QByteArray data;
+        std::list<AssetUtils::AssetHash>::iterator lruPosition;
+    };
+
+    // returns how many LRU entries have to go to make room for hash, or -1 if it shouldn't be admitted
+    // NOTE: _mutex must be held by caller
+    int computeVictims(const AssetUtils::AssetHash& hash, qint64 size) const;
+
+    mutable QMutex _mutex;
+    QHash<AssetUtils::AssetHash, Entry> _entries;
+    std::list<AssetUtils::AssetHash> _lru; // most recently used first
+    FrequencySketch _sketch;
+    qint64 _size { 0 };
+    qint64 _maxSize { 0 };
+
+    std::atomic<uint64_t> _hits { 0 };
+    std::atomic<uint64_t> _misses { 0 };
+    std::atomic<uint64_t> _bytesServed { 0 };
+};
+
+using AssetMemoryCachePointer = std::shared_ptr<AssetMemoryCache>;
+
+#endif // hifi_AssetMemoryCache_h
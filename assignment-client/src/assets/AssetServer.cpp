@@ -12,6 +12,8 @@
 
 #include "AssetServer.h"
 
+#include <algorithm>
+#include <limits>
 #include <thread>
 #include <memory>
 
@@ -33,6 +35,7 @@
 #include <SharedUtil.h>
 #include <PathUtils.h>
 #include <image/Image.h>
+#include <shared/ContentDefinedChunker.h>
 
 #include "AssetServerLogging.h"
 #include "BakeAssetTask.h"
@@ -108,11 +111,37 @@ BakeVersion currentBakeVersionForAssetType(BakedAssetType type) {
 
 const QString ASSET_SERVER_LOGGING_TARGET_NAME = "asset-server";
 
+static qint64 estimateBakeMemory(BakedAssetType type, qint64 fileSize) {
+    // rough peak footprints of an oven process, based on the size of the original file
+    const qint64 BYTES_PER_MEGABYTE = 1024 * 1024;
+    const qint64 BASE_OVEN_MEMORY = 64 * BYTES_PER_MEGABYTE;
+    switch (type) {
+        case Model:
+            // the FBX tree, the extracted meshes, their draco encoding and every embedded texture being compressed
+            return BASE_OVEN_MEMORY + 16 * fileSize;
+        case Texture:
+            // a compressed image expands to its pixels, their mips and the compressor's working copy
+            return BASE_OVEN_MEMORY + 24 * fileSize;
+        default:
+            return BASE_OVEN_MEMORY + fileSize;
+    }
+}
+
 void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath) {
     qDebug() << "Starting bake for: " << assetPath << assetHash;
     auto it = _pendingBakes.find(assetHash);
     if (it == _pendingBakes.end()) {
-        auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath);
+        QString inputFilePath = filePath;
+        if (!QFile::exists(filePath) && _chunkStore->contains(assetHash)) {
+            inputFilePath = writeBakeInputFile(assetHash);
+            if (inputFilePath.isEmpty()) {
+                qWarning() << "Could not reassemble" << assetPath << assetHash << "for baking";
+                return;
+            }
+        }
+
+        auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, inputFilePath, _isTextureSupercompressionEnabled,
+                                                    _bakedTextureCacheDirectory);
         task->setAutoDelete(false);
         _pendingBakes[assetHash] = task;
 
@@ -120,16 +149,108 @@ void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetU
         connect(task.get(), &BakeAssetTask::bakeFailed, this, &AssetServer::handleFailedBake);
         connect(task.get(), &BakeAssetTask::bakeAborted, this, &AssetServer::handleAbortedBake);
 
-        _bakingTaskPool.start(task.get());
+        _bakeScheduler.enqueue(assetHash, estimateBakeMemory(assetTypeForFilename(assetPath), QFileInfo(inputFilePath).size()));
+        startQueuedBakes();
     } else {
         qDebug() << "Already in queue";
     }
 }
 
+void AssetServer::startQueuedBakes() {
+    AssetUtils::AssetHash hash;
+    while (_bakeScheduler.takeNext(hash)) {
+        auto it = _pendingBakes.find(hash);
+        if (it != _pendingBakes.end()) {
+            qDebug() << "Starting oven for" << hash << "-" << _bakeScheduler.getNumRunning() << "running,"
+                << _bakeScheduler.getQueueDepth() << "queued";
+            _bakingTaskPool.start(it->get());
+        } else {
+            _bakeScheduler.finished(hash);
+        }
+    }
+}
+
+void AssetServer::finishBake(const AssetUtils::AssetHash& hash) {
+    _bakeScheduler.finished(hash);
+    _pendingBakes.remove(hash);
+
+    auto it = _bakeInputDirectories.find(hash);
+    if (it != _bakeInputDirectories.end()) {
+        QDir(*it).removeRecursively();
+        _bakeInputDirectories.erase(it);
+    }
+
+    startQueuedBakes();
+}
+
+QString AssetServer::writeBakeInputFile(const AssetUtils::AssetHash& hash) {
+    QByteArray data;
+    if (!readAssetFile(hash, data)) {
+        return QString();
+    }
+
+    QDir tempDir { PathUtils::generateTemporaryDir() };
+    QFile file { tempDir.absoluteFilePath(hash) };
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size()) {
+        tempDir.removeRecursively();
+        return QString();
+    }
+    _bakeInputDirectories[hash] = tempDir.absolutePath();
+    return file.fileName();
+}
+
 QString AssetServer::getPathToAssetHash(const AssetUtils::AssetHash& assetHash) {
     return _filesDirectory.absoluteFilePath(assetHash);
 }
 
+bool AssetServer::readAssetFile(const AssetUtils::AssetHash& hash, QByteArray& data) {
+    QFile file { _filesDirectory.absoluteFilePath(hash) };
+    if (file.open(QIODevice::ReadOnly)) {
+        data = file.readAll();
+        return true;
+    }
+    qint64 size;
+    return _chunkStore->getSize(hash, size) && _chunkStore->read(hash, 0, size, data);
+}
+
+bool AssetServer::removeAssetFile(const AssetUtils::AssetHash& hash) {
+    auto filePath = _filesDirectory.absoluteFilePath(hash);
+    _mappedFileCache->remove(filePath);
+    _memoryCache->remove(hash);
+
+    // content can be in both places if chunked storage was turned off and the same file uploaded again
+    bool removedChunks = !_chunkStore->contains(hash) || _chunkStore->remove(hash);
+    bool removedFile = !QFile::exists(filePath) || QFile::remove(filePath);
+    return removedChunks && removedFile;
+}
+
+void AssetServer::migrateFilesToChunkStore() {
+    QRegExp hashFileRegex { AssetUtils::ASSET_HASH_REGEX_STRING };
+
+    int numMigrated = 0;
+    for (const auto& fileInfo : _filesDirectory.entryInfoList(QDir::Files)) {
+        auto hash = fileInfo.fileName();
+        if (!hashFileRegex.exactMatch(hash) || fileInfo.size() < ContentDefinedChunker::MIN_CHUNK_SIZE
+                || fileInfo.size() > std::numeric_limits<int>::max()) {
+            continue;
+        }
+
+        QFile file { fileInfo.absoluteFilePath() };
+        if (file.open(QIODevice::ReadOnly) && _chunkStore->add(hash, file.readAll())) {
+            file.close();
+            _mappedFileCache->remove(fileInfo.absoluteFilePath());
+            file.remove();
+            ++numMigrated;
+        } else {
+            qCWarning(asset_server) << "Could not move" << hash << "into the chunk store";
+        }
+    }
+
+    if (numMigrated > 0) {
+        qCInfo(asset_server) << "Moved" << numMigrated << "asset files into the chunk store.";
+    }
+}
+
 std::pair<AssetUtils::BakingStatus, QString> AssetServer::getAssetStatus(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash) {
     auto it = _pendingBakes.find(hash);
     if (it != _pendingBakes.end()) {
@@ -336,12 +457,22 @@ void AssetServer::aboutToFinish() {
     // remove pending transfer tasks
     _transferTaskPool.clear();
 
+    // running transfers keep the files they use mapped until they are done
+    _mappedFileCache->clear();
+    _memoryCache->clear();
+
+    // drop the bakes the scheduler never started
+    for (auto& hash : _bakeScheduler.clearQueue()) {
+        _pendingBakes.remove(hash);
+    }
+
     // abort each of our still running bake tasks, remove pending bakes that were never put on the thread pool
     auto it = _pendingBakes.begin();
     while (it != _pendingBakes.end()) {
         auto pendingRunnable =  _bakingTaskPool.tryTake(it->get());
 
         if (pendingRunnable) {
+            _bakeScheduler.finished(it.key());
             it = _pendingBakes.erase(it);
         } else {
             qDebug() << "Aborting bake for" << it.key();
@@ -375,6 +506,8 @@ void AssetServer::run() {
 }
 
 static const QString ASSET_FILES_SUBDIR = "files";
+static const QString ASSET_CHUNKS_SUBDIR = "chunks";
+static const QString BAKED_TEXTURE_CACHE_SUBDIR = "baked_texture_cache";
 
 void AssetServer::completeSetup() {
     auto nodeList = DependencyManager::get<NodeList>();
@@ -404,6 +537,18 @@ void AssetServer::completeSetup() {
                     " (" << maxBandwidth << "bits/s)";
     }
 
+    // get how many oven processes may run at once and how much memory they may use between them
+    static const QString MAX_CONCURRENT_BAKES_OPTION = "max_concurrent_bakes";
+    static const QString BAKING_MEMORY_BUDGET_OPTION = "baking_memory_budget";
+    const qint64 BYTES_PER_MEGABYTE = 1024 * 1024;
+    auto maxConcurrentBakes = assetServerObject[MAX_CONCURRENT_BAKES_OPTION].toInt(0);
+    auto bakingMemoryBudget = assetServerObject[BAKING_MEMORY_BUDGET_OPTION]
+        .toInt((int)(BakeScheduler::DEFAULT_MEMORY_BUDGET / BYTES_PER_MEGABYTE));
+    _bakeScheduler.setLimits(maxConcurrentBakes, std::max(bakingMemoryBudget, 0) * BYTES_PER_MEGABYTE);
+    _bakingTaskPool.setMaxThreadCount(_bakeScheduler.getMaxConcurrentBakes());
+    qCInfo(asset_server) << "Running up to" << _bakeScheduler.getMaxConcurrentBakes() << "bakes at once within"
+        << bakingMemoryBudget << "MB.";
+
     // get the path to the asset folder from the domain server settings
     static const QString ASSETS_PATH_OPTION = "assets_path";
     auto assetsJSONValue = assetServerObject[ASSETS_PATH_OPTION];
@@ -436,6 +581,35 @@ void AssetServer::completeSetup() {
         return;
     }
 
+    static const QString SUPERCOMPRESSED_TEXTURES_OPTION = "supercompressed_textures";
+    _isTextureSupercompressionEnabled = assetServerObject[SUPERCOMPRESSED_TEXTURES_OPTION].toBool(false);
+
+    // ovens reuse the baked textures in here instead of compressing the same image again for every model it is in,
+    // a new texture bake version starts from an empty folder and the folders of older versions are dropped
+    QString currentTextureBakeVersion = QString::number((BakeVersion)CURRENT_TEXTURE_BAKE_VERSION);
+    QDir bakedTextureCacheRoot { _resourcesDirectory.absoluteFilePath(BAKED_TEXTURE_CACHE_SUBDIR) };
+    for (auto& version : bakedTextureCacheRoot.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        if (version != currentTextureBakeVersion) {
+            QDir(bakedTextureCacheRoot.absoluteFilePath(version)).removeRecursively();
+        }
+    }
+    auto bakedTextureCachePath = BAKED_TEXTURE_CACHE_SUBDIR + "/" + currentTextureBakeVersion;
+    if (_resourcesDirectory.mkpath(bakedTextureCachePath)) {
+        _bakedTextureCacheDirectory = _resourcesDirectory.absoluteFilePath(bakedTextureCachePath);
+    } else {
+        qCWarning(asset_server) << "Unable to create the baked texture cache, textures will be baked for every model.";
+    }
+
+    // the chunk store is always loaded so chunked assets stay available if chunked storage gets turned off
+    static const QString CHUNKED_STORAGE_OPTION = "chunked_storage";
+    _isChunkedStorageEnabled = assetServerObject[CHUNKED_STORAGE_OPTION].toBool(false);
+    _chunkStore = std::make_shared<ChunkStore>(QDir(_resourcesDirectory.absoluteFilePath(ASSET_CHUNKS_SUBDIR)));
+    if (!_chunkStore->load()) {
+        qCCritical(asset_server) << "Unable to load the asset-server chunk store. Stopping assignment.";
+        setFinished(true);
+        return;
+    }
+
     // load whatever mappings we currently have from the local file
     if (loadMappingsFromFile()) {
         qCInfo(asset_server) << "Serving files from: " << _filesDirectory.path();
@@ -453,6 +627,10 @@ void AssetServer::completeSetup() {
             cleanupBakedFilesForDeletedAssets();
         }
 
+        if (_isChunkedStorageEnabled) {
+            migrateFilesToChunkStore();
+        }
+
         nodeList->addSetOfNodeTypesToNodeInterestSet({ NodeType::Agent, NodeType::EntityScriptServer });
 
         bakeAssets();
@@ -470,6 +648,24 @@ void AssetServer::completeSetup() {
         _filesizeLimit = assetsFilesizeLimit * BITS_PER_MEGABITS;
     }
 
+    // get the limits of the memory mapped file cache used to serve downloads
+    static const QString MAPPED_FILE_CACHE_SIZE_OPTION = "mapped_file_cache_size";
+    static const QString MAPPED_FILE_CACHE_MAX_FILES_OPTION = "mapped_file_cache_max_files";
+    auto mappedFileCacheSize = assetServerObject[MAPPED_FILE_CACHE_SIZE_OPTION]
+        .toInt((int)(MappedFileCache::DEFAULT_MAX_MAPPED_BYTES / BYTES_PER_MEGABYTE));
+    auto mappedFileCacheMaxFiles = assetServerObject[MAPPED_FILE_CACHE_MAX_FILES_OPTION]
+        .toInt(MappedFileCache::DEFAULT_MAX_OPEN_FILES);
+    _mappedFileCache->setLimits(mappedFileCacheSize * BYTES_PER_MEGABYTE, mappedFileCacheMaxFiles);
+    qCInfo(asset_server) << "Keeping up to" << mappedFileCacheMaxFiles << "asset files and"
+        << mappedFileCacheSize << "MB mapped for downloads.";
+
+    // get the size of the in memory cache for the most requested assets
+    static const QString MEMORY_CACHE_SIZE_OPTION = "memory_cache_size";
+    auto memoryCacheSize = assetServerObject[MEMORY_CACHE_SIZE_OPTION]
+        .toInt((int)(AssetMemoryCache::DEFAULT_MAX_SIZE / BYTES_PER_MEGABYTE));
+    _memoryCache->setMaxSize(std::max(memoryCacheSize, 0) * BYTES_PER_MEGABYTE);
+    qCInfo(asset_server) << "Keeping up to" << memoryCacheSize << "MB of the most requested assets in memory.";
+
     PathUtils::removeTemporaryApplicationDirs();
     PathUtils::removeTemporaryApplicationDirs("Oven");
 
@@ -548,9 +744,7 @@ void AssetServer::cleanupUnmappedFiles() {
             }
             if (!matched) {
                 // remove the unmapped file
-                QFile removeableFile { fileInfo.absoluteFilePath() };
-
-                if (removeableFile.remove()) {
+                if (removeAssetFile(filename)) {
                     qCDebug(asset_server) << "\tDeleted" << filename << "from asset files directory since it is unmapped.";
 
                     removeBakedPathsForDeletedAsset(filename);
@@ -560,6 +754,22 @@ void AssetServer::cleanupUnmappedFiles() {
             }
         }
     }
+
+    std::set<AssetUtils::AssetHash> mappedHashes;
+    for (auto& pair : _fileMappings) {
+        mappedHashes.insert(pair.second);
+    }
+    for (const auto& hash : _chunkStore->getHashes()) {
+        if (mappedHashes.find(hash) == mappedHashes.end()) {
+            if (removeAssetFile(hash)) {
+                qCDebug(asset_server) << "\tDeleted" << hash << "from the chunk store since it is unmapped.";
+
+                removeBakedPathsForDeletedAsset(hash);
+            } else {
+                qCDebug(asset_server) << "\tAttempt to delete unmapped chunked asset" << hash << "failed";
+            }
+        }
+    }
 }
 
 void AssetServer::cleanupBakedFilesForDeletedAssets() {
@@ -680,6 +890,9 @@ void AssetServer::handleGetMappingOperation(ReceivedMessage& message, NLPacketLi
                 }
             } else {
                 qDebug() << "Did not find baked version for: " << originalAssetHash << assetPath;
+
+                // someone is waiting on this one, bake it ahead of the rest of the queue
+                _bakeScheduler.prioritize(originalAssetHash);
             }
         }
 
@@ -864,12 +1077,21 @@ void AssetServer::handleAssetGetInfo(QSharedPointer<ReceivedMessage> message, Sh
     replyPacket->write(assetHash);
 
     QString fileName = QString(hexHash);
+    qint64 cachedSize;
+    qint64 chunkedSize;
     QFileInfo fileInfo { _filesDirectory.filePath(fileName) };
 
-    if (fileInfo.exists() && fileInfo.isReadable()) {
+    if (_memoryCache->getSize(fileName, cachedSize)) {
+        // popular assets are answered without touching the disk
+        replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
+        replyPacket->writePrimitive(cachedSize);
+    } else if (fileInfo.exists() && fileInfo.isReadable()) {
         qCDebug(asset_server) << "Opening file: " << fileInfo.filePath();
         replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
         replyPacket->writePrimitive(fileInfo.size());
+    } else if (_chunkStore->getSize(fileName, chunkedSize)) {
+        replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
+        replyPacket->writePrimitive(chunkedSize);
     } else {
         qCDebug(asset_server) << "Asset not found: " << QString(hexHash);
         replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
@@ -889,7 +1111,7 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
     }
 
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _filesDirectory, _mappedFileCache, _memoryCache, _chunkStore);
     _transferTaskPool.start(task);
 }
 
@@ -903,7 +1125,8 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
     if (canWriteToAssetServer) {
         qCDebug(asset_server) << "Starting an UploadAssetTask for upload from" << uuidStringWithoutCurlyBraces(message->getSourceID());
 
-        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit);
+        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit,
+                                        _isChunkedStorageEnabled ? _chunkStore : nullptr);
         _transferTaskPool.start(task);
     } else {
         // this is a node the domain told us is not allowed to rez entities
@@ -994,6 +1217,47 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     }
 
+    QJsonObject mappedFileCacheStats;
+    mappedFileCacheStats["1. Hits"] = (double)_mappedFileCache->getHits();
+    mappedFileCacheStats["2. Misses"] = (double)_mappedFileCache->getMisses();
+    mappedFileCacheStats["3. Open Files"] = _mappedFileCache->getNumFiles();
+    mappedFileCacheStats["4. Mapped (MB)"] = (double)_mappedFileCache->getMappedBytes() / (1024.0 * 1024.0);
+    serverStats["Mapped File Cache"] = mappedFileCacheStats;
+
+    QJsonObject memoryCacheStats;
+    auto memoryCacheHits = _memoryCache->getHits();
+    auto memoryCacheRequests = memoryCacheHits + _memoryCache->getMisses();
+    memoryCacheStats["1. Hit Rate (%)"] = memoryCacheRequests > 0 ? (100.0 * memoryCacheHits) / memoryCacheRequests : 0.0;
+    memoryCacheStats["2. Hits"] = (double)memoryCacheHits;
+    memoryCacheStats["3. Served From Memory (MB)"] = (double)_memoryCache->getBytesServed() / (1024.0 * 1024.0);
+    memoryCacheStats["4. Resident Assets"] = _memoryCache->getNumEntries();
+    memoryCacheStats["5. Resident (MB)"] = (double)_memoryCache->getSize() / (1024.0 * 1024.0);
+    serverStats["Memory Cache"] = memoryCacheStats;
+
+    QJsonObject bakingStats;
+    bakingStats["1. Queued"] = _bakeScheduler.getQueueDepth();
+    bakingStats["2. Running"] = _bakeScheduler.getNumRunning();
+    bakingStats["3. Max Concurrent"] = _bakeScheduler.getMaxConcurrentBakes();
+    bakingStats["4. Estimated Memory (MB)"] = (double)_bakeScheduler.getMemoryInUse() / (1024.0 * 1024.0);
+    bakingStats["5. Completed"] = (double)_bakeScheduler.getNumCompleted();
+    bakingStats["6. Average Bake Time (s)"] = _bakeScheduler.getAverageBakeTime();
+    bakingStats["7. Max Bake Time (s)"] = _bakeScheduler.getMaxBakeTime();
+    bakingStats["8. Average Queue Time (s)"] = _bakeScheduler.getAverageQueueTime();
+    bakingStats["9. Baked Files Already Stored"] = (double)_numSharedBakedFiles;
+    serverStats["Baking"] = bakingStats;
+
+    QJsonObject chunkStoreStats;
+    auto chunkedAssetBytes = _chunkStore ? _chunkStore->getAssetBytes() : 0;
+    auto storedChunkBytes = _chunkStore ? _chunkStore->getStoredBytes() : 0;
+    chunkStoreStats["1. Enabled"] = _isChunkedStorageEnabled;
+    chunkStoreStats["2. Assets"] = _chunkStore ? _chunkStore->getNumAssets() : 0;
+    chunkStoreStats["3. Chunks"] = _chunkStore ? _chunkStore->getNumChunks() : 0;
+    chunkStoreStats["4. Asset Size (MB)"] = (double)chunkedAssetBytes / (1024.0 * 1024.0);
+    chunkStoreStats["5. Stored Size (MB)"] = (double)storedChunkBytes / (1024.0 * 1024.0);
+    chunkStoreStats["6. Saved (%)"] = chunkedAssetBytes > 0 ?
+        100.0 * (double)(chunkedAssetBytes - storedChunkBytes) / chunkedAssetBytes : 0.0;
+    serverStats["Chunk Store"] = chunkStoreStats;
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
@@ -1203,9 +1467,7 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
         // we now have a set of hashes that are unmapped - we will delete those asset files
         for (auto& hash : hashesToCheckForDeletion) {
             // remove the unmapped file
-            QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
-
-            if (removeableFile.remove()) {
+            if (removeAssetFile(hash)) {
                 qCDebug(asset_server) << "\tDeleted" << hash << "from asset files directory since it is now unmapped.";
 
                 removeBakedPathsForDeletedAsset(hash);
@@ -1350,7 +1612,7 @@ void AssetServer::handleFailedBake(QString originalAssetHash, QString assetPath,
 
     writeMetaFile(originalAssetHash, meta);
 
-    _pendingBakes.remove(originalAssetHash);
+    finishBake(originalAssetHash);
 }
 
 void AssetServer::handleCompletedBake(QString originalAssetHash, QString originalAssetPath,
@@ -1381,8 +1643,20 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
             }
 
             // first check that we don't already have this bake file in our list
+            // (textures shared between models come out of the oven's texture cache with the same content and are only
+            // stored once)
             auto bakeFileDestination = _filesDirectory.absoluteFilePath(bakedFileHash);
-            if (!QFile::exists(bakeFileDestination)) {
+            if (QFile::exists(bakeFileDestination) || _chunkStore->contains(bakedFileHash)) {
+                ++_numSharedBakedFiles;
+            } else if (_isChunkedStorageEnabled && file.size() >= ContentDefinedChunker::MIN_CHUNK_SIZE
+                       && file.size() <= std::numeric_limits<int>::max()) {
+                if (!file.seek(0) || !_chunkStore->add(bakedFileHash, file.readAll())) {
+                    // stop handling this bake, couldn't add the bake file to the chunk store
+                    errorCompletingBake = true;
+                    errorReason = "Failed to copy baked assets to asset server";
+                    break;
+                }
+            } else {
                 // copy each to our files folder (with the hash as their filename)
                 if (!file.copy(_filesDirectory.absoluteFilePath(bakedFileHash))) {
                     // stop handling this bake, couldn't copy the bake file into our files directory
@@ -1450,14 +1724,14 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
 
     writeMetaFile(originalAssetHash, meta);
 
-    _pendingBakes.remove(originalAssetHash);
+    finishBake(originalAssetHash);
 }
 
 void AssetServer::handleAbortedBake(QString originalAssetHash, QString assetPath) {
     qDebug() << "Aborted bake:" << originalAssetHash;
 
     // for an aborted bake we don't do anything but remove the BakeAssetTask from our pending bakes
-    _pendingBakes.remove(originalAssetHash);
+    finishBake(originalAssetHash);
 }
 
 static const QString BAKE_VERSION_KEY = "bake_version";
@@ -1474,12 +1748,9 @@ std::pair<bool, AssetMeta> AssetServer::readMetaFile(AssetUtils::AssetHash hash)
 
     auto metaFileHash = it->second;
 
-    QFile metaFile(_filesDirectory.absoluteFilePath(metaFileHash));
-
-    if (metaFile.open(QIODevice::ReadOnly)) {
-        auto data = metaFile.readAll();
-        metaFile.close();
+    QByteArray data;
 
+    if (readAssetFile(metaFileHash, data)) {
         QJsonParseError error;
         auto doc = QJsonDocument::fromJson(data, &error);
 
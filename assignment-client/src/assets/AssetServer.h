@@ -18,7 +18,11 @@
 
 #include <ThreadedAssignment.h>
 
+#include "AssetMemoryCache.h"
 #include "AssetUtils.h"
+#include "BakeScheduler.h"
+#include "ChunkStore.h"
+#include "MappedFileCache.h"
 #include "ReceivedMessage.h"
 
 #include "RegisteredMetaTypes.h"
@@ -40,6 +44,7 @@ enum BakedAssetType : int {
 // need to update the function currentBakeVersionForAssetType() inside of AssetServer.cpp.
 enum class ModelBakeVersion : BakeVersion {
     Initial = INITIAL_BAKE_VERSION,
+    OptimizedMeshes,
 
     COUNT
 };
@@ -127,6 +132,18 @@ private:
 
     QString getPathToAssetHash(const AssetUtils::AssetHash& assetHash);
 
+    /// Read the whole content of an asset, from its plain file or from the chunk store
+    bool readAssetFile(const AssetUtils::AssetHash& hash, QByteArray& data);
+
+    /// Delete the content of an asset, wherever it is stored
+    bool removeAssetFile(const AssetUtils::AssetHash& hash);
+
+    /// Move plain asset files that are big enough to be chunked into the chunk store
+    void migrateFilesToChunkStore();
+
+    /// Write a chunked asset to a temporary file the oven can read, returns an empty path on failure
+    QString writeBakeInputFile(const AssetUtils::AssetHash& hash);
+
     std::pair<AssetUtils::BakingStatus, QString> getAssetStatus(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash);
 
     void bakeAssets();
@@ -136,6 +153,12 @@ private:
     bool needsToBeBaked(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& assetHash);
     void bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath);
 
+    /// Start as many queued bakes as the scheduler allows
+    void startQueuedBakes();
+
+    /// Release the scheduler slot of a bake that is done, one way or another, and start the next ones
+    void finishBake(const AssetUtils::AssetHash& hash);
+
     /// Move baked content for asset to baked directory and update baked status
     void handleCompletedBake(QString originalAssetHash, QString assetPath, QString bakedTempOutputDir,
                              QVector<QString> bakedFilePaths);
@@ -157,8 +180,23 @@ private:
     /// Task pool for handling uploads and downloads of assets
     QThreadPool _transferTaskPool;
 
+    /// Open, memory mapped asset files shared by the download tasks
+    MappedFileCachePointer _mappedFileCache { std::make_shared<MappedFileCache>() };
+
+    /// Content of the most requested assets
+    AssetMemoryCachePointer _memoryCache { std::make_shared<AssetMemoryCache>() };
+
+    /// Deduplicated chunks of asset content, new content only goes there when chunked storage is enabled
+    ChunkStorePointer _chunkStore;
+    bool _isChunkedStorageEnabled { false };
+    bool _isTextureSupercompressionEnabled { false };
+    QString _bakedTextureCacheDirectory;
+
     QHash<AssetUtils::AssetHash, std::shared_ptr<BakeAssetTask>> _pendingBakes;
     QThreadPool _bakingTaskPool;
+    BakeScheduler _bakeScheduler;
+    QHash<AssetUtils::AssetHash, QString> _bakeInputDirectories;
+    uint64_t _numSharedBakedFiles { 0 };
 
     QMutex _queuedRequestsMutex;
     bool _isQueueingRequests { true };
@@ -24,10 +24,13 @@ static const int OVEN_STATUS_CODE_ABORT { 2 };
 
 std::once_flag registerMetaTypesFlag;
 
-BakeAssetTask::BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath) :
+BakeAssetTask::BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath,
+                             bool supercompressTextures, const QString& bakedTextureCacheDir) :
     _assetHash(assetHash),
     _assetPath(assetPath),
-    _filePath(filePath)
+    _filePath(filePath),
+    _supercompressTextures(supercompressTextures),
+    _bakedTextureCacheDir(bakedTextureCacheDir)
 {
 
     std::call_once(registerMetaTypesFlag, []() {
@@ -66,6 +69,12 @@ void BakeAssetTask::run() {
         "-o", tempOutputDir,
         "-t", extension,
     };
+    if (_supercompressTextures) {
+        args << "--supercompress";
+    }
+    if (!_bakedTextureCacheDir.isEmpty()) {
+        args << "--texture-cache" << _bakedTextureCacheDir;
+    }
 
     _ovenProcess.reset(new QProcess());
 
@@ -0,0 +1,107 @@
+//
+//  BakeScheduler.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakeScheduler.h"
+
+#include <algorithm>
+
+#include <QtCore/QThread>
+
+#include <SharedUtil.h>
+
+#include "AssetServerLogging.h"
+
+const qint64 BakeScheduler::DEFAULT_MEMORY_BUDGET = 4096LL * 1024 * 1024;
+
+void BakeScheduler::setLimits(int maxConcurrentBakes, qint64 memoryBudget) {
+    if (maxConcurrentBakes <= 0) {
+        // the oven uses more than one thread for textures, so leave it some room
+        maxConcurrentBakes = std::max(QThread::idealThreadCount() / 2, 1);
+    }
+    _maxConcurrentBakes = maxConcurrentBakes;
+    _memoryBudget = memoryBudget;
+}
+
+void BakeScheduler::enqueue(const AssetUtils::AssetHash& hash, qint64 estimatedMemory) {
+    if (_queue.contains(hash) || _running.contains(hash)) {
+        return;
+    }
+    QueuedBake& bake = _queue[hash];
+    bake.estimatedMemory = estimatedMemory;
+    bake.sequence = _nextSequence++;
+    bake.queuedTime = usecTimestampNow();
+}
+
+void BakeScheduler::prioritize(const AssetUtils::AssetHash& hash) {
+    auto it = _queue.find(hash);
+    if (it != _queue.end()) {
+        ++it->priority;
+    }
+}
+
+bool BakeScheduler::takeNext(AssetUtils::AssetHash& hash) {
+    if (_running.size() >= _maxConcurrentBakes) {
+        return false;
+    }
+
+    // the most requested bake that fits in the memory left, oldest first among equals
+    auto best = _queue.end();
+    for (auto it = _queue.begin(); it != _queue.end(); ++it) {
+        bool fits = _running.empty() || _memoryInUse + it->estimatedMemory <= _memoryBudget;
+        if (fits && (best == _queue.end() || it->priority > best->priority ||
+                (it->priority == best->priority && it->sequence < best->sequence))) {
+            best = it;
+        }
+    }
+    if (best == _queue.end()) {
+        return false;
+    }
+
+    uint64_t now = usecTimestampNow();
+    hash = best.key();
+    RunningBake& running = _running[hash];
+    running.estimatedMemory = best->estimatedMemory;
+    running.startTime = now;
+    _memoryInUse += best->estimatedMemory;
+    _totalQueueTime += now - best->queuedTime;
+    ++_numStarted;
+    _queue.erase(best);
+    return true;
+}
+
+void BakeScheduler::finished(const AssetUtils::AssetHash& hash) {
+    auto it = _running.find(hash);
+    if (it == _running.end()) {
+        return;
+    }
+    uint64_t bakeTime = usecTimestampNow() - it->startTime;
+    _memoryInUse -= it->estimatedMemory;
+    _running.erase(it);
+
+    ++_numCompleted;
+    _totalBakeTime += bakeTime;
+    _maxBakeTime = std::max(_maxBakeTime, bakeTime);
+    qCDebug(asset_server) << "Bake of" << hash << "took" << (float)bakeTime / USECS_PER_SECOND << "s,"
+        << _running.size() << "running," << _queue.size() << "queued";
+}
+
+QList<AssetUtils::AssetHash> BakeScheduler::clearQueue() {
+    QList<AssetUtils::AssetHash> hashes = _queue.keys();
+    _queue.clear();
+    return hashes;
+}
+
+float BakeScheduler::getAverageBakeTime() const {
+    return _numCompleted > 0 ? (float)_totalBakeTime / (_numCompleted * USECS_PER_SECOND) : 0.0f;
+}
+
+float BakeScheduler::getAverageQueueTime() const {
+    return _numStarted > 0 ? (float)_totalQueueTime / (_numStarted * USECS_PER_SECOND) : 0.0f;
+}
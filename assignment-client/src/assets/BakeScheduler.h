@@ -0,0 +1,86 @@
+//
+//  BakeScheduler.h
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BakeScheduler_h
+#define hifi_BakeScheduler_h
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+
+#include <AssetUtils.h>
+#include <NumericalConstants.h>
+
+// BakeScheduler decides which queued bakes the asset-server starts and when.  Several oven processes may run at
+// once as long as there are free bake slots and their estimated memory fits in the budget; one bake is always
+// allowed to run so an asset bigger than the budget still gets baked eventually.  Assets that clients have asked
+// for go first, otherwise bakes start in the order they were queued.
+//
+// It only does the bookkeeping, the AssetServer owns the BakeAssetTasks.  Main assignment thread only.
+class BakeScheduler {
+public:
+    static const qint64 DEFAULT_MEMORY_BUDGET;
+
+    // a maxConcurrentBakes of zero picks a count based on the number of cores
+    void setLimits(int maxConcurrentBakes, qint64 memoryBudget);
+    int getMaxConcurrentBakes() const { return _maxConcurrentBakes; }
+
+    void enqueue(const AssetUtils::AssetHash& hash, qint64 estimatedMemory);
+
+    // raises the priority of a queued bake because a client has requested the asset
+    void prioritize(const AssetUtils::AssetHash& hash);
+
+    // removes the next bake that can start now from the queue, returns false if there is none
+    bool takeNext(AssetUtils::AssetHash& hash);
+
+    // releases the slot and memory held by a bake that was started, whether it succeeded or not
+    void finished(const AssetUtils::AssetHash& hash);
+
+    // empties the queue (started bakes are unaffected) and returns what was in it
+    QList<AssetUtils::AssetHash> clearQueue();
+
+    int getQueueDepth() const { return _queue.size(); }
+    int getNumRunning() const { return _running.size(); }
+    qint64 getMemoryInUse() const { return _memoryInUse; }
+    uint64_t getNumCompleted() const { return _numCompleted; }
+    float getAverageBakeTime() const; // seconds
+    float getMaxBakeTime() const { return (float)_maxBakeTime / USECS_PER_SECOND; }
+    float getAverageQueueTime() const; // seconds
+
+private:
+    class QueuedBake {
+    public:
+        qint64 estimatedMemory { 0 };
+        int priority { 0 };
+        uint64_t sequence { 0 };
+        uint64_t queuedTime { 0 };
+    };
+
+    class RunningBake {
+    public:
+        qint64 estimatedMemory { 0 };
+        uint64_t startTime { 0 };
+    };
+
+    QHash<AssetUtils::AssetHash, QueuedBake> _queue;
+    QHash<AssetUtils::AssetHash, RunningBake> _running;
+    uint64_t _nextSequence { 0 };
+
+    int _maxConcurrentBakes { 1 };
+    qint64 _memoryBudget { DEFAULT_MEMORY_BUDGET };
+    qint64 _memoryInUse { 0 };
+
+    uint64_t _numCompleted { 0 };
+    uint64_t _totalBakeTime { 0 };
+    uint64_t _maxBakeTime { 0 };
+    uint64_t _numStarted { 0 };
+    uint64_t _totalQueueTime { 0 };
+};
+
+#endif // hifi_BakeScheduler_h
@@ -0,0 +1,377 @@
+//
+//  ChunkStore.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ChunkStore.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QRegExp>
+#include <QtCore/QSaveFile>
+#include <QtCore/QSet>
+
+#include <shared/ContentDefinedChunker.h>
+
+#include "AssetServerLogging.h"
+
+static const QString MANIFESTS_SUBDIR = "manifests";
+static const QString CHUNKS_SUBDIR = "data";
+static const QString SIZE_KEY = "size";
+static const QString CHUNKS_KEY = "chunks";
+// about 6 GB of assets at the average chunk size
+static const int MAX_CACHED_MANIFEST_CHUNKS = 100 * 1000;
+
+ChunkStore::ChunkStore(const QDir& directory) :
+    _manifestsDirectory(directory.absoluteFilePath(MANIFESTS_SUBDIR)),
+    _chunksDirectory(directory.absoluteFilePath(CHUNKS_SUBDIR)),
+    _manifestCache(MAX_CACHED_MANIFEST_CHUNKS)
+{
+}
+
+QString ChunkStore::manifestPath(const AssetUtils::AssetHash& hash) const {
+    return _manifestsDirectory.absoluteFilePath(hash);
+}
+
+QString ChunkStore::chunkPath(const QByteArray& chunkHash) const {
+    return _chunksDirectory.absoluteFilePath(QString(chunkHash));
+}
+
+bool ChunkStore::readManifest(const AssetUtils::AssetHash& hash, Manifest& manifest, qint64& size) const {
+    QFile file { manifestPath(hash) };
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QJsonParseError error;
+    auto doc = QJsonDocument::fromJson(file.readAll(), &error);
+    if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+        qCWarning(asset_server) << "Chunk manifest for" << hash << "is malformed:" << error.errorString();
+        return false;
+    }
+
+    auto root = doc.object();
+    size = (qint64)root[SIZE_KEY].toDouble(-1);
+    auto chunks = root[CHUNKS_KEY].toArray();
+    manifest.clear();
+    manifest.reserve(chunks.size());
+    qint64 total = 0;
+    for (const auto& value : chunks) {
+        auto entry = value.toArray();
+        Chunk chunk;
+        chunk.hash = entry.at(0).toString().toUtf8();
+        chunk.size = entry.at(1).toInt(-1);
+        if (chunk.hash.size() != AssetUtils::SHA256_HASH_HEX_LENGTH || chunk.size <= 0) {
+            qCWarning(asset_server) << "Chunk manifest for" << hash << "has a malformed chunk.";
+            return false;
+        }
+        total += chunk.size;
+        manifest.push_back(chunk);
+    }
+    if (total != size) {
+        qCWarning(asset_server) << "Chunk manifest for" << hash << "does not add up to its size.";
+        return false;
+    }
+    return true;
+}
+
+bool ChunkStore::writeManifest(const AssetUtils::AssetHash& hash, const Manifest& manifest, qint64 size) const {
+    QJsonArray chunks;
+    for (const auto& chunk : manifest) {
+        chunks.append(QJsonArray { QString(chunk.hash), chunk.size });
+    }
+    QJsonObject root;
+    root[SIZE_KEY] = (double)size;
+    root[CHUNKS_KEY] = chunks;
+
+    QSaveFile file { manifestPath(hash) };
+    return file.open(QIODevice::WriteOnly) && file.write(QJsonDocument(root).toJson(QJsonDocument::Compact)) >= 0
+        && file.commit();
+}
+
+bool ChunkStore::getManifest(const AssetUtils::AssetHash& hash, Manifest& manifest, qint64& size) const {
+    {
+        QMutexLocker lock(&_mutex);
+        auto sizeIt = _assetSizes.find(hash);
+        if (sizeIt == _assetSizes.end()) {
+            return false;
+        }
+        auto cached = _manifestCache.object(hash);
+        if (cached) {
+            manifest = *cached;
+            size = *sizeIt;
+            return true;
+        }
+    }
+
+    // parse it without holding the lock, a concurrent remove makes that fail like a missing asset
+    if (!readManifest(hash, manifest, size)) {
+        return false;
+    }
+    QMutexLocker lock(&_mutex);
+    if (_assetSizes.contains(hash)) {
+        _manifestCache.insert(hash, new Manifest(manifest), std::max(manifest.size(), 1));
+    }
+    return true;
+}
+
+bool ChunkStore::load() {
+    QMutexLocker lock(&_mutex);
+    _assetSizes.clear();
+    _chunks.clear();
+    _manifestCache.clear();
+    _assetBytes = 0;
+    _storedBytes = 0;
+
+    if (!_manifestsDirectory.mkpath(".") || !_chunksDirectory.mkpath(".")) {
+        qCCritical(asset_server) << "Unable to create the chunk store directories in" << _manifestsDirectory.path();
+        return false;
+    }
+
+    QRegExp hashFileRegex { AssetUtils::ASSET_HASH_REGEX_STRING };
+
+    for (const auto& hash : _manifestsDirectory.entryList(QDir::Files)) {
+        if (!hashFileRegex.exactMatch(hash)) {
+            continue;
+        }
+        Manifest manifest;
+        qint64 size;
+        if (!readManifest(hash, manifest, size)) {
+            qCWarning(asset_server) << "Ignoring unreadable chunk manifest for" << hash;
+            continue;
+        }
+        _assetSizes[hash] = size;
+        _assetBytes += size;
+        for (const auto& chunk : manifest) {
+            auto& info = _chunks[chunk.hash];
+            info.size = chunk.size;
+            info.isStored = true;
+            ++info.refCount;
+        }
+    }
+
+    // chunks nothing references are left over from an interrupted add or remove
+    int numOrphans = 0;
+    for (const auto& fileInfo : _chunksDirectory.entryInfoList(QDir::Files)) {
+        auto it = _chunks.find(fileInfo.fileName().toUtf8());
+        if (it == _chunks.end()) {
+            QFile::remove(fileInfo.absoluteFilePath());
+            ++numOrphans;
+        } else {
+            _storedBytes += it->size;
+        }
+    }
+
+    qCInfo(asset_server) << "Chunk store has" << _assetSizes.size() << "assets in" << _chunks.size() << "chunks,"
+        << numOrphans << "unreferenced chunks removed.";
+    return true;
+}
+
+bool ChunkStore::contains(const AssetUtils::AssetHash& hash) const {
+    QMutexLocker lock(&_mutex);
+    return _assetSizes.contains(hash);
+}
+
+bool ChunkStore::getSize(const AssetUtils::AssetHash& hash, qint64& size) const {
+    QMutexLocker lock(&_mutex);
+    auto it = _assetSizes.find(hash);
+    if (it == _assetSizes.end()) {
+        return false;
+    }
+    size = *it;
+    return true;
+}
+
+QList<AssetUtils::AssetHash> ChunkStore::getHashes() const {
+    QMutexLocker lock(&_mutex);
+    return _assetSizes.keys();
+}
+
+void ChunkStore::releaseChunks(const Manifest& manifest) {
+    for (const auto& chunk : manifest) {
+        auto it = _chunks.find(chunk.hash);
+        if (it != _chunks.end() && --it->refCount <= 0) {
+            QFile::remove(chunkPath(chunk.hash));
+            if (it->isStored) {
+                _storedBytes -= it->size;
+            }
+            _chunks.erase(it);
+        }
+    }
+}
+
+bool ChunkStore::add(const AssetUtils::AssetHash& hash, const QByteArray& data) {
+    // split and hash without holding the lock
+    Manifest manifest;
+    const char* bytes = data.constData();
+    int remaining = data.size();
+    while (remaining > 0) {
+        Chunk chunk;
+        chunk.size = ContentDefinedChunker::findBoundary(bytes, remaining);
+        chunk.hash = QCryptographicHash::hash(QByteArray::fromRawData(bytes, chunk.size),
+                                              QCryptographicHash::Sha256).toHex();
+        manifest.push_back(chunk);
+        bytes += chunk.size;
+        remaining -= chunk.size;
+    }
+
+    // reserve the chunks so a concurrent remove keeps them, and find the ones no one has stored yet
+    QSet<QByteArray> toWrite;
+    {
+        QMutexLocker lock(&_mutex);
+        if (_assetSizes.contains(hash)) {
+            return true;
+        }
+        for (const auto& chunk : manifest) {
+            auto& info = _chunks[chunk.hash];
+            info.size = chunk.size;
+            ++info.refCount;
+            if (!info.isStored) {
+                toWrite.insert(chunk.hash);
+            }
+        }
+    }
+
+    // write them without the lock, a chunk being written by two adds at once gets the same content either way
+    bool success = true;
+    QSet<QByteArray> written;
+    qint64 offset = 0;
+    for (const auto& chunk : manifest) {
+        if (toWrite.contains(chunk.hash) && !written.contains(chunk.hash)) {
+            QSaveFile file { chunkPath(chunk.hash) };
+            bool wasWritten = file.open(QIODevice::WriteOnly) &&
+                file.write(data.constData() + offset, chunk.size) == chunk.size && file.commit();
+            if (!wasWritten && QFileInfo(chunkPath(chunk.hash)).size() != chunk.size) {
+                qCWarning(asset_server) << "Failed to write chunk" << chunk.hash << "of" << hash;
+                success = false;
+                break;
+            }
+            written.insert(chunk.hash);
+        }
+        offset += chunk.size;
+    }
+
+    QMutexLocker lock(&_mutex);
+    if (success) {
+        for (const auto& chunkHash : written) {
+            auto& info = _chunks[chunkHash];
+            if (!info.isStored) {
+                info.isStored = true;
+                _storedBytes += info.size;
+            }
+        }
+    }
+    if (success && _assetSizes.contains(hash)) {
+        // someone else added the same content in the meantime
+        releaseChunks(manifest);
+        return true;
+    }
+    if (!success || !writeManifest(hash, manifest, data.size())) {
+        if (success) {
+            qCWarning(asset_server) << "Failed to write chunk manifest for" << hash;
+        }
+        releaseChunks(manifest);
+        return false;
+    }
+
+    // the reservations become the manifest's references
+    _assetSizes[hash] = data.size();
+    _assetBytes += data.size();
+    _manifestCache.insert(hash, new Manifest(manifest), std::max(manifest.size(), 1));
+    return true;
+}
+
+bool ChunkStore::read(const AssetUtils::AssetHash& hash, qint64 offset, qint64 length, QByteArray& data) const {
+    Manifest manifest;
+    qint64 size;
+    if (!getManifest(hash, manifest, size)) {
+        return false;
+    }
+    if (offset < 0 || length < 0 || offset + length > size || length > std::numeric_limits<int>::max()) {
+        return false;
+    }
+
+    // a concurrent remove can take the chunk files away, that reads as a missing asset
+    data.resize((int)length);
+    char* out = data.data();
+    qint64 end = offset + length;
+    qint64 chunkStart = 0;
+    for (const auto& chunk : manifest) {
+        qint64 chunkEnd = chunkStart + chunk.size;
+        if (chunkStart >= end) {
+            break;
+        }
+        if (chunkEnd > offset) {
+            qint64 from = std::max(offset, chunkStart);
+            qint64 to = std::min(end, chunkEnd);
+            QFile file { chunkPath(chunk.hash) };
+            if (!file.open(QIODevice::ReadOnly) || !file.seek(from - chunkStart)
+                    || file.read(out + (from - offset), to - from) != to - from) {
+                qCWarning(asset_server) << "Failed to read chunk" << chunk.hash << "of" << hash;
+                return false;
+            }
+        }
+        chunkStart = chunkEnd;
+    }
+    return true;
+}
+
+bool ChunkStore::remove(const AssetUtils::AssetHash& hash) {
+    QMutexLocker lock(&_mutex);
+    auto it = _assetSizes.find(hash);
+    if (it == _assetSizes.end()) {
+        return false;
+    }
+
+    Manifest manifest;
+    auto cached = _manifestCache.object(hash);
+    qint64 size;
+    bool hasManifest = cached ? true : readManifest(hash, manifest, size);
+    if (cached) {
+        manifest = *cached;
+    }
+    if (!QFile::remove(manifestPath(hash))) {
+        return false;
+    }
+
+    _assetBytes -= *it;
+    _assetSizes.erase(it);
+    _manifestCache.remove(hash);
+
+    if (hasManifest) {
+        releaseChunks(manifest);
+    }
+    return true;
+}
+
+int ChunkStore::getNumAssets() const {
+    QMutexLocker lock(&_mutex);
+    return _assetSizes.size();
+}
+
+int ChunkStore::getNumChunks() const {
+    QMutexLocker lock(&_mutex);
+    return _chunks.size();
+}
+
+qint64 ChunkStore::getAssetBytes() const {
+    QMutexLocker lock(&_mutex);
+    return _assetBytes;
+}
+
+qint64 ChunkStore::getStoredBytes() const {
+    QMutexLocker lock(&_mutex);
+    return _storedBytes;
+}
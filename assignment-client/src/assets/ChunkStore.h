@@ -0,0 +1,98 @@
+//
+//  ChunkStore.h
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ChunkStore_h
+#define hifi_ChunkStore_h
+
+#include <memory>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QCache>
+#include <QtCore/QDir>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QVector>
+
+#include <AssetUtils.h>
+
+// ChunkStore keeps asset content split into content-defined chunks (see ContentDefinedChunker), each stored once
+// under the hash of its content, plus a manifest per asset listing its chunks.  An edit only changes the chunks
+// around it, so near-identical uploads (a re-exported FBX, a texture revision) share most of their storage.
+//
+// Chunk reference counts are rebuilt from the manifests on load, so a crash can at worst leave unreferenced
+// chunks behind, and those are deleted by the next load.
+//
+// All methods are thread-safe.  Chunks are hashed and written without holding the lock, an add only takes it to
+// reserve its chunks and to publish its manifest.
+class ChunkStore {
+public:
+    ChunkStore(const QDir& directory);
+
+    bool load();
+
+    bool contains(const AssetUtils::AssetHash& hash) const;
+    bool getSize(const AssetUtils::AssetHash& hash, qint64& size) const;
+    QList<AssetUtils::AssetHash> getHashes() const;
+
+    // stores data as hash, only the chunks that aren't already stored are written
+    bool add(const AssetUtils::AssetHash& hash, const QByteArray& data);
+
+    // reassembles length bytes of hash starting at offset
+    bool read(const AssetUtils::AssetHash& hash, qint64 offset, qint64 length, QByteArray& data) const;
+
+    // drops the manifest of hash and deletes the chunks nothing else references
+    bool remove(const AssetUtils::AssetHash& hash);
+
+    int getNumAssets() const;
+    int getNumChunks() const;
+    qint64 getAssetBytes() const; // what the assets would take as plain files
+    qint64 getStoredBytes() const; // what their chunks take
+
+private:
+    class Chunk {
+    public:
+        QByteArray hash;
+        int size { 0 };
+    };
+    using Manifest = QVector<Chunk>;
+
+    class ChunkInfo {
+    public:
+        int size { 0 };
+        int refCount { 0 }; // includes the adds that are still writing their chunks
+        bool isStored { false };
+    };
+
+    QString manifestPath(const AssetUtils::AssetHash& hash) const;
+    QString chunkPath(const QByteArray& chunkHash) const;
+    bool readManifest(const AssetUtils::AssetHash& hash, Manifest& manifest, qint64& size) const;
+    bool writeManifest(const AssetUtils::AssetHash& hash, const Manifest& manifest, qint64 size) const;
+    bool getManifest(const AssetUtils::AssetHash& hash, Manifest& manifest, qint64& size) const;
+
+    // NOTE: _mutex must be held by caller
+    void releaseChunks(const Manifest& manifest);
+
+    QDir _manifestsDirectory;
+    QDir _chunksDirectory;
+
+    mutable QMutex _mutex;
+    QHash<AssetUtils::AssetHash, qint64> _assetSizes;
+    QHash<QByteArray, ChunkInfo> _chunks;
+    qint64 _assetBytes { 0 };
+    qint64 _storedBytes { 0 };
+
+    // parsed manifests of recently read or added assets, the cost is their number of chunks
+    mutable QCache<AssetUtils::AssetHash, Manifest> _manifestCache;
+};
+
+using ChunkStorePointer = std::shared_ptr<ChunkStore>;
+
+#endif // hifi_ChunkStore_h
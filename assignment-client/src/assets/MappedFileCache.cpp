@@ -0,0 +1,121 @@
+//
+//  MappedFileCache.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MappedFileCache.h"
+
+#include "AssetServerLogging.h"
+
+const qint64 MappedFileCache::DEFAULT_MAX_MAPPED_BYTES = 1024LL * 1024 * 1024;
+const int MappedFileCache::DEFAULT_MAX_OPEN_FILES = 512;
+
+MappedFile::MappedFile(const QString& filePath) :
+    _file(filePath)
+{
+    if (!_file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    _size = _file.size();
+    if (_size == 0) {
+        // nothing to map, but an empty asset is still a valid asset
+        _isValid = true;
+        return;
+    }
+    // the file stays open since closing a QFile unmaps it
+    _data = _file.map(0, _size);
+    if (_data) {
+        _isValid = true;
+    } else {
+        qCWarning(asset_server) << "Could not map" << filePath << ":" << _file.errorString();
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (_data) {
+        _file.unmap(_data);
+    }
+}
+
+void MappedFileCache::setLimits(qint64 maxMappedBytes, int maxOpenFiles) {
+    QMutexLocker lock(&_mutex);
+    _maxMappedBytes = maxMappedBytes;
+    _maxOpenFiles = maxOpenFiles;
+    evict();
+}
+
+MappedFilePointer MappedFileCache::get(const QString& filePath) {
+    {
+        QMutexLocker lock(&_mutex);
+        auto itr = _entries.find(filePath);
+        if (itr != _entries.end()) {
+            _lru.splice(_lru.begin(), _lru, itr->lruPosition);
+            ++_hits;
+            return itr->file;
+        }
+    }
+    ++_misses;
+
+    // open and map without holding the lock so other transfers aren't held up by the disk
+    auto file = std::make_shared<MappedFile>(filePath);
+    if (!file->isValid()) {
+        return nullptr;
+    }
+
+    QMutexLocker lock(&_mutex);
+    auto itr = _entries.find(filePath);
+    if (itr != _entries.end()) {
+        // another transfer mapped it first
+        return itr->file;
+    }
+    if (file->size() > _maxMappedBytes / 2) {
+        // too big to be worth keeping, the caller holds the only reference
+        return file;
+    }
+    _lru.push_front(filePath);
+    _entries.insert(filePath, { file, _lru.begin() });
+    _mappedBytes += file->size();
+    evict();
+    return file;
+}
+
+void MappedFileCache::remove(const QString& filePath) {
+    QMutexLocker lock(&_mutex);
+    auto itr = _entries.find(filePath);
+    if (itr != _entries.end()) {
+        _mappedBytes -= itr->file->size();
+        _lru.erase(itr->lruPosition);
+        _entries.erase(itr);
+    }
+}
+
+void MappedFileCache::clear() {
+    QMutexLocker lock(&_mutex);
+    _entries.clear();
+    _lru.clear();
+    _mappedBytes = 0;
+}
+
+int MappedFileCache::getNumFiles() const {
+    QMutexLocker lock(&_mutex);
+    return _entries.size();
+}
+
+qint64 MappedFileCache::getMappedBytes() const {
+    QMutexLocker lock(&_mutex);
+    return _mappedBytes;
+}
+
+void MappedFileCache::evict() {
+    while (!_lru.empty() && (_mappedBytes > _maxMappedBytes || _entries.size() > _maxOpenFiles)) {
+        auto itr = _entries.find(_lru.back());
+        _mappedBytes -= itr->file->size();
+        _entries.erase(itr);
+        _lru.pop_back();
+    }
+}
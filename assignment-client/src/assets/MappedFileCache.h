@@ -0,0 +1,90 @@
+//
+//  MappedFileCache.h
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MappedFileCache_h
+#define hifi_MappedFileCache_h
+
+#include <atomic>
+#include <list>
+#include <memory>
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+// MappedFile keeps an asset file open and memory mapped for as long as it is referenced.
+// Asset files are named by the hash of their content and never modified in place, so a mapping stays valid
+// until the file is deleted.
+class MappedFile {
+public:
+    MappedFile(const QString& filePath);
+    ~MappedFile();
+
+    bool isValid() const { return _isValid; }
+    const char* data() const { return reinterpret_cast<const char*>(_data); }
+    qint64 size() const { return _size; }
+
+private:
+    QFile _file;
+    uchar* _data { nullptr };
+    qint64 _size { 0 };
+    bool _isValid { false };
+};
+
+using MappedFilePointer = std::shared_ptr<MappedFile>;
+
+// MappedFileCache is an LRU of MappedFiles bounded by total mapped bytes and number of open files, shared by the
+// asset-server transfer tasks so popular assets are served straight from the page cache without re-opening or
+// reading them for every request.  Evicted files stay mapped until the last task using them lets go.
+class MappedFileCache {
+public:
+    static const qint64 DEFAULT_MAX_MAPPED_BYTES;
+    static const int DEFAULT_MAX_OPEN_FILES;
+
+    void setLimits(qint64 maxMappedBytes, int maxOpenFiles);
+
+    // returns the mapped file at filePath or nullptr if it can't be opened, thread-safe
+    MappedFilePointer get(const QString& filePath);
+
+    // drops filePath from the cache, call before deleting or replacing the file
+    void remove(const QString& filePath);
+
+    void clear();
+
+    uint64_t getHits() const { return _hits; }
+    uint64_t getMisses() const { return _misses; }
+    int getNumFiles() const;
+    qint64 getMappedBytes() const;
+
+private:
+    class Entry {
+    public:
+        MappedFilePointer file;
+        std::list<QString>::iterator lruPosition;
+    };
+
+    // NOTE: _mutex must be held by caller
+    void evict();
+
+    mutable QMutex _mutex;
+    QHash<QString, Entry> _entries;
+    std::list<QString> _lru; // most recently used first
+    qint64 _mappedBytes { 0 };
+    qint64 _maxMappedBytes { DEFAULT_MAX_MAPPED_BYTES };
+    int _maxOpenFiles { DEFAULT_MAX_OPEN_FILES };
+
+    std::atomic<uint64_t> _hits { 0 };
+    std::atomic<uint64_t> _misses { 0 };
+};
+
+using MappedFileCachePointer = std::shared_ptr<MappedFileCache>;
+
+#endif // hifi_MappedFileCache_h
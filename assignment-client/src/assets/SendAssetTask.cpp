@@ -13,8 +13,6 @@
 
 #include <cmath>
 
-#include <QFile>
-
 #include <DependencyManager.h>
 #include <NetworkLogging.h>
 #include <NLPacket.h>
@@ -26,11 +24,16 @@
 #include "ByteRange.h"
 #include "ClientServerUtils.h"
 
-SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir) :
+SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir,
+                             MappedFileCachePointer mappedFileCache, AssetMemoryCachePointer memoryCache,
+                             ChunkStorePointer chunkStore) :
     QRunnable(),
     _message(message),
     _senderNode(sendToNode),
-    _resourcesDir(resourcesDir)
+    _resourcesDir(resourcesDir),
+    _mappedFileCache(mappedFileCache),
+    _memoryCache(memoryCache),
+    _chunkStore(chunkStore)
 {
     
 }
@@ -60,21 +63,40 @@ void SendAssetTask::run() {
 
     replyPacketList->writePrimitive(messageID);
 
+    MappedFilePointer file;
+    QByteArray chunkedData;
+    qint64 chunkedSize = 0;
     if (!byteRange.isValid()) {
         replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
     } else {
         QString filePath = _resourcesDir.filePath(QString(hexHash));
-        
-        QFile file { filePath };
 
-        if (file.open(QIODevice::ReadOnly)) {
+        // popular assets are served from memory, everything else from the mapped file,
+        // which is shared with other transfers through the cache and stays mapped while we hold it,
+        // or reassembled from the chunk store for chunked assets
+        QByteArray cachedData = _memoryCache->get(hexHash);
+        const char* fileData = cachedData.constData();
+        qint64 fileSize = cachedData.size();
+        bool isChunked = false;
+        if (cachedData.isNull()) {
+            file = _mappedFileCache->get(filePath);
+            if (file) {
+                fileData = file->data();
+                fileSize = file->size();
+            } else if (_chunkStore && _chunkStore->getSize(hexHash, chunkedSize)) {
+                isChunked = true;
+                fileSize = chunkedSize;
+            }
+        }
+
+        if (!cachedData.isNull() || file || isChunked) {
 
             // first fixup the range based on the now known file size
-            byteRange.fixupRange(file.size());
+            byteRange.fixupRange(fileSize);
 
             // check if we're being asked to read data that we just don't have
             // because of the file size
-            if (file.size() < byteRange.fromInclusive || file.size() < byteRange.toExclusive) {
+            if (fileSize < byteRange.fromInclusive || fileSize < byteRange.toExclusive) {
                 replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
                 qCDebug(networking) << "Bad byte range: " << hexHash << " "
                     << byteRange.fromInclusive << ":" << byteRange.toExclusive;
@@ -82,29 +104,29 @@ void SendAssetTask::run() {
                 // we have a valid byte range, handle it and send the asset
                 auto size = byteRange.size();
 
-                if (byteRange.fromInclusive >= 0) {
+                auto offset = byteRange.offset(fileSize);
 
-                    // this range is positive, meaning we just need to seek into the file and then read from there
-                    file.seek(byteRange.fromInclusive);
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
-                    replyPacketList->write(file.read(size));
+                // only the chunks covering the range are read
+                if (isChunked && !_chunkStore->read(hexHash, offset, size, chunkedData)) {
+                    qCDebug(networking) << "Failed to reassemble chunked asset: " << hexHash;
+                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
                 } else {
-                    // this range is negative, at least the first part of the read will be back into the end of the file
-
-                    // seek to the part of the file where the negative range begins
-                    file.seek(file.size() + byteRange.fromInclusive);
+                    const char* rangeData = isChunked ? chunkedData.constData() : fileData + offset;
 
                     replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
                     replyPacketList->writePrimitive(size);
 
-                    // first write everything from the negative range to the end of the file
-                    replyPacketList->write(file.read(size));
-                }
+                    // the packets are filled straight from the cached or mapped data, without an intermediate read buffer
+                    if (size > 0) {
+                        replyPacketList->write(rangeData, size);
+                    }
+                    if (!cachedData.isNull()) {
+                        _memoryCache->recordBytesServed(size);
+                    }
 
-                qCDebug(networking) << "Sending asset: " << hexHash;
+                    qCDebug(networking) << "Sending asset: " << hexHash;
+                }
             }
-            file.close();
         } else {
             qCDebug(networking) << "Asset not found: " << filePath << "(" << hexHash << ")";
             replyPacketList->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
@@ -117,4 +139,12 @@ void SendAssetTask::run() {
     } else {
         nodeList->sendPacketList(std::move(replyPacketList), _message->getSenderSockAddr());
     }
+
+    if (file) {
+        // this was a miss, once the reply is on its way let the memory cache decide whether to keep the asset
+        _memoryCache->offer(hexHash, file->data(), file->size());
+    } else if (chunkedSize > 0 && chunkedData.size() == chunkedSize) {
+        // saves reassembling it the next time
+        _memoryCache->offer(hexHash, chunkedData.constData(), chunkedSize);
+    }
 }
@@ -18,14 +18,18 @@
 #include <QtCore/QRunnable>
 
 #include "AssetUtils.h"
+#include "AssetMemoryCache.h"
 #include "AssetServer.h"
+#include "ChunkStore.h"
+#include "MappedFileCache.h"
 #include "Node.h"
 
 class NLPacket;
 
 class SendAssetTask : public QRunnable {
 public:
-    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir);
+    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir,
+                  MappedFileCachePointer mappedFileCache, AssetMemoryCachePointer memoryCache, ChunkStorePointer chunkStore);
 
     void run() override;
 
@@ -33,6 +37,9 @@ private:
     QSharedPointer<ReceivedMessage> _message;
     SharedNodePointer _senderNode;
     QDir _resourcesDir;
+    MappedFileCachePointer _mappedFileCache;
+    AssetMemoryCachePointer _memoryCache;
+    ChunkStorePointer _chunkStore;
 };
 
 #endif
@@ -17,15 +17,17 @@
 #include <AssetUtils.h>
 #include <NodeList.h>
 #include <NLPacketList.h>
+#include <shared/ContentDefinedChunker.h>
 
 #include "ClientServerUtils.h"
 
 UploadAssetTask::UploadAssetTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
-                                 const QDir& resourcesDir, uint64_t filesizeLimit) :
+                                 const QDir& resourcesDir, uint64_t filesizeLimit, ChunkStorePointer chunkStore) :
     _receivedMessage(receivedMessage),
     _senderNode(senderNode),
     _resourcesDir(resourcesDir),
-    _filesizeLimit(filesizeLimit)
+    _filesizeLimit(filesizeLimit),
+    _chunkStore(chunkStore)
 {
     
 }
@@ -68,8 +70,20 @@ void UploadAssetTask::run() {
         QFile file { _resourcesDir.filePath(QString(hexHash)) };
 
         bool existingCorrectFile = false;
+        bool isChunked = _chunkStore &&
+            (_chunkStore->contains(QString(hexHash)) || fileData.size() >= ContentDefinedChunker::MIN_CHUNK_SIZE);
         
-        if (file.exists()) {
+        if (isChunked) {
+            // only the chunks that aren't already stored get written
+            if (_chunkStore->add(QString(hexHash), fileData)) {
+                qDebug() << "Stored file" << hexHash << "in the chunk store. Upload complete";
+                replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
+                replyPacket->write(hash);
+            } else {
+                qWarning() << "Failed to store" << hexHash << "in the chunk store - upload failed.";
+                replyPacket->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
+            }
+        } else if (file.exists()) {
             // check if the local file has the correct contents, otherwise we overwrite
             if (file.open(QIODevice::ReadOnly) && AssetUtils::hashData(file.readAll()) == hash) {
                 qDebug() << "Not overwriting existing verified file: " << hexHash;
@@ -84,7 +98,7 @@ void UploadAssetTask::run() {
             }
         }
 
-        if (!existingCorrectFile) {
+        if (!existingCorrectFile && !isChunked) {
             if (file.open(QIODevice::WriteOnly) && file.write(fileData) == qint64(fileSize)) {
                 qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
                 file.close();
@@ -21,13 +21,15 @@
 
 #include "ReceivedMessage.h"
 
+#include "ChunkStore.h"
+
 class NLPacketList;
 class Node;
 
 class UploadAssetTask : public QRunnable {
 public:
     UploadAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, 
-                    const QDir& resourcesDir, uint64_t filesizeLimit);
+                    const QDir& resourcesDir, uint64_t filesizeLimit, ChunkStorePointer chunkStore = nullptr);
 
     void run() override;
 
@@ -36,6 +38,7 @@ private:
     QSharedPointer<Node> _senderNode;
     QDir _resourcesDir;
     uint64_t _filesizeLimit;
+    ChunkStorePointer _chunkStore;
 };
 
 #endif // hifi_UploadAssetTask_h
@@ -324,6 +324,25 @@ void EntityServer::readAdditionalConfiguration(const QJsonObject& settingsSectio
 
     startDynamicDomainVerification();
 
+    bool noSharedViewVisibility = false;
+    readOptionBool(QString("NoSharedViewVisibility"), settingsSectionObject, noSharedViewVisibility);
+    if (noSharedViewVisibility) {
+        _viewVisibilityCache.reset();
+    } else {
+        int positionQuantumCentimeters;
+        if (readOptionInt("sharedViewPositionQuantum", settingsSectionObject, positionQuantumCentimeters)) {
+            const float METERS_PER_CENTIMETER = 0.01f;
+            _viewVisibilityCache->setQuanta(positionQuantumCentimeters * METERS_PER_CENTIMETER,
+                ViewVisibilityCache::DEFAULT_ORIENTATION_QUANTUM);
+        }
+    }
+    qDebug("sharedViewVisibility=%s", debug::valueOf(!noSharedViewVisibility));
+
+    readOptionInt("maxEditsPerSecondPerEntity", settingsSectionObject, _maxEditsPerSecondPerItem);
+    readOptionInt("maxEditsPerSecondPerSender", settingsSectionObject, _maxEditsPerSecondPerSender);
+    qDebug("maxEditsPerSecondPerEntity=%d maxEditsPerSecondPerSender=%d",
+        _maxEditsPerSecondPerItem, _maxEditsPerSecondPerSender);
+
     tree->setWantEditLogging(wantEditLogging);
     tree->setWantTerseEditLogging(wantTerseEditLogging);
 
@@ -397,6 +416,27 @@ QString EntityServer::serverSubclassStats() {
     statsString += QString().sprintf("       EntityItem size... %ld bytes\r\n", sizeof(EntityItem));
     statsString += "\r\n\r\n";
 
+    if (_viewVisibilityCache) {
+        uint64_t hits = _viewVisibilityCache->getHits();
+        uint64_t misses = _viewVisibilityCache->getMisses();
+        statsString += "<b>Entity Server Shared View Visibility Statistics</b>\r\n";
+        statsString += QString("     Shared views... %1\r\n").arg(locale.toString((uint)_viewVisibilityCache->getNumEntries()));
+        statsString += QString("  Element lookups... %1 hits / %2 misses\r\n")
+            .arg(locale.toString((qulonglong)hits)).arg(locale.toString((qulonglong)misses));
+        statsString += "\r\n\r\n";
+    }
+
+    if (_octreeInboundPacketProcessor) {
+        statsString += "<b>Entity Server Edit Batching Statistics</b>\r\n";
+        statsString += QString("       Edits merged... %1\r\n")
+            .arg(locale.toString((qulonglong)_octreeInboundPacketProcessor->getTotalEditsMerged()));
+        statsString += QString(" Edits rate limited... %1\r\n")
+            .arg(locale.toString((qulonglong)_octreeInboundPacketProcessor->getTotalEditsRateLimited()));
+        statsString += QString("   Edits held back... %1\r\n")
+            .arg(locale.toString((uint)_octreeInboundPacketProcessor->getDeferredEditsCount()));
+        statsString += "\r\n\r\n";
+    }
+
     statsString += "<b>Entity Server Sending to Viewer Statistics</b>\r\n";
     statsString += "----- Viewer Node ID -----------------    ----- Entity ID ----------------------    "
                    "---------- Last Sent To ----------    ---------- Last Edited -----------\r\n";
@@ -19,6 +19,7 @@
 #include "EntityItem.h"
 #include "EntityServerConsts.h"
 #include "EntityTree.h"
+#include "ViewVisibilityCache.h"
 
 /// Handles assignments of type EntityServer - sending entities to various clients.
 
@@ -60,6 +61,9 @@ public:
 
     virtual void aboutToFinish() override;
 
+    // null when sharing of element visibility between send threads is disabled
+    ViewVisibilityCachePointer getViewVisibilityCache() const { return _viewVisibilityCache; }
+
 public slots:
     virtual void nodeAdded(SharedNodePointer node) override;
     virtual void nodeKilled(SharedNodePointer node) override;
@@ -78,6 +82,8 @@ private:
     SimpleEntitySimulationPointer _entitySimulation;
     QTimer* _pruneDeletedEntitiesTimer = nullptr;
 
+    ViewVisibilityCachePointer _viewVisibilityCache { std::make_shared<ViewVisibilityCache>() };
+
     QReadWriteLock _viewerSendingStatsLock;
     QMap<QUuid, QMap<QUuid, ViewerSendingStats>> _viewerSendingStats;
 
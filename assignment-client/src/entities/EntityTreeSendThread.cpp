@@ -14,6 +14,7 @@
 #include <EntityNodeData.h>
 #include <EntityTypes.h>
 #include <OctreeUtils.h>
+#include <TBBHelpers.h>
 
 #include "EntityServer.h"
 
@@ -24,6 +25,9 @@ EntityTreeSendThread::EntityTreeSendThread(OctreeServer* myServer, const SharedN
     connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::editingEntityPointer, this, &EntityTreeSendThread::editingEntityPointer, Qt::QueuedConnection);
     connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::deletingEntityPointer, this, &EntityTreeSendThread::deletingEntityPointer, Qt::QueuedConnection);
 
+    // share element visibility with the send threads of other clients that have a near-identical view
+    _traversal.setVisibilityCache(static_cast<EntityServer*>(myServer)->getViewVisibilityCache());
+
     // connect to connection ID change on EntityNodeData so we can clear state for this receiver
     auto nodeData = static_cast<EntityNodeData*>(node->getLinkedData());
     connect(nodeData, &EntityNodeData::incomingConnectionIDChanged, this, &EntityTreeSendThread::resetState);
@@ -230,6 +234,9 @@ void EntityTreeSendThread::startNewTraversal(const ViewFrustum& view, EntityTree
     // The _conicalView is updated here as a cached view approximation used by the lambdas for efficient
     // computation of entity sorting priorities.
     //
+    // Each scanCallback hands queueElementEntities() an EntityPrioritizer which may be evaluated
+    // concurrently on the TBB pool, so the prioritizers must only read shared state.
+    //
     _conicalView.set(_traversal.getCurrentView());
 
     switch (type) {
@@ -240,11 +247,7 @@ void EntityTreeSendThread::startNewTraversal(const ViewFrustum& view, EntityTree
                 float lodScaleFactor = _traversal.getCurrentLODScaleFactor();
                 glm::vec3 viewPosition = _traversal.getCurrentView().getPosition();
                 _traversal.setScanCallback([=](DiffTraversal::VisibleElement& next) {
-                    next.element->forEachEntity([=](EntityItemPointer entity) {
-                        // Bail early if we've already checked this entity this frame
-                        if (_entitiesInQueue.find(entity.get()) != _entitiesInQueue.end()) {
-                            return;
-                        }
+                    queueElementEntities(next.element, [=](const EntityItemPointer& entity, float& priority) {
                         bool success = false;
                         AACube cube = entity->getQueryAACube(success);
                         if (success) {
@@ -256,26 +259,21 @@ void EntityTreeSendThread::startNewTraversal(const ViewFrustum& view, EntityTree
                                 float distance = glm::distance(cube.calcCenter(), viewPosition) + MIN_VISIBLE_DISTANCE;
                                 float angularDiameter = cube.getScale() / distance;
                                 if (angularDiameter > MIN_ENTITY_ANGULAR_DIAMETER * lodScaleFactor) {
-                                    float priority = _conicalView.computePriority(cube);
-                                    _sendQueue.push(PrioritizedEntity(entity, priority));
-                                    _entitiesInQueue.insert(entity.get());
+                                    priority = _conicalView.computePriority(cube);
+                                    return true;
                                 }
                             }
-                        } else {
-                            _sendQueue.push(PrioritizedEntity(entity, PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY));
-                            _entitiesInQueue.insert(entity.get());
+                            return false;
                         }
+                        priority = PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY;
+                        return true;
                     });
                 });
             } else {
                 _traversal.setScanCallback([this](DiffTraversal::VisibleElement& next) {
-                    next.element->forEachEntity([this](EntityItemPointer entity) {
-                        // Bail early if we've already checked this entity this frame
-                        if (_entitiesInQueue.find(entity.get()) != _entitiesInQueue.end()) {
-                            return;
-                        }
-                        _sendQueue.push(PrioritizedEntity(entity, PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY));
-                        _entitiesInQueue.insert(entity.get());
+                    queueElementEntities(next.element, [](const EntityItemPointer& entity, float& priority) {
+                        priority = PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY;
+                        return true;
                     });
                 });
             }
@@ -287,37 +285,34 @@ void EntityTreeSendThread::startNewTraversal(const ViewFrustum& view, EntityTree
                 _traversal.setScanCallback([=](DiffTraversal::VisibleElement& next) {
                     uint64_t startOfCompletedTraversal = _traversal.getStartOfCompletedTraversal();
                     if (next.element->getLastChangedContent() > startOfCompletedTraversal) {
-                        next.element->forEachEntity([=](EntityItemPointer entity) {
-                            // Bail early if we've already checked this entity this frame
-                            if (_entitiesInQueue.find(entity.get()) != _entitiesInQueue.end()) {
-                                return;
-                            }
+                        ViewFrustum::intersection elementIntersection = next.intersection;
+                        queueElementEntities(next.element, [=](const EntityItemPointer& entity, float& priority) {
                             auto knownTimestamp = _knownState.find(entity.get());
                             if (knownTimestamp == _knownState.end()) {
                                 bool success = false;
                                 AACube cube = entity->getQueryAACube(success);
                                 if (success) {
-                                    if (next.intersection == ViewFrustum::INSIDE || _traversal.getCurrentView().cubeIntersectsKeyhole(cube)) {
+                                    if (elementIntersection == ViewFrustum::INSIDE || _traversal.getCurrentView().cubeIntersectsKeyhole(cube)) {
                                         // See the DiffTraversal::First case for an explanation of the "entity is too small" check
                                         float distance = glm::distance(cube.calcCenter(), viewPosition) + MIN_VISIBLE_DISTANCE;
                                         float angularDiameter = cube.getScale() / distance;
                                         if (angularDiameter > MIN_ENTITY_ANGULAR_DIAMETER * lodScaleFactor) {
-                                            float priority = _conicalView.computePriority(cube);
-                                            _sendQueue.push(PrioritizedEntity(entity, priority));
-                                            _entitiesInQueue.insert(entity.get());
+                                            priority = _conicalView.computePriority(cube);
+                                            return true;
                                         }
                                     }
-                                } else {
-                                    _sendQueue.push(PrioritizedEntity(entity, PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY));
-                                    _entitiesInQueue.insert(entity.get());
+                                    return false;
                                 }
+                                priority = PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY;
+                                return true;
                             } else if (entity->getLastEdited() > knownTimestamp->second
                                     || entity->getLastChangedOnServer() > knownTimestamp->second) {
                                 // it is known and it changed --> put it on the queue with any priority
                                 // TODO: sort these correctly
-                                _sendQueue.push(PrioritizedEntity(entity, PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY));
-                                _entitiesInQueue.insert(entity.get());
+                                priority = PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY;
+                                return true;
                             }
+                            return false;
                         });
                     }
                 });
@@ -325,18 +320,15 @@ void EntityTreeSendThread::startNewTraversal(const ViewFrustum& view, EntityTree
                 _traversal.setScanCallback([this](DiffTraversal::VisibleElement& next) {
                     uint64_t startOfCompletedTraversal = _traversal.getStartOfCompletedTraversal();
                     if (next.element->getLastChangedContent() > startOfCompletedTraversal) {
-                        next.element->forEachEntity([this](EntityItemPointer entity) {
-                            // Bail early if we've already checked this entity this frame
-                            if (_entitiesInQueue.find(entity.get()) != _entitiesInQueue.end()) {
-                                return;
-                            }
+                        queueElementEntities(next.element, [this](const EntityItemPointer& entity, float& priority) {
                             auto knownTimestamp = _knownState.find(entity.get());
                             if (knownTimestamp == _knownState.end()
                                     || entity->getLastEdited() > knownTimestamp->second
                                     || entity->getLastChangedOnServer() > knownTimestamp->second) {
-                                _sendQueue.push(PrioritizedEntity(entity, PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY));
-                                _entitiesInQueue.insert(entity.get());
+                                priority = PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY;
+                                return true;
                             }
+                            return false;
                         });
                     }
                 });
@@ -349,11 +341,7 @@ void EntityTreeSendThread::startNewTraversal(const ViewFrustum& view, EntityTree
             float completedLODScaleFactor = _traversal.getCompletedLODScaleFactor();
             glm::vec3 completedViewPosition = _traversal.getCompletedView().getPosition();
             _traversal.setScanCallback([=] (DiffTraversal::VisibleElement& next) {
-                next.element->forEachEntity([=](EntityItemPointer entity) {
-                    // Bail early if we've already checked this entity this frame
-                    if (_entitiesInQueue.find(entity.get()) != _entitiesInQueue.end()) {
-                        return;
-                    }
+                queueElementEntities(next.element, [=](const EntityItemPointer& entity, float& priority) {
                     auto knownTimestamp = _knownState.find(entity.get());
                     if (knownTimestamp == _knownState.end()) {
                         bool success = false;
@@ -365,39 +353,78 @@ void EntityTreeSendThread::startNewTraversal(const ViewFrustum& view, EntityTree
                                 float angularDiameter = cube.getScale() / distance;
                                 if (angularDiameter > MIN_ENTITY_ANGULAR_DIAMETER * lodScaleFactor) {
                                     if (!_traversal.getCompletedView().cubeIntersectsKeyhole(cube)) {
-                                        float priority = _conicalView.computePriority(cube);
-                                        _sendQueue.push(PrioritizedEntity(entity, priority));
-                                        _entitiesInQueue.insert(entity.get());
+                                        priority = _conicalView.computePriority(cube);
+                                        return true;
                                     } else {
                                         // If this entity was skipped last time because it was too small, we still need to send it
                                         distance = glm::distance(cube.calcCenter(), completedViewPosition) + MIN_VISIBLE_DISTANCE;
                                         angularDiameter = cube.getScale() / distance;
                                         if (angularDiameter <= MIN_ENTITY_ANGULAR_DIAMETER * completedLODScaleFactor) {
                                             // this object was skipped in last completed traversal
-                                            float priority = _conicalView.computePriority(cube);
-                                            _sendQueue.push(PrioritizedEntity(entity, priority));
-                                            _entitiesInQueue.insert(entity.get());
+                                            priority = _conicalView.computePriority(cube);
+                                            return true;
                                         }
                                     }
                                 }
                             }
-                        } else {
-                            _sendQueue.push(PrioritizedEntity(entity, PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY));
-                            _entitiesInQueue.insert(entity.get());
+                            return false;
                         }
+                        priority = PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY;
+                        return true;
                     } else if (entity->getLastEdited() > knownTimestamp->second
                             || entity->getLastChangedOnServer() > knownTimestamp->second) {
                         // it is known and it changed --> put it on the queue with any priority
                         // TODO: sort these correctly
-                        _sendQueue.push(PrioritizedEntity(entity, PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY));
-                        _entitiesInQueue.insert(entity.get());
+                        priority = PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY;
+                        return true;
                     }
+                    return false;
                 });
             });
             break;
     }
 }
 
+void EntityTreeSendThread::queueElementEntities(const EntityTreeElementPointer& element, const EntityPrioritizer& prioritizer) {
+    _scanCandidates.clear();
+    element->forEachEntity([&](EntityItemPointer entity) {
+        // Bail early if we've already checked this entity this frame
+        if (_entitiesInQueue.find(entity.get()) == _entitiesInQueue.end()) {
+            _scanCandidates.push_back(entity);
+        }
+    });
+
+    size_t numCandidates = _scanCandidates.size();
+    _scanPriorities.resize(numCandidates);
+    _scanAccepted.resize(numCandidates);
+    auto prioritizeRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            float priority = PrioritizedEntity::DO_NOT_SEND;
+            _scanAccepted[i] = prioritizer(_scanCandidates[i], priority);
+            _scanPriorities[i] = priority;
+        }
+    };
+
+    // crowded elements are split over the shared TBB pool, which the send threads of all clients draw from
+    const size_t MIN_ENTITIES_FOR_PARALLEL_SCAN = 64;
+    if (numCandidates >= MIN_ENTITIES_FOR_PARALLEL_SCAN) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numCandidates), [&](const tbb::blocked_range<size_t>& range) {
+            prioritizeRange(range.begin(), range.end());
+        });
+    } else {
+        prioritizeRange(0, numCandidates);
+    }
+
+    // the queue and set are owned by this thread so they are only touched serially
+    for (size_t i = 0; i < numCandidates; ++i) {
+        if (_scanAccepted[i]) {
+            _sendQueue.push(PrioritizedEntity(_scanCandidates[i], _scanPriorities[i]));
+            _entitiesInQueue.insert(_scanCandidates[i].get());
+        }
+    }
+    _scanCandidates.clear();
+}
+
 bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) {
     if (_sendQueue.empty()) {
         OctreeServer::trackEncodeTime(OctreeServer::SKIP_TIME);
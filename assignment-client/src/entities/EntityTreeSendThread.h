@@ -43,6 +43,10 @@ private:
 
     void startNewTraversal(const ViewFrustum& viewFrustum, EntityTreeElementPointer root, int32_t lodLevelOffset, 
         bool usesViewFrustum);
+
+    // returns true and sets priority if the entity should be added to the _sendQueue
+    using EntityPrioritizer = std::function<bool(const EntityItemPointer& entity, float& priority)>;
+    void queueElementEntities(const EntityTreeElementPointer& element, const EntityPrioritizer& prioritizer);
     bool traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) override;
 
     void preDistributionProcessing() override;
@@ -57,6 +61,11 @@ private:
     std::unordered_map<EntityItem*, uint64_t> _knownState;
     ConicalView _conicalView; // cached optimized view for fast priority calculations
 
+    // scratch buffers for queueElementEntities, kept to avoid reallocating per element
+    std::vector<EntityItemPointer> _scanCandidates;
+    std::vector<float> _scanPriorities;
+    std::vector<uint8_t> _scanAccepted;
+
     // packet construction stuff
     EntityTreeElementExtraEncodeDataPointer _extraEncodeData { new EntityTreeElementExtraEncodeData() };
     int32_t _numEntitiesOffset { 0 };
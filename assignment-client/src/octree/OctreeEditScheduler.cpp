@@ -0,0 +1,219 @@
+//
+//  OctreeEditScheduler.cpp
+//  assignment-client/src/octree
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeEditScheduler.h"
+
+#include <algorithm>
+
+#include <QtCore/QPair>
+#include <QtCore/QSet>
+
+#include <NumericalConstants.h>
+
+const quint64 RATE_BUCKET_EXPIRY = 10 * USECS_PER_SECOND;
+// past this many held back edits a sender's edits are applied right away instead of queueing without bound
+const int MAX_DEFERRED_EDITS_PER_SENDER = 1000;
+
+OctreeEditScheduler::Plan OctreeEditScheduler::schedule(const std::vector<Edit>& edits, const QUuid& flushSenderID,
+        quint64 now) {
+    Plan plan;
+    std::vector<bool> merged;
+    mergeSupersededEdits(edits, merged, plan);
+
+    bool rateLimited = _maxPerItem > 0 || _maxPerSender > 0;
+    if (rateLimited) {
+        pruneRateBuckets(now);
+    }
+
+    // senders whose edits skip the rate caps for the rest of this pass
+    QSet<QUuid> unlimitedSenders;
+    if (!flushSenderID.isNull()) {
+        unlimitedSenders.insert(flushSenderID);
+    }
+
+    plan.editsToApply.reserve(edits.size());
+    std::vector<size_t> heldBackEdits;
+    QSet<QPair<QUuid, QUuid>> heldBack;
+    QHash<QUuid, int> heldBackPerSender;
+
+    // a sender's held back edits go ahead of its next edit that can't wait, so its edits keep their order
+    auto flushHeldBack = [&](const QUuid& senderID) {
+        if (!heldBackPerSender.contains(senderID)) {
+            return;
+        }
+        auto itr = heldBackEdits.begin();
+        while (itr != heldBackEdits.end()) {
+            if (edits[*itr].senderID == senderID) {
+                plan.editsToApply.push_back(*itr);
+                itr = heldBackEdits.erase(itr);
+            } else {
+                ++itr;
+            }
+        }
+        auto keyItr = heldBack.begin();
+        while (keyItr != heldBack.end()) {
+            if (keyItr->first == senderID) {
+                keyItr = heldBack.erase(keyItr);
+            } else {
+                ++keyItr;
+            }
+        }
+        heldBackPerSender.remove(senderID);
+    };
+
+    for (size_t i = 0; i < edits.size(); ++i) {
+        if (merged[i]) {
+            continue;
+        }
+        const Edit& edit = edits[i];
+        if (!edit.record) {
+            // erases and other edits the tree reads itself are never held back
+            flushHeldBack(edit.senderID);
+        } else if (rateLimited && !edit.record->targetID.isNull() && !unlimitedSenders.contains(edit.senderID)) {
+            auto key = qMakePair(edit.senderID, edit.record->targetID);
+            // once an edit to an item is held back, later edits to it wait as well so they still apply in order
+            if (heldBack.contains(key) || !takeEditTokens(edit.record->targetID, edit.senderID, now)) {
+                if (heldBackPerSender.value(edit.senderID) < MAX_DEFERRED_EDITS_PER_SENDER) {
+                    heldBack.insert(key);
+                    heldBackPerSender[edit.senderID]++;
+                    heldBackEdits.push_back(i);
+                    if (!edit.counted) {
+                        plan.editsRateLimited++;
+                    }
+                    continue;
+                }
+                // this sender has too many edits waiting, stop holding them back
+                flushHeldBack(edit.senderID);
+                unlimitedSenders.insert(edit.senderID);
+            }
+        }
+        plan.editsToApply.push_back(i);
+    }
+
+    // held back edits carry the edits merged into them, which are merged again on the next pass
+    for (size_t index : heldBackEdits) {
+        std::vector<size_t> chain;
+        for (int from = plan.mergedFrom[index]; from >= 0; from = plan.mergedFrom[from]) {
+            chain.push_back((size_t)from);
+        }
+        plan.deferredEdits.insert(plan.deferredEdits.end(), chain.rbegin(), chain.rend());
+        plan.deferredEdits.push_back(index);
+    }
+    return plan;
+}
+
+void OctreeEditScheduler::applyMerged(const Plan& plan, size_t index, const std::function<bool(size_t)>& applyEdit) {
+    if (applyEdit(index) || plan.mergedFrom[index] < 0) {
+        return;
+    }
+
+    // the tree rejected or altered the edit, so the ones merged into it have to be applied after all. They go in the
+    // order they were sent and the edit goes again last, otherwise their older values would overwrite its own.
+    std::vector<size_t> chain;
+    for (int from = plan.mergedFrom[index]; from >= 0; from = plan.mergedFrom[from]) {
+        chain.push_back((size_t)from);
+    }
+    for (auto itr = chain.rbegin(); itr != chain.rend(); ++itr) {
+        applyEdit(*itr);
+    }
+    applyEdit(index);
+}
+
+void OctreeEditScheduler::mergeSupersededEdits(const std::vector<Edit>& edits, std::vector<bool>& merged, Plan& plan) {
+    merged.assign(edits.size(), false);
+    plan.mergedFrom.assign(edits.size(), -1);
+
+    // Walk backwards remembering the next edit to each item. An edit is dropped when that next edit comes from the
+    // same sender and overwrites everything it changes. The dropped edit is kept in mergedFrom so it can still be
+    // applied if the tree rejects or alters the edit that replaced it.
+    QHash<QUuid, size_t> nextEdits;
+    for (size_t i = edits.size(); i-- > 0; ) {
+        const Edit& edit = edits[i];
+        if (!edit.record) {
+            // the tree applies these itself (erases, etc) so don't merge edits across them
+            nextEdits.clear();
+            continue;
+        }
+        if (edit.record->targetID.isNull()) {
+            continue;
+        }
+        auto itr = nextEdits.find(edit.record->targetID);
+        if (itr != nextEdits.end()) {
+            const Edit& nextEdit = edits[itr.value()];
+            if (nextEdit.senderID == edit.senderID && edit.record->isSupersededBy(*nextEdit.record)) {
+                merged[i] = true;
+                plan.mergedFrom[itr.value()] = (int)i;
+                if (!edit.counted) {
+                    plan.editsMerged++;
+                }
+            }
+        }
+        nextEdits[edit.record->targetID] = i;
+    }
+}
+
+bool OctreeEditScheduler::takeEditTokens(const QUuid& itemID, const QUuid& senderID, quint64 now) {
+    // each bucket holds up to one second's worth of edits
+    auto refill = [&](RateBucket& bucket, int maxPerSecond) {
+        if (bucket.lastRefill == 0) {
+            bucket.tokens = (float)maxPerSecond;
+        } else {
+            float elapsed = (float)(now - bucket.lastRefill) / (float)USECS_PER_SECOND;
+            bucket.tokens = std::min((float)maxPerSecond, bucket.tokens + elapsed * maxPerSecond);
+        }
+        bucket.lastRefill = now;
+    };
+
+    RateBucket* itemBucket = nullptr;
+    if (_maxPerItem > 0) {
+        itemBucket = &_itemBuckets[itemID];
+        refill(*itemBucket, _maxPerItem);
+        if (itemBucket->tokens < 1.0f) {
+            return false;
+        }
+    }
+    RateBucket* senderBucket = nullptr;
+    if (_maxPerSender > 0) {
+        senderBucket = &_senderBuckets[senderID];
+        refill(*senderBucket, _maxPerSender);
+        if (senderBucket->tokens < 1.0f) {
+            return false;
+        }
+    }
+
+    if (itemBucket) {
+        itemBucket->tokens -= 1.0f;
+    }
+    if (senderBucket) {
+        senderBucket->tokens -= 1.0f;
+    }
+    return true;
+}
+
+void OctreeEditScheduler::pruneRateBuckets(quint64 now) {
+    if (now - _lastBucketPrune < USECS_PER_SECOND) {
+        return;
+    }
+    _lastBucketPrune = now;
+
+    // an idle bucket would be full again anyway
+    auto prune = [&](QHash<QUuid, RateBucket>& buckets) {
+        auto itr = buckets.begin();
+        while (itr != buckets.end()) {
+            if (now - itr.value().lastRefill > RATE_BUCKET_EXPIRY) {
+                itr = buckets.erase(itr);
+            } else {
+                ++itr;
+            }
+        }
+    };
+    prune(_itemBuckets);
+    prune(_senderBuckets);
+}
@@ -0,0 +1,72 @@
+//
+//  OctreeEditScheduler.h
+//  assignment-client/src/octree
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeEditScheduler_h
+#define hifi_OctreeEditScheduler_h
+
+#include <functional>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QUuid>
+
+#include <Octree.h>
+
+/// Decides the order a batch of decoded edits is applied in. Edits superseded by a later edit from the same sender are
+/// merged into it, and the per-item and per-sender rate caps hold edits back for a later batch.
+class OctreeEditScheduler {
+public:
+    // what the scheduler needs to know about one edit in the batch
+    class Edit {
+    public:
+        QUuid senderID;
+        OctreeEditRecordPointer record; // null for edits the tree reads itself (erases, etc)
+        bool counted { false }; // already counted in the stats by an earlier batch that held it back
+    };
+
+    class Plan {
+    public:
+        std::vector<size_t> editsToApply; // in apply order
+        std::vector<size_t> deferredEdits; // held back for the next batch, in arrival order
+        std::vector<int> mergedFrom; // the edit each edit replaced, -1 when none, following it gives the merged chain
+        int editsMerged { 0 };
+        int editsRateLimited { 0 };
+    };
+
+    void setMaxEditsPerSecond(int perItem, int perSender) { _maxPerItem = perItem; _maxPerSender = perSender; }
+
+    // edits from flushSenderID are applied even if the rate caps would hold them back
+    Plan schedule(const std::vector<Edit>& edits, const QUuid& flushSenderID, quint64 now);
+
+    // Applies edit index with applyEdit(), which returns true when the tree took the edit as sent. When it didn't, the
+    // edits merged into it are applied oldest first and then the edit again, so its values are still the last ones set.
+    static void applyMerged(const Plan& plan, size_t index, const std::function<bool(size_t)>& applyEdit);
+
+private:
+    // token bucket for the per-item and per-sender edit rate caps
+    class RateBucket {
+    public:
+        float tokens { 0.0f };
+        quint64 lastRefill { 0 };
+    };
+
+    void mergeSupersededEdits(const std::vector<Edit>& edits, std::vector<bool>& merged, Plan& plan);
+    bool takeEditTokens(const QUuid& itemID, const QUuid& senderID, quint64 now);
+    void pruneRateBuckets(quint64 now);
+
+    int _maxPerItem { 0 };
+    int _maxPerSender { 0 };
+
+    QHash<QUuid, RateBucket> _itemBuckets;
+    QHash<QUuid, RateBucket> _senderBuckets;
+    quint64 _lastBucketPrune { 0 };
+};
+
+#endif // hifi_OctreeEditScheduler_h
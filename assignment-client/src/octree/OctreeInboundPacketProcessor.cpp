@@ -19,8 +19,14 @@
 #include "OctreeServerConsts.h"
 #include "OctreeInboundPacketProcessor.h"
 
-static QUuid DEFAULT_NODE_ID_REF;
 const quint64 TOO_LONG_SINCE_LAST_NACK = 1 * USECS_PER_SECOND;
+// a batch of edits releases the tree lock after this many so send threads aren't starved
+const size_t MAX_EDITS_PER_LOCK = 128;
+const uint32_t DEFERRED_EDITS_RETRY_MSECS = 10;
+
+static QUuid senderUUIDForEdit(const SharedNodePointer& sendingNode) {
+    return sendingNode ? sendingNode->getUUID() : QUuid();
+}
 
 OctreeInboundPacketProcessor::OctreeInboundPacketProcessor(OctreeServer* myServer) :
     _myServer(myServer),
@@ -41,6 +47,8 @@ void OctreeInboundPacketProcessor::resetStats() {
     _totalLockWaitTime = 0;
     _totalElementsInPacket = 0;
     _totalPackets = 0;
+    _totalEditsMerged = 0;
+    _totalEditsRateLimited = 0;
     _lastNackTime = usecTimestampNow();
 
     QWriteLocker locker(&_senderStatsLock);
@@ -54,7 +62,12 @@ uint32_t OctreeInboundPacketProcessor::getMaxWait() const {
     if (now >= nextNackTime) {
         return 0;
     }
-    return (nextNackTime - now) / USECS_PER_MSEC + 1;
+    uint32_t maxWait = (nextNackTime - now) / USECS_PER_MSEC + 1;
+    if (!_deferredEdits.empty()) {
+        // come back soon for the edits held back by the rate caps
+        maxWait = std::min(maxWait, DEFERRED_EDITS_RETRY_MSECS);
+    }
+    return maxWait;
 }
 
 void OctreeInboundPacketProcessor::preProcess() {
@@ -64,6 +77,11 @@ void OctreeInboundPacketProcessor::preProcess() {
         _lastNackTime = now;
         sendNackPackets();
     }
+
+    // edits held back by the rate caps are retried even when no new packets arrive
+    if (!_deferredEdits.empty() && !hasPacketsToProcess()) {
+        processPendingEdits();
+    }
 }
 
 void OctreeInboundPacketProcessor::midProcess() {
@@ -91,6 +109,13 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
 
     // Ask our tree subclass if it can handle the incoming packet...
     PacketType packetType = message->getType();
+
+    bool isEditPacket = _myServer->getOctree()->handlesEditPacketType(packetType);
+    if (!isEditPacket) {
+        // apply the edits batched so far first, including the sender's held back ones, so they keep their order
+        // with this packet
+        processPendingEdits(sendingNode ? sendingNode->getUUID() : QUuid());
+    }
     
     if (packetType == PacketType::ChallengeOwnership) {
         _myServer->getOctree()->withWriteLock([&] {
@@ -104,7 +129,7 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
         _myServer->getOctree()->withWriteLock([&] {
             _myServer->getOctree()->processChallengeOwnershipReplyPacket(*message, sendingNode);
         });
-    } else if (_myServer->getOctree()->handlesEditPacketType(packetType)) {
+    } else if (isEditPacket) {
         PerformanceWarning warn(debugProcessPacket, "processPacket KNOWN TYPE", debugProcessPacket);
         _receivedPacketCount++;
 
@@ -124,9 +149,6 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
         }
 
         quint64 transitTime = arrivedAt - sentAt;
-        int editsInPacket = 0;
-        quint64 processTime = 0;
-        quint64 lockWaitTime = 0;
 
         if (debugProcessPacket || _myServer->wantsDebugReceiving()) {
             qDebug() << "PROCESSING THREAD: got '" << packetType << "' packet - " << _receivedPacketCount << " command from client";
@@ -152,76 +174,176 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
             }
         }
         
-        const unsigned char* editData = nullptr;
-        
-        while (message->getBytesLeftToRead() > 0) {
-
-            editData = reinterpret_cast<const unsigned char*>(message->getRawMessage() + message->getPosition());
-
-            int maxSize = message->getBytesLeftToRead();
-
+        // Make sure our Node and NodeList knows we've heard from this node.
+        QUuid nodeUUID;
+        if (sendingNode) {
+            nodeUUID = sendingNode->getUUID();
             if (debugProcessPacket) {
-                qDebug() << " --- inside while loop ---";
-                qDebug() << "    maxSize=" << maxSize;
-                qDebug("OctreeInboundPacketProcessor::processPacket() %hhu "
-                       "payload=%p payloadLength=%lld editData=%p payloadPosition=%lld maxSize=%d",
-                       (unsigned char)packetType, message->getRawMessage(), message->getSize(), editData,
-                        message->getPosition(), maxSize);
+                qDebug() << "sender has uuid=" << nodeUUID;
             }
-
-            quint64 startProcess, startLock = usecTimestampNow();
-            int editDataBytesRead;
-            _myServer->getOctree()->withWriteLock([&] {
-                startProcess = usecTimestampNow();
-                editDataBytesRead =
-                    _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
-            });
-            quint64 endProcess = usecTimestampNow();
-
+        } else {
             if (debugProcessPacket) {
-                qDebug() << "OctreeInboundPacketProcessor::processPacket() after processEditPacketData()..."
-                    << "editDataBytesRead=" << editDataBytesRead;
+                qDebug() << "sender has no known nodeUUID.";
             }
+        }
 
-            editsInPacket++;
-            quint64 thisProcessTime = endProcess - startProcess;
-            quint64 thisLockWaitTime = startProcess - startLock;
-            processTime += thisProcessTime;
-            lockWaitTime += thisLockWaitTime;
-
-            // skip to next edit record in the packet
-            message->seek(message->getPosition() + editDataBytesRead);
+        // the records are decoded now, outside the tree lock, and applied with the rest of the batch in postProcess()
+        PendingPacket pendingPacket;
+        pendingPacket.nodeUUID = nodeUUID;
+        pendingPacket.sequence = sequence;
+        pendingPacket.transitTime = transitTime;
+        _pendingPackets.push_back(pendingPacket);
+        queueEditRecords(message, sendingNode, (int)_pendingPackets.size() - 1);
+    } else {
+        qDebug("unknown packet ignored... packetType=%hhu", (unsigned char)packetType);
+    }
+}
 
-            if (debugProcessPacket) {
-                qDebug() << "    editDataBytesRead=" << editDataBytesRead;
-                qDebug() << "    AFTER processEditPacketData payload position=" << message->getPosition();
-                qDebug() << "    AFTER processEditPacketData payload size=" << message->getSize();
-            }
+void OctreeInboundPacketProcessor::postProcess() {
+    processPendingEdits();
+}
 
+void OctreeInboundPacketProcessor::queueEditRecords(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode,
+        int packetIndex) {
+    bool debugProcessPacket = _myServer->wantsVerboseDebug();
+    quint64 startDecode = usecTimestampNow();
+
+    while (message->getBytesLeftToRead() > 0) {
+        const unsigned char* editData =
+            reinterpret_cast<const unsigned char*>(message->getRawMessage() + message->getPosition());
+        int maxSize = message->getBytesLeftToRead();
+
+        PendingEdit edit;
+        edit.message = message;
+        edit.sendingNode = sendingNode;
+        edit.editOffset = message->getPosition();
+        edit.packetIndex = packetIndex;
+        edit.record = _myServer->getOctree()->decodeEditPacketData(*message, editData, maxSize);
+        _pendingEdits.push_back(edit);
+        _pendingPackets[packetIndex].editsInPacket++;
+
+        if (!edit.record || edit.record->recordBytes <= 0) {
+            // the tree reads the rest of this message itself when the edit is applied
+            break;
         }
 
+        // skip to next edit record in the packet
+        message->seek(message->getPosition() + edit.record->recordBytes);
+
         if (debugProcessPacket) {
-            qDebug("OctreeInboundPacketProcessor::processPacket() DONE LOOPING FOR %hhu "
-                   "payload=%p payloadLength=%lld editData=%p payloadPosition=%lld",
-                   (unsigned char)packetType, message->getRawMessage(), message->getSize(), editData, message->getPosition());
+            qDebug() << "    decoded edit record, recordBytes=" << edit.record->recordBytes
+                << "payload position=" << message->getPosition() << "payload size=" << message->getSize();
         }
+    }
 
-        // Make sure our Node and NodeList knows we've heard from this node.
-        QUuid& nodeUUID = DEFAULT_NODE_ID_REF;
-        if (sendingNode) {
-            nodeUUID = sendingNode->getUUID();
-            if (debugProcessPacket) {
-                qDebug() << "sender has uuid=" << nodeUUID;
+    _pendingPackets[packetIndex].processTime += usecTimestampNow() - startDecode;
+}
+
+int OctreeInboundPacketProcessor::applyEdit(const PendingEdit& edit, bool& appliedAsSent) {
+    // NOTE: caller must hold the tree's write lock, returns the number of edit records applied
+    OctreePointer tree = _myServer->getOctree();
+    if (edit.record) {
+        appliedAsSent = tree->processDecodedEditPacketData(*edit.message, edit.record, edit.sendingNode);
+        return 1;
+    }
+
+    appliedAsSent = true;
+    int recordsApplied = 0;
+    ReceivedMessage& message = *edit.message;
+    message.seek(edit.editOffset);
+    while (message.getBytesLeftToRead() > 0) {
+        const unsigned char* editData =
+            reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition());
+        int editDataBytesRead =
+            tree->processEditPacketData(message, editData, message.getBytesLeftToRead(), edit.sendingNode);
+        recordsApplied++;
+        if (editDataBytesRead <= 0) {
+            break;
+        }
+        // skip to next edit record in the packet
+        message.seek(message.getPosition() + editDataBytesRead);
+    }
+    return recordsApplied;
+}
+
+void OctreeInboundPacketProcessor::processPendingEdits(const QUuid& flushSenderID) {
+    if (_pendingEdits.empty() && _deferredEdits.empty()) {
+        return;
+    }
+
+    // edits held back by the rate caps arrived first, so they go first
+    std::vector<PendingEdit> edits;
+    edits.reserve(_deferredEdits.size() + _pendingEdits.size());
+    edits.insert(edits.end(), _deferredEdits.begin(), _deferredEdits.end());
+    edits.insert(edits.end(), _pendingEdits.begin(), _pendingEdits.end());
+    _deferredEdits.clear();
+    _pendingEdits.clear();
+
+    std::vector<OctreeEditScheduler::Edit> scheduledEdits(edits.size());
+    for (size_t i = 0; i < edits.size(); ++i) {
+        scheduledEdits[i].senderID = senderUUIDForEdit(edits[i].sendingNode);
+        scheduledEdits[i].record = edits[i].record;
+        scheduledEdits[i].counted = edits[i].packetIndex < 0;
+    }
+    _editScheduler.setMaxEditsPerSecond(_myServer->getMaxEditsPerSecondPerItem(),
+        _myServer->getMaxEditsPerSecondPerSender());
+    OctreeEditScheduler::Plan plan = _editScheduler.schedule(scheduledEdits, flushSenderID, usecTimestampNow());
+    _totalEditsMerged += plan.editsMerged;
+    _totalEditsRateLimited += plan.editsRateLimited;
+
+    for (size_t index : plan.deferredEdits) {
+        _deferredEdits.push_back(edits[index]);
+        _deferredEdits.back().packetIndex = -1;
+    }
+    _deferredEditsCount = _deferredEdits.size();
+
+    const std::vector<size_t>& editsToApply = plan.editsToApply;
+    OctreePointer tree = _myServer->getOctree();
+    size_t next = 0;
+    while (next < editsToApply.size()) {
+        size_t end = std::min(next + MAX_EDITS_PER_LOCK, editsToApply.size());
+        quint64 startProcess = 0;
+        quint64 startLock = usecTimestampNow();
+        tree->withWriteLock([&] {
+            startProcess = usecTimestampNow();
+            for (size_t i = next; i < end; ++i) {
+                size_t index = editsToApply[i];
+                const PendingEdit& edit = edits[index];
+                quint64 startEdit = usecTimestampNow();
+                int recordsApplied = -1;
+                OctreeEditScheduler::applyMerged(plan, index, [&](size_t applyIndex) {
+                    bool appliedAsSent = false;
+                    int records = applyEdit(edits[applyIndex], appliedAsSent);
+                    if (recordsApplied < 0) {
+                        recordsApplied = records;
+                    }
+                    return appliedAsSent;
+                });
+                if (edit.packetIndex >= 0) {
+                    PendingPacket& packet = _pendingPackets[edit.packetIndex];
+                    packet.processTime += usecTimestampNow() - startEdit;
+                    // the first record was counted when it was queued
+                    packet.editsInPacket += recordsApplied - 1;
+                }
             }
-        } else {
-            if (debugProcessPacket) {
-                qDebug() << "sender has no known nodeUUID.";
+        });
+
+        // the wait for the lock is shared by the edits applied under it
+        quint64 lockWaitPerEdit = (startProcess - startLock) / (end - next);
+        for (size_t i = next; i < end; ++i) {
+            const PendingEdit& edit = edits[editsToApply[i]];
+            if (edit.packetIndex >= 0) {
+                _pendingPackets[edit.packetIndex].lockWaitTime += lockWaitPerEdit;
             }
         }
-        trackInboundPacket(nodeUUID, sequence, transitTime, editsInPacket, processTime, lockWaitTime);
-    } else {
-        qDebug("unknown packet ignored... packetType=%hhu", (unsigned char)packetType);
+        next = end;
+    }
+
+    for (auto& packet : _pendingPackets) {
+        trackInboundPacket(packet.nodeUUID, packet.sequence, packet.transitTime, packet.editsInPacket,
+            packet.processTime, packet.lockWaitTime);
     }
+    _pendingPackets.clear();
 }
 
 void OctreeInboundPacketProcessor::trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
@@ -14,8 +14,12 @@
 #ifndef hifi_OctreeInboundPacketProcessor_h
 #define hifi_OctreeInboundPacketProcessor_h
 
+#include <list>
+
+#include <Octree.h>
 #include <ReceivedPacketProcessor.h>
 
+#include "OctreeEditScheduler.h"
 #include "SequenceNumberStats.h"
 
 class OctreeServer;
@@ -70,6 +74,10 @@ public:
     quint64 getAverageLockWaitTimePerElement() const
                 { return _totalElementsInPacket == 0 ? 0 : _totalLockWaitTime / _totalElementsInPacket; }
 
+    quint64 getTotalEditsMerged() const { return _totalEditsMerged; }
+    quint64 getTotalEditsRateLimited() const { return _totalEditsRateLimited; }
+    size_t getDeferredEditsCount() const { return _deferredEditsCount; }
+
     void resetStats();
 
     NodeToSenderStatsMap getSingleSenderStats() { QReadLocker locker(&_senderStatsLock); return _singleSenderStats; }
@@ -83,11 +91,38 @@ protected:
     virtual uint32_t getMaxWait() const override;
     virtual void preProcess() override;
     virtual void midProcess() override;
+    virtual void postProcess() override;
 
 private:
     int sendNackPackets();
 
 private:
+    // an edit packet whose records are waiting in the current batch
+    class PendingPacket {
+    public:
+        QUuid nodeUUID;
+        unsigned short int sequence { 0 };
+        quint64 transitTime { 0 };
+        int editsInPacket { 0 };
+        quint64 processTime { 0 };
+        quint64 lockWaitTime { 0 };
+    };
+
+    // a decoded edit record waiting to be applied
+    class PendingEdit {
+    public:
+        QSharedPointer<ReceivedMessage> message;
+        SharedNodePointer sendingNode;
+        OctreeEditRecordPointer record; // when null, the rest of message from editOffset goes to processEditPacketData()
+        qint64 editOffset { 0 };
+        int packetIndex { -1 }; // into _pendingPackets, -1 once the packet has been tracked (deferred edits)
+    };
+
+    void queueEditRecords(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode, int packetIndex);
+    // edits from flushSenderID are applied even if the rate caps would hold them back
+    void processPendingEdits(const QUuid& flushSenderID = QUuid());
+    int applyEdit(const PendingEdit& edit, bool& appliedAsSent);
+
     void trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
             int elementsInPacket, quint64 processTime, quint64 lockWaitTime);
 
@@ -105,5 +140,16 @@ private:
 
     std::atomic<uint64_t> _lastNackTime;
     bool _shuttingDown;
+
+    // edits are decoded as packets arrive and applied together in postProcess()
+    std::vector<PendingPacket> _pendingPackets;
+    std::vector<PendingEdit> _pendingEdits;
+    std::list<PendingEdit> _deferredEdits; // held back by the rate caps, in arrival order, capped per sender
+    std::atomic<size_t> _deferredEditsCount { 0 };
+
+    OctreeEditScheduler _editScheduler;
+
+    std::atomic<uint64_t> _totalEditsMerged { 0 };
+    std::atomic<uint64_t> _totalEditsRateLimited { 0 };
 };
 #endif // hifi_OctreeInboundPacketProcessor_h
@@ -64,6 +64,10 @@ public:
     int getPacketsTotalPerInterval() const { return _packetsTotalPerInterval; }
     int getPacketsTotalPerSecond() const { return getPacketsTotalPerInterval() * INTERVALS_PER_SECOND; }
 
+    // inbound edit rate caps, 0 means unlimited
+    int getMaxEditsPerSecondPerItem() const { return _maxEditsPerSecondPerItem; }
+    int getMaxEditsPerSecondPerSender() const { return _maxEditsPerSecondPerSender; }
+
     static int getCurrentClientCount() { return _clientCount; }
     static void clientConnected() { _clientCount++; }
     static void clientDisconnected() { _clientCount--; }
@@ -193,6 +197,8 @@ protected:
     QString _backupDirectoryPath;
     int _packetsPerClientPerInterval;
     int _packetsTotalPerInterval;
+    int _maxEditsPerSecondPerItem { 0 };
+    int _maxEditsPerSecondPerSender { 0 };
     OctreePointer _tree; // this IS a reaveraging tree
     bool _wantPersist;
     bool _debugSending;
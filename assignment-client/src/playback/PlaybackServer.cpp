@@ -0,0 +1,180 @@
+//
+//  PlaybackServer.cpp
+//  assignment-client/src/playback
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PlaybackServer.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QUrl>
+
+#include <tbb/parallel_for.h>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <AvatarData.h>
+#include <LogUtils.h>
+#include <NodeList.h>
+#include <recording/Frame.h>
+
+#include "../AssignmentClientLogging.h"
+#include "PlaybackTrack.h"
+
+// the rate of agents' avatars
+static const int AVATAR_DATA_HZ = 45;
+static const int AVATAR_DATA_IN_MSECS = MSECS_PER_SECOND / AVATAR_DATA_HZ;
+
+// ticks between the full avatar updates of a track, they are spread over the ticks by track
+static const int FULL_UPDATE_INTERVAL_TICKS = (int)(1.0f / AVATAR_SEND_FULL_UPDATE_RATIO);
+
+static const int IDENTITY_INTERVAL_TICKS = AVATAR_IDENTITY_PACKET_SEND_INTERVAL_MSECS / AVATAR_DATA_IN_MSECS;
+
+static const QString MANIFEST_TRACKS_KEY = "tracks";
+static const QString MANIFEST_URL_KEY = "url";
+static const QString MANIFEST_OFFSET_KEY = "offset";
+static const QString MANIFEST_LOOP_KEY = "loop";
+
+PlaybackServer::PlaybackServer(const QString& manifestPath, const QString& domainServerHostname,
+                               quint16 domainServerPort, quint16 listenPort) :
+    _domainServerHostname(domainServerHostname)
+{
+    LogUtils::init();
+
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+
+    // the tracks have their own NodeLists, this one is never connected but library code expects it
+    DependencyManager::set<NodeList>(NodeType::Unassigned, listenPort);
+
+    if (!loadManifest(manifestPath)) {
+        QTimer::singleShot(0, [] { QCoreApplication::exit(1); });
+        return;
+    }
+
+    _domainServerSocket = HifiSockAddr(domainServerHostname, domainServerPort, true);
+    _domainServerSocket.setObjectName("DomainServer");
+    qCDebug(assignment_client) << "Playing" << _tracks.size() << "recordings in domain" << _domainServerSocket;
+
+    for (auto& track : _tracks) {
+        track->connectToDomain(_domainServerSocket, _domainServerHostname);
+    }
+
+    connect(&_checkInTimer, &QTimer::timeout, this, &PlaybackServer::checkInWithDomain);
+    _checkInTimer.start(DOMAIN_SERVER_CHECK_IN_MSECS);
+
+    connect(&_tickTimer, &QTimer::timeout, this, &PlaybackServer::tick);
+    _tickTimer.setTimerType(Qt::PreciseTimer);
+    _tickTimer.start(AVATAR_DATA_IN_MSECS);
+    _clock.start();
+}
+
+PlaybackServer::~PlaybackServer() {
+    // destroy the tracks before the NodeList of the process
+    _tracks.clear();
+}
+
+bool PlaybackServer::loadManifest(const QString& manifestPath) {
+    QFile manifestFile(manifestPath);
+    if (!manifestFile.open(QIODevice::ReadOnly)) {
+        qCCritical(assignment_client) << "Unable to open playback manifest" << manifestPath;
+        return false;
+    }
+
+    QJsonParseError error;
+    auto manifest = QJsonDocument::fromJson(manifestFile.readAll(), &error);
+    if (error.error != QJsonParseError::NoError) {
+        qCCritical(assignment_client) << "Invalid playback manifest" << manifestPath << "-" << error.errorString();
+        return false;
+    }
+
+    // the avatar frame type has to be known before the clips are read
+    static const recording::FrameType AVATAR_FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::FRAME_NAME);
+
+    QDir manifestDir = QFileInfo(manifestPath).absoluteDir();
+    for (const auto& trackValue : manifest.object()[MANIFEST_TRACKS_KEY].toArray()) {
+        auto trackObject = trackValue.toObject();
+        QUrl url = QUrl(trackObject[MANIFEST_URL_KEY].toString());
+        QString path;
+        if (url.isLocalFile()) {
+            path = url.toLocalFile();
+        } else if (url.scheme().isEmpty() || url.scheme().size() == 1) {
+            // a relative path, or an absolute one with a drive letter
+            path = manifestDir.absoluteFilePath(trackObject[MANIFEST_URL_KEY].toString());
+        } else {
+            qCWarning(assignment_client) << "Only local recordings can be played, skipping" << url;
+            continue;
+        }
+
+        auto clip = recording::Clip::fromFile(path);
+        if (!clip) {
+            qCWarning(assignment_client) << "Unable to read recording" << path;
+            continue;
+        }
+
+        float offset = (float)trackObject[MANIFEST_OFFSET_KEY].toDouble(0.0);
+        bool loop = trackObject[MANIFEST_LOOP_KEY].toBool(true);
+        _tracks.emplace_back(new PlaybackTrack(clip, AVATAR_FRAME_TYPE, offset, loop));
+    }
+
+    if (_tracks.empty()) {
+        qCCritical(assignment_client) << "No recordings to play in" << manifestPath;
+        return false;
+    }
+    return true;
+}
+
+void PlaybackServer::checkInWithDomain() {
+    for (auto& track : _tracks) {
+        track->checkInWithDomain();
+    }
+}
+
+void PlaybackServer::tick() {
+    const auto now = (recording::Frame::Time)_clock.elapsed();
+    const int numTracks = (int)_tracks.size();
+
+    // Read the clips and parse the frames on the workers
+    tbb::parallel_for(0, numTracks, [&](int i) {
+        _tracks[i]->decodeFrame(now);
+    });
+
+    for (auto& track : _tracks) {
+        track->applyFrame();
+    }
+
+    const int tickIndex = (int)(_tickCount % FULL_UPDATE_INTERVAL_TICKS);
+    tbb::parallel_for(0, numTracks, [&](int i) {
+        _tracks[i]->encodeAvatarData((i % FULL_UPDATE_INTERVAL_TICKS) == tickIndex);
+    });
+
+    // Then send the whole batch from this thread, the one the sockets live on
+    for (auto& track : _tracks) {
+        track->sendAvatarData();
+    }
+
+    if (_tickCount % IDENTITY_INTERVAL_TICKS == 0) {
+        for (auto& track : _tracks) {
+            track->sendIdentity();
+        }
+    }
+    ++_tickCount;
+}
+
+void PlaybackServer::aboutToQuit() {
+    _tickTimer.stop();
+    _checkInTimer.stop();
+    for (auto& track : _tracks) {
+        track->disconnectFromDomain();
+    }
+}
@@ -0,0 +1,61 @@
+//
+//  PlaybackServer.h
+//  assignment-client/src/playback
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PlaybackServer_h
+#define hifi_PlaybackServer_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+
+#include <HifiSockAddr.h>
+
+class PlaybackTrack;
+
+// Plays the recordings of a manifest as avatars in a domain, all from one process.  The manifest is a JSON file:
+//
+//   { "tracks": [ { "url": "recordings/walk.hfr", "offset": 2.5, "loop": true }, ... ] }
+//
+// where url is a local file, relative to the manifest, offset the time in seconds into the recording that
+// playback starts at, so copies of a clip don't move in step, and loop defaults to true.
+//
+// Every track connects to the domain as its own agent node, but there is no script engine or Deck per track.
+// Clips are read and avatar data encoded for all tracks on the shared TBB workers, and the packets of a tick
+// are then sent together, one per track.
+class PlaybackServer : public QObject {
+    Q_OBJECT
+public:
+    PlaybackServer(const QString& manifestPath, const QString& domainServerHostname, quint16 domainServerPort,
+                   quint16 listenPort);
+    ~PlaybackServer();
+
+    void aboutToQuit();
+
+private slots:
+    void tick();
+    void checkInWithDomain();
+
+private:
+    bool loadManifest(const QString& manifestPath);
+
+    HifiSockAddr _domainServerSocket;
+    QString _domainServerHostname;
+    std::vector<std::unique_ptr<PlaybackTrack>> _tracks;
+
+    QElapsedTimer _clock;
+    QTimer _tickTimer;
+    QTimer _checkInTimer;
+    quint64 _tickCount { 0 };
+};
+
+#endif // hifi_PlaybackServer_h
@@ -0,0 +1,159 @@
+//
+//  PlaybackTrack.cpp
+//  assignment-client/src/playback
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PlaybackTrack.h"
+
+#include <QtCore/QJsonDocument>
+
+#include <udt/PacketHeaders.h>
+
+#include "../AssignmentClientLogging.h"
+
+using namespace recording;
+
+PlaybackTrack::PlaybackTrack(const ClipPointer& clip, FrameType avatarFrameType, float offset, bool loop) :
+    _clip(clip),
+    _avatarFrameType(avatarFrameType),
+    _offset(Frame::secondsToFrameTime(offset)),
+    _duration(Frame::secondsToFrameTime(clip->duration())),
+    _loop(loop && _duration > 0),
+    _avatar(std::make_shared<AvatarData>())
+{
+    // each track is its own node, on its own socket, with the port picked by the OS
+    _nodeList = QSharedPointer<NodeList>(new NodeList(NodeType::Agent, 0), &QObject::deleteLater);
+    _nodeList->addSetOfNodeTypesToNodeInterestSet(NodeSet() << NodeType::AvatarMixer);
+
+    auto avatar = _avatar.get();
+    QObject::connect(_nodeList.data(), &LimitedNodeList::uuidChanged, avatar,
+                     [avatar](const QUuid& sessionUUID, const QUuid&) {
+        avatar->setSessionUUID(sessionUUID);
+    });
+}
+
+PlaybackTrack::~PlaybackTrack() {
+    disconnectFromDomain();
+}
+
+void PlaybackTrack::connectToDomain(const HifiSockAddr& domainServerSocket, const QString& hostname) {
+    _nodeList->getDomainHandler().setSockAddr(domainServerSocket, hostname);
+    _nodeList->sendDomainServerCheckIn();
+}
+
+void PlaybackTrack::checkInWithDomain() {
+    _nodeList->sendDomainServerCheckIn();
+}
+
+void PlaybackTrack::disconnectFromDomain() {
+    // The avatar mixer keeps avatars for as long as their node is connected, tell it to drop ours right away
+    _nodeList->eachMatchingNode(
+        [](const SharedNodePointer& node)->bool {
+            return node->getType() == NodeType::AvatarMixer && node->getActiveSocket();
+        },
+        [this](const SharedNodePointer& node) {
+            auto packet = NLPacket::create(PacketType::KillAvatar, NUM_BYTES_RFC4122_UUID + sizeof(KillAvatarReason), true);
+            packet->write(_avatar->getSessionUUID().toRfc4122());
+            packet->writePrimitive(KillAvatarReason::NoReason);
+            _nodeList->sendPacket(std::move(packet), *node);
+        });
+    _nodeList->getDomainHandler().disconnect();
+}
+
+bool PlaybackTrack::hasAvatarMixer() const {
+    auto avatarMixer = _nodeList->soloNodeOfType(NodeType::AvatarMixer);
+    return avatarMixer && avatarMixer->getActiveSocket();
+}
+
+void PlaybackTrack::decodeFrame(Frame::Time now) {
+    _pendingFrame = QJsonObject();
+
+    Frame::Time time = now + _offset;
+    if (_loop) {
+        qint64 loopCount = time / _duration;
+        time %= _duration;
+        if (loopCount != _loopCount) {
+            _loopCount = loopCount;
+            _clip->seekFrameTime(time);
+        }
+    } else if (_loopCount < 0) {
+        _loopCount = 0;
+        _clip->seekFrameTime(time);
+    }
+
+    // Avatar frames are full states, only the latest one matters
+    FrameConstPointer avatarFrame;
+    while (_clip->positionFrameTime() <= time) {
+        auto frame = _clip->nextFrame();
+        if (!frame) {
+            break;
+        }
+        if (frame->type == _avatarFrameType) {
+            avatarFrame = frame;
+        }
+    }
+
+    if (avatarFrame) {
+        _pendingFrame = QJsonDocument::fromBinaryData(avatarFrame->data).object();
+    }
+}
+
+void PlaybackTrack::applyFrame() {
+    // AvatarData hands most setters to its own thread, so this can't run on the workers
+    if (!_pendingFrame.isEmpty()) {
+        _avatar->fromJson(_pendingFrame);
+        _pendingFrame = QJsonObject();
+    }
+}
+
+void PlaybackTrack::encodeAvatarData(bool sendAll) {
+    _avatarByteArray.clear();
+    if (!hasAvatarMixer()) {
+        return;
+    }
+
+    auto dataDetail = sendAll ? AvatarData::SendAllData : AvatarData::CullSmallData;
+    QByteArray avatarByteArray = _avatar->toByteArrayStateful(dataDetail);
+
+    int maximumByteArraySize = NLPacket::maxPayloadSize(PacketType::AvatarData) - sizeof(AvatarDataSequenceNumber);
+
+    if (avatarByteArray.size() > maximumByteArraySize) {
+        avatarByteArray = _avatar->toByteArrayStateful(dataDetail, true);
+
+        if (avatarByteArray.size() > maximumByteArraySize) {
+            avatarByteArray = _avatar->toByteArrayStateful(AvatarData::MinimumData, true);
+
+            if (avatarByteArray.size() > maximumByteArraySize) {
+                qCWarning(assignment_client) << "Recorded avatar data too large to send:" << avatarByteArray.size();
+                return;
+            }
+        }
+    }
+
+    _avatar->doneEncoding(true);
+    _avatarByteArray = avatarByteArray;
+}
+
+void PlaybackTrack::sendAvatarData() {
+    if (_avatarByteArray.isEmpty()) {
+        return;
+    }
+
+    auto avatarPacket = NLPacket::create(PacketType::AvatarData, _avatarByteArray.size() + sizeof(_sequenceNumber));
+    avatarPacket->writePrimitive(_sequenceNumber++);
+    avatarPacket->write(_avatarByteArray);
+    _nodeList->broadcastToNodes(std::move(avatarPacket), NodeSet() << NodeType::AvatarMixer);
+    _avatarByteArray.clear();
+}
+
+void PlaybackTrack::sendIdentity() {
+    if (hasAvatarMixer()) {
+        _avatar->markIdentityDataChanged();
+        _avatar->sendIdentityPacket(*_nodeList);
+    }
+}
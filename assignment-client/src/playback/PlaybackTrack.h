@@ -0,0 +1,60 @@
+//
+//  PlaybackTrack.h
+//  assignment-client/src/playback
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PlaybackTrack_h
+#define hifi_PlaybackTrack_h
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QSharedPointer>
+
+#include <AvatarData.h>
+#include <NodeList.h>
+#include <recording/Clip.h>
+
+// One recorded avatar of the PlaybackServer: a clip, the avatar it drives and the NodeList the avatar is
+// connected to the domain with, so the avatar-mixer sees it as a node of its own.
+//
+// decodeFrame and encodeAvatarData run on the shared workers, everything else on the server's thread.
+class PlaybackTrack {
+public:
+    PlaybackTrack(const recording::ClipPointer& clip, recording::FrameType avatarFrameType, float offset, bool loop);
+    ~PlaybackTrack();
+
+    void connectToDomain(const HifiSockAddr& domainServerSocket, const QString& hostname);
+    void checkInWithDomain();
+    void disconnectFromDomain();
+
+    // Reads the clip up to now and parses the latest avatar frame
+    void decodeFrame(recording::Frame::Time now);
+    void applyFrame();
+
+    void encodeAvatarData(bool sendAll);
+    void sendAvatarData();
+    void sendIdentity();
+
+    bool hasAvatarMixer() const;
+
+private:
+    const recording::ClipPointer _clip;
+    const recording::FrameType _avatarFrameType;
+    const recording::Frame::Time _offset;
+    const recording::Frame::Time _duration;
+    const bool _loop;
+
+    AvatarSharedPointer _avatar;
+    QSharedPointer<NodeList> _nodeList;
+
+    qint64 _loopCount { -1 };
+    QJsonObject _pendingFrame;
+    QByteArray _avatarByteArray;
+    AvatarDataSequenceNumber _sequenceNumber { 0 };
+};
+
+#endif // hifi_PlaybackTrack_h
@@ -225,17 +225,18 @@ void AssetsBackupHandler::loadingComplete() {
     checkForAssetsToDelete();
 }
 
-void AssetsBackupHandler::createBackup(const QString& backupName, QuaZip& zip) {
+bool AssetsBackupHandler::createBackup(const QString& backupName, QuaZip& zip) {
     Q_ASSERT(QThread::currentThread() == thread());
 
     if (operationInProgress()) {
         qCWarning(asset_backup) << "There is already an operation in progress.";
-        return;
+        // the rest of the backup goes ahead without the asset mappings
+        return true;
     }
 
     if (_lastMappingsRefresh.time_since_epoch().count() == 0) {
         qCWarning(asset_backup) << "Current mappings not yet loaded.";
-        return;
+        return true;
     }
 
     if ((p_high_resolution_clock::now() - _lastMappingsRefresh) > MAX_REFRESH_TIME) {
@@ -255,16 +256,17 @@ void AssetsBackupHandler::createBackup(const QString& backupName, QuaZip& zip) {
     QuaZipFile zipFile { &zip };
     if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(MAPPINGS_FILE))) {
         qCDebug(asset_backup) << "Could not open zip file:" << zipFile.getZipError();
-        return;
+        return false;
     }
     zipFile.write(document.toJson());
     zipFile.close();
     if (zipFile.getZipError() != UNZ_OK) {
         qCDebug(asset_backup) << "Could not close zip file: " << zipFile.getZipError();
-        return;
+        return false;
     }
     _backups.emplace_back(backupName, mappings, false);
     qDebug() << "Created asset backup:" << backupName;
+    return true;
 }
 
 void AssetsBackupHandler::recoverBackup(const QString& backupName, QuaZip& zip) {
@@ -37,7 +37,7 @@ public:
 
     void loadBackup(const QString& backupName, QuaZip& zip) override;
     void loadingComplete() override;
-    void createBackup(const QString& backupName, QuaZip& zip) override;
+    bool createBackup(const QString& backupName, QuaZip& zip) override;
     void recoverBackup(const QString& backupName, QuaZip& zip) override;
     void deleteBackup(const QString& backupName) override;
     void consolidateBackup(const QString& backupName, QuaZip& zip) override;
@@ -0,0 +1,209 @@
+//
+//  BackupChunkStore.cpp
+//  domain-server/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BackupChunkStore.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+#include <quazip5/quazip.h>
+#include <quazip5/quazipfile.h>
+
+static const QString CHUNKS_DIR = "/chunks/";
+static const QString CHUNKS_KEY = "chunks";
+
+BackupChunkStore::BackupChunkStore(const QString& backupDirectory) :
+    _chunksDirectory(backupDirectory + CHUNKS_DIR),
+    _chunker([this](const QByteArray& chunk) { return storeChunk(chunk); })
+{
+    _chunksDirectory.mkpath(".");
+}
+
+QString BackupChunkStore::chunkPath(const QByteArray& chunkHash) const {
+    return _chunksDirectory.absoluteFilePath(QString(chunkHash));
+}
+
+bool BackupChunkStore::storeChunk(const QByteArray& chunk) {
+    auto chunkHash = QCryptographicHash::hash(chunk, QCryptographicHash::Sha256).toHex();
+    _currentManifest.push_back(chunkHash);
+
+    if (QFile::exists(chunkPath(chunkHash))) {
+        // an earlier backup already has it
+        return true;
+    }
+
+    QSaveFile file { chunkPath(chunkHash) };
+    auto compressed = qCompress(chunk);
+    if (!file.open(QIODevice::WriteOnly) || file.write(compressed) != compressed.size() || !file.commit()) {
+        qCritical() << "Failed to write backup chunk" << chunkHash << ":" << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+void BackupChunkStore::beginFile() {
+    _chunker.reset();
+    _currentManifest.clear();
+}
+
+bool BackupChunkStore::append(const char* data, int size) {
+    return _chunker.append(data, size);
+}
+
+bool BackupChunkStore::endFile(const QString& backupName, QuaZip& zip, const QString& manifestName) {
+    Manifest manifest;
+    bool success = _chunker.finish();
+    std::swap(manifest, _currentManifest);
+    if (!success) {
+        return false;
+    }
+
+    QJsonArray chunks;
+    for (const auto& chunkHash : manifest) {
+        chunks.append(QString(chunkHash));
+    }
+    QJsonObject root;
+    root[CHUNKS_KEY] = chunks;
+
+    QuaZipFile zipFile { &zip };
+    if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(manifestName))) {
+        qCritical().nospace() << "Failed to open " << manifestName << " for writing in zip";
+        return false;
+    }
+    zipFile.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    zipFile.close();
+    if (zipFile.getZipError() != UNZ_OK) {
+        qCritical().nospace() << "Failed to zip " << manifestName << ": " << zipFile.getZipError();
+        return false;
+    }
+
+    retain(backupName, manifestName, manifest);
+    return true;
+}
+
+bool BackupChunkStore::readManifest(QuaZip& zip, const QString& manifestName, Manifest& manifest) {
+    if (!zip.setCurrentFile(manifestName)) {
+        return false;
+    }
+    QuaZipFile zipFile { &zip };
+    if (!zipFile.open(QIODevice::ReadOnly)) {
+        qCritical() << "Failed to open" << manifestName << "in backup";
+        return false;
+    }
+    auto document = QJsonDocument::fromJson(zipFile.readAll());
+    zipFile.close();
+
+    manifest.clear();
+    for (const auto& value : document.object()[CHUNKS_KEY].toArray()) {
+        manifest.push_back(value.toString().toUtf8());
+    }
+    return true;
+}
+
+bool BackupChunkStore::readChunks(const Manifest& manifest, QByteArray& data) {
+    data.clear();
+    for (const auto& chunkHash : manifest) {
+        QFile file { chunkPath(chunkHash) };
+        if (!file.open(QIODevice::ReadOnly)) {
+            qCritical() << "Backup chunk" << chunkHash << "is missing";
+            return false;
+        }
+        auto chunk = qUncompress(file.readAll());
+        if (QCryptographicHash::hash(chunk, QCryptographicHash::Sha256).toHex() != chunkHash) {
+            qCritical() << "Backup chunk" << chunkHash << "is corrupted";
+            return false;
+        }
+        data.append(chunk);
+    }
+    return true;
+}
+
+bool BackupChunkStore::readFile(QuaZip& zip, const QString& manifestName, QByteArray& data) {
+    Manifest manifest;
+    return readManifest(zip, manifestName, manifest) && readChunks(manifest, data);
+}
+
+bool BackupChunkStore::readFile(const QString& backupName, const QString& manifestName, QByteArray& data) {
+    auto it = _backupManifests.find(backupName);
+    if (it == _backupManifests.end() || !it->contains(manifestName)) {
+        return false;
+    }
+    return readChunks(it->value(manifestName), data);
+}
+
+void BackupChunkStore::retain(const QString& backupName, const QString& manifestName, const Manifest& manifest) {
+    auto& manifests = _backupManifests[backupName];
+    if (manifests.contains(manifestName)) {
+        return;
+    }
+    manifests[manifestName] = manifest;
+    for (const auto& chunkHash : manifest) {
+        ++_refCounts[chunkHash];
+    }
+}
+
+bool BackupChunkStore::loadBackup(const QString& backupName, QuaZip& zip, const QString& manifestName) {
+    Manifest manifest;
+    if (!readManifest(zip, manifestName, manifest)) {
+        // backups from before chunking hold the whole file instead
+        return true;
+    }
+    retain(backupName, manifestName, manifest);
+
+    for (const auto& chunkHash : manifest) {
+        if (!QFile::exists(chunkPath(chunkHash))) {
+            qCritical() << "Backup" << backupName << "is missing chunk" << chunkHash << "of" << manifestName;
+            _backupsMissingChunks.insert(backupName);
+            return false;
+        }
+    }
+    return true;
+}
+
+void BackupChunkStore::releaseBackup(const QString& backupName) {
+    auto it = _backupManifests.find(backupName);
+    if (it == _backupManifests.end()) {
+        return;
+    }
+
+    int numRemoved = 0;
+    for (const auto& manifest : *it) {
+        for (const auto& chunkHash : manifest) {
+            auto refIt = _refCounts.find(chunkHash);
+            if (refIt != _refCounts.end() && --(*refIt) <= 0) {
+                _refCounts.erase(refIt);
+                QFile::remove(chunkPath(chunkHash));
+                ++numRemoved;
+            }
+        }
+    }
+    _backupManifests.erase(it);
+    _backupsMissingChunks.remove(backupName);
+
+    qDebug() << "Released backup" << backupName << "-" << numRemoved << "chunks no longer needed";
+}
+
+void BackupChunkStore::removeUnreferencedChunks() {
+    int numRemoved = 0;
+    for (const auto& fileInfo : _chunksDirectory.entryInfoList(QDir::Files)) {
+        if (!_refCounts.contains(fileInfo.fileName().toUtf8())) {
+            QFile::remove(fileInfo.absoluteFilePath());
+            ++numRemoved;
+        }
+    }
+    if (numRemoved > 0) {
+        qDebug() << "Removed" << numRemoved << "unreferenced backup chunks";
+    }
+}
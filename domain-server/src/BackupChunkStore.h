@@ -0,0 +1,80 @@
+//
+//  BackupChunkStore.h
+//  domain-server/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BackupChunkStore_h
+#define hifi_BackupChunkStore_h
+
+#include <memory>
+
+#include <QByteArray>
+#include <QDir>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+#include <shared/ContentDefinedChunker.h>
+
+class QuaZip;
+
+// BackupChunkStore lets backup handlers store a file of a backup as a small manifest inside the backup zip,
+// with its content kept as compressed, content-defined chunks in a directory shared by every backup.  A chunk
+// is stored once no matter how many backups contain it, so a backup only costs the chunks that changed since
+// the ones before it, yet every backup is complete on its own and can be restored or deleted in any order.
+//
+// A file is written a block at a time, so memory use does not grow with its size.
+//
+// Chunks are reference counted per backup: loadBackup and endFile retain the chunks of a backup and
+// releaseBackup lets them go.  Backup thread only.
+class BackupChunkStore {
+public:
+    BackupChunkStore(const QString& backupDirectory);
+
+    // writing a file to the backup being created
+    void beginFile();
+    bool append(const char* data, int size);
+    bool endFile(const QString& backupName, QuaZip& zip, const QString& manifestName);
+
+    // reassembles a file from its manifest in zip, or in a backup that was loaded or created
+    bool readFile(QuaZip& zip, const QString& manifestName, QByteArray& data);
+    bool readFile(const QString& backupName, const QString& manifestName, QByteArray& data);
+
+    // takes a reference on the chunks of a file in an existing backup, returns false if some are missing
+    bool loadBackup(const QString& backupName, QuaZip& zip, const QString& manifestName);
+
+    // drops the references of a deleted backup and deletes the chunks no backup needs anymore
+    void releaseBackup(const QString& backupName);
+
+    bool isMissingChunks(const QString& backupName) const { return _backupsMissingChunks.contains(backupName); }
+
+    // deletes chunks left behind by backups that failed half way, once every backup is loaded
+    void removeUnreferencedChunks();
+
+private:
+    using Manifest = QVector<QByteArray>;
+
+    bool storeChunk(const QByteArray& chunk);
+    bool readManifest(QuaZip& zip, const QString& manifestName, Manifest& manifest);
+    bool readChunks(const Manifest& manifest, QByteArray& data);
+    void retain(const QString& backupName, const QString& manifestName, const Manifest& manifest);
+    QString chunkPath(const QByteArray& chunkHash) const;
+
+    QDir _chunksDirectory;
+    ContentDefinedChunker _chunker;
+    Manifest _currentManifest;
+
+    QHash<QByteArray, int> _refCounts;
+    QHash<QString, QHash<QString, Manifest>> _backupManifests;
+    QSet<QString> _backupsMissingChunks;
+};
+
+using BackupChunkStorePointer = std::shared_ptr<BackupChunkStore>;
+
+#endif // hifi_BackupChunkStore_h
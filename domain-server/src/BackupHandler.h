@@ -29,7 +29,8 @@ public:
 
     virtual void loadBackup(const QString& backupName, QuaZip& zip) = 0;
     virtual void loadingComplete() = 0;
-    virtual void createBackup(const QString& backupName, QuaZip& zip) = 0;
+    // Returns false if the handler's part of the backup couldn't be written, which fails the whole backup.
+    virtual bool createBackup(const QString& backupName, QuaZip& zip) = 0;
     virtual void recoverBackup(const QString& backupName, QuaZip& zip) = 0;
     virtual void deleteBackup(const QString& backupName) = 0;
     virtual void consolidateBackup(const QString& backupName, QuaZip& zip) = 0;
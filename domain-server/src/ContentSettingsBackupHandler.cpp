@@ -14,14 +14,21 @@
 #include <quazip5/quazip.h>
 #include <quazip5/quazipfile.h>
 
-ContentSettingsBackupHandler::ContentSettingsBackupHandler(DomainServerSettingsManager& domainServerSettingsManager) :
-    _settingsManager(domainServerSettingsManager)
+ContentSettingsBackupHandler::ContentSettingsBackupHandler(DomainServerSettingsManager& domainServerSettingsManager,
+                                                           BackupChunkStorePointer chunkStore) :
+    _settingsManager(domainServerSettingsManager),
+    _chunkStore(chunkStore)
 {
 }
 
 static const QString CONTENT_SETTINGS_BACKUP_FILENAME = "content-settings.json";
+static const QString CONTENT_SETTINGS_MANIFEST_FILENAME = "content-settings.json.chunks";
 
-void ContentSettingsBackupHandler::createBackup(const QString& backupName, QuaZip& zip) {
+void ContentSettingsBackupHandler::loadBackup(const QString& backupName, QuaZip& zip) {
+    _chunkStore->loadBackup(backupName, zip, CONTENT_SETTINGS_MANIFEST_FILENAME);
+}
+
+bool ContentSettingsBackupHandler::createBackup(const QString& backupName, QuaZip& zip) {
 
     // grab the content settings as JSON, excluding default values and values hidden from backup
     QJsonObject contentSettingsJSON = _settingsManager.settingsResponseObjectForType(
@@ -34,41 +41,69 @@ void ContentSettingsBackupHandler::createBackup(const QString& backupName, QuaZi
     // make a QJsonDocument using the object
     QJsonDocument contentSettingsDocument { contentSettingsJSON };
 
-    QuaZipFile zipFile { &zip };
+    // settings that did not change since the last backup share its chunks
+    auto contentSettingsData = contentSettingsDocument.toJson();
+    _chunkStore->beginFile();
+    if (!_chunkStore->append(contentSettingsData.constData(), contentSettingsData.size())
+            || !_chunkStore->endFile(backupName, zip, CONTENT_SETTINGS_MANIFEST_FILENAME)) {
+        qCritical().nospace() << "Failed to write " << CONTENT_SETTINGS_BACKUP_FILENAME << " to backup";
+        return false;
+    }
+    return true;
+}
 
-    if (zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(CONTENT_SETTINGS_BACKUP_FILENAME))) {
-        if (zipFile.write(contentSettingsDocument.toJson()) == -1) {
-            qCritical().nospace() << "Failed to write to " << CONTENT_SETTINGS_BACKUP_FILENAME << ": " << zipFile.getZipError();
+void ContentSettingsBackupHandler::recoverBackup(const QString& backupName, QuaZip& zip) {
+    QByteArray rawData;
+
+    if (zip.setCurrentFile(CONTENT_SETTINGS_BACKUP_FILENAME)) {
+        // a consolidated or uploaded backup, or one from before backups were chunked
+        QuaZipFile zipFile { &zip };
+        if (!zipFile.open(QIODevice::ReadOnly)) {
+            qCritical() << "Failed to open" << CONTENT_SETTINGS_BACKUP_FILENAME << "in backup";
+            return;
         }
 
+        rawData = zipFile.readAll();
         zipFile.close();
+    } else if (!_chunkStore->readFile(zip, CONTENT_SETTINGS_MANIFEST_FILENAME, rawData)) {
+        qWarning() << "Failed to find" << CONTENT_SETTINGS_BACKUP_FILENAME << "while recovering backup";
+        return;
+    }
 
-        if (zipFile.getZipError() != UNZ_OK) {
-            qCritical().nospace() << "Failed to zip " << CONTENT_SETTINGS_BACKUP_FILENAME << ": " << zipFile.getZipError();
-        }
-    } else {
-        qCritical().nospace() << "Failed to open " << CONTENT_SETTINGS_BACKUP_FILENAME << ": " << zipFile.getZipError();
+    QJsonDocument jsonDocument = QJsonDocument::fromJson(rawData);
+
+    if (!_settingsManager.restoreSettingsFromObject(jsonDocument.object(), ContentSettings)) {
+        qCritical() << "Failed to restore settings from" << CONTENT_SETTINGS_BACKUP_FILENAME << "in content archive";
     }
 }
 
-void ContentSettingsBackupHandler::recoverBackup(const QString& backupName, QuaZip& zip) {
-    if (!zip.setCurrentFile(CONTENT_SETTINGS_BACKUP_FILENAME)) {
-        qWarning() << "Failed to find" << CONTENT_SETTINGS_BACKUP_FILENAME << "while recovering backup";
-        return;
-    }
+void ContentSettingsBackupHandler::deleteBackup(const QString& backupName) {
+    _chunkStore->releaseBackup(backupName);
+}
 
-    QuaZipFile zipFile { &zip };
-    if (!zipFile.open(QIODevice::ReadOnly)) {
-        qCritical() << "Failed to open" << CONTENT_SETTINGS_BACKUP_FILENAME << "in backup";
+void ContentSettingsBackupHandler::consolidateBackup(const QString& backupName, QuaZip& zip) {
+    QByteArray contentSettingsData;
+    if (!_chunkStore->readFile(backupName, CONTENT_SETTINGS_MANIFEST_FILENAME, contentSettingsData)) {
+        // the backup already holds the whole settings file
         return;
     }
 
-    auto rawData = zipFile.readAll();
-    zipFile.close();
+    QuaZipFile zipFile { &zip };
+    if (zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(CONTENT_SETTINGS_BACKUP_FILENAME))) {
+        if (zipFile.write(contentSettingsData) == -1) {
+            qCritical().nospace() << "Failed to write to " << CONTENT_SETTINGS_BACKUP_FILENAME << ": " << zipFile.getZipError();
+        }
 
-    QJsonDocument jsonDocument = QJsonDocument::fromJson(rawData);
+        zipFile.close();
 
-    if (!_settingsManager.restoreSettingsFromObject(jsonDocument.object(), ContentSettings)) {
-        qCritical() << "Failed to restore settings from" << CONTENT_SETTINGS_BACKUP_FILENAME << "in content archive";
+        if (zipFile.getZipError() != UNZ_OK) {
+            qCritical().nospace() << "Failed to zip " << CONTENT_SETTINGS_BACKUP_FILENAME << ": " << zipFile.getZipError();
+        }
+    } else {
+        qCritical().nospace() << "Failed to open " << CONTENT_SETTINGS_BACKUP_FILENAME << ": " << zipFile.getZipError();
     }
 }
+
+bool ContentSettingsBackupHandler::isCorruptedBackup(const QString& backupName) {
+    return _chunkStore->isMissingChunks(backupName);
+}
@@ -13,31 +13,34 @@
 #define hifi_ContentSettingsBackupHandler_h
 
 #include "BackupHandler.h"
+#include "BackupChunkStore.h"
 #include "DomainServerSettingsManager.h"
 
 class ContentSettingsBackupHandler : public BackupHandlerInterface {
 public:
-    ContentSettingsBackupHandler(DomainServerSettingsManager& domainServerSettingsManager);
+    ContentSettingsBackupHandler(DomainServerSettingsManager& domainServerSettingsManager,
+                                 BackupChunkStorePointer chunkStore);
 
     std::pair<bool, float> isAvailable(const QString& backupName) override { return { true, 1.0f }; }
     std::pair<bool, float> getRecoveryStatus() override { return { false, 1.0f }; }
 
-    void loadBackup(const QString& backupName, QuaZip& zip) override {}
+    void loadBackup(const QString& backupName, QuaZip& zip) override;
 
     void loadingComplete() override {}
 
-    void createBackup(const QString& backupName, QuaZip& zip) override;
+    bool createBackup(const QString& backupName, QuaZip& zip) override;
 
     void recoverBackup(const QString& backupName, QuaZip& zip) override;
 
-    void deleteBackup(const QString& backupName) override {}
+    void deleteBackup(const QString& backupName) override;
 
-    void consolidateBackup(const QString& backupName, QuaZip& zip) override {}
+    void consolidateBackup(const QString& backupName, QuaZip& zip) override;
 
-    bool isCorruptedBackup(const QString& backupName) override { return false; }
+    bool isCorruptedBackup(const QString& backupName) override;
 
 private:
     DomainServerSettingsManager& _settingsManager;
+    BackupChunkStorePointer _chunkStore;
 };
 
 #endif // hifi_ContentSettingsBackupHandler_h
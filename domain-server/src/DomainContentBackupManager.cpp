@@ -456,6 +456,11 @@ void DomainContentBackupManager::removeOldBackupVersions(const BackupRule& rule)
                 QFile backupFile(fileInfo);
                 if (backupFile.remove()) {
                     qCDebug(domain_server) << "Removed old backup: " << backupFile.fileName();
+
+                    // let the handlers drop what they were keeping for it
+                    for (auto& handler : _backupHandlers) {
+                        handler->deleteBackup(matchingFiles[i].fileName());
+                    }
                 } else {
                     qCDebug(domain_server) << "Failed to remove old backup: " << backupFile.fileName();
                 }
@@ -660,11 +665,23 @@ std::pair<bool, QString> DomainContentBackupManager::createBackup(const QString&
         return { false, path };
     }
 
+    bool success = true;
     for (auto& handler : _backupHandlers) {
-        handler->createBackup(fileName, zip);
+        if (!handler->createBackup(fileName, zip)) {
+            success = false;
+            break;
+        }
     }
 
     zip.close();
 
-    return { true, path };
+    if (!success) {
+        // don't keep a backup that is missing part of the content
+        for (auto& handler : _backupHandlers) {
+            handler->deleteBackup(fileName);
+        }
+        QFile::remove(path);
+    }
+
+    return { success, path };
 }
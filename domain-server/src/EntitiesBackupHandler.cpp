@@ -16,51 +16,94 @@
 #include <quazip5/quazip.h>
 #include <quazip5/quazipfile.h>
 
+#include <Gzip.h>
 #include <OctreeDataUtils.h>
 
-EntitiesBackupHandler::EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath) :
+EntitiesBackupHandler::EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath,
+                                             BackupChunkStorePointer chunkStore) :
     _entitiesFilePath(entitiesFilePath),
-    _entitiesReplacementFilePath(entitiesReplacementFilePath)
+    _entitiesReplacementFilePath(entitiesReplacementFilePath),
+    _chunkStore(chunkStore)
 {
 }
 
 static const QString ENTITIES_BACKUP_FILENAME = "models.json.gz";
+static const QString ENTITIES_MANIFEST_FILENAME = "models.json.chunks";
+static const QByteArray GZIP_MAGIC { "\x1f\x8b", 2 };
 
-void EntitiesBackupHandler::createBackup(const QString& backupName, QuaZip& zip) {
+void EntitiesBackupHandler::loadBackup(const QString& backupName, QuaZip& zip) {
+    _chunkStore->loadBackup(backupName, zip, ENTITIES_MANIFEST_FILENAME);
+}
+
+void EntitiesBackupHandler::loadingComplete() {
+    _chunkStore->removeUnreferencedChunks();
+}
+
+bool EntitiesBackupHandler::createBackup(const QString& backupName, QuaZip& zip) {
     QFile entitiesFile { _entitiesFilePath };
 
-    if (entitiesFile.open(QIODevice::ReadOnly)) {
-        QuaZipFile zipFile { &zip };
-        if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(ENTITIES_BACKUP_FILENAME, _entitiesFilePath))) {
-            qCritical().nospace() << "Failed to open " << ENTITIES_BACKUP_FILENAME << " for writing in zip";
-            return;
+    if (!entitiesFile.open(QIODevice::ReadOnly)) {
+        // no entities saved yet
+        return true;
+    }
+
+    // the uncompressed JSON is chunked so only the parts that changed since earlier backups get stored,
+    // it is inflated a block at a time straight into the chunk store
+    auto appendToBackup = [this](const char* data, int size) {
+        return _chunkStore->append(data, size);
+    };
+
+    bool success = true;
+    _chunkStore->beginFile();
+    if (entitiesFile.peek(GZIP_MAGIC.size()) == GZIP_MAGIC) {
+        // a gzipped file that fails to inflate is corrupt or couldn't be stored, don't back up the part that did
+        if (!gunzip(entitiesFile, appendToBackup)) {
+            qCritical() << "Failed to inflate entities file into backup";
+            success = false;
         }
-        auto entityData = entitiesFile.readAll();
-        if (zipFile.write(entityData) != entityData.size()) {
-            qCritical() << "Failed to write entities file to backup";
-            zipFile.close();
+    } else {
+        qWarning() << "Entities file is not gzipped, backing it up as it is";
+
+        const qint64 BLOCK_SIZE = ContentDefinedChunker::MAX_CHUNK_SIZE;
+        QByteArray block;
+        do {
+            block = entitiesFile.read(BLOCK_SIZE);
+            if (!block.isEmpty() && !appendToBackup(block.constData(), block.size())) {
+                success = false;
+            }
+        } while (success && !block.isEmpty());
+        success = success && entitiesFile.error() == QFileDevice::NoError;
+    }
+
+    if (!success || !_chunkStore->endFile(backupName, zip, ENTITIES_MANIFEST_FILENAME)) {
+        qCritical() << "Failed to write entities file to backup";
+        return false;
+    }
+    return true;
+}
+
+void EntitiesBackupHandler::recoverBackup(const QString& backupName, QuaZip& zip) {
+    QByteArray rawData;
+
+    if (zip.setCurrentFile(ENTITIES_BACKUP_FILENAME)) {
+        // a consolidated or uploaded backup, or one from before backups were chunked
+        QuaZipFile zipFile { &zip };
+        if (!zipFile.open(QIODevice::ReadOnly)) {
+            qCritical() << "Failed to open" << ENTITIES_BACKUP_FILENAME << "in backup";
             return;
         }
+        rawData = zipFile.readAll();
+
         zipFile.close();
+
         if (zipFile.getZipError() != UNZ_OK) {
-            qCritical().nospace() << "Failed to zip " << ENTITIES_BACKUP_FILENAME << ": " << zipFile.getZipError();
+            qCritical().nospace() << "Failed to unzip " << ENTITIES_BACKUP_FILENAME << ": " << zipFile.getZipError();
+            return;
         }
-    }
-}
-
-void EntitiesBackupHandler::recoverBackup(const QString& backupName, QuaZip& zip) {
-    if (!zip.setCurrentFile(ENTITIES_BACKUP_FILENAME)) {
+    } else if (!_chunkStore->readFile(zip, ENTITIES_MANIFEST_FILENAME, rawData)) {
         qWarning() << "Failed to find" << ENTITIES_BACKUP_FILENAME << "while recovering backup";
         return;
     }
-    QuaZipFile zipFile { &zip };
-    if (!zipFile.open(QIODevice::ReadOnly)) {
-        qCritical() << "Failed to open" << ENTITIES_BACKUP_FILENAME << "in backup";
-        return;
-    }
-    auto rawData = zipFile.readAll();
-
-    zipFile.close();
 
     OctreeUtils::RawEntityData data;
     if (!data.readOctreeDataInfoFromData(rawData)) {
@@ -70,14 +113,44 @@ void EntitiesBackupHandler::recoverBackup(const QString& backupName, QuaZip& zip
 
     data.resetIdAndVersion();
 
-    if (zipFile.getZipError() != UNZ_OK) {
-        qCritical().nospace() << "Failed to unzip " << ENTITIES_BACKUP_FILENAME << ": " << zipFile.getZipError();
-        return;
-    }
-
     QFile entitiesFile { _entitiesReplacementFilePath };
 
     if (entitiesFile.open(QIODevice::WriteOnly)) {
         entitiesFile.write(data.toGzippedByteArray());
     }
 }
+
+void EntitiesBackupHandler::deleteBackup(const QString& backupName) {
+    _chunkStore->releaseBackup(backupName);
+}
+
+void EntitiesBackupHandler::consolidateBackup(const QString& backupName, QuaZip& zip) {
+    QByteArray entityData;
+    if (!_chunkStore->readFile(backupName, ENTITIES_MANIFEST_FILENAME, entityData)) {
+        // the backup already holds the whole entities file
+        return;
+    }
+
+    QByteArray gzippedData;
+    if (!gzip(entityData, gzippedData)) {
+        qCritical() << "Failed to compress entities file for backup";
+        return;
+    }
+
+    QuaZipFile zipFile { &zip };
+    if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(ENTITIES_BACKUP_FILENAME, _entitiesFilePath))) {
+        qCritical().nospace() << "Failed to open " << ENTITIES_BACKUP_FILENAME << " for writing in zip";
+        return;
+    }
+    if (zipFile.write(gzippedData) != gzippedData.size()) {
+        qCritical() << "Failed to write entities file to backup";
+    }
+    zipFile.close();
+    if (zipFile.getZipError() != UNZ_OK) {
+        qCritical().nospace() << "Failed to zip " << ENTITIES_BACKUP_FILENAME << ": " << zipFile.getZipError();
+    }
+}
+
+bool EntitiesBackupHandler::isCorruptedBackup(const QString& backupName) {
+    return _chunkStore->isMissingChunks(backupName);
+}
@@ -13,35 +13,37 @@
 #define hifi_EntitiesBackupHandler_h
 
 #include "BackupHandler.h"
+#include "BackupChunkStore.h"
 
 class EntitiesBackupHandler : public BackupHandlerInterface {
 public:
-    EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath);
+    EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath, BackupChunkStorePointer chunkStore);
 
     std::pair<bool, float> isAvailable(const QString& backupName) override { return { true, 1.0f }; }
     std::pair<bool, float> getRecoveryStatus() override { return { false, 1.0f }; }
 
-    void loadBackup(const QString& backupName, QuaZip& zip) override {}
+    void loadBackup(const QString& backupName, QuaZip& zip) override;
 
-    void loadingComplete() override {}
+    void loadingComplete() override;
 
     // Create a skeleton backup
-    void createBackup(const QString& backupName, QuaZip& zip) override;
+    bool createBackup(const QString& backupName, QuaZip& zip) override;
 
     // Recover from a full backup
     void recoverBackup(const QString& backupName, QuaZip& zip) override;
 
     // Delete a skeleton backup
-    void deleteBackup(const QString& backupName) override {}
+    void deleteBackup(const QString& backupName) override;
 
     // Create a full backup
-    void consolidateBackup(const QString& backupName, QuaZip& zip) override {}
+    void consolidateBackup(const QString& backupName, QuaZip& zip) override;
 
-    bool isCorruptedBackup(const QString& backupName) override { return false; }
+    bool isCorruptedBackup(const QString& backupName) override;
 
 private:
     QString _entitiesFilePath;
     QString _entitiesReplacementFilePath;
+    BackupChunkStorePointer _chunkStore;
 };
 
 #endif /* hifi_EntitiesBackupHandler_h */
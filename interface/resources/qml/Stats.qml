@@ -116,6 +116,11 @@ Item {
                         visible: root.expanded
                         text: "Avatars NOT Updated: " + root.notUpdatedAvatarCount
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: "Avatar Anim LOD Full/Reduced/Frozen: " + root.fullAnimLODAvatarCount + "/" +
+                              root.reducedAnimLODAvatarCount + "/" + root.frozenAnimLODAvatarCount
+                    }
                 }
             }
 
@@ -173,6 +178,11 @@ Item {
                     StatText {
                         text: "Yaw: " + root.yaw.toFixed(1)
                     }
+                    StatText {
+                        visible: root.expanded;
+                        text: "IK: " + root.ikIterations + " iterations, " +
+                            root.ikSolveTime + " usec";
+                    }
                     StatText {
                         visible: root.expanded;
                         text: "Avatar Mixer In: " + root.avatarMixerInKbps + " kbps, " +
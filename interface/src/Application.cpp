@@ -1232,6 +1232,18 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     }
     ResourceCache::setRequestLimit(concurrentDownloads);
 
+    // a backend can have a lower limit so a slow server doesn't take every slot
+    QString concurrentHTTPDownloadsStr = getCmdOption(argc, constArgv, "--concurrent-http-downloads");
+    int concurrentHTTPDownloads = concurrentHTTPDownloadsStr.toInt(&success);
+    if (success) {
+        ResourceCache::setRequestLimit(ResourceRequestBackend::HTTP, concurrentHTTPDownloads);
+    }
+    QString concurrentATPDownloadsStr = getCmdOption(argc, constArgv, "--concurrent-atp-downloads");
+    int concurrentATPDownloads = concurrentATPDownloadsStr.toInt(&success);
+    if (success) {
+        ResourceCache::setRequestLimit(ResourceRequestBackend::ATP, concurrentATPDownloads);
+    }
+
     // perhaps override the avatar url.  Since we will test later for validity
     // we don't need to do so here.
     QString avatarURL = getCmdOption(argc, constArgv, "--avatarURL");
@@ -4645,6 +4657,8 @@ void Application::init() {
     ShapeEntityItem::setShapeInfoCalulator(ShapeEntityItem::ShapeInfoCalculator(&shapeInfoCalculator));
 
     getEntities()->init();
+    // picks, overlaps and searches from scripts and the renderer are answered by a BVH rather than the octree
+    getEntities()->getTree()->setUseBVH(true);
     getEntities()->setEntityLoadingPriorityFunction([this](const EntityItem& item) {
         auto dims = item.getScaledDimensions();
         auto maxSize = glm::compMax(dims);
@@ -5398,6 +5412,19 @@ void Application::update(float deltaTime) {
         _overlays.update(deltaTime);
     }
 
+    {
+        // the download threads pick the next request by these priorities but can't compute them, the
+        // priority functions read the avatar and entities
+        const quint64 RESOURCE_PRIORITY_UPDATE_INTERVAL = USECS_PER_SECOND / 10;
+        quint64 now = usecTimestampNow();
+        if (now - _lastResourcePriorityUpdate > RESOURCE_PRIORITY_UPDATE_INTERVAL) {
+            PROFILE_RANGE(app, "ResourcePriorities");
+            PerformanceTimer perfTimer("resourcePriorities");
+            _lastResourcePriorityUpdate = now;
+            DependencyManager::get<ResourceCacheSharedItems>()->updatePendingRequestPriorities();
+        }
+    }
+
     // Update _viewFrustum with latest camera and view frustum data...
     // NOTE: we get this from the view frustum, to make it simpler, since the
     // loadViewFrumstum() method will get the correct details from the camera
@@ -674,6 +674,7 @@ private:
     uint32_t _nearbyEntitiesCountAtLastPhysicsCheck { 0 }; // how many in-range entities last time we checked physics ready
     uint32_t _nearbyEntitiesStabilityCount { 0 }; // how many times has _nearbyEntitiesCountAtLastPhysicsCheck been the same
     quint64 _lastPhysicsCheckTime { usecTimestampNow() }; // when did we last check to see if physics was ready
+    quint64 _lastResourcePriorityUpdate { 0 };
 
     bool _keyboardDeviceHasFocus { true };
 
@@ -498,6 +498,14 @@ Menu::Menu() {
         });
     }
 
+    {
+        auto action = addActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::RenderClearGeometryCache);
+        connect(action, &QAction::triggered, []{
+            Setting::Handle<int>(GeometryFileCache::SETTING_VERSION_NAME, GeometryFileCache::INVALID_VERSION)
+                .set(GeometryFileCache::INVALID_VERSION);
+        });
+    }
+
     // Developer > Render > LOD Tools
     addActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::LodTools, 0,
                                   qApp, SLOT(loadLODToolsDialog()));
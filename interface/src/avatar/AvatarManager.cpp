@@ -13,6 +13,8 @@
 
 #include <QScriptEngine>
 
+#include <tbb/parallel_for.h>
+
 #if defined(__GNUC__) && !defined(__clang__)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdouble-promotion"
@@ -49,6 +51,9 @@
 const int CLIENT_TO_AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 50;
 static const quint64 MIN_TIME_BETWEEN_MY_AVATAR_DATA_SENDS = USECS_PER_SECOND / CLIENT_TO_AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND;
 
+static const float DEFAULT_REDUCED_ANIM_LOD_DISTANCE = 10.0f; // meters, for an avatar of scale 1
+static Setting::Handle<float> reducedAnimLODDistance("reducedAnimLODDistance", DEFAULT_REDUCED_ANIM_LOD_DISTANCE);
+
 // We add _myAvatar into the hash with all the other AvatarData, and we use the default NULL QUid as the key.
 const QUuid MY_AVATAR_KEY;  // NULL key
 
@@ -175,21 +180,72 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
         ++itr;
     }
 
-    // process in sorted order
+    // drain the queue, the avatars are visited twice
+    std::vector<SortableAvatar> sortedAvatarVector;
+    sortedAvatarVector.reserve(sortedAvatars.size());
+    while (!sortedAvatars.empty()) {
+        sortedAvatarVector.push_back(sortedAvatars.top());
+        sortedAvatars.pop();
+    }
+
+    const float OUT_OF_VIEW_THRESHOLD = 0.5f * AvatarData::OUT_OF_VIEW_PENALTY;
     uint64_t startTime = usecTimestampNow();
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    // Pick the animation LOD of every avatar, far ones update their poses less often and those out of view not at all
+    int numAvatarsAtAnimLOD[(int)Rig::AnimLOD::NumLODs] = { 0 };
+    {
+        const float reducedLODDistance = reducedAnimLODDistance.get();
+        for (const auto& sortData : sortedAvatarVector) {
+            const auto avatar = std::static_pointer_cast<Avatar>(sortData.getAvatar());
+            if (nodeList->isPersonalMutingNode(avatar->getID())) {
+                continue;
+            }
+            Rig::AnimLOD lod = Rig::AnimLOD::Frozen;
+            if (sortData.getPriority() > OUT_OF_VIEW_THRESHOLD) {
+                float distance = glm::distance(cameraView.getPosition(), avatar->getWorldPosition());
+                lod = distance > reducedLODDistance * avatar->getModelScale() ? Rig::AnimLOD::Reduced : Rig::AnimLOD::Full;
+            }
+            avatar->setAnimLOD(lod, deltaTime);
+            numAvatarsAtAnimLOD[(int)lod]++;
+        }
+    }
+
+    // The rigs of other avatars are independent, so the joint data of the avatars in view is turned into rig poses
+    // on the workers.  Each rig publishes its poses through its external pose set, the rest stays on this thread.
+    {
+        PROFILE_RANGE(simulation, "jointPoses");
+        std::vector<Avatar*> avatarsWithNewJointData;
+        for (const auto& sortData : sortedAvatarVector) {
+            if (sortData.getPriority() <= OUT_OF_VIEW_THRESHOLD) {
+                break;
+            }
+            const auto avatar = std::static_pointer_cast<Avatar>(sortData.getAvatar());
+            if (avatar->isJointPoseUpdateDue() && !nodeList->isPersonalMutingNode(avatar->getID())) {
+                avatarsWithNewJointData.push_back(avatar.get());
+            }
+        }
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, avatarsWithNewJointData.size()),
+                          [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                avatarsWithNewJointData[i]->updateJointPoses();
+            }
+        });
+    }
+
+    // process in sorted order
     const uint64_t UPDATE_BUDGET = 2000; // usec
     uint64_t updateExpiry = startTime + UPDATE_BUDGET;
     int numAvatarsUpdated = 0;
     int numAVatarsNotUpdated = 0;
 
     render::Transaction transaction;
-    while (!sortedAvatars.empty()) {
-        const SortableAvatar& sortData = sortedAvatars.top();
+    for (size_t i = 0; i < sortedAvatarVector.size(); ++i) {
+        const SortableAvatar& sortData = sortedAvatarVector[i];
         const auto avatar = std::static_pointer_cast<Avatar>(sortData.getAvatar());
 
-        bool ignoring = DependencyManager::get<NodeList>()->isPersonalMutingNode(avatar->getID());
+        bool ignoring = nodeList->isPersonalMutingNode(avatar->getID());
         if (ignoring) {
-            sortedAvatars.pop();
             continue;
         }
 
@@ -211,12 +267,11 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
         }
         avatar->animateScaleChanges(deltaTime);
 
-        const float OUT_OF_VIEW_THRESHOLD = 0.5f * AvatarData::OUT_OF_VIEW_PENALTY;
         uint64_t now = usecTimestampNow();
         if (now < updateExpiry) {
             // we're within budget
             bool inView = sortData.getPriority() > OUT_OF_VIEW_THRESHOLD;
-            if (inView && avatar->hasNewJointData()) {
+            if (inView && avatar->isJointPoseUpdateDue()) {
                 numAvatarsUpdated++;
             }
             avatar->simulate(deltaTime, inView);
@@ -229,26 +284,17 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
             // --> some avatar velocity measurements may be a little off
 
             // no time simulate, but we take the time to count how many were tragically missed
-            bool inView = sortData.getPriority() > OUT_OF_VIEW_THRESHOLD;
-            if (!inView) {
-                break;
-            }
-            if (inView && avatar->hasNewJointData()) {
-                numAVatarsNotUpdated++;
-            }
-            sortedAvatars.pop();
-            while (inView && !sortedAvatars.empty()) {
-                const SortableAvatar& newSortData = sortedAvatars.top();
-                const auto newAvatar = std::static_pointer_cast<Avatar>(newSortData.getAvatar());
-                inView = newSortData.getPriority() > OUT_OF_VIEW_THRESHOLD;
-                if (inView && newAvatar->hasNewJointData()) {
+            for (; i < sortedAvatarVector.size(); ++i) {
+                const SortableAvatar& missedSortData = sortedAvatarVector[i];
+                if (missedSortData.getPriority() <= OUT_OF_VIEW_THRESHOLD) {
+                    break;
+                }
+                if (std::static_pointer_cast<Avatar>(missedSortData.getAvatar())->isJointPoseUpdateDue()) {
                     numAVatarsNotUpdated++;
                 }
-                sortedAvatars.pop();
             }
             break;
         }
-        sortedAvatars.pop();
     }
 
     if (_shouldRender) {
@@ -268,6 +314,7 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 
     _numAvatarsUpdated = numAvatarsUpdated;
     _numAvatarsNotUpdated = numAVatarsNotUpdated;
+    std::copy(std::begin(numAvatarsAtAnimLOD), std::end(numAvatarsAtAnimLOD), std::begin(_numAvatarsAtAnimLOD));
 
     simulateAvatarFades(deltaTime);
 
@@ -565,6 +612,14 @@ RayToAvatarIntersectionResult AvatarManager::findRayIntersectionVector(const Pic
     return result;
 }
 
+float AvatarManager::getReducedAnimLODDistance() const {
+    return reducedAnimLODDistance.get();
+}
+
+void AvatarManager::setReducedAnimLODDistance(float distance) {
+    reducedAnimLODDistance.set(std::max(distance, 0.0f));
+}
+
 // HACK
 float AvatarManager::getAvatarSortCoefficient(const QString& name) {
     if (name == "size") {
@@ -50,6 +50,7 @@ public:
 
     int getNumAvatarsUpdated() const { return _numAvatarsUpdated; }
     int getNumAvatarsNotUpdated() const { return _numAvatarsNotUpdated; }
+    int getNumAvatarsAtAnimLOD(Rig::AnimLOD lod) const { return _numAvatarsAtAnimLOD[(int)lod]; }
     float getAvatarSimulationTime() const { return _avatarSimulationTime; }
 
     void updateMyAvatar(float deltaTime);
@@ -77,6 +78,11 @@ public:
                                                                         const QVector<EntityItemID>& avatarsToInclude,
                                                                         const QVector<EntityItemID>& avatarsToDiscard);
 
+    // Avatars in view further than this from the camera, in multiples of their scale, are animated at reduced LOD.
+    // Avatars out of view are frozen.
+    Q_INVOKABLE float getReducedAnimLODDistance() const;
+    Q_INVOKABLE void setReducedAnimLODDistance(float distance);
+
     // TODO: remove this HACK once we settle on optimal default sort coefficients
     Q_INVOKABLE float getAvatarSortCoefficient(const QString& name);
     Q_INVOKABLE void setAvatarSortCoefficient(const QString& name, const QScriptValue& value);
@@ -112,6 +118,7 @@ private:
     RateCounter<> _myAvatarSendRate;
     int _numAvatarsUpdated { 0 };
     int _numAvatarsNotUpdated { 0 };
+    int _numAvatarsAtAnimLOD[(int)Rig::AnimLOD::NumLODs] { 0 };
     float _avatarSimulationTime { 0.0f };
     bool _shouldRender { true };
 };
@@ -3409,6 +3409,14 @@ float MyAvatar::getIKErrorOnLastSolve() const {
     return _skeletonModel->getRig().getIKErrorOnLastSolve();
 }
 
+int MyAvatar::getIKIterationsOnLastSolve() const {
+    return _skeletonModel->getRig().getIKIterationsOnLastSolve();
+}
+
+int MyAvatar::getIKSolveTimeOnLastSolve() const {
+    return (int)_skeletonModel->getRig().getIKSolveTimeOnLastSolve();
+}
+
 // thread-safe
 void MyAvatar::addHoldAction(AvatarActionHold* holdAction) {
     std::lock_guard<std::mutex> guard(_holdActionsMutex);
@@ -484,6 +484,8 @@ public:
     Q_INVOKABLE bool clearPinOnJoint(int index);
 
     Q_INVOKABLE float getIKErrorOnLastSolve() const;
+    Q_INVOKABLE int getIKIterationsOnLastSolve() const;
+    Q_INVOKABLE int getIKSolveTimeOnLastSolve() const; // usecs
 
     Q_INVOKABLE void useFullAvatarURL(const QUrl& fullAvatarURL, const QString& modelName = QString());
     Q_INVOKABLE QUrl getFullAvatarURLFromPreferences() const { return _fullAvatarURLFromPreferences; }
@@ -123,6 +123,9 @@ void Stats::updateStats(bool force) {
     STAT_UPDATE(avatarCount, avatarManager->size() - 1);
     STAT_UPDATE(updatedAvatarCount, avatarManager->getNumAvatarsUpdated());
     STAT_UPDATE(notUpdatedAvatarCount, avatarManager->getNumAvatarsNotUpdated());
+    STAT_UPDATE(fullAnimLODAvatarCount, avatarManager->getNumAvatarsAtAnimLOD(Rig::AnimLOD::Full));
+    STAT_UPDATE(reducedAnimLODAvatarCount, avatarManager->getNumAvatarsAtAnimLOD(Rig::AnimLOD::Reduced));
+    STAT_UPDATE(frozenAnimLODAvatarCount, avatarManager->getNumAvatarsAtAnimLOD(Rig::AnimLOD::Frozen));
     STAT_UPDATE(serverCount, (int)nodeList->size());
     STAT_UPDATE_FLOAT(renderrate, qApp->getRenderLoopRate(), 0.1f);
     if (qApp->getActiveDisplayPlugin()) {
@@ -209,6 +212,8 @@ void Stats::updateStats(bool force) {
             STAT_UPDATE(avatarMixerOutPps, -1);
         }
         STAT_UPDATE_FLOAT(myAvatarSendRate, avatarManager->getMyAvatarSendRate(), 0.1f);
+        STAT_UPDATE(ikIterations, myAvatar->getIKIterationsOnLastSolve());
+        STAT_UPDATE(ikSolveTime, myAvatar->getIKSolveTimeOnLastSolve());
 
         SharedNodePointer audioMixerNode = nodeList->soloNodeOfType(NodeType::AudioMixer);
         auto audioClient = DependencyManager::get<AudioClient>();
@@ -49,6 +49,9 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, avatarCount, 0)
     STATS_PROPERTY(int, updatedAvatarCount, 0)
     STATS_PROPERTY(int, notUpdatedAvatarCount, 0)
+    STATS_PROPERTY(int, fullAnimLODAvatarCount, 0)
+    STATS_PROPERTY(int, reducedAnimLODAvatarCount, 0)
+    STATS_PROPERTY(int, frozenAnimLODAvatarCount, 0)
     STATS_PROPERTY(int, packetInCount, 0)
     STATS_PROPERTY(int, packetOutCount, 0)
     STATS_PROPERTY(float, mbpsIn, 0)
@@ -63,6 +66,8 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(QVector3D, position, QVector3D(0, 0, 0))
     STATS_PROPERTY(float, speed, 0)
     STATS_PROPERTY(float, yaw, 0)
+    STATS_PROPERTY(int, ikIterations, 0)
+    STATS_PROPERTY(int, ikSolveTime, 0)
     STATS_PROPERTY(int, avatarMixerInKbps, 0)
     STATS_PROPERTY(int, avatarMixerInPps, 0)
     STATS_PROPERTY(int, avatarMixerOutKbps, 0)
@@ -177,6 +182,9 @@ signals:
     void avatarCountChanged();
     void updatedAvatarCountChanged();
     void notUpdatedAvatarCountChanged();
+    void fullAnimLODAvatarCountChanged();
+    void reducedAnimLODAvatarCountChanged();
+    void frozenAnimLODAvatarCountChanged();
     void packetInCountChanged();
     void packetOutCountChanged();
     void mbpsInChanged();
@@ -191,6 +199,8 @@ signals:
     void positionChanged();
     void speedChanged();
     void yawChanged();
+    void ikIterationsChanged();
+    void ikSolveTimeChanged();
     void avatarMixerInKbpsChanged();
     void avatarMixerInPpsChanged();
     void avatarMixerOutKbpsChanged();
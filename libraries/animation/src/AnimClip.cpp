@@ -8,6 +8,8 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <QThreadPool>
+
 #include "GLMHelpers.h"
 #include "AnimClip.h"
 #include "AnimationLogging.h"
@@ -43,17 +45,27 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
 
     // poll network anim to see if it's finished loading yet.
     if (_networkAnim && _networkAnim->isLoaded() && _skeleton) {
-        // loading is complete, copy animation frames from network animation, then throw it away.
-        copyFromNetworkAnim();
+        // loading is complete, build the frames from the network animation in a worker thread, then throw it away.
+        // compressing them here would stall the graph
+        bool buildMirror = _mirrorFlag || !_mirrorFlagVar.isEmpty();
+        _pendingFrames = std::make_shared<AnimClipFrames>();
+        QThreadPool::globalInstance()->start(new AnimClipBuilder(_networkAnim, _skeleton, _url, _tolerance, buildMirror,
+                                                                 _pendingFrames));
         _networkAnim.reset();
+    } else if (_mirrorFlag && _frames && !_frames->hasMirror && !_pendingFrames) {
+        // the mirror is only built with the frames of the clips that can be mirrored
+        _pendingFrames = std::make_shared<AnimClipFrames>();
+        QThreadPool::globalInstance()->start(new AnimClipBuilder(_frames, _skeleton, _url, _tolerance, _pendingFrames));
     }
 
-    if (_anim.size()) {
+    if (_pendingFrames && _pendingFrames->isBuilt) {
+        _frames = _pendingFrames;
+        _pendingFrames.reset();
+        _poses.resize(_frames->numJoints);
+        _nextPoses.resize(_frames->numJoints);
+    }
 
-        // lazy creation of mirrored animation frames.
-        if (_mirrorFlag && _anim.size() != _mirrorAnim.size()) {
-            buildMirrorAnim();
-        }
+    if (_frames && _frames->numFrames > 0) {
 
         int prevIndex = (int)glm::floor(_frame);
         int nextIndex;
@@ -65,15 +77,30 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
 
         // It can be quite possible for the user to set _startFrame and _endFrame to
         // values before or past valid ranges.  We clamp the frames here.
-        int frameCount = (int)_anim.size();
+        int frameCount = _frames->numFrames;
         prevIndex = std::min(std::max(0, prevIndex), frameCount - 1);
         nextIndex = std::min(std::max(0, nextIndex), frameCount - 1);
 
-        const AnimPoseVec& prevFrame = _mirrorFlag ? _mirrorAnim[prevIndex] : _anim[prevIndex];
-        const AnimPoseVec& nextFrame = _mirrorFlag ? _mirrorAnim[nextIndex] : _anim[nextIndex];
+        // until its mirror is built the clip plays unmirrored
+        bool mirror = _mirrorFlag && _frames->hasMirror;
         float alpha = glm::fract(_frame);
 
-        ::blend(_poses.size(), &prevFrame[0], &nextFrame[0], alpha, &_poses[0]);
+        if (!_frames->anim.isEmpty()) {
+            const AnimCompressedClip& anim = mirror ? _frames->mirrorAnim : _frames->anim;
+            if (nextIndex == prevIndex) {
+                anim.sample((float)prevIndex, _poses.data());
+            } else if (nextIndex == prevIndex + 1) {
+                // the clip interpolates between frames itself
+                anim.sample((float)prevIndex + alpha, _poses.data());
+            } else {
+                anim.sample((float)prevIndex, _poses.data());
+                anim.sample((float)nextIndex, _nextPoses.data());
+                ::blend(_poses.size(), &_poses[0], &_nextPoses[0], alpha, &_poses[0]);
+            }
+        } else {
+            const std::vector<AnimPoseVec>& anim = mirror ? _frames->uncompressedMirrorAnim : _frames->uncompressedAnim;
+            ::blend(_poses.size(), &anim[prevIndex][0], &anim[nextIndex][0], alpha, &_poses[0]);
+        }
     }
 
     return _poses;
@@ -82,6 +109,8 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
 void AnimClip::loadURL(const QString& url) {
     auto animCache = DependencyManager::get<AnimationCache>();
     _networkAnim = animCache->getAnimation(url);
+    _tolerance = animCache->getClipCompressionTolerance();
+    _pendingFrames.reset();
     _url = url;
 }
 
@@ -92,93 +121,6 @@ void AnimClip::setCurrentFrameInternal(float frame) {
     _frame = ::accumulateTime(_startFrame, _endFrame, _timeScale, frame + _startFrame, dt, _loopFlag, _id, triggers);
 }
 
-void AnimClip::copyFromNetworkAnim() {
-    assert(_networkAnim && _networkAnim->isLoaded() && _skeleton);
-    _anim.clear();
-
-    // build a mapping from animation joint indices to skeleton joint indices.
-    // by matching joints with the same name.
-    const FBXGeometry& geom = _networkAnim->getGeometry();
-    AnimSkeleton animSkeleton(geom);
-    const auto animJointCount = animSkeleton.getNumJoints();
-    const auto skeletonJointCount = _skeleton->getNumJoints();
-    std::vector<int> jointMap;
-    jointMap.reserve(animJointCount);
-    for (int i = 0; i < animJointCount; i++) {
-        int skeletonJoint = _skeleton->nameToJointIndex(animSkeleton.getJointName(i));
-        if (skeletonJoint == -1) {
-            qCWarning(animation) << "animation contains joint =" << animSkeleton.getJointName(i) << " which is not in the skeleton, url =" << _url;
-        }
-        jointMap.push_back(skeletonJoint);
-    }
-
-    const int frameCount = geom.animationFrames.size();
-    _anim.resize(frameCount);
-
-    for (int frame = 0; frame < frameCount; frame++) {
-
-        const FBXAnimationFrame& fbxAnimFrame = geom.animationFrames[frame];
-
-        // init all joints in animation to default pose
-        // this will give us a resonable result for bones in the model skeleton but not in the animation.
-        _anim[frame].reserve(skeletonJointCount);
-        for (int skeletonJoint = 0; skeletonJoint < skeletonJointCount; skeletonJoint++) {
-            _anim[frame].push_back(_skeleton->getRelativeDefaultPose(skeletonJoint));
-        }
-
-        for (int animJoint = 0; animJoint < animJointCount; animJoint++) {
-            int skeletonJoint = jointMap[animJoint];
-
-            const glm::vec3& fbxAnimTrans = fbxAnimFrame.translations[animJoint];
-            const glm::quat& fbxAnimRot = fbxAnimFrame.rotations[animJoint];
-
-            // skip joints that are in the animation but not in the skeleton.
-            if (skeletonJoint >= 0 && skeletonJoint < skeletonJointCount) {
-
-                AnimPose preRot, postRot;
-                preRot = animSkeleton.getPreRotationPose(animJoint);
-                postRot = animSkeleton.getPostRotationPose(animJoint);
-
-                // cancel out scale
-                preRot.scale() = glm::vec3(1.0f);
-                postRot.scale() = glm::vec3(1.0f);
-
-                AnimPose rot(glm::vec3(1.0f), fbxAnimRot, glm::vec3());
-
-                // adjust translation offsets, so large translation animatons on the reference skeleton
-                // will be adjusted when played on a skeleton with short limbs.
-                const glm::vec3& fbxZeroTrans = geom.animationFrames[0].translations[animJoint];
-                const AnimPose& relDefaultPose = _skeleton->getRelativeDefaultPose(skeletonJoint);
-                float boneLengthScale = 1.0f;
-                const float EPSILON = 0.0001f;
-                if (fabsf(glm::length(fbxZeroTrans)) > EPSILON) {
-                    boneLengthScale = glm::length(relDefaultPose.trans()) / glm::length(fbxZeroTrans);
-                }
-
-                AnimPose trans = AnimPose(glm::vec3(1.0f), glm::quat(), relDefaultPose.trans() + boneLengthScale * (fbxAnimTrans - fbxZeroTrans));
-
-                _anim[frame][skeletonJoint] = trans * preRot * rot * postRot;
-            }
-        }
-    }
-
-    // mirrorAnim will be re-built on demand, if needed.
-    _mirrorAnim.clear();
-
-    _poses.resize(skeletonJointCount);
-}
-
-void AnimClip::buildMirrorAnim() {
-    assert(_skeleton);
-
-    _mirrorAnim.clear();
-    _mirrorAnim.reserve(_anim.size());
-    for (auto& relPoses : _anim) {
-        _mirrorAnim.push_back(relPoses);
-        _skeleton->mirrorRelativePoses(_mirrorAnim.back());
-    }
-}
-
 const AnimPoseVec& AnimClip::getPosesInternal() const {
     return _poses;
 }
@@ -13,6 +13,7 @@
 
 #include <string>
 #include "AnimationCache.h"
+#include "AnimCompressedClip.h"
 #include "AnimNode.h"
 
 // Playback a single animation timeline.
@@ -56,18 +57,16 @@ protected:
 
     virtual void setCurrentFrameInternal(float frame) override;
 
-    void copyFromNetworkAnim();
-    void buildMirrorAnim();
-
     // for AnimDebugDraw rendering
     virtual const AnimPoseVec& getPosesInternal() const override;
 
     AnimationPointer _networkAnim;
     AnimPoseVec _poses;
+    AnimPoseVec _nextPoses; // when looping from the end frame back to the start frame
 
-    // _anim[frame][joint]
-    std::vector<AnimPoseVec> _anim;
-    std::vector<AnimPoseVec> _mirrorAnim;
+    AnimCompressedClip::Tolerance _tolerance;
+    std::shared_ptr<const AnimClipFrames> _frames;
+    AnimClipFramesPointer _pendingFrames; // being built by an AnimClipBuilder
 
     QString _url;
     float _startFrame;
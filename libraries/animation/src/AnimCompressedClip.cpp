@@ -0,0 +1,366 @@
+//
+//  AnimCompressedClip.cpp
+//  libraries/animation/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimCompressedClip.h"
+
+#include <assert.h>
+#include <algorithm>
+#include <limits>
+
+#include <GLMHelpers.h>
+
+const float AnimCompressedClip::DEFAULT_ROTATION_TOLERANCE = 0.001f;     // radians, about 0.06 degrees
+const float AnimCompressedClip::DEFAULT_TRANSLATION_TOLERANCE = 0.001f;  // a thousandth of the bone
+const float AnimCompressedClip::DEFAULT_SCALE_TOLERANCE = 0.001f;
+
+static const float ROTATION_QUANTIZATION = 32767.0f;
+
+// a key every so many frames at least, which bounds the cost of looking for the keys at load time
+static const int MAX_FRAMES_BETWEEN_KEYS = 32;
+
+static inline void quantizeRotation(const glm::quat& rotation, int16_t* quantizedOut) {
+    quantizedOut[0] = (int16_t)glm::round(rotation.x * ROTATION_QUANTIZATION);
+    quantizedOut[1] = (int16_t)glm::round(rotation.y * ROTATION_QUANTIZATION);
+    quantizedOut[2] = (int16_t)glm::round(rotation.z * ROTATION_QUANTIZATION);
+    quantizedOut[3] = (int16_t)glm::round(rotation.w * ROTATION_QUANTIZATION);
+}
+
+static inline glm::quat dequantizeRotation(const int16_t* quantized) {
+    glm::quat rotation((float)quantized[3], (float)quantized[0], (float)quantized[1], (float)quantized[2]);
+    return glm::normalize(rotation / ROTATION_QUANTIZATION);
+}
+
+// |q1 - q2|, of the closer of q2 and -q2
+static inline float quatDistance(const glm::quat& q1, const glm::quat& q2) {
+    float sign = glm::dot(q1, q2) < 0.0f ? -1.0f : 1.0f;
+    return glm::length(glm::vec4(q1.x - sign * q2.x, q1.y - sign * q2.y, q1.z - sign * q2.z, q1.w - sign * q2.w));
+}
+
+static inline glm::quat nlerp(const glm::quat& a, const glm::quat& b, float alpha) {
+    glm::quat c = glm::dot(a, b) < 0.0f ? -b : b;
+    return glm::normalize(a * (1.0f - alpha) + c * alpha);
+}
+
+// Greedy keyframe reduction.  Every key is followed by the furthest frame that linear interpolation from the key
+// reproduces all the frames in between of.  isWithinTolerance(a, b, i) says whether interpolating between frames a
+// and b gives frame i.
+template <typename ErrorFunction>
+static std::vector<int> findKeys(int numFrames, ErrorFunction isWithinTolerance) {
+    std::vector<int> keys;
+    keys.push_back(0);
+
+    // constant tracks need a single key
+    bool isConstant = true;
+    for (int i = 1; i < numFrames && isConstant; i++) {
+        isConstant = isWithinTolerance(0, 0, i);
+    }
+    if (isConstant) {
+        return keys;
+    }
+
+    int key = 0;
+    while (key < numFrames - 1) {
+        int nextKey = key + 1;
+        int lastCandidate = std::min(numFrames - 1, key + MAX_FRAMES_BETWEEN_KEYS);
+        for (int candidate = key + 2; candidate <= lastCandidate; candidate++) {
+            bool fits = true;
+            for (int i = key + 1; i < candidate && fits; i++) {
+                fits = isWithinTolerance(key, candidate, i);
+            }
+            if (!fits) {
+                break;
+            }
+            nextKey = candidate;
+        }
+        keys.push_back(nextKey);
+        key = nextKey;
+    }
+    return keys;
+}
+
+static inline float interpolationAlpha(int a, int b, int i) {
+    return b > a ? (float)(i - a) / (float)(b - a) : 0.0f;
+}
+
+void AnimCompressedClip::compressRotations(const std::vector<glm::quat>& rotations, float tolerance, Track& trackOut) {
+    const int numFrames = (int)rotations.size();
+
+    // the error is measured against the quantized keys, so it includes the quantization error
+    std::vector<int16_t> quantized(4 * numFrames);
+    std::vector<glm::quat> dequantized(numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        quantizeRotation(rotations[i], &quantized[4 * i]);
+        dequantized[i] = dequantizeRotation(&quantized[4 * i]);
+    }
+
+    // The angle between unit quaternions q1 and q2 is 4 * asin(|q1 - q2| / 2), when they are in the same hemisphere.
+    // Unlike 2 * acos(dot(q1, q2)) it stays accurate in floats for small angles.
+    const float maxDistance = 2.0f * sinf(0.25f * tolerance);
+    auto keys = findKeys(numFrames, [&](int a, int b, int i) {
+        glm::quat rotation = nlerp(dequantized[a], dequantized[b], interpolationAlpha(a, b, i));
+        return quatDistance(rotation, rotations[i]) <= maxDistance;
+    });
+
+    trackOut.firstKey = (uint32_t)_keyFrames.size();
+    trackOut.firstValue = (uint32_t)(_rotations.size() / 4);
+    trackOut.numKeys = (uint32_t)keys.size();
+    for (int key : keys) {
+        _keyFrames.push_back((uint16_t)key);
+        _rotations.insert(_rotations.end(), &quantized[4 * key], &quantized[4 * key] + 4);
+    }
+}
+
+void AnimCompressedClip::compressTranslations(const std::vector<glm::vec3>& translations, float tolerance,
+                                              JointTracks& jointOut) {
+    const int numFrames = (int)translations.size();
+
+    // quantize to the range of the track
+    glm::vec3 minTranslation = translations[0];
+    glm::vec3 maxTranslation = translations[0];
+    float boneLength = 0.0f;
+    for (auto& translation : translations) {
+        minTranslation = glm::min(minTranslation, translation);
+        maxTranslation = glm::max(maxTranslation, translation);
+        boneLength = std::max(boneLength, glm::length(translation));
+    }
+    const float MAX_QUANTIZED = (float)std::numeric_limits<uint16_t>::max();
+    glm::vec3 step = (maxTranslation - minTranslation) / MAX_QUANTIZED;
+    glm::vec3 invStep;
+    for (int k = 0; k < 3; k++) {
+        invStep[k] = step[k] > 0.0f ? 1.0f / step[k] : 0.0f;
+    }
+
+    std::vector<uint16_t> quantized(3 * numFrames);
+    std::vector<glm::vec3> dequantized(numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        glm::vec3 rounded = glm::round((translations[i] - minTranslation) * invStep);
+        for (int k = 0; k < 3; k++) {
+            quantized[3 * i + k] = (uint16_t)glm::clamp(rounded[k], 0.0f, MAX_QUANTIZED);
+        }
+        glm::vec3 q = glm::vec3((float)quantized[3 * i], (float)quantized[3 * i + 1], (float)quantized[3 * i + 2]);
+        dequantized[i] = minTranslation + step * q;
+    }
+
+    const float maxDistance = tolerance * boneLength;
+    auto keys = findKeys(numFrames, [&](int a, int b, int i) {
+        glm::vec3 translation = lerp(dequantized[a], dequantized[b], interpolationAlpha(a, b, i));
+        return glm::distance(translation, translations[i]) <= maxDistance;
+    });
+
+    Track& track = jointOut.translation;
+    track.firstKey = (uint32_t)_keyFrames.size();
+    track.firstValue = (uint32_t)(_translations.size() / 3);
+    track.numKeys = (uint32_t)keys.size();
+    for (int key : keys) {
+        _keyFrames.push_back((uint16_t)key);
+        _translations.insert(_translations.end(), &quantized[3 * key], &quantized[3 * key] + 3);
+    }
+    jointOut.translationMin = minTranslation;
+    jointOut.translationStep = step;
+}
+
+void AnimCompressedClip::compressScales(const std::vector<glm::vec3>& scales, float tolerance, Track& trackOut) {
+    auto keys = findKeys((int)scales.size(), [&](int a, int b, int i) {
+        glm::vec3 scale = lerp(scales[a], scales[b], interpolationAlpha(a, b, i));
+        return glm::distance(scale, scales[i]) <= tolerance;
+    });
+
+    trackOut.firstKey = (uint32_t)_keyFrames.size();
+    trackOut.firstValue = (uint32_t)_scales.size();
+    trackOut.numKeys = (uint32_t)keys.size();
+    for (int key : keys) {
+        _keyFrames.push_back((uint16_t)key);
+        _scales.push_back(scales[key]);
+    }
+}
+
+bool AnimCompressedClip::compress(const std::vector<AnimPoseVec>& frames, const Tolerance& tolerance) {
+    clear();
+
+    // key frames are 16 bits
+    if (frames.size() > (size_t)std::numeric_limits<uint16_t>::max() + 1) {
+        return false;
+    }
+    if (frames.empty()) {
+        return true;
+    }
+
+    const int numFrames = (int)frames.size();
+    const int numJoints = (int)frames[0].size();
+    _joints.resize(numJoints);
+
+    std::vector<glm::quat> rotations(numFrames);
+    std::vector<glm::vec3> translations(numFrames);
+    std::vector<glm::vec3> scales(numFrames);
+    for (int joint = 0; joint < numJoints; joint++) {
+        for (int frame = 0; frame < numFrames; frame++) {
+            const AnimPose& pose = frames[frame][joint];
+
+            // keep consecutive rotations in the same hemisphere, so they interpolate the short way
+            glm::quat rotation = glm::normalize(pose.rot());
+            if (frame > 0 && glm::dot(rotation, rotations[frame - 1]) < 0.0f) {
+                rotation = -rotation;
+            }
+            rotations[frame] = rotation;
+            translations[frame] = pose.trans();
+            scales[frame] = pose.scale();
+        }
+        compressRotations(rotations, tolerance.rotation, _joints[joint].rotation);
+        compressTranslations(translations, tolerance.translation, _joints[joint].translation);
+        compressScales(scales, tolerance.scale, _joints[joint].scale);
+    }
+
+    // the last translation key is loaded with 64 bits too
+    _translations.push_back(0);
+
+    _joints.shrink_to_fit();
+    _keyFrames.shrink_to_fit();
+    _rotations.shrink_to_fit();
+    _translations.shrink_to_fit();
+    _scales.shrink_to_fit();
+    _numFrames = numFrames;
+    return true;
+}
+
+void AnimCompressedClip::clear() {
+    _joints.clear();
+    _keyFrames.clear();
+    _rotations.clear();
+    _translations.clear();
+    _scales.clear();
+    _numFrames = 0;
+}
+
+// the keys of a track before and after frame, as offsets from the first key of the track, and how far between
+// them frame is
+static inline void findKeyPair(const uint16_t* keyFrames, uint32_t numKeys, float frame,
+                               uint32_t& keyOut, uint32_t& nextKeyOut, float& alphaOut) {
+    if (numKeys < 2) {
+        keyOut = nextKeyOut = 0;
+        alphaOut = 0.0f;
+        return;
+    }
+    const uint16_t* next = std::upper_bound(keyFrames, keyFrames + numKeys, frame);
+    keyOut = (uint32_t)std::min(std::max((int)(next - keyFrames) - 1, 0), (int)numKeys - 2);
+    nextKeyOut = keyOut + 1;
+    float start = (float)keyFrames[keyOut];
+    float end = (float)keyFrames[nextKeyOut];
+    alphaOut = glm::clamp((frame - start) / (end - start), 0.0f, 1.0f);
+}
+
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+// horizontal sum of the four lanes, in all four lanes
+static inline __m128 dot4(__m128 a, __m128 b) {
+    __m128 d = _mm_mul_ps(a, b);
+    d = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+static inline glm::quat interpolateRotation(const int16_t* a, const int16_t* b, float alpha) {
+    const __m128 scale = _mm_set1_ps(1.0f / ROTATION_QUANTIZATION);
+
+    // sign extend the 16 bit components to 32 bits
+    __m128i qa = _mm_loadl_epi64((const __m128i*)a);
+    __m128i qb = _mm_loadl_epi64((const __m128i*)b);
+    __m128 x = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(qa, qa), 16)), scale);
+    __m128 y = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(qb, qb), 16)), scale);
+
+    // adjust signs if necessary
+    __m128 sign = _mm_and_ps(_mm_cmplt_ps(dot4(x, y), _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+    y = _mm_xor_ps(y, sign);
+
+    __m128 r = _mm_add_ps(x, _mm_mul_ps(_mm_sub_ps(y, x), _mm_set1_ps(alpha)));
+    r = _mm_div_ps(r, _mm_sqrt_ps(dot4(r, r)));
+
+    float q[4];
+    _mm_storeu_ps(q, r);
+    return glm::quat(q[3], q[0], q[1], q[2]);
+}
+
+static inline glm::vec3 interpolateTranslation(const uint16_t* a, const uint16_t* b, float alpha,
+                                               const glm::vec3& min, const glm::vec3& step) {
+    // zero extend the 16 bit components to 32 bits, the fourth one belongs to the next key
+    const __m128i zero = _mm_setzero_si128();
+    __m128 x = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)a), zero));
+    __m128 y = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)b), zero));
+    __m128 q = _mm_add_ps(x, _mm_mul_ps(_mm_sub_ps(y, x), _mm_set1_ps(alpha)));
+    __m128 t = _mm_add_ps(_mm_setr_ps(min.x, min.y, min.z, 0.0f),
+                          _mm_mul_ps(q, _mm_setr_ps(step.x, step.y, step.z, 0.0f)));
+
+    float v[4];
+    _mm_storeu_ps(v, t);
+    return glm::vec3(v[0], v[1], v[2]);
+}
+
+#else   // portable reference code
+
+static inline glm::quat interpolateRotation(const int16_t* a, const int16_t* b, float alpha) {
+    glm::quat x((float)a[3], (float)a[0], (float)a[1], (float)a[2]);
+    glm::quat y((float)b[3], (float)b[0], (float)b[1], (float)b[2]);
+    return nlerp(x / ROTATION_QUANTIZATION, y / ROTATION_QUANTIZATION, alpha);
+}
+
+static inline glm::vec3 interpolateTranslation(const uint16_t* a, const uint16_t* b, float alpha,
+                                               const glm::vec3& min, const glm::vec3& step) {
+    glm::vec3 q = lerp(glm::vec3((float)a[0], (float)a[1], (float)a[2]), glm::vec3((float)b[0], (float)b[1], (float)b[2]), alpha);
+    return min + step * q;
+}
+
+#endif
+
+void AnimCompressedClip::sample(float frame, AnimPose* posesOut) const {
+    if (_numFrames == 0) {
+        return;
+    }
+    frame = glm::clamp(frame, 0.0f, (float)(_numFrames - 1));
+
+    const uint16_t* keyFrames = _keyFrames.data();
+    uint32_t key, nextKey;
+    float alpha;
+    for (size_t i = 0; i < _joints.size(); i++) {
+        const JointTracks& joint = _joints[i];
+        AnimPose& pose = posesOut[i];
+
+        const Track& rotation = joint.rotation;
+        findKeyPair(keyFrames + rotation.firstKey, rotation.numKeys, frame, key, nextKey, alpha);
+        pose.rot() = interpolateRotation(&_rotations[4 * (rotation.firstValue + key)],
+                                         &_rotations[4 * (rotation.firstValue + nextKey)], alpha);
+
+        const Track& translation = joint.translation;
+        findKeyPair(keyFrames + translation.firstKey, translation.numKeys, frame, key, nextKey, alpha);
+        pose.trans() = interpolateTranslation(&_translations[3 * (translation.firstValue + key)],
+                                              &_translations[3 * (translation.firstValue + nextKey)], alpha,
+                                              joint.translationMin, joint.translationStep);
+
+        const Track& scale = joint.scale;
+        findKeyPair(keyFrames + scale.firstKey, scale.numKeys, frame, key, nextKey, alpha);
+        pose.scale() = lerp(_scales[scale.firstValue + key], _scales[scale.firstValue + nextKey], alpha);
+    }
+}
+
+void AnimCompressedClip::decodeFrame(int frame, AnimPoseVec& posesOut) const {
+    posesOut.resize(_joints.size());
+    sample((float)frame, posesOut.data());
+}
+
+size_t AnimCompressedClip::getMemorySize() const {
+    return sizeof(AnimCompressedClip) +
+        _joints.capacity() * sizeof(JointTracks) +
+        _keyFrames.capacity() * sizeof(uint16_t) +
+        _rotations.capacity() * sizeof(int16_t) +
+        _translations.capacity() * sizeof(uint16_t) +
+        _scales.capacity() * sizeof(glm::vec3);
+}
@@ -0,0 +1,75 @@
+//
+//  AnimCompressedClip.h
+//  libraries/animation/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimCompressedClip_h
+#define hifi_AnimCompressedClip_h
+
+#include <stdint.h>
+#include <vector>
+
+#include "AnimPose.h"
+
+// The frames of an animation clip, stored as one rotation, translation and scale track per joint.  Each track only
+// keeps the keys that linear interpolation can't reproduce within the tolerance, rotations are quantized to
+// 16 bits per component and translations to 16 bits within the range of their track.  Frames are decoded on the
+// fly by sample().
+class AnimCompressedClip {
+public:
+    struct Tolerance {
+        float rotation { DEFAULT_ROTATION_TOLERANCE };       // radians
+        float translation { DEFAULT_TRANSLATION_TOLERANCE }; // relative to the length of the bone
+        float scale { DEFAULT_SCALE_TOLERANCE };
+    };
+    static const float DEFAULT_ROTATION_TOLERANCE;
+    static const float DEFAULT_TRANSLATION_TOLERANCE;
+    static const float DEFAULT_SCALE_TOLERANCE;
+
+    // frames[frame][joint], every frame has the same number of joints.  Returns false if the clip has too many
+    // frames to be compressed.
+    bool compress(const std::vector<AnimPoseVec>& frames, const Tolerance& tolerance);
+    void clear();
+
+    bool isEmpty() const { return _numFrames == 0; }
+    int getNumFrames() const { return _numFrames; }
+    int getNumJoints() const { return (int)_joints.size(); }
+
+    // posesOut[joint] is the pose at frame, interpolated between the frames around it
+    void sample(float frame, AnimPose* posesOut) const;
+    void decodeFrame(int frame, AnimPoseVec& posesOut) const;
+
+    size_t getMemorySize() const;
+
+private:
+    struct Track {
+        uint32_t firstKey { 0 };   // in _keyFrames
+        uint32_t firstValue { 0 }; // in keys of the value array of the track
+        uint32_t numKeys { 0 };
+    };
+    struct JointTracks {
+        Track rotation;
+        Track translation;
+        Track scale;
+        glm::vec3 translationMin;
+        glm::vec3 translationStep;
+    };
+
+    void compressRotations(const std::vector<glm::quat>& rotations, float tolerance, Track& trackOut);
+    void compressTranslations(const std::vector<glm::vec3>& translations, float tolerance, JointTracks& jointOut);
+    void compressScales(const std::vector<glm::vec3>& scales, float tolerance, Track& trackOut);
+
+    std::vector<JointTracks> _joints;
+    std::vector<uint16_t> _keyFrames;     // the frame of every key, in the order of the tracks
+    std::vector<int16_t> _rotations;      // x, y, z, w of the rotation keys
+    std::vector<uint16_t> _translations;  // x, y, z of the translation keys, padded for 64 bit loads
+    std::vector<glm::vec3> _scales;
+    int _numFrames { 0 };
+};
+
+#endif // hifi_AnimCompressedClip_h
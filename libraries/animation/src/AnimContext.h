@@ -17,7 +17,7 @@
 class AnimContext {
 public:
     AnimContext(bool enableDebugDrawIKTargets, bool enableDebugDrawIKConstraints, bool enableDebugDrawIKChains,
-                const glm::mat4& geometryToRigMatrix, const glm::mat4& rigToWorldMatrix);
+                const glm::mat4& geometryToRigMatrix, const glm::mat4& rigToWorldMatrix, bool enableIK = true);
 
     bool getEnableDebugDrawIKTargets() const { return _enableDebugDrawIKTargets; }
     bool getEnableDebugDrawIKConstraints() const { return _enableDebugDrawIKConstraints; }
@@ -25,6 +25,9 @@ public:
     const glm::mat4& getGeometryToRigMatrix() const { return _geometryToRigMatrix; }
     const glm::mat4& getRigToWorldMatrix() const { return _rigToWorldMatrix; }
 
+    // false at reduced animation LOD, IK and manipulator nodes then pass their under poses through
+    bool getEnableIK() const { return _enableIK; }
+
 protected:
 
     bool _enableDebugDrawIKTargets { false };
@@ -32,6 +35,7 @@ protected:
     bool _enableDebugDrawIKChains { false };
     glm::mat4 _geometryToRigMatrix;
     glm::mat4 _rigToWorldMatrix;
+    bool _enableIK { true };
 };
 
 #endif  // hifi_AnimContext_h
@@ -26,6 +26,16 @@
 static const int MAX_TARGET_MARKERS = 30;
 static const float JOINT_CHAIN_INTERP_TIME = 0.25f;
 
+const float AnimInverseKinematics::DEFAULT_ERROR_THRESHOLD = 0.001f; // meters
+
+// how far targets and under poses may drift from the inputs of a converged solve before it is solved again
+static const float STABLE_TRANSLATION_EPSILON = 0.0001f; // meters
+static const float STABLE_ROTATION_DOT = 1.0f - 1.0e-6f;  // cos(half angle), about 0.16 degrees
+
+static bool isPoseStable(const AnimPose& a, const AnimPose& b, float translationEpsilon) {
+    return glm::length(a.trans() - b.trans()) <= translationEpsilon && fabsf(glm::dot(a.rot(), b.rot())) >= STABLE_ROTATION_DOT;
+}
+
 static void lookupJointInfo(const AnimInverseKinematics::JointChainInfo& jointChainInfo,
                             int indexA, int indexB,
                             const AnimInverseKinematics::JointInfo** jointInfoA,
@@ -52,7 +62,8 @@ static float easeOutExpo(float t) {
 
 AnimInverseKinematics::IKTargetVar::IKTargetVar(const QString& jointNameIn, const QString& positionVarIn, const QString& rotationVarIn,
                                                 const QString& typeVarIn, const QString& weightVarIn, float weightIn, const std::vector<float>& flexCoefficientsIn,
-                                                const QString& poleVectorEnabledVarIn, const QString& poleReferenceVectorVarIn, const QString& poleVectorVarIn) :
+                                                const QString& poleVectorEnabledVarIn, const QString& poleReferenceVectorVarIn, const QString& poleVectorVarIn,
+                                                float errorThresholdIn) :
     jointName(jointNameIn),
     positionVar(positionVarIn),
     rotationVar(rotationVarIn),
@@ -62,6 +73,7 @@ AnimInverseKinematics::IKTargetVar::IKTargetVar(const QString& jointNameIn, cons
     poleReferenceVectorVar(poleReferenceVectorVarIn),
     poleVectorVar(poleVectorVarIn),
     weight(weightIn),
+    errorThreshold(errorThresholdIn),
     numFlexCoefficients(flexCoefficientsIn.size()),
     jointIndex(-1)
 {
@@ -81,6 +93,7 @@ AnimInverseKinematics::IKTargetVar::IKTargetVar(const IKTargetVar& orig) :
     poleReferenceVectorVar(orig.poleReferenceVectorVar),
     poleVectorVar(orig.poleVectorVar),
     weight(orig.weight),
+    errorThreshold(orig.errorThreshold),
     numFlexCoefficients(orig.numFlexCoefficients),
     jointIndex(orig.jointIndex)
 {
@@ -140,8 +153,10 @@ void AnimInverseKinematics::computeAbsolutePoses(AnimPoseVec& absolutePoses) con
 
 void AnimInverseKinematics::setTargetVars(const QString& jointName, const QString& positionVar, const QString& rotationVar,
                                           const QString& typeVar, const QString& weightVar, float weight, const std::vector<float>& flexCoefficients,
-                                          const QString& poleVectorEnabledVar, const QString& poleReferenceVectorVar, const QString& poleVectorVar) {
-    IKTargetVar targetVar(jointName, positionVar, rotationVar, typeVar, weightVar, weight, flexCoefficients, poleVectorEnabledVar, poleReferenceVectorVar, poleVectorVar);
+                                          const QString& poleVectorEnabledVar, const QString& poleReferenceVectorVar, const QString& poleVectorVar,
+                                          float errorThreshold) {
+    IKTargetVar targetVar(jointName, positionVar, rotationVar, typeVar, weightVar, weight, flexCoefficients, poleVectorEnabledVar, poleReferenceVectorVar, poleVectorVar,
+                          errorThreshold);
 
     // if there are dups, last one wins.
     bool found = false;
@@ -189,6 +204,7 @@ void AnimInverseKinematics::computeTargets(const AnimVariantMap& animVars, std::
 
                 target.setPose(rotation, translation);
                 target.setWeight(weight);
+                target.setErrorThreshold(targetVar.errorThreshold);
                 target.setFlexCoefficients(targetVar.numFlexCoefficients, targetVar.flexCoefficients);
 
                 bool poleVectorEnabled = animVars.lookup(targetVar.poleVectorEnabledVar, false);
@@ -227,13 +243,44 @@ void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<
         accumulator.clearAndClean();
     }
 
+    // error thresholds are in meters in the rig frame, the solver works in the geometry frame
+    float rigToGeometryScale = 1.0f;
+    float geometryToRigScale = extractScale(context.getGeometryToRigMatrix()).x;
+    if (geometryToRigScale > EPSILON) {
+        rigToGeometryScale = 1.0f / geometryToRigScale;
+    }
+
+    // compute maxError, and whether every weighted target is within its error threshold
+    auto computeErrors = [&](float& maxErrorOut) -> bool {
+        bool converged = true;
+        maxErrorOut = 0.0f;
+        for (size_t i = 0; i < targets.size(); i++) {
+            if (targets[i].getType() == IKTarget::Type::RotationAndPosition || targets[i].getType() == IKTarget::Type::HmdHead ||
+                targets[i].getType() == IKTarget::Type::HipsRelativeRotationAndPosition) {
+                float error = glm::length(absolutePoses[targets[i].getIndex()].trans() - targets[i].getTranslation());
+                if (error > maxErrorOut) {
+                    maxErrorOut = error;
+                }
+                if (targets[i].getWeight() > 0.0f && error > targets[i].getErrorThreshold() * rigToGeometryScale) {
+                    converged = false;
+                }
+            }
+        }
+        return converged;
+    };
+
+    // a warm start from the previous solution may already be within the thresholds
     float maxError = 0.0f;
+    bool converged = computeErrors(maxError);
+
     int numLoops = 0;
     const int MAX_IK_LOOPS = 16;
     while (numLoops < MAX_IK_LOOPS) {
         ++numLoops;
 
-        bool debug = context.getEnableDebugDrawIKChains() && numLoops == MAX_IK_LOOPS;
+        // in convergent mode, the iteration after all targets are met is the last one
+        bool lastLoop = numLoops == MAX_IK_LOOPS || (_solverMode == SolverMode::Convergent && converged);
+        bool debug = context.getEnableDebugDrawIKChains() && lastLoop;
 
         // solve all targets
         for (size_t i = 0; i < targets.size(); i++) {
@@ -250,7 +297,7 @@ void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<
         }
 
         // on last iteration, interpolate jointChains, if necessary
-        if (numLoops == MAX_IK_LOOPS) {
+        if (lastLoop) {
             for (size_t i = 0; i < _prevJointChainInfoVec.size(); i++) {
                 if (_prevJointChainInfoVec[i].timer > 0.0f) {
                     float alpha = (JOINT_CHAIN_INTERP_TIME - _prevJointChainInfoVec[i].timer) / JOINT_CHAIN_INTERP_TIME;
@@ -314,19 +361,15 @@ void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<
             }
         }
 
-        // compute maxError
-        maxError = 0.0f;
-        for (size_t i = 0; i < targets.size(); i++) {
-            if (targets[i].getType() == IKTarget::Type::RotationAndPosition || targets[i].getType() == IKTarget::Type::HmdHead ||
-                targets[i].getType() == IKTarget::Type::HipsRelativeRotationAndPosition) {
-                float error = glm::length(absolutePoses[targets[i].getIndex()].trans() - targets[i].getTranslation());
-                if (error > maxError) {
-                    maxError = error;
-                }
-            }
+        converged = computeErrors(maxError);
+
+        if (lastLoop) {
+            break;
         }
     }
     _maxErrorOnLastSolve = maxError;
+    _numIterationsOnLastSolve = numLoops;
+    _convergedOnLastSolve = converged;
 
     // finally set the relative rotation of each tip to agree with absolute target rotation
     for (auto& target: targets) {
@@ -887,6 +930,10 @@ const AnimPoseVec& AnimInverseKinematics::overlay(const AnimVariantMap& animVars
     return underPoses;
 #endif
 
+    if (!context.getEnableIK()) {
+        return underPoses;
+    }
+
     // allows solutionSource to be overridden by an animVar
     auto solutionSource = animVars.lookup(_solutionSourceVar, (int)_solutionSource);
 
@@ -895,9 +942,28 @@ const AnimPoseVec& AnimInverseKinematics::overlay(const AnimVariantMap& animVars
         dt = MAX_OVERLAY_DT;
     }
 
+    bool posesLoaded = false;
     if (_relativePoses.size() != underPoses.size()) {
         loadPoses(underPoses);
-    } else {
+        posesLoaded = true;
+    }
+
+    // build a list of targets from _targetVarVec
+    std::vector<IKTarget> targets;
+    if (!_relativePoses.empty()) {
+        PROFILE_RANGE_EX(simulation_animation, "ik/computeTargets", 0xffff00ff, 0);
+        computeTargets(animVars, targets, underPoses);
+    }
+
+    if (!posesLoaded) {
+        if (_solverMode == SolverMode::Convergent && !targets.empty() && !isSolveNeeded(context, solutionSource, targets, underPoses)) {
+            // nothing has moved since the last solve converged, its solution still holds.  The state the solve
+            // advances with dt, the joint chain blend timers, is idle too, and the hips shift only depends on
+            // the targets and under poses, see isSolveNeeded
+            _numIterationsOnLastSolve = 0;
+            _solveTimeOnLastSolve = 0;
+            return _relativePoses;
+        }
 
         PROFILE_RANGE_EX(simulation_animation, "ik/relax", 0xffff00ff, 0);
 
@@ -915,19 +981,24 @@ const AnimPoseVec& AnimInverseKinematics::overlay(const AnimVariantMap& animVars
         }
     }
 
-    if (!_relativePoses.empty()) {
+    _numIterationsOnLastSolve = 0;
+    _solveTimeOnLastSolve = 0;
+    _convergedOnLastSolve = false;
 
-        // build a list of targets from _targetVarVec
-        std::vector<IKTarget> targets;
-        {
-            PROFILE_RANGE_EX(simulation_animation, "ik/computeTargets", 0xffff00ff, 0);
-            computeTargets(animVars, targets, underPoses);
-        }
+    if (!_relativePoses.empty()) {
 
         if (targets.empty()) {
             _relativePoses = underPoses;
         } else {
 
+            if (_solverMode == SolverMode::Convergent) {
+                // remember the inputs before the hips shift below adjusts the targets
+                _solutionSourceOnLastSolve = solutionSource;
+                _targetsOnLastSolve = targets;
+                _underPosesOnLastSolve = underPoses;
+                _secondaryTargetsOnLastSolve = _secondaryTargetsInRigFrame;
+            }
+
             JointChainInfoVec jointChainInfoVec(targets.size());
             {
                 PROFILE_RANGE_EX(simulation_animation, "ik/jointChainInfo", 0xffff00ff, 0);
@@ -1043,11 +1114,14 @@ const AnimPoseVec& AnimInverseKinematics::overlay(const AnimVariantMap& animVars
 
             {
                 PROFILE_RANGE_EX(simulation_animation, "ik/ccd", 0xffff00ff, 0);
+                uint64_t startTime = usecTimestampNow();
 
                 setSecondaryTargets(context);
                 preconditionRelativePosesToAvoidLimbLock(context, targets);
 
                 solve(context, targets, dt, jointChainInfoVec);
+
+                _solveTimeOnLastSolve = usecTimestampNow() - startTime;
             }
         }
 
@@ -1059,6 +1133,64 @@ const AnimPoseVec& AnimInverseKinematics::overlay(const AnimVariantMap& animVars
     return _relativePoses;
 }
 
+bool AnimInverseKinematics::isSolveNeeded(const AnimContext& context, int solutionSource, const std::vector<IKTarget>& targets,
+                                          const AnimPoseVec& underPoses) const {
+    if (!_convergedOnLastSolve || solutionSource != _solutionSourceOnLastSolve ||
+        targets.size() != _targetsOnLastSolve.size() || underPoses.size() != _underPosesOnLastSolve.size() ||
+        _secondaryTargetsInRigFrame.size() != _secondaryTargetsOnLastSolve.size()) {
+        return true;
+    }
+
+    // debug rendering is refreshed by the solve, and the target markers are removed by the first one after it is off
+    if (context.getEnableDebugDrawIKTargets() || context.getEnableDebugDrawIKChains() || context.getEnableDebugDrawIKConstraints() ||
+        context.getEnableDebugDrawIKTargets() != _previousEnableDebugIKTargets) {
+        return true;
+    }
+
+    // joint chains that are still blending between target types change the solution every frame
+    for (auto& jointChainInfo : _prevJointChainInfoVec) {
+        if (jointChainInfo.timer > 0.0f) {
+            return true;
+        }
+    }
+
+    float geometryToRigScale = extractScale(context.getGeometryToRigMatrix()).x;
+    float geometryEpsilon = (geometryToRigScale > EPSILON) ? STABLE_TRANSLATION_EPSILON / geometryToRigScale : STABLE_TRANSLATION_EPSILON;
+
+    for (size_t i = 0; i < targets.size(); i++) {
+        const IKTarget& target = targets[i];
+        const IKTarget& prevTarget = _targetsOnLastSolve[i];
+        if (target.getType() != prevTarget.getType() || target.getIndex() != prevTarget.getIndex() ||
+            target.getWeight() != prevTarget.getWeight() || target.getPoleVectorEnabled() != prevTarget.getPoleVectorEnabled()) {
+            return true;
+        }
+        if (target.getType() != IKTarget::Type::Unknown && !isPoseStable(target.getPose(), prevTarget.getPose(), geometryEpsilon)) {
+            return true;
+        }
+        if (target.getPoleVectorEnabled() &&
+            (glm::dot(target.getPoleVector(), prevTarget.getPoleVector()) < STABLE_ROTATION_DOT ||
+             glm::dot(target.getPoleReferenceVector(), prevTarget.getPoleReferenceVector()) < STABLE_ROTATION_DOT)) {
+            return true;
+        }
+    }
+
+    for (size_t i = 0; i < underPoses.size(); i++) {
+        if (!isPoseStable(underPoses[i], _underPosesOnLastSolve[i], geometryEpsilon)) {
+            return true;
+        }
+    }
+
+    auto prevIter = _secondaryTargetsOnLastSolve.begin();
+    for (auto& iter : _secondaryTargetsInRigFrame) {
+        if (iter.first != prevIter->first || !isPoseStable(iter.second, prevIter->second, STABLE_TRANSLATION_EPSILON)) {
+            return true;
+        }
+        ++prevIter;
+    }
+
+    return false;
+}
+
 void AnimInverseKinematics::clearIKJointLimitHistory() {
     for (auto& pair : _constraints) {
         pair.second->clearHistory();
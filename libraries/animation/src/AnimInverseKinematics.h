@@ -50,7 +50,8 @@ public:
 
     void setTargetVars(const QString& jointName, const QString& positionVar, const QString& rotationVar,
                        const QString& typeVar, const QString& weightVar, float weight, const std::vector<float>& flexCoefficients,
-                       const QString& poleVectorEnabledVar, const QString& poleReferenceVectorVar, const QString& poleVectorVar);
+                       const QString& poleVectorEnabledVar, const QString& poleReferenceVectorVar, const QString& poleVectorVar,
+                       float errorThreshold = DEFAULT_ERROR_THRESHOLD);
 
     virtual const AnimPoseVec& evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimNode::Triggers& triggersOut) override;
     virtual const AnimPoseVec& overlay(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut, const AnimPoseVec& underPoses) override;
@@ -58,6 +59,10 @@ public:
     void clearIKJointLimitHistory();
 
     float getMaxErrorOnLastSolve() { return _maxErrorOnLastSolve; }
+    int getNumIterationsOnLastSolve() const { return _numIterationsOnLastSolve; }
+    uint64_t getSolveTimeOnLastSolve() const { return _solveTimeOnLastSolve; } // usecs
+
+    static const float DEFAULT_ERROR_THRESHOLD; // meters
 
     enum class SolutionSource {
         RelaxToUnderPoses = 0,
@@ -74,6 +79,18 @@ public:
     void setSolutionSource(SolutionSource solutionSource) { _solutionSource = solutionSource; }
     void setSolutionSourceVar(const QString& solutionSourceVar) { _solutionSourceVar = solutionSourceVar; }
 
+    // FixedIterations always runs every iteration of the solver.  Convergent stops iterating once all targets are
+    // within their error thresholds, and reuses the previous solution as long as neither the targets nor the
+    // under poses have moved since it converged.
+    enum class SolverMode {
+        FixedIterations = 0,
+        Convergent,
+        NumSolverModes
+    };
+
+    void setSolverMode(SolverMode solverMode) { _solverMode = solverMode; }
+    SolverMode getSolverMode() const { return _solverMode; }
+
 protected:
     void computeTargets(const AnimVariantMap& animVars, std::vector<IKTarget>& targets, const AnimPoseVec& underPoses);
     void solve(const AnimContext& context, const std::vector<IKTarget>& targets, float dt, JointChainInfoVec& jointChainInfoVec);
@@ -90,6 +107,8 @@ protected:
     void blendToPoses(const AnimPoseVec& targetPoses, const AnimPoseVec& underPose, float blendFactor);
     void preconditionRelativePosesToAvoidLimbLock(const AnimContext& context, const std::vector<IKTarget>& targets);
     void setSecondaryTargets(const AnimContext& context);
+    bool isSolveNeeded(const AnimContext& context, int solutionSource, const std::vector<IKTarget>& targets,
+                       const AnimPoseVec& underPoses) const;
 
     // used to pre-compute information about each joint influeced by a spline IK target.
     struct SplineJointInfo {
@@ -117,7 +136,8 @@ protected:
     struct IKTargetVar {
         IKTargetVar(const QString& jointNameIn, const QString& positionVarIn, const QString& rotationVarIn,
                     const QString& typeVarIn, const QString& weightVarIn, float weightIn, const std::vector<float>& flexCoefficientsIn,
-                    const QString& poleVectorEnabledVar, const QString& poleReferenceVectorVar, const QString& poleVectorVar);
+                    const QString& poleVectorEnabledVar, const QString& poleReferenceVectorVar, const QString& poleVectorVar,
+                    float errorThresholdIn);
         IKTargetVar(const IKTargetVar& orig);
 
         QString jointName;
@@ -129,6 +149,7 @@ protected:
         QString poleReferenceVectorVar;
         QString poleVectorVar;
         float weight;
+        float errorThreshold;
         float flexCoefficients[MAX_FLEX_COEFFICIENTS];
         size_t numFlexCoefficients;
         int jointIndex; // cached joint index
@@ -157,8 +178,19 @@ protected:
     bool _previousEnableDebugIKTargets { false };
     SolutionSource _solutionSource { SolutionSource::RelaxToUnderPoses };
     QString _solutionSourceVar;
+    SolverMode _solverMode { SolverMode::FixedIterations };
 
     JointChainInfoVec _prevJointChainInfoVec;
+
+    // inputs of the last solve, to tell whether its solution still holds
+    bool _convergedOnLastSolve { false };
+    int _solutionSourceOnLastSolve { -1 };
+    std::vector<IKTarget> _targetsOnLastSolve;
+    AnimPoseVec _underPosesOnLastSolve;
+    std::map<int, AnimPose> _secondaryTargetsOnLastSolve;
+
+    int _numIterationsOnLastSolve { 0 };
+    uint64_t _solveTimeOnLastSolve { 0 };
 };
 
 #endif // hifi_AnimInverseKinematics_h
@@ -41,7 +41,7 @@ const AnimPoseVec& AnimManipulator::overlay(const AnimVariantMap& animVars, cons
 
     _poses = underPoses;
 
-    if (underPoses.size() == 0) {
+    if (underPoses.size() == 0 || !context.getEnableIK()) {
         return _poses;
     }
 
@@ -32,6 +32,20 @@ using NodeProcessFunc = bool (*)(AnimNode::Pointer node, const QJsonObject& json
 static AnimNode::Pointer loadClipNode(const QJsonObject& jsonObj, const QString& id, const QUrl& jsonUrl);
 static AnimNode::Pointer loadBlendLinearNode(const QJsonObject& jsonObj, const QString& id, const QUrl& jsonUrl);
 static AnimNode::Pointer loadBlendLinearMoveNode(const QJsonObject& jsonObj, const QString& id, const QUrl& jsonUrl);
+static const char* solverModeStrings[(int)AnimInverseKinematics::SolverMode::NumSolverModes] = {
+    "fixedIterations",
+    "convergent"
+};
+
+static AnimInverseKinematics::SolverMode stringToSolverModeEnum(const QString& str) {
+    for (int i = 0; i < (int)AnimInverseKinematics::SolverMode::NumSolverModes; i++) {
+        if (str == solverModeStrings[i]) {
+            return (AnimInverseKinematics::SolverMode)i;
+        }
+    }
+    return AnimInverseKinematics::SolverMode::NumSolverModes;
+}
+
 static AnimNode::Pointer loadOverlayNode(const QJsonObject& jsonObj, const QString& id, const QUrl& jsonUrl);
 static AnimNode::Pointer loadStateMachineNode(const QJsonObject& jsonObj, const QString& id, const QUrl& jsonUrl);
 static AnimNode::Pointer loadManipulatorNode(const QJsonObject& jsonObj, const QString& id, const QUrl& jsonUrl);
@@ -487,6 +501,7 @@ AnimNode::Pointer loadInverseKinematicsNode(const QJsonObject& jsonObj, const QS
         READ_OPTIONAL_STRING(typeVar, targetObj);
         READ_OPTIONAL_STRING(weightVar, targetObj);
         READ_OPTIONAL_FLOAT(weight, targetObj, 1.0f);
+        READ_OPTIONAL_FLOAT(errorThreshold, targetObj, AnimInverseKinematics::DEFAULT_ERROR_THRESHOLD);
         READ_OPTIONAL_STRING(poleVectorEnabledVar, targetObj);
         READ_OPTIONAL_STRING(poleReferenceVectorVar, targetObj);
         READ_OPTIONAL_STRING(poleVectorVar, targetObj);
@@ -502,7 +517,8 @@ AnimNode::Pointer loadInverseKinematicsNode(const QJsonObject& jsonObj, const QS
             flexCoefficients.push_back((float)value.toDouble());
         }
 
-        node->setTargetVars(jointName, positionVar, rotationVar, typeVar, weightVar, weight, flexCoefficients, poleVectorEnabledVar, poleReferenceVectorVar, poleVectorVar);
+        node->setTargetVars(jointName, positionVar, rotationVar, typeVar, weightVar, weight, flexCoefficients, poleVectorEnabledVar, poleReferenceVectorVar, poleVectorVar,
+                            errorThreshold);
     };
 
     READ_OPTIONAL_STRING(solutionSource, jsonObj);
@@ -522,6 +538,17 @@ AnimNode::Pointer loadInverseKinematicsNode(const QJsonObject& jsonObj, const QS
         node->setSolutionSourceVar(solutionSourceVar);
     }
 
+    READ_OPTIONAL_STRING(solverMode, jsonObj);
+
+    if (!solverMode.isEmpty()) {
+        AnimInverseKinematics::SolverMode solverModeType = stringToSolverModeEnum(solverMode);
+        if (solverModeType != AnimInverseKinematics::SolverMode::NumSolverModes) {
+            node->setSolverMode(solverModeType);
+        } else {
+            qCWarning(animation) << "AnimNodeLoader, bad solverMode in \"solverMode\", id = " << id << ", url = " << jsonUrl.toDisplayString();
+        }
+    }
+
     return node;
 }
 
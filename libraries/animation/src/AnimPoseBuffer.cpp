@@ -0,0 +1,434 @@
+//
+//  AnimPoseBuffer.cpp
+//  libraries/animation/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseBuffer.h"
+
+#include <assert.h>
+#include <algorithm>
+
+#include <GLMHelpers.h>
+
+using Component = AnimPoseBuffer::Component;
+
+void AnimPoseBuffer::resize(size_t size) {
+    _size = size;
+    _paddedSize = ((size + PADDING - 1) / PADDING) * PADDING;
+    _data.assign(NumComponents * _paddedSize, 0.0f);
+
+    // pad with identity poses, so the kernels never normalize a zero rotation
+    for (Component component : { ScaleX, ScaleY, ScaleZ, RotW }) {
+        std::fill(data(component), data(component) + _paddedSize, 1.0f);
+    }
+}
+
+void AnimPoseBuffer::load(const AnimPose* poses, size_t size) {
+    if (size != _size) {
+        resize(size);
+    }
+    for (size_t i = 0; i < size; i++) {
+        set(i, poses[i]);
+    }
+}
+
+void AnimPoseBuffer::store(AnimPose* posesOut) const {
+    for (size_t i = 0; i < _size; i++) {
+        posesOut[i] = get(i);
+    }
+}
+
+void AnimPoseBuffer::store(AnimPoseVec& posesOut) const {
+    posesOut.resize(_size);
+    store(posesOut.data());
+}
+
+AnimPose AnimPoseBuffer::get(size_t index) const {
+    assert(index < _size);
+    return AnimPose(glm::vec3(data(ScaleX)[index], data(ScaleY)[index], data(ScaleZ)[index]),
+                    glm::quat(data(RotW)[index], data(RotX)[index], data(RotY)[index], data(RotZ)[index]),
+                    glm::vec3(data(TransX)[index], data(TransY)[index], data(TransZ)[index]));
+}
+
+void AnimPoseBuffer::set(size_t index, const AnimPose& pose) {
+    assert(index < _size);
+    data(ScaleX)[index] = pose.scale().x;
+    data(ScaleY)[index] = pose.scale().y;
+    data(ScaleZ)[index] = pose.scale().z;
+    data(RotX)[index] = pose.rot().x;
+    data(RotY)[index] = pose.rot().y;
+    data(RotZ)[index] = pose.rot().z;
+    data(RotW)[index] = pose.rot().w;
+    data(TransX)[index] = pose.trans().x;
+    data(TransY)[index] = pose.trans().y;
+    data(TransZ)[index] = pose.trans().z;
+}
+
+bool AnimPoseBuffer::hasUniformScale() const {
+    const float* scaleX = data(ScaleX);
+    const float* scaleY = data(ScaleY);
+    const float* scaleZ = data(ScaleZ);
+    for (size_t i = 0; i < _size; i++) {
+        if (isNonUniformScale(glm::vec3(scaleX[i], scaleY[i], scaleZ[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The scalar version of the hierarchy kernels: rotations and scales multiply, and the child's translation is
+// scaled and rotated by the parent.  This matches AnimPose::operator* when the parent scales uniformly.
+static inline AnimPose composePoses(const AnimPose& parent, const AnimPose& child) {
+    return AnimPose(parent.scale() * child.scale(), parent.rot() * child.rot(),
+                    parent.trans() + parent.rot() * (parent.scale() * child.trans()));
+}
+
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+static void blendPoses_SSE(const float* a, const float* b, float alpha, float* result, size_t stride) {
+
+    assert(stride % 4 == 0);
+
+    const __m128 t = _mm_set1_ps(alpha);
+    const __m128 oneMinusT = _mm_set1_ps(1.0f - alpha);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    static const int LERPED_COMPONENTS[] = {
+        AnimPoseBuffer::ScaleX, AnimPoseBuffer::ScaleY, AnimPoseBuffer::ScaleZ,
+        AnimPoseBuffer::TransX, AnimPoseBuffer::TransY, AnimPoseBuffer::TransZ
+    };
+
+    for (size_t i = 0; i < stride; i += 4) {
+
+        for (int component : LERPED_COMPONENTS) {
+            size_t k = component * stride + i;
+            __m128 x = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&a[k]), oneMinusT), _mm_mul_ps(_mm_loadu_ps(&b[k]), t));
+            _mm_storeu_ps(&result[k], x);
+        }
+
+        const float* aRot = &a[AnimPoseBuffer::RotX * stride + i];
+        const float* bRot = &b[AnimPoseBuffer::RotX * stride + i];
+        __m128 ax = _mm_loadu_ps(&aRot[0 * stride]);
+        __m128 ay = _mm_loadu_ps(&aRot[1 * stride]);
+        __m128 az = _mm_loadu_ps(&aRot[2 * stride]);
+        __m128 aw = _mm_loadu_ps(&aRot[3 * stride]);
+        __m128 bx = _mm_loadu_ps(&bRot[0 * stride]);
+        __m128 by = _mm_loadu_ps(&bRot[1 * stride]);
+        __m128 bz = _mm_loadu_ps(&bRot[2 * stride]);
+        __m128 bw = _mm_loadu_ps(&bRot[3 * stride]);
+
+        // adjust signs if necessary
+        __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+                                _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+        __m128 sign = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), signMask);
+        bx = _mm_xor_ps(bx, sign);
+        by = _mm_xor_ps(by, sign);
+        bz = _mm_xor_ps(bz, sign);
+        bw = _mm_xor_ps(bw, sign);
+
+        __m128 x = _mm_add_ps(_mm_mul_ps(ax, oneMinusT), _mm_mul_ps(bx, t));
+        __m128 y = _mm_add_ps(_mm_mul_ps(ay, oneMinusT), _mm_mul_ps(by, t));
+        __m128 z = _mm_add_ps(_mm_mul_ps(az, oneMinusT), _mm_mul_ps(bz, t));
+        __m128 w = _mm_add_ps(_mm_mul_ps(aw, oneMinusT), _mm_mul_ps(bw, t));
+
+        __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+                                               _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w))));
+
+        float* rot = &result[AnimPoseBuffer::RotX * stride + i];
+        _mm_storeu_ps(&rot[0 * stride], _mm_div_ps(x, length));
+        _mm_storeu_ps(&rot[1 * stride], _mm_div_ps(y, length));
+        _mm_storeu_ps(&rot[2 * stride], _mm_div_ps(z, length));
+        _mm_storeu_ps(&rot[3 * stride], _mm_div_ps(w, length));
+    }
+}
+
+static inline __m128 gather4(const float* stream, const int* indices) {
+    return _mm_setr_ps(stream[indices[0]], stream[indices[1]], stream[indices[2]], stream[indices[3]]);
+}
+
+static inline void scatter4(float* stream, const int* indices, __m128 x) {
+    float values[4];
+    _mm_storeu_ps(values, x);
+    stream[indices[0]] = values[0];
+    stream[indices[1]] = values[1];
+    stream[indices[2]] = values[2];
+    stream[indices[3]] = values[3];
+}
+
+// Makes absolute the joints of one depth, whose parents are absolute already.  They are spread over the
+// stream, so they are gathered four at a time.
+static void composeJoints_SSE(float* const* streams, const int* joints, const int* parentIndices, int numJoints) {
+
+    for (int k = 0; k < numJoints; k += 4) {
+
+        // repeat the last joint to fill the tail, it is written with the same value each time
+        int children[4];
+        int parents[4];
+        for (int j = 0; j < 4; j++) {
+            children[j] = joints[std::min(k + j, numJoints - 1)];
+            parents[j] = parentIndices[children[j]];
+        }
+
+        __m128 psx = gather4(streams[AnimPoseBuffer::ScaleX], parents);
+        __m128 psy = gather4(streams[AnimPoseBuffer::ScaleY], parents);
+        __m128 psz = gather4(streams[AnimPoseBuffer::ScaleZ], parents);
+        __m128 prx = gather4(streams[AnimPoseBuffer::RotX], parents);
+        __m128 pry = gather4(streams[AnimPoseBuffer::RotY], parents);
+        __m128 prz = gather4(streams[AnimPoseBuffer::RotZ], parents);
+        __m128 prw = gather4(streams[AnimPoseBuffer::RotW], parents);
+        __m128 ptx = gather4(streams[AnimPoseBuffer::TransX], parents);
+        __m128 pty = gather4(streams[AnimPoseBuffer::TransY], parents);
+        __m128 ptz = gather4(streams[AnimPoseBuffer::TransZ], parents);
+
+        __m128 csx = gather4(streams[AnimPoseBuffer::ScaleX], children);
+        __m128 csy = gather4(streams[AnimPoseBuffer::ScaleY], children);
+        __m128 csz = gather4(streams[AnimPoseBuffer::ScaleZ], children);
+        __m128 crx = gather4(streams[AnimPoseBuffer::RotX], children);
+        __m128 cry = gather4(streams[AnimPoseBuffer::RotY], children);
+        __m128 crz = gather4(streams[AnimPoseBuffer::RotZ], children);
+        __m128 crw = gather4(streams[AnimPoseBuffer::RotW], children);
+        __m128 ctx = gather4(streams[AnimPoseBuffer::TransX], children);
+        __m128 cty = gather4(streams[AnimPoseBuffer::TransY], children);
+        __m128 ctz = gather4(streams[AnimPoseBuffer::TransZ], children);
+
+        // scale
+        scatter4(streams[AnimPoseBuffer::ScaleX], children, _mm_mul_ps(psx, csx));
+        scatter4(streams[AnimPoseBuffer::ScaleY], children, _mm_mul_ps(psy, csy));
+        scatter4(streams[AnimPoseBuffer::ScaleZ], children, _mm_mul_ps(psz, csz));
+
+        // rotation, parent * child
+        __m128 rw = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(prw, crw), _mm_mul_ps(prx, crx)),
+                               _mm_add_ps(_mm_mul_ps(pry, cry), _mm_mul_ps(prz, crz)));
+        __m128 rx = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(prw, crx), _mm_mul_ps(prx, crw)), _mm_mul_ps(pry, crz)),
+                               _mm_mul_ps(prz, cry));
+        __m128 ry = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(prw, cry), _mm_mul_ps(pry, crw)), _mm_mul_ps(prz, crx)),
+                               _mm_mul_ps(prx, crz));
+        __m128 rz = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(prw, crz), _mm_mul_ps(prz, crw)), _mm_mul_ps(prx, cry)),
+                               _mm_mul_ps(pry, crx));
+        scatter4(streams[AnimPoseBuffer::RotX], children, rx);
+        scatter4(streams[AnimPoseBuffer::RotY], children, ry);
+        scatter4(streams[AnimPoseBuffer::RotZ], children, rz);
+        scatter4(streams[AnimPoseBuffer::RotW], children, rw);
+
+        // translation, rotate the scaled child translation the way glm does: v + 2 * (w * (q x v) + q x (q x v))
+        __m128 vx = _mm_mul_ps(psx, ctx);
+        __m128 vy = _mm_mul_ps(psy, cty);
+        __m128 vz = _mm_mul_ps(psz, ctz);
+        __m128 uvx = _mm_sub_ps(_mm_mul_ps(pry, vz), _mm_mul_ps(prz, vy));
+        __m128 uvy = _mm_sub_ps(_mm_mul_ps(prz, vx), _mm_mul_ps(prx, vz));
+        __m128 uvz = _mm_sub_ps(_mm_mul_ps(prx, vy), _mm_mul_ps(pry, vx));
+        __m128 uuvx = _mm_sub_ps(_mm_mul_ps(pry, uvz), _mm_mul_ps(prz, uvy));
+        __m128 uuvy = _mm_sub_ps(_mm_mul_ps(prz, uvx), _mm_mul_ps(prx, uvz));
+        __m128 uuvz = _mm_sub_ps(_mm_mul_ps(prx, uvy), _mm_mul_ps(pry, uvx));
+        __m128 two = _mm_set1_ps(2.0f);
+        vx = _mm_add_ps(vx, _mm_mul_ps(_mm_add_ps(_mm_mul_ps(uvx, prw), uuvx), two));
+        vy = _mm_add_ps(vy, _mm_mul_ps(_mm_add_ps(_mm_mul_ps(uvy, prw), uuvy), two));
+        vz = _mm_add_ps(vz, _mm_mul_ps(_mm_add_ps(_mm_mul_ps(uvz, prw), uuvz), two));
+        scatter4(streams[AnimPoseBuffer::TransX], children, _mm_add_ps(ptx, vx));
+        scatter4(streams[AnimPoseBuffer::TransY], children, _mm_add_ps(pty, vy));
+        scatter4(streams[AnimPoseBuffer::TransZ], children, _mm_add_ps(ptz, vz));
+    }
+}
+
+static void computeMatrices_SSE(const float* poses, size_t stride, size_t numPoses, glm::mat4* matricesOut) {
+
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+
+    for (size_t i = 0; i < numPoses; i += 4) {
+        __m128 sx = _mm_loadu_ps(&poses[AnimPoseBuffer::ScaleX * stride + i]);
+        __m128 sy = _mm_loadu_ps(&poses[AnimPoseBuffer::ScaleY * stride + i]);
+        __m128 sz = _mm_loadu_ps(&poses[AnimPoseBuffer::ScaleZ * stride + i]);
+        __m128 x = _mm_loadu_ps(&poses[AnimPoseBuffer::RotX * stride + i]);
+        __m128 y = _mm_loadu_ps(&poses[AnimPoseBuffer::RotY * stride + i]);
+        __m128 z = _mm_loadu_ps(&poses[AnimPoseBuffer::RotZ * stride + i]);
+        __m128 w = _mm_loadu_ps(&poses[AnimPoseBuffer::RotW * stride + i]);
+        __m128 tx = _mm_loadu_ps(&poses[AnimPoseBuffer::TransX * stride + i]);
+        __m128 ty = _mm_loadu_ps(&poses[AnimPoseBuffer::TransY * stride + i]);
+        __m128 tz = _mm_loadu_ps(&poses[AnimPoseBuffer::TransZ * stride + i]);
+
+        __m128 xx = _mm_mul_ps(x, x);
+        __m128 yy = _mm_mul_ps(y, y);
+        __m128 zz = _mm_mul_ps(z, z);
+        __m128 xy = _mm_mul_ps(x, y);
+        __m128 xz = _mm_mul_ps(x, z);
+        __m128 yz = _mm_mul_ps(y, z);
+        __m128 wx = _mm_mul_ps(w, x);
+        __m128 wy = _mm_mul_ps(w, y);
+        __m128 wz = _mm_mul_ps(w, z);
+
+        // rotation matrix columns, scaled
+        __m128 m00 = _mm_mul_ps(sx, _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))));
+        __m128 m01 = _mm_mul_ps(sx, _mm_mul_ps(two, _mm_add_ps(xy, wz)));
+        __m128 m02 = _mm_mul_ps(sx, _mm_mul_ps(two, _mm_sub_ps(xz, wy)));
+        __m128 m10 = _mm_mul_ps(sy, _mm_mul_ps(two, _mm_sub_ps(xy, wz)));
+        __m128 m11 = _mm_mul_ps(sy, _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))));
+        __m128 m12 = _mm_mul_ps(sy, _mm_mul_ps(two, _mm_add_ps(yz, wx)));
+        __m128 m20 = _mm_mul_ps(sz, _mm_mul_ps(two, _mm_add_ps(xz, wy)));
+        __m128 m21 = _mm_mul_ps(sz, _mm_mul_ps(two, _mm_sub_ps(yz, wx)));
+        __m128 m22 = _mm_mul_ps(sz, _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))));
+        __m128 zero0 = _mm_setzero_ps();
+        __m128 zero1 = _mm_setzero_ps();
+        __m128 zero2 = _mm_setzero_ps();
+        __m128 one3 = one;
+
+        // one column of four matrices per register
+        _MM_TRANSPOSE4_PS(m00, m01, m02, zero0);
+        _MM_TRANSPOSE4_PS(m10, m11, m12, zero1);
+        _MM_TRANSPOSE4_PS(m20, m21, m22, zero2);
+        _MM_TRANSPOSE4_PS(tx, ty, tz, one3);
+
+        __m128 columns[4][4] = {
+            { m00, m10, m20, tx },
+            { m01, m11, m21, ty },
+            { m02, m12, m22, tz },
+            { zero0, zero1, zero2, one3 }
+        };
+        size_t count = std::min((size_t)4, numPoses - i);
+        for (size_t j = 0; j < count; j++) {
+            float* matrix = &matricesOut[i + j][0][0];
+            _mm_storeu_ps(&matrix[0], columns[j][0]);
+            _mm_storeu_ps(&matrix[4], columns[j][1]);
+            _mm_storeu_ps(&matrix[8], columns[j][2]);
+            _mm_storeu_ps(&matrix[12], columns[j][3]);
+        }
+    }
+}
+
+//
+// Runtime CPU dispatch
+//
+
+#include "CPUDetect.h"
+
+void blendPoses_AVX2(const float* a, const float* b, float alpha, float* result, size_t stride);
+
+static void blendPoses(const float* a, const float* b, float alpha, float* result, size_t stride) {
+
+    static auto f = cpuSupportsAVX2() ? blendPoses_AVX2 : blendPoses_SSE;
+    (*f)(a, b, alpha, result, stride); // dispatch
+}
+
+static void composeJoints(float* const* streams, const int* joints, const int* parentIndices, int numJoints) {
+    composeJoints_SSE(streams, joints, parentIndices, numJoints);
+}
+
+static void computeMatrices(const float* poses, size_t stride, size_t numPoses, glm::mat4* matricesOut) {
+    computeMatrices_SSE(poses, stride, numPoses, matricesOut);
+}
+
+#else   // portable reference code
+
+static void blendPoses(const float* a, const float* b, float alpha, float* result, size_t stride) {
+
+    static const int LERPED_COMPONENTS[] = {
+        AnimPoseBuffer::ScaleX, AnimPoseBuffer::ScaleY, AnimPoseBuffer::ScaleZ,
+        AnimPoseBuffer::TransX, AnimPoseBuffer::TransY, AnimPoseBuffer::TransZ
+    };
+
+    for (int component : LERPED_COMPONENTS) {
+        size_t offset = component * stride;
+        for (size_t i = 0; i < stride; i++) {
+            result[offset + i] = lerp(a[offset + i], b[offset + i], alpha);
+        }
+    }
+
+    const float* aRot = &a[AnimPoseBuffer::RotX * stride];
+    const float* bRot = &b[AnimPoseBuffer::RotX * stride];
+    float* rot = &result[AnimPoseBuffer::RotX * stride];
+    for (size_t i = 0; i < stride; i++) {
+        glm::quat q1(aRot[3 * stride + i], aRot[i], aRot[stride + i], aRot[2 * stride + i]);
+        glm::quat q2(bRot[3 * stride + i], bRot[i], bRot[stride + i], bRot[2 * stride + i]);
+        if (glm::dot(q1, q2) < 0.0f) {
+            q2 = -q2;
+        }
+        glm::quat q = glm::normalize(glm::lerp(q1, q2, alpha));
+        rot[i] = q.x;
+        rot[stride + i] = q.y;
+        rot[2 * stride + i] = q.z;
+        rot[3 * stride + i] = q.w;
+    }
+}
+
+static AnimPose getPose(const float* const* streams, int index) {
+    return AnimPose(glm::vec3(streams[AnimPoseBuffer::ScaleX][index], streams[AnimPoseBuffer::ScaleY][index],
+                              streams[AnimPoseBuffer::ScaleZ][index]),
+                    glm::quat(streams[AnimPoseBuffer::RotW][index], streams[AnimPoseBuffer::RotX][index],
+                              streams[AnimPoseBuffer::RotY][index], streams[AnimPoseBuffer::RotZ][index]),
+                    glm::vec3(streams[AnimPoseBuffer::TransX][index], streams[AnimPoseBuffer::TransY][index],
+                              streams[AnimPoseBuffer::TransZ][index]));
+}
+
+static void composeJoints(float* const* streams, const int* joints, const int* parentIndices, int numJoints) {
+    for (int k = 0; k < numJoints; k++) {
+        int index = joints[k];
+        AnimPose pose = composePoses(getPose(streams, parentIndices[index]), getPose(streams, index));
+        streams[AnimPoseBuffer::ScaleX][index] = pose.scale().x;
+        streams[AnimPoseBuffer::ScaleY][index] = pose.scale().y;
+        streams[AnimPoseBuffer::ScaleZ][index] = pose.scale().z;
+        streams[AnimPoseBuffer::RotX][index] = pose.rot().x;
+        streams[AnimPoseBuffer::RotY][index] = pose.rot().y;
+        streams[AnimPoseBuffer::RotZ][index] = pose.rot().z;
+        streams[AnimPoseBuffer::RotW][index] = pose.rot().w;
+        streams[AnimPoseBuffer::TransX][index] = pose.trans().x;
+        streams[AnimPoseBuffer::TransY][index] = pose.trans().y;
+        streams[AnimPoseBuffer::TransZ][index] = pose.trans().z;
+    }
+}
+
+static void computeMatrices(const float* poses, size_t stride, size_t numPoses, glm::mat4* matricesOut) {
+    const float* streams[AnimPoseBuffer::NumComponents];
+    for (int component = 0; component < AnimPoseBuffer::NumComponents; component++) {
+        streams[component] = &poses[component * stride];
+    }
+    for (size_t i = 0; i < numPoses; i++) {
+        matricesOut[i] = getPose(streams, (int)i);
+    }
+}
+
+#endif
+
+void AnimPoseBuffer::blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result) {
+    assert(a.size() == b.size());
+    if (result.size() != a.size()) {
+        result.resize(a.size());
+    }
+    blendPoses(a._data.data(), b._data.data(), alpha, result._data.data(), a._paddedSize);
+}
+
+void AnimPoseBuffer::convertRelativeToAbsolute(const AnimHierarchy& hierarchy, const AnimPose& rootPose) {
+    assert(hierarchy.isValid && hierarchy.parentIndices.size() == _size);
+    if (hierarchy.depthOffsets.size() < 2) {
+        return;
+    }
+
+    // the roots are few, transform them one by one
+    for (int k = hierarchy.depthOffsets[0]; k < hierarchy.depthOffsets[1]; k++) {
+        int index = hierarchy.jointsByDepth[k];
+        set(index, composePoses(rootPose, get(index)));
+    }
+
+    float* const streams[NumComponents] = {
+        data(ScaleX), data(ScaleY), data(ScaleZ),
+        data(RotX), data(RotY), data(RotZ), data(RotW),
+        data(TransX), data(TransY), data(TransZ)
+    };
+    for (size_t depth = 1; depth + 1 < hierarchy.depthOffsets.size(); depth++) {
+        int begin = hierarchy.depthOffsets[depth];
+        int end = hierarchy.depthOffsets[depth + 1];
+        composeJoints(streams, &hierarchy.jointsByDepth[begin], hierarchy.parentIndices.data(), end - begin);
+    }
+}
+
+void AnimPoseBuffer::computeMatrices(glm::mat4* matricesOut) const {
+    ::computeMatrices(_data.data(), _paddedSize, _size, matricesOut);
+}
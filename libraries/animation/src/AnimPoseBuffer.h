@@ -0,0 +1,79 @@
+//
+//  AnimPoseBuffer.h
+//  libraries/animation/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseBuffer_h
+#define hifi_AnimPoseBuffer_h
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "AnimPose.h"
+
+// The joints of a skeleton grouped by depth in the hierarchy.  Joints of the same depth don't depend on each
+// other, so they can be made absolute together once their parents are.
+struct AnimHierarchy {
+    std::vector<int> parentIndices;
+    std::vector<int> jointsByDepth;
+    std::vector<int> depthOffsets; // depth d is jointsByDepth[depthOffsets[d]] until jointsByDepth[depthOffsets[d + 1]]
+    bool isValid { false };        // false if a parent comes after its child, which only the scalar code handles
+};
+
+// Poses as a structure of arrays, one float stream per component, for kernels that process four (SSE) or
+// eight (AVX2) joints at once.  The streams are padded with identity poses to a multiple of eight joints.
+class AnimPoseBuffer {
+public:
+    enum Component {
+        ScaleX = 0, ScaleY, ScaleZ,
+        RotX, RotY, RotZ, RotW,
+        TransX, TransY, TransZ,
+        NumComponents
+    };
+
+    static const size_t PADDING = 8;
+
+    AnimPoseBuffer() {}
+    explicit AnimPoseBuffer(size_t size) { resize(size); }
+
+    void resize(size_t size);
+    size_t size() const { return _size; }
+    size_t paddedSize() const { return _paddedSize; }
+
+    void load(const AnimPose* poses, size_t size);
+    void load(const AnimPoseVec& poses) { load(poses.data(), poses.size()); }
+    void store(AnimPose* posesOut) const;
+    void store(AnimPoseVec& posesOut) const;
+
+    AnimPose get(size_t index) const;
+    void set(size_t index, const AnimPose& pose);
+
+    float* data(Component component) { return _data.data() + component * _paddedSize; }
+    const float* data(Component component) const { return _data.data() + component * _paddedSize; }
+
+    // convertRelativeToAbsolute composes poses without going through matrices, which is only exact when
+    // parents scale uniformly
+    bool hasUniformScale() const;
+
+    // Same as ::blend(), nlerp of the rotations and lerp of the rest.  result may be a or b.
+    static void blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result);
+
+    // Turns poses relative to their parent into absolute ones in place, like
+    // AnimSkeleton::convertRelativePosesToAbsolute().  Root poses are premultiplied by rootPose.
+    void convertRelativeToAbsolute(const AnimHierarchy& hierarchy, const AnimPose& rootPose);
+
+    // matricesOut[i] is glm::mat4(get(i)), for the first size() poses
+    void computeMatrices(glm::mat4* matricesOut) const;
+
+private:
+    std::vector<float> _data;
+    size_t _size { 0 };
+    size_t _paddedSize { 0 };
+};
+
+#endif // hifi_AnimPoseBuffer_h
@@ -105,7 +105,20 @@ AnimPose AnimSkeleton::getAbsolutePose(int jointIndex, const AnimPoseVec& relati
 }
 
 void AnimSkeleton::convertRelativePosesToAbsolute(AnimPoseVec& poses) const {
+    convertRelativePosesToAbsolute(poses, _poseBuffer);
+}
+
+void AnimSkeleton::convertRelativePosesToAbsolute(AnimPoseVec& poses, AnimPoseBuffer& buffer) const {
     // poses start off relative and leave in absolute frame
+    if ((int)poses.size() == _jointsSize && _hierarchy.isValid) {
+        buffer.load(poses);
+        if (buffer.hasUniformScale()) {
+            buffer.convertRelativeToAbsolute(_hierarchy, AnimPose::identity);
+            buffer.store(poses);
+            return;
+        }
+    }
+
     int lastIndex = std::min((int)poses.size(), _jointsSize);
     for (int i = 0; i < lastIndex; ++i) {
         int parentIndex = _joints[i].parentIndex;
@@ -137,26 +150,22 @@ void AnimSkeleton::convertAbsoluteRotationsToRelative(std::vector<glm::quat>& ro
     }
 }
 
-void AnimSkeleton::saveNonMirroredPoses(const AnimPoseVec& poses) const {
-    _nonMirroredPoses.clear();
-    for (int i = 0; i < (int)_nonMirroredIndices.size(); ++i) {
-        _nonMirroredPoses.push_back(poses[_nonMirroredIndices[i]]);
-    }
-}
-
-void AnimSkeleton::restoreNonMirroredPoses(AnimPoseVec& poses) const {
+void AnimSkeleton::mirrorRelativePoses(AnimPoseVec& poses) const {
+    // the scratch state is local, this skeleton is shared with the threads building mirrored clips
+    AnimPoseVec nonMirroredPoses;
+    nonMirroredPoses.reserve(_nonMirroredIndices.size());
     for (int i = 0; i < (int)_nonMirroredIndices.size(); ++i) {
-        int index = _nonMirroredIndices[i];
-        poses[index] = _nonMirroredPoses[i];
+        nonMirroredPoses.push_back(poses[_nonMirroredIndices[i]]);
     }
-}
 
-void AnimSkeleton::mirrorRelativePoses(AnimPoseVec& poses) const {
-    saveNonMirroredPoses(poses);
-    convertRelativePosesToAbsolute(poses);
+    AnimPoseBuffer buffer;
+    convertRelativePosesToAbsolute(poses, buffer);
     mirrorAbsolutePoses(poses);
     convertAbsolutePosesToRelative(poses);
-    restoreNonMirroredPoses(poses);
+
+    for (int i = 0; i < (int)_nonMirroredIndices.size(); ++i) {
+        poses[_nonMirroredIndices[i]] = nonMirroredPoses[i];
+    }
 }
 
 void AnimSkeleton::mirrorAbsolutePoses(AnimPoseVec& poses) const {
@@ -202,6 +211,8 @@ void AnimSkeleton::buildSkeletonFromJoints(const std::vector<FBXJoint>& joints)
         _jointIndicesByName[_joints[i].name] = i;
     }
 
+    buildHierarchy();
+
     // build mirror map.
     _nonMirroredIndices.clear();
     _mirrorMap.reserve(_jointsSize);
@@ -231,6 +242,40 @@ void AnimSkeleton::buildSkeletonFromJoints(const std::vector<FBXJoint>& joints)
     }
 }
 
+void AnimSkeleton::buildHierarchy() {
+    _hierarchy = AnimHierarchy();
+    _hierarchy.parentIndices.reserve(_jointsSize);
+    std::vector<int> depths;
+    depths.reserve(_jointsSize);
+    int maxDepth = -1;
+    bool isValid = true;
+    for (int i = 0; i < _jointsSize; i++) {
+        int parentIndex = _joints[i].parentIndex;
+        if (parentIndex >= i) {
+            isValid = false;
+        }
+        int depth = (parentIndex >= 0 && parentIndex < i) ? depths[parentIndex] + 1 : 0;
+        _hierarchy.parentIndices.push_back(parentIndex);
+        depths.push_back(depth);
+        maxDepth = std::max(maxDepth, depth);
+    }
+
+    // counting sort of the joints by depth, each depth keeps the joint order
+    _hierarchy.depthOffsets.assign(maxDepth + 2, 0);
+    for (int depth : depths) {
+        _hierarchy.depthOffsets[depth + 1]++;
+    }
+    for (int depth = 0; depth <= maxDepth; depth++) {
+        _hierarchy.depthOffsets[depth + 1] += _hierarchy.depthOffsets[depth];
+    }
+    _hierarchy.jointsByDepth.resize(_jointsSize);
+    std::vector<int> nextSlots(_hierarchy.depthOffsets.begin(), _hierarchy.depthOffsets.end() - 1);
+    for (int i = 0; i < _jointsSize; i++) {
+        _hierarchy.jointsByDepth[nextSlots[depths[i]]++] = i;
+    }
+    _hierarchy.isValid = isValid;
+}
+
 void AnimSkeleton::dump(bool verbose) const {
     qCDebug(animation) << "[";
     for (int i = 0; i < getNumJoints(); i++) {
@@ -17,6 +17,7 @@
 
 #include <FBXReader.h>
 #include "AnimPose.h"
+#include "AnimPoseBuffer.h"
 
 class AnimSkeleton {
 public:
@@ -43,18 +44,18 @@ public:
     const AnimPose& getPostRotationPose(int jointIndex) const;
 
     int getParentIndex(int jointIndex) const;
+    const AnimHierarchy& getHierarchy() const { return _hierarchy; }
     std::vector<int> getChildrenOfJoint(int jointIndex) const;
 
     AnimPose getAbsolutePose(int jointIndex, const AnimPoseVec& relativePoses) const;
 
+    // uses a scratch buffer of the skeleton, so only from the thread that evaluates the anim graph
     void convertRelativePosesToAbsolute(AnimPoseVec& poses) const;
     void convertAbsolutePosesToRelative(AnimPoseVec& poses) const;
 
     void convertAbsoluteRotationsToRelative(std::vector<glm::quat>& rotations) const;
 
-    void saveNonMirroredPoses(const AnimPoseVec& poses) const;
-    void restoreNonMirroredPoses(AnimPoseVec& poses) const;
-
+    // safe from any thread, the clip builders mirror frames on worker threads
     void mirrorRelativePoses(AnimPoseVec& poses) const;
     void mirrorAbsolutePoses(AnimPoseVec& poses) const;
 
@@ -63,6 +64,8 @@ public:
 
 protected:
     void buildSkeletonFromJoints(const std::vector<FBXJoint>& joints);
+    void buildHierarchy();
+    void convertRelativePosesToAbsolute(AnimPoseVec& poses, AnimPoseBuffer& buffer) const;
 
     std::vector<FBXJoint> _joints;
     int _jointsSize { 0 };
@@ -70,7 +73,8 @@ protected:
     AnimPoseVec _absoluteDefaultPoses;
     AnimPoseVec _relativePreRotationPoses;
     AnimPoseVec _relativePostRotationPoses;
-    mutable AnimPoseVec _nonMirroredPoses;
+    mutable AnimPoseBuffer _poseBuffer;
+    AnimHierarchy _hierarchy;
     std::vector<int> _nonMirroredIndices;
     std::vector<int> _mirrorMap;
     QHash<QString, int> _jointIndicesByName;
@@ -41,6 +41,17 @@ AnimationPointer AnimationCache::getAnimation(const QUrl& url) {
     return getResource(url).staticCast<Animation>();
 }
 
+void AnimationCache::setClipCompressionTolerance(float rotation, float translation) {
+    std::lock_guard<std::mutex> lock(_clipCompressionToleranceMutex);
+    _clipCompressionTolerance.rotation = glm::radians(std::max(rotation, 0.0f));
+    _clipCompressionTolerance.translation = std::max(translation, 0.0f);
+}
+
+AnimCompressedClip::Tolerance AnimationCache::getClipCompressionTolerance() const {
+    std::lock_guard<std::mutex> lock(_clipCompressionToleranceMutex);
+    return _clipCompressionTolerance;
+}
+
 QSharedPointer<Resource> AnimationCache::createResource(const QUrl& url, const QSharedPointer<Resource>& fallback,
     const void* extra) {
     return QSharedPointer<Resource>(new Animation(url), &Resource::deleter);
@@ -147,3 +158,144 @@ void Animation::animationParseError(int error, QString str) {
     finishedLoading(false);
 }
 
+
+AnimClipBuilder::AnimClipBuilder(const AnimationPointer& animation, const AnimSkeleton::ConstPointer& skeleton,
+                                 const QString& url, const AnimCompressedClip::Tolerance& tolerance, bool buildMirror,
+                                 const AnimClipFramesPointer& framesOut) :
+    _animation(animation),
+    _skeleton(skeleton),
+    _url(url),
+    _tolerance(tolerance),
+    _buildMirror(buildMirror),
+    _framesOut(framesOut) {
+}
+
+AnimClipBuilder::AnimClipBuilder(const std::shared_ptr<const AnimClipFrames>& frames, const AnimSkeleton::ConstPointer& skeleton,
+                                 const QString& url, const AnimCompressedClip::Tolerance& tolerance,
+                                 const AnimClipFramesPointer& framesOut) :
+    _frames(frames),
+    _skeleton(skeleton),
+    _url(url),
+    _tolerance(tolerance),
+    _buildMirror(true),
+    _framesOut(framesOut) {
+}
+
+void AnimClipBuilder::run() {
+    PROFILE_RANGE_EX(resource_parse, __FUNCTION__, 0xFF00FF00, 0, { { "url", _url } });
+
+    std::vector<AnimPoseVec> anim;
+    if (_animation) {
+        convertAnimation(anim);
+        _animation.reset();
+        _framesOut->numFrames = (int)anim.size();
+        _framesOut->numJoints = _skeleton->getNumJoints();
+        compress(anim, _framesOut->anim, _framesOut->uncompressedAnim);
+    } else {
+        _framesOut->anim = _frames->anim;
+        _framesOut->uncompressedAnim = _frames->uncompressedAnim;
+        _framesOut->numFrames = _frames->numFrames;
+        _framesOut->numJoints = _frames->numJoints;
+        if (_frames->anim.isEmpty()) {
+            anim = _frames->uncompressedAnim;
+        } else {
+            anim.resize(_frames->numFrames);
+            for (int frame = 0; frame < _frames->numFrames; frame++) {
+                _frames->anim.decodeFrame(frame, anim[frame]);
+            }
+        }
+        _frames.reset();
+    }
+
+    if (_buildMirror) {
+        for (auto& poses : anim) {
+            _skeleton->mirrorRelativePoses(poses);
+        }
+        compress(anim, _framesOut->mirrorAnim, _framesOut->uncompressedMirrorAnim);
+        _framesOut->hasMirror = true;
+    }
+
+    _framesOut->isBuilt = true;
+}
+
+void AnimClipBuilder::convertAnimation(std::vector<AnimPoseVec>& anim) const {
+    // build a mapping from animation joint indices to skeleton joint indices.
+    // by matching joints with the same name.
+    const FBXGeometry& geom = _animation->getGeometry();
+    AnimSkeleton animSkeleton(geom);
+    const auto animJointCount = animSkeleton.getNumJoints();
+    const auto skeletonJointCount = _skeleton->getNumJoints();
+    std::vector<int> jointMap;
+    jointMap.reserve(animJointCount);
+    for (int i = 0; i < animJointCount; i++) {
+        int skeletonJoint = _skeleton->nameToJointIndex(animSkeleton.getJointName(i));
+        if (skeletonJoint == -1) {
+            qCWarning(animation) << "animation contains joint =" << animSkeleton.getJointName(i) << " which is not in the skeleton, url =" << _url;
+        }
+        jointMap.push_back(skeletonJoint);
+    }
+
+    const int frameCount = geom.animationFrames.size();
+    anim.resize(frameCount);
+
+    for (int frame = 0; frame < frameCount; frame++) {
+
+        const FBXAnimationFrame& fbxAnimFrame = geom.animationFrames[frame];
+
+        // init all joints in animation to default pose
+        // this will give us a resonable result for bones in the model skeleton but not in the animation.
+        anim[frame].reserve(skeletonJointCount);
+        for (int skeletonJoint = 0; skeletonJoint < skeletonJointCount; skeletonJoint++) {
+            anim[frame].push_back(_skeleton->getRelativeDefaultPose(skeletonJoint));
+        }
+
+        for (int animJoint = 0; animJoint < animJointCount; animJoint++) {
+            int skeletonJoint = jointMap[animJoint];
+
+            const glm::vec3& fbxAnimTrans = fbxAnimFrame.translations[animJoint];
+            const glm::quat& fbxAnimRot = fbxAnimFrame.rotations[animJoint];
+
+            // skip joints that are in the animation but not in the skeleton.
+            if (skeletonJoint >= 0 && skeletonJoint < skeletonJointCount) {
+
+                AnimPose preRot, postRot;
+                preRot = animSkeleton.getPreRotationPose(animJoint);
+                postRot = animSkeleton.getPostRotationPose(animJoint);
+
+                // cancel out scale
+                preRot.scale() = glm::vec3(1.0f);
+                postRot.scale() = glm::vec3(1.0f);
+
+                AnimPose rot(glm::vec3(1.0f), fbxAnimRot, glm::vec3());
+
+                // adjust translation offsets, so large translation animatons on the reference skeleton
+                // will be adjusted when played on a skeleton with short limbs.
+                const glm::vec3& fbxZeroTrans = geom.animationFrames[0].translations[animJoint];
+                const AnimPose& relDefaultPose = _skeleton->getRelativeDefaultPose(skeletonJoint);
+                float boneLengthScale = 1.0f;
+                const float EPSILON = 0.0001f;
+                if (fabsf(glm::length(fbxZeroTrans)) > EPSILON) {
+                    boneLengthScale = glm::length(relDefaultPose.trans()) / glm::length(fbxZeroTrans);
+                }
+
+                AnimPose trans = AnimPose(glm::vec3(1.0f), glm::quat(), relDefaultPose.trans() + boneLengthScale * (fbxAnimTrans - fbxZeroTrans));
+
+                anim[frame][skeletonJoint] = trans * preRot * rot * postRot;
+            }
+        }
+    }
+}
+
+void AnimClipBuilder::compress(const std::vector<AnimPoseVec>& anim, AnimCompressedClip& compressedOut,
+                               std::vector<AnimPoseVec>& uncompressedOut) const {
+    if (compressedOut.compress(anim, _tolerance)) {
+        size_t uncompressedSize = anim.size() * _skeleton->getNumJoints() * sizeof(AnimPose);
+        qCDebug(animation) << "AnimClip: compressed" << _url << "from" << uncompressedSize << "to"
+                           << compressedOut.getMemorySize() << "bytes";
+    } else {
+        qCWarning(animation) << "AnimClip: too many frames to compress, playing uncompressed, frames =" << anim.size()
+                             << ", url =" << _url;
+        // the mirror is built from the same frames
+        uncompressedOut = anim;
+    }
+}
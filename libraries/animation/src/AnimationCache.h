@@ -12,6 +12,10 @@
 #ifndef hifi_AnimationCache_h
 #define hifi_AnimationCache_h
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 #include <QtCore/QRunnable>
 #include <QtScript/QScriptEngine>
 #include <QtScript/QScriptValue>
@@ -20,6 +24,9 @@
 #include <FBXReader.h>
 #include <ResourceCache.h>
 
+#include "AnimCompressedClip.h"
+#include "AnimSkeleton.h"
+
 class Animation;
 
 typedef QSharedPointer<Animation> AnimationPointer;
@@ -45,6 +52,17 @@ public:
     Q_INVOKABLE AnimationPointer getAnimation(const QString& url) { return getAnimation(QUrl(url)); }
     Q_INVOKABLE AnimationPointer getAnimation(const QUrl& url);
 
+    /**jsdoc
+     * Sets how closely the frames of the animation clips loaded from now on follow their animation.  The larger the
+     * tolerance, the less memory the clips take.
+     * @function AnimationCache.setClipCompressionTolerance
+     * @param rotation {number} The largest rotation error of a joint, in degrees.
+     * @param translation {number} The largest translation error of a joint, relative to the length of its bone.
+     */
+    Q_INVOKABLE void setClipCompressionTolerance(float rotation, float translation);
+
+    AnimCompressedClip::Tolerance getClipCompressionTolerance() const;
+
 protected:
 
     virtual QSharedPointer<Resource> createResource(const QUrl& url, const QSharedPointer<Resource>& fallback,
@@ -53,6 +71,9 @@ private:
     explicit AnimationCache(QObject* parent = NULL);
     virtual ~AnimationCache() { }
 
+    mutable std::mutex _clipCompressionToleranceMutex;
+    AnimCompressedClip::Tolerance _clipCompressionTolerance;
+
 };
 
 Q_DECLARE_METATYPE(AnimationPointer)
@@ -107,5 +128,48 @@ private:
     QByteArray _data;
 };
 
+/// The frames of an AnimClip, converted to the skeleton it plays on.
+struct AnimClipFrames {
+    AnimCompressedClip anim;
+    AnimCompressedClip mirrorAnim;
+
+    // clips with too many frames to compress are played from these instead
+    std::vector<AnimPoseVec> uncompressedAnim;
+    std::vector<AnimPoseVec> uncompressedMirrorAnim;
+
+    int numFrames { 0 };
+    int numJoints { 0 };
+    bool hasMirror { false };
+    std::atomic<bool> isBuilt { false }; // the other members are only read once this is set
+};
+using AnimClipFramesPointer = std::shared_ptr<AnimClipFrames>;
+
+/// Builds the frames of an AnimClip in a worker thread, next to the readers of the animations.
+class AnimClipBuilder : public QRunnable {
+public:
+    /// Converts a loaded animation, and its mirror if buildMirror.
+    AnimClipBuilder(const AnimationPointer& animation, const AnimSkeleton::ConstPointer& skeleton, const QString& url,
+                    const AnimCompressedClip::Tolerance& tolerance, bool buildMirror, const AnimClipFramesPointer& framesOut);
+
+    /// Adds the mirror to frames built without one.
+    AnimClipBuilder(const std::shared_ptr<const AnimClipFrames>& frames, const AnimSkeleton::ConstPointer& skeleton,
+                    const QString& url, const AnimCompressedClip::Tolerance& tolerance, const AnimClipFramesPointer& framesOut);
+
+    virtual void run() override;
+
+private:
+    void convertAnimation(std::vector<AnimPoseVec>& anim) const;
+    void compress(const std::vector<AnimPoseVec>& anim, AnimCompressedClip& compressedOut,
+                  std::vector<AnimPoseVec>& uncompressedOut) const;
+
+    AnimationPointer _animation;
+    std::shared_ptr<const AnimClipFrames> _frames;
+    AnimSkeleton::ConstPointer _skeleton;
+    QString _url;
+    AnimCompressedClip::Tolerance _tolerance;
+    bool _buildMirror;
+    AnimClipFramesPointer _framesOut;
+};
+
 
 #endif // hifi_AnimationCache_h
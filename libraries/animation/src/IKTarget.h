@@ -48,6 +48,10 @@ public:
     void setWeight(float weight) { _weight = weight; }
     float getWeight() const { return _weight; }
 
+    // distance in meters, in the rig frame, at which the target counts as reached
+    void setErrorThreshold(float errorThreshold) { _errorThreshold = errorThreshold; }
+    float getErrorThreshold() const { return _errorThreshold; }
+
     enum FlexCoefficients { MAX_FLEX_COEFFICIENTS = 10 };
 
 private:
@@ -58,6 +62,7 @@ private:
     int _index { -1 };
     Type _type { Type::Unknown };
     float _weight { 0.0f };
+    float _errorThreshold { 0.0f };
     float _flexCoefficients[MAX_FLEX_COEFFICIENTS];
     size_t _numFlexCoefficients;
 };
@@ -18,6 +18,7 @@
 #include <QReadLocker>
 
 #include <GeometryUtil.h>
+#include <GLMHelpers.h>
 #include <NumericalConstants.h>
 #include <DebugDraw.h>
 #include <PerfStat.h>
@@ -59,6 +60,8 @@ const glm::vec3 DEFAULT_RIGHT_EYE_POS(-0.3f, 0.9f, 0.0f);
 const glm::vec3 DEFAULT_LEFT_EYE_POS(0.3f, 0.9f, 0.0f);
 const glm::vec3 DEFAULT_HEAD_POS(0.0f, 0.75f, 0.0f);
 
+const float Rig::REDUCED_ANIM_LOD_HZ = 15.0f;
+
 Rig::Rig() {
     // Ensure thread-safe access to the rigRegistry.
     std::lock_guard<std::mutex> guard(rigRegistryMutex);
@@ -384,6 +387,16 @@ void Rig::clearIKJointLimitHistory() {
     }
 }
 
+int Rig::getIKIterationsOnLastSolve() const {
+    auto ikNode = getAnimInverseKinematicsNode();
+    return ikNode ? ikNode->getNumIterationsOnLastSolve() : 0;
+}
+
+uint64_t Rig::getIKSolveTimeOnLastSolve() const {
+    auto ikNode = getAnimInverseKinematicsNode();
+    return ikNode ? ikNode->getSolveTimeOnLastSolve() : 0;
+}
+
 float Rig::getIKErrorOnLastSolve() const {
     float result = 0.0f;
 
@@ -605,6 +618,25 @@ void Rig::setEnableAnimations(bool enable) {
     _enabledAnimations = enable;
 }
 
+void Rig::setAnimLOD(AnimLOD lod) {
+    if (lod != _animLOD) {
+        _animLOD = lod;
+        // start the interpolation over from the next evaluation
+        _animLODTargetPoses.clear();
+    }
+}
+
+bool Rig::isAnimLODUpdateDue() const {
+    switch (_animLOD) {
+        case AnimLOD::Full:
+            return true;
+        case AnimLOD::Reduced:
+            return _animLODTime * REDUCED_ANIM_LOD_HZ >= 1.0f;
+        default:
+            return false;
+    }
+}
+
 AnimPose Rig::getAbsoluteDefaultPose(int index) const {
     if (_animSkeleton && index >= 0 && index < _animSkeleton->getNumJoints()) {
         return _absoluteDefaultPoses[index];
@@ -1039,19 +1071,34 @@ void Rig::updateAnimations(float deltaTime, const glm::mat4& rootTransform, cons
 
     setModelOffset(rootTransform);
 
-    if (_animNode && _enabledAnimations) {
+    _animLODTime += deltaTime;
+    if (_animLOD == AnimLOD::Frozen) {
+        return;
+    }
+
+    const bool reducedLOD = (_animLOD == AnimLOD::Reduced);
+    if (_animNode && _enabledAnimations && (!reducedLOD || isAnimLODUpdateDue() ||
+                                            _animLODTargetPoses.size() != _internalPoseSet._relativePoses.size())) {
         DETAILED_PERFORMANCE_TIMER("handleTriggers");
 
         updateAnimationStateHandlers();
         _animVars.setRigToGeometryTransform(_rigToGeometryTransform);
 
         AnimContext context(_enableDebugDrawIKTargets, _enableDebugDrawIKConstraints, _enableDebugDrawIKChains,
-                            getGeometryToRigTransform(), rigToWorldTransform);
+                            getGeometryToRigTransform(), rigToWorldTransform, !reducedLOD);
+
+        // at reduced LOD the graph catches up with the skipped updates, but not with a long freeze
+        const float MAX_REDUCED_ANIM_LOD_DELTA_TIME = 2.0f / REDUCED_ANIM_LOD_HZ;
+        float animDeltaTime = reducedLOD ? std::min(_animLODTime, MAX_REDUCED_ANIM_LOD_DELTA_TIME) : deltaTime;
+        _animLODTime = 0.0f;
+        if (reducedLOD) {
+            _animLODSourcePoses = _internalPoseSet._relativePoses;
+        }
 
         // evaluate the animation
         AnimNode::Triggers triggersOut;
 
-        _internalPoseSet._relativePoses = _animNode->evaluate(_animVars, context, deltaTime, triggersOut);
+        _internalPoseSet._relativePoses = _animNode->evaluate(_animVars, context, animDeltaTime, triggersOut);
         if ((int)_internalPoseSet._relativePoses.size() != _animSkeleton->getNumJoints()) {
             // animations haven't fully loaded yet.
             _internalPoseSet._relativePoses = _animSkeleton->getRelativeDefaultPoses();
@@ -1060,6 +1107,23 @@ void Rig::updateAnimations(float deltaTime, const glm::mat4& rootTransform, cons
         for (auto& trigger : triggersOut) {
             _animVars.setTrigger(trigger);
         }
+
+        if (reducedLOD) {
+            // the evaluated poses are reached by the next evaluation
+            _animLODTargetPoses = _internalPoseSet._relativePoses;
+            if (_animLODSourcePoses.size() == _animLODTargetPoses.size()) {
+                _internalPoseSet._relativePoses = _animLODSourcePoses;
+            } else {
+                _animLODSourcePoses = _animLODTargetPoses;
+            }
+        } else {
+            _animLODTargetPoses.clear();
+        }
+    } else if (_animNode && _enabledAnimations) {
+        // reduced LOD between evaluations
+        float alpha = std::min(_animLODTime * REDUCED_ANIM_LOD_HZ, 1.0f);
+        ::blend(_animLODTargetPoses.size(), _animLODSourcePoses.data(), _animLODTargetPoses.data(), alpha,
+                _internalPoseSet._relativePoses.data());
     }
     applyOverridePoses();
     buildAbsoluteRigPoses(_internalPoseSet._relativePoses, _internalPoseSet._absolutePoses);
@@ -1696,8 +1760,17 @@ void Rig::buildAbsoluteRigPoses(const AnimPoseVec& relativePoses, AnimPoseVec& a
 
     ASSERT(_animSkeleton->getNumJoints() == (int)relativePoses.size());
 
-    absolutePosesOut.resize(relativePoses.size());
     AnimPose geometryToRigTransform(_geometryToRigTransform);
+    if (_animSkeleton->getHierarchy().isValid && !isNonUniformScale(geometryToRigTransform.scale())) {
+        _poseBuffer.load(relativePoses);
+        if (_poseBuffer.hasUniformScale()) {
+            _poseBuffer.convertRelativeToAbsolute(_animSkeleton->getHierarchy(), geometryToRigTransform);
+            _poseBuffer.store(absolutePosesOut);
+            return;
+        }
+    }
+
+    absolutePosesOut.resize(relativePoses.size());
     for (int i = 0; i < (int)relativePoses.size(); i++) {
         int parentIndex = _animSkeleton->getParentIndex(i);
         if (parentIndex == -1) {
@@ -1718,6 +1791,12 @@ glm::mat4 Rig::getJointTransform(int jointIndex) const {
     }
 }
 
+void Rig::getJointTransforms(std::vector<glm::mat4>& transformsOut) const {
+    _poseBuffer.load(_internalPoseSet._absolutePoses);
+    transformsOut.resize(_poseBuffer.size());
+    _poseBuffer.computeMatrices(transformsOut.data());
+}
+
 AnimPose Rig::getJointPose(int jointIndex) const {
     if (isIndexValid(jointIndex)) {
         return _internalPoseSet._absolutePoses[jointIndex];
@@ -1800,6 +1879,7 @@ void Rig::copyJointsFromJointData(const QVector<JointData>& jointDataVec) {
 }
 
 void Rig::computeExternalPoses(const glm::mat4& modelOffsetMat) {
+    _animLODTime = 0.0f;
     _modelOffset = AnimPose(modelOffsetMat);
     _geometryToRigTransform = _modelOffset * _geometryOffset;
     _rigToGeometryTransform = glm::inverse(_geometryToRigTransform);
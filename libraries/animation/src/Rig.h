@@ -102,6 +102,15 @@ public:
         Hover
     };
 
+    // Animation level of detail, lower levels update the poses less often and skip the expensive nodes
+    enum class AnimLOD {
+        Full = 0,  // every update
+        Reduced,   // at REDUCED_ANIM_LOD_HZ without IK and manipulator nodes, interpolated in between
+        Frozen,    // never, the poses stay as they are
+        NumLODs
+    };
+    static const float REDUCED_ANIM_LOD_HZ;
+
     Rig();
     virtual ~Rig();
 
@@ -133,6 +142,8 @@ public:
     float getMaxHipsOffsetLength() const;
 
     float getIKErrorOnLastSolve() const;
+    int getIKIterationsOnLastSolve() const;
+    uint64_t getIKSolveTimeOnLastSolve() const;
 
     int getJointParentIndex(int childIndex) const;
 
@@ -166,6 +177,9 @@ public:
     glm::mat4 getJointTransform(int jointIndex) const;
     AnimPose getJointPose(int jointIndex) const;
 
+    // rig space, getJointTransform() of every joint at once
+    void getJointTransforms(std::vector<glm::mat4>& transformsOut) const;
+
     // Start or stop animations as needed.
     void computeMotionAnimationState(float deltaTime, const glm::vec3& worldPosition, const glm::vec3& worldVelocity, const glm::quat& worldRotation, CharacterControllerState ccState);
 
@@ -205,6 +219,15 @@ public:
     void setEnableInverseKinematics(bool enable);
     void setEnableAnimations(bool enable);
 
+    void setAnimLOD(AnimLOD lod);
+    AnimLOD getAnimLOD() const { return _animLOD; }
+
+    // For rigs driven by joint data rather than an anim graph: accumulates the time since the poses were last
+    // computed, isAnimLODUpdateDue() then says whether the current LOD wants them computed again.
+    // computeExternalPoses() restarts the count.
+    void accumulateAnimLODTime(float deltaTime) { _animLODTime += deltaTime; }
+    bool isAnimLODUpdateDue() const;
+
     const glm::mat4& getGeometryToRigTransform() const { return _geometryToRigTransform; }
 
     const AnimPose& getModelOffsetPose() const { return _modelOffset; }
@@ -262,6 +285,14 @@ protected:
 
     AnimPoseVec _absoluteDefaultPoses; // rig space, not relative to parent.
 
+    // scratch space for the SIMD pose kernels
+    mutable AnimPoseBuffer _poseBuffer;
+
+    AnimLOD _animLOD { AnimLOD::Full };
+    float _animLODTime { 0.0f };          // since the poses were last evaluated
+    AnimPoseVec _animLODSourcePoses;      // reduced LOD interpolates from these...
+    AnimPoseVec _animLODTargetPoses;      // ...to the last evaluated poses
+
     glm::mat4 _geometryToRigTransform;
     glm::mat4 _rigToGeometryTransform;
 
@@ -0,0 +1,76 @@
+//
+//  AnimPoseBuffer_avx2.cpp
+//  libraries/animation/src/avx2
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "../AnimPoseBuffer.h"
+
+// nlerp of the rotations and lerp of the rest, eight joints at a time
+void blendPoses_AVX2(const float* a, const float* b, float alpha, float* result, size_t stride) {
+
+    assert(stride % 8 == 0);
+
+    const __m256 t = _mm256_set1_ps(alpha);
+    const __m256 oneMinusT = _mm256_set1_ps(1.0f - alpha);
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    static const int LERPED_COMPONENTS[] = {
+        AnimPoseBuffer::ScaleX, AnimPoseBuffer::ScaleY, AnimPoseBuffer::ScaleZ,
+        AnimPoseBuffer::TransX, AnimPoseBuffer::TransY, AnimPoseBuffer::TransZ
+    };
+
+    for (size_t i = 0; i < stride; i += 8) {
+
+        for (int component : LERPED_COMPONENTS) {
+            size_t k = component * stride + i;
+            __m256 x = _mm256_fmadd_ps(_mm256_loadu_ps(&b[k]), t, _mm256_mul_ps(_mm256_loadu_ps(&a[k]), oneMinusT));
+            _mm256_storeu_ps(&result[k], x);
+        }
+
+        const float* aRot = &a[AnimPoseBuffer::RotX * stride + i];
+        const float* bRot = &b[AnimPoseBuffer::RotX * stride + i];
+        __m256 ax = _mm256_loadu_ps(&aRot[0 * stride]);
+        __m256 ay = _mm256_loadu_ps(&aRot[1 * stride]);
+        __m256 az = _mm256_loadu_ps(&aRot[2 * stride]);
+        __m256 aw = _mm256_loadu_ps(&aRot[3 * stride]);
+        __m256 bx = _mm256_loadu_ps(&bRot[0 * stride]);
+        __m256 by = _mm256_loadu_ps(&bRot[1 * stride]);
+        __m256 bz = _mm256_loadu_ps(&bRot[2 * stride]);
+        __m256 bw = _mm256_loadu_ps(&bRot[3 * stride]);
+
+        // adjust signs if necessary
+        __m256 dot = _mm256_fmadd_ps(aw, bw, _mm256_fmadd_ps(az, bz, _mm256_fmadd_ps(ay, by, _mm256_mul_ps(ax, bx))));
+        __m256 sign = _mm256_and_ps(_mm256_cmp_ps(dot, _mm256_setzero_ps(), _CMP_LT_OQ), signMask);
+        bx = _mm256_xor_ps(bx, sign);
+        by = _mm256_xor_ps(by, sign);
+        bz = _mm256_xor_ps(bz, sign);
+        bw = _mm256_xor_ps(bw, sign);
+
+        __m256 x = _mm256_fmadd_ps(bx, t, _mm256_mul_ps(ax, oneMinusT));
+        __m256 y = _mm256_fmadd_ps(by, t, _mm256_mul_ps(ay, oneMinusT));
+        __m256 z = _mm256_fmadd_ps(bz, t, _mm256_mul_ps(az, oneMinusT));
+        __m256 w = _mm256_fmadd_ps(bw, t, _mm256_mul_ps(aw, oneMinusT));
+
+        __m256 length = _mm256_sqrt_ps(_mm256_fmadd_ps(w, w, _mm256_fmadd_ps(z, z,
+                                       _mm256_fmadd_ps(y, y, _mm256_mul_ps(x, x)))));
+
+        float* rot = &result[AnimPoseBuffer::RotX * stride + i];
+        _mm256_storeu_ps(&rot[0 * stride], _mm256_div_ps(x, length));
+        _mm256_storeu_ps(&rot[1 * stride], _mm256_div_ps(y, length));
+        _mm256_storeu_ps(&rot[2 * stride], _mm256_div_ps(z, length));
+        _mm256_storeu_ps(&rot[3 * stride], _mm256_div_ps(w, length));
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
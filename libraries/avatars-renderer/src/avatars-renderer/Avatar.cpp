@@ -429,10 +429,12 @@ void Avatar::simulate(float deltaTime, bool inView) {
         PROFILE_RANGE(simulation, "updateJoints");
         if (inView) {
             Head* head = getHead();
-            if (_hasNewJointData) {
-                _skeletonModel->getRig().copyJointsFromJointData(_jointData);
-                glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-                _skeletonModel->getRig().computeExternalPoses(rootTransform);
+            if (isJointPoseUpdateDue()) {
+                // the AvatarManager has usually computed the poses on the workers already
+                if (!_hasNewJointPoses) {
+                    updateJointPoses();
+                }
+                _hasNewJointPoses = false;
                 _jointDataSimulationRate.increment();
 
                 _skeletonModel->simulate(deltaTime, true);
@@ -485,6 +487,30 @@ void Avatar::simulate(float deltaTime, bool inView) {
     }
 }
 
+void Avatar::updateJointPoses() {
+    if (!_hasNewJointData) {
+        return;
+    }
+    Rig& rig = _skeletonModel->getRig();
+    {
+        QReadLocker readLock(&_jointDataLock);
+        rig.copyJointsFromJointData(_jointData);
+    }
+    glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+    rig.computeExternalPoses(rootTransform);
+    _hasNewJointPoses = true;
+}
+
+void Avatar::setAnimLOD(Rig::AnimLOD lod, float deltaTime) {
+    Rig& rig = _skeletonModel->getRig();
+    rig.setAnimLOD(lod);
+    rig.accumulateAnimLODTime(deltaTime);
+}
+
+bool Avatar::isJointPoseUpdateDue() const {
+    return _hasNewJointData && _skeletonModel->getRig().isAnimLODUpdateDue();
+}
+
 float Avatar::getSimulationRate(const QString& rateName) const {
     if (rateName == "") {
         return _simulationRate.rate();
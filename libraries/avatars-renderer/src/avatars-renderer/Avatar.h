@@ -89,6 +89,15 @@ public:
     void simulate(float deltaTime, bool inView);
     virtual void simulateAttachments(float deltaTime);
 
+    // Converts new joint data into the poses of the rig, ahead of simulate.  It only touches this avatar's
+    // rig, so the AvatarManager runs it for many avatars at once on the workers.
+    void updateJointPoses();
+
+    // Sets the animation LOD of the rig for this frame, ahead of updateJointPoses() and simulate().  Joint data
+    // is only turned into poses when the LOD is due an update.
+    void setAnimLOD(Rig::AnimLOD lod, float deltaTime);
+    bool isJointPoseUpdateDue() const;
+
     virtual void render(RenderArgs* renderArgs);
 
     void addToScene(AvatarSharedPointer self, const render::ScenePointer& scene,
@@ -382,6 +391,7 @@ protected:
     MapOfAvatarEntityDataHashes _avatarEntityDataHashes;
 
     uint64_t _lastRenderUpdateTime { 0 };
+    bool _hasNewJointPoses { false };
     int _leftPointerGeometryID { 0 };
     int _rightPointerGeometryID { 0 };
     int _nameRectGeometryID { 0 };
@@ -1855,8 +1855,10 @@ void AvatarData::sendAvatarDataPacket() {
 }
 
 void AvatarData::sendIdentityPacket() {
-    auto nodeList = DependencyManager::get<NodeList>();
+    sendIdentityPacket(*DependencyManager::get<NodeList>());
+}
 
+void AvatarData::sendIdentityPacket(LimitedNodeList& nodeList) {
     if (_identityDataChanged) {
         // if the identity data has changed, push the sequence number forwards
         ++_identitySequenceNumber;
@@ -1866,12 +1868,12 @@ void AvatarData::sendIdentityPacket() {
 
     auto packetList = NLPacketList::create(PacketType::AvatarIdentity, QByteArray(), true, true);
     packetList->write(identityData);
-    nodeList->eachMatchingNode(
+    nodeList.eachMatchingNode(
         [&](const SharedNodePointer& node)->bool {
             return node->getType() == NodeType::AvatarMixer && node->getActiveSocket();
         },
         [&](const SharedNodePointer& node) {
-            nodeList->sendPacketList(std::move(packetList), *node);
+            nodeList.sendPacketList(std::move(packetList), *node);
     });
 
     _avatarEntityDataLocallyEdited = false;
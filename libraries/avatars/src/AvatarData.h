@@ -316,6 +316,7 @@ Q_DECLARE_METATYPE(KillAvatarReason);
 class QDataStream;
 
 class AttachmentData;
+class LimitedNodeList;
 class Transform;
 using TransformPointer = std::shared_ptr<Transform>;
 
@@ -610,6 +611,9 @@ public:
 
     QByteArray identityByteArray(bool setIsReplicated = false) const;
 
+    // Sends the identity through nodeList, for avatars that are not the one of the process's NodeList
+    void sendIdentityPacket(LimitedNodeList& nodeList);
+
     const QUrl& getSkeletonModelURL() const { return _skeletonModelURL; }
     const QString& getDisplayName() const { return _displayName; }
     const QString& getSessionDisplayName() const { return _sessionDisplayName; }
@@ -0,0 +1,341 @@
+//
+//  MeshOptimizer.cpp
+//  libraries/baking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+
+const int MeshOptimizer::CACHE_SIZE;
+constexpr float MeshOptimizer::OVERDRAW_ACMR_THRESHOLD;
+
+// Forsyth's scoring, see https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html
+static const float CACHE_DECAY_POWER = 1.5f;
+static const float LAST_TRIANGLE_SCORE = 0.75f;
+static const float VALENCE_BOOST_SCALE = 2.0f;
+static const float VALENCE_BOOST_POWER = 0.5f;
+
+static float evalVertexScore(int cachePosition, int remainingTriangles) {
+    if (remainingTriangles == 0) {
+        // nothing left to draw with this vertex
+        return -1.0f;
+    }
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            // it was used by the last triangle, which doesn't favour that triangle's vertices in particular
+            score = LAST_TRIANGLE_SCORE;
+        } else {
+            const float scaler = 1.0f / (MeshOptimizer::CACHE_SIZE - 3);
+            score = powf(1.0f - (cachePosition - 3) * scaler, CACHE_DECAY_POWER);
+        }
+    }
+
+    // finish off vertices with few triangles left so they leave the cache for good
+    score += VALENCE_BOOST_SCALE * powf((float)remainingTriangles, -VALENCE_BOOST_POWER);
+    return score;
+}
+
+int MeshOptimizer::countCacheMisses(const QVector<int>& indices, int numVertices, int cacheSize) {
+    // a vertex is in the FIFO if fewer than cacheSize vertices were loaded since it was
+    std::vector<int> loadedAt(numVertices, -cacheSize - 1);
+    int numLoaded = 0;
+    for (int index : indices) {
+        if (numLoaded - loadedAt[index] > cacheSize) {
+            loadedAt[index] = numLoaded++;
+        }
+    }
+    return numLoaded;
+}
+
+QVector<int> MeshOptimizer::optimizeVertexCache(const QVector<int>& indices, int numVertices) {
+    const int numTriangles = indices.size() / 3;
+
+    // the triangles of each vertex that are still to be drawn sit at the front of its adjacency range
+    std::vector<int> remaining(numVertices, 0);
+    for (int i = 0; i < numTriangles * 3; ++i) {
+        remaining[indices[i]]++;
+    }
+    std::vector<int> adjacencyOffsets(numVertices + 1, 0);
+    for (int vertex = 0; vertex < numVertices; ++vertex) {
+        adjacencyOffsets[vertex + 1] = adjacencyOffsets[vertex] + remaining[vertex];
+    }
+    std::vector<int> adjacency(adjacencyOffsets.back());
+    {
+        std::vector<int> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (int i = 0; i < numTriangles * 3; ++i) {
+            adjacency[fill[indices[i]]++] = i / 3;
+        }
+    }
+
+    std::vector<int> cachePosition(numVertices, -1);
+    std::vector<float> vertexScore(numVertices);
+    for (int vertex = 0; vertex < numVertices; ++vertex) {
+        vertexScore[vertex] = evalVertexScore(-1, remaining[vertex]);
+    }
+    std::vector<float> triangleScore(numTriangles);
+    for (int triangle = 0; triangle < numTriangles; ++triangle) {
+        triangleScore[triangle] = vertexScore[indices[triangle * 3]] + vertexScore[indices[triangle * 3 + 1]]
+            + vertexScore[indices[triangle * 3 + 2]];
+    }
+    std::vector<bool> drawn(numTriangles, false);
+
+    QVector<int> order;
+    order.reserve(numTriangles);
+    std::vector<int> cache;
+    std::vector<int> newCache;
+    cache.reserve(CACHE_SIZE + 3);
+    newCache.reserve(CACHE_SIZE + 3);
+    int nextUndrawn = 0;
+    int bestTriangle = -1;
+
+    while (order.size() < numTriangles) {
+        if (bestTriangle < 0) {
+            // the cache has nothing left to draw, carry on from the first triangle not drawn yet
+            while (drawn[nextUndrawn]) {
+                ++nextUndrawn;
+            }
+            bestTriangle = nextUndrawn;
+        }
+
+        order.push_back(bestTriangle);
+        drawn[bestTriangle] = true;
+
+        // the triangle's vertices go to the front of the cache
+        newCache.clear();
+        for (int corner = 0; corner < 3; ++corner) {
+            int vertex = indices[bestTriangle * 3 + corner];
+            if (std::find(newCache.begin(), newCache.end(), vertex) == newCache.end()) {
+                newCache.push_back(vertex);
+            }
+
+            int* live = &adjacency[adjacencyOffsets[vertex]];
+            int* liveEnd = live + remaining[vertex];
+            auto found = std::find(live, liveEnd, bestTriangle);
+            if (found != liveEnd) {
+                std::swap(*found, *(liveEnd - 1));
+                remaining[vertex]--;
+            }
+        }
+        for (int vertex : cache) {
+            if (std::find(newCache.begin(), newCache.end(), vertex) == newCache.end()) {
+                newCache.push_back(vertex);
+            }
+        }
+
+        // rescore everything that moved, including what fell out of the cache
+        for (int i = 0; i < (int)newCache.size(); ++i) {
+            int vertex = newCache[i];
+            cachePosition[vertex] = i < CACHE_SIZE ? i : -1;
+            float score = evalVertexScore(cachePosition[vertex], remaining[vertex]);
+            float delta = score - vertexScore[vertex];
+            vertexScore[vertex] = score;
+            for (int j = 0; j < remaining[vertex]; ++j) {
+                triangleScore[adjacency[adjacencyOffsets[vertex] + j]] += delta;
+            }
+        }
+        if ((int)newCache.size() > CACHE_SIZE) {
+            newCache.resize(CACHE_SIZE);
+        }
+        std::swap(cache, newCache);
+
+        // the next triangle is the best one that uses a cached vertex
+        bestTriangle = -1;
+        float bestScore = -1.0f;
+        for (int vertex : cache) {
+            for (int j = 0; j < remaining[vertex]; ++j) {
+                int triangle = adjacency[adjacencyOffsets[vertex] + j];
+                if (triangleScore[triangle] > bestScore) {
+                    bestScore = triangleScore[triangle];
+                    bestTriangle = triangle;
+                }
+            }
+        }
+    }
+
+    return order;
+}
+
+QVector<int> MeshOptimizer::optimizeOverdraw(const QVector<int>& indices, const QVector<glm::vec3>& positions,
+                                             float threshold) {
+    const int numTriangles = indices.size() / 3;
+    QVector<int> identity(numTriangles);
+    for (int triangle = 0; triangle < numTriangles; ++triangle) {
+        identity[triangle] = triangle;
+    }
+
+    // split where a triangle misses the cache on all three vertices, moving those clusters around
+    // hardly changes how well the cache is used
+    std::vector<int> clusterStarts;
+    {
+        std::vector<int> loadedAt(positions.size(), -CACHE_SIZE - 1);
+        int numLoaded = 0;
+        for (int triangle = 0; triangle < numTriangles; ++triangle) {
+            int misses = 0;
+            for (int corner = 0; corner < 3; ++corner) {
+                int vertex = indices[triangle * 3 + corner];
+                if (numLoaded - loadedAt[vertex] > CACHE_SIZE) {
+                    loadedAt[vertex] = numLoaded++;
+                    ++misses;
+                }
+            }
+            if (triangle == 0 || misses == 3) {
+                clusterStarts.push_back(triangle);
+            }
+        }
+    }
+    if (clusterStarts.size() < 2) {
+        return identity;
+    }
+    clusterStarts.push_back(numTriangles);
+
+    // clusters that face away from the middle of the mesh are on its outside, so draw those first
+    const int numClusters = (int)clusterStarts.size() - 1;
+    std::vector<glm::vec3> clusterCentroids(numClusters);
+    std::vector<glm::vec3> clusterNormals(numClusters);
+    glm::vec3 meshCentroid { 0.0f };
+    float meshArea = 0.0f;
+    for (int cluster = 0; cluster < numClusters; ++cluster) {
+        glm::vec3 centroid { 0.0f };
+        glm::vec3 normal { 0.0f };
+        float area = 0.0f;
+        for (int triangle = clusterStarts[cluster]; triangle < clusterStarts[cluster + 1]; ++triangle) {
+            const glm::vec3& p0 = positions[indices[triangle * 3]];
+            const glm::vec3& p1 = positions[indices[triangle * 3 + 1]];
+            const glm::vec3& p2 = positions[indices[triangle * 3 + 2]];
+            glm::vec3 weightedNormal = glm::cross(p1 - p0, p2 - p0);
+            float triangleArea = glm::length(weightedNormal);
+            centroid += (p0 + p1 + p2) * (triangleArea / 3.0f);
+            normal += weightedNormal;
+            area += triangleArea;
+        }
+        meshCentroid += centroid;
+        meshArea += area;
+        clusterCentroids[cluster] = area > 0.0f ? centroid / area : positions[indices[clusterStarts[cluster] * 3]];
+        float normalLength = glm::length(normal);
+        clusterNormals[cluster] = normalLength > 0.0f ? normal / normalLength : glm::vec3(0.0f);
+    }
+    if (meshArea > 0.0f) {
+        meshCentroid /= meshArea;
+    }
+
+    std::vector<float> sortKeys(numClusters);
+    std::vector<int> clusterOrder(numClusters);
+    for (int cluster = 0; cluster < numClusters; ++cluster) {
+        sortKeys[cluster] = glm::dot(clusterCentroids[cluster] - meshCentroid, clusterNormals[cluster]);
+        clusterOrder[cluster] = cluster;
+    }
+    std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&](int a, int b) {
+        return sortKeys[a] > sortKeys[b];
+    });
+
+    QVector<int> order;
+    order.reserve(numTriangles);
+    QVector<int> reordered;
+    reordered.reserve(indices.size());
+    for (int cluster : clusterOrder) {
+        for (int triangle = clusterStarts[cluster]; triangle < clusterStarts[cluster + 1]; ++triangle) {
+            order.push_back(triangle);
+            reordered << indices[triangle * 3] << indices[triangle * 3 + 1] << indices[triangle * 3 + 2];
+        }
+    }
+
+    int missesBefore = countCacheMisses(indices, positions.size());
+    int missesAfter = countCacheMisses(reordered, positions.size());
+    if (missesAfter > missesBefore * threshold) {
+        return identity;
+    }
+    return order;
+}
+
+template <typename T>
+static QByteArray attributeBytes(const QVector<T>& attribute, int vertex) {
+    if (vertex >= attribute.size()) {
+        return QByteArray();
+    }
+    return QByteArray::fromRawData(reinterpret_cast<const char*>(&attribute[vertex]), sizeof(T));
+}
+
+static QVector<int> reorderTriangles(const QVector<int>& indices, const QVector<int>& order) {
+    QVector<int> reordered;
+    reordered.reserve(indices.size());
+    for (int triangle : order) {
+        reordered << indices[triangle * 3] << indices[triangle * 3 + 1] << indices[triangle * 3 + 2];
+    }
+    return reordered;
+}
+
+MeshOptimizer::Stats MeshOptimizer::optimizeMesh(FBXMesh& mesh, bool withOriginalIndices) {
+    Stats stats;
+
+    // number the distinct vertices, attributes that aren't there are empty
+    const int numVertices = mesh.vertices.size();
+    QVector<int> distinctVertices(numVertices);
+    QVector<glm::vec3> distinctPositions;
+    {
+        QHash<QByteArray, int> distinctVertexIDs;
+        for (int vertex = 0; vertex < numVertices; ++vertex) {
+            QByteArray key = attributeBytes(mesh.vertices, vertex) + attributeBytes(mesh.normals, vertex)
+                + attributeBytes(mesh.colors, vertex) + attributeBytes(mesh.texCoords, vertex)
+                + attributeBytes(mesh.texCoords1, vertex);
+            if (withOriginalIndices) {
+                key += attributeBytes(mesh.originalIndices, vertex);
+            }
+            auto found = distinctVertexIDs.find(key);
+            if (found == distinctVertexIDs.end()) {
+                found = distinctVertexIDs.insert(key, distinctPositions.size());
+                distinctPositions.push_back(mesh.vertices[vertex]);
+            }
+            distinctVertices[vertex] = found.value();
+        }
+    }
+
+    auto optimizeTriangles = [&](QVector<int>& indices) {
+        if (indices.isEmpty() || indices.size() % 3 != 0) {
+            return;
+        }
+        QVector<int> distinctIndices;
+        distinctIndices.reserve(indices.size());
+        for (int index : indices) {
+            if (index < 0 || index >= numVertices) {
+                return;
+            }
+            distinctIndices.push_back(distinctVertices[index]);
+        }
+
+        stats.numTriangles += indices.size() / 3;
+        stats.cacheMissesBefore += countCacheMisses(distinctIndices, distinctPositions.size());
+
+        auto cacheOrder = optimizeVertexCache(distinctIndices, distinctPositions.size());
+        distinctIndices = reorderTriangles(distinctIndices, cacheOrder);
+        auto overdrawOrder = optimizeOverdraw(distinctIndices, distinctPositions);
+        distinctIndices = reorderTriangles(distinctIndices, overdrawOrder);
+
+        QVector<int> order;
+        order.reserve(overdrawOrder.size());
+        for (int triangle : overdrawOrder) {
+            order.push_back(cacheOrder[triangle]);
+        }
+        indices = reorderTriangles(indices, order);
+
+        stats.cacheMissesAfter += countCacheMisses(distinctIndices, distinctPositions.size());
+    };
+
+    for (auto& part : mesh.parts) {
+        optimizeTriangles(part.quadTrianglesIndices);
+        optimizeTriangles(part.triangleIndices);
+    }
+    return stats;
+}
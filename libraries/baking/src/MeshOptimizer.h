@@ -0,0 +1,57 @@
+//
+//  MeshOptimizer.h
+//  libraries/baking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MeshOptimizer_h
+#define hifi_MeshOptimizer_h
+
+#include <QtCore/QVector>
+
+#include <glm/glm.hpp>
+
+#include <FBX.h>
+
+// Reorders the triangles of a mesh for the GPU: first for the post transform vertex cache (Tom Forsyth's linear
+// speed optimizer), then clusters of those triangles are sorted so the outward facing ones draw first and hide
+// what is behind them, as long as that costs little cache efficiency.
+//
+// Vertices are compared by value, the way the Draco mesh builder merges them, so the optimization works on the
+// vertices the GPU will see even when the mesh was extracted without deduplication.
+class MeshOptimizer {
+public:
+    // FIFO cache size the ACMR is measured against, and LRU cache size the optimizer assumes
+    static const int CACHE_SIZE = 32;
+
+    // how much worse than the vertex cache order the overdraw order may be
+    static constexpr float OVERDRAW_ACMR_THRESHOLD = 1.05f;
+
+    class Stats {
+    public:
+        int numTriangles { 0 };
+        int cacheMissesBefore { 0 };
+        int cacheMissesAfter { 0 };
+
+        // average cache miss ratio: vertex shader invocations per triangle, 0.5 is ideal for a regular grid and 3 the worst
+        float getACMRBefore() const { return numTriangles ? (float)cacheMissesBefore / numTriangles : 0.0f; }
+        float getACMRAfter() const { return numTriangles ? (float)cacheMissesAfter / numTriangles : 0.0f; }
+    };
+
+    // Reorders the triangles of every part of mesh.  Set withOriginalIndices when the original indices get encoded,
+    // they keep vertices that are otherwise equal apart.
+    static Stats optimizeMesh(FBXMesh& mesh, bool withOriginalIndices);
+
+    static int countCacheMisses(const QVector<int>& indices, int numVertices, int cacheSize = CACHE_SIZE);
+
+    // These return the new triangle order
+    static QVector<int> optimizeVertexCache(const QVector<int>& indices, int numVertices);
+    static QVector<int> optimizeOverdraw(const QVector<int>& indices, const QVector<glm::vec3>& positions,
+                                         float threshold = OVERDRAW_ACMR_THRESHOLD);
+};
+
+#endif // hifi_MeshOptimizer_h
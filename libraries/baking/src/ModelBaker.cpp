@@ -11,6 +11,8 @@
 
 #include "ModelBaker.h"
 
+#include "MeshOptimizer.h"
+
 #include <PathUtils.h>
 
 #include <FBXReader.h>
@@ -28,6 +30,8 @@
 #pragma warning( pop )
 #endif
 
+std::atomic<bool> ModelBaker::_meshOptimizationEnabled { true };
+
 ModelBaker::ModelBaker(const QUrl& inputModelURL, TextureBakerThreadGetter inputTextureThreadGetter,
                        const QString& bakedOutputDirectory, const QString& originalOutputDirectory) :
     _modelURL(inputModelURL),
@@ -95,6 +99,15 @@ bool ModelBaker::compressMesh(FBXMesh& mesh, bool hasDeformers, FBXNode& dracoMe
         return false;
     }
 
+    bool hasPerFaceMaterials = (materialIDCallback) ? (mesh.parts.size() > 1 || materialIDCallback(0) != 0 ) : true;
+    bool needsOriginalIndices{ hasDeformers };
+
+    MeshOptimizer::Stats optimizerStats;
+    bool isOptimized = _meshOptimizationEnabled;
+    if (isOptimized) {
+        optimizerStats = MeshOptimizer::optimizeMesh(mesh, needsOriginalIndices);
+    }
+
     draco::TriangleSoupMeshBuilder meshBuilder;
 
     meshBuilder.Start(numTriangles);
@@ -103,8 +116,6 @@ bool ModelBaker::compressMesh(FBXMesh& mesh, bool hasDeformers, FBXNode& dracoMe
     bool hasColors{ mesh.colors.size() > 0 };
     bool hasTexCoords{ mesh.texCoords.size() > 0 };
     bool hasTexCoords1{ mesh.texCoords1.size() > 0 };
-    bool hasPerFaceMaterials = (materialIDCallback) ? (mesh.parts.size() > 1 || materialIDCallback(0) != 0 ) : true;
-    bool needsOriginalIndices{ hasDeformers };
 
     int normalsAttributeID { -1 };
     int colorsAttributeID { -1 };
@@ -230,10 +241,20 @@ bool ModelBaker::compressMesh(FBXMesh& mesh, bool hasDeformers, FBXNode& dracoMe
     encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 12);
     encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
     encoder.SetSpeedOptions(0, 5);
+    if (isOptimized) {
+        // edgebreaker traverses the faces in its own order, which would undo the optimization
+        encoder.SetEncodingMethod(draco::MESH_SEQUENTIAL_ENCODING);
+    }
 
     draco::EncoderBuffer buffer;
     encoder.EncodeMeshToBuffer(*dracoMesh, &buffer);
 
+    if (isOptimized) {
+        qCDebug(model_baking).nospace() << "Optimized mesh " << mesh.meshIndex << ": " << optimizerStats.numTriangles
+            << " triangles, ACMR " << optimizerStats.getACMRBefore() << " -> " << optimizerStats.getACMRAfter()
+            << ", " << buffer.size() << " bytes";
+    }
+
     FBXNode dracoNode;
     dracoNode.name = "DracoMesh";
     auto value = QVariant::fromValue(QByteArray(buffer.data(), (int)buffer.size()));
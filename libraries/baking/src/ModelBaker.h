@@ -12,6 +12,8 @@
 #ifndef hifi_ModelBaker_h
 #define hifi_ModelBaker_h
 
+#include <atomic>
+
 #include <QtCore/QFutureSynchronizer>
 #include <QtCore/QDir>
 #include <QtCore/QUrl>
@@ -44,6 +46,11 @@ public:
     QUrl getModelURL() const { return _modelURL; }
     QString getBakedModelFilePath() const { return _bakedModelFilePath; }
 
+    // Reorder the triangles of baked meshes for the vertex cache and overdraw (see MeshOptimizer).  On by default, the
+    // reordered meshes are encoded with Draco's sequential method, which makes larger files than edgebreaker.
+    static void setMeshOptimizationEnabled(bool enabled) { _meshOptimizationEnabled = enabled; }
+    static bool isMeshOptimizationEnabled() { return _meshOptimizationEnabled; }
+
 public slots:
     virtual void abort() override;
 
@@ -74,6 +81,8 @@ private:
     QHash<QString, int> _textureNameMatchCount;
     QHash<QUrl, QString> _remappedTexturePaths;
     bool _pendingErrorEmission{ false };
+
+    static std::atomic<bool> _meshOptimizationEnabled;
 };
 
 #endif // hifi_ModelBaker_h
@@ -9,9 +9,11 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QDir>
 #include <QtCore/QEventLoop>
 #include <QtCore/QFile>
+#include <QtCore/QSaveFile>
 #include <QtNetwork/QNetworkReply>
 
 #include <image/Image.h>
@@ -25,6 +27,9 @@
 
 const QString BAKED_TEXTURE_EXT = ".ktx";
 
+std::atomic<bool> TextureBaker::_supercompressionEnabled { false };
+QString TextureBaker::_bakedTextureCacheDirectory;
+
 TextureBaker::TextureBaker(const QUrl& textureURL, image::TextureUsage::Type textureType,
                            const QDir& outputDirectory, const QString& bakedFilename,
                            const QByteArray& textureContent) :
@@ -112,7 +117,53 @@ void TextureBaker::handleTextureNetworkReply() {
     }
 }
 
+QString TextureBaker::getBakedTextureCacheFileName(const QByteArray& originalTexture,
+                                                  image::TextureUsage::Type textureType) {
+    // the same image baked as a different type of texture or with a different compression is a different bake
+    QString fileName = QCryptographicHash::hash(originalTexture, QCryptographicHash::Sha256).toHex();
+    fileName += "-" + QString::number((int)textureType);
+    if (_supercompressionEnabled) {
+        fileName += "-supercompressed";
+    }
+    return fileName + BAKED_TEXTURE_EXT;
+}
+
+bool TextureBaker::copyFromBakedTextureCache(const QString& cachedFilePath) {
+    if (!QFile::exists(cachedFilePath)) {
+        return false;
+    }
+
+    auto filePath = _outputDirectory.absoluteFilePath(_bakedTextureFileName);
+    QFile::remove(filePath);
+    if (!QFile::copy(cachedFilePath, filePath)) {
+        qCWarning(model_baking) << "Could not copy cached baked texture" << cachedFilePath << "for" << _textureURL;
+        return false;
+    }
+
+    _outputFiles.push_back(filePath);
+    qCDebug(model_baking) << "Reused baked texture" << cachedFilePath << "for" << _textureURL;
+    return true;
+}
+
+void TextureBaker::addToBakedTextureCache(const QString& cachedFilePath, const char* data, qint64 length) {
+    // other ovens may be baking the same texture, QSaveFile only moves a complete file into place
+    QSaveFile cachedFile { cachedFilePath };
+    if (!cachedFile.open(QIODevice::WriteOnly) || cachedFile.write(data, length) != length || !cachedFile.commit()) {
+        qCWarning(model_baking) << "Could not add baked texture for" << _textureURL << "to the cache";
+    }
+}
+
 void TextureBaker::processTexture() {
+    QString cachedFilePath;
+    if (!_bakedTextureCacheDirectory.isEmpty()) {
+        cachedFilePath = QDir(_bakedTextureCacheDirectory).absoluteFilePath(
+            getBakedTextureCacheFileName(_originalTexture, _textureType));
+        if (copyFromBakedTextureCache(cachedFilePath)) {
+            setIsFinished(true);
+            return;
+        }
+    }
+
     // the baked textures need to have the source hash added for cache checks in Interface
     // so we add that to the processed texture before handling it off to be serialized
     auto hashData = QCryptographicHash::hash(_originalTexture, QCryptographicHash::Md5);
@@ -140,8 +191,17 @@ void TextureBaker::processTexture() {
         return;
     }
 
-    const char* data = reinterpret_cast<const char*>(memKTX->_storage->data());
-    const size_t length = memKTX->_storage->size();
+    ktx::StoragePointer ktxStorage = memKTX->_storage;
+    if (_supercompressionEnabled) {
+        ktxStorage = ktx::KTX::supercompress(*memKTX);
+        if (!ktxStorage) {
+            handleError("Could not supercompress " + _textureURL.toString());
+            return;
+        }
+    }
+
+    const char* data = reinterpret_cast<const char*>(ktxStorage->data());
+    const size_t length = ktxStorage->size();
 
     // attempt to write the baked texture to the destination file path
     auto filePath = _outputDirectory.absoluteFilePath(_bakedTextureFileName);
@@ -151,6 +211,9 @@ void TextureBaker::processTexture() {
         handleError("Could not write baked texture for " + _textureURL.toString());
     } else {
         _outputFiles.push_back(filePath);
+        if (!cachedFilePath.isEmpty()) {
+            addToBakedTextureCache(cachedFilePath, data, (qint64)length);
+        }
     }
 
     qCDebug(model_baking) << "Baked texture" << _textureURL;
@@ -40,6 +40,17 @@ public:
 
     virtual void setWasAborted(bool wasAborted) override;
 
+    // Deflate the levels of baked textures (see ktx::HIFI_SUPERCOMPRESSION_KEY), only clients that know the
+    // format can load them
+    static void setSupercompressionEnabled(bool enabled) { _supercompressionEnabled = enabled; }
+    static bool isSupercompressionEnabled() { return _supercompressionEnabled; }
+
+    // Baked textures are looked up in and added to this directory by the hash of their original content, so a
+    // texture shared by several bakes is only compressed once. Set it before any bake starts, empty disables it.
+    static void setBakedTextureCacheDirectory(const QString& path) { _bakedTextureCacheDirectory = path; }
+    static QString getBakedTextureCacheDirectory() { return _bakedTextureCacheDirectory; }
+    static QString getBakedTextureCacheFileName(const QByteArray& originalTexture, image::TextureUsage::Type textureType);
+
 public slots:
     virtual void bake() override;
     virtual void abort() override; 
@@ -53,6 +64,8 @@ private slots:
 private:
     void loadTexture();
     void handleTextureNetworkReply();
+    bool copyFromBakedTextureCache(const QString& cachedFilePath);
+    void addToBakedTextureCache(const QString& cachedFilePath, const char* data, qint64 length);
 
     QUrl _textureURL;
     QByteArray _originalTexture;
@@ -62,6 +75,9 @@ private:
     QString _bakedTextureFileName;
 
     std::atomic<bool> _abortProcessing { false };
+
+    static std::atomic<bool> _supercompressionEnabled;
+    static QString _bakedTextureCacheDirectory;
 };
 
 #endif // hifi_TextureBaker_h
@@ -1332,7 +1332,12 @@ void ModelEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& sce
         });
         connect(model.get(), &Model::requestRenderUpdate, this, &ModelEntityRenderer::requestRenderUpdate);
         connect(entity.get(), &RenderableModelEntityItem::requestCollisionGeometryUpdate, this, &ModelEntityRenderer::flagForCollisionGeometryUpdate);
-        model->setLoadingPriority(EntityTreeRenderer::getEntityLoadingPriority(*entity));
+        // reevaluated whenever the download queue is sorted, so what we walk up to loads first
+        std::weak_ptr<EntityItem> weakEntity = entity;
+        model->setLoadingPriorityOperator([weakEntity] {
+            auto lockedEntity = weakEntity.lock();
+            return lockedEntity ? EntityTreeRenderer::getEntityLoadingPriority(*lockedEntity) : 0.0f;
+        });
         entity->setModel(model);
         withWriteLock([&] { _model = model; });
     }
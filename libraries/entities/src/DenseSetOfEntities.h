@@ -0,0 +1,80 @@
+//
+//  DenseSetOfEntities.h
+//  libraries/entities/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DenseSetOfEntities_h
+#define hifi_DenseSetOfEntities_h
+
+#include <unordered_map>
+#include <vector>
+
+#include "EntityTypes.h"
+
+// DenseSetOfEntities is a set of entities stored contiguously so the simulation can walk it every tick
+// without chasing hash buckets.  Membership is tracked in a side index so insert and remove stay O(1);
+// removal swaps the last member into the hole, so iteration order is not stable across removes.
+class DenseSetOfEntities {
+public:
+    using const_iterator = std::vector<EntityItemPointer>::const_iterator;
+
+    // returns true if entity was not already a member
+    bool insert(const EntityItemPointer& entity) {
+        auto result = _indices.emplace(entity.get(), (int)_entities.size());
+        if (result.second) {
+            _entities.push_back(entity);
+        }
+        return result.second;
+    }
+
+    // returns true if entity was a member
+    bool remove(const EntityItemPointer& entity) {
+        auto itr = _indices.find(entity.get());
+        if (itr == _indices.end()) {
+            return false;
+        }
+        int index = itr->second;
+        _indices.erase(itr);
+        removeSlot(index);
+        return true;
+    }
+
+    // removes the member at index, the former last member takes its place
+    void removeAt(int index) {
+        _indices.erase(_entities[index].get());
+        removeSlot(index);
+    }
+
+    bool contains(const EntityItemPointer& entity) const { return _indices.find(entity.get()) != _indices.end(); }
+    const EntityItemPointer& at(int index) const { return _entities[index]; }
+    int size() const { return (int)_entities.size(); }
+    bool empty() const { return _entities.empty(); }
+
+    void clear() {
+        _entities.clear();
+        _indices.clear();
+    }
+
+    const_iterator begin() const { return _entities.begin(); }
+    const_iterator end() const { return _entities.end(); }
+
+private:
+    void removeSlot(int index) {
+        int lastIndex = (int)_entities.size() - 1;
+        if (index != lastIndex) {
+            _entities[index] = std::move(_entities[lastIndex]);
+            _indices[_entities[index].get()] = index;
+        }
+        _entities.pop_back();
+    }
+
+    std::vector<EntityItemPointer> _entities;
+    std::unordered_map<EntityItem*, int> _indices;
+};
+
+#endif // hifi_DenseSetOfEntities_h
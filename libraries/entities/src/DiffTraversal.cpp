@@ -11,9 +11,60 @@
 
 #include "DiffTraversal.h"
 
+#include <NumericalConstants.h>
 #include <OctreeUtils.h>
 
 
+ViewFrustum::intersection DiffTraversal::View::computeElementVisibility(const AACube& cube) const {
+    if (visibility) {
+        ViewFrustum::intersection intersection;
+        if (visibility->find(cube, intersection)) {
+            visibilityCache->recordHit();
+        } else {
+            visibilityCache->recordMiss();
+            intersection = computeSharedVisibility(cube);
+            visibility->insert(cube, intersection);
+        }
+        if (intersection != ViewFrustum::INTERSECT) {
+            return intersection;
+        }
+        // the cube is near an edge for some view in the bucket, so this view needs its own answer
+    }
+    return computeExactVisibility(cube);
+}
+
+ViewFrustum::intersection DiffTraversal::View::computeExactVisibility(const AACube& cube) const {
+    // check for LOD truncation
+    float distance = glm::distance(viewFrustum.getPosition(), cube.calcCenter()) + MIN_VISIBLE_DISTANCE;
+    float angularDiameter = cube.getScale() / distance;
+    if (angularDiameter > MIN_ELEMENT_ANGULAR_DIAMETER * lodScaleFactor) {
+        return viewFrustum.calculateCubeKeyholeIntersection(cube);
+    }
+    return ViewFrustum::OUTSIDE;
+}
+
+ViewFrustum::intersection DiffTraversal::View::computeSharedVisibility(const AACube& cube) const {
+    const ViewVisibilityCache::Tolerance& tolerance = visibilityTolerance;
+    float distance = glm::distance(viewFrustum.getPosition(), cube.calcCenter());
+
+    // LOD truncation, for the nearest and farthest view positions and LOD scales of the bucket
+    float minAngularDiameter = MIN_ELEMENT_ANGULAR_DIAMETER * lodScaleFactor;
+    float nearestDistance = glm::max(distance - tolerance.position, 0.0f) + MIN_VISIBLE_DISTANCE;
+    if (cube.getScale() / nearestDistance <= minAngularDiameter * (1.0f - tolerance.lodScale)) {
+        return ViewFrustum::OUTSIDE;
+    }
+    float farthestDistance = distance + tolerance.position + MIN_VISIBLE_DISTANCE;
+    if (cube.getScale() / farthestDistance <= minAngularDiameter * (1.0f + tolerance.lodScale)) {
+        return ViewFrustum::INTERSECT;
+    }
+
+    // every view of the bucket sees the cube somewhere inside this one, relative to this view
+    float reach = distance + 0.5f * SQUARE_ROOT_OF_3 * cube.getScale() + tolerance.position;
+    float margin = tolerance.position + tolerance.slope * reach;
+    AACube inflatedCube(cube.getCorner() - glm::vec3(margin), cube.getScale() + 2.0f * margin);
+    return viewFrustum.calculateCubeKeyholeIntersection(inflatedCube);
+}
+
 DiffTraversal::Waypoint::Waypoint(EntityTreeElementPointer& element) : _nextIndex(0) {
     assert(element);
     _weakElement = element;
@@ -41,14 +92,9 @@ void DiffTraversal::Waypoint::getNextVisibleElementFirstTime(DiffTraversal::Visi
                         // No LOD truncation if we aren't using the view frustum
                         next.element = nextElement;
                         return;
-                    } else if (view.viewFrustum.cubeIntersectsKeyhole(nextElement->getAACube())) {
-                        // check for LOD truncation
-                        float distance = glm::distance(view.viewFrustum.getPosition(), nextElement->getAACube().calcCenter()) + MIN_VISIBLE_DISTANCE;
-                        float angularDiameter = nextElement->getAACube().getScale() / distance;
-                        if (angularDiameter > MIN_ELEMENT_ANGULAR_DIAMETER * view.lodScaleFactor) {
-                            next.element = nextElement;
-                            return;
-                        }
+                    } else if (view.computeElementVisibility(nextElement->getAACube()) != ViewFrustum::OUTSIDE) {
+                        next.element = nextElement;
+                        return;
                     }
                 }
             }
@@ -82,16 +128,11 @@ void DiffTraversal::Waypoint::getNextVisibleElementRepeat(
                         next.intersection = ViewFrustum::INSIDE;
                         return;
                     } else {
-                        // check for LOD truncation
-                        float distance = glm::distance(view.viewFrustum.getPosition(), nextElement->getAACube().calcCenter()) + MIN_VISIBLE_DISTANCE;
-                        float angularDiameter = nextElement->getAACube().getScale() / distance;
-                        if (angularDiameter > MIN_ELEMENT_ANGULAR_DIAMETER * view.lodScaleFactor) {
-                            ViewFrustum::intersection intersection = view.viewFrustum.calculateCubeKeyholeIntersection(nextElement->getAACube());
-                            if (intersection != ViewFrustum::OUTSIDE) {
-                                next.element = nextElement;
-                                next.intersection = intersection;
-                                return;
-                            }
+                        ViewFrustum::intersection intersection = view.computeElementVisibility(nextElement->getAACube());
+                        if (intersection != ViewFrustum::OUTSIDE) {
+                            next.element = nextElement;
+                            next.intersection = intersection;
+                            return;
                         }
                     }
                 }
@@ -118,16 +159,10 @@ void DiffTraversal::Waypoint::getNextVisibleElementDifferential(DiffTraversal::V
                 EntityTreeElementPointer nextElement = element->getChildAtIndex(_nextIndex);
                 ++_nextIndex;
                 if (nextElement) {
-                    AACube cube = nextElement->getAACube();
-                    // check for LOD truncation
-                    float distance = glm::distance(view.viewFrustum.getPosition(), cube.calcCenter()) + MIN_VISIBLE_DISTANCE;
-                    float angularDiameter = cube.getScale() / distance;
-                    if (angularDiameter > MIN_ELEMENT_ANGULAR_DIAMETER * view.lodScaleFactor) {
-                        if (view.viewFrustum.calculateCubeKeyholeIntersection(cube) != ViewFrustum::OUTSIDE) {
-                            next.element = nextElement;
-                            next.intersection = ViewFrustum::OUTSIDE;
-                            return;
-                        }
+                    if (view.computeElementVisibility(nextElement->getAACube()) != ViewFrustum::OUTSIDE) {
+                        next.element = nextElement;
+                        next.intersection = ViewFrustum::OUTSIDE;
+                        return;
                     }
                 }
             }
@@ -187,6 +222,17 @@ DiffTraversal::Type DiffTraversal::prepareNewTraversal(const ViewFrustum& viewFr
         };
     }
 
+    // views that quantize to the same key share their element classifications through the cache
+    if (_visibilityCache && _currentView.usesViewFrustum) {
+        _currentView.visibilityCache = _visibilityCache;
+        _currentView.visibility = _visibilityCache->getEntry(
+            _visibilityCache->computeKey(_currentView.viewFrustum, _currentView.lodScaleFactor));
+        _currentView.visibilityTolerance = _visibilityCache->computeTolerance(_currentView.viewFrustum);
+    } else {
+        _currentView.visibilityCache.reset();
+        _currentView.visibility.reset();
+    }
+
     _path.clear();
     _path.push_back(DiffTraversal::Waypoint(root));
     // set root fork's index such that root element returned at getNextElement()
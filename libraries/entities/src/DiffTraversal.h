@@ -15,6 +15,7 @@
 #include <ViewFrustum.h>
 
 #include "EntityTreeElement.h"
+#include "ViewVisibilityCache.h"
 
 // DiffTraversal traverses the tree and applies _scanElementCallback on elements it finds
 class DiffTraversal {
@@ -30,10 +31,21 @@ public:
     // View is a struct with a ViewFrustum and LOD parameters
     class View {
     public:
+        // returns OUTSIDE when the cube is culled by LOD or out of view, else its keyhole intersection
+        ViewFrustum::intersection computeElementVisibility(const AACube& cube) const;
+        ViewFrustum::intersection computeExactVisibility(const AACube& cube) const;
+        // INSIDE or OUTSIDE when that holds for every view in the bucket of visibility, else INTERSECT
+        ViewFrustum::intersection computeSharedVisibility(const AACube& cube) const;
+
         ViewFrustum viewFrustum;
         uint64_t startTime { 0 };
         float lodScaleFactor { 1.0f };
         bool usesViewFrustum { true };
+
+        // shared classification results for all views that quantize like this one (may be null)
+        ViewVisibilityCachePointer visibilityCache;
+        ViewVisibilityCache::EntryPointer visibility;
+        ViewVisibilityCache::Tolerance visibilityTolerance;
     };
 
     // Waypoint is an bookmark in a "path" of waypoints during a traversal.
@@ -71,6 +83,7 @@ public:
     bool finished() const { return _path.empty(); }
 
     void setScanCallback(std::function<void (VisibleElement&)> cb);
+    void setVisibilityCache(const ViewVisibilityCachePointer& cache) { _visibilityCache = cache; }
     void traverse(uint64_t timeBudget);
 
     void reset() { _path.clear(); _completedView.startTime = 0; } // resets our state to force a new "First" traversal
@@ -81,6 +94,7 @@ private:
     View _currentView;
     View _completedView;
     std::vector<Waypoint> _path;
+    ViewVisibilityCachePointer _visibilityCache;
     std::function<void (VisibleElement&)> _getNextVisibleElementCallback { nullptr };
     std::function<void (VisibleElement&)> _scanElementCallback { [](VisibleElement& e){} };
 };
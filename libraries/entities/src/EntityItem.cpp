@@ -990,62 +990,7 @@ void EntityItem::setCollisionSoundURL(const QString& value) {
     }
 }
 
-void EntityItem::simulate(const quint64& now) {
-    DETAILED_PROFILE_RANGE(simulation_physics, "Simulate");
-    if (getLastSimulated() == 0) {
-        setLastSimulated(now);
-    }
-
-    float timeElapsed = (float)(now - getLastSimulated()) / (float)(USECS_PER_SECOND);
-
-    #ifdef WANT_DEBUG
-        qCDebug(entities) << "********** EntityItem::simulate()";
-        qCDebug(entities) << "    entity ID=" << getEntityItemID();
-        qCDebug(entities) << "    simulator ID=" << getSimulatorID();
-        qCDebug(entities) << "    now=" << now;
-        qCDebug(entities) << "    _lastSimulated=" << _lastSimulated;
-        qCDebug(entities) << "    timeElapsed=" << timeElapsed;
-        qCDebug(entities) << "    hasVelocity=" << hasVelocity();
-        qCDebug(entities) << "    hasGravity=" << hasGravity();
-        qCDebug(entities) << "    hasAcceleration=" << hasAcceleration();
-        qCDebug(entities) << "    hasAngularVelocity=" << hasAngularVelocity();
-        qCDebug(entities) << "    getAngularVelocity=" << getAngularVelocity();
-        qCDebug(entities) << "    isMortal=" << isMortal();
-        qCDebug(entities) << "    getAge()=" << getAge();
-        qCDebug(entities) << "    getLifetime()=" << getLifetime();
-
-
-        if (hasVelocity() || hasGravity()) {
-            qCDebug(entities) << "    MOVING...=";
-            qCDebug(entities) << "        hasVelocity=" << hasVelocity();
-            qCDebug(entities) << "        hasGravity=" << hasGravity();
-            qCDebug(entities) << "        hasAcceleration=" << hasAcceleration();
-            qCDebug(entities) << "        hasAngularVelocity=" << hasAngularVelocity();
-            qCDebug(entities) << "        getAngularVelocity=" << getAngularVelocity();
-        }
-        if (hasAngularVelocity()) {
-            qCDebug(entities) << "    CHANGING...=";
-            qCDebug(entities) << "        hasAngularVelocity=" << hasAngularVelocity();
-            qCDebug(entities) << "        getAngularVelocity=" << getAngularVelocity();
-        }
-        if (isMortal()) {
-            qCDebug(entities) << "    MORTAL...=";
-            qCDebug(entities) << "        isMortal=" << isMortal();
-            qCDebug(entities) << "        getAge()=" << getAge();
-            qCDebug(entities) << "        getLifetime()=" << getLifetime();
-        }
-        qCDebug(entities) << "     ********** EntityItem::simulate() .... SETTING _lastSimulated=" << _lastSimulated;
-    #endif
-
-    if (!stepKinematicMotion(timeElapsed)) {
-        // this entity is no longer moving
-        // flag it to transition from KINEMATIC to STATIC
-        markDirtyFlags(Simulation::DIRTY_MOTION_TYPE);
-        setAcceleration(Vectors::ZERO);
-    }
-    setLastSimulated(now);
-}
-
+// NOTE: KinematicBatch performs the same integration for many entities at once, keep the two in sync
 bool EntityItem::stepKinematicMotion(float timeElapsed) {
     DETAILED_PROFILE_RANGE(simulation_physics, "StepKinematicMotion");
     // get all the data
@@ -2362,9 +2307,12 @@ QList<EntityDynamicPointer> EntityItem::getActionsOfType(EntityDynamicType typeT
 
 void EntityItem::locationChanged(bool tellPhysics) {
     requiresRecalcBoxes();
+    EntityTreePointer tree = getTree();
+    if (tree) {
+        tree->entityBoundsChanged(this);
+    }
     if (tellPhysics) {
         _flags |= Simulation::DIRTY_TRANSFORM;
-        EntityTreePointer tree = getTree();
         if (tree) {
             tree->entityChanged(getThisPointer());
         }
@@ -2375,6 +2323,10 @@ void EntityItem::locationChanged(bool tellPhysics) {
 
 void EntityItem::dimensionsChanged() {
     requiresRecalcBoxes();
+    EntityTreePointer tree = getTree();
+    if (tree) {
+        tree->entityBoundsChanged(this);
+    }
     SpatiallyNestable::dimensionsChanged(); // Do what you have to do
     somethingChangedNotification();
 }
@@ -152,8 +152,7 @@ public:
     virtual void update(const quint64& now);
     quint64 getLastUpdated() const;
 
-    // perform linear extrapolation for SimpleEntitySimulation
-    void simulate(const quint64& now);
+    // SimpleEntitySimulation steps its kinematic entities together with a KinematicBatch
     bool stepKinematicMotion(float timeElapsed); // return 'true' if moving
 
     virtual bool needsToCallUpdate() const { return false; }
@@ -513,7 +512,7 @@ protected:
 
     glm::vec3 _unscaledDimensions { ENTITY_ITEM_DEFAULT_DIMENSIONS };
     EntityTypes::EntityType _type { EntityTypes::Unknown };
-    quint64 _lastSimulated { 0 }; // last time this entity called simulate(), this includes velocity, angular velocity,
+    quint64 _lastSimulated { 0 }; // last time this entity's motion was stepped, this includes velocity, angular velocity,
                             // and physics changes
     quint64 _lastUpdated { 0 }; // last time this entity called update(), this includes animations and non-physics changes
     quint64 _lastEdited { 0 }; // last official local or remote edit time
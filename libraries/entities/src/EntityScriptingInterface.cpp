@@ -20,6 +20,7 @@
 #include <shared/QtHelpers.h>
 #include <VariantMapToScriptValue.h>
 #include <SharedUtil.h>
+#include <TBBHelpers.h>
 #include <SpatialParentFinder.h>
 #include <AvatarHashMap.h>
 
@@ -812,6 +813,87 @@ RayToEntityIntersectionResult EntityScriptingInterface::findRayIntersectionWorke
     return result;
 }
 
+// batches smaller than this are answered on the calling thread, larger ones are spread over the TBB pool
+const int MIN_PARALLEL_BATCH_SIZE = 16;
+
+// NOTE: the queries run while the caller holds the entity tree's read lock, so they must not take it again
+template <typename F>
+static void forEachBatchedQuery(int numQueries, F query) {
+    if (numQueries < MIN_PARALLEL_BATCH_SIZE) {
+        for (int i = 0; i < numQueries; ++i) {
+            query(i);
+        }
+        return;
+    }
+    tbb::parallel_for(tbb::blocked_range<int>(0, numQueries), [&](const tbb::blocked_range<int>& range) {
+        for (int i = range.begin(); i != range.end(); ++i) {
+            query(i);
+        }
+    });
+}
+
+QVector<RayToEntityIntersectionResult> EntityScriptingInterface::findRayIntersections(const QVector<PickRay>& rays,
+        bool precisionPicking, const QScriptValue& entityIdsToInclude, const QScriptValue& entityIdsToDiscard,
+        bool visibleOnly, bool collidableOnly) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    QVector<EntityItemID> entitiesToInclude = qVectorEntityItemIDFromScriptValue(entityIdsToInclude);
+    QVector<EntityItemID> entitiesToDiscard = qVectorEntityItemIDFromScriptValue(entityIdsToDiscard);
+
+    QVector<RayToEntityIntersectionResult> results(rays.size());
+    if (_entityTree) {
+        RayToEntityIntersectionResult* resultData = results.data();
+        _entityTree->withReadLock([&] {
+            forEachBatchedQuery(rays.size(), [&](int i) {
+                resultData[i] = findRayIntersectionWorker(rays[i], Octree::NoLock, precisionPicking,
+                    entitiesToInclude, entitiesToDiscard, visibleOnly, collidableOnly);
+            });
+        });
+    }
+    return results;
+}
+
+QVector<QVector<QUuid>> EntityScriptingInterface::findEntitiesInSpheres(const QVector<glm::vec3>& centers,
+        const QVector<float>& radii) const {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    QVector<QVector<QUuid>> results(std::min(centers.size(), radii.size()));
+    if (_entityTree) {
+        QVector<QUuid>* resultData = results.data();
+        _entityTree->withReadLock([&] {
+            forEachBatchedQuery(results.size(), [&](int i) {
+                QVector<EntityItemPointer> entities;
+                _entityTree->findEntities(centers[i], radii[i], entities);
+                foreach (EntityItemPointer entity, entities) {
+                    resultData[i] << entity->getEntityItemID();
+                }
+            });
+        });
+    }
+    return results;
+}
+
+QVector<QVector<QUuid>> EntityScriptingInterface::findEntitiesInBoxes(const QVector<glm::vec3>& corners,
+        const QVector<glm::vec3>& dimensions) const {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    QVector<QVector<QUuid>> results(std::min(corners.size(), dimensions.size()));
+    if (_entityTree) {
+        QVector<QUuid>* resultData = results.data();
+        _entityTree->withReadLock([&] {
+            forEachBatchedQuery(results.size(), [&](int i) {
+                QVector<EntityItemPointer> entities;
+                AABox box(corners[i], dimensions[i]);
+                _entityTree->findEntities(box, entities);
+                foreach (EntityItemPointer entity, entities) {
+                    resultData[i] << entity->getEntityItemID();
+                }
+            });
+        });
+    }
+    return results;
+}
+
 bool EntityScriptingInterface::reloadServerScripts(QUuid entityID) {
     auto client = DependencyManager::get<EntityScriptClient>();
     return client->reloadServerScript(entityID);
@@ -83,6 +83,7 @@ public:
 };
 
 Q_DECLARE_METATYPE(RayToEntityIntersectionResult)
+Q_DECLARE_METATYPE(QVector<RayToEntityIntersectionResult>)
 
 QScriptValue RayToEntityIntersectionResultToScriptValue(QScriptEngine* engine, const RayToEntityIntersectionResult& results);
 void RayToEntityIntersectionResultFromScriptValue(const QScriptValue& object, RayToEntityIntersectionResult& results);
@@ -446,6 +447,65 @@ public slots:
     Q_INVOKABLE RayToEntityIntersectionResult findRayIntersectionBlocking(const PickRay& ray, bool precisionPicking = false, 
         const QScriptValue& entityIdsToInclude = QScriptValue(), const QScriptValue& entityIdsToDiscard = QScriptValue());
 
+    /**jsdoc
+     * Find the first entity intersected by each of an array of {@link PickRay}s. This gives the same results as calling 
+     * {@link Entities.findRayIntersection|findRayIntersection} once per ray but takes the entity tree lock once for the whole 
+     * batch and, for larger batches, evaluates the rays in parallel.
+     * @function Entities.findRayIntersections
+     * @param {PickRay[]} pickRays - The PickRays to use for finding entities.
+     * @param {boolean} [precisionPicking=false] - If <code>true</code> and an intersected entity is a <code>Model</code> 
+     *     entity, its result's <code>extraInfo</code> property includes more information than it otherwise would.
+     * @param {Uuid[]} [entitiesToInclude=[]] - If not empty then the search is restricted to these entities.
+     * @param {Uuid[]} [entitiesToDiscard=[]] - Entities to ignore during the search.
+     * @param {boolean} [visibleOnly=false] - If <code>true</code> then only entities that are 
+     *     <code>{@link Entities.EntityProperties|visible}<code> are searched.
+     * @param {boolean} [collideableOnly=false] - If <code>true</code> then only entities that are not 
+     *     <code>{@link Entities.EntityProperties|collisionless}</code> are searched.
+     * @returns {Entities.RayToEntityIntersectionResult[]} The result of the search for each PickRay, in the same order as 
+     *     <code>pickRays</code>.
+     * @example <caption>Find the entities below a row of points in front of your avatar.</caption>
+     * var pickRays = [];
+     * for (var i = 0; i < 10; i++) {
+     *     pickRays.push({
+     *         origin: Vec3.sum(MyAvatar.position, Vec3.multiply(i, Quat.getFront(MyAvatar.orientation))),
+     *         direction: Vec3.UNIT_NEG_Y
+     *     });
+     * }
+     * var intersections = Entities.findRayIntersections(pickRays);
+     * print("First entity below the row: " + intersections[0].entityID);
+     */
+    Q_INVOKABLE QVector<RayToEntityIntersectionResult> findRayIntersections(const QVector<PickRay>& rays,
+        bool precisionPicking = false, const QScriptValue& entityIdsToInclude = QScriptValue(),
+        const QScriptValue& entityIdsToDiscard = QScriptValue(), bool visibleOnly = false, bool collidableOnly = false);
+
+    /**jsdoc
+     * Find all entities that intersect each of an array of spheres. This gives the same results as calling 
+     * {@link Entities.findEntities|findEntities} once per sphere but takes the entity tree lock once for the whole batch 
+     * and, for larger batches, evaluates the spheres in parallel.
+     * @function Entities.findEntitiesInSpheres
+     * @param {Vec3[]} centers - The centers of the search spheres.
+     * @param {number[]} radii - The radii of the search spheres, one per center.
+     * @returns {Uuid[][]} An array of entity IDs for each search sphere, in the same order as <code>centers</code>. If 
+     *     <code>radii</code> has fewer values than <code>centers</code> the extra centers are not searched.
+     */
+    /// this function will not find any models in script engine contexts which don't have access to models
+    Q_INVOKABLE QVector<QVector<QUuid>> findEntitiesInSpheres(const QVector<glm::vec3>& centers,
+        const QVector<float>& radii) const;
+
+    /**jsdoc
+     * Find all entities whose axis-aligned boxes intersect each of an array of search axis-aligned boxes. This gives the same 
+     * results as calling {@link Entities.findEntitiesInBox|findEntitiesInBox} once per box but takes the entity tree lock 
+     * once for the whole batch and, for larger batches, evaluates the boxes in parallel.
+     * @function Entities.findEntitiesInBoxes
+     * @param {Vec3[]} corners - The corners of the search AA boxes with minimum co-ordinate values.
+     * @param {Vec3[]} dimensions - The dimensions of the search AA boxes, one per corner.
+     * @returns {Uuid[][]} An array of entity IDs for each search box, in the same order as <code>corners</code>. If 
+     *     <code>dimensions</code> has fewer values than <code>corners</code> the extra corners are not searched.
+     */
+    /// this function will not find any models in script engine contexts which don't have access to models
+    Q_INVOKABLE QVector<QVector<QUuid>> findEntitiesInBoxes(const QVector<glm::vec3>& corners,
+        const QVector<glm::vec3>& dimensions) const;
+
 
     /**jsdoc
      * Reloads an entity's server entity script such that the latest version re-downloaded.
@@ -20,7 +20,6 @@
 void EntitySimulation::setEntityTree(EntityTreePointer tree) {
     if (_entityTree && _entityTree != tree) {
         _mortalEntities.clear();
-        _nextExpiry = std::numeric_limits<uint64_t>::max();
         _entitiesToUpdate.clear();
         _entitiesToSort.clear();
         _simpleKinematicEntities.clear();
@@ -71,29 +70,19 @@ void EntitySimulation::prepareEntityForDelete(EntityItemPointer entity) {
 
 // protected
 void EntitySimulation::expireMortalEntities(uint64_t now) {
-    if (now > _nextExpiry) {
-        PROFILE_RANGE_EX(simulation_physics, "ExpireMortals", 0xffff00ff, (uint64_t)_mortalEntities.size());
-        // only search for expired entities if we expect to find one
-        _nextExpiry = std::numeric_limits<uint64_t>::max();
-        QMutexLocker lock(&_mutex);
-        SetOfEntities::iterator itemItr = _mortalEntities.begin();
-        while (itemItr != _mortalEntities.end()) {
-            EntityItemPointer entity = *itemItr;
-            uint64_t expiry = entity->getExpiry();
-            if (expiry < now) {
-                itemItr = _mortalEntities.erase(itemItr);
-                entity->die();
-                prepareEntityForDelete(entity);
-            } else {
-                if (expiry < _nextExpiry) {
-                    // remember the smallest _nextExpiry so we know when to start the next search
-                    _nextExpiry = expiry;
-                }
-                ++itemItr;
-            }
-        }
-        if (_mortalEntities.size() < 1) {
-            _nextExpiry = -1;
+    PROFILE_RANGE_EX(simulation_physics, "ExpireMortals", 0xffff00ff, (uint64_t)_mortalEntities.size());
+    QMutexLocker lock(&_mutex);
+    // the wheel only visits the slots that have elapsed since the last tick
+    VectorOfEntities expired;
+    _mortalEntities.takeExpired(now, expired);
+    for (auto& entity : expired) {
+        uint64_t expiry = entity->getExpiry();
+        if (expiry < now) {
+            entity->die();
+            prepareEntityForDelete(entity);
+        } else {
+            // the expiry was pushed back without a DIRTY_LIFETIME change
+            _mortalEntities.insert(entity, expiry);
         }
     }
 }
@@ -102,16 +91,17 @@ void EntitySimulation::expireMortalEntities(uint64_t now) {
 void EntitySimulation::callUpdateOnEntitiesThatNeedIt(uint64_t now) {
     PerformanceTimer perfTimer("updatingEntities");
     QMutexLocker lock(&_mutex);
-    SetOfEntities::iterator itemItr = _entitiesToUpdate.begin();
-    while (itemItr != _entitiesToUpdate.end()) {
-        EntityItemPointer entity = *itemItr;
+    int i = 0;
+    while (i < _entitiesToUpdate.size()) {
+        // copy the pointer: update() may change the entity in ways that come back through changeEntity()
+        EntityItemPointer entity = _entitiesToUpdate.at(i);
         // TODO: catch transition from needing update to not as a "change"
         // so we don't have to scan for it here.
         if (!entity->needsToCallUpdate()) {
-            itemItr = _entitiesToUpdate.erase(itemItr);
+            _entitiesToUpdate.removeAt(i);
         } else {
             entity->update(now);
-            ++itemItr;
+            ++i;
         }
     }
 }
@@ -123,22 +113,23 @@ void EntitySimulation::sortEntitiesThatMoved() {
     // External changes to entity position/shape are expected to be sorted outside of the EntitySimulation.
     MovingEntitiesOperator moveOperator;
     AACube domainBounds(glm::vec3((float)-HALF_TREE_SCALE), (float)TREE_SCALE);
-    SetOfEntities::iterator itemItr = _entitiesToSort.begin();
-    while (itemItr != _entitiesToSort.end()) {
-        EntityItemPointer entity = *itemItr;
+    VectorOfEntities entitiesOutOfBounds;
+    for (auto& entity : _entitiesToSort) {
         // check to see if this movement has sent the entity outside of the domain.
         bool success;
         AACube newCube = entity->getQueryAACube(success);
         if (success && !domainBounds.touches(newCube)) {
             qCDebug(entities) << "Entity " << entity->getEntityItemID() << " moved out of domain bounds.";
-            itemItr = _entitiesToSort.erase(itemItr);
-            entity->die();
-            prepareEntityForDelete(entity);
+            entitiesOutOfBounds.push_back(entity);
         } else {
             moveOperator.addEntityToMoveList(entity, newCube);
-            ++itemItr;
         }
     }
+    // deleting removes the entity from _entitiesToSort so it is done after the walk
+    for (auto& entity : entitiesOutOfBounds) {
+        entity->die();
+        prepareEntityForDelete(entity);
+    }
     if (moveOperator.hasMovingEntities()) {
         PerformanceTimer perfTimer("recurseTreeWithOperator");
         _entityTree->recurseTreeWithOperator(&moveOperator);
@@ -152,11 +143,7 @@ void EntitySimulation::addEntity(EntityItemPointer entity) {
     assert(entity);
     entity->deserializeActions();
     if (entity->isMortal()) {
-        _mortalEntities.insert(entity);
-        uint64_t expiry = entity->getExpiry();
-        if (expiry < _nextExpiry) {
-            _nextExpiry = expiry;
-        }
+        _mortalEntities.insert(entity, entity->getExpiry());
     }
     if (entity->needsToCallUpdate()) {
         _entitiesToUpdate.insert(entity);
@@ -199,11 +186,7 @@ void EntitySimulation::changeEntity(EntityItemPointer entity) {
 
     if (dirtyFlags & Simulation::DIRTY_LIFETIME) {
         if (entity->isMortal()) {
-            _mortalEntities.insert(entity);
-            uint64_t expiry = entity->getExpiry();
-            if (expiry < _nextExpiry) {
-                _nextExpiry = expiry;
-            }
+            _mortalEntities.insert(entity, entity->getExpiry());
         } else {
             _mortalEntities.remove(entity);
         }
@@ -220,7 +203,6 @@ void EntitySimulation::changeEntity(EntityItemPointer entity) {
 void EntitySimulation::clearEntities() {
     QMutexLocker lock(&_mutex);
     _mortalEntities.clear();
-    _nextExpiry = std::numeric_limits<uint64_t>::max();
     _entitiesToUpdate.clear();
     _entitiesToSort.clear();
     _simpleKinematicEntities.clear();
@@ -233,9 +215,10 @@ void EntitySimulation::clearEntities() {
 
 void EntitySimulation::moveSimpleKinematics(uint64_t now) {
     PROFILE_RANGE_EX(simulation_physics, "MoveSimples", 0xffff00ff, (uint64_t)_simpleKinematicEntities.size());
-    SetOfEntities::iterator itemItr = _simpleKinematicEntities.begin();
-    while (itemItr != _simpleKinematicEntities.end()) {
-        EntityItemPointer entity = *itemItr;
+    _kinematicBatch.reserve(_simpleKinematicEntities.size());
+    int i = 0;
+    while (i < _simpleKinematicEntities.size()) {
+        const EntityItemPointer& entity = _simpleKinematicEntities.at(i);
 
         // The entity-server doesn't know where avatars are, so don't attempt to do simple extrapolation for
         // children of avatars.  See related code in EntityMotionState::remoteSimulationOutOfSync.
@@ -244,14 +227,20 @@ void EntitySimulation::moveSimpleKinematics(uint64_t now) {
         bool hasAvatarAncestor = entity->hasAncestorOfType(NestableType::Avatar);
 
         if (entity->isMovingRelativeToParent() && !entity->getPhysicsInfo() && ancestryIsKnown && !hasAvatarAncestor) {
-            entity->simulate(now);
+            _kinematicBatch.add(entity, now);
             _entitiesToSort.insert(entity);
-            ++itemItr;
+            ++i;
         } else {
             // the entity is no longer non-physical-kinematic
-            itemItr = _simpleKinematicEntities.erase(itemItr);
+            _simpleKinematicEntities.removeAt(i);
         }
     }
+
+    // step all of them together, equivalent to EntityItem::stepKinematicMotion() on each
+    _kinematicBatch.integrate();
+    _kinematicBatch.apply(now);
+    // keep the capacity but don't hold on to the entities until the next tick
+    _kinematicBatch.clear();
 }
 
 void EntitySimulation::addDynamic(EntityDynamicPointer dynamic) {
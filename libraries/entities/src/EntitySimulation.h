@@ -20,9 +20,12 @@
 
 #include <PerfStat.h>
 
+#include "DenseSetOfEntities.h"
 #include "EntityDynamicInterface.h"
 #include "EntityItem.h"
 #include "EntityTree.h"
+#include "KinematicBatch.h"
+#include "MortalEntityWheel.h"
 
 using EntitySimulationPointer = std::shared_ptr<EntitySimulation>;
 using SetOfEntities = QSet<EntityItemPointer>;
@@ -46,7 +49,7 @@ const int DIRTY_SIMULATION_FLAGS =
 
 class EntitySimulation : public QObject, public std::enable_shared_from_this<EntitySimulation> {
 public:
-    EntitySimulation() : _mutex(QMutex::Recursive), _entityTree(NULL), _nextExpiry(std::numeric_limits<uint64_t>::max()) { }
+    EntitySimulation() : _mutex(QMutex::Recursive), _entityTree(NULL) { }
     virtual ~EntitySimulation() { setEntityTree(NULL); }
 
     inline EntitySimulationPointer getThisPointer() const {
@@ -97,8 +100,8 @@ protected:
 
     QMutex _mutex{ QMutex::Recursive };
 
-    SetOfEntities _entitiesToSort; // entities moved by simulation (and might need resort in EntityTree)
-    SetOfEntities _simpleKinematicEntities; // entities undergoing non-colliding kinematic motion
+    DenseSetOfEntities _entitiesToSort; // entities moved by simulation (and might need resort in EntityTree)
+    DenseSetOfEntities _simpleKinematicEntities; // entities undergoing non-colliding kinematic motion
     QList<EntityDynamicPointer> _dynamicsToAdd;
     QSet<QUuid> _dynamicsToRemove;
     QMutex _dynamicsMutex { QMutex::Recursive };
@@ -115,11 +118,11 @@ private:
     // We maintain multiple lists, each for its distinct purpose.
     // An entity may be in more than one list.
     SetOfEntities _allEntities; // tracks all entities added the simulation
-    SetOfEntities _mortalEntities; // entities that have an expiry
-    uint64_t _nextExpiry;
+    MortalEntityWheel _mortalEntities; // entities that have an expiry
 
+    DenseSetOfEntities _entitiesToUpdate; // entities that need to call EntityItem::update()
 
-    SetOfEntities _entitiesToUpdate; // entities that need to call EntityItem::update()
+    KinematicBatch _kinematicBatch; // reused by moveSimpleKinematics() to avoid reallocating every tick
 };
 
 #endif // hifi_EntitySimulation_h
@@ -99,6 +99,9 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
     }
     QHash<EntityItemID, EntityItemPointer> localMap;
     localMap.swap(_entityMap);
+    if (_bvh) {
+        _bvh->clear();
+    }
     this->withWriteLock([&] {
         foreach(EntityItemPointer entity, localMap) {
             EntityTreeElementPointer element = entity->getElement();
@@ -289,7 +292,7 @@ bool EntityTree::updateEntity(const EntityItemID& entityID, const EntityItemProp
 }
 
 bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperties& origProperties,
-        const SharedNodePointer& senderNode) {
+        const SharedNodePointer& senderNode, bool* wasSquashed) {
     EntityTreeElementPointer containingElement = entity->getElement();
     if (!containingElement) {
         return false;
@@ -316,6 +319,9 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
     // enforce support for locked entities. If an entity is currently locked, then the only
     // property we allow you to change is the locked property.
     if (entity->getLocked()) {
+        if (wasSquashed) {
+            *wasSquashed = true;
+        }
         if (properties.lockedChanged()) {
             bool wantsLocked = properties.getLocked();
             if (!wantsLocked) {
@@ -393,6 +399,9 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
                 properties.setAccelerationChanged(false);
                 properties.setParentIDChanged(false);
                 properties.setParentJointIndexChanged(false);
+                if (wasSquashed) {
+                    *wasSquashed = true;
+                }
 
                 if (wantTerseEditLogging()) {
                     qCDebug(entities) << (senderNode ? senderNode->getUUID() : "null") << "physical edits suppressed";
@@ -772,10 +781,25 @@ EntityItemID EntityTree::findRayIntersection(const glm::vec3& origin, const glm:
             element, distance, face, surfaceNormal, extraInfo, EntityItemID() };
     distance = FLT_MAX;
 
-    bool requireLock = lockType == Octree::Lock;
-    bool lockResult = withReadLock([&]{
+    auto findIntersection = [&]{
+        if (_bvh) {
+            EntityItemPointer entity = _bvh->findRayIntersection(origin, direction, entityIdsToInclude, entityIdsToDiscard,
+                visibleOnly, collidableOnly, precisionPicking, element, distance, face, surfaceNormal, extraInfo);
+            if (entity) {
+                args.entityID = entity->getEntityItemID();
+            }
+            return;
+        }
         recurseTreeWithOperation(findRayIntersectionOp, &args);
-    }, requireLock);
+    };
+
+    bool lockResult = true;
+    if (lockType == Octree::NoLock) {
+        findIntersection();
+    } else {
+        bool requireLock = lockType == Octree::Lock;
+        lockResult = withReadLock(findIntersection, requireLock);
+    }
 
     if (accurateResult) {
         *accurateResult = lockResult; // if user asked to accuracy or result, let them know this is accurate
@@ -786,6 +810,14 @@ EntityItemID EntityTree::findRayIntersection(const glm::vec3& origin, const glm:
 
 
 EntityItemPointer EntityTree::findClosestEntity(const glm::vec3& position, float targetRadius) {
+    if (_bvh) {
+        EntityItemPointer closestEntity;
+        withReadLock([&] {
+            closestEntity = _bvh->findClosestEntity(position, targetRadius);
+        });
+        return closestEntity;
+    }
+
     FindNearPointArgs args = { position, targetRadius, false, NULL, FLT_MAX };
     withReadLock([&] {
         // NOTE: This should use recursion, since this is a spatial operation
@@ -820,6 +852,10 @@ bool EntityTree::findInSphereOperation(const OctreeElementPointer& element, void
 
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const glm::vec3& center, float radius, QVector<EntityItemPointer>& foundEntities) {
+    if (_bvh) {
+        _bvh->findEntities(center, radius, foundEntities);
+        return;
+    }
     FindAllNearPointArgs args = { center, radius, QVector<EntityItemPointer>() };
     // NOTE: This should use recursion, since this is a spatial operation
     recurseTreeWithOperation(findInSphereOperation, &args);
@@ -850,6 +886,10 @@ bool EntityTree::findInCubeOperation(const OctreeElementPointer& element, void*
 
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const AACube& cube, QVector<EntityItemPointer>& foundEntities) {
+    if (_bvh) {
+        _bvh->findEntities(cube, foundEntities);
+        return;
+    }
     FindEntitiesInCubeArgs args(cube);
     // NOTE: This should use recursion, since this is a spatial operation
     recurseTreeWithOperation(findInCubeOperation, &args);
@@ -879,6 +919,10 @@ bool EntityTree::findInBoxOperation(const OctreeElementPointer& element, void* e
 
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const AABox& box, QVector<EntityItemPointer>& foundEntities) {
+    if (_bvh) {
+        _bvh->findEntities(box, foundEntities);
+        return;
+    }
     FindEntitiesInBoxArgs args(box);
     // NOTE: This should use recursion, since this is a spatial operation
     recurseTreeWithOperation(findInBoxOperation, &args);
@@ -904,6 +948,10 @@ bool EntityTree::findInFrustumOperation(const OctreeElementPointer& element, voi
 
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const ViewFrustum& frustum, QVector<EntityItemPointer>& foundEntities) {
+    if (_bvh) {
+        _bvh->findEntities(frustum, foundEntities);
+        return;
+    }
     FindInFrustumArgs args = { frustum, QVector<EntityItemPointer>() };
     // NOTE: This should use recursion, since this is a spatial operation
     recurseTreeWithOperation(findInFrustumOperation, &args);
@@ -1413,7 +1461,6 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
     }
 
     int processedBytes = 0;
-    bool isAdd = false;
     // we handle these types of "edit" packets
     switch (message.getType()) {
         case PacketType::EntityErase: {
@@ -1423,252 +1470,314 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
         }
 
         case PacketType::EntityAdd:
-            isAdd = true;  // fall through to next case
         case PacketType::EntityPhysics:
         case PacketType::EntityEdit: {
-            quint64 startDecode = 0, endDecode = 0;
-            quint64 startLookup = 0, endLookup = 0;
-            quint64 startUpdate = 0, endUpdate = 0;
-            quint64 startCreate = 0, endCreate = 0;
-            quint64 startFilter = 0, endFilter = 0;
-            quint64 startLogging = 0, endLogging = 0;
-
-            bool suppressDisallowedClientScript = false;
-            bool suppressDisallowedServerScript = false;
-            bool isPhysics = message.getType() == PacketType::EntityPhysics;
-
-            _totalEditMessages++;
-
-            EntityItemID entityItemID;
-            EntityItemProperties properties;
-            startDecode = usecTimestampNow();
-
-            bool validEditPacket = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, processedBytes,
-                                                                                entityItemID, properties);
-            endDecode = usecTimestampNow();
-
-            EntityItemPointer existingEntity;
-            if (!isAdd) {
-                // search for the entity by EntityItemID
-                startLookup = usecTimestampNow();
-                existingEntity = findEntityByEntityItemID(entityItemID);
-                endLookup = usecTimestampNow();
-                if (!existingEntity) {
-                    // this is not an add-entity operation, and we don't know about the identified entity.
-                    validEditPacket = false;
-                }
-            }
+            EntityEditRecord record;
+            decodeEntityEditRecord(message.getType(), editData, maxLength, record);
+            processedBytes = record.recordBytes;
+            processEntityEditRecord(record, senderNode);
+            break;
+        }
+
+        default:
+            processedBytes = 0;
+            break;
+    }
+    return processedBytes;
+}
+
+OctreeEditRecordPointer EntityTree::decodeEditPacketData(const ReceivedMessage& message, const unsigned char* editData,
+                                                         int maxLength) {
+    switch (message.getType()) {
+        case PacketType::EntityAdd:
+        case PacketType::EntityPhysics:
+        case PacketType::EntityEdit: {
+            auto record = std::make_shared<EntityEditRecord>();
+            decodeEntityEditRecord(message.getType(), editData, maxLength, *record);
+            return record;
+        }
 
-            if (validEditPacket && !_entityScriptSourceWhitelist.isEmpty()) {
+        default:
+            // erases are applied directly with processEditPacketData()
+            return nullptr;
+    }
+}
 
-                bool wasDeletedBecauseOfClientScript = false;
+bool EntityTree::processDecodedEditPacketData(const ReceivedMessage& message, const OctreeEditRecordPointer& record,
+                                              const SharedNodePointer& senderNode) {
+    if (!getIsServer()) {
+        qCWarning(entities) << "EntityTree::processDecodedEditPacketData() should only be called on a server tree.";
+        return false;
+    }
+    return processEntityEditRecord(*std::static_pointer_cast<EntityEditRecord>(record), senderNode);
+}
 
-                // check the client entity script to make sure its URL is in the whitelist
-                if (!properties.getScript().isEmpty()) {
-                    bool clientScriptPassedWhitelist = isScriptInWhitelist(properties.getScript());
+bool EntityEditRecord::isSupersededBy(const OctreeEditRecord& other) const {
+    const EntityEditRecord& otherEdit = static_cast<const EntityEditRecord&>(other);
+    if (type != otherEdit.type || type == PacketType::EntityAdd || !otherEdit.valid ||
+        entityItemID != otherEdit.entityItemID) {
+        return false;
+    }
+    // an older edit that arrives later would be rejected by the entity, so it can't stand in for this one
+    if (otherEdit.properties.getLastEdited() < properties.getLastEdited()) {
+        return false;
+    }
+    EntityPropertyFlags changedProperties = properties.getChangedProperties();
+    return (changedProperties & otherEdit.properties.getChangedProperties()) == changedProperties;
+}
 
-                    if (!clientScriptPassedWhitelist) {
-                        if (wantEditLogging()) {
-                            qCDebug(entities) << "User [" << senderNode->getUUID()
-                                << "] attempting to set entity script not on whitelist, edit rejected";
-                        }
+void EntityTree::decodeEntityEditRecord(PacketType type, const unsigned char* editData, int maxLength,
+                                        EntityEditRecord& record) {
+    quint64 startDecode = usecTimestampNow();
+    record.type = type;
+    record.valid = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, record.recordBytes,
+                                                                record.entityItemID, record.properties);
+    // adds can't be merged or rate limited, leave them without a target
+    if (record.valid && type != PacketType::EntityAdd) {
+        record.targetID = record.entityItemID;
+    }
+    record.decodeTime = usecTimestampNow() - startDecode;
+}
 
-                        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                        if (isAdd) {
-                            QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                            _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                            validEditPacket = false;
-                            wasDeletedBecauseOfClientScript = true;
-                        } else {
-                            suppressDisallowedClientScript = true;
-                        }
-                    }
-                }
+bool EntityTree::processEntityEditRecord(EntityEditRecord& record, const SharedNodePointer& senderNode) {
+    // true only when the edit reached the entity with every property it was sent with
+    bool appliedAsSent = false;
+    quint64 startLookup = 0, endLookup = 0;
+    quint64 startUpdate = 0, endUpdate = 0;
+    quint64 startCreate = 0, endCreate = 0;
+    quint64 startFilter = 0, endFilter = 0;
+    quint64 startLogging = 0, endLogging = 0;
 
-                // check all server entity scripts to make sure their URLs are in the whitelist
-                if (!properties.getServerScripts().isEmpty()) {
-                    bool serverScriptPassedWhitelist = isScriptInWhitelist(properties.getServerScripts());
+    bool suppressDisallowedClientScript = false;
+    bool suppressDisallowedServerScript = false;
+    bool isAdd = record.type == PacketType::EntityAdd;
+    bool isPhysics = record.type == PacketType::EntityPhysics;
 
-                    if (!serverScriptPassedWhitelist) {
-                        if (wantEditLogging()) {
-                            qCDebug(entities) << "User [" << senderNode->getUUID()
-                                << "] attempting to set server entity script not on whitelist, edit rejected";
-                        }
+    _totalEditMessages++;
 
-                        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                        if (isAdd) {
-                            // Make sure we didn't already need to send back a delete because the client script failed
-                            // the whitelist check
-                            if (!wasDeletedBecauseOfClientScript) {
-                                QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                                _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                                validEditPacket = false;
-                            }
-                        } else {
-                            suppressDisallowedServerScript = true;
-                        }
-                    }
+    const EntityItemID& entityItemID = record.entityItemID;
+    EntityItemProperties& properties = record.properties;
+    bool validEditPacket = record.valid;
+
+    EntityItemPointer existingEntity;
+    if (!isAdd) {
+        // search for the entity by EntityItemID
+        startLookup = usecTimestampNow();
+        existingEntity = findEntityByEntityItemID(entityItemID);
+        endLookup = usecTimestampNow();
+        if (!existingEntity) {
+            // this is not an add-entity operation, and we don't know about the identified entity.
+            validEditPacket = false;
+        }
+    }
+
+    if (validEditPacket && !_entityScriptSourceWhitelist.isEmpty()) {
+
+        bool wasDeletedBecauseOfClientScript = false;
+
+        // check the client entity script to make sure its URL is in the whitelist
+        if (!properties.getScript().isEmpty()) {
+            bool clientScriptPassedWhitelist = isScriptInWhitelist(properties.getScript());
+
+            if (!clientScriptPassedWhitelist) {
+                if (wantEditLogging()) {
+                    qCDebug(entities) << "User [" << senderNode->getUUID()
+                        << "] attempting to set entity script not on whitelist, edit rejected";
                 }
 
+                // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
+                if (isAdd) {
+                    QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+                    _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+                    validEditPacket = false;
+                    wasDeletedBecauseOfClientScript = true;
+                } else {
+                    suppressDisallowedClientScript = true;
+                }
             }
+        }
+
+        // check all server entity scripts to make sure their URLs are in the whitelist
+        if (!properties.getServerScripts().isEmpty()) {
+            bool serverScriptPassedWhitelist = isScriptInWhitelist(properties.getServerScripts());
+
+            if (!serverScriptPassedWhitelist) {
+                if (wantEditLogging()) {
+                    qCDebug(entities) << "User [" << senderNode->getUUID()
+                        << "] attempting to set server entity script not on whitelist, edit rejected";
+                }
 
-            if ((isAdd || properties.lifetimeChanged()) &&
-                ((!senderNode->getCanRez() && senderNode->getCanRezTmp()) ||
-                (!senderNode->getCanRezCertified() && senderNode->getCanRezTmpCertified()))) {
-                // this node is only allowed to rez temporary entities.  if need be, cap the lifetime.
-                if (properties.getLifetime() == ENTITY_ITEM_IMMORTAL_LIFETIME ||
-                    properties.getLifetime() > _maxTmpEntityLifetime) {
-                    properties.setLifetime(_maxTmpEntityLifetime);
-                    bumpTimestamp(properties);
+                // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
+                if (isAdd) {
+                    // Make sure we didn't already need to send back a delete because the client script failed
+                    // the whitelist check
+                    if (!wasDeletedBecauseOfClientScript) {
+                        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+                        _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+                        validEditPacket = false;
+                    }
+                } else {
+                    suppressDisallowedServerScript = true;
                 }
             }
+        }
+
+    }
 
-            if (isAdd && properties.getLocked() && !senderNode->isAllowedEditor()) {
-                // if a node can't change locks, don't allow it to create an already-locked entity -- automatically
-                // clear the locked property and allow the unlocked entity to be created.
-                properties.setLocked(false);
+    if ((isAdd || properties.lifetimeChanged()) &&
+        ((!senderNode->getCanRez() && senderNode->getCanRezTmp()) ||
+        (!senderNode->getCanRezCertified() && senderNode->getCanRezTmpCertified()))) {
+        // this node is only allowed to rez temporary entities.  if need be, cap the lifetime.
+        if (properties.getLifetime() == ENTITY_ITEM_IMMORTAL_LIFETIME ||
+            properties.getLifetime() > _maxTmpEntityLifetime) {
+            properties.setLifetime(_maxTmpEntityLifetime);
+            bumpTimestamp(properties);
+        }
+    }
+
+    if (isAdd && properties.getLocked() && !senderNode->isAllowedEditor()) {
+        // if a node can't change locks, don't allow it to create an already-locked entity -- automatically
+        // clear the locked property and allow the unlocked entity to be created.
+        properties.setLocked(false);
+        bumpTimestamp(properties);
+    }
+
+    // If we got a valid edit packet, then it could be a new entity or it could be an update to
+    // an existing entity... handle appropriately
+    if (validEditPacket) {
+        startFilter = usecTimestampNow();
+        bool wasChanged = false;
+        // Having (un)lock rights bypasses the filter, unless it's a physics result.
+        FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
+        bool allowed = (!isPhysics && senderNode->isAllowedEditor()) || filterProperties(existingEntity, properties, properties, wasChanged, filterType);
+        if (!allowed) {
+            auto timestamp = properties.getLastEdited();
+            properties = EntityItemProperties();
+            properties.setLastEdited(timestamp);
+        }
+        if (!allowed || wasChanged) {
+            bumpTimestamp(properties);
+            // For now, free ownership on any modification.
+            properties.clearSimulationOwner();
+        }
+        endFilter = usecTimestampNow();
+
+        if (existingEntity && !isAdd) {
+
+            if (suppressDisallowedClientScript) {
                 bumpTimestamp(properties);
+                properties.setScript(existingEntity->getScript());
             }
 
-            // If we got a valid edit packet, then it could be a new entity or it could be an update to
-            // an existing entity... handle appropriately
-            if (validEditPacket) {
-                startFilter = usecTimestampNow();
-                bool wasChanged = false;
-                // Having (un)lock rights bypasses the filter, unless it's a physics result.
-                FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
-                bool allowed = (!isPhysics && senderNode->isAllowedEditor()) || filterProperties(existingEntity, properties, properties, wasChanged, filterType);
-                if (!allowed) {
-                    auto timestamp = properties.getLastEdited();
-                    properties = EntityItemProperties();
-                    properties.setLastEdited(timestamp);
-                }
-                if (!allowed || wasChanged) {
-                    bumpTimestamp(properties);
-                    // For now, free ownership on any modification.
-                    properties.clearSimulationOwner();
-                }
-                endFilter = usecTimestampNow();
+            if (suppressDisallowedServerScript) {
+                bumpTimestamp(properties);
+                properties.setServerScripts(existingEntity->getServerScripts());
+            }
 
-                if (existingEntity && !isAdd) {
+            // if the EntityItem exists, then update it
+            startLogging = usecTimestampNow();
+            if (wantEditLogging()) {
+                qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
+                qCDebug(entities) << "   properties:" << properties;
+            }
+            if (wantTerseEditLogging()) {
+                QList<QString> changedProperties = properties.listChangedProperties();
+                fixupTerseEditLogging(properties, changedProperties);
+                qCDebug(entities) << senderNode->getUUID() << "edit" <<
+                    existingEntity->getDebugName() << changedProperties;
+            }
+            endLogging = usecTimestampNow();
 
-                    if (suppressDisallowedClientScript) {
-                        bumpTimestamp(properties);
-                        properties.setScript(existingEntity->getScript());
+            startUpdate = usecTimestampNow();
+            if (!isPhysics) {
+                properties.setLastEditedBy(senderNode->getUUID());
+            }
+            bool wasSquashed = false;
+            bool updated = updateEntity(existingEntity, properties, senderNode, &wasSquashed);
+            appliedAsSent = updated && allowed && !wasChanged && !wasSquashed &&
+                !suppressDisallowedClientScript && !suppressDisallowedServerScript;
+            existingEntity->markAsChangedOnServer();
+            endUpdate = usecTimestampNow();
+            _totalUpdates++;
+        } else if (isAdd) {
+            bool failedAdd = !allowed;
+            bool isCertified = !properties.getCertificateID().isEmpty();
+            if (!allowed) {
+                qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
+            } else if (!isCertified && !senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
+                failedAdd = true;
+                qCDebug(entities) << "User without 'uncertified rez rights' [" << senderNode->getUUID()
+                    << "] attempted to add an uncertified entity with ID:" << entityItemID;
+            } else if (isCertified && !senderNode->getCanRezCertified() && !senderNode->getCanRezTmpCertified()) {
+                failedAdd = true;
+                qCDebug(entities) << "User without 'certified rez rights' [" << senderNode->getUUID()
+                    << "] attempted to add a certified entity with ID:" << entityItemID;
+            } else {
+                // this is a new entity... assign a new entityID
+                properties.setCreated(properties.getLastEdited());
+                properties.setLastEditedBy(senderNode->getUUID());
+                startCreate = usecTimestampNow();
+                EntityItemPointer newEntity = addEntity(entityItemID, properties);
+                endCreate = usecTimestampNow();
+                _totalCreates++;
+
+                if (newEntity && isCertified && getIsServer()) {
+                    if (!properties.verifyStaticCertificateProperties()) {
+                        qCDebug(entities) << "User" << senderNode->getUUID()
+                            << "attempted to add a certified entity with ID" << entityItemID << "which failed"
+                            << "static certificate verification.";
+                        // Delete the entity we just added if it doesn't pass static certificate verification
+                        deleteEntity(entityItemID, true);
+                    } else {
+                        validatePop(properties.getCertificateID(), entityItemID, senderNode, false);
                     }
+                }
 
-                    if (suppressDisallowedServerScript) {
-                        bumpTimestamp(properties);
-                        properties.setServerScripts(existingEntity->getServerScripts());
-                    }
+                if (newEntity) {
+                    appliedAsSent = true;
+                    newEntity->markAsChangedOnServer();
+                    notifyNewlyCreatedEntity(*newEntity, senderNode);
 
-                    // if the EntityItem exists, then update it
                     startLogging = usecTimestampNow();
                     if (wantEditLogging()) {
-                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
+                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
+                                          << newEntity->getEntityItemID();
                         qCDebug(entities) << "   properties:" << properties;
                     }
                     if (wantTerseEditLogging()) {
                         QList<QString> changedProperties = properties.listChangedProperties();
                         fixupTerseEditLogging(properties, changedProperties);
-                        qCDebug(entities) << senderNode->getUUID() << "edit" <<
-                            existingEntity->getDebugName() << changedProperties;
+                        qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
                     }
                     endLogging = usecTimestampNow();
 
-                    startUpdate = usecTimestampNow();
-                    if (!isPhysics) {
-                        properties.setLastEditedBy(senderNode->getUUID());
-                    }
-                    updateEntity(existingEntity, properties, senderNode);
-                    existingEntity->markAsChangedOnServer();
-                    endUpdate = usecTimestampNow();
-                    _totalUpdates++;
-                } else if (isAdd) {
-                    bool failedAdd = !allowed;
-                    bool isCertified = !properties.getCertificateID().isEmpty();
-                    if (!allowed) {
-                        qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
-                    } else if (!isCertified && !senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User without 'uncertified rez rights' [" << senderNode->getUUID()
-                            << "] attempted to add an uncertified entity with ID:" << entityItemID;
-                    } else if (isCertified && !senderNode->getCanRezCertified() && !senderNode->getCanRezTmpCertified()) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User without 'certified rez rights' [" << senderNode->getUUID()
-                            << "] attempted to add a certified entity with ID:" << entityItemID;
-                    } else {
-                        // this is a new entity... assign a new entityID
-                        properties.setCreated(properties.getLastEdited());
-                        properties.setLastEditedBy(senderNode->getUUID());
-                        startCreate = usecTimestampNow();
-                        EntityItemPointer newEntity = addEntity(entityItemID, properties);
-                        endCreate = usecTimestampNow();
-                        _totalCreates++;
-
-                        if (newEntity && isCertified && getIsServer()) {
-                            if (!properties.verifyStaticCertificateProperties()) {
-                                qCDebug(entities) << "User" << senderNode->getUUID()
-                                    << "attempted to add a certified entity with ID" << entityItemID << "which failed"
-                                    << "static certificate verification.";
-                                // Delete the entity we just added if it doesn't pass static certificate verification
-                                deleteEntity(entityItemID, true);
-                            } else {
-                                validatePop(properties.getCertificateID(), entityItemID, senderNode, false);
-                            }
-                        }
-
-                        if (newEntity) {
-                            newEntity->markAsChangedOnServer();
-                            notifyNewlyCreatedEntity(*newEntity, senderNode);
-
-                            startLogging = usecTimestampNow();
-                            if (wantEditLogging()) {
-                                qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
-                                                  << newEntity->getEntityItemID();
-                                qCDebug(entities) << "   properties:" << properties;
-                            }
-                            if (wantTerseEditLogging()) {
-                                QList<QString> changedProperties = properties.listChangedProperties();
-                                fixupTerseEditLogging(properties, changedProperties);
-                                qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
-                            }
-                            endLogging = usecTimestampNow();
-
-                        } else {
-                            failedAdd = true;
-                            qCDebug(entities) << "Add entity failed ID:" << entityItemID;
-                        }
-                    }
-                    if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
-                        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                        _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                    }
                 } else {
-                    static QString repeatedMessage =
-                        LogHandler::getInstance().addRepeatedMessageRegex("^Edit failed.*");
-                    qCDebug(entities) << "Edit failed. [" << message.getType() <<"] " <<
-                            "entity id:" << entityItemID << 
-                            "existingEntity pointer:" << existingEntity.get();
+                    failedAdd = true;
+                    qCDebug(entities) << "Add entity failed ID:" << entityItemID;
                 }
             }
+            if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
+                QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+                _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+            }
+        } else {
+            static QString repeatedMessage =
+                LogHandler::getInstance().addRepeatedMessageRegex("^Edit failed.*");
+            qCDebug(entities) << "Edit failed. [" << record.type <<"] " <<
+                    "entity id:" << entityItemID << 
+                    "existingEntity pointer:" << existingEntity.get();
+        }
+    }
 
 
-            _totalDecodeTime += endDecode - startDecode;
-            _totalLookupTime += endLookup - startLookup;
-            _totalUpdateTime += endUpdate - startUpdate;
-            _totalCreateTime += endCreate - startCreate;
-            _totalLoggingTime += endLogging - startLogging;
-            _totalFilterTime += endFilter - startFilter;
-
-            break;
-        }
+    _totalDecodeTime += record.decodeTime;
+    _totalLookupTime += endLookup - startLookup;
+    _totalUpdateTime += endUpdate - startUpdate;
+    _totalCreateTime += endCreate - startCreate;
+    _totalLoggingTime += endLogging - startLogging;
+    _totalFilterTime += endFilter - startFilter;
 
-        default:
-            processedBytes = 0;
-            break;
-    }
-    return processedBytes;
+    return appliedAsSent;
 }
 
 
@@ -1833,6 +1942,10 @@ void EntityTree::update(bool simulate) {
             }
         }
     });
+    if (_bvh) {
+        // fold this frame's moves into the BVH now rather than during the first query that follows
+        _bvh->sync();
+    }
 }
 
 quint64 EntityTree::getAdjustedConsiderSince(quint64 sinceTime) {
@@ -2029,11 +2142,34 @@ void EntityTree::addEntityMapEntry(EntityItemPointer entity) {
         return;
     }
     _entityMap.insert(id, entity);
+    if (_bvh) {
+        _bvh->addEntity(entity);
+    }
 }
 
 void EntityTree::clearEntityMapEntry(const EntityItemID& id) {
     QWriteLocker locker(&_entityMapLock);
-    _entityMap.remove(id);
+    EntityItemPointer entity = _entityMap.take(id);
+    if (_bvh && entity) {
+        _bvh->removeEntity(entity.get());
+    }
+}
+
+void EntityTree::setUseBVH(bool useBVH) {
+    if (useBVH == (bool)_bvh) {
+        return;
+    }
+    if (useBVH) {
+        auto bvh = std::make_shared<EntityTreeBVH>();
+        QReadLocker locker(&_entityMapLock);
+        foreach(EntityItemPointer entity, _entityMap) {
+            bvh->addEntity(entity);
+        }
+        bvh->sync();
+        _bvh = bvh;
+    } else {
+        _bvh.reset();
+    }
 }
 
 void EntityTree::debugDumpMap() {
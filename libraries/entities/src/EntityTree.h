@@ -22,6 +22,7 @@ class EntityTree;
 using EntityTreePointer = std::shared_ptr<EntityTree>;
 
 #include "AddEntityOperator.h"
+#include "EntityTreeBVH.h"
 #include "EntityTreeElement.h"
 #include "DeleteEntityOperator.h"
 #include "MovingEntitiesOperator.h"
@@ -50,6 +51,18 @@ public:
     QHash<EntityItemID, EntityItemID>* map;
 };
 
+// a decoded EntityAdd, EntityEdit or EntityPhysics record
+class EntityEditRecord : public OctreeEditRecord {
+public:
+    virtual bool isSupersededBy(const OctreeEditRecord& other) const override;
+
+    PacketType type { PacketType::Unknown };
+    EntityItemID entityItemID;
+    EntityItemProperties properties;
+    bool valid { false };
+    quint64 decodeTime { 0 };
+};
+
 
 class EntityTree : public Octree, public SpatialParentTree {
     Q_OBJECT
@@ -94,6 +107,10 @@ public:
     void fixupTerseEditLogging(EntityItemProperties& properties, QList<QString>& changedProperties);
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& senderNode) override;
+    virtual OctreeEditRecordPointer decodeEditPacketData(const ReceivedMessage& message, const unsigned char* editData,
+                                                         int maxLength) override;
+    virtual bool processDecodedEditPacketData(const ReceivedMessage& message, const OctreeEditRecordPointer& record,
+                                              const SharedNodePointer& senderNode) override;
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
     virtual void processChallengeOwnershipReplyPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
     virtual void processChallengeOwnershipPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
@@ -211,6 +228,11 @@ public:
 
     void entityChanged(EntityItemPointer entity);
 
+    // the optional BVH answers the spatial queries below in place of walking the octree
+    void setUseBVH(bool useBVH);
+    bool getUseBVH() const { return (bool)_bvh; }
+    void entityBoundsChanged(EntityItem* entity) { if (_bvh) { _bvh->entityBoundsChanged(entity); } }
+
     void emitEntityScriptChanging(const EntityItemID& entityItemID, bool reload);
     void emitEntityServerScriptChanging(const EntityItemID& entityItemID, bool reload);
 
@@ -316,7 +338,7 @@ protected:
 
     void processRemovedEntities(const DeleteEntityOperator& theOperator);
     bool updateEntity(EntityItemPointer entity, const EntityItemProperties& properties,
-            const SharedNodePointer& senderNode = SharedNodePointer(nullptr));
+            const SharedNodePointer& senderNode = SharedNodePointer(nullptr), bool* wasSquashed = nullptr);
     static bool findNearPointOperation(const OctreeElementPointer& element, void* extraData);
     static bool findInSphereOperation(const OctreeElementPointer& element, void* extraData);
     static bool findInCubeOperation(const OctreeElementPointer& element, void* extraData);
@@ -325,6 +347,10 @@ protected:
     static bool sendEntitiesOperation(const OctreeElementPointer& element, void* extraData);
     static void bumpTimestamp(EntityItemProperties& properties);
 
+    static void decodeEntityEditRecord(PacketType type, const unsigned char* editData, int maxLength,
+                                       EntityEditRecord& record);
+    bool processEntityEditRecord(EntityEditRecord& record, const SharedNodePointer& senderNode);
+
     void notifyNewlyCreatedEntity(const EntityItem& newEntity, const SharedNodePointer& senderNode);
 
     bool isScriptInWhitelist(const QString& scriptURL);
@@ -397,6 +423,7 @@ protected:
     QStringList _entityScriptSourceWhitelist;
 
     MovingEntitiesOperator _entityMover;
+    EntityTreeBVHPointer _bvh;
     QHash<EntityItemID, EntityItemPointer> _entitiesToAdd;
 
     Q_INVOKABLE void startChallengeOwnershipTimer(const EntityItemID& entityItemID);
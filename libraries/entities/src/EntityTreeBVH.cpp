@@ -0,0 +1,563 @@
+//
+//  EntityTreeBVH.cpp
+//  libraries/entities/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeBVH.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <glm/gtx/norm.hpp>
+
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <ViewFrustum.h>
+
+#include "EntityTreeElement.h"
+
+const int EntityTreeBVH::MAX_LEAF_SIZE = 4;
+const float EntityTreeBVH::MAX_REFIT_COST_RATIO = 1.5f;
+const float EntityTreeBVH::MAX_UNINDEXED_RATIO = 0.1f;
+const uint64_t EntityTreeBVH::REBUILD_PERIOD = 5 * USECS_PER_SECOND;
+
+static const size_t MIN_UNINDEXED_BEFORE_REBUILD = 32;
+static const int NUM_SAH_BINS = 16;
+
+namespace {
+    const glm::vec3 EMPTY_MINIMUM(std::numeric_limits<float>::max());
+    const glm::vec3 EMPTY_MAXIMUM(-std::numeric_limits<float>::max());
+    const glm::vec3 INFINITE_MINIMUM(-std::numeric_limits<float>::infinity());
+    const glm::vec3 INFINITE_MAXIMUM(std::numeric_limits<float>::infinity());
+
+    float surfaceArea(const glm::vec3& minimum, const glm::vec3& maximum) {
+        glm::vec3 d = glm::max(maximum - minimum, glm::vec3(0.0f));
+        return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    bool isFinite(const glm::vec3& minimum, const glm::vec3& maximum) {
+        return glm::all(glm::lessThan(maximum - minimum, INFINITE_MAXIMUM));
+    }
+
+    bool boxesOverlap(const glm::vec3& minA, const glm::vec3& maxA, const glm::vec3& minB, const glm::vec3& maxB) {
+        return glm::all(glm::lessThanEqual(minA, maxB)) && glm::all(glm::lessThanEqual(minB, maxA));
+    }
+
+    float distanceSquaredToBox(const glm::vec3& point, const glm::vec3& minimum, const glm::vec3& maximum) {
+        glm::vec3 closest = glm::clamp(point, minimum, maximum);
+        return glm::distance2(point, closest);
+    }
+}
+
+void EntityTreeBVH::addEntity(const EntityItemPointer& entity) {
+    std::lock_guard<std::mutex> lock(_pendingMutex);
+    PendingChange change;
+    change.entity = entity;
+    change.rawEntity = entity.get();
+    change.add = true;
+    _pendingChanges.push_back(change);
+    _hasPending = true;
+}
+
+void EntityTreeBVH::removeEntity(EntityItem* entity) {
+    std::lock_guard<std::mutex> lock(_pendingMutex);
+    PendingChange change;
+    change.rawEntity = entity;
+    change.add = false;
+    _pendingChanges.push_back(change);
+    _hasPending = true;
+}
+
+void EntityTreeBVH::entityBoundsChanged(EntityItem* entity) {
+    std::lock_guard<std::mutex> lock(_pendingMutex);
+    _pendingBounds.insert(entity);
+    _hasPending = true;
+}
+
+void EntityTreeBVH::clear() {
+    std::lock_guard<std::mutex> lock(_pendingMutex);
+    _pendingChanges.clear();
+    _pendingBounds.clear();
+    _clearPending = true;
+    _hasPending = true;
+}
+
+void EntityTreeBVH::sync() {
+    if (!_hasPending) {
+        return;
+    }
+    uint64_t now = usecTimestampNow();
+    withWriteLock([&] {
+        applyPendingChanges(now);
+    });
+}
+
+void EntityTreeBVH::applyPendingChanges(uint64_t now) {
+    std::vector<PendingChange> changes;
+    std::unordered_set<EntityItem*> changedBounds;
+    bool clearAll = false;
+    {
+        std::lock_guard<std::mutex> lock(_pendingMutex);
+        changes.swap(_pendingChanges);
+        changedBounds.swap(_pendingBounds);
+        clearAll = _clearPending;
+        _clearPending = false;
+        _hasPending = false;
+    }
+
+    if (clearAll) {
+        _primitives.clear();
+        _primitiveIndices.clear();
+        _nodes.clear();
+        _unindexed.clear();
+        _unbounded.clear();
+        _primitiveMap.clear();
+        _numIndexed = 0;
+        _numRemoved = 0;
+        _builtCost = 0.0f;
+    }
+
+    // membership changes are applied in the order they happened, since an EntityItem address may be reused
+    for (auto& change : changes) {
+        auto itr = _primitiveMap.find(change.rawEntity);
+        if (itr != _primitiveMap.end()) {
+            Primitive& oldPrimitive = _primitives[itr->second];
+            oldPrimitive.removed = true;
+            oldPrimitive.entity.reset();
+            _primitiveMap.erase(itr);
+            ++_numRemoved;
+        }
+        if (change.add && !change.entity.expired()) {
+            uint32_t index = (uint32_t)_primitives.size();
+            _primitives.emplace_back();
+            Primitive& primitive = _primitives.back();
+            primitive.entity = change.entity;
+            primitive.rawEntity = change.rawEntity;
+            updatePrimitiveBounds(primitive);
+            _primitiveMap[change.rawEntity] = index;
+            _unindexed.push_back(index);
+        }
+        _changedSinceRebuild = true;
+    }
+
+    bool needsRefit = false;
+    for (auto rawEntity : changedBounds) {
+        auto itr = _primitiveMap.find(rawEntity);
+        if (itr != _primitiveMap.end()) {
+            updatePrimitiveBounds(_primitives[itr->second]);
+            needsRefit = true;
+        }
+    }
+    if (needsRefit) {
+        refit();
+        _changedSinceRebuild = true;
+    }
+
+    size_t numLive = _primitives.size() - _numRemoved;
+    size_t maxUnindexed = std::max(MIN_UNINDEXED_BEFORE_REBUILD, (size_t)(MAX_UNINDEXED_RATIO * numLive));
+    bool shouldRebuild = (_unindexed.size() + _numRemoved) > maxUnindexed;
+    if (!shouldRebuild && needsRefit) {
+        float cost = computeCost();
+        const float COST_SLACK = 1.0f; // keeps degenerate (flat or point-like) hierarchies from rebuilding every sync
+        shouldRebuild = !(cost <= MAX_REFIT_COST_RATIO * _builtCost + COST_SLACK);
+    }
+    if (!shouldRebuild && _changedSinceRebuild && (!_unindexed.empty() || _numRemoved > 0)) {
+        shouldRebuild = now - _lastRebuild > REBUILD_PERIOD;
+    }
+    if (shouldRebuild) {
+        rebuild();
+        _lastRebuild = now;
+    }
+}
+
+void EntityTreeBVH::updatePrimitiveBounds(Primitive& primitive) {
+    EntityItemPointer entity = primitive.entity.lock();
+    if (!entity) {
+        primitive.hasBounds = false;
+        return;
+    }
+    bool success;
+    AABox box = entity->getAABox(success);
+    primitive.hasBounds = success;
+    if (success) {
+        primitive.minimum = box.getMinimumPoint();
+        primitive.maximum = box.getMaximumPoint();
+    }
+}
+
+void EntityTreeBVH::rebuild() {
+    // compact away removed primitives
+    std::vector<Primitive> livePrimitives;
+    livePrimitives.reserve(_primitives.size() - _numRemoved);
+    for (auto& primitive : _primitives) {
+        if (!primitive.removed && !primitive.entity.expired()) {
+            livePrimitives.push_back(primitive);
+        }
+    }
+    _primitives.swap(livePrimitives);
+    _primitiveMap.clear();
+    _primitiveIndices.clear();
+    _unindexed.clear();
+    _unbounded.clear();
+    _nodes.clear();
+    _numRemoved = 0;
+
+    std::vector<glm::vec3> centroids(_primitives.size());
+    for (uint32_t i = 0; i < (uint32_t)_primitives.size(); ++i) {
+        const Primitive& primitive = _primitives[i];
+        _primitiveMap[primitive.rawEntity] = i;
+        if (primitive.hasBounds) {
+            centroids[i] = 0.5f * (primitive.minimum + primitive.maximum);
+            _primitiveIndices.push_back(i);
+        } else {
+            // entities without known bounds are tested on every query
+            _unbounded.push_back(i);
+        }
+    }
+
+    _numIndexed = _primitiveIndices.size();
+    if (_numIndexed > 0) {
+        _nodes.reserve(2 * _numIndexed / MAX_LEAF_SIZE + 1);
+        _nodes.emplace_back();
+        buildNode(0, 0, (uint32_t)_numIndexed, centroids);
+    }
+    _builtCost = computeCost();
+    _changedSinceRebuild = false;
+    ++_numRebuilds;
+}
+
+void EntityTreeBVH::buildNode(uint32_t nodeIndex, uint32_t first, uint32_t count, std::vector<glm::vec3>& centroids) {
+    glm::vec3 minimum = EMPTY_MINIMUM;
+    glm::vec3 maximum = EMPTY_MAXIMUM;
+    glm::vec3 centroidMinimum = EMPTY_MINIMUM;
+    glm::vec3 centroidMaximum = EMPTY_MAXIMUM;
+    for (uint32_t i = first; i < first + count; ++i) {
+        const Primitive& primitive = _primitives[_primitiveIndices[i]];
+        minimum = glm::min(minimum, primitive.minimum);
+        maximum = glm::max(maximum, primitive.maximum);
+        centroidMinimum = glm::min(centroidMinimum, centroids[_primitiveIndices[i]]);
+        centroidMaximum = glm::max(centroidMaximum, centroids[_primitiveIndices[i]]);
+    }
+    _nodes[nodeIndex].minimum = minimum;
+    _nodes[nodeIndex].maximum = maximum;
+
+    if (count <= (uint32_t)MAX_LEAF_SIZE) {
+        _nodes[nodeIndex].first = first;
+        _nodes[nodeIndex].count = count;
+        return;
+    }
+
+    // split along the axis of largest centroid extent
+    glm::vec3 extent = centroidMaximum - centroidMinimum;
+    int axis = (extent.x > extent.y && extent.x > extent.z) ? 0 : (extent.y > extent.z ? 1 : 2);
+    uint32_t middle = first + count / 2;
+    auto begin = _primitiveIndices.begin() + first;
+    auto end = begin + count;
+
+    if (extent[axis] > EPSILON) {
+        // binned surface area heuristic
+        class Bin {
+        public:
+            glm::vec3 minimum { EMPTY_MINIMUM };
+            glm::vec3 maximum { EMPTY_MAXIMUM };
+            uint32_t count { 0 };
+        };
+        Bin bins[NUM_SAH_BINS];
+        float binScale = (float)NUM_SAH_BINS / extent[axis];
+        auto binIndex = [&](uint32_t primitiveIndex) {
+            int index = (int)((centroids[primitiveIndex][axis] - centroidMinimum[axis]) * binScale);
+            return glm::clamp(index, 0, NUM_SAH_BINS - 1);
+        };
+        for (auto itr = begin; itr != end; ++itr) {
+            Bin& bin = bins[binIndex(*itr)];
+            bin.minimum = glm::min(bin.minimum, _primitives[*itr].minimum);
+            bin.maximum = glm::max(bin.maximum, _primitives[*itr].maximum);
+            ++bin.count;
+        }
+
+        // sweep from the right to accumulate the cost of every right partition
+        float rightCosts[NUM_SAH_BINS];
+        glm::vec3 sweepMinimum = EMPTY_MINIMUM;
+        glm::vec3 sweepMaximum = EMPTY_MAXIMUM;
+        uint32_t sweepCount = 0;
+        for (int i = NUM_SAH_BINS - 1; i > 0; --i) {
+            sweepMinimum = glm::min(sweepMinimum, bins[i].minimum);
+            sweepMaximum = glm::max(sweepMaximum, bins[i].maximum);
+            sweepCount += bins[i].count;
+            rightCosts[i] = surfaceArea(sweepMinimum, sweepMaximum) * sweepCount;
+        }
+
+        float bestCost = std::numeric_limits<float>::max();
+        int bestSplit = -1;
+        sweepMinimum = EMPTY_MINIMUM;
+        sweepMaximum = EMPTY_MAXIMUM;
+        sweepCount = 0;
+        for (int i = 0; i < NUM_SAH_BINS - 1; ++i) {
+            sweepMinimum = glm::min(sweepMinimum, bins[i].minimum);
+            sweepMaximum = glm::max(sweepMaximum, bins[i].maximum);
+            sweepCount += bins[i].count;
+            if (sweepCount == 0 || sweepCount == count) {
+                continue;
+            }
+            float cost = surfaceArea(sweepMinimum, sweepMaximum) * sweepCount + rightCosts[i + 1];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestSplit = i;
+            }
+        }
+
+        if (bestSplit >= 0) {
+            auto split = std::partition(begin, end, [&](uint32_t primitiveIndex) {
+                return binIndex(primitiveIndex) <= bestSplit;
+            });
+            middle = (uint32_t)(split - _primitiveIndices.begin());
+        }
+    }
+
+    if (middle == first || middle == first + count) {
+        // degenerate distribution: fall back to a median split
+        middle = first + count / 2;
+        std::nth_element(begin, _primitiveIndices.begin() + middle, end, [&](uint32_t a, uint32_t b) {
+            return centroids[a][axis] < centroids[b][axis];
+        });
+    }
+
+    // children are allocated together and after their parent, so refit() can walk the nodes backwards
+    uint32_t left = (uint32_t)_nodes.size();
+    _nodes.emplace_back();
+    _nodes.emplace_back();
+    _nodes[nodeIndex].first = left;
+    _nodes[nodeIndex].count = 0;
+    buildNode(left, first, middle - first, centroids);
+    buildNode(left + 1, middle, first + count - middle, centroids);
+}
+
+void EntityTreeBVH::refit() {
+    for (size_t i = _nodes.size(); i-- > 0; ) {
+        Node& node = _nodes[i];
+        if (node.count > 0) {
+            node.minimum = EMPTY_MINIMUM;
+            node.maximum = EMPTY_MAXIMUM;
+            for (uint32_t j = node.first; j < node.first + node.count; ++j) {
+                const Primitive& primitive = _primitives[_primitiveIndices[j]];
+                if (primitive.removed) {
+                    continue;
+                }
+                if (!primitive.hasBounds) {
+                    // this leaf must be visited by every query until the next rebuild moves the primitive out
+                    node.minimum = INFINITE_MINIMUM;
+                    node.maximum = INFINITE_MAXIMUM;
+                    break;
+                }
+                node.minimum = glm::min(node.minimum, primitive.minimum);
+                node.maximum = glm::max(node.maximum, primitive.maximum);
+            }
+        } else {
+            const Node& left = _nodes[node.first];
+            const Node& right = _nodes[node.first + 1];
+            node.minimum = glm::min(left.minimum, right.minimum);
+            node.maximum = glm::max(left.maximum, right.maximum);
+        }
+    }
+}
+
+float EntityTreeBVH::computeCost() const {
+    // relative SAH cost: only compared against the cost at the last rebuild
+    float cost = 0.0f;
+    for (const auto& node : _nodes) {
+        cost += surfaceArea(node.minimum, node.maximum) * (node.count > 0 ? (float)node.count : 1.0f);
+    }
+    return cost;
+}
+
+template <typename NodeTest, typename F>
+void EntityTreeBVH::forEachCandidate(NodeTest nodeTest, F f) const {
+    auto visitPrimitive = [&](uint32_t index) {
+        const Primitive& primitive = _primitives[index];
+        if (primitive.removed || (primitive.hasBounds && !nodeTest(primitive.minimum, primitive.maximum))) {
+            return;
+        }
+        EntityItemPointer entity = primitive.entity.lock();
+        if (entity) {
+            f(entity);
+        }
+    };
+
+    if (!_nodes.empty()) {
+        const int MIN_STACK_DEPTH = 64;
+        std::vector<uint32_t> stack;
+        stack.reserve(MIN_STACK_DEPTH);
+        stack.push_back(0);
+        while (!stack.empty()) {
+            const Node& node = _nodes[stack.back()];
+            stack.pop_back();
+            if (!nodeTest(node.minimum, node.maximum)) {
+                continue;
+            }
+            if (node.count > 0) {
+                for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                    visitPrimitive(_primitiveIndices[i]);
+                }
+            } else {
+                stack.push_back(node.first + 1);
+                stack.push_back(node.first);
+            }
+        }
+    }
+    for (auto index : _unindexed) {
+        visitPrimitive(index);
+    }
+    for (auto index : _unbounded) {
+        visitPrimitive(index);
+    }
+}
+
+EntityItemPointer EntityTreeBVH::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
+        const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard,
+        bool visibleOnly, bool collidableOnly, bool precisionPicking,
+        OctreeElementPointer& element, float& distance, BoxFace& face, glm::vec3& surfaceNormal,
+        QVariantMap& extraInfo) {
+    sync();
+
+    // avoid 0 * inf in the slab test when the origin lies on a box face
+    glm::vec3 safeDirection;
+    for (int i = 0; i < 3; ++i) {
+        safeDirection[i] = fabsf(direction[i]) < EPSILON ? (direction[i] < 0.0f ? -EPSILON : EPSILON) : direction[i];
+    }
+    glm::vec3 inverseDirection = 1.0f / safeDirection;
+
+    EntityItemPointer result;
+    withReadLock([&] {
+        auto rayTest = [&](const glm::vec3& minimum, const glm::vec3& maximum) {
+            if (!glm::all(glm::lessThanEqual(minimum, maximum))) {
+                return false; // empty box
+            }
+            glm::vec3 t0 = (minimum - origin) * inverseDirection;
+            glm::vec3 t1 = (maximum - origin) * inverseDirection;
+            glm::vec3 tNear = glm::min(t0, t1);
+            glm::vec3 tFar = glm::max(t0, t1);
+            float enter = glm::max(glm::max(tNear.x, tNear.y), tNear.z);
+            float exit = glm::min(glm::min(tFar.x, tFar.y), tFar.z);
+            // nothing inside a box that starts beyond the best hit can be closer
+            return enter <= exit && exit >= 0.0f && enter <= distance;
+        };
+
+        forEachCandidate(rayTest, [&](const EntityItemPointer& entity) {
+            // use simple line-sphere for broadphase check, as EntityTreeElement does
+            bool success;
+            AABox entityBox = entity->getAABox(success);
+            if (!success || !entityBox.rayHitsBoundingSphere(origin, direction)) {
+                return;
+            }
+            if (!EntityTreeElement::entityPassesRayFilter(entity, entityIdsToInclude, entityIdsToDiscard,
+                    visibleOnly, collidableOnly)) {
+                return;
+            }
+            OctreeElementPointer entityElement = entity->getElement();
+            QVariantMap localExtraInfo;
+            if (EntityTreeElement::findEntityRayIntersection(entity, origin, direction, entityElement, distance,
+                    face, surfaceNormal, localExtraInfo, precisionPicking)) {
+                element = entityElement;
+                extraInfo = localExtraInfo;
+                result = entity;
+            }
+        });
+    });
+    return result;
+}
+
+EntityItemPointer EntityTreeBVH::findClosestEntity(const glm::vec3& position, float targetRadius) {
+    sync();
+    EntityItemPointer closestEntity;
+    float closestDistance = targetRadius;
+    withReadLock([&] {
+        forEachCandidate([&](const glm::vec3& minimum, const glm::vec3& maximum) {
+            return distanceSquaredToBox(position, minimum, maximum) <= closestDistance * closestDistance;
+        }, [&](const EntityItemPointer& entity) {
+            float distance = glm::distance(entity->getWorldPosition(), position);
+            if (distance <= closestDistance) {
+                closestDistance = distance;
+                closestEntity = entity;
+            }
+        });
+    });
+    return closestEntity;
+}
+
+void EntityTreeBVH::findEntities(const glm::vec3& center, float radius, QVector<EntityItemPointer>& foundEntities) {
+    sync();
+    foundEntities.clear();
+    withReadLock([&] {
+        forEachCandidate([&](const glm::vec3& minimum, const glm::vec3& maximum) {
+            return distanceSquaredToBox(center, minimum, maximum) <= radius * radius;
+        }, [&](const EntityItemPointer& entity) {
+            if (EntityTreeElement::entityTouchesSphere(entity, center, radius)) {
+                foundEntities.push_back(entity);
+            }
+        });
+    });
+}
+
+void EntityTreeBVH::findEntities(const AACube& cube, QVector<EntityItemPointer>& foundEntities) {
+    sync();
+    foundEntities.clear();
+    glm::vec3 queryMinimum = cube.getMinimumPoint();
+    glm::vec3 queryMaximum = cube.getMaximumPoint();
+    withReadLock([&] {
+        forEachCandidate([&](const glm::vec3& minimum, const glm::vec3& maximum) {
+            return boxesOverlap(minimum, maximum, queryMinimum, queryMaximum);
+        }, [&](const EntityItemPointer& entity) {
+            bool success;
+            AABox entityBox = entity->getAABox(success);
+            // If the entities AABox touches the search cube then consider it to be found
+            if (!success || entityBox.touches(cube)) {
+                foundEntities.push_back(entity);
+            }
+        });
+    });
+}
+
+void EntityTreeBVH::findEntities(const AABox& box, QVector<EntityItemPointer>& foundEntities) {
+    sync();
+    foundEntities.clear();
+    glm::vec3 queryMinimum = box.getMinimumPoint();
+    glm::vec3 queryMaximum = box.getMaximumPoint();
+    withReadLock([&] {
+        forEachCandidate([&](const glm::vec3& minimum, const glm::vec3& maximum) {
+            return boxesOverlap(minimum, maximum, queryMinimum, queryMaximum);
+        }, [&](const EntityItemPointer& entity) {
+            bool success;
+            AABox entityBox = entity->getAABox(success);
+            // If the entities AABox touches the search box then consider it to be found
+            if (!success || entityBox.touches(box)) {
+                foundEntities.push_back(entity);
+            }
+        });
+    });
+}
+
+void EntityTreeBVH::findEntities(const ViewFrustum& frustum, QVector<EntityItemPointer>& foundEntities) {
+    sync();
+    foundEntities.clear();
+    withReadLock([&] {
+        forEachCandidate([&](const glm::vec3& minimum, const glm::vec3& maximum) {
+            if (!isFinite(minimum, maximum)) {
+                return glm::all(glm::lessThanEqual(minimum, maximum));
+            }
+            AABox nodeBox(minimum, maximum - minimum);
+            return frustum.boxIntersectsFrustum(nodeBox) || frustum.boxIntersectsKeyhole(nodeBox);
+        }, [&](const EntityItemPointer& entity) {
+            bool success;
+            AABox entityBox = entity->getAABox(success);
+            if (!success || frustum.boxIntersectsFrustum(entityBox) || frustum.boxIntersectsKeyhole(entityBox)) {
+                foundEntities.push_back(entity);
+            }
+        });
+    });
+}
@@ -0,0 +1,127 @@
+//
+//  EntityTreeBVH.h
+//  libraries/entities/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeBVH_h
+#define hifi_EntityTreeBVH_h
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <AABox.h>
+#include <shared/ReadWriteLockable.h>
+
+#include "EntityItem.h"
+
+class ViewFrustum;
+
+// EntityTreeBVH is a flat bounding volume hierarchy over entity AABoxes used to answer the spatial queries of
+// the EntityTree (ray picks, sphere/box/frustum searches, closest entity) without walking the octree and taking
+// a lock per element.  The octree remains the authority for membership and networking: the tree forwards
+// adds, removes and bounds changes here and the BVH folds them in lazily on the next query.
+//
+// Changed bounds are handled by refitting the node boxes; new entities sit in an unindexed list that is
+// scanned linearly until the next rebuild.  A full SAH rebuild happens when the refit quality has degraded,
+// when too many entities are unindexed or removed, or periodically if anything has changed.
+class EntityTreeBVH : public ReadWriteLockable {
+public:
+    static const int MAX_LEAF_SIZE;
+    static const float MAX_REFIT_COST_RATIO; // rebuild once refit SAH cost grows past this ratio of built cost
+    static const float MAX_UNINDEXED_RATIO; // rebuild once this fraction of entities are unindexed or removed
+    static const uint64_t REBUILD_PERIOD; // usec
+
+    // called by EntityTree, may be called from any thread
+    void addEntity(const EntityItemPointer& entity);
+    void removeEntity(EntityItem* entity);
+    void entityBoundsChanged(EntityItem* entity);
+    void clear();
+
+    // folds pending changes into the hierarchy, called before each query and once per EntityTree::update
+    void sync();
+
+    EntityItemPointer findRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
+        const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard,
+        bool visibleOnly, bool collidableOnly, bool precisionPicking,
+        OctreeElementPointer& element, float& distance, BoxFace& face, glm::vec3& surfaceNormal,
+        QVariantMap& extraInfo);
+    EntityItemPointer findClosestEntity(const glm::vec3& position, float targetRadius);
+    void findEntities(const glm::vec3& center, float radius, QVector<EntityItemPointer>& foundEntities);
+    void findEntities(const AACube& cube, QVector<EntityItemPointer>& foundEntities);
+    void findEntities(const AABox& box, QVector<EntityItemPointer>& foundEntities);
+    void findEntities(const ViewFrustum& frustum, QVector<EntityItemPointer>& foundEntities);
+
+    size_t getNumIndexedEntities() const { return _numIndexed; }
+    size_t getNumRebuilds() const { return _numRebuilds; }
+
+private:
+    class Primitive {
+    public:
+        EntityItemWeakPointer entity;
+        EntityItem* rawEntity { nullptr };
+        glm::vec3 minimum;
+        glm::vec3 maximum;
+        bool hasBounds { false }; // false when the entity's AABox is unknown (e.g. parent not yet known)
+        bool removed { false };
+    };
+
+    class Node {
+    public:
+        glm::vec3 minimum;
+        glm::vec3 maximum;
+        uint32_t first { 0 }; // index of left child for interior nodes, first primitive index for leaves
+        uint32_t count { 0 }; // number of primitives, zero for interior nodes
+    };
+
+    class PendingChange {
+    public:
+        EntityItemWeakPointer entity;
+        EntityItem* rawEntity { nullptr };
+        bool add { true };
+    };
+
+    void applyPendingChanges(uint64_t now);
+    void updatePrimitiveBounds(Primitive& primitive);
+    void rebuild();
+    void buildNode(uint32_t nodeIndex, uint32_t first, uint32_t count, std::vector<glm::vec3>& centroids);
+    void refit();
+    float computeCost() const;
+
+    // visits the live entities of every primitive whose box passes nodeTest, and all primitives without bounds
+    template <typename NodeTest, typename F>
+    void forEachCandidate(NodeTest nodeTest, F f) const;
+
+    // pending changes from the EntityTree, guarded by _pendingMutex rather than the hierarchy lock
+    std::mutex _pendingMutex;
+    std::vector<PendingChange> _pendingChanges;
+    std::unordered_set<EntityItem*> _pendingBounds;
+    bool _clearPending { false };
+    std::atomic<bool> _hasPending { false };
+
+    // the hierarchy, guarded by the ReadWriteLockable lock
+    std::vector<Primitive> _primitives;
+    std::vector<uint32_t> _primitiveIndices; // leaves reference ranges of this array
+    std::vector<Node> _nodes;
+    std::vector<uint32_t> _unindexed; // primitives added since the last rebuild
+    std::vector<uint32_t> _unbounded; // indexed primitives that have no bounds
+    std::unordered_map<EntityItem*, uint32_t> _primitiveMap;
+
+    size_t _numIndexed { 0 };
+    size_t _numRemoved { 0 };
+    size_t _numRebuilds { 0 };
+    float _builtCost { 0.0f };
+    bool _changedSinceRebuild { false };
+    uint64_t _lastRebuild { 0 };
+};
+
+using EntityTreeBVHPointer = std::shared_ptr<EntityTreeBVH>;
+
+#endif // hifi_EntityTreeBVH_h
@@ -635,7 +635,6 @@ EntityItemID EntityTreeElement::findDetailedRayIntersection(const glm::vec3& ori
                                     bool visibleOnly, bool collidableOnly, QVariantMap& extraInfo, bool precisionPicking) {
 
     // only called if we do intersect our bounding cube, but find if we actually intersect with entities...
-    int entityNumber = 0;
     EntityItemID entityID;
     forEachEntity([&](EntityItemPointer entity) {
         // use simple line-sphere for broadphase check
@@ -649,65 +648,80 @@ EntityItemID EntityTreeElement::findDetailedRayIntersection(const glm::vec3& ori
             return;
         }
 
-        // check RayPick filter settings
-        if ((visibleOnly && !entity->isVisible())
-                || (collidableOnly && (entity->getCollisionless() || entity->getShapeType() == SHAPE_TYPE_NONE))
-                || (entityIdsToInclude.size() > 0 && !entityIdsToInclude.contains(entity->getID()))
-                || (entityIDsToDiscard.size() > 0 && entityIDsToDiscard.contains(entity->getID())) ) {
+        if (!entityPassesRayFilter(entity, entityIdsToInclude, entityIDsToDiscard, visibleOnly, collidableOnly)) {
             return;
         }
 
-        // extents is the entity relative, scaled, centered extents of the entity
-        glm::mat4 rotation = glm::mat4_cast(entity->getWorldOrientation());
-        glm::mat4 translation = glm::translate(entity->getWorldPosition());
-        glm::mat4 entityToWorldMatrix = translation * rotation;
-        glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+        if (findEntityRayIntersection(entity, origin, direction, element, distance, face, surfaceNormal,
+                extraInfo, precisionPicking)) {
+            entityID = entity->getEntityItemID();
+        }
+    });
+    return entityID;
+}
 
-        glm::vec3 dimensions = entity->getScaledDimensions();
-        glm::vec3 registrationPoint = entity->getRegistrationPoint();
-        glm::vec3 corner = -(dimensions * registrationPoint);
-
-        AABox entityFrameBox(corner, dimensions);
-
-        glm::vec3 entityFrameOrigin = glm::vec3(worldToEntityMatrix * glm::vec4(origin, 1.0f));
-        glm::vec3 entityFrameDirection = glm::vec3(worldToEntityMatrix * glm::vec4(direction, 0.0f));
-
-        // we can use the AABox's ray intersection by mapping our origin and direction into the entity frame
-        // and testing intersection there.
-        float localDistance;
-        BoxFace localFace;
-        glm::vec3 localSurfaceNormal;
-        if (entityFrameBox.findRayIntersection(entityFrameOrigin, entityFrameDirection, localDistance,
-                                                localFace, localSurfaceNormal)) {
-            if (entityFrameBox.contains(entityFrameOrigin) || localDistance < distance) {
-                // now ask the entity if we actually intersect
-                if (entity->supportsDetailedRayIntersection()) {
-                    QVariantMap localExtraInfo;
-                    if (entity->findDetailedRayIntersection(origin, direction, element, localDistance,
-                            localFace, localSurfaceNormal, localExtraInfo, precisionPicking)) {
-                        if (localDistance < distance) {
-                            distance = localDistance;
-                            face = localFace;
-                            surfaceNormal = localSurfaceNormal;
-                            extraInfo = localExtraInfo;
-                            entityID = entity->getEntityItemID();
-                        }
-                    }
-                } else {
-                    // if the entity type doesn't support a detailed intersection, then just return the non-AABox results
-                    // Never intersect with particle entities
-                    if (localDistance < distance && entity->getType() != EntityTypes::ParticleEffect) {
+bool EntityTreeElement::entityPassesRayFilter(const EntityItemPointer& entity, const QVector<EntityItemID>& entityIdsToInclude,
+                                    const QVector<EntityItemID>& entityIDsToDiscard, bool visibleOnly, bool collidableOnly) {
+    // check RayPick filter settings
+    return !((visibleOnly && !entity->isVisible())
+            || (collidableOnly && (entity->getCollisionless() || entity->getShapeType() == SHAPE_TYPE_NONE))
+            || (entityIdsToInclude.size() > 0 && !entityIdsToInclude.contains(entity->getID()))
+            || (entityIDsToDiscard.size() > 0 && entityIDsToDiscard.contains(entity->getID())));
+}
+
+// returns true and updates the outputs when the ray hits the entity closer than distance
+bool EntityTreeElement::findEntityRayIntersection(const EntityItemPointer& entity, const glm::vec3& origin,
+                                    const glm::vec3& direction, OctreeElementPointer& element, float& distance,
+                                    BoxFace& face, glm::vec3& surfaceNormal, QVariantMap& extraInfo, bool precisionPicking) {
+    // extents is the entity relative, scaled, centered extents of the entity
+    glm::mat4 rotation = glm::mat4_cast(entity->getWorldOrientation());
+    glm::mat4 translation = glm::translate(entity->getWorldPosition());
+    glm::mat4 entityToWorldMatrix = translation * rotation;
+    glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+
+    glm::vec3 dimensions = entity->getScaledDimensions();
+    glm::vec3 registrationPoint = entity->getRegistrationPoint();
+    glm::vec3 corner = -(dimensions * registrationPoint);
+
+    AABox entityFrameBox(corner, dimensions);
+
+    glm::vec3 entityFrameOrigin = glm::vec3(worldToEntityMatrix * glm::vec4(origin, 1.0f));
+    glm::vec3 entityFrameDirection = glm::vec3(worldToEntityMatrix * glm::vec4(direction, 0.0f));
+
+    // we can use the AABox's ray intersection by mapping our origin and direction into the entity frame
+    // and testing intersection there.
+    float localDistance;
+    BoxFace localFace;
+    glm::vec3 localSurfaceNormal;
+    if (entityFrameBox.findRayIntersection(entityFrameOrigin, entityFrameDirection, localDistance,
+                                            localFace, localSurfaceNormal)) {
+        if (entityFrameBox.contains(entityFrameOrigin) || localDistance < distance) {
+            // now ask the entity if we actually intersect
+            if (entity->supportsDetailedRayIntersection()) {
+                QVariantMap localExtraInfo;
+                if (entity->findDetailedRayIntersection(origin, direction, element, localDistance,
+                        localFace, localSurfaceNormal, localExtraInfo, precisionPicking)) {
+                    if (localDistance < distance) {
                         distance = localDistance;
                         face = localFace;
-                        surfaceNormal = glm::vec3(rotation * glm::vec4(localSurfaceNormal, 1.0f));
-                        entityID = entity->getEntityItemID();
+                        surfaceNormal = localSurfaceNormal;
+                        extraInfo = localExtraInfo;
+                        return true;
                     }
                 }
+            } else {
+                // if the entity type doesn't support a detailed intersection, then just return the non-AABox results
+                // Never intersect with particle entities
+                if (localDistance < distance && entity->getType() != EntityTypes::ParticleEffect) {
+                    distance = localDistance;
+                    face = localFace;
+                    surfaceNormal = glm::vec3(rotation * glm::vec4(localSurfaceNormal, 1.0f));
+                    return true;
+                }
             }
         }
-        entityNumber++;
-    });
-    return entityID;
+    }
+    return false;
 }
 
 // TODO: change this to use better bounding shape for entity than sphere
@@ -753,55 +767,57 @@ EntityItemPointer EntityTreeElement::getClosestEntity(glm::vec3 position) const
 // TODO: change this to use better bounding shape for entity than sphere
 void EntityTreeElement::getEntities(const glm::vec3& searchPosition, float searchRadius, QVector<EntityItemPointer>& foundEntities) const {
     forEachEntity([&](EntityItemPointer entity) {
+        if (entityTouchesSphere(entity, searchPosition, searchRadius)) {
+            foundEntities.push_back(entity);
+        }
+    });
+}
 
-        bool success;
-        AABox entityBox = entity->getAABox(success);
+bool EntityTreeElement::entityTouchesSphere(const EntityItemPointer& entity, const glm::vec3& searchPosition, float searchRadius) {
+    bool success;
+    AABox entityBox = entity->getAABox(success);
 
-        // if the sphere doesn't intersect with our world frame AABox, we don't need to consider the more complex case
-        glm::vec3 penetration;
-        if (!success || entityBox.findSpherePenetration(searchPosition, searchRadius, penetration)) {
-
-            glm::vec3 dimensions = entity->getScaledDimensions();
-
-            // FIXME - consider allowing the entity to determine penetration so that
-            //         entities could presumably dull actuall hull testing if they wanted to
-            // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
-            //         can we handle the ellipsoid case better? We only currently handle perfect spheres
-            //         with centered registration points
-            if (entity->getShapeType() == SHAPE_TYPE_SPHERE &&
-                (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
-
-                // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
-                //       maximum bounding sphere, which is actually larger than our actual radius
-                float entityTrueRadius = dimensions.x / 2.0f;
-
-                bool success;
-                if (findSphereSpherePenetration(searchPosition, searchRadius,
-                        entity->getCenterPosition(success), entityTrueRadius, penetration)) {
-                    if (success) {
-                        foundEntities.push_back(entity);
-                    }
-                }
-            } else {
-                // determine the worldToEntityMatrix that doesn't include scale because
-                // we're going to use the registration aware aa box in the entity frame
-                glm::mat4 rotation = glm::mat4_cast(entity->getWorldOrientation());
-                glm::mat4 translation = glm::translate(entity->getWorldPosition());
-                glm::mat4 entityToWorldMatrix = translation * rotation;
-                glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+    // if the sphere doesn't intersect with our world frame AABox, we don't need to consider the more complex case
+    glm::vec3 penetration;
+    if (!success || entityBox.findSpherePenetration(searchPosition, searchRadius, penetration)) {
+
+        glm::vec3 dimensions = entity->getScaledDimensions();
 
-                glm::vec3 registrationPoint = entity->getRegistrationPoint();
-                glm::vec3 corner = -(dimensions * registrationPoint);
+        // FIXME - consider allowing the entity to determine penetration so that
+        //         entities could presumably dull actuall hull testing if they wanted to
+        // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
+        //         can we handle the ellipsoid case better? We only currently handle perfect spheres
+        //         with centered registration points
+        if (entity->getShapeType() == SHAPE_TYPE_SPHERE &&
+            (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
 
-                AABox entityFrameBox(corner, dimensions);
+            // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
+            //       maximum bounding sphere, which is actually larger than our actual radius
+            float entityTrueRadius = dimensions.x / 2.0f;
 
-                glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(searchPosition, 1.0f));
-                if (entityFrameBox.findSpherePenetration(entityFrameSearchPosition, searchRadius, penetration)) {
-                    foundEntities.push_back(entity);
-                }
+            bool success;
+            if (findSphereSpherePenetration(searchPosition, searchRadius,
+                    entity->getCenterPosition(success), entityTrueRadius, penetration)) {
+                return success;
             }
+        } else {
+            // determine the worldToEntityMatrix that doesn't include scale because
+            // we're going to use the registration aware aa box in the entity frame
+            glm::mat4 rotation = glm::mat4_cast(entity->getWorldOrientation());
+            glm::mat4 translation = glm::translate(entity->getWorldPosition());
+            glm::mat4 entityToWorldMatrix = translation * rotation;
+            glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+
+            glm::vec3 registrationPoint = entity->getRegistrationPoint();
+            glm::vec3 corner = -(dimensions * registrationPoint);
+
+            AABox entityFrameBox(corner, dimensions);
+
+            glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(searchPosition, 1.0f));
+            return entityFrameBox.findSpherePenetration(entityFrameSearchPosition, searchRadius, penetration);
         }
-    });
+    }
+    return false;
 }
 
 void EntityTreeElement::getEntities(const AACube& cube, QVector<EntityItemPointer>& foundEntities) {
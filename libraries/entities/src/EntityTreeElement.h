@@ -159,6 +159,14 @@ public:
     virtual bool findSpherePenetration(const glm::vec3& center, float radius,
                         glm::vec3& penetration, void** penetratedObject) const override;
 
+    // per-entity tests shared by the element searches and the EntityTreeBVH
+    static bool entityPassesRayFilter(const EntityItemPointer& entity, const QVector<EntityItemID>& entityIdsToInclude,
+                         const QVector<EntityItemID>& entityIdsToDiscard, bool visibleOnly, bool collidableOnly);
+    static bool findEntityRayIntersection(const EntityItemPointer& entity, const glm::vec3& origin, const glm::vec3& direction,
+                         OctreeElementPointer& element, float& distance, BoxFace& face, glm::vec3& surfaceNormal,
+                         QVariantMap& extraInfo, bool precisionPicking);
+    static bool entityTouchesSphere(const EntityItemPointer& entity, const glm::vec3& searchPosition, float searchRadius);
+
 
     template <typename F>
     void forEachEntity(F f) const {
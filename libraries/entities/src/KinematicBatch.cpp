@@ -0,0 +1,213 @@
+//
+//  KinematicBatch.cpp
+//  libraries/entities/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "KinematicBatch.h"
+
+#include <glm/gtx/norm.hpp>
+
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <PhysicsHelpers.h>
+#include <Profile.h>
+
+#include "EntityItem.h"
+#include "EntitiesLogging.h"
+
+void KinematicBatch::clear() {
+    _entities.clear();
+    _transforms.clear();
+    _timeSteps.clear();
+    _positionX.clear();
+    _positionY.clear();
+    _positionZ.clear();
+    _velocityX.clear();
+    _velocityY.clear();
+    _velocityZ.clear();
+    _accelerationX.clear();
+    _accelerationY.clear();
+    _accelerationZ.clear();
+    _dampingFactors.clear();
+    _hasAcceleration.clear();
+    _angularVelocities.clear();
+    _angularDampings.clear();
+}
+
+void KinematicBatch::reserve(int numEntities) {
+    _entities.reserve(numEntities);
+    _transforms.reserve(numEntities);
+    _timeSteps.reserve(numEntities);
+    _positionX.reserve(numEntities);
+    _positionY.reserve(numEntities);
+    _positionZ.reserve(numEntities);
+    _velocityX.reserve(numEntities);
+    _velocityY.reserve(numEntities);
+    _velocityZ.reserve(numEntities);
+    _accelerationX.reserve(numEntities);
+    _accelerationY.reserve(numEntities);
+    _accelerationZ.reserve(numEntities);
+    _dampingFactors.reserve(numEntities);
+    _hasAcceleration.reserve(numEntities);
+    _angularVelocities.reserve(numEntities);
+    _angularDampings.reserve(numEntities);
+}
+
+void KinematicBatch::add(const EntityItemPointer& entity, uint64_t now) {
+    uint64_t lastSimulated = entity->getLastSimulated();
+    if (lastSimulated == 0) {
+        lastSimulated = now;
+    }
+    float timeElapsed = (float)(now - lastSimulated) / (float)(USECS_PER_SECOND);
+
+    Transform transform;
+    glm::vec3 linearVelocity;
+    glm::vec3 angularVelocity;
+    entity->getLocalTransformAndVelocities(transform, linearVelocity, angularVelocity);
+
+    bool moving = glm::length2(linearVelocity) > 0.0f || glm::length2(angularVelocity) > 0.0f;
+    if (!moving) {
+        // flag it to transition from KINEMATIC to STATIC
+        entity->markDirtyFlags(Simulation::DIRTY_MOTION_TYPE);
+        entity->setAcceleration(Vectors::ZERO);
+        entity->setLastSimulated(now);
+        return;
+    }
+    if (timeElapsed <= 0.0f) {
+        // nothing to integrate but it is still moving
+        entity->setLastSimulated(now);
+        return;
+    }
+
+    const float MAX_TIME_ELAPSED = 1.0f; // seconds
+    if (timeElapsed > MAX_TIME_ELAPSED) {
+        qCWarning(entities) << "kinematic timestep = " << timeElapsed << " truncated to " << MAX_TIME_ELAPSED;
+        timeElapsed = MAX_TIME_ELAPSED;
+    }
+
+    // acceleration is in world-frame but we integrate in local-frame
+    const float MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED = 1.0e-4f; // 0.01 m/sec^2
+    glm::vec3 acceleration = entity->getAcceleration();
+    bool hasAcceleration = glm::length2(acceleration) > MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED;
+    if (hasAcceleration) {
+        bool success;
+        Transform parentTransform = entity->getParentTransform(success);
+        if (success) {
+            acceleration = glm::inverse(parentTransform.getRotation()) * acceleration;
+        }
+    } else {
+        acceleration = Vectors::ZERO;
+    }
+
+    glm::vec3 position = transform.getTranslation();
+    _entities.push_back(entity);
+    _transforms.push_back(transform);
+    _timeSteps.push_back(timeElapsed);
+    _positionX.push_back(position.x);
+    _positionY.push_back(position.y);
+    _positionZ.push_back(position.z);
+    _velocityX.push_back(linearVelocity.x);
+    _velocityY.push_back(linearVelocity.y);
+    _velocityZ.push_back(linearVelocity.z);
+    _accelerationX.push_back(acceleration.x);
+    _accelerationY.push_back(acceleration.y);
+    _accelerationZ.push_back(acceleration.z);
+    // zero damping gives a factor of exactly zero
+    _dampingFactors.push_back(powf(1.0f - entity->getDamping(), timeElapsed) - 1.0f);
+    _hasAcceleration.push_back(hasAcceleration ? 1 : 0);
+    _angularVelocities.push_back(angularVelocity);
+    _angularDampings.push_back(entity->getAngularDamping());
+}
+
+void KinematicBatch::integrate() {
+    PROFILE_RANGE_EX(simulation_physics, "IntegrateKinematics", 0xffff00ff, (uint64_t)_entities.size());
+    const int numEntities = size();
+
+    // linear motion
+    const float MIN_KINEMATIC_LINEAR_SPEED_SQUARED =
+        KINEMATIC_LINEAR_SPEED_THRESHOLD * KINEMATIC_LINEAR_SPEED_THRESHOLD;
+    float* positionX = _positionX.data();
+    float* positionY = _positionY.data();
+    float* positionZ = _positionZ.data();
+    float* velocityX = _velocityX.data();
+    float* velocityY = _velocityY.data();
+    float* velocityZ = _velocityZ.data();
+    const float* accelerationX = _accelerationX.data();
+    const float* accelerationY = _accelerationY.data();
+    const float* accelerationZ = _accelerationZ.data();
+    const float* dampingFactors = _dampingFactors.data();
+    const float* timeSteps = _timeSteps.data();
+    const uint8_t* hasAcceleration = _hasAcceleration.data();
+    for (int i = 0; i < numEntities; ++i) {
+        float dt = timeSteps[i];
+        float vx = velocityX[i];
+        float vy = velocityY[i];
+        float vz = velocityZ[i];
+        float dvx = dampingFactors[i] * vx + accelerationX[i] * dt;
+        float dvy = dampingFactors[i] * vy + accelerationY[i] * dt;
+        float dvz = dampingFactors[i] * vz + accelerationZ[i] * dt;
+
+        float speedSquared = vx * vx + vy * vy + vz * vz;
+        float deltaSquared = dvx * dvx + dvy * dvy + dvz * dvz;
+        float nextSpeedSquared = (vx + dvx) * (vx + dvx) + (vy + dvy) * (vy + dvy) + (vz + dvz) * (vz + dvz);
+
+        // an entity that isn't translating is left alone, a slow one is stopped, the rest advance
+        // (with no second-order acceleration term for displacement because Bullet doesn't use it)
+        bool translating = speedSquared > 0.0f;
+        bool slow = speedSquared < MIN_KINEMATIC_LINEAR_SPEED_SQUARED;
+        bool stop = slow && (!hasAcceleration[i] ||
+            (deltaSquared < MIN_KINEMATIC_LINEAR_SPEED_SQUARED && nextSpeedSquared < MIN_KINEMATIC_LINEAR_SPEED_SQUARED));
+        float advance = (translating && !stop) ? 1.0f : 0.0f;
+        float keep = (translating && stop) ? 0.0f : 1.0f;
+
+        positionX[i] += advance * dt * vx;
+        positionY[i] += advance * dt * vy;
+        positionZ[i] += advance * dt * vz;
+        velocityX[i] = keep * (vx + advance * dvx);
+        velocityY[i] = keep * (vy + advance * dvy);
+        velocityZ[i] = keep * (vz + advance * dvz);
+    }
+
+    // angular motion
+    const float MIN_KINEMATIC_ANGULAR_SPEED_SQUARED =
+        KINEMATIC_ANGULAR_SPEED_THRESHOLD * KINEMATIC_ANGULAR_SPEED_THRESHOLD;
+    for (int i = 0; i < numEntities; ++i) {
+        glm::vec3& angularVelocity = _angularVelocities[i];
+        if (glm::length2(angularVelocity) == 0.0f) {
+            continue;
+        }
+        float timeElapsed = _timeSteps[i];
+        if (_angularDampings[i] > 0.0f) {
+            angularVelocity *= powf(1.0f - _angularDampings[i], timeElapsed);
+        }
+        if (glm::length2(angularVelocity) < MIN_KINEMATIC_ANGULAR_SPEED_SQUARED) {
+            angularVelocity = Vectors::ZERO;
+        } else {
+            // break the integration into bullet-sized substeps, as in EntityItem::stepKinematicMotion()
+            glm::quat rotation = _transforms[i].getRotation();
+            float dt = timeElapsed;
+            while (dt > 0.0f) {
+                glm::quat dQ = computeBulletRotationStep(angularVelocity, glm::min(dt, PHYSICS_ENGINE_FIXED_SUBSTEP));
+                rotation = glm::normalize(dQ * rotation);
+                dt -= PHYSICS_ENGINE_FIXED_SUBSTEP;
+            }
+            _transforms[i].setRotation(rotation);
+        }
+    }
+}
+
+void KinematicBatch::apply(uint64_t now) {
+    const int numEntities = size();
+    for (int i = 0; i < numEntities; ++i) {
+        Transform& transform = _transforms[i];
+        transform.setTranslation(glm::vec3(_positionX[i], _positionY[i], _positionZ[i]));
+        glm::vec3 linearVelocity(_velocityX[i], _velocityY[i], _velocityZ[i]);
+        _entities[i]->setLocalTransformAndVelocities(transform, linearVelocity, _angularVelocities[i]);
+        _entities[i]->setLastSimulated(now);
+    }
+}
@@ -0,0 +1,58 @@
+//
+//  KinematicBatch.h
+//  libraries/entities/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_KinematicBatch_h
+#define hifi_KinematicBatch_h
+
+#include <vector>
+
+#include <Transform.h>
+
+#include "EntityTypes.h"
+
+// KinematicBatch steps many simple kinematic entities at once.  It is equivalent to calling
+// EntityItem::stepKinematicMotion() on each of them, but the per-entity state is gathered into structure-of-arrays
+// form first so the linear integration runs as one branch-free loop over contiguous floats that the compiler
+// can vectorize; only spinning entities take the scalar rotation path.
+//
+// NOTE: the integration mirrors EntityItem::stepKinematicMotion() and must be kept in sync with it.
+class KinematicBatch {
+public:
+    void clear();
+    void reserve(int numEntities);
+    int size() const { return (int)_entities.size(); }
+
+    // gathers the local motion of entity for a step ending at now
+    // an entity that has stopped moving is flagged for a motion type change right away and is not added
+    void add(const EntityItemPointer& entity, uint64_t now);
+
+    void integrate();
+
+    // writes the integrated motion back to the entities and marks them simulated at now
+    void apply(uint64_t now);
+
+private:
+    std::vector<EntityItemPointer> _entities;
+    std::vector<Transform> _transforms;
+    std::vector<float> _timeSteps;
+
+    // linear state, local frame
+    std::vector<float> _positionX, _positionY, _positionZ;
+    std::vector<float> _velocityX, _velocityY, _velocityZ;
+    std::vector<float> _accelerationX, _accelerationY, _accelerationZ; // zero when below threshold
+    std::vector<float> _dampingFactors; // velocity change per unit velocity due to damping over the step
+    std::vector<uint8_t> _hasAcceleration;
+
+    // angular state, local frame
+    std::vector<glm::vec3> _angularVelocities;
+    std::vector<float> _angularDampings;
+};
+
+#endif // hifi_KinematicBatch_h
@@ -0,0 +1,82 @@
+//
+//  MortalEntityWheel.cpp
+//  libraries/entities/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MortalEntityWheel.h"
+
+#include <algorithm>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+const uint64_t MortalEntityWheel::RESOLUTION = USECS_PER_SECOND / 10;
+const int MortalEntityWheel::NUM_SLOTS = 1024; // ~100 seconds per revolution
+
+MortalEntityWheel::MortalEntityWheel() :
+    _slots(NUM_SLOTS),
+    _nextTick(usecTimestampNow() / RESOLUTION)
+{
+}
+
+void MortalEntityWheel::insert(const EntityItemPointer& entity, uint64_t expiry) {
+    Scheduled& scheduled = _schedule[entity.get()];
+    if (scheduled.entity && scheduled.expiry == expiry) {
+        return;
+    }
+    scheduled.entity = entity;
+    scheduled.expiry = expiry;
+
+    // expiries that are already due go in the next slot to be visited
+    uint64_t tick = std::max(expiry / RESOLUTION, _nextTick);
+    _slots[tick % NUM_SLOTS].push_back({ entity.get(), expiry });
+}
+
+void MortalEntityWheel::remove(const EntityItemPointer& entity) {
+    // the slot entry is dropped lazily
+    _schedule.erase(entity.get());
+}
+
+void MortalEntityWheel::clear() {
+    for (auto& slot : _slots) {
+        slot.clear();
+    }
+    _schedule.clear();
+}
+
+void MortalEntityWheel::takeExpired(uint64_t now, QVector<EntityItemPointer>& expired) {
+    // only slots whose whole interval is before now are visited, so every entry found due there has expired
+    uint64_t nowTick = now / RESOLUTION;
+    if (nowTick <= _nextTick) {
+        return;
+    }
+    // after a long stall one revolution visits every slot
+    uint64_t firstTick = nowTick > (uint64_t)NUM_SLOTS ? std::max(_nextTick, nowTick - NUM_SLOTS) : _nextTick;
+    for (uint64_t tick = firstTick; tick < nowTick; ++tick) {
+        std::vector<SlotEntry>& slot = _slots[tick % NUM_SLOTS];
+        size_t i = 0;
+        while (i < slot.size()) {
+            const SlotEntry& entry = slot[i];
+            auto itr = _schedule.find(entry.entity);
+            bool stale = itr == _schedule.end() || itr->second.expiry != entry.expiry;
+            bool due = !stale && entry.expiry / RESOLUTION < nowTick;
+            if (stale || due) {
+                if (due) {
+                    expired.push_back(itr->second.entity);
+                    _schedule.erase(itr);
+                }
+                slot[i] = slot.back();
+                slot.pop_back();
+            } else {
+                // belongs to a later revolution
+                ++i;
+            }
+        }
+    }
+    _nextTick = nowTick;
+}
@@ -0,0 +1,65 @@
+//
+//  MortalEntityWheel.h
+//  libraries/entities/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MortalEntityWheel_h
+#define hifi_MortalEntityWheel_h
+
+#include <unordered_map>
+#include <vector>
+
+#include <QVector>
+
+#include "EntityTypes.h"
+
+// MortalEntityWheel is a hashed timing wheel of entity expiries.  Each slot covers RESOLUTION usecs and
+// the wheel wraps every NUM_SLOTS slots; expiries further out than one revolution stay in their slot and
+// are skipped until their round comes up.  Advancing the wheel only visits the slots that have elapsed
+// since the last call, so the cost of expiring entities no longer depends on how many are still alive.
+//
+// Rescheduling or removing an entity leaves its old slot entry behind; stale entries are recognized by
+// comparing against the current schedule and dropped when their slot is next visited.
+class MortalEntityWheel {
+public:
+    static const uint64_t RESOLUTION; // usec per slot
+    static const int NUM_SLOTS;
+
+    MortalEntityWheel();
+
+    // schedules entity to expire at expiry, replacing any earlier schedule
+    void insert(const EntityItemPointer& entity, uint64_t expiry);
+    void remove(const EntityItemPointer& entity);
+    void clear();
+
+    bool contains(const EntityItemPointer& entity) const { return _schedule.find(entity.get()) != _schedule.end(); }
+    int size() const { return (int)_schedule.size(); }
+
+    // removes every entity whose expiry is before now and appends it to expired
+    // NOTE: expiries are resolved to the slot, so an entity may be reported up to RESOLUTION usecs late
+    void takeExpired(uint64_t now, QVector<EntityItemPointer>& expired);
+
+private:
+    class SlotEntry {
+    public:
+        EntityItem* entity;
+        uint64_t expiry;
+    };
+
+    class Scheduled {
+    public:
+        EntityItemPointer entity;
+        uint64_t expiry;
+    };
+
+    std::vector<std::vector<SlotEntry>> _slots;
+    std::unordered_map<EntityItem*, Scheduled> _schedule;
+    uint64_t _nextTick; // first tick not yet visited
+};
+
+#endif // hifi_MortalEntityWheel_h
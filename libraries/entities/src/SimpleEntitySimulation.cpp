@@ -83,9 +83,7 @@ void SimpleEntitySimulation::changeEntityInternal(EntityItemPointer entity) {
     {
         QMutexLocker lock(&_mutex);
         if (entity->isMovingRelativeToParent() && !entity->getPhysicsInfo()) {
-            int numKinematicEntities = _simpleKinematicEntities.size();
-            _simpleKinematicEntities.insert(entity);
-            if (numKinematicEntities != _simpleKinematicEntities.size()) {
+            if (_simpleKinematicEntities.insert(entity)) {
                 entity->setLastSimulated(usecTimestampNow());
             }
         } else {
@@ -116,11 +114,8 @@ void SimpleEntitySimulation::clearEntitiesInternal() {
 }
 
 void SimpleEntitySimulation::sortEntitiesThatMoved() {
-    SetOfEntities::iterator itemItr = _entitiesToSort.begin();
-    while (itemItr != _entitiesToSort.end()) {
-        EntityItemPointer entity = *itemItr;
+    for (auto& entity : _entitiesToSort) {
         entity->updateQueryAACube();
-        ++itemItr;
     }
     EntitySimulation::sortEntitiesThatMoved();
 }
@@ -0,0 +1,147 @@
+//
+//  ViewVisibilityCache.cpp
+//  libraries/entities/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ViewVisibilityCache.h"
+
+#include <NumericalConstants.h>
+#include <RegisteredMetaTypes.h>
+#include <SharedUtil.h>
+
+const float ViewVisibilityCache::DEFAULT_POSITION_QUANTUM = 0.25f;
+const float ViewVisibilityCache::DEFAULT_ORIENTATION_QUANTUM = 1.0f / 128.0f; // roughly one degree
+const uint64_t ViewVisibilityCache::ENTRY_EXPIRY = 2 * USECS_PER_SECOND;
+
+static const float RELATIVE_QUANTA_PER_UNIT = 64.0f; // log2 buckets, so ~1% relative error for scalar parameters
+
+size_t ViewVisibilityCache::KeyHasher::operator()(const Key& key) const {
+    size_t result = 0;
+    for (auto value : key.values) {
+        std::hash_combine(result, value);
+    }
+    return result;
+}
+
+size_t ViewVisibilityCache::Entry::CubeKeyHasher::operator()(const CubeKey& key) const {
+    size_t result = 0;
+    std::hash_combine(result, key.corner.x, key.corner.y, key.corner.z, key.scale);
+    return result;
+}
+
+bool ViewVisibilityCache::Entry::find(const AACube& cube, ViewFrustum::intersection& intersection) const {
+    auto itr = _classifications.find(CubeKey(cube));
+    if (itr == _classifications.end()) {
+        return false;
+    }
+    intersection = (ViewFrustum::intersection)itr->second;
+    return true;
+}
+
+void ViewVisibilityCache::Entry::insert(const AACube& cube, ViewFrustum::intersection intersection) {
+    // two threads may race to classify the same cube: they compute the same answer so the loser is dropped
+    _classifications.insert({ CubeKey(cube), (uint8_t)intersection });
+}
+
+void ViewVisibilityCache::setQuanta(float positionQuantum, float orientationQuantum) {
+    std::lock_guard<std::mutex> lock(_entriesMutex);
+    _positionQuantum = glm::max(positionQuantum, EPSILON);
+    _orientationQuantum = glm::max(orientationQuantum, EPSILON);
+    // previously computed entries were keyed with the old quanta
+    _entries.clear();
+}
+
+ViewVisibilityCache::Key ViewVisibilityCache::computeKey(const ViewFrustum& viewFrustum, float lodScaleFactor) const {
+    auto quantizeRelative = [&](float value) {
+        return (int32_t)floorf(log2f(glm::max(value, EPSILON)) * RELATIVE_QUANTA_PER_UNIT);
+    };
+
+    glm::vec3 position = viewFrustum.getPosition() / _positionQuantum;
+    glm::quat orientation = viewFrustum.getOrientation();
+    if (orientation.w < 0.0f) {
+        // q and -q describe the same rotation
+        orientation = -orientation;
+    }
+    orientation /= _orientationQuantum;
+
+    Key key;
+    key.values = {{
+        (int32_t)floorf(position.x), (int32_t)floorf(position.y), (int32_t)floorf(position.z),
+        (int32_t)floorf(orientation.x), (int32_t)floorf(orientation.y), (int32_t)floorf(orientation.z),
+        (int32_t)floorf(orientation.w),
+        quantizeRelative(viewFrustum.getFieldOfView()),
+        quantizeRelative(viewFrustum.getAspectRatio()),
+        quantizeRelative(viewFrustum.getNearClip()),
+        quantizeRelative(viewFrustum.getFarClip()),
+        quantizeRelative(viewFrustum.getCenterRadius()),
+        quantizeRelative(lodScaleFactor)
+    }};
+    return key;
+}
+
+ViewVisibilityCache::Tolerance ViewVisibilityCache::computeTolerance(const ViewFrustum& viewFrustum) const {
+    float relativeError = exp2f(1.0f / RELATIVE_QUANTA_PER_UNIT) - 1.0f;
+
+    Tolerance tolerance;
+    tolerance.position = SQUARE_ROOT_OF_3 * _positionQuantum;
+    tolerance.lodScale = relativeError;
+
+    // each quaternion component is within one quantum, so |q1 - q2| <= 2 * quantum and
+    // the angle between the orientations is 4 * asin(|q1 - q2| / 2)
+    float angle = 4.0f * asinf(glm::min(_orientationQuantum, 1.0f));
+
+    // the widest aperture in the bucket, compared to this one
+    const float MAX_HALF_FOV = glm::radians(89.0f);
+    float halfFov = 0.5f * glm::radians(viewFrustum.getFieldOfView());
+    float tanHalfFov = tanf(glm::min(halfFov, MAX_HALF_FOV));
+    float maxTanHalfFov = tanf(glm::min(halfFov * (1.0f + relativeError), MAX_HALF_FOV));
+    float aspectRatio = viewFrustum.getAspectRatio();
+    float aperture = glm::max(maxTanHalfFov - tanHalfFov,
+                              aspectRatio * ((1.0f + relativeError) * maxTanHalfFov - tanHalfFov));
+
+    // the clips and the keyhole radius only matter at distances comparable to their own
+    tolerance.slope = angle + aperture + relativeError;
+    return tolerance;
+}
+
+ViewVisibilityCache::EntryPointer ViewVisibilityCache::getEntry(const Key& key) {
+    uint64_t now = usecTimestampNow();
+    std::lock_guard<std::mutex> lock(_entriesMutex);
+    pruneStaleEntries(now);
+
+    TimestampedEntry& timestampedEntry = _entries[key];
+    if (!timestampedEntry.entry) {
+        timestampedEntry.entry = std::make_shared<Entry>();
+    }
+    timestampedEntry.lastUsed = now;
+    return timestampedEntry.entry;
+}
+
+size_t ViewVisibilityCache::getNumEntries() const {
+    std::lock_guard<std::mutex> lock(_entriesMutex);
+    return _entries.size();
+}
+
+void ViewVisibilityCache::pruneStaleEntries(uint64_t now) {
+    // NOTE: _entriesMutex must be held by caller
+    const uint64_t PRUNE_PERIOD = USECS_PER_SECOND;
+    if (now - _lastPrune < PRUNE_PERIOD) {
+        return;
+    }
+    _lastPrune = now;
+
+    auto itr = _entries.begin();
+    while (itr != _entries.end()) {
+        // an entry still referenced by a traversal is kept alive, otherwise it expires after ENTRY_EXPIRY
+        if (itr->second.entry.use_count() == 1 && now - itr->second.lastUsed > ENTRY_EXPIRY) {
+            itr = _entries.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+}
@@ -0,0 +1,117 @@
+//
+//  ViewVisibilityCache.h
+//  libraries/entities/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ViewVisibilityCache_h
+#define hifi_ViewVisibilityCache_h
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <AACube.h>
+#include <TBBHelpers.h>
+#include <ViewFrustum.h>
+
+// ViewVisibilityCache shares the per-element view classification (keyhole intersection + LOD culling)
+// between DiffTraversals whose views quantize to the same Key.  When many clients stand together
+// the frustum and LOD tests for each octree element are computed once and reused by every send thread.
+// Only classifications that hold for every view with the same Key are shared: elements near the edge of
+// the view or of the LOD range are stored as INTERSECT, and each traversal classifies those itself.
+class ViewVisibilityCache {
+public:
+    static const float DEFAULT_POSITION_QUANTUM; // meters
+    static const float DEFAULT_ORIENTATION_QUANTUM; // quaternion component units
+    static const uint64_t ENTRY_EXPIRY; // usec
+
+    // Key is the quantized form of a ViewFrustum and LOD scale
+    class Key {
+    public:
+        bool operator==(const Key& other) const { return values == other.values; }
+        std::array<int32_t, 13> values;
+    };
+
+    // Tolerance bounds how far apart two views with the same Key can be
+    class Tolerance {
+    public:
+        float position { 0.0f }; // meters between the view positions
+        float slope { 0.0f };    // meters per meter of distance from the view that the planes, clips and keyhole can move
+        float lodScale { 0.0f }; // relative difference between the LOD scale factors
+    };
+
+    class KeyHasher {
+    public:
+        size_t operator()(const Key& key) const;
+    };
+
+    // Entry holds the classifications computed so far for one quantized view.
+    // It is safe to read and write from several send threads at once.
+    class Entry {
+    public:
+        // returns true and sets intersection when the cube has already been classified for this view
+        bool find(const AACube& cube, ViewFrustum::intersection& intersection) const;
+        void insert(const AACube& cube, ViewFrustum::intersection intersection);
+        size_t size() const { return _classifications.size(); }
+
+    private:
+        class CubeKey {
+        public:
+            CubeKey(const AACube& cube) : corner(cube.getCorner()), scale(cube.getScale()) {}
+            bool operator==(const CubeKey& other) const { return corner == other.corner && scale == other.scale; }
+            glm::vec3 corner;
+            float scale;
+        };
+        class CubeKeyHasher {
+        public:
+            size_t operator()(const CubeKey& key) const;
+        };
+
+        tbb::concurrent_unordered_map<CubeKey, uint8_t, CubeKeyHasher> _classifications;
+    };
+    using EntryPointer = std::shared_ptr<Entry>;
+
+    void setQuanta(float positionQuantum, float orientationQuantum);
+
+    Key computeKey(const ViewFrustum& viewFrustum, float lodScaleFactor) const;
+    Tolerance computeTolerance(const ViewFrustum& viewFrustum) const;
+
+    // returns the Entry shared by all views that quantize to key, creating it if necessary
+    EntryPointer getEntry(const Key& key);
+
+    void recordHit() { ++_hits; }
+    void recordMiss() { ++_misses; }
+    uint64_t getHits() const { return _hits; }
+    uint64_t getMisses() const { return _misses; }
+    size_t getNumEntries() const;
+
+private:
+    class TimestampedEntry {
+    public:
+        EntryPointer entry;
+        uint64_t lastUsed { 0 };
+    };
+
+    void pruneStaleEntries(uint64_t now);
+
+    float _positionQuantum { DEFAULT_POSITION_QUANTUM };
+    float _orientationQuantum { DEFAULT_ORIENTATION_QUANTUM };
+
+    mutable std::mutex _entriesMutex;
+    std::unordered_map<Key, TimestampedEntry, KeyHasher> _entries;
+    uint64_t _lastPrune { 0 };
+
+    std::atomic<uint64_t> _hits { 0 };
+    std::atomic<uint64_t> _misses { 0 };
+};
+
+using ViewVisibilityCachePointer = std::shared_ptr<ViewVisibilityCache>;
+
+#endif // hifi_ViewVisibilityCache_h
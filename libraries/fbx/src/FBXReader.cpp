@@ -9,7 +9,9 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <atomic>
 #include <iostream>
+#include <vector>
 #include <QBuffer>
 #include <QDataStream>
 #include <QIODevice>
@@ -30,6 +32,8 @@
 #include <OctalCode.h>
 #include <gpu/Format.h>
 #include <LogHandler.h>
+#include <SharedUtil.h>
+#include <TBBHelpers.h>
 
 #include "FBXReader.h"
 #include "ModelFormatLogging.h"
@@ -41,6 +45,40 @@ using namespace std;
 
 int FBXGeometryPointerMetaTypeId = qRegisterMetaType<FBXGeometry::Pointer>();
 
+static std::atomic<bool> parallelFBXMeshProcessing { true };
+
+bool isParallelFBXMeshProcessingEnabled() {
+    return parallelFBXMeshProcessing.load();
+}
+
+void setParallelFBXMeshProcessingEnabled(bool enabled) {
+    parallelFBXMeshProcessing.store(enabled);
+}
+
+// Runs body for every mesh index in [0, count), one mesh per TBB task since their sizes vary wildly
+template <typename F>
+void forEachMesh(int count, F&& body) {
+    if (parallelFBXMeshProcessing.load()) {
+        tbb::parallel_for(tbb::blocked_range<int>(0, count, 1), [&](const tbb::blocked_range<int>& range) {
+            for (int i = range.begin(); i != range.end(); ++i) {
+                body(i);
+            }
+        });
+    } else {
+        for (int i = 0; i < count; ++i) {
+            body(i);
+        }
+    }
+}
+
+// A mesh geometry node found while indexing the objects
+class PendingMesh {
+public:
+    QString id;
+    const FBXNode* node;
+    unsigned int meshIndex;
+};
+
 QStringList FBXGeometry::getJointNames() const {
     QStringList names;
     foreach (const FBXJoint& joint, joints) {
@@ -533,6 +571,37 @@ QString getString(const QVariant& value) {
 
 typedef std::vector<glm::vec3> ShapeVertices;
 
+// What a cluster of a mesh skinned to several joints needs from the skeleton
+class ClusterSkinning {
+public:
+    const Cluster* cluster;
+    int jointIndex;
+    glm::mat4 meshToJoint;
+    float clusterScale;
+};
+
+// Everything the per vertex processing of a mesh reads from the rest of the scene, gathered beforehand so that
+// meshes can be processed in parallel, plus the joint shape points it produces
+class MeshProcessing {
+public:
+    ExtractedMesh* extracted;
+    QString modelID;
+    glm::mat4 modelTransform;
+    bool generateTangents { false };
+
+    // skinned to several clusters
+    QVector<ClusterSkinning> skinning;
+
+    // bound to a single joint
+    int jointIndex { 0 };
+    glm::mat4 meshToJoint;
+    float clusterScale { 1.0f };
+    bool hasGeometricOffset { false };
+    glm::mat4 geometricOffset;
+
+    std::vector<std::pair<int, ShapeVertices>> shapeVertices;
+};
+
 class AnimationCurve {
 public:
     QVector<float> values;
@@ -697,6 +766,7 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
     glm::vec3 ambientColor;
     QString hifiGlobalNodeID;
     unsigned int meshIndex = 0;
+    std::vector<PendingMesh> pendingMeshes;
     haveReportedUnhandledRotationOrder = false;
     foreach (const FBXNode& child, node.children) {
 
@@ -745,7 +815,8 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
             foreach (const FBXNode& object, child.children) {
                 if (object.name == "Geometry") {
                     if (object.properties.at(2) == "Mesh") {
-                        meshes.insert(getID(object.properties), extractMesh(object, meshIndex));
+                        // extracted in parallel once every object is indexed, see below
+                        pendingMeshes.push_back({ getID(object.properties), &object, meshIndex++ });
                     } else { // object.properties.at(2) == "Shape"
                         ExtractedBlendshape extracted = { getID(object.properties), extractBlendshape(object) };
                         blendshapes.append(extracted);
@@ -1435,6 +1506,18 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
 #endif
     }
 
+    // the meshes only depend on their own nodes, so they can be extracted side by side
+    quint64 meshExtractionStart = usecTimestampNow();
+    std::vector<ExtractedMesh> extractedMeshes(pendingMeshes.size());
+    forEachMesh((int)pendingMeshes.size(), [&](int i) {
+        unsigned int index = pendingMeshes[i].meshIndex;
+        extractedMeshes[i] = extractMesh(*pendingMeshes[i].node, index);
+    });
+    for (size_t i = 0; i < pendingMeshes.size(); ++i) {
+        meshes.insert(pendingMeshes[i].id, std::move(extractedMeshes[i]));
+    }
+    _meshExtractionUsecs = usecTimestampNow() - meshExtractionStart;
+
     // TODO: check if is code is needed
     if (!lights.empty()) {
         if (hifiGlobalNodeID.isEmpty()) {
@@ -1670,25 +1753,20 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
     // see if any materials have texture children
     bool materialsHaveTextures = checkMaterialsHaveTextures(_fbxMaterials, _textureFilenames, _connectionChildMap);
 
+    // The clusters update the joints as they go, so the scene graph, materials and skeleton of every mesh are
+    // resolved in order first, the per vertex work then runs for all meshes in parallel.
+    std::vector<MeshProcessing> meshProcessing;
+    meshProcessing.reserve(meshes.size());
     for (QMap<QString, ExtractedMesh>::iterator it = meshes.begin(); it != meshes.end(); it++) {
         ExtractedMesh& extracted = it.value();
-
-        extracted.mesh.meshExtents.reset();
+        MeshProcessing processing;
+        processing.extracted = &extracted;
 
         // accumulate local transforms
         QString modelID = models.contains(it.key()) ? it.key() : _connectionParentMap.value(it.key());
         glm::mat4 modelTransform = getGlobalTransform(_connectionParentMap, models, modelID, geometry.applicationName == "mixamo.com", url);
-
-        // compute the mesh extents from the transformed vertices
-        foreach (const glm::vec3& vertex, extracted.mesh.vertices) {
-            glm::vec3 transformedVertex = glm::vec3(modelTransform * glm::vec4(vertex, 1.0f));
-            geometry.meshExtents.minimum = glm::min(geometry.meshExtents.minimum, transformedVertex);
-            geometry.meshExtents.maximum = glm::max(geometry.meshExtents.maximum, transformedVertex);
-
-            extracted.mesh.meshExtents.minimum = glm::min(extracted.mesh.meshExtents.minimum, transformedVertex);
-            extracted.mesh.meshExtents.maximum = glm::max(extracted.mesh.meshExtents.maximum, transformedVertex);
-            extracted.mesh.modelTransform = modelTransform;
-        }
+        processing.modelID = modelID;
+        processing.modelTransform = modelTransform;
 
         // look for textures, material properties
         // allocate the Part material library
@@ -1726,9 +1804,7 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
                 textureIndex++;
             }
         }
-
-        extracted.mesh.createMeshTangents(generateTangents);
-        extracted.mesh.createBlendShapeTangents(generateTangents);
+        processing.generateTangents = generateTangents;
 
         // find the clusters with which the mesh is associated
         QVector<QString> clusterIDs;
@@ -1788,52 +1864,78 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
 
         // whether we're skinned depends on how many clusters are attached
         const FBXCluster& firstFBXCluster = extracted.mesh.clusters.at(0);
-        glm::mat4 inverseModelTransform = glm::inverse(modelTransform);
         if (clusterIDs.size() > 1) {
             // this is a multi-mesh joint
+            for (int i = 0; i < clusterIDs.size(); i++) {
+                const FBXCluster& fbxCluster = extracted.mesh.clusters.at(i);
+                const FBXJoint& joint = geometry.joints.at(fbxCluster.jointIndex);
+                ClusterSkinning skinning;
+                skinning.cluster = &clusters.constFind(clusterIDs.at(i)).value();
+                skinning.jointIndex = fbxCluster.jointIndex;
+                skinning.meshToJoint = glm::inverse(joint.bindTransform) * modelTransform;
+                skinning.clusterScale = extractUniformScale(fbxCluster.inverseBindMatrix);
+                processing.skinning.append(skinning);
+            }
+        } else {
+            // this is a single-mesh joint
+            int jointIndex = firstFBXCluster.jointIndex;
+            const FBXJoint& joint = geometry.joints.at(jointIndex);
+            processing.jointIndex = jointIndex;
+            processing.clusterScale = extractUniformScale(firstFBXCluster.inverseBindMatrix);
+            processing.meshToJoint = glm::inverse(joint.bindTransform) * modelTransform;
+            processing.hasGeometricOffset = joint.hasGeometricOffset;
+            if (joint.hasGeometricOffset) {
+                processing.geometricOffset = createMatFromScaleQuatAndPos(joint.geometricScaling, joint.geometricRotation, joint.geometricTranslation);
+            }
+        }
+
+        meshProcessing.push_back(std::move(processing));
+    }
+
+    quint64 meshProcessingStart = usecTimestampNow();
+    forEachMesh((int)meshProcessing.size(), [&](int meshNumber) {
+        MeshProcessing& processing = meshProcessing[meshNumber];
+        ExtractedMesh& extracted = *processing.extracted;
+        const glm::mat4& modelTransform = processing.modelTransform;
+
+        // compute the mesh extents from the transformed vertices
+        extracted.mesh.meshExtents.reset();
+        foreach (const glm::vec3& vertex, extracted.mesh.vertices) {
+            glm::vec3 transformedVertex = glm::vec3(modelTransform * glm::vec4(vertex, 1.0f));
+            extracted.mesh.meshExtents.minimum = glm::min(extracted.mesh.meshExtents.minimum, transformedVertex);
+            extracted.mesh.meshExtents.maximum = glm::max(extracted.mesh.meshExtents.maximum, transformedVertex);
+            extracted.mesh.modelTransform = modelTransform;
+        }
+
+        extracted.mesh.createMeshTangents(processing.generateTangents);
+        extracted.mesh.createBlendShapeTangents(processing.generateTangents);
+
+        if (!processing.skinning.isEmpty()) {
             const int WEIGHTS_PER_VERTEX = 4;
             int numClusterIndices = extracted.mesh.vertices.size() * WEIGHTS_PER_VERTEX;
             extracted.mesh.clusterIndices.fill(0, numClusterIndices);
             QVector<float> weightAccumulators;
             weightAccumulators.fill(0.0f, numClusterIndices);
 
-            for (int i = 0; i < clusterIDs.size(); i++) {
-                QString clusterID = clusterIDs.at(i);
-                const Cluster& cluster = clusters[clusterID];
-                const FBXCluster& fbxCluster = extracted.mesh.clusters.at(i);
-                int jointIndex = fbxCluster.jointIndex;
-                FBXJoint& joint = geometry.joints[jointIndex];
-                glm::mat4 transformJointToMesh = inverseModelTransform * joint.bindTransform;
-                glm::vec3 boneEnd = extractTranslation(transformJointToMesh);
-                glm::vec3 boneBegin = boneEnd;
-                glm::vec3 boneDirection;
-                float boneLength = 0.0f;
-                if (joint.parentIndex != -1) {
-                    boneBegin = extractTranslation(inverseModelTransform * geometry.joints[joint.parentIndex].bindTransform);
-                    boneDirection = boneEnd - boneBegin;
-                    boneLength = glm::length(boneDirection);
-                    if (boneLength > EPSILON) {
-                        boneDirection /= boneLength;
-                    }
-                }
-
-                float clusterScale = extractUniformScale(fbxCluster.inverseBindMatrix);
-                glm::mat4 meshToJoint = glm::inverse(joint.bindTransform) * modelTransform;
-                ShapeVertices& points = shapeVertices.at(jointIndex);
+            for (int i = 0; i < processing.skinning.size(); i++) {
+                const ClusterSkinning& skinning = processing.skinning.at(i);
+                const Cluster& cluster = *skinning.cluster;
+                processing.shapeVertices.emplace_back(skinning.jointIndex, ShapeVertices());
+                ShapeVertices& points = processing.shapeVertices.back().second;
 
                 for (int j = 0; j < cluster.indices.size(); j++) {
                     int oldIndex = cluster.indices.at(j);
                     float weight = cluster.weights.at(j);
                     for (QMultiHash<int, int>::const_iterator it = extracted.newIndices.constFind(oldIndex);
-                            it != extracted.newIndices.end() && it.key() == oldIndex; it++) {
+                            it != extracted.newIndices.constEnd() && it.key() == oldIndex; it++) {
                         int newIndex = it.value();
 
                         // remember vertices with at least 1/4 weight
                         const float EXPANSION_WEIGHT_THRESHOLD = 0.25f;
                         if (weight >= EXPANSION_WEIGHT_THRESHOLD) {
                             // transform to joint-frame and save for later
-                            const glm::mat4 vertexTransform = meshToJoint * glm::translate(extracted.mesh.vertices.at(newIndex));
-                            points.push_back(extractTranslation(vertexTransform) * clusterScale);
+                            const glm::mat4 vertexTransform = skinning.meshToJoint * glm::translate(extracted.mesh.vertices.at(newIndex));
+                            points.push_back(extractTranslation(vertexTransform) * skinning.clusterScale);
                         }
 
                         // look for an unused slot in the weights vector
@@ -1882,34 +1984,42 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
                 }
             }
         } else {
-            // this is a single-mesh joint
-            int jointIndex = firstFBXCluster.jointIndex;
-            FBXJoint& joint = geometry.joints[jointIndex];
-
             // transform cluster vertices to joint-frame and save for later
-            float clusterScale = extractUniformScale(firstFBXCluster.inverseBindMatrix);
-            glm::mat4 meshToJoint = glm::inverse(joint.bindTransform) * modelTransform;
-            ShapeVertices& points = shapeVertices.at(jointIndex);
+            processing.shapeVertices.emplace_back(processing.jointIndex, ShapeVertices());
+            ShapeVertices& points = processing.shapeVertices.back().second;
             foreach (const glm::vec3& vertex, extracted.mesh.vertices) {
-                const glm::mat4 vertexTransform = meshToJoint * glm::translate(vertex);
-                points.push_back(extractTranslation(vertexTransform) * clusterScale);
+                const glm::mat4 vertexTransform = processing.meshToJoint * glm::translate(vertex);
+                points.push_back(extractTranslation(vertexTransform) * processing.clusterScale);
             }
 
             // Apply geometric offset, if present, by transforming the vertices directly
-            if (joint.hasGeometricOffset) {
-                glm::mat4 geometricOffset = createMatFromScaleQuatAndPos(joint.geometricScaling, joint.geometricRotation, joint.geometricTranslation);
+            if (processing.hasGeometricOffset) {
                 for (int i = 0; i < extracted.mesh.vertices.size(); i++) {
-                    extracted.mesh.vertices[i] = transformPoint(geometricOffset, extracted.mesh.vertices[i]);
+                    extracted.mesh.vertices[i] = transformPoint(processing.geometricOffset, extracted.mesh.vertices[i]);
                 }
             }
         }
         buildModelMesh(extracted.mesh, url);
+    });
+    _meshProcessingUsecs = usecTimestampNow() - meshProcessingStart;
+
+    // gather the results in mesh order, which keeps the shape points and mesh indices the same as a serial load
+    size_t meshNumber = 0;
+    for (QMap<QString, ExtractedMesh>::iterator it = meshes.begin(); it != meshes.end(); it++, meshNumber++) {
+        const MeshProcessing& processing = meshProcessing[meshNumber];
+        ExtractedMesh& extracted = it.value();
+
+        geometry.meshExtents.addExtents(extracted.mesh.meshExtents);
+        for (const auto& jointPoints : processing.shapeVertices) {
+            ShapeVertices& points = shapeVertices.at(jointPoints.first);
+            points.insert(points.end(), jointPoints.second.begin(), jointPoints.second.end());
+        }
 
         geometry.meshes.append(extracted.mesh);
         int meshIndex = geometry.meshes.size() - 1;
         if (extracted.mesh._mesh) {
             extracted.mesh._mesh->displayName = QString("%1#/mesh/%2").arg(url).arg(meshIndex).toStdString();
-            extracted.mesh._mesh->modelName = modelIDsToNames.value(modelID).toStdString();
+            extracted.mesh._mesh->modelName = modelIDsToNames.value(processing.modelID).toStdString();
         }
         meshIDsToMeshIndices.insert(it.key(), meshIndex);
     }
@@ -56,6 +56,10 @@ FBXGeometry* readFBX(const QByteArray& model, const QVariantHash& mapping, const
 /// \exception QString if an error occurs in parsing
 FBXGeometry* readFBX(QIODevice* device, const QVariantHash& mapping, const QString& url = "", bool loadLightmaps = true, float lightmapLevel = 1.0f);
 
+// Whether meshes are extracted and processed on the TBB workers, on by default
+bool isParallelFBXMeshProcessingEnabled();
+void setParallelFBXMeshProcessingEnabled(bool enabled);
+
 class TextureParam {
 public:
     glm::vec2 UVTranslation;
@@ -124,6 +128,10 @@ public:
 
     FBXGeometry* extractFBXGeometry(const QVariantHash& mapping, const QString& url);
 
+    // time the last extractFBXGeometry spent in its parallel mesh phases
+    quint64 getMeshExtractionUsecs() const { return _meshExtractionUsecs; }
+    quint64 getMeshProcessingUsecs() const { return _meshProcessingUsecs; }
+
     static ExtractedMesh extractMesh(const FBXNode& object, unsigned int& meshIndex, bool deduplicate = true);
     QHash<QString, ExtractedMesh> meshes;
     static void buildModelMesh(FBXMesh& extractedMesh, const QString& url);
@@ -177,6 +185,10 @@ public:
     static QVector<int> getIntVector(const FBXNode& node);
     static QVector<float> getFloatVector(const FBXNode& node);
     static QVector<double> getDoubleVector(const FBXNode& node);
+
+private:
+    quint64 _meshExtractionUsecs { 0 };
+    quint64 _meshProcessingUsecs { 0 };
 };
 
 #endif // hifi_FBXReader_h
@@ -0,0 +1,793 @@
+//
+//  FBXSerializer.cpp
+//  libraries/fbx/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXSerializer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "ModelFormatLogging.h"
+
+static const char SERIALIZED_GEOMETRY_MAGIC[4] = { 'H', 'F', 'G', 'M' };
+static const size_t ARRAY_ALIGNMENT = 8;
+static const int32_t NO_BUFFER = -1;
+
+// The least each element of a list takes in the file, with its arrays and strings empty: the lists of a corrupt
+// file can't ask for more elements than these leave room for
+static const size_t ARRAY_HEADER_SIZE = sizeof(uint64_t);
+static const size_t TRANSFORM_SIZE = 2 * sizeof(glm::vec3) + sizeof(glm::quat);
+static const size_t EXTENTS_SIZE = 2 * sizeof(glm::vec3);
+static const size_t BUFFER_VIEW_SIZE = sizeof(int32_t) + 2 * sizeof(uint64_t) + sizeof(uint16_t) + 3 * sizeof(uint8_t);
+static const size_t MIN_JOINT_SIZE = 5 * ARRAY_HEADER_SIZE + 4 * sizeof(glm::mat4) + 6 * sizeof(glm::quat) +
+    6 * sizeof(glm::vec3) + sizeof(int) + sizeof(float) + 4 * sizeof(uint8_t);
+static const size_t MIN_JOINT_INDEX_SIZE = ARRAY_HEADER_SIZE + sizeof(int);
+static const size_t MIN_TEXTURE_SIZE = 5 * ARRAY_HEADER_SIZE + TRANSFORM_SIZE + 2 * sizeof(int) + sizeof(uint8_t);
+static const size_t NUM_MATERIAL_TEXTURES = 11;
+static const size_t MIN_MATERIAL_SIZE = 3 * ARRAY_HEADER_SIZE + NUM_MATERIAL_TEXTURES * MIN_TEXTURE_SIZE +
+    3 * sizeof(glm::vec3) + 10 * sizeof(float) + sizeof(glm::vec2) + 10 * sizeof(uint8_t);
+static const size_t MIN_MESH_PART_SIZE = 4 * ARRAY_HEADER_SIZE;
+static const size_t MIN_CLUSTER_SIZE = sizeof(int) + sizeof(glm::mat4) + TRANSFORM_SIZE;
+static const size_t MIN_BLENDSHAPE_SIZE = 4 * ARRAY_HEADER_SIZE;
+static const size_t MIN_MESH_SIZE = 3 * sizeof(uint32_t) + 9 * ARRAY_HEADER_SIZE + EXTENTS_SIZE + sizeof(glm::mat4) +
+    sizeof(uint32_t) + 2 * sizeof(uint8_t);
+static const size_t MIN_MODEL_MESH_ATTRIBUTE_SIZE = sizeof(uint8_t) + BUFFER_VIEW_SIZE;
+static const size_t MIN_ANIMATION_FRAME_SIZE = 2 * ARRAY_HEADER_SIZE;
+static const size_t MIN_MODEL_NAME_SIZE = sizeof(int) + ARRAY_HEADER_SIZE;
+
+const uint32_t FBXSerializer::VERSION;
+
+namespace {
+
+class Writer {
+public:
+    const QByteArray& getData() const { return _data; }
+
+    template <typename T>
+    void write(const T& value) {
+        _data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+    void write(bool value) { write<uint8_t>(value ? 1 : 0); }
+
+    void writeBytes(const void* bytes, size_t size) {
+        write<uint64_t>(size);
+        align();
+        _data.append(reinterpret_cast<const char*>(bytes), (int)size);
+    }
+    void writeBytes(const QByteArray& bytes) { writeBytes(bytes.constData(), bytes.size()); }
+    void writeString(const QString& string) { writeBytes(string.toUtf8()); }
+
+    template <typename T>
+    void writeArray(const QVector<T>& array) { writeBytes(array.constData(), array.size() * sizeof(T)); }
+    template <typename T>
+    void writeArray(const std::vector<T>& array) { writeBytes(array.data(), array.size() * sizeof(T)); }
+
+private:
+    void align() {
+        int padding = (ARRAY_ALIGNMENT - _data.size() % ARRAY_ALIGNMENT) % ARRAY_ALIGNMENT;
+        _data.append(QByteArray(padding, '\0'));
+    }
+
+    QByteArray _data;
+};
+
+// Reads never go past the end of the data; once one would, the reader is failed and everything after reads as zero
+class Reader {
+public:
+    Reader(const uint8_t* data, size_t size) : _begin(data), _cursor(data), _end(data + size) {}
+
+    bool isValid() const { return !_failed; }
+
+    template <typename T>
+    void read(T& value) {
+        if (ensure(sizeof(T))) {
+            memcpy(&value, _cursor, sizeof(T));
+            _cursor += sizeof(T);
+        }
+    }
+    void read(bool& value) {
+        uint8_t byte = 0;
+        read(byte);
+        value = byte != 0;
+    }
+    template <typename T>
+    T read() {
+        T value = T();
+        read(value);
+        return value;
+    }
+
+    // Fails the reader, rather than allocating, when the rest of the data can't hold count elements of minSize
+    int readCount(size_t minSize) {
+        uint32_t count = read<uint32_t>();
+        if (!ensure((uint64_t)count * minSize)) {
+            return 0;
+        }
+        return (int)count;
+    }
+
+    const uint8_t* readBytes(size_t& size) {
+        uint64_t byteCount = read<uint64_t>();
+        size_t offset = _cursor - _begin;
+        size_t padding = (ARRAY_ALIGNMENT - offset % ARRAY_ALIGNMENT) % ARRAY_ALIGNMENT;
+        // compare the count with what is left after the padding, padding + byteCount could wrap
+        if (!ensure(padding) || byteCount > (uint64_t)(_end - _cursor) - padding) {
+            _failed = true;
+            size = 0;
+            return nullptr;
+        }
+        const uint8_t* bytes = _cursor + padding;
+        _cursor = bytes + byteCount;
+        size = (size_t)byteCount;
+        return bytes;
+    }
+    QByteArray readByteArray() {
+        size_t size;
+        const uint8_t* bytes = readBytes(size);
+        return QByteArray(reinterpret_cast<const char*>(bytes), (int)size);
+    }
+    QString readString() {
+        size_t size;
+        const uint8_t* bytes = readBytes(size);
+        return QString::fromUtf8(reinterpret_cast<const char*>(bytes), (int)size);
+    }
+
+    template <typename T>
+    void readArray(QVector<T>& array) {
+        size_t size;
+        const uint8_t* bytes = readBytes(size);
+        if (size % sizeof(T) != 0) {
+            _failed = true;
+            return;
+        }
+        array.resize((int)(size / sizeof(T)));
+        if (size > 0) {
+            memcpy(array.data(), bytes, size);
+        }
+    }
+    template <typename T>
+    void readArray(std::vector<T>& array) {
+        size_t size;
+        const uint8_t* bytes = readBytes(size);
+        if (size % sizeof(T) != 0) {
+            _failed = true;
+            return;
+        }
+        array.resize(size / sizeof(T));
+        if (size > 0) {
+            memcpy(array.data(), bytes, size);
+        }
+    }
+
+private:
+    bool ensure(uint64_t size) {
+        if (_failed || size > (uint64_t)(_end - _cursor)) {
+            _failed = true;
+            return false;
+        }
+        return true;
+    }
+
+    const uint8_t* const _begin;
+    const uint8_t* _cursor;
+    const uint8_t* const _end;
+    bool _failed { false };
+};
+
+}
+
+static void writeTransform(Writer& writer, const Transform& transform) {
+    writer.write(transform.getTranslation());
+    writer.write(transform.getRotation());
+    writer.write(transform.getScale());
+}
+
+static Transform readTransform(Reader& reader) {
+    Transform transform;
+    transform.setTranslation(reader.read<glm::vec3>());
+    transform.setRotation(reader.read<glm::quat>());
+    transform.setScale(reader.read<glm::vec3>());
+    return transform;
+}
+
+static void writeExtents(Writer& writer, const Extents& extents) {
+    writer.write(extents.minimum);
+    writer.write(extents.maximum);
+}
+
+static Extents readExtents(Reader& reader) {
+    Extents extents;
+    reader.read(extents.minimum);
+    reader.read(extents.maximum);
+    return extents;
+}
+
+static void writeJoint(Writer& writer, const FBXJoint& joint) {
+    writer.write(joint.shapeInfo.avgPoint);
+    writer.writeArray(joint.shapeInfo.dots);
+    writer.writeArray(joint.shapeInfo.points);
+    writer.writeArray(joint.shapeInfo.debugLines);
+    writer.writeArray(joint.freeLineage);
+    writer.write(joint.isFree);
+    writer.write(joint.parentIndex);
+    writer.write(joint.distanceToParent);
+    writer.write(joint.translation);
+    writer.write(joint.preTransform);
+    writer.write(joint.preRotation);
+    writer.write(joint.rotation);
+    writer.write(joint.postRotation);
+    writer.write(joint.postTransform);
+    writer.write(joint.transform);
+    writer.write(joint.rotationMin);
+    writer.write(joint.rotationMax);
+    writer.write(joint.inverseDefaultRotation);
+    writer.write(joint.inverseBindRotation);
+    writer.write(joint.bindTransform);
+    writer.writeString(joint.name);
+    writer.write(joint.isSkeletonJoint);
+    writer.write(joint.bindTransformFoundInCluster);
+    writer.write(joint.hasGeometricOffset);
+    writer.write(joint.geometricTranslation);
+    writer.write(joint.geometricRotation);
+    writer.write(joint.geometricScaling);
+}
+
+static void readJoint(Reader& reader, FBXJoint& joint) {
+    reader.read(joint.shapeInfo.avgPoint);
+    reader.readArray(joint.shapeInfo.dots);
+    reader.readArray(joint.shapeInfo.points);
+    reader.readArray(joint.shapeInfo.debugLines);
+    reader.readArray(joint.freeLineage);
+    reader.read(joint.isFree);
+    reader.read(joint.parentIndex);
+    reader.read(joint.distanceToParent);
+    reader.read(joint.translation);
+    reader.read(joint.preTransform);
+    reader.read(joint.preRotation);
+    reader.read(joint.rotation);
+    reader.read(joint.postRotation);
+    reader.read(joint.postTransform);
+    reader.read(joint.transform);
+    reader.read(joint.rotationMin);
+    reader.read(joint.rotationMax);
+    reader.read(joint.inverseDefaultRotation);
+    reader.read(joint.inverseBindRotation);
+    reader.read(joint.bindTransform);
+    joint.name = reader.readString();
+    reader.read(joint.isSkeletonJoint);
+    reader.read(joint.bindTransformFoundInCluster);
+    reader.read(joint.hasGeometricOffset);
+    reader.read(joint.geometricTranslation);
+    reader.read(joint.geometricRotation);
+    reader.read(joint.geometricScaling);
+}
+
+static void writeTexture(Writer& writer, const FBXTexture& texture) {
+    writer.writeString(texture.id);
+    writer.writeString(texture.name);
+    writer.writeBytes(texture.filename);
+    writer.writeBytes(texture.content);
+    writeTransform(writer, texture.transform);
+    writer.write(texture.maxNumPixels);
+    writer.write(texture.texcoordSet);
+    writer.writeString(texture.texcoordSetName);
+    writer.write(texture.isBumpmap);
+}
+
+static void readTexture(Reader& reader, FBXTexture& texture) {
+    texture.id = reader.readString();
+    texture.name = reader.readString();
+    texture.filename = reader.readByteArray();
+    texture.content = reader.readByteArray();
+    texture.transform = readTransform(reader);
+    reader.read(texture.maxNumPixels);
+    reader.read(texture.texcoordSet);
+    texture.texcoordSetName = reader.readString();
+    reader.read(texture.isBumpmap);
+}
+
+static void writeMaterial(Writer& writer, const FBXMaterial& material) {
+    writer.write(material.diffuseColor);
+    writer.write(material.diffuseFactor);
+    writer.write(material.specularColor);
+    writer.write(material.specularFactor);
+    writer.write(material.emissiveColor);
+    writer.write(material.emissiveFactor);
+    writer.write(material.shininess);
+    writer.write(material.opacity);
+    writer.write(material.metallic);
+    writer.write(material.roughness);
+    writer.write(material.emissiveIntensity);
+    writer.write(material.ambientFactor);
+    writer.write(material.bumpMultiplier);
+    writer.writeString(material.materialID);
+    writer.writeString(material.name);
+    writer.writeString(material.shadingModel);
+
+    for (const FBXTexture* texture : { &material.normalTexture, &material.albedoTexture, &material.opacityTexture,
+                                       &material.glossTexture, &material.roughnessTexture, &material.specularTexture,
+                                       &material.metallicTexture, &material.emissiveTexture, &material.occlusionTexture,
+                                       &material.scatteringTexture, &material.lightmapTexture }) {
+        writeTexture(writer, *texture);
+    }
+    writer.write(material.lightmapParams);
+
+    writer.write(material.isPBSMaterial);
+    writer.write(material.useNormalMap);
+    writer.write(material.useAlbedoMap);
+    writer.write(material.useOpacityMap);
+    writer.write(material.useRoughnessMap);
+    writer.write(material.useSpecularMap);
+    writer.write(material.useMetallicMap);
+    writer.write(material.useEmissiveMap);
+    writer.write(material.useOcclusionMap);
+
+    // The texture maps are only set later, by NetworkMaterial, so the schema values are all there is to the material
+    const auto& schemaMaterial = material._material;
+    writer.write((bool)schemaMaterial);
+    if (schemaMaterial) {
+        writer.write(schemaMaterial->getEmissive(false));
+        writer.write(schemaMaterial->getAlbedo(false));
+        writer.write(schemaMaterial->getFresnel(false));
+        writer.write(schemaMaterial->getOpacity());
+        writer.write(schemaMaterial->getRoughness());
+        writer.write(schemaMaterial->getMetallic());
+        writer.write(schemaMaterial->getScattering());
+        writer.write(schemaMaterial->isUnlit());
+    }
+}
+
+static void readMaterial(Reader& reader, FBXMaterial& material) {
+    reader.read(material.diffuseColor);
+    reader.read(material.diffuseFactor);
+    reader.read(material.specularColor);
+    reader.read(material.specularFactor);
+    reader.read(material.emissiveColor);
+    reader.read(material.emissiveFactor);
+    reader.read(material.shininess);
+    reader.read(material.opacity);
+    reader.read(material.metallic);
+    reader.read(material.roughness);
+    reader.read(material.emissiveIntensity);
+    reader.read(material.ambientFactor);
+    reader.read(material.bumpMultiplier);
+    material.materialID = reader.readString();
+    material.name = reader.readString();
+    material.shadingModel = reader.readString();
+
+    for (FBXTexture* texture : { &material.normalTexture, &material.albedoTexture, &material.opacityTexture,
+                                 &material.glossTexture, &material.roughnessTexture, &material.specularTexture,
+                                 &material.metallicTexture, &material.emissiveTexture, &material.occlusionTexture,
+                                 &material.scatteringTexture, &material.lightmapTexture }) {
+        readTexture(reader, *texture);
+    }
+    reader.read(material.lightmapParams);
+
+    reader.read(material.isPBSMaterial);
+    reader.read(material.useNormalMap);
+    reader.read(material.useAlbedoMap);
+    reader.read(material.useOpacityMap);
+    reader.read(material.useRoughnessMap);
+    reader.read(material.useSpecularMap);
+    reader.read(material.useMetallicMap);
+    reader.read(material.useEmissiveMap);
+    reader.read(material.useOcclusionMap);
+
+    if (reader.read<bool>()) {
+        // The setters derive the material key from the values, in the order the FBX reader sets them
+        auto schemaMaterial = std::make_shared<graphics::Material>();
+        schemaMaterial->setEmissive(reader.read<glm::vec3>(), false);
+        schemaMaterial->setAlbedo(reader.read<glm::vec3>(), false);
+        schemaMaterial->setFresnel(reader.read<glm::vec3>(), false);
+        float opacity = reader.read<float>();
+        schemaMaterial->setRoughness(reader.read<float>());
+        schemaMaterial->setMetallic(reader.read<float>());
+        float scattering = reader.read<float>();
+        if (scattering > 0.0f) {
+            schemaMaterial->setScattering(scattering);
+        }
+        schemaMaterial->setUnlit(reader.read<bool>());
+        schemaMaterial->setOpacity(opacity);
+        material._material = schemaMaterial;
+    }
+}
+
+static void writeBufferView(Writer& writer, const gpu::BufferView& view, const std::vector<const gpu::Buffer*>& buffers) {
+    auto found = std::find(buffers.begin(), buffers.end(), view._buffer.get());
+    writer.write<int32_t>(view._buffer ? (int32_t)(found - buffers.begin()) : NO_BUFFER);
+    writer.write<uint64_t>(view._offset);
+    writer.write<uint64_t>(view._size);
+    writer.write<uint16_t>(view._stride);
+    writer.write<uint8_t>(view._element.getDimension());
+    writer.write<uint8_t>(view._element.getType());
+    writer.write<uint8_t>(view._element.getSemantic());
+}
+
+static gpu::BufferView readBufferView(Reader& reader, const std::vector<gpu::BufferPointer>& buffers) {
+    int32_t bufferIndex = reader.read<int32_t>();
+    gpu::BufferView::Size offset = reader.read<uint64_t>();
+    gpu::BufferView::Size size = reader.read<uint64_t>();
+    uint16_t stride = reader.read<uint16_t>();
+    auto dimension = (gpu::Dimension)reader.read<uint8_t>();
+    auto type = (gpu::Type)reader.read<uint8_t>();
+    auto semantic = (gpu::Semantic)reader.read<uint8_t>();
+    gpu::Element element(dimension, type, semantic);
+
+    if (bufferIndex < 0 || bufferIndex >= (int32_t)buffers.size()) {
+        return gpu::BufferView(element);
+    }
+    const auto& buffer = buffers[bufferIndex];
+    if (offset + size > buffer->getSize() || stride == 0) {
+        return gpu::BufferView(element);
+    }
+    return gpu::BufferView(buffer, offset, size, stride, element);
+}
+
+// The buffers of the gpu mesh are stored as built by FBXReader::buildModelMesh, with the attributes still sharing
+// their interleaved buffer
+static void writeModelMesh(Writer& writer, const graphics::Mesh& mesh) {
+    std::vector<std::pair<gpu::Stream::Slot, gpu::BufferView>> attributes;
+    for (int slot = 0; slot < gpu::Stream::NUM_INPUT_SLOTS; ++slot) {
+        auto view = mesh.getAttributeBuffer(slot);
+        if (view._buffer) {
+            attributes.emplace_back((gpu::Stream::Slot)slot, view);
+        }
+    }
+
+    std::vector<const gpu::Buffer*> buffers;
+    auto addBuffer = [&buffers](const gpu::BufferView& view) {
+        if (view._buffer && std::find(buffers.begin(), buffers.end(), view._buffer.get()) == buffers.end()) {
+            buffers.push_back(view._buffer.get());
+        }
+    };
+    addBuffer(mesh.getVertexBuffer());
+    addBuffer(mesh.getIndexBuffer());
+    addBuffer(mesh.getPartBuffer());
+    for (const auto& attribute : attributes) {
+        addBuffer(attribute.second);
+    }
+
+    writer.writeString(QString::fromStdString(mesh.modelName));
+    writer.write<uint32_t>((uint32_t)buffers.size());
+    for (const auto& buffer : buffers) {
+        writer.writeBytes(buffer->getData(), buffer->getSize());
+    }
+    writeBufferView(writer, mesh.getVertexBuffer(), buffers);
+    writeBufferView(writer, mesh.getIndexBuffer(), buffers);
+    writeBufferView(writer, mesh.getPartBuffer(), buffers);
+    writer.write<uint32_t>((uint32_t)attributes.size());
+    for (const auto& attribute : attributes) {
+        writer.write<uint8_t>(attribute.first);
+        writeBufferView(writer, attribute.second, buffers);
+    }
+}
+
+static graphics::MeshPointer readModelMesh(Reader& reader) {
+    auto mesh = std::make_shared<graphics::Mesh>();
+    mesh->modelName = reader.readString().toStdString();
+
+    std::vector<gpu::BufferPointer> buffers;
+    int numBuffers = reader.readCount(ARRAY_HEADER_SIZE);
+    buffers.reserve(numBuffers);
+    for (int i = 0; i < numBuffers; ++i) {
+        size_t size;
+        const uint8_t* bytes = reader.readBytes(size);
+        buffers.push_back(std::make_shared<gpu::Buffer>(size, bytes));
+    }
+
+    mesh->setVertexBuffer(readBufferView(reader, buffers));
+    mesh->setIndexBuffer(readBufferView(reader, buffers));
+    mesh->setPartBuffer(readBufferView(reader, buffers));
+    int numAttributes = reader.readCount(MIN_MODEL_MESH_ATTRIBUTE_SIZE);
+    for (int i = 0; i < numAttributes; ++i) {
+        gpu::Stream::Slot slot = reader.read<uint8_t>();
+        auto view = readBufferView(reader, buffers);
+        if (view._buffer) {
+            mesh->addAttribute(slot, view);
+        }
+    }
+    return mesh;
+}
+
+static void writeMesh(Writer& writer, const FBXMesh& mesh) {
+    writer.write<uint32_t>(mesh.parts.size());
+    for (const FBXMeshPart& part : mesh.parts) {
+        writer.writeArray(part.quadIndices);
+        writer.writeArray(part.quadTrianglesIndices);
+        writer.writeArray(part.triangleIndices);
+        writer.writeString(part.materialID);
+    }
+
+    writer.writeArray(mesh.vertices);
+    writer.writeArray(mesh.normals);
+    writer.writeArray(mesh.tangents);
+    writer.writeArray(mesh.colors);
+    writer.writeArray(mesh.texCoords);
+    writer.writeArray(mesh.texCoords1);
+    writer.writeArray(mesh.clusterIndices);
+    writer.writeArray(mesh.clusterWeights);
+    writer.writeArray(mesh.originalIndices);
+
+    writer.write<uint32_t>(mesh.clusters.size());
+    for (const FBXCluster& cluster : mesh.clusters) {
+        writer.write(cluster.jointIndex);
+        writer.write(cluster.inverseBindMatrix);
+        writeTransform(writer, cluster.inverseBindTransform);
+    }
+
+    writeExtents(writer, mesh.meshExtents);
+    writer.write(mesh.modelTransform);
+
+    writer.write<uint32_t>(mesh.blendshapes.size());
+    for (const FBXBlendshape& blendshape : mesh.blendshapes) {
+        writer.writeArray(blendshape.indices);
+        writer.writeArray(blendshape.vertices);
+        writer.writeArray(blendshape.normals);
+        writer.writeArray(blendshape.tangents);
+    }
+
+    writer.write<uint32_t>(mesh.meshIndex);
+    writer.write(mesh.wasCompressed);
+
+    writer.write((bool)mesh._mesh);
+    if (mesh._mesh) {
+        writeModelMesh(writer, *mesh._mesh);
+    }
+}
+
+static void readMesh(Reader& reader, FBXMesh& mesh) {
+    mesh.parts.resize(reader.readCount(MIN_MESH_PART_SIZE));
+    for (FBXMeshPart& part : mesh.parts) {
+        reader.readArray(part.quadIndices);
+        reader.readArray(part.quadTrianglesIndices);
+        reader.readArray(part.triangleIndices);
+        part.materialID = reader.readString();
+    }
+
+    reader.readArray(mesh.vertices);
+    reader.readArray(mesh.normals);
+    reader.readArray(mesh.tangents);
+    reader.readArray(mesh.colors);
+    reader.readArray(mesh.texCoords);
+    reader.readArray(mesh.texCoords1);
+    reader.readArray(mesh.clusterIndices);
+    reader.readArray(mesh.clusterWeights);
+    reader.readArray(mesh.originalIndices);
+
+    mesh.clusters.resize(reader.readCount(MIN_CLUSTER_SIZE));
+    for (FBXCluster& cluster : mesh.clusters) {
+        reader.read(cluster.jointIndex);
+        reader.read(cluster.inverseBindMatrix);
+        cluster.inverseBindTransform = readTransform(reader);
+    }
+
+    mesh.meshExtents = readExtents(reader);
+    reader.read(mesh.modelTransform);
+
+    mesh.blendshapes.resize(reader.readCount(MIN_BLENDSHAPE_SIZE));
+    for (FBXBlendshape& blendshape : mesh.blendshapes) {
+        reader.readArray(blendshape.indices);
+        reader.readArray(blendshape.vertices);
+        reader.readArray(blendshape.normals);
+        reader.readArray(blendshape.tangents);
+    }
+
+    mesh.meshIndex = reader.read<uint32_t>();
+    reader.read(mesh.wasCompressed);
+
+    if (reader.read<bool>()) {
+        mesh._mesh = readModelMesh(reader);
+    }
+}
+
+// The rig and the model index their arrays with these without checking them, as they come from the reader
+static bool hasValidJointIndices(const FBXGeometry& geometry) {
+    int numJoints = geometry.joints.size();
+    auto isJoint = [numJoints](int index) { return index >= 0 && index < numJoints; };
+    auto isJointOrNone = [numJoints](int index) { return index >= -1 && index < numJoints; };
+
+    for (const FBXJoint& joint : geometry.joints) {
+        if (!isJointOrNone(joint.parentIndex)) {
+            return false;
+        }
+        for (int index : joint.freeLineage) {
+            if (!isJoint(index)) {
+                return false;
+            }
+        }
+    }
+    // the values of jointIndices are one more than the index, see FBXGeometry::getJointIndex
+    for (int index : geometry.jointIndices) {
+        if (!isJoint(index - 1)) {
+            return false;
+        }
+    }
+    for (int index : { geometry.leftEyeJointIndex, geometry.rightEyeJointIndex, geometry.neckJointIndex,
+                       geometry.rootJointIndex, geometry.leanJointIndex, geometry.headJointIndex,
+                       geometry.leftHandJointIndex, geometry.rightHandJointIndex,
+                       geometry.leftToeJointIndex, geometry.rightToeJointIndex }) {
+        if (!isJointOrNone(index)) {
+            return false;
+        }
+    }
+    for (int index : geometry.humanIKJointIndices) {
+        if (!isJointOrNone(index)) {
+            return false;
+        }
+    }
+    for (const FBXMesh& mesh : geometry.meshes) {
+        for (const FBXCluster& cluster : mesh.clusters) {
+            if (!isJoint(cluster.jointIndex)) {
+                return false;
+            }
+        }
+        for (uint16_t index : mesh.clusterIndices) {
+            if (index >= mesh.clusters.size()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+QByteArray FBXSerializer::serialize(const FBXGeometry& geometry) {
+    Writer writer;
+    for (char magic : SERIALIZED_GEOMETRY_MAGIC) {
+        writer.write(magic);
+    }
+    writer.write<uint32_t>(VERSION);
+
+    writer.writeString(geometry.author);
+    writer.writeString(geometry.applicationName);
+
+    writer.write<uint32_t>(geometry.joints.size());
+    for (const FBXJoint& joint : geometry.joints) {
+        writeJoint(writer, joint);
+    }
+    writer.write<uint32_t>(geometry.jointIndices.size());
+    for (auto it = geometry.jointIndices.constBegin(); it != geometry.jointIndices.constEnd(); ++it) {
+        writer.writeString(it.key());
+        writer.write(it.value());
+    }
+    writer.write(geometry.hasSkeletonJoints);
+
+    writer.write<uint32_t>(geometry.meshes.size());
+    for (const FBXMesh& mesh : geometry.meshes) {
+        writeMesh(writer, mesh);
+    }
+
+    writer.write<uint32_t>(geometry.materials.size());
+    for (auto it = geometry.materials.constBegin(); it != geometry.materials.constEnd(); ++it) {
+        writer.writeString(it.key());
+        writeMaterial(writer, it.value());
+    }
+
+    writer.write(geometry.offset);
+    for (int jointIndex : { geometry.leftEyeJointIndex, geometry.rightEyeJointIndex, geometry.neckJointIndex,
+                            geometry.rootJointIndex, geometry.leanJointIndex, geometry.headJointIndex,
+                            geometry.leftHandJointIndex, geometry.rightHandJointIndex,
+                            geometry.leftToeJointIndex, geometry.rightToeJointIndex }) {
+        writer.write(jointIndex);
+    }
+    writer.write(geometry.leftEyeSize);
+    writer.write(geometry.rightEyeSize);
+    writer.writeArray(geometry.humanIKJointIndices);
+    writer.write(geometry.palmDirection);
+    writer.write(geometry.neckPivot);
+    writeExtents(writer, geometry.bindExtents);
+    writeExtents(writer, geometry.meshExtents);
+
+    writer.write<uint32_t>(geometry.animationFrames.size());
+    for (const FBXAnimationFrame& frame : geometry.animationFrames) {
+        writer.writeArray(frame.rotations);
+        writer.writeArray(frame.translations);
+    }
+
+    writer.write<uint32_t>(geometry.meshIndicesToModelNames.size());
+    for (auto it = geometry.meshIndicesToModelNames.constBegin(); it != geometry.meshIndicesToModelNames.constEnd(); ++it) {
+        writer.write(it.key());
+        writer.writeString(it.value());
+    }
+
+    writer.write<uint32_t>(geometry.blendshapeChannelNames.size());
+    for (const QString& name : geometry.blendshapeChannelNames) {
+        writer.writeString(name);
+    }
+
+    return writer.getData();
+}
+
+FBXGeometry::Pointer FBXSerializer::deserialize(const uint8_t* data, size_t size, const QString& url) {
+    Reader reader(data, size);
+    for (char magic : SERIALIZED_GEOMETRY_MAGIC) {
+        if (reader.read<char>() != magic) {
+            qCWarning(modelformat) << "Not a serialized geometry for" << url;
+            return nullptr;
+        }
+    }
+    auto version = reader.read<uint32_t>();
+    if (version != VERSION) {
+        qCDebug(modelformat) << "Serialized geometry for" << url << "is version" << version << "instead of" << VERSION;
+        return nullptr;
+    }
+
+    auto geometry = std::make_shared<FBXGeometry>();
+    geometry->originalURL = url;
+    geometry->author = reader.readString();
+    geometry->applicationName = reader.readString();
+
+    geometry->joints.resize(reader.readCount(MIN_JOINT_SIZE));
+    for (FBXJoint& joint : geometry->joints) {
+        readJoint(reader, joint);
+    }
+    int numJointIndices = reader.readCount(MIN_JOINT_INDEX_SIZE);
+    for (int i = 0; i < numJointIndices; ++i) {
+        QString name = reader.readString();
+        geometry->jointIndices.insert(name, reader.read<int>());
+    }
+    reader.read(geometry->hasSkeletonJoints);
+
+    geometry->meshes.resize(reader.readCount(MIN_MESH_SIZE));
+    for (int i = 0; i < geometry->meshes.size(); ++i) {
+        FBXMesh& mesh = geometry->meshes[i];
+        readMesh(reader, mesh);
+        if (mesh._mesh) {
+            mesh._mesh->displayName = QString("%1#/mesh/%2").arg(url).arg(i).toStdString();
+        }
+    }
+
+    int numMaterials = reader.readCount(ARRAY_HEADER_SIZE + MIN_MATERIAL_SIZE);
+    for (int i = 0; i < numMaterials; ++i) {
+        QString key = reader.readString();
+        readMaterial(reader, geometry->materials[key]);
+    }
+
+    reader.read(geometry->offset);
+    for (int* jointIndex : { &geometry->leftEyeJointIndex, &geometry->rightEyeJointIndex, &geometry->neckJointIndex,
+                             &geometry->rootJointIndex, &geometry->leanJointIndex, &geometry->headJointIndex,
+                             &geometry->leftHandJointIndex, &geometry->rightHandJointIndex,
+                             &geometry->leftToeJointIndex, &geometry->rightToeJointIndex }) {
+        reader.read(*jointIndex);
+    }
+    reader.read(geometry->leftEyeSize);
+    reader.read(geometry->rightEyeSize);
+    reader.readArray(geometry->humanIKJointIndices);
+    reader.read(geometry->palmDirection);
+    reader.read(geometry->neckPivot);
+    geometry->bindExtents = readExtents(reader);
+    geometry->meshExtents = readExtents(reader);
+
+    geometry->animationFrames.resize(reader.readCount(MIN_ANIMATION_FRAME_SIZE));
+    for (FBXAnimationFrame& frame : geometry->animationFrames) {
+        reader.readArray(frame.rotations);
+        reader.readArray(frame.translations);
+    }
+
+    int numModelNames = reader.readCount(MIN_MODEL_NAME_SIZE);
+    for (int i = 0; i < numModelNames; ++i) {
+        int meshIndex = reader.read<int>();
+        geometry->meshIndicesToModelNames.insert(meshIndex, reader.readString());
+    }
+
+    int numBlendshapeChannels = reader.readCount(ARRAY_HEADER_SIZE);
+    for (int i = 0; i < numBlendshapeChannels; ++i) {
+        geometry->blendshapeChannelNames.append(reader.readString());
+    }
+
+    if (!reader.isValid()) {
+        qCWarning(modelformat) << "Serialized geometry for" << url << "is truncated";
+        return nullptr;
+    }
+    if (!hasValidJointIndices(*geometry)) {
+        qCWarning(modelformat) << "Serialized geometry for" << url << "has joint indices out of range";
+        return nullptr;
+    }
+    return geometry;
+}
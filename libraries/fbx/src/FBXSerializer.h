@@ -0,0 +1,37 @@
+//
+//  FBXSerializer.h
+//  libraries/fbx/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FBXSerializer_h
+#define hifi_FBXSerializer_h
+
+#include <QByteArray>
+#include <QString>
+
+#include "FBX.h"
+
+// Binary image of a parsed FBXGeometry, for caching models on disk.
+//
+// The format is a flat sequence of little endian values in the order of the FBXGeometry fields.  Arrays are
+// prefixed with their element count and start on an 8 byte boundary, so a memory mapped file is copied straight
+// into the vertex arrays, and the gpu buffers of the meshes are stored as they were built, ready for upload.
+// There is nothing left to parse or convert when reading.
+class FBXSerializer {
+public:
+    // Whenever a change is made to the format, or to what the readers put in an FBXGeometry,
+    // this value should be incremented
+    static const uint32_t VERSION = 1;
+
+    static QByteArray serialize(const FBXGeometry& geometry);
+
+    // Returns nullptr if the data is truncated or of another version
+    static FBXGeometry::Pointer deserialize(const uint8_t* data, size_t size, const QString& url);
+};
+
+#endif // hifi_FBXSerializer_h
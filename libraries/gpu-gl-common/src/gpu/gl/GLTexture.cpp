@@ -225,7 +225,9 @@ TransferJob::TransferJob(const GLTexture& parent, uint16_t sourceMip, uint16_t t
     _bufferingLambda = [=] {
         auto mipStorage = _parent._gpuObject.accessStoredMipFace(sourceMip, face);
         if (mipStorage) {
+            // the view reads straight from a mapped KTX file, which stays in the open file list until the upload is done
             _mipData = mipStorage->createView(_transferSize, _transferOffset);
+            Texture::KtxStorage::holdKtxView(_mipData);
         } else {
             qCWarning(gpugllogging) << "Buffering failed because mip could not be retrieved from texture " << _parent._source.c_str() ;
         }
@@ -234,6 +236,7 @@ TransferJob::TransferJob(const GLTexture& parent, uint16_t sourceMip, uint16_t t
     _transferLambda = [=] {
         if (_mipData) {
             _parent.copyMipFaceLinesFromTexture(targetMip, face, transferDimensions, lineOffset, internalFormat, format, type, _mipData->size(), _mipData->readData());
+            Texture::KtxStorage::releaseKtxView(_mipData);
             _mipData.reset();
         } else {
             qCWarning(gpugllogging) << "Transfer failed because mip could not be retrieved from texture " << _parent._source.c_str();
@@ -246,6 +249,10 @@ TransferJob::TransferJob(const GLTexture& parent, std::function<void()> transfer
 }
 
 TransferJob::~TransferJob() {
+    if (_mipData) {
+        // buffered but never transferred
+        Texture::KtxStorage::releaseKtxView(_mipData);
+    }
     Backend::texturePendingGPUTransferMemSize.update(_transferSize, 0);
 }
 
@@ -346,14 +346,21 @@ public:
         // Don't keep files open forever.  We close them at the beginning of each frame (GLBackend::recycle)
         static void releaseOpenKtxFiles();
 
+        // Keeps the file a mip view maps in the open file list while the view is held across frames, by a queued
+        // transfer for instance.  The file is closed by the first releaseOpenKtxFiles() after releaseKtxView().
+        static void holdKtxView(const storage::StoragePointer& view);
+        static void releaseKtxView(const storage::StoragePointer& view);
+
     protected:
         std::shared_ptr<storage::FileStorage> maybeOpenFile() const;
+        void cacheOpenFile(const std::shared_ptr<storage::FileStorage>& file) const;
 
         mutable std::shared_ptr<std::mutex> _cacheFileMutex { std::make_shared<std::mutex>() };
         mutable std::weak_ptr<storage::FileStorage> _cacheFile;
 
         static std::vector<std::pair<std::shared_ptr<storage::FileStorage>, std::shared_ptr<std::mutex>>> _cachedKtxFiles;
         static std::mutex _cachedKtxFilesMutex;
+        static std::vector<storage::StoragePointer> _heldKtxViews;
 
         std::string _filename;
         cache::FilePointer _cacheEntry;
@@ -12,6 +12,8 @@
 
 #include "Texture.h"
 
+#include <algorithm>
+
 #include <QtCore/QByteArray>
 
 #include <ktx/KTX.h>
@@ -25,6 +27,7 @@ using KtxStorage = Texture::KtxStorage;
 
 std::vector<std::pair<std::shared_ptr<storage::FileStorage>, std::shared_ptr<std::mutex>>> KtxStorage::_cachedKtxFiles;
 std::mutex KtxStorage::_cachedKtxFilesMutex;
+std::vector<storage::StoragePointer> KtxStorage::_heldKtxViews;
 
 struct GPUKTXPayload {
     using Version = uint8;
@@ -164,7 +167,8 @@ KtxStorage::KtxStorage(const cache::FilePointer& cacheEntry) : KtxStorage(cacheE
 KtxStorage::KtxStorage(const std::string& filename) : _filename(filename) {
     {
         // We are doing a lot of work here just to get descriptor data
-        ktx::StoragePointer storage{ new storage::FileStorage(_filename.c_str()) };
+        auto file = std::make_shared<storage::FileStorage>(_filename.c_str());
+        ktx::StoragePointer storage = file;
         auto ktxPointer = ktx::KTX::create(storage);
         _ktxDescriptor.reset(new ktx::KTXDescriptor(ktxPointer->toDescriptor()));
         if (_ktxDescriptor->images.size() < _ktxDescriptor->header.numberOfMipmapLevels) {
@@ -179,6 +183,10 @@ KtxStorage::KtxStorage(const std::string& filename) : _filename(filename) {
             // Assume all mip levels are available
             _minMipLevelAvailable = 0;
         }
+
+        // the first mip requests are likely to follow right away, keep the mapping for them
+        std::lock_guard<std::mutex> lock(*_cacheFileMutex);
+        cacheOpenFile(file);
     }
 
 
@@ -200,22 +208,49 @@ std::shared_ptr<storage::FileStorage> KtxStorage::maybeOpenFile() const {
 
     // If the file isn't open, create it and save a weak_ptr to it
     file = std::make_shared<storage::FileStorage>(_filename.c_str());
+    cacheOpenFile(file);
+
+    return file;
+}
+
+// cacheOpenFile should be called with _cacheFileMutex already held
+void KtxStorage::cacheOpenFile(const std::shared_ptr<storage::FileStorage>& file) const {
     _cacheFile = file;
 
-    {
-        // Add the shared_ptr to the global list of open KTX files, to be released at the beginning of the next present thread frame
-        std::lock_guard<std::mutex> lock(_cachedKtxFilesMutex);
-        _cachedKtxFiles.emplace_back(file, _cacheFileMutex);
-    }
+    // Add the shared_ptr to the global list of open KTX files, to be released at the beginning of the next present thread frame
+    std::lock_guard<std::mutex> lock(_cachedKtxFilesMutex);
+    _cachedKtxFiles.emplace_back(file, _cacheFileMutex);
+}
 
-    return file;
+using CachedKtxFile = std::pair<std::shared_ptr<storage::FileStorage>, std::shared_ptr<std::mutex>>;
+
+// The storage at the end of a chain of views
+static storage::StoragePointer viewedStorage(storage::StoragePointer storage) {
+    auto view = std::dynamic_pointer_cast<const storage::ViewStorage>(storage);
+    while (view) {
+        storage = view->getOwner();
+        view = std::dynamic_pointer_cast<const storage::ViewStorage>(storage);
+    }
+    return storage;
 }
 
 void KtxStorage::releaseOpenKtxFiles() {
-    std::vector<std::pair<std::shared_ptr<storage::FileStorage>, std::shared_ptr<std::mutex>>> localKtxFiles;
+    std::vector<CachedKtxFile> localKtxFiles;
     {
         std::lock_guard<std::mutex> lock(_cachedKtxFilesMutex);
         localKtxFiles.swap(_cachedKtxFiles);
+
+        // files that held views still read from stay open until the views are released
+        for (const auto& view : _heldKtxViews) {
+            auto file = viewedStorage(view);
+            auto itr = std::find_if(localKtxFiles.begin(), localKtxFiles.end(), [&](const CachedKtxFile& cacheFileAndMutex) {
+                return cacheFileAndMutex.first.get() == file.get();
+            });
+            if (itr != localKtxFiles.end()) {
+                _cachedKtxFiles.push_back(*itr);
+                localKtxFiles.erase(itr);
+            }
+        }
     }
     for (auto& cacheFileAndMutex : localKtxFiles) {
         std::lock_guard<std::mutex> lock(*(cacheFileAndMutex.second));
@@ -223,6 +258,33 @@ void KtxStorage::releaseOpenKtxFiles() {
     }
 }
 
+void KtxStorage::holdKtxView(const storage::StoragePointer& view) {
+    auto file = std::dynamic_pointer_cast<const storage::FileStorage>(viewedStorage(view));
+    if (!file) {
+        // not a mapped file, nothing to keep open
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_cachedKtxFilesMutex);
+    _heldKtxViews.push_back(view);
+
+    // the file may have been released from the list since the view was made
+    auto itr = std::find_if(_cachedKtxFiles.begin(), _cachedKtxFiles.end(), [&](const CachedKtxFile& cacheFileAndMutex) {
+        return cacheFileAndMutex.first.get() == file.get();
+    });
+    if (itr == _cachedKtxFiles.end()) {
+        _cachedKtxFiles.emplace_back(std::const_pointer_cast<storage::FileStorage>(file), std::make_shared<std::mutex>());
+    }
+}
+
+void KtxStorage::releaseKtxView(const storage::StoragePointer& view) {
+    std::lock_guard<std::mutex> lock(_cachedKtxFilesMutex);
+    auto itr = std::find(_heldKtxViews.begin(), _heldKtxViews.end(), view);
+    if (itr != _heldKtxViews.end()) {
+        _heldKtxViews.erase(itr);
+    }
+}
+
 PixelsPointer KtxStorage::getMipFace(uint16 level, uint8 face) const {
     auto faceOffset = _ktxDescriptor->getMipFaceTexelsOffset(level, face);
     auto faceSize = _ktxDescriptor->getMipFaceTexelsSize(level, face);
@@ -232,7 +294,9 @@ PixelsPointer KtxStorage::getMipFace(uint16 level, uint8 face) const {
         if (file) {
             auto storageView = file->createView(faceSize, faceOffset);
             if (storageView) {
-                return storageView->toMemoryStorage();
+                // Hand out the mapped pages rather than a copy.  The view keeps the file mapped after it is
+                // released from the open file list, so callers that hold on to it across frames use holdKtxView().
+                return storageView;
             } else {
                 qWarning() << "Failed to get a valid storageView for faceSize=" << faceSize << "  faceOffset=" << faceOffset << "out of valid file " << QString::fromStdString(_filename);
             }
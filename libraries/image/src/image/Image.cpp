@@ -11,6 +11,8 @@
 
 #include "Image.h"
 
+#include <array>
+
 #include <glm/gtc/packing.hpp>
 
 #include <QtCore/QtGlobal>
@@ -23,6 +25,7 @@
 #include <Profile.h>
 #include <StatTracker.h>
 #include <GLMHelpers.h>
+#include <TBBHelpers.h>
 
 #include "ImageLogging.h"
 
@@ -43,6 +46,7 @@ static std::atomic<bool> compressColorTextures { false };
 static std::atomic<bool> compressNormalTextures { false };
 static std::atomic<bool> compressGrayscaleTextures { false };
 static std::atomic<bool> compressCubeTextures { false };
+static std::atomic<bool> parallelTextureProcessing { true };
 
 uint rectifyDimension(const uint& dimension) {
     if (dimension == 0) {
@@ -219,6 +223,30 @@ void setCubeTexturesCompressionEnabled(bool enabled) {
     compressCubeTextures.store(enabled);
 }
 
+bool isParallelTextureProcessingEnabled() {
+    return parallelTextureProcessing.load();
+}
+
+void setParallelTextureProcessingEnabled(bool enabled) {
+    parallelTextureProcessing.store(enabled);
+}
+
+// Runs body over [begin, end) rows, split across the TBB workers unless parallel processing is disabled
+template <typename F>
+void forEachRow(int begin, int end, F&& body) {
+    if (parallelTextureProcessing.load()) {
+        tbb::parallel_for(tbb::blocked_range<int>(begin, end), [&](const tbb::blocked_range<int>& range) {
+            for (int row = range.begin(); row != range.end(); ++row) {
+                body(row);
+            }
+        });
+    } else {
+        for (int row = begin; row < end; ++row) {
+            body(row);
+        }
+    }
+}
+
 static float denormalize(float value, const float minValue) {
     return value < minValue ? 0.0f : value;
 }
@@ -429,20 +457,34 @@ struct MyErrorHandler : public nvtt::ErrorHandler {
     }
 };
 
-class SequentialTaskDispatcher : public nvtt::TaskDispatcher {
+// nvtt dispatches one task per 4x4 block when compressing, so running them on the TBB workers
+// encodes the tiles of a mip in parallel.  The caller's thread takes part and waits for all of them.
+class ParallelTaskDispatcher : public nvtt::TaskDispatcher {
 public:
-    SequentialTaskDispatcher(const std::atomic<bool>& abortProcessing) : _abortProcessing(abortProcessing) {};
+    ParallelTaskDispatcher(const std::atomic<bool>& abortProcessing) : _abortProcessing(abortProcessing) {};
 
     const std::atomic<bool>& _abortProcessing;
 
     virtual void dispatch(nvtt::Task* task, void* context, int count) override {
-        for (int i = 0; i < count; i++) {
-            if (!_abortProcessing.load()) {
-                task(context, i);
-            } else {
-                break;
+        if (!parallelTextureProcessing.load()) {
+            for (int i = 0; i < count; i++) {
+                if (!_abortProcessing.load()) {
+                    task(context, i);
+                } else {
+                    break;
+                }
             }
+            return;
         }
+
+        tbb::parallel_for(tbb::blocked_range<int>(0, count), [&](const tbb::blocked_range<int>& range) {
+            if (_abortProcessing.load()) {
+                return;
+            }
+            for (int i = range.begin(); i != range.end(); ++i) {
+                task(context, i);
+            }
+        });
     }
 };
 
@@ -455,7 +497,6 @@ void generateHDRMips(gpu::Texture* texture, QImage&& image, const std::atomic<bo
 
     const int width = localCopy.width(), height = localCopy.height();
     std::vector<glm::vec4> data;
-    std::vector<glm::vec4>::iterator dataIt;
     auto mipFormat = texture->getStoredMipFormat();
     std::function<glm::vec3(uint32)> unpackFunc;
 
@@ -494,18 +535,17 @@ void generateHDRMips(gpu::Texture* texture, QImage&& image, const std::atomic<bo
     }
 
     data.resize(width * height);
-    dataIt = data.begin();
-    for (auto lineNb = 0; lineNb < height; lineNb++) {
+    forEachRow(0, height, [&](int lineNb) {
         const uint32* srcPixelIt = reinterpret_cast<const uint32*>(localCopy.constScanLine(lineNb));
         const uint32* srcPixelEnd = srcPixelIt + width;
+        auto dataIt = data.begin() + lineNb * width;
 
         while (srcPixelIt < srcPixelEnd) {
             *dataIt = glm::vec4(unpackFunc(*srcPixelIt), 1.0f);
             ++srcPixelIt;
             ++dataIt;
         }
-    }
-    assert(dataIt == data.end());
+    });
 
     // We're done with the localCopy, free up the memory to avoid bloating the heap
     localCopy = QImage(); // QImage doesn't have a clear function, so override it with an empty one.
@@ -532,7 +572,7 @@ void generateHDRMips(gpu::Texture* texture, QImage&& image, const std::atomic<bo
     surface.setAlphaMode(alphaMode);
     surface.setWrapMode(wrapMode);
 
-    SequentialTaskDispatcher dispatcher(abortProcessing);
+    ParallelTaskDispatcher dispatcher(abortProcessing);
     nvtt::Compressor compressor;
     context.setTaskDispatcher(&dispatcher);
 
@@ -665,7 +705,7 @@ void generateLDRMips(gpu::Texture* texture, QImage&& image, const std::atomic<bo
     MyErrorHandler errorHandler;
     outputOptions.setErrorHandler(&errorHandler);
 
-    SequentialTaskDispatcher dispatcher(abortProcessing);
+    ParallelTaskDispatcher dispatcher(abortProcessing);
     nvtt::Compressor compressor;
     compressor.setTaskDispatcher(&dispatcher);
     compressor.process(inputOptions, compressionOptions, outputOptions);
@@ -815,34 +855,29 @@ QImage processBumpMap(QImage&& image) {
 
     QImage result(width, height, QImage::Format_ARGB32);
 
-    for (int i = 0; i < width; i++) {
-        const int iNextClamped = clampPixelCoordinate(i + 1, width - 1);
-        const int iPrevClamped = clampPixelCoordinate(i - 1, width - 1);
-
-        for (int j = 0; j < height; j++) {
-            const int jNextClamped = clampPixelCoordinate(j + 1, height - 1);
-            const int jPrevClamped = clampPixelCoordinate(j - 1, height - 1);
-
-            // surrounding pixels
-            const QRgb topLeft = localCopy.pixel(iPrevClamped, jPrevClamped);
-            const QRgb top = localCopy.pixel(iPrevClamped, j);
-            const QRgb topRight = localCopy.pixel(iPrevClamped, jNextClamped);
-            const QRgb right = localCopy.pixel(i, jNextClamped);
-            const QRgb bottomRight = localCopy.pixel(iNextClamped, jNextClamped);
-            const QRgb bottom = localCopy.pixel(iNextClamped, j);
-            const QRgb bottomLeft = localCopy.pixel(iNextClamped, jPrevClamped);
-            const QRgb left = localCopy.pixel(i, jPrevClamped);
-
-            // take their gray intensities
-            // since it's a grayscale image, the value of each component RGB is the same
-            const double tl = qRed(topLeft);
-            const double t = qRed(top);
-            const double tr = qRed(topRight);
-            const double r = qRed(right);
-            const double br = qRed(bottomRight);
-            const double b = qRed(bottom);
-            const double bl = qRed(bottomLeft);
-            const double l = qRed(left);
+    // walk the image a row at a time, reading the gray values straight from the scanlines
+    // scanLine() detaches, so take the pointer once rather than from every row
+    uchar* resultBits = result.bits();
+    const int resultBytesPerLine = result.bytesPerLine();
+    forEachRow(0, height, [&](int j) {
+        const uchar* prevLine = localCopy.constScanLine(clampPixelCoordinate(j - 1, height - 1));
+        const uchar* line = localCopy.constScanLine(j);
+        const uchar* nextLine = localCopy.constScanLine(clampPixelCoordinate(j + 1, height - 1));
+        QRgb* resultLine = reinterpret_cast<QRgb*>(resultBits + j * resultBytesPerLine);
+
+        for (int i = 0; i < width; i++) {
+            const int iNextClamped = clampPixelCoordinate(i + 1, width - 1);
+            const int iPrevClamped = clampPixelCoordinate(i - 1, width - 1);
+
+            // gray intensities of the surrounding pixels
+            const double tl = prevLine[iPrevClamped];
+            const double t = line[iPrevClamped];
+            const double tr = nextLine[iPrevClamped];
+            const double r = nextLine[i];
+            const double br = nextLine[iNextClamped];
+            const double b = line[iNextClamped];
+            const double bl = prevLine[iNextClamped];
+            const double l = prevLine[i];
 
             // apply the sobel filter
             const double dX = (tr + pStrength * r + br) - (tl + pStrength * l + bl);
@@ -854,9 +889,9 @@ QImage processBumpMap(QImage&& image) {
 
             // convert to rgb from the value obtained computing the filter
             QRgb qRgbValue = qRgba(mapComponent(v.z), mapComponent(v.y), mapComponent(v.x), 1.0);
-            result.setPixel(i, j, qRgbValue);
+            resultLine[i] = qRgbValue;
         }
-    }
+    });
 
     return result;
 }
@@ -1205,6 +1240,18 @@ const int CubeLayout::NUM_CUBEMAP_LAYOUTS = sizeof(CubeLayout::CUBEMAP_LAYOUTS)
 
 //#define DEBUG_COLOR_PACKING
 
+// 8 bit gamma encoded component to linear, looked up instead of calling powf for every component
+static const std::array<float, 256>& getGammaToLinearTable() {
+    static const std::array<float, 256> table = [] {
+        std::array<float, 256> values;
+        for (size_t i = 0; i < values.size(); ++i) {
+            values[i] = powf((float)i / 255.0f, 2.2f);
+        }
+        return values;
+    }();
+    return table;
+}
+
 QImage convertToHDRFormat(QImage&& srcImage, gpu::Element format) {
     // Take a local copy to force move construction
     // https://github.com/isocpp/CppCoreGuidelines/blob/master/CppCoreGuidelines.md#f18-for-consume-parameters-pass-by-x-and-stdmove-the-parameter
@@ -1236,21 +1283,21 @@ QImage convertToHDRFormat(QImage&& srcImage, gpu::Element format) {
     }
 
     localCopy = localCopy.convertToFormat(QImage::Format_ARGB32);
-    for (auto y = 0; y < localCopy.height(); y++) {
+    const auto& toLinear = getGammaToLinearTable();
+    // scanLine() detaches, so take the pointer once rather than from every row
+    uchar* hdrBits = hdrImage.bits();
+    const int hdrBytesPerLine = hdrImage.bytesPerLine();
+    forEachRow(0, localCopy.height(), [&](int y) {
         const QRgb* srcLineIt = reinterpret_cast<const QRgb*>( localCopy.constScanLine(y) );
         const QRgb* srcLineEnd = srcLineIt + localCopy.width();
-        uint32* hdrLineIt = reinterpret_cast<uint32*>( hdrImage.scanLine(y) );
+        uint32* hdrLineIt = reinterpret_cast<uint32*>( hdrBits + y * hdrBytesPerLine );
         glm::vec3 color;
 
         while (srcLineIt < srcLineEnd) {
-            color.r = qRed(*srcLineIt);
-            color.g = qGreen(*srcLineIt);
-            color.b = qBlue(*srcLineIt);
             // Normalize and apply gamma
-            color /= 255.0f;
-            color.r = powf(color.r, 2.2f);
-            color.g = powf(color.g, 2.2f);
-            color.b = powf(color.b, 2.2f);
+            color.r = toLinear[qRed(*srcLineIt)];
+            color.g = toLinear[qGreen(*srcLineIt)];
+            color.b = toLinear[qBlue(*srcLineIt)];
             *hdrLineIt = packFunc(color);
 #ifdef DEBUG_COLOR_PACKING
             glm::vec3 ucolor = unpackFunc(*hdrLineIt);
@@ -1259,7 +1306,7 @@ QImage convertToHDRFormat(QImage&& srcImage, gpu::Element format) {
             ++srcLineIt;
             ++hdrLineIt;
         }
-    }
+    });
     return hdrImage;
 }
 
@@ -92,6 +92,10 @@ void setNormalTexturesCompressionEnabled(bool enabled);
 void setGrayscaleTexturesCompressionEnabled(bool enabled);
 void setCubeTexturesCompressionEnabled(bool enabled);
 
+// Conversions and compression are split across threads unless this is disabled, on by default
+bool isParallelTextureProcessingEnabled();
+void setParallelTextureProcessingEnabled(bool enabled);
+
 gpu::TexturePointer processImage(QByteArray&& content, const std::string& url,
                                  int maxNumPixels, TextureUsage::Type textureType,
                                  const std::atomic<bool>& abortProcessing = false);
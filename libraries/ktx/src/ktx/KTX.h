@@ -87,6 +87,12 @@ namespace ktx {
     // FIXME move out of this header, not specific to ktx
     const std::string HIFI_MIN_POPULATED_MIP_KEY { "hifi.minMip" };
 
+    // Present when every level is stored as one deflated block instead of raw faces.  The value is the scheme
+    // followed by the compressed size of each level, all uint32.  Each level is still laid out as a uint32 size
+    // followed by padded data, but the size and data are the compressed ones.
+    const std::string HIFI_SUPERCOMPRESSION_KEY { "hifi.supercompression" };
+    static const uint32_t SUPERCOMPRESSION_SCHEME_ZLIB { 1 };
+
 
     using Byte = uint8_t;
 
@@ -309,6 +315,13 @@ namespace ktx {
 
     using Images = std::vector<Image>;
 
+    // Where a level of a supercompressed KTX is, relative to the end of the key values
+    struct SupercompressedImage {
+        size_t _imageOffset;
+        uint32_t _imageSize;
+    };
+    using SupercompressedImages = std::vector<SupercompressedImage>;
+
     class KTX;
 
     // A KTX descriptor is a lightweight container for all the information about a serialized KTX file, but without the
@@ -364,6 +377,16 @@ namespace ktx {
         static KeyValues parseKeyValues(size_t srcSize, const Byte* srcBytes);
         static Images parseImages(const Header& header, size_t srcSize, const Byte* srcBytes);
 
+        // Supercompression, see HIFI_SUPERCOMPRESSION_KEY.  create(src) decompresses transparently, so a KTX object
+        // always holds raw images.
+        static StoragePointer supercompress(const KTX& ktx);
+        static std::unique_ptr<KTX> decompress(const StoragePointer& src);
+        static bool isSupercompressed(const KeyValues& keyValues);
+        // Returns an empty index if the key is missing or doesn't describe every level of header
+        static SupercompressedImages getSupercompressedImages(const Header& header, const KeyValues& keyValues);
+        // Inflates one level into destBytes, fails unless it fills exactly destByteSize
+        static bool decompressImage(const Byte* srcBytes, size_t srcSize, Byte* destBytes, size_t destByteSize);
+
         // Access raw pointers to the main sections of the KTX
         const Header& getHeader() const;
 
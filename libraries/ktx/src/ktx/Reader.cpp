@@ -200,6 +200,9 @@ namespace ktx {
 
         // read metadata
         result->_keyValues = parseKeyValues(result->getHeader().bytesOfKeyValueData, result->getKeyValueData());
+        if (isSupercompressed(result->_keyValues)) {
+            return decompress(src);
+        }
 
         // populate image table
         result->_images = parseImages(result->getHeader(), result->getTexelsDataSize(), result->getTexelsData());
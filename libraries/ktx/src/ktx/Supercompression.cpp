@@ -0,0 +1,165 @@
+//
+//  Supercompression.cpp
+//  ktx/src/ktx
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "KTX.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <QtCore/QDebug>
+
+#include <zlib.h>
+
+using namespace ktx;
+
+// BCn blocks deflate slowly, but a texture is baked once and downloaded many times
+static const int SUPERCOMPRESSION_LEVEL { Z_BEST_COMPRESSION };
+
+static KeyValues::const_iterator findSupercompressionKey(const KeyValues& keyValues) {
+    return std::find_if(keyValues.begin(), keyValues.end(), [](const KeyValue& keyValue) {
+        return keyValue._key == HIFI_SUPERCOMPRESSION_KEY;
+    });
+}
+
+bool KTX::isSupercompressed(const KeyValues& keyValues) {
+    return findSupercompressionKey(keyValues) != keyValues.end();
+}
+
+SupercompressedImages KTX::getSupercompressedImages(const Header& header, const KeyValues& keyValues) {
+    auto found = findSupercompressionKey(keyValues);
+    if (found == keyValues.end()) {
+        return SupercompressedImages();
+    }
+
+    const auto& value = found->_value;
+    const size_t numWords = value.size() / sizeof(uint32_t);
+    if (value.size() % sizeof(uint32_t) != 0 || numWords != header.getNumberOfLevels() + 1) {
+        qWarning() << "Supercompressed KTX has a malformed level index";
+        return SupercompressedImages();
+    }
+
+    std::vector<uint32_t> words(numWords);
+    memcpy(words.data(), value.data(), value.size());
+    if (words[0] != SUPERCOMPRESSION_SCHEME_ZLIB) {
+        qWarning() << "Unknown KTX supercompression scheme" << words[0];
+        return SupercompressedImages();
+    }
+
+    SupercompressedImages images;
+    size_t imageOffset = 0;
+    for (size_t i = 1; i < numWords; ++i) {
+        images.push_back({ imageOffset, words[i] });
+        imageOffset += IMAGE_SIZE_WIDTH + evalPaddedSize(words[i]);
+    }
+    return images;
+}
+
+bool KTX::decompressImage(const Byte* srcBytes, size_t srcSize, Byte* destBytes, size_t destByteSize) {
+    uLongf destLength = (uLongf)destByteSize;
+    auto result = uncompress(destBytes, &destLength, srcBytes, (uLong)srcSize);
+    if (result != Z_OK || destLength != destByteSize) {
+        qWarning() << "Unable to decompress KTX level, zlib error" << result;
+        return false;
+    }
+    return true;
+}
+
+StoragePointer KTX::supercompress(const KTX& ktx) {
+    if (isSupercompressed(ktx._keyValues)) {
+        return nullptr;
+    }
+
+    std::vector<std::vector<Byte>> compressedImages;
+    std::vector<uint32_t> index { SUPERCOMPRESSION_SCHEME_ZLIB };
+    size_t imagesSize = 0;
+    for (const auto& image : ktx._images) {
+        // the faces of a level are contiguous, so a level is compressed in one go
+        if (image._faceBytes.empty() || !image._faceBytes[0]) {
+            return nullptr;
+        }
+        uLongf compressedSize = compressBound(image._imageSize);
+        std::vector<Byte> compressed(compressedSize);
+        if (compress2(compressed.data(), &compressedSize, image._faceBytes[0], image._imageSize,
+                      SUPERCOMPRESSION_LEVEL) != Z_OK || compressedSize > std::numeric_limits<uint32_t>::max()) {
+            qWarning() << "Unable to supercompress KTX level" << compressedImages.size();
+            return nullptr;
+        }
+        compressed.resize(compressedSize);
+        index.push_back((uint32_t)compressedSize);
+        imagesSize += IMAGE_SIZE_WIDTH + evalPaddedSize(compressedSize);
+        compressedImages.push_back(std::move(compressed));
+    }
+
+    KeyValues keyValues = ktx._keyValues;
+    keyValues.emplace_back(HIFI_SUPERCOMPRESSION_KEY, (uint32_t)(index.size() * sizeof(uint32_t)),
+                           reinterpret_cast<const Byte*>(index.data()));
+
+    Header header = ktx._header;
+    header.bytesOfKeyValueData = KeyValue::serializedKeyValuesByteSize(keyValues);
+
+    // the storage is zero filled, which takes care of the padding
+    auto storage = std::make_shared<storage::MemoryStorage>(sizeof(Header) + header.bytesOfKeyValueData + imagesSize);
+    Byte* destBytes = storage->data();
+    memcpy(destBytes, &header, sizeof(Header));
+    destBytes += sizeof(Header);
+    destBytes += writeKeyValues(destBytes, header.bytesOfKeyValueData, keyValues);
+    for (const auto& compressed : compressedImages) {
+        uint32_t imageSize = (uint32_t)compressed.size();
+        memcpy(destBytes, &imageSize, IMAGE_SIZE_WIDTH);
+        destBytes += IMAGE_SIZE_WIDTH;
+        memcpy(destBytes, compressed.data(), compressed.size());
+        destBytes += evalPaddedSize(compressed.size());
+    }
+    return storage;
+}
+
+std::unique_ptr<KTX> KTX::decompress(const StoragePointer& src) {
+    if (!src || !(*src) || !checkHeaderFromStorage(src->size(), src->data())) {
+        return nullptr;
+    }
+
+    const Header& srcHeader = *reinterpret_cast<const Header*>(src->data());
+    const Byte* srcImages = src->data() + sizeof(Header) + srcHeader.bytesOfKeyValueData;
+    const size_t srcImagesSize = src->size() - sizeof(Header) - srcHeader.bytesOfKeyValueData;
+
+    auto keyValues = parseKeyValues(srcHeader.bytesOfKeyValueData, src->data() + sizeof(Header));
+    auto compressedImages = getSupercompressedImages(srcHeader, keyValues);
+    auto descriptors = srcHeader.generateImageDescriptors();
+    if (compressedImages.empty() || compressedImages.size() != descriptors.size()) {
+        return nullptr;
+    }
+    keyValues.remove_if([](const KeyValue& keyValue) { return keyValue._key == HIFI_SUPERCOMPRESSION_KEY; });
+
+    auto storageSize = evalStorageSize(srcHeader, descriptors, keyValues);
+    auto storage = std::make_shared<storage::MemoryStorage>(storageSize);
+    writeWithoutImages(storage->data(), storageSize, srcHeader, descriptors, keyValues);
+    const auto& header = *reinterpret_cast<const Header*>(storage->data());
+    Byte* destImages = storage->data() + sizeof(Header) + header.bytesOfKeyValueData;
+
+    for (size_t level = 0; level < descriptors.size(); ++level) {
+        const auto& compressed = compressedImages[level];
+        const auto& descriptor = descriptors[level];
+        if (compressed._imageOffset + IMAGE_SIZE_WIDTH + compressed._imageSize > srcImagesSize) {
+            qWarning() << "Supercompressed KTX is truncated at level" << level;
+            return nullptr;
+        }
+        uint32_t imageSize;
+        memcpy(&imageSize, srcImages + compressed._imageOffset, IMAGE_SIZE_WIDTH);
+        if (imageSize != compressed._imageSize) {
+            qWarning() << "Supercompressed KTX level" << level << "doesn't match its index";
+            return nullptr;
+        }
+        if (!decompressImage(srcImages + compressed._imageOffset + IMAGE_SIZE_WIDTH, compressed._imageSize,
+                             destImages + descriptor._imageOffset + IMAGE_SIZE_WIDTH, descriptor._imageSize)) {
+            return nullptr;
+        }
+    }
+
+    return create(storage);
+}
@@ -352,6 +352,17 @@ bool KTX::validate(const StoragePointer& src) {
         return false;
     }
 
+    auto keyValues = parseKeyValues(header.bytesOfKeyValueData, src->data() + sizeof(Header));
+    bool supercompressed = isSupercompressed(keyValues);
+    SupercompressedImages supercompressedImages;
+    if (supercompressed) {
+        supercompressedImages = getSupercompressedImages(header, keyValues);
+        if (supercompressedImages.size() != header.numberOfMipmapLevels) {
+            qDebug() << "Invalid supercompression index";
+            return false;
+        }
+    }
+
 
     // Validate the images
     for (uint32_t mip = 0; mip < header.numberOfMipmapLevels; ++mip) {
@@ -361,6 +372,19 @@ bool KTX::validate(const StoragePointer& src) {
             return false;
         }
 
+        // A supercompressed level is a single block holding every face
+        if (supercompressed) {
+            if (imageSize != supercompressedImages[mip]._imageSize) {
+                qDebug() << "Supercompressed image size doesn't match the index";
+                return false;
+            }
+            if (!buffer.skip(imageSize)) {
+                qDebug() << "Unable to skip past image data";
+                return false;
+            }
+            continue;
+        }
+
         uint32_t arrayElements = header.numberOfArrayElements == 0 ? 1 : header.numberOfArrayElements;
         for (uint32_t arrayElement = 0; arrayElement < arrayElements; ++arrayElement) {
             for (uint8_t face = 0; face < header.numberOfFaces; ++face) {
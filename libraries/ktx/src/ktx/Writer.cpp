@@ -45,6 +45,8 @@ namespace ktx {
 
         Byte minMip = header.numberOfMipmapLevels;
         auto newKeyValues = keyValues;
+        // the images of a bare KTX are filled in raw
+        newKeyValues.remove_if([](const KeyValue& keyValue) { return keyValue._key == HIFI_SUPERCOMPRESSION_KEY; });
         newKeyValues.emplace_back(KeyValue(HIFI_MIN_POPULATED_MIP_KEY, sizeof(Byte), &minMip));
 
         StoragePointer storagePointer;
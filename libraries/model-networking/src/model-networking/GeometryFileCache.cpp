@@ -0,0 +1,93 @@
+//
+//  GeometryFileCache.cpp
+//  libraries/model-networking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GeometryFileCache.h"
+
+#include <QCryptographicHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <FBXSerializer.h>
+#include <SettingHandle.h>
+#include <shared/Storage.h>
+
+#include "ModelNetworkingLogging.h"
+
+using File = cache::File;
+
+// Whenever a change is made to the serialized format for the geometry cache that isn't backward compatible,
+// this value should be incremented.  This will force the geometry cache to be wiped
+const int GeometryFileCache::CURRENT_VERSION = FBXSerializer::VERSION;
+const int GeometryFileCache::INVALID_VERSION = 0x00;
+const char* GeometryFileCache::SETTING_VERSION_NAME = "hifi.geometry.cache_version";
+
+GeometryFileCache::GeometryFileCache(const std::string& dir, const std::string& ext) :
+    FileCache(dir, ext) { }
+
+void GeometryFileCache::initialize() {
+    FileCache::initialize();
+    Setting::Handle<int> cacheVersionHandle(SETTING_VERSION_NAME, INVALID_VERSION);
+    auto cacheVersion = cacheVersionHandle.get();
+    if (cacheVersion != CURRENT_VERSION) {
+        wipe();
+        cacheVersionHandle.set(CURRENT_VERSION);
+    }
+}
+
+// The keys of a JSON object are sorted, unlike the iteration order of a QHash.  Every value of the keys the FST
+// reader inserts more than once goes in an array, QJsonObject::fromVariantHash would keep only one of them.
+static QJsonValue mappingToJson(const QVariant& value) {
+    if (value.type() != QVariant::Hash) {
+        return QJsonValue::fromVariant(value);
+    }
+    QVariantHash mapping = value.toHash();
+    QJsonObject object;
+    for (const QString& key : mapping.uniqueKeys()) {
+        QJsonArray values;
+        for (const QVariant& keyValue : mapping.values(key)) {
+            values.append(mappingToJson(keyValue));
+        }
+        object.insert(key, values);
+    }
+    return object;
+}
+
+GeometryFileCache::Key GeometryFileCache::getKey(const QString& contentHash, const QVariantHash& mapping) {
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(contentHash.toLatin1());
+    hash.addData(QJsonDocument(mappingToJson(mapping).toObject()).toJson(QJsonDocument::Compact));
+    return hash.result().toHex().toStdString();
+}
+
+FBXGeometry::Pointer GeometryFileCache::readGeometry(const Key& key, const QString& url) {
+    // holding the file keeps it from being evicted while it is read
+    auto file = getFile(key);
+    if (!file) {
+        return nullptr;
+    }
+
+    storage::FileStorage storage(QString::fromStdString(file->getFilepath()));
+    if (!storage) {
+        qCWarning(modelnetworking) << "Failed to map cached geometry for" << url;
+        return nullptr;
+    }
+    return FBXSerializer::deserialize(storage.data(), storage.size(), url);
+}
+
+bool GeometryFileCache::writeGeometry(const Key& key, const FBXGeometry& geometry) {
+    QByteArray data = FBXSerializer::serialize(geometry);
+    return (bool)writeFile(data.constData(), Metadata(key, data.size()));
+}
+
+std::unique_ptr<File> GeometryFileCache::createFile(Metadata&& metadata, const std::string& filepath) {
+    qCInfo(file_cache) << "Wrote geometry" << metadata.key.c_str();
+    return FileCache::createFile(std::move(metadata), filepath);
+}
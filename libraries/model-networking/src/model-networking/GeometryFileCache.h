@@ -0,0 +1,49 @@
+//
+//  GeometryFileCache.h
+//  libraries/model-networking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_GeometryFileCache_h
+#define hifi_GeometryFileCache_h
+
+#include <QString>
+#include <QVariantHash>
+
+#include <shared/FileCache.h>
+
+#include <FBX.h>
+
+// On disk cache of parsed model geometry, the counterpart of the KTXCache for models.  Entries are keyed by the
+// content of the model file and the FST mapping it was read with, so the same model at another URL, or from the
+// ATP hash of the model, is read back without parsing.
+class GeometryFileCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    // Whenever a change is made to the serialized format for the geometry cache that isn't backward compatible,
+    // this value should be incremented.  This will force the geometry cache to be wiped
+    static const int CURRENT_VERSION;
+    static const int INVALID_VERSION;
+    static const char* SETTING_VERSION_NAME;
+
+    GeometryFileCache(const std::string& dir, const std::string& ext);
+
+    void initialize() override;
+
+    // contentHash is the hex SHA-256 of the model file, the same as its ATP hash
+    static Key getKey(const QString& contentHash, const QVariantHash& mapping);
+
+    // Returns nullptr if there is no such entry, the entry is memory mapped and copied straight into the geometry
+    FBXGeometry::Pointer readGeometry(const Key& key, const QString& url);
+    bool writeGeometry(const Key& key, const FBXGeometry& geometry);
+
+protected:
+    std::unique_ptr<cache::File> createFile(Metadata&& metadata, const std::string& filepath) override final;
+};
+
+#endif // hifi_GeometryFileCache_h
@@ -10,6 +10,7 @@
 //
 
 #include "ModelCache.h"
+#include <AssetUtils.h>
 #include <Finally.h>
 #include <FSTReader.h>
 #include "FBXReader.h"
@@ -101,6 +102,7 @@ void GeometryMappingResource::downloadFinished(const QByteArray& data) {
         _geometryResource = modelCache->getResource(url, QUrl(), &extra).staticCast<GeometryResource>();
         // Avoid caching nested resources - their references will be held by the parent
         _geometryResource->_isCacheable = false;
+        _geometryResource->inheritLoadPriorities(*this);
 
         if (_geometryResource->isLoaded()) {
             onGeometryMappingLoaded(!_geometryResource->getURL().isEmpty());
@@ -134,9 +136,11 @@ void GeometryMappingResource::onGeometryMappingLoaded(bool success) {
 
 class GeometryReader : public QRunnable {
 public:
+    // data may be empty when the content hash is known, for a model that is read from the geometry file cache
     GeometryReader(QWeakPointer<Resource>& resource, const QUrl& url, const QVariantHash& mapping,
-                   const QByteArray& data, bool combineParts) :
-        _resource(resource), _url(url), _mapping(mapping), _data(data), _combineParts(combineParts) {
+                   const QByteArray& data, bool combineParts, const QString& contentHash = QString()) :
+        _resource(resource), _url(url), _mapping(mapping), _data(data), _combineParts(combineParts),
+        _contentHash(contentHash) {
 
         DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
     }
@@ -149,6 +153,7 @@ private:
     QVariantHash _mapping;
     QByteArray _data;
     bool _combineParts;
+    QString _contentHash;
 };
 
 void GeometryReader::run() {
@@ -170,7 +175,7 @@ void GeometryReader::run() {
     }
 
     try {
-        if (_data.isEmpty()) {
+        if (_data.isEmpty() && _contentHash.isEmpty()) {
             throw QString("reply is NULL");
         }
 
@@ -185,9 +190,30 @@ void GeometryReader::run() {
             FBXGeometry::Pointer fbxGeometry;
 
             if (_url.path().toLower().endsWith(".fbx")) {
-                fbxGeometry.reset(readFBX(_data, _mapping, _url.path()));
-                if (fbxGeometry->meshes.size() == 0 && fbxGeometry->joints.size() == 0) {
-                    throw QString("empty geometry, possibly due to an unsupported FBX version");
+                // An FBX file is self contained, so its parsed geometry is cached on disk by content.  Other
+                // formats reference files beside them (.mtl, .bin) which may change on their own.
+                auto geometryFileCache = DependencyManager::get<ModelCache>()->getGeometryFileCache();
+                QString contentHash = _contentHash.isEmpty() ? QString(AssetUtils::hashData(_data).toHex()) : _contentHash;
+                auto cacheKey = GeometryFileCache::getKey(contentHash, _mapping);
+                fbxGeometry = geometryFileCache->readGeometry(cacheKey, _url.path());
+
+                if (!fbxGeometry) {
+                    if (_data.isEmpty()) {
+                        // the entry was evicted since the resource found it, so the model has to be downloaded
+                        auto resource = _resource.toStrongRef();
+                        if (resource) {
+                            QMetaObject::invokeMethod(resource.data(), "requestWithoutGeometryFileCache");
+                        }
+                        return;
+                    }
+
+                    fbxGeometry.reset(readFBX(_data, _mapping, _url.path()));
+                    if (fbxGeometry->meshes.size() == 0 && fbxGeometry->joints.size() == 0) {
+                        throw QString("empty geometry, possibly due to an unsupported FBX version");
+                    }
+                    if (!geometryFileCache->writeGeometry(cacheKey, *fbxGeometry)) {
+                        qCWarning(modelnetworking) << "Failed to cache the geometry of" << _url;
+                    }
                 }
             } else if (_url.path().toLower().endsWith(".obj")) {
                 fbxGeometry = OBJReader().readOBJ(_data, _mapping, _combineParts, _url);
@@ -243,13 +269,41 @@ public:
     virtual void downloadFinished(const QByteArray& data) override;
 
 protected:
+    virtual void makeRequest() override;
+
     Q_INVOKABLE void setGeometryDefinition(FBXGeometry::Pointer fbxGeometry);
+    Q_INVOKABLE void requestWithoutGeometryFileCache();
 
 private:
     QVariantHash _mapping;
     bool _combineParts;
+    bool _skipGeometryFileCache { false };
 };
 
+void GeometryDefinitionResource::makeRequest() {
+    // A model addressed by its ATP hash is known by content before it is downloaded, so there is nothing
+    // to download when its geometry is in the file cache
+    auto contentHash = AssetUtils::extractAssetHash(_activeUrl.toString()).toLower();
+    if (!_skipGeometryFileCache && !contentHash.isEmpty() && _activeUrl.path().toLower().endsWith(".fbx")) {
+        auto cacheKey = GeometryFileCache::getKey(contentHash, _mapping);
+        auto file = DependencyManager::get<ModelCache>()->getGeometryFileCache()->getFile(cacheKey);
+        if (file) {
+            ResourceCache::requestCompleted(_self);
+            emit loading();
+            setSize(file->getLength());
+            QThreadPool::globalInstance()->start(new GeometryReader(_self, _activeUrl, _mapping, QByteArray(),
+                                                                    _combineParts, contentHash));
+            return;
+        }
+    }
+    GeometryResource::makeRequest();
+}
+
+void GeometryDefinitionResource::requestWithoutGeometryFileCache() {
+    _skipGeometryFileCache = true;
+    attemptRequest();
+}
+
 void GeometryDefinitionResource::downloadFinished(const QByteArray& data) {
     if (_url != _effectiveBaseURL) {
         _url = _effectiveBaseURL;
@@ -268,6 +322,7 @@ void GeometryDefinitionResource::setGeometryDefinition(FBXGeometry::Pointer fbxG
         materialIDAtlas[material.materialID] = _materials.size();
         _materials.push_back(std::make_shared<NetworkMaterial>(material, _textureBaseUrl));
     }
+    inheritTextureLoadPriorities(*this);
 
     std::shared_ptr<GeometryMeshes> meshes = std::make_shared<GeometryMeshes>();
     std::shared_ptr<GeometryMeshParts> parts = std::make_shared<GeometryMeshParts>();
@@ -289,7 +344,11 @@ void GeometryDefinitionResource::setGeometryDefinition(FBXGeometry::Pointer fbxG
     finishedLoading(true);
 }
 
+const std::string ModelCache::GEOMETRY_CACHE_DIRNAME { "geometry_cache" };
+const std::string ModelCache::GEOMETRY_CACHE_EXT { "hfg" };
+
 ModelCache::ModelCache() {
+    _geometryFileCache->initialize();
     const qint64 GEOMETRY_DEFAULT_UNUSED_MAX_SIZE = DEFAULT_UNUSED_MAX_SIZE;
     setUnusedResourceCacheSize(GEOMETRY_DEFAULT_UNUSED_MAX_SIZE);
     setObjectName("ModelCache");
@@ -440,6 +499,16 @@ void GeometryResource::deleter() {
     Resource::deleter();
 }
 
+void Geometry::inheritTextureLoadPriorities(Resource& resource) {
+    for (const auto& material : _materials) {
+        for (const auto& texture : material->_textures) {
+            if (texture.texture) {
+                texture.texture->inheritLoadPriorities(resource);
+            }
+        }
+    }
+}
+
 void GeometryResource::setTextures() {
     if (_fbxGeometry) {
         for (const FBXMaterial& material : _fbxGeometry->materials) {
@@ -19,6 +19,7 @@
 #include <graphics/Asset.h>
 
 #include "FBXReader.h"
+#include "GeometryFileCache.h"
 #include "TextureCache.h"
 
 // Alias instead of derive to avoid copying
@@ -59,6 +60,9 @@ public:
 protected:
     friend class GeometryMappingResource;
 
+    // Textures load in the order of the models they are on
+    void inheritTextureLoadPriorities(Resource& resource);
+
     // Shared across all geometries, constant throughout lifetime
     std::shared_ptr<const FBXGeometry> _fbxGeometry;
     std::shared_ptr<const GeometryMeshes> _meshes;
@@ -145,6 +149,8 @@ public:
                                                            const QVariantHash& mapping = QVariantHash(),
                                                            const QUrl& textureBaseUrl = QUrl());
 
+    const std::shared_ptr<GeometryFileCache>& getGeometryFileCache() const { return _geometryFileCache; }
+
 protected:
     friend class GeometryMappingResource;
 
@@ -154,6 +160,11 @@ protected:
 private:
     ModelCache();
     virtual ~ModelCache() = default;
+
+    static const std::string GEOMETRY_CACHE_DIRNAME;
+    static const std::string GEOMETRY_CACHE_EXT;
+    std::shared_ptr<GeometryFileCache> _geometryFileCache {
+        std::make_shared<GeometryFileCache>(GEOMETRY_CACHE_DIRNAME, GEOMETRY_CACHE_EXT) };
 };
 
 class NetworkMaterial : public graphics::Material {
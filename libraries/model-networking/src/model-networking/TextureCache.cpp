@@ -66,6 +66,10 @@ static const QUrl HMD_PREVIEW_FRAME_URL("resource://hmdPreviewFrame");
 static const float SKYBOX_LOAD_PRIORITY { 10.0f }; // Make sure skybox loads first
 static const float HIGH_MIPS_LOAD_PRIORITY { 9.0f }; // Make sure high mips loads after skybox but before models
 
+// The initial load of a KTX fetches the header and the high mips, from each end of the file
+static const int KTX_HEADER_REQUEST_SIZE { 1000 };
+static const int HIGH_MIP_MAX_SIZE { 5516 };
+
 TextureCache::TextureCache() {
     _ktxCache->initialize();
 #if defined(DISABLE_KTX_CACHE)
@@ -433,7 +437,7 @@ void NetworkTexture::makeRequest() {
 
         ByteRange range;
         range.fromInclusive = 0;
-        range.toExclusive = 1000;
+        range.toExclusive = KTX_HEADER_REQUEST_SIZE;
         _ktxHeaderRequest->setByteRange(range);
 
         emit loading();
@@ -461,6 +465,24 @@ void NetworkTexture::makeRequest() {
 
 }
 
+qint64 NetworkTexture::evalExpectedRequestSize() const {
+    if (!_sourceIsKTX || isLocalUrl(_url)) {
+        return Resource::evalExpectedRequestSize();
+    }
+
+    if (_ktxResourceState == PENDING_INITIAL_LOAD) {
+        return KTX_HEADER_REQUEST_SIZE + HIGH_MIP_MAX_SIZE;
+    } else if (_ktxResourceState == PENDING_MIP_REQUEST && _originalKtxDescriptor &&
+               _lowestKnownPopulatedMip > 0 && _lowestKnownPopulatedMip < _originalKtxDescriptor->images.size()) {
+        uint16_t nextMip = _lowestKnownPopulatedMip - 1;
+        if (!_supercompressedImages.empty()) {
+            return _supercompressedImages[nextMip]._imageSize;
+        }
+        return _originalKtxDescriptor->images[nextMip + 1]._imageOffset - _originalKtxDescriptor->images[nextMip]._imageOffset;
+    }
+    return 0;
+}
+
 void NetworkTexture::handleLocalRequestCompleted() {
     TextureCache::requestCompleted(_self);
 }
@@ -573,6 +595,11 @@ void NetworkTexture::startRequestForNextMipLevel() {
     }
 }
 
+void NetworkTexture::setOriginalDescriptor(ktx::KTXDescriptor* descriptor) {
+    _originalKtxDescriptor.reset(descriptor);
+    _supercompressedImages = ktx::KTX::getSupercompressedImages(descriptor->header, descriptor->keyValues);
+}
+
 // Load mips in the range [low, high] (inclusive)
 void NetworkTexture::startMipRangeRequest(uint16_t low, uint16_t high) {
     if (_ktxMipRequest) {
@@ -592,13 +619,22 @@ void NetworkTexture::startMipRangeRequest(uint16_t low, uint16_t high) {
 
     _ktxMipLevelRangeInFlight = { low, high };
     if (isHighMipRequest) {
-        static const int HIGH_MIP_MAX_SIZE = 5516;
         // This is a special case where we load the high 7 mips
         ByteRange range;
         range.fromInclusive = -HIGH_MIP_MAX_SIZE;
         _ktxMipRequest->setByteRange(range);
 
         connect(_ktxMipRequest, &ResourceRequest::finished, this, &NetworkTexture::ktxInitialDataRequestFinished);
+    } else if (!_supercompressedImages.empty()) {
+        ByteRange range;
+        range.fromInclusive = ktx::KTX_HEADER_SIZE + _originalKtxDescriptor->header.bytesOfKeyValueData
+                              + _supercompressedImages[low]._imageOffset + ktx::IMAGE_SIZE_WIDTH;
+        range.toExclusive = ktx::KTX_HEADER_SIZE + _originalKtxDescriptor->header.bytesOfKeyValueData
+                              + _supercompressedImages[high]._imageOffset + ktx::IMAGE_SIZE_WIDTH
+                              + _supercompressedImages[high]._imageSize;
+        _ktxMipRequest->setByteRange(range);
+
+        connect(_ktxMipRequest, &ResourceRequest::finished, this, &NetworkTexture::ktxMipRequestFinished);
     } else {
         ByteRange range;
         range.fromInclusive = ktx::KTX_HEADER_SIZE + _originalKtxDescriptor->header.bytesOfKeyValueData
@@ -707,8 +743,10 @@ void NetworkTexture::ktxMipRequestFinished() {
             auto data = _ktxMipRequest->getData();
             auto mipLevel = _ktxMipLevelRangeInFlight.first;
             auto texture = _textureSource->getGPUTexture();
+            bool isSupercompressed = !_supercompressedImages.empty();
+            size_t mipSize = _originalKtxDescriptor->images[mipLevel]._imageSize;
             DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
-            QtConcurrent::run(QThreadPool::globalInstance(), [self, data, mipLevel, url, texture] {
+            QtConcurrent::run(QThreadPool::globalInstance(), [self, data, mipLevel, url, texture, isSupercompressed, mipSize] {
                 PROFILE_RANGE_EX(resource_parse_image, "NetworkTexture - Processing Mip Data", 0xffff0000, 0, { { "url", url.toString() } });
                 DependencyManager::get<StatTracker>()->decrementStat("PendingProcessing");
                 CounterStat counter("Processing");
@@ -728,7 +766,17 @@ void NetworkTexture::ktxMipRequestFinished() {
 
                 Q_ASSERT_X(texture, "Async - NetworkTexture::ktxMipRequestFinished", "NetworkTexture should have been assigned a GPU texture by now.");
 
-                texture->assignStoredMip(mipLevel, data.size(), reinterpret_cast<const uint8_t*>(data.data()));
+                if (isSupercompressed) {
+                    std::vector<uint8_t> mipData(mipSize);
+                    if (!ktx::KTX::decompressImage(reinterpret_cast<const uint8_t*>(data.data()), data.size(),
+                                                   mipData.data(), mipData.size())) {
+                        qCWarning(modelnetworking) << "Failed to decompress mip" << mipLevel << "of" << url;
+                        return;
+                    }
+                    texture->assignStoredMip(mipLevel, mipData.size(), mipData.data());
+                } else {
+                    texture->assignStoredMip(mipLevel, data.size(), reinterpret_cast<const uint8_t*>(data.data()));
+                }
 
                 // If mip level assigned above is still unavailable, then we assume future requests will also fail.
                 auto minMipLevel = texture->minAvailableMipLevel();
@@ -826,6 +874,17 @@ void NetworkTexture::handleFinishedInitialLoad() {
                 Q_ARG(int, 0));
             return;
         }
+
+        auto supercompressedImages = ktx::KTX::getSupercompressedImages(*header, keyValues);
+        if (ktx::KTX::isSupercompressed(keyValues) && supercompressedImages.size() != imageDescriptors.size()) {
+            qWarning(networking) << "Cannot load " << url << ", unsupported or malformed supercompression";
+            QMetaObject::invokeMethod(resource.data(), "setImage",
+                Q_ARG(gpu::TexturePointer, nullptr),
+                Q_ARG(int, 0),
+                Q_ARG(int, 0));
+            return;
+        }
+
         auto originalKtxDescriptor = new ktx::KTXDescriptor(*header, keyValues, imageDescriptors);
         QMetaObject::invokeMethod(resource.data(), "setOriginalDescriptor",
             Q_ARG(ktx::KTXDescriptor*, originalKtxDescriptor));
@@ -902,16 +961,36 @@ void NetworkTexture::handleFinishedInitialLoad() {
             size_t imageSizeRemaining = ktxHighMipData.size();
             const uint8_t* ktxData = reinterpret_cast<const uint8_t*>(ktxHighMipData.data());
             ktxData += ktxHighMipData.size();
-            // TODO Move image offset calculation to ktx ImageDescriptor
-            for (int level = static_cast<int>(images.size()) - 1; level >= 0; --level) {
-                auto& image = images[level];
-                if (image._imageSize > imageSizeRemaining) {
-                    break;
+            if (!supercompressedImages.empty()) {
+                // the high mips come in compressed, which fits more of them in the same range
+                std::vector<uint8_t> mipData;
+                for (int level = static_cast<int>(images.size()) - 1; level >= 0; --level) {
+                    auto& compressedImage = supercompressedImages[level];
+                    size_t paddedSize = ktx::evalPaddedSize(compressedImage._imageSize);
+                    if (paddedSize + ktx::IMAGE_SIZE_WIDTH > imageSizeRemaining) {
+                        break;
+                    }
+                    ktxData -= paddedSize;
+                    mipData.resize(images[level]._imageSize);
+                    if (!ktx::KTX::decompressImage(ktxData, compressedImage._imageSize, mipData.data(), mipData.size())) {
+                        break;
+                    }
+                    texture->assignStoredMip(static_cast<gpu::uint16>(level), mipData.size(), mipData.data());
+                    ktxData -= ktx::IMAGE_SIZE_WIDTH;
+                    imageSizeRemaining -= (paddedSize + ktx::IMAGE_SIZE_WIDTH);
+                }
+            } else {
+                // TODO Move image offset calculation to ktx ImageDescriptor
+                for (int level = static_cast<int>(images.size()) - 1; level >= 0; --level) {
+                    auto& image = images[level];
+                    if (image._imageSize > imageSizeRemaining) {
+                        break;
+                    }
+                    ktxData -= image._imageSize;
+                    texture->assignStoredMip(static_cast<gpu::uint16>(level), image._imageSize, ktxData);
+                    ktxData -= ktx::IMAGE_SIZE_WIDTH;
+                    imageSizeRemaining -= (image._imageSize + ktx::IMAGE_SIZE_WIDTH);
                 }
-                ktxData -= image._imageSize;
-                texture->assignStoredMip(static_cast<gpu::uint16>(level), image._imageSize, ktxData);
-                ktxData -= ktx::IMAGE_SIZE_WIDTH;
-                imageSizeRemaining -= (image._imageSize + ktx::IMAGE_SIZE_WIDTH);
             }
 
             // We replace the texture with the one stored in the cache.  This deals with the possible race condition of two different
@@ -59,7 +59,7 @@ public:
 
     void refresh() override;
 
-    Q_INVOKABLE void setOriginalDescriptor(ktx::KTXDescriptor* descriptor) { _originalKtxDescriptor.reset(descriptor); }
+    Q_INVOKABLE void setOriginalDescriptor(ktx::KTXDescriptor* descriptor);
 
 signals:
     void networkTextureCreated(const QWeakPointer<NetworkTexture>& self);
@@ -71,6 +71,7 @@ public slots:
 protected:
     void makeRequest() override;
     void makeLocalRequest();
+    qint64 evalExpectedRequestSize() const override;
     Q_INVOKABLE void handleLocalRequestCompleted();
 
     virtual bool isCacheable() const override { return _loaded; }
@@ -122,6 +123,8 @@ private:
     // in its key/value data, and so will not match up with the original, causing
     // mip offsets to change.
     ktx::KTXDescriptorPointer _originalKtxDescriptor;
+    // where each level is in the file when it is supercompressed, empty otherwise
+    ktx::SupercompressedImages _supercompressedImages;
 
 
     int _originalWidth { 0 };
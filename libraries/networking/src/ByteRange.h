@@ -19,6 +19,10 @@ struct ByteRange {
     bool isSet() const { return fromInclusive < 0 || fromInclusive < toExclusive; }
     int64_t size() const { return toExclusive - fromInclusive; }
 
+    // where a fixed up range starts in a file of fileSize bytes
+    // a positive range starts that far into the file, a negative range starts that far back from the end
+    int64_t offset(int64_t fileSize) const { return fromInclusive >= 0 ? fromInclusive : fileSize + fromInclusive; }
+
     // byte ranges are invalid if:
     // (1) the toExclusive of the range is negative
     // (2) the toExclusive of the range is less than the fromInclusive, and isn't zero
@@ -57,6 +57,10 @@ DomainHandler::DomainHandler(QObject* parent) :
     connect(this, &DomainHandler::connectedToDomain, &_apiRefreshTimer, &QTimer::stop);
 }
 
+NodeList* DomainHandler::getNodeList() const {
+    return static_cast<NodeList*>(parent());
+}
+
 void DomainHandler::disconnect() {
     // if we're currently connected to a domain, send a disconnect packet on our way out
     if (_isConnected) {
@@ -85,7 +89,7 @@ void DomainHandler::sendDisconnectPacket() {
     static auto disconnectPacket = NLPacket::create(PacketType::DomainDisconnectRequest, 0);
 
     // send the disconnect packet to the current domain server
-    auto nodeList = DependencyManager::get<NodeList>();
+    auto nodeList = getNodeList();
     nodeList->sendUnreliablePacket(*disconnectPacket, _sockAddr);
 }
 
@@ -137,7 +141,7 @@ void DomainHandler::setSockAddr(const HifiSockAddr& sockAddr, const QString& hos
     }
 
     if (!_sockAddr.isNull()) {
-        DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
+        getNodeList()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
     }
 
     // some callers may pass a hostname, this is not to be used for lookup but for DTLS certificate verification
@@ -183,7 +187,7 @@ void DomainHandler::setURLAndID(QUrl domainURL, QUuid domainID) {
                 qCDebug(networking, "Looking up DS hostname %s.", domainURL.host().toLocal8Bit().constData());
                 QHostInfo::lookupHost(domainURL.host(), this, SLOT(completedHostnameLookup(const QHostInfo&)));
 
-                DependencyManager::get<NodeList>()->flagTimeForConnectionStep(
+                getNodeList()->flagTimeForConnectionStep(
                     LimitedNodeList::ConnectionStep::SetDomainHostname);
 
                 UserActivityLogger::getInstance().changedDomain(domainURL.host());
@@ -217,7 +221,7 @@ void DomainHandler::setIceServerHostnameAndID(const QString& iceServerHostname,
         replaceableSockAddr = new (replaceableSockAddr) HifiSockAddr(iceServerHostname, ICE_SERVER_DEFAULT_PORT);
         _iceServerSockAddr.setObjectName("IceServer");
 
-        auto nodeList = DependencyManager::get<NodeList>();
+        auto nodeList = getNodeList();
 
         nodeList->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetICEServerHostname);
 
@@ -233,7 +237,7 @@ void DomainHandler::setIceServerHostnameAndID(const QString& iceServerHostname,
 }
 
 void DomainHandler::activateICELocalSocket() {
-    DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
+    getNodeList()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
     _sockAddr = _icePeer.getLocalSocket();
     _domainURL.setScheme(URL_SCHEME_HIFI);
     _domainURL.setHost(_sockAddr.getAddress().toString());
@@ -242,7 +246,7 @@ void DomainHandler::activateICELocalSocket() {
 }
 
 void DomainHandler::activateICEPublicSocket() {
-    DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
+    getNodeList()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
     _sockAddr = _icePeer.getPublicSocket();
     _domainURL.setScheme(URL_SCHEME_HIFI);
     _domainURL.setHost(_sockAddr.getAddress().toString());
@@ -255,7 +259,7 @@ void DomainHandler::completedHostnameLookup(const QHostInfo& hostInfo) {
         if (hostInfo.addresses()[i].protocol() == QAbstractSocket::IPv4Protocol) {
             _sockAddr.setAddress(hostInfo.addresses()[i]);
 
-            DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
+            getNodeList()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
 
             qCDebug(networking, "DS at %s is at %s", _domainURL.host().toLocal8Bit().constData(),
                    _sockAddr.getAddress().toString().toLocal8Bit().constData());
@@ -273,7 +277,7 @@ void DomainHandler::completedHostnameLookup(const QHostInfo& hostInfo) {
 void DomainHandler::completedIceServerHostnameLookup() {
     qCDebug(networking) << "ICE server socket is at" << _iceServerSockAddr;
 
-    DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetICEServerSocket);
+    getNodeList()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetICEServerSocket);
 
     // emit our signal so we can send a heartbeat to ice-server immediately
     emit iceSocketAndIDReceived();
@@ -300,12 +304,12 @@ void DomainHandler::setIsConnected(bool isConnected) {
 void DomainHandler::requestDomainSettings() {
     qCDebug(networking) << "Requesting settings from domain server";
 
-    Assignment::Type assignmentType = Assignment::typeForNodeType(DependencyManager::get<NodeList>()->getOwnerType());
+    Assignment::Type assignmentType = Assignment::typeForNodeType(getNodeList()->getOwnerType());
 
     auto packet = NLPacket::create(PacketType::DomainSettingsRequest, sizeof(assignmentType), true, false);
     packet->writePrimitive(assignmentType);
 
-    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    auto nodeList = getNodeList();
     nodeList->sendPacket(std::move(packet), _sockAddr);
 
     _settingsTimer.start();
@@ -373,7 +377,7 @@ void DomainHandler::processICEResponsePacket(QSharedPointer<ReceivedMessage> mes
 
     iceResponseStream >> _icePeer;
 
-    DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::ReceiveDSPeerInformation);
+    getNodeList()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::ReceiveDSPeerInformation);
 
     if (_icePeer.getUUID() != _pendingDomainID) {
         qCDebug(networking) << "Received a network peer with ID that does not match current domain. Will not attempt connection.";
@@ -34,6 +34,8 @@ const quint16 DOMAIN_SERVER_HTTPS_PORT = 40101;
 
 const int MAX_SILENT_DOMAIN_SERVER_CHECK_INS = 5;
 
+class NodeList;
+
 class DomainHandler : public QObject {
     Q_OBJECT
 public:
@@ -180,6 +182,9 @@ private:
     void sendDisconnectPacket();
     void hardReset();
 
+    // The NodeList this handler belongs to, which is not necessarily the one in the DependencyManager
+    NodeList* getNodeList() const;
+
     QUuid _uuid;
     QUrl _domainURL;
     HifiSockAddr _sockAddr;
@@ -580,7 +580,7 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     // emit our signal so listeners know we just heard from the DS
     emit receivedDomainServerList();
 
-    DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::ReceiveDSList);
+    flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::ReceiveDSList);
 
     QDataStream packetStream(message->getMessage());
 
@@ -205,9 +205,7 @@ void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
     if (_shouldDropPackets) {
         return;
     }
-    
-    auto nodeList = DependencyManager::get<LimitedNodeList>();
-    
+
     // setup an NLPacket from the packet we were passed
     auto nlPacket = NLPacket::fromBase(std::move(packet));
     auto receivedMessage = QSharedPointer<ReceivedMessage>::create(*nlPacket);
@@ -257,7 +255,11 @@ void PacketReceiver::handleMessageFailure(HifiSockAddr from, udt::Packet::Messag
 }
 
 void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> receivedMessage, bool justReceived) {
-    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    // look the source up in the node list that received the packet, a process can have more than one
+    auto nodeList = qobject_cast<LimitedNodeList*>(parent());
+    if (!nodeList) {
+        nodeList = DependencyManager::get<LimitedNodeList>().data();
+    }
     
     SharedNodePointer matchingNode;
     
@@ -11,8 +11,11 @@
 
 #include "ResourceCache.h"
 
+#include <algorithm>
 #include <cfloat>
+#include <climits>
 #include <cmath>
+#include <limits>
 #include <assert.h>
 
 #include <QThread>
@@ -32,22 +35,28 @@
                            (((x) > (max)) ? (max) :\
                                             (x)))
 
-void ResourceCacheSharedItems::appendActiveRequest(QWeakPointer<Resource> resource) {
+// Requests for the same importance are ordered by size, a resource twice the size of another is as good as one
+// REQUEST_SIZE_PRIORITY_COST less important.  Priorities set by owners are on the order of the angular size of
+// what they belong to (at most pi / 2) so this only separates resources that are close.
+static const float REQUEST_SIZE_PRIORITY_COST = 0.02f;
+static const qint64 REQUEST_SIZE_PRIORITY_UNIT = 64 * 1024;
+
+void ResourceCacheSharedItems::appendActiveRequest(QWeakPointer<Resource> resource, ResourceRequestBackend backend) {
     Lock lock(_mutex);
-    _loadingRequests.append(resource);
+    _loadingRequests.append({ resource, backend });
 }
 
-void ResourceCacheSharedItems::appendPendingRequest(QWeakPointer<Resource> resource) {
+void ResourceCacheSharedItems::appendPendingRequest(QWeakPointer<Resource> resource, ResourceRequestBackend backend) {
     Lock lock(_mutex);
-    _pendingRequests.append(resource);
+    _pendingRequests.append({ resource, backend });
 }
 
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach(QSharedPointer<Resource> resource, _pendingRequests) {
-        if (resource) {
+    for (const auto& request : _pendingRequests) {
+        if (auto resource = request.resource.lock()) {
             result.append(resource);
         }
     }
@@ -64,8 +73,8 @@ QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getLoadingRequests() {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach(QSharedPointer<Resource> resource, _loadingRequests) {
-        if (resource) {
+    for (const auto& request : _loadingRequests) {
+        if (auto resource = request.resource.lock()) {
             result.append(resource);
         }
     }
@@ -78,6 +87,21 @@ uint32_t ResourceCacheSharedItems::getLoadingRequestsCount() const {
     return _loadingRequests.size();
 }
 
+uint32_t ResourceCacheSharedItems::getLoadingRequestsCount(ResourceRequestBackend backend) const {
+    Lock lock(_mutex);
+    return countLoadingRequests(backend);
+}
+
+uint32_t ResourceCacheSharedItems::countLoadingRequests(ResourceRequestBackend backend) const {
+    uint32_t count = 0;
+    for (const auto& request : _loadingRequests) {
+        if (request.backend == backend) {
+            count++;
+        }
+    }
+    return count;
+}
+
 void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     Lock lock(_mutex);
 
@@ -85,7 +109,7 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     // QWeakPointer has no operator== implementation for two weak ptrs, so
     // manually loop in case resource has been freed.
     for (int i = 0; i < _loadingRequests.size();) {
-        auto request = _loadingRequests.at(i);
+        auto request = _loadingRequests.at(i).resource;
         // Clear our resource and any freed resources
         if (!request || request.data() == resource.data()) {
             _loadingRequests.removeAt(i);
@@ -95,31 +119,56 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     }
 }
 
-QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
+float ResourceCacheSharedItems::evalRequestScore(float priority, qint64 expectedBytes) {
+    if (expectedBytes <= 0) {
+        return priority;
+    }
+    return priority - REQUEST_SIZE_PRIORITY_COST * log2f(1.0f + (float)expectedBytes / REQUEST_SIZE_PRIORITY_UNIT);
+}
+
+void ResourceCacheSharedItems::updatePendingRequestPriorities() {
+    // the operators and the size estimates run without the lock, they can take a while
+    for (const auto& resource : getPendingRequests()) {
+        resource->updateLoadPriority();
+    }
+}
+
+QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest(const ResourceRequestLimits& limits) {
     // look for the highest priority pending request
     int highestIndex = -1;
-    float highestPriority = -FLT_MAX;
+    float highestScore = -FLT_MAX;
     QSharedPointer<Resource> highestResource;
     Lock lock(_mutex);
 
-    bool currentHighestIsFile = false;
+    std::array<bool, (size_t)ResourceRequestBackend::NumBackends> isBackendAvailable;
+    for (size_t i = 0; i < isBackendAvailable.size(); i++) {
+        isBackendAvailable[i] = (int)countLoadingRequests((ResourceRequestBackend)i) < limits[i];
+    }
+
+    bool currentHighestIsLocal = false;
 
     for (int i = 0; i < _pendingRequests.size();) {
         // Clear any freed resources
-        auto resource = _pendingRequests.at(i).lock();
+        const auto& request = _pendingRequests.at(i);
+        auto resource = request.resource.lock();
         if (!resource) {
             _pendingRequests.removeAt(i);
             continue;
         }
 
-        // Check load priority
-        float priority = resource->getLoadPriority();
-        bool isFile = resource->getURL().scheme() == URL_SCHEME_FILE;
-        if (priority >= highestPriority && (isFile || !currentHighestIsFile)) {
-            highestPriority = priority;
+        if (!isBackendAvailable[(size_t)request.backend]) {
+            i++;
+            continue;
+        }
+
+        // Check load priority, local files always go first as they don't take any bandwidth
+        float score = evalRequestScore(resource->getLoadPriority(), resource->getExpectedRequestSize());
+        bool isLocal = request.backend == ResourceRequestBackend::Local;
+        if (score >= highestScore && (isLocal || !currentHighestIsLocal)) {
+            highestScore = score;
             highestIndex = i;
             highestResource = resource;
-            currentHighestIsFile = isFile;
+            currentHighestIsLocal = isLocal;
         }
         i++;
     }
@@ -131,6 +180,108 @@ QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
     return highestResource;
 }
 
+void ResourceLRU::push(const QSharedPointer<Resource>& resource) {
+    int shardIndex = qHash(resource->getURL()) % NUM_SHARDS;
+    Shard& shard = _shards[shardIndex];
+    Lock lock(shard.mutex);
+    Q_ASSERT(resource->_lruShard == -1);
+
+    resource->_lruSelf = resource;
+    resource->_lruStamp = ++_clock;
+    resource->_lruBytes = resource->getBytes();
+    resource->_lruOlder = shard.newest;
+    resource->_lruNewer = nullptr;
+    if (shard.newest) {
+        shard.newest->_lruNewer = resource.data();
+    } else {
+        shard.oldest = resource.data();
+    }
+    shard.newest = resource.data();
+    resource->_lruShard = shardIndex;
+
+    _count++;
+    _bytes += resource->_lruBytes;
+}
+
+QSharedPointer<Resource> ResourceLRU::unlink(Shard& shard, Resource* resource) {
+    if (resource->_lruOlder) {
+        resource->_lruOlder->_lruNewer = resource->_lruNewer;
+    } else {
+        shard.oldest = resource->_lruNewer;
+    }
+    if (resource->_lruNewer) {
+        resource->_lruNewer->_lruOlder = resource->_lruOlder;
+    } else {
+        shard.newest = resource->_lruOlder;
+    }
+    resource->_lruOlder = resource->_lruNewer = nullptr;
+    resource->_lruShard = -1;
+
+    _count--;
+    _bytes -= resource->_lruBytes;
+
+    // the caller releases it, outside of the lock
+    QSharedPointer<Resource> self;
+    self.swap(resource->_lruSelf);
+    return self;
+}
+
+QSharedPointer<Resource> ResourceLRU::remove(Resource* resource) {
+    int shardIndex = resource->_lruShard;
+    if (shardIndex < 0) {
+        return QSharedPointer<Resource>();
+    }
+
+    Shard& shard = _shards[shardIndex];
+    Lock lock(shard.mutex);
+    if (resource->_lruShard != shardIndex) {
+        // taken out by another thread in the meantime
+        return QSharedPointer<Resource>();
+    }
+    return unlink(shard, resource);
+}
+
+QSharedPointer<Resource> ResourceLRU::popOldest() {
+    while (true) {
+        // the oldest of the oldest resource of each shard
+        int oldestShard = -1;
+        uint64_t oldestStamp = std::numeric_limits<uint64_t>::max();
+        for (int i = 0; i < NUM_SHARDS; i++) {
+            Lock lock(_shards[i].mutex);
+            if (_shards[i].oldest && _shards[i].oldest->_lruStamp < oldestStamp) {
+                oldestStamp = _shards[i].oldest->_lruStamp;
+                oldestShard = i;
+            }
+        }
+        if (oldestShard < 0) {
+            return QSharedPointer<Resource>();
+        }
+
+        Shard& shard = _shards[oldestShard];
+        Lock lock(shard.mutex);
+        if (shard.oldest && shard.oldest->_lruStamp == oldestStamp) {
+            return unlink(shard, shard.oldest);
+        }
+        // the shard changed since we looked, look again
+    }
+}
+
+QList<QSharedPointer<Resource>> ResourceLRU::removeIf(const std::function<bool(const Resource&)>& predicate) {
+    QList<QSharedPointer<Resource>> removed;
+    for (auto& shard : _shards) {
+        Lock lock(shard.mutex);
+        Resource* resource = shard.oldest;
+        while (resource) {
+            Resource* next = resource->_lruNewer;
+            if (!predicate || predicate(*resource)) {
+                removed.append(unlink(shard, resource));
+            }
+            resource = next;
+        }
+    }
+    return removed;
+}
+
 ScriptableResource::ScriptableResource(const QUrl& url) :
     QObject(nullptr),
     _url(url) { }
@@ -247,11 +398,11 @@ void ResourceCache::clearATPAssets() {
         }
     }
     {
-        QWriteLocker locker(&_unusedResourcesLock);
-        for (auto& resource : _unusedResources.values()) {
-            if (resource->getURL().scheme() == URL_SCHEME_ATP) {
-                _unusedResources.remove(resource->getLRUKey());
-            }
+        auto removed = _unusedResources.removeIf([](const Resource& resource) {
+            return resource.getURL().scheme() == URL_SCHEME_ATP;
+        });
+        if (!removed.isEmpty()) {
+            qCDebug(networking) << "Cleared" << removed.size() << "unused ATP resources";
         }
     }
     {
@@ -303,6 +454,19 @@ void ResourceCache::refresh(const QUrl& url) {
     }
 }
 
+QVariantMap ResourceCache::getStats() const {
+    QVariantMap stats;
+    stats["numTotal"] = (qulonglong)getNumTotalResources();
+    stats["numCached"] = (qulonglong)getNumCachedResources();
+    stats["sizeTotal"] = (qlonglong)_totalResourcesSize;
+    stats["sizeCached"] = (qlonglong)_unusedResources.getBytes();
+    stats["maxSizeCached"] = (qlonglong)_unusedResourcesMaxSize;
+    stats["numHits"] = (qulonglong)_numHits;
+    stats["numMisses"] = (qulonglong)_numMisses;
+    stats["numEvictions"] = (qulonglong)_numEvictions;
+    return stats;
+}
+
 QVariantList ResourceCache::getResourceList() {
     QVariantList list;
     if (QThread::currentThread() != thread()) {
@@ -329,6 +493,27 @@ void ResourceCache::setRequestLimit(int limit) {
     }
 }
 
+void ResourceCache::setRequestLimit(ResourceRequestBackend backend, int limit) {
+    if (backend == ResourceRequestBackend::Local) {
+        return;
+    }
+    _backendRequestLimits[(size_t)backend] = limit;
+
+    while (attemptHighestPriorityRequest()) {
+    }
+}
+
+ResourceRequestBackend ResourceCache::getRequestBackend(const QUrl& url) {
+    auto resourceManager = DependencyManager::get<ResourceManager>();
+    auto scheme = resourceManager ? resourceManager->normalizeURL(url).scheme() : url.scheme();
+    if (scheme == URL_SCHEME_ATP) {
+        return ResourceRequestBackend::ATP;
+    } else if (scheme == URL_SCHEME_HTTP || scheme == URL_SCHEME_HTTPS || scheme == URL_SCHEME_FTP) {
+        return ResourceRequestBackend::HTTP;
+    }
+    return ResourceRequestBackend::Local;
+}
+
 QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl& fallback, void* extra) {
     QSharedPointer<Resource> resource;
     {
@@ -336,6 +521,7 @@ QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl&
         resource = _resources.value(url).lock();
     }
     if (resource) {
+        _numHits++;
         removeUnusedResource(resource);
         return resource;
     }
@@ -344,6 +530,8 @@ QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl&
         return getResource(fallback, QUrl());
     }
 
+    _numMisses++;
+
     resource = createResource(
         url,
         fallback.isValid() ?  getResource(fallback, QUrl()) : QSharedPointer<Resource>(),
@@ -377,55 +565,43 @@ void ResourceCache::addUnusedResource(const QSharedPointer<Resource>& resource)
         return;
     }
     reserveUnusedResource(resource->getBytes());
-    
-    resource->setLRUKey(++_lastLRUKey);
-    _unusedResourcesSize += resource->getBytes();
 
-    resetResourceCounters();
+    _unusedResources.push(resource);
 
-    QWriteLocker locker(&_unusedResourcesLock);
-    _unusedResources.insert(resource->getLRUKey(), resource);
+    resetResourceCounters();
 }
 
 void ResourceCache::removeUnusedResource(const QSharedPointer<Resource>& resource) {
-    QWriteLocker locker(&_unusedResourcesLock);
-    if (_unusedResources.contains(resource->getLRUKey())) {
-        _unusedResources.remove(resource->getLRUKey());
-        _unusedResourcesSize -= resource->getBytes();
-
-        locker.unlock();
+    if (_unusedResources.remove(resource.data())) {
         resetResourceCounters();
     }
 }
 
 void ResourceCache::reserveUnusedResource(qint64 resourceSize) {
-    QWriteLocker locker(&_unusedResourcesLock);
-    while (!_unusedResources.empty() &&
-           _unusedResourcesSize + resourceSize > _unusedResourcesMaxSize) {
+    while (_unusedResources.getBytes() + resourceSize > _unusedResourcesMaxSize) {
         // unload the oldest resource
-        QMap<int, QSharedPointer<Resource> >::iterator it = _unusedResources.begin();
-        
-        it.value()->setCache(nullptr);
-        auto size = it.value()->getBytes();
-
-        locker.unlock();
-        removeResource(it.value()->getURL(), size);
-        locker.relock();
+        auto resource = _unusedResources.popOldest();
+        if (!resource) {
+            break;
+        }
 
-        _unusedResourcesSize -= size;
-        _unusedResources.erase(it);
+        resource->setCache(nullptr);
+        removeResource(resource->getURL(), resource->getBytes());
+        _numEvictions++;
     }
 }
 
 void ResourceCache::clearUnusedResources() {
     // the unused resources may themselves reference resources that will be added to the unused
     // list on destruction, so keep clearing until there are no references left
-    QWriteLocker locker(&_unusedResourcesLock);
-    while (!_unusedResources.isEmpty()) {
-        foreach (const QSharedPointer<Resource>& resource, _unusedResources) {
+    while (true) {
+        auto resources = _unusedResources.removeIf();
+        if (resources.isEmpty()) {
+            break;
+        }
+        for (const auto& resource : resources) {
             resource->setCache(nullptr);
         }
-        _unusedResources.clear();
     }
 }
 
@@ -435,11 +611,6 @@ void ResourceCache::resetResourceCounters() {
         _numTotalResources = _resources.size();
     }
 
-    {
-        QReadLocker locker(&_unusedResourcesLock);
-        _numUnusedResources = _unusedResources.size();
-    }
-
     emit dirty();
 }
 
@@ -471,19 +642,25 @@ int ResourceCache::getLoadingRequestCount() {
     return DependencyManager::get<ResourceCacheSharedItems>()->getLoadingRequestsCount();
 }
 
+int ResourceCache::getLoadingRequestCount(ResourceRequestBackend backend) {
+    return DependencyManager::get<ResourceCacheSharedItems>()->getLoadingRequestsCount(backend);
+}
+
 bool ResourceCache::attemptRequest(QSharedPointer<Resource> resource) {
     Q_ASSERT(!resource.isNull());
 
 
     auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
-    if (_requestsActive >= _requestLimit) {
+    auto backend = getRequestBackend(resource->_activeUrl);
+    if (_requestsActive >= _requestLimit ||
+        (int)sharedItems->getLoadingRequestsCount(backend) >= _backendRequestLimits[(size_t)backend]) {
         // wait until a slot becomes available
-        sharedItems->appendPendingRequest(resource);
+        sharedItems->appendPendingRequest(resource, backend);
         return false;
     }
     
     ++_requestsActive;
-    sharedItems->appendActiveRequest(resource);
+    sharedItems->appendActiveRequest(resource, backend);
     resource->makeRequest();
     return true;
 }
@@ -498,8 +675,11 @@ void ResourceCache::requestCompleted(QWeakPointer<Resource> resource) {
 }
 
 bool ResourceCache::attemptHighestPriorityRequest() {
+    if (_requestsActive >= _requestLimit) {
+        return false;
+    }
     auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
-    auto resource = sharedItems->getHighestPendingRequest();
+    auto resource = sharedItems->getHighestPendingRequest(_backendRequestLimits);
     return (resource && attemptRequest(resource));
 }
 
@@ -507,6 +687,12 @@ const int DEFAULT_REQUEST_LIMIT = 10;
 int ResourceCache::_requestLimit = DEFAULT_REQUEST_LIMIT;
 int ResourceCache::_requestsActive = 0;
 
+// Requests past the limit wait in our queue, where they keep being reprioritized, rather than in the queue of
+// QNetworkAccessManager or the asset client
+const int DEFAULT_HTTP_REQUEST_LIMIT = 10;
+const int DEFAULT_ATP_REQUEST_LIMIT = 10;
+ResourceRequestLimits ResourceCache::_backendRequestLimits { { INT_MAX, DEFAULT_HTTP_REQUEST_LIMIT, DEFAULT_ATP_REQUEST_LIMIT } };
+
 static int requestID = 0;
 
 Resource::Resource(const QUrl& url) :
@@ -534,6 +720,7 @@ void Resource::ensureLoading() {
 void Resource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
     if (!(_failedToLoad)) {
         _loadPriorities.insert(owner, priority);
+        updateLoadPriority();
     }
 }
 
@@ -545,17 +732,41 @@ void Resource::setLoadPriorities(const QHash<QPointer<QObject>, float>& prioriti
             it != priorities.constEnd(); it++) {
         _loadPriorities.insert(it.key(), it.value());
     }
+    updateLoadPriority();
+}
+
+void Resource::setLoadPriorityOperator(const QPointer<QObject>& owner, std::function<float()> priorityOperator) {
+    if (!(_failedToLoad)) {
+        _loadPriorityOperators.insert(owner, priorityOperator);
+        updateLoadPriority();
+    }
 }
 
 void Resource::clearLoadPriority(const QPointer<QObject>& owner) {
     if (!(_failedToLoad)) {
         _loadPriorities.remove(owner);
+        _loadPriorityOperators.remove(owner);
+        updateLoadPriority();
     }
 }
 
-float Resource::getLoadPriority() {
-    if (_loadPriorities.size() == 0) {
-        return 0;
+void Resource::inheritLoadPriorities(Resource& resource) {
+    if (_failedToLoad) {
+        return;
+    }
+    setLoadPriorities(resource._loadPriorities);
+    for (auto it = resource._loadPriorityOperators.constBegin(); it != resource._loadPriorityOperators.constEnd(); it++) {
+        _loadPriorityOperators.insert(it.key(), it.value());
+    }
+    updateLoadPriority();
+}
+
+void Resource::updateLoadPriority() {
+    _expectedRequestSize = evalExpectedRequestSize();
+
+    if (_loadPriorities.size() == 0 && _loadPriorityOperators.size() == 0) {
+        _loadPriority = 0.0f;
+        return;
     }
 
     float highestPriority = -FLT_MAX;
@@ -567,7 +778,23 @@ float Resource::getLoadPriority() {
         highestPriority = qMax(highestPriority, it.value());
         it++;
     }
-    return highestPriority;
+    for (auto it = _loadPriorityOperators.begin(); it != _loadPriorityOperators.end(); ) {
+        if (it.key().isNull()) {
+            it = _loadPriorityOperators.erase(it);
+            continue;
+        }
+        highestPriority = qMax(highestPriority, it.value()());
+        it++;
+    }
+    _loadPriority = highestPriority;
+}
+
+qint64 Resource::evalExpectedRequestSize() const {
+    if (_requestByteRange.isSet()) {
+        return _requestByteRange.fromInclusive < 0 ? -_requestByteRange.fromInclusive : _requestByteRange.size();
+    }
+    // what the last attempt reported, for retries and refreshes
+    return std::max(_bytesTotal, (qint64)0);
 }
 
 void Resource::refresh() {
@@ -643,6 +870,9 @@ void Resource::finishedLoading(bool success) {
     if (success) {
         qCDebug(networking).noquote() << "Finished loading:" << _url.toDisplayString();
         _loadPriorities.clear();
+        _loadPriorityOperators.clear();
+        _loadPriority = 0.0f;
+        _expectedRequestSize = 0;
         _loaded = true;
     } else {
         qCDebug(networking).noquote() << "Failed to load:" << _url.toDisplayString();
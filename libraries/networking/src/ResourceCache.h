@@ -12,7 +12,9 @@
 #ifndef hifi_ResourceCache_h
 #define hifi_ResourceCache_h
 
+#include <array>
 #include <atomic>
+#include <functional>
 #include <mutex>
 
 #include <QtCore/QHash>
@@ -55,6 +57,16 @@ static const qint64 DEFAULT_UNUSED_MAX_SIZE = 1024 * BYTES_PER_MEGABYTES;
 static const qint64 MIN_UNUSED_MAX_SIZE = 0;
 static const qint64 MAX_UNUSED_MAX_SIZE = MAXIMUM_CACHE_SIZE;
 
+// Requests are limited per backend as well as in total, so that a slow asset server doesn't hold up
+// HTTP downloads or the other way around.  Local requests only count toward the total.
+enum class ResourceRequestBackend {
+    Local,
+    HTTP,
+    ATP,
+    NumBackends
+};
+using ResourceRequestLimits = std::array<int, (size_t)ResourceRequestBackend::NumBackends>;
+
 // We need to make sure that these items are available for all instances of
 // ResourceCache derived classes. Since we can't count on the ordering of
 // static members destruction, we need to use this Dependency manager implemented
@@ -66,21 +78,83 @@ class ResourceCacheSharedItems : public Dependency  {
     using Lock = std::unique_lock<Mutex>;
 
 public:
-    void appendPendingRequest(QWeakPointer<Resource> newRequest);
-    void appendActiveRequest(QWeakPointer<Resource> newRequest);
+    void appendPendingRequest(QWeakPointer<Resource> newRequest, ResourceRequestBackend backend);
+    void appendActiveRequest(QWeakPointer<Resource> newRequest, ResourceRequestBackend backend);
     void removeRequest(QWeakPointer<Resource> doneRequest);
     QList<QSharedPointer<Resource>> getPendingRequests();
     uint32_t getPendingRequestsCount() const;
     QList<QSharedPointer<Resource>> getLoadingRequests();
-    QSharedPointer<Resource> getHighestPendingRequest();
     uint32_t getLoadingRequestsCount() const;
+    uint32_t getLoadingRequestsCount(ResourceRequestBackend backend) const;
+
+    /// Takes the pending request with the highest score (see evalRequestScore) out of those whose backend is
+    /// below its limit.  Uses the priorities last computed by updatePendingRequestPriorities, from any thread.
+    QSharedPointer<Resource> getHighestPendingRequest(const ResourceRequestLimits& limits);
+
+    /// Recomputes the load priority of every pending request, so the queue follows the camera.  Main thread only:
+    /// the priority operators read the avatar and entities.
+    void updatePendingRequestPriorities();
+
+    /// The load priority of a resource less a cost that grows with the log of the bytes it is expected to transfer,
+    /// so that among things of about the same importance the cheap ones go first.
+    static float evalRequestScore(float priority, qint64 expectedBytes);
 
 private:
     ResourceCacheSharedItems() = default;
 
+    class Request {
+    public:
+        QWeakPointer<Resource> resource;
+        ResourceRequestBackend backend;
+    };
+
+    uint32_t countLoadingRequests(ResourceRequestBackend backend) const;
+
     mutable Mutex _mutex;
-    QList<QWeakPointer<Resource>> _pendingRequests;
-    QList<QWeakPointer<Resource>> _loadingRequests;
+    QList<Request> _pendingRequests;
+    QList<Request> _loadingRequests;
+};
+
+/// The unused resources of a cache, from least to most recently used.  The list is intrusive, the links live in the
+/// resources, and it is split in shards by URL so that threads releasing and reacquiring resources rarely contend.
+/// A resource in the list is held by it.
+class ResourceLRU {
+public:
+    /// Adds a resource as the most recently used.
+    void push(const QSharedPointer<Resource>& resource);
+
+    /// Takes a resource out of the list, returns the reference the list held or null if it wasn't in it.
+    QSharedPointer<Resource> remove(Resource* resource);
+
+    /// Takes the least recently used resource out of the list.
+    QSharedPointer<Resource> popOldest();
+
+    /// Takes the resources that match (all of them without a predicate) out of the list.
+    QList<QSharedPointer<Resource>> removeIf(const std::function<bool(const Resource&)>& predicate = nullptr);
+
+    size_t getCount() const { return _count; }
+    qint64 getBytes() const { return _bytes; }
+
+private:
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+
+    static const int NUM_SHARDS = 8;
+
+    class Shard {
+    public:
+        Mutex mutex;
+        Resource* oldest { nullptr };
+        Resource* newest { nullptr };
+    };
+
+    // the shard must be locked
+    QSharedPointer<Resource> unlink(Shard& shard, Resource* resource);
+
+    std::array<Shard, NUM_SHARDS> _shards;
+    std::atomic<uint64_t> _clock { 0 };
+    std::atomic<size_t> _count { 0 };
+    std::atomic<qint64> _bytes { 0 };
 };
 
 /// Wrapper to expose resources to JS/QML
@@ -185,6 +259,9 @@ class ResourceCache : public QObject {
     Q_PROPERTY(size_t numCached READ getNumCachedResources NOTIFY dirty)
     Q_PROPERTY(size_t sizeTotal READ getSizeTotalResources NOTIFY dirty)
     Q_PROPERTY(size_t sizeCached READ getSizeCachedResources NOTIFY dirty)
+    Q_PROPERTY(size_t numHits READ getNumHits NOTIFY dirty)
+    Q_PROPERTY(size_t numMisses READ getNumMisses NOTIFY dirty)
+    Q_PROPERTY(size_t numEvictions READ getNumEvictions NOTIFY dirty)
 
     /**jsdoc
      * @namespace ResourceCache
@@ -192,6 +269,9 @@ class ResourceCache : public QObject {
      * @property numCached {number} total number of cached resource
      * @property sizeTotal {number} size in bytes of all resources
      * @property sizeCached {number} size in bytes of all cached resources
+     * @property numHits {number} number of requests for resources that were already loaded or loading
+     * @property numMisses {number} number of requests that had to load a resource
+     * @property numEvictions {number} number of cached resources dropped to make room
      */
 
 public:
@@ -214,14 +294,35 @@ public:
      * @function ResourceCache.getNumCachedResources
      * @return {number}
      */
-    size_t getNumCachedResources() const { return _numUnusedResources; }
+    size_t getNumCachedResources() const { return _unusedResources.getCount(); }
 
     /**jsdoc
      * Returns the total size in bytes of cached resources
      * @function ResourceCache.getSizeCachedResources
      * @return {number}
      */
-    size_t getSizeCachedResources() const { return _unusedResourcesSize; }
+    size_t getSizeCachedResources() const { return _unusedResources.getBytes(); }
+
+    /**jsdoc
+     * Returns the number of requests for resources that were already loaded or loading
+     * @function ResourceCache.getNumHits
+     * @return {number}
+     */
+    size_t getNumHits() const { return _numHits; }
+
+    /**jsdoc
+     * Returns the number of requests that had to load a resource
+     * @function ResourceCache.getNumMisses
+     * @return {number}
+     */
+    size_t getNumMisses() const { return _numMisses; }
+
+    /**jsdoc
+     * Returns the number of cached resources dropped to make room for others
+     * @function ResourceCache.getNumEvictions
+     * @return {number}
+     */
+    size_t getNumEvictions() const { return _numEvictions; }
 
     /**jsdoc
      * Returns list of all resource urls
@@ -230,9 +331,21 @@ public:
      */
     Q_INVOKABLE QVariantList getResourceList();
 
+    /**jsdoc
+     * Returns the counters of the cache in one object
+     * @function ResourceCache.getStats
+     * @return {object} numTotal, numCached, sizeTotal, sizeCached, maxSizeCached, numHits, numMisses and numEvictions
+     */
+    Q_INVOKABLE QVariantMap getStats() const;
+
     static void setRequestLimit(int limit);
     static int getRequestLimit() { return _requestLimit; }
 
+    static void setRequestLimit(ResourceRequestBackend backend, int limit);
+    static int getRequestLimit(ResourceRequestBackend backend) { return _backendRequestLimits[(size_t)backend]; }
+
+    static ResourceRequestBackend getRequestBackend(const QUrl& url);
+
     static int getRequestsActive() { return _requestsActive; }
     
     void setUnusedResourceCacheSize(qint64 unusedResourcesMaxSize);
@@ -244,6 +357,8 @@ public:
 
     static int getLoadingRequestCount();
 
+    static int getLoadingRequestCount(ResourceRequestBackend backend);
+
     ResourceCache(QObject* parent = nullptr);
     virtual ~ResourceCache();
     
@@ -315,22 +430,22 @@ private:
 
     static int _requestLimit;
     static int _requestsActive;
+    static ResourceRequestLimits _backendRequestLimits;
 
     // Resources
     QHash<QUrl, QWeakPointer<Resource>> _resources;
     QReadWriteLock _resourcesLock { QReadWriteLock::Recursive };
-    int _lastLRUKey = 0;
 
     std::atomic<size_t> _numTotalResources { 0 };
     std::atomic<qint64> _totalResourcesSize { 0 };
 
     // Cached resources
-    QMap<int, QSharedPointer<Resource>> _unusedResources;
-    QReadWriteLock _unusedResourcesLock { QReadWriteLock::Recursive };
-    qint64 _unusedResourcesMaxSize = DEFAULT_UNUSED_MAX_SIZE;
+    ResourceLRU _unusedResources;
+    std::atomic<qint64> _unusedResourcesMaxSize { DEFAULT_UNUSED_MAX_SIZE };
 
-    std::atomic<size_t> _numUnusedResources { 0 };
-    std::atomic<qint64> _unusedResourcesSize { 0 };
+    std::atomic<size_t> _numHits { 0 };
+    std::atomic<size_t> _numMisses { 0 };
+    std::atomic<size_t> _numEvictions { 0 };
 
     // Pending resources
     QQueue<QUrl> _resourcesToBeGotten;
@@ -347,9 +462,6 @@ public:
     virtual ~Resource();
 
     virtual QString getType() const { return "Resource"; }
-    
-    /// Returns the key last used to identify this resource in the unused map.
-    int getLRUKey() const { return _lruKey; }
 
     /// Makes sure that the resource has started loading.
     void ensureLoading();
@@ -360,11 +472,26 @@ public:
     /// Sets a set of priorities at once.
     virtual void setLoadPriorities(const QHash<QPointer<QObject>, float>& priorities);
     
+    /// Sets a function returning the load priority for one owner, for priorities that change over time
+    /// (distance, screen size).  It is called on the main thread, see updateLoadPriority.
+    virtual void setLoadPriorityOperator(const QPointer<QObject>& owner, std::function<float()> priorityOperator);
+
     /// Clears the load priority for one owner.
     virtual void clearLoadPriority(const QPointer<QObject>& owner);
-    
-    /// Returns the highest load priority across all owners.
-    float getLoadPriority();
+
+    /// Gives this resource the load priorities of another one, for the resources it pulls in.
+    void inheritLoadPriorities(Resource& resource);
+
+    /// Returns the highest load priority across all owners, as of the last updateLoadPriority.
+    float getLoadPriority() const { return _loadPriority; }
+
+    /// Returns the number of bytes the next request is expected to transfer, zero when unknown, as of the last
+    /// updateLoadPriority.
+    qint64 getExpectedRequestSize() const { return _expectedRequestSize; }
+
+    /// Recomputes the load priority from the owners that are still alive, and the expected request size.  Main
+    /// thread only, like the functions that set the priorities.
+    void updateLoadPriority();
 
     /// Checks whether the resource has loaded.
     virtual bool isLoaded() const { return _loaded; }
@@ -435,6 +562,10 @@ protected:
     /// Checks whether the resource is cacheable.
     virtual bool isCacheable() const { return true; }
 
+    /// Returns the number of bytes the next request is expected to transfer, zero when unknown.  Main thread only,
+    /// see getExpectedRequestSize for other threads.
+    virtual qint64 evalExpectedRequestSize() const;
+
     /// Called when the download has finished.
     /// This should be overridden by subclasses that need to process the data once it is downloaded.
     virtual void downloadFinished(const QByteArray& data) { finishedLoading(true); }
@@ -465,6 +596,9 @@ protected:
     bool _loaded = false;
 
     QHash<QPointer<QObject>, float> _loadPriorities;
+    QHash<QPointer<QObject>, std::function<float()>> _loadPriorityOperators;
+    std::atomic<float> _loadPriority { 0.0f }; // read by the threads picking the next request
+    std::atomic<qint64> _expectedRequestSize { 0 }; // same
     QWeakPointer<Resource> _self;
     QPointer<ResourceCache> _cache;
 
@@ -481,17 +615,23 @@ public slots:
 
 private:
     friend class ResourceCache;
+    friend class ResourceLRU;
     friend class ScriptableResource;
-    
-    void setLRUKey(int lruKey) { _lruKey = lruKey; }
-    
+
     void retry();
     void reinsert();
 
     bool isInScript() const { return _isInScript; }
     void setInScript(bool isInScript) { _isInScript = isInScript; }
     
-    int _lruKey{ 0 };
+    // links in the unused resources of the cache, _lruShard is -1 when not in them
+    QSharedPointer<Resource> _lruSelf;
+    Resource* _lruOlder { nullptr };
+    Resource* _lruNewer { nullptr };
+    uint64_t _lruStamp { 0 };
+    qint64 _lruBytes { 0 };
+    std::atomic<int> _lruShard { -1 };
+
     QTimer* _replyTimer{ nullptr };
     unsigned int _attempts{ 0 };
     static const int MAX_ATTEMPTS = 8;
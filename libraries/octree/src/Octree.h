@@ -188,6 +188,20 @@ public:
     {}
 };
 
+// An edit record decoded ahead of time by Octree::decodeEditPacketData(), so the decode can happen outside the tree lock
+// and the inbound packet processor can merge records that a later record from the same sender makes redundant.
+class OctreeEditRecord {
+public:
+    virtual ~OctreeEditRecord() {}
+
+    // true if applying other after this record leaves nothing of this record's effect behind
+    virtual bool isSupersededBy(const OctreeEditRecord& other) const { return false; }
+
+    QUuid targetID; // the item being edited, null if the record must not be merged or rate limited (adds, etc)
+    int recordBytes { 0 };
+};
+using OctreeEditRecordPointer = std::shared_ptr<OctreeEditRecord>;
+
 class Octree : public QObject, public std::enable_shared_from_this<Octree>, public ReadWriteLockable {
     Q_OBJECT
 public:
@@ -205,6 +219,13 @@ public:
     virtual bool handlesEditPacketType(PacketType packetType) const { return false; }
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& sourceNode) { return 0; }
+    // Optional split of processEditPacketData(): decode without the tree lock, then apply with the write lock held.
+    // Trees that return nullptr from decodeEditPacketData() have the rest of the message handed to processEditPacketData().
+    // processDecodedEditPacketData() returns false when the edit was rejected or altered by the tree's checks.
+    virtual OctreeEditRecordPointer decodeEditPacketData(const ReceivedMessage& message, const unsigned char* editData,
+                                                         int maxLength) { return nullptr; }
+    virtual bool processDecodedEditPacketData(const ReceivedMessage& message, const OctreeEditRecordPointer& record,
+                                              const SharedNodePointer& sourceNode) { return true; }
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
     virtual void processChallengeOwnershipReplyPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
     virtual void processChallengeOwnershipPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
@@ -260,7 +281,8 @@ public:
     // output hints from the encode process
     typedef enum {
         Lock,
-        TryLock
+        TryLock,
+        NoLock // caller already holds the tree's read lock
     } lockType;
 
 
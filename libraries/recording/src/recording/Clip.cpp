@@ -13,12 +13,15 @@
 
 #include "impl/FileClip.h"
 #include "impl/BufferClip.h"
+#include "impl/ChunkIndex.h"
 
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QBuffer>
 #include <QtCore/QDebug>
 
+#include <vector>
+
 using namespace recording;
 
 Clip::Pointer Clip::fromFile(const QString& filePath) {
@@ -92,8 +95,17 @@ bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
 
 const QString Clip::FRAME_TYPE_MAP = QStringLiteral("frameTypes");
 const QString Clip::FRAME_COMREPSSION_FLAG = QStringLiteral("compressed");
+const QString Clip::FORMAT_VERSION = QStringLiteral("version");
+
+void appendChunkFrame(QByteArray& chunkData, const Frame& frame) {
+    uint32_t dataSize = frame.data.size();
+    chunkData.append((const char*)&(frame.type), sizeof(FrameType));
+    chunkData.append((const char*)&(frame.timeOffset), sizeof(Frame::Time));
+    chunkData.append((const char*)&dataSize, sizeof(uint32_t));
+    chunkData.append(frame.data);
+}
 
-bool Clip::write(QIODevice& output) {
+bool Clip::write(QIODevice& output, bool compressed) {
     auto frameTypes = Frame::getFrameTypes();
     QJsonObject frameTypeObj;
     for (const auto& frameTypeName : frameTypes.keys()) {
@@ -102,20 +114,83 @@ bool Clip::write(QIODevice& output) {
 
     QJsonObject rootObject;
     rootObject.insert(FRAME_TYPE_MAP, frameTypeObj);
-    // Always mark new files as compressed
-    rootObject.insert(FRAME_COMREPSSION_FLAG, true);
+    rootObject.insert(FRAME_COMREPSSION_FLAG, compressed);
+    rootObject.insert(FORMAT_VERSION, CHUNKED_FORMAT_VERSION);
     QByteArray headerFrameData = QJsonDocument(rootObject).toBinaryData();
     // Never compress the header frame
     if (!writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), false)) {
         return false;
     }
+    quint64 offset = PointerClip::MINIMUM_FRAME_SIZE + headerFrameData.size();
 
-    seek(0);
+    std::vector<ChunkIndexEntry> chunks;
+    ChunkIndexEntry chunk;
+    QByteArray chunkData;
+    uint32_t frameCount = 0;
 
-    for (auto frame = nextFrame(); frame; frame = nextFrame()) {
-        if (!writeFrame(output, *frame)) {
+    auto writeChunk = [&]() -> bool {
+        if (0 == chunk.frameCount) {
+            return true;
+        }
+        chunk.offset = offset;
+        chunk.rawSize = chunkData.size();
+        QByteArray storedData = chunkData;
+        if (compressed) {
+            QByteArray compressedData = qCompress(chunkData);
+            if (compressedData.size() < chunkData.size()) {
+                storedData = compressedData;
+                chunk.compressed = 1;
+            }
+        }
+        chunk.storedSize = storedData.size();
+        if (output.write(storedData) != storedData.size()) {
             return false;
         }
+        offset += chunk.storedSize;
+        chunks.push_back(chunk);
+
+        chunk = ChunkIndexEntry();
+        chunk.firstFrame = frameCount;
+        chunkData.resize(0);
+        return true;
+    };
+
+    // Frames of types that are not registered can't be named in the header, so no reader could use them
+    auto frameTypeNames = Frame::getFrameTypeNames();
+    seek(0);
+    for (auto frame = nextFrame(); frame; frame = nextFrame()) {
+        if (frame->type == Frame::TYPE_INVALID) {
+            qWarning() << "Attempting to write invalid frame";
+            continue;
+        }
+        if (!frameTypeNames.contains(frame->type)) {
+            continue;
+        }
+
+        if (chunk.frameCount != 0 &&
+            (frame->timeOffset >= chunk.startTime + KEYFRAME_INTERVAL || (uint32_t)chunkData.size() >= MAX_CHUNK_SIZE)) {
+            if (!writeChunk()) {
+                return false;
+            }
+        }
+        if (0 == chunk.frameCount) {
+            chunk.startTime = frame->timeOffset;
+        }
+        chunk.endTime = frame->timeOffset;
+        ++chunk.frameCount;
+        ++frameCount;
+        appendChunkFrame(chunkData, *frame);
     }
-    return true;
+    if (!writeChunk()) {
+        return false;
+    }
+
+    ChunkTrailer trailer;
+    trailer.indexOffset = offset;
+    trailer.chunkCount = (uint32_t)chunks.size();
+    qint64 indexSize = chunks.size() * sizeof(ChunkIndexEntry);
+    if (indexSize != 0 && output.write((const char*)chunks.data(), indexSize) != indexSize) {
+        return false;
+    }
+    return output.write((const char*)&trailer, sizeof(ChunkTrailer)) == sizeof(ChunkTrailer);
 }
@@ -47,7 +47,8 @@ public:
     virtual void skipFrame() = 0;
     virtual void addFrame(FrameConstPointer) = 0;
 
-    bool write(QIODevice& output);
+    // Writes the clip in the chunked format, compressing the chunks that get smaller for it
+    bool write(QIODevice& output, bool compressed = true);
 
     static Pointer fromFile(const QString& filePath);
     static void toFile(const QString& filePath, const ConstPointer& clip);
@@ -56,6 +57,7 @@ public:
     
     static const QString FRAME_TYPE_MAP;
     static const QString FRAME_COMREPSSION_FLAG;
+    static const QString FORMAT_VERSION;
 
 protected:
     friend class WrapperClip;
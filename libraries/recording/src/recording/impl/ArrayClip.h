@@ -21,10 +21,11 @@ class ArrayClip : public Clip {
 public:
     virtual float duration() const override {
         Locker lock(_mutex);
-        if (_frames.empty()) {
+        auto count = frameCount();
+        if (0 == count) {
             return 0;
         }
-        return Frame::frameTimeToSeconds((*_frames.rbegin()).timeOffset);
+        return Frame::frameTimeToSeconds(frameTime(count - 1));
     }
 
     virtual size_t frameCount() const override {
@@ -35,7 +36,8 @@ public:
     virtual Clip::Pointer duplicate() const override {
         auto result = newClip();
         Locker lock(_mutex);
-        for (size_t i = 0; i < _frames.size(); ++i) {
+        auto count = frameCount();
+        for (size_t i = 0; i < count; ++i) {
             result->addFrame(readFrame(i));
         }
         return result;
@@ -43,19 +45,14 @@ public:
 
     virtual void seekFrameTime(Frame::Time offset) override {
         Locker lock(_mutex);
-        auto itr = std::lower_bound(_frames.begin(), _frames.end(), offset,
-                [](const T& a, Frame::Time b)->bool {
-                return a.timeOffset < b;
-            }
-        );
-        _frameIndex = itr - _frames.begin();
+        _frameIndex = findFrame(offset);
     }
 
     virtual Frame::Time positionFrameTime() const override {
         Locker lock(_mutex);
         Frame::Time result = Frame::INVALID_TIME;
-        if (_frameIndex < _frames.size()) {
-            result = _frames[_frameIndex].timeOffset;
+        if (_frameIndex < frameCount()) {
+            result = frameTime(_frameIndex);
         }
         return result;
     }
@@ -63,7 +60,7 @@ public:
     virtual FrameConstPointer peekFrame() const override {
         Locker lock(_mutex);
         FrameConstPointer result;
-        if (_frameIndex < _frames.size()) {
+        if (_frameIndex < frameCount()) {
             result = readFrame(_frameIndex);
         }
         return result;
@@ -72,7 +69,7 @@ public:
     virtual FrameConstPointer nextFrame() override {
         Locker lock(_mutex);
         FrameConstPointer result;
-        if (_frameIndex < _frames.size()) {
+        if (_frameIndex < frameCount()) {
             result = readFrame(_frameIndex++);
         }
         return result;
@@ -80,7 +77,7 @@ public:
 
     virtual void skipFrame() override {
         Locker lock(_mutex);
-        if (_frameIndex < _frames.size()) {
+        if (_frameIndex < frameCount()) {
             ++_frameIndex;
         }
     }
@@ -90,6 +87,20 @@ protected:
         _frameIndex = 0;
     }
 
+    // Index of the first frame at or after offset, or frameCount() if there is none
+    virtual size_t findFrame(Frame::Time offset) const {
+        auto itr = std::lower_bound(_frames.begin(), _frames.end(), offset,
+                [](const T& a, Frame::Time b)->bool {
+                return a.timeOffset < b;
+            }
+        );
+        return itr - _frames.begin();
+    }
+
+    virtual Frame::Time frameTime(size_t index) const {
+        return _frames[index].timeOffset;
+    }
+
     virtual FrameConstPointer readFrame(size_t index) const = 0;
     std::vector<T> _frames;
     mutable size_t _frameIndex { 0 };
@@ -0,0 +1,64 @@
+//
+//  ChunkIndex.h
+//  libraries/recording/src/recording/impl
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_Recording_Impl_ChunkIndex_h
+#define hifi_Recording_Impl_ChunkIndex_h
+
+#include "../Frame.h"
+
+namespace recording {
+
+// Version 2 clips store their frames in chunks, each compressed as a whole and decodable on its own,
+// followed by an index of the chunks and a fixed size trailer pointing at that index:
+//
+//   header frame | chunk 0 | ... | chunk N-1 | ChunkIndexEntry[N] | ChunkTrailer
+//
+// The header frame is written the same way as in version 1 clips.  A chunk is a sequence of frame
+// type, time offset, uint32_t data size and data records.  A new chunk is started at least every
+// KEYFRAME_INTERVAL, and since every frame holds a full state the first frame of a chunk is a keyframe:
+// a reader seeks by binary searching the index and only ever needs the one chunk it plays from.
+
+static const int CHUNKED_FORMAT_VERSION = 2;
+
+// Frame time between keyframes, in milliseconds
+static const Frame::Time KEYFRAME_INTERVAL = 1000;
+
+// Uncompressed size after which a chunk is ended early, bounding the memory needed to play it
+static const uint32_t MAX_CHUNK_SIZE = 256 * 1024;
+
+static const uint32_t CHUNK_TRAILER_MAGIC = 0x49524648; // "HFRI"
+
+static const size_t CHUNK_FRAME_HEADER_SIZE = sizeof(FrameType) + sizeof(Frame::Time) + sizeof(uint32_t);
+
+struct ChunkIndexEntry {
+    quint64 offset { 0 }; // from the start of the clip data
+    uint32_t storedSize { 0 };
+    uint32_t rawSize { 0 };
+    uint32_t firstFrame { 0 };
+    uint32_t frameCount { 0 };
+    Frame::Time startTime { 0 };
+    Frame::Time endTime { 0 };
+    uint32_t compressed { 0 };
+    uint32_t reserved { 0 };
+};
+
+struct ChunkTrailer {
+    quint64 indexOffset { 0 };
+    uint32_t chunkCount { 0 };
+    uint32_t magic { CHUNK_TRAILER_MAGIC };
+};
+
+static_assert(sizeof(ChunkIndexEntry) == 40, "Chunk index entries are written as is");
+static_assert(sizeof(ChunkTrailer) == 16, "Chunk trailer is written as is");
+
+}
+
+#endif
@@ -45,26 +45,33 @@ FrameTranslationMap parseTranslationMap(const QJsonDocument& doc) {
 }
 
 
+bool parseFrameHeader(uchar* const start, uchar*& current, uchar* const end, PointerFrameHeader& header) {
+    if (end - current < PointerClip::MINIMUM_FRAME_SIZE) {
+        return false;
+    }
+    memcpy(&(header.type), current, sizeof(FrameType));
+    current += sizeof(FrameType);
+    memcpy(&(header.timeOffset), current, sizeof(Frame::Time));
+    current += sizeof(Frame::Time);
+    memcpy(&(header.size), current, sizeof(FrameSize));
+    current += sizeof(FrameSize);
+    header.fileOffset = current - start;
+    if (end - current < header.size) {
+        current = end;
+        return false;
+    }
+    current += header.size;
+    return true;
+}
+
 PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size) {
     PointerFrameHeaderList results;
     auto current = start;
     auto end = current + size;
     // Read all the frame headers
     // FIXME move to Frame::readHeader?
-    while (end - current >= PointerClip::MINIMUM_FRAME_SIZE) {
-        PointerFrameHeader header;
-        memcpy(&(header.type), current, sizeof(FrameType));
-        current += sizeof(FrameType);
-        memcpy(&(header.timeOffset), current, sizeof(Frame::Time));
-        current += sizeof(Frame::Time);
-        memcpy(&(header.size), current, sizeof(FrameSize));
-        current += sizeof(FrameSize);
-        header.fileOffset = current - start;
-        if (end - current < header.size) {
-            current = end;
-            break;
-        }
-        current += header.size;
+    PointerFrameHeader header;
+    while (parseFrameHeader(start, current, end, header)) {
         results.push_back(header);
     }
     qDebug(recordingLog) << "Parsed source data into " << results.size() << " frames";
@@ -76,10 +83,17 @@ PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size)
 }
 
 void PointerClip::reset() {
+    ArrayClip::reset();
     _frames.clear();
     _data = nullptr;
     _size = 0;
     _header = QJsonDocument();
+    _translationMap.clear();
+    _chunks.clear();
+    _chunkedFrameCount = 0;
+    _loadedChunk = INVALID_CHUNK;
+    _chunkData.clear();
+    _chunkFrames.clear();
 }
 
 void PointerClip::init(uchar* data, size_t size) {
@@ -88,18 +102,17 @@ void PointerClip::init(uchar* data, size_t size) {
     _data = data;
     _size = size;
 
-    auto parsedFrameHeaders = parseFrameHeaders(data, size);
-    // Verify that at least one frame exists and that the first frame is a header
-    if (0 == parsedFrameHeaders.size()) {
-        qWarning() << "No frames found, invalid file";
-        reset();
-        return;
-    }
-
-    // Grab the file header
+    // Grab the file header, the first frame of every version
+    size_t headerEnd = 0;
     {
-        auto fileHeaderFrameHeader = *parsedFrameHeaders.begin();
-        parsedFrameHeaders.pop_front();
+        PointerFrameHeader fileHeaderFrameHeader;
+        auto current = _data;
+        if (!_data || !parseFrameHeader(_data, current, _data + _size, fileHeaderFrameHeader)) {
+            qWarning() << "No frames found, invalid file";
+            reset();
+            return;
+        }
+
         if (fileHeaderFrameHeader.type != Frame::TYPE_HEADER) {
             qWarning() << "Missing header frame, invalid file";
             reset();
@@ -107,6 +120,7 @@ void PointerClip::init(uchar* data, size_t size) {
         }
 
         QByteArray fileHeaderData((char*)_data + fileHeaderFrameHeader.fileOffset, fileHeaderFrameHeader.size);
+        headerEnd = fileHeaderFrameHeader.fileOffset + fileHeaderFrameHeader.size;
         _header = QJsonDocument::fromBinaryData(fileHeaderData);
     }
 
@@ -115,31 +129,216 @@ void PointerClip::init(uchar* data, size_t size) {
         _compressed = _header.object()[FRAME_COMREPSSION_FLAG].toBool();
     }
 
-    // Find the type enum translation map and fix up the frame headers
+    // Find the type enum translation map
     {
-        FrameTranslationMap translationMap = parseTranslationMap(_header);
-        if (translationMap.empty()) {
+        _translationMap = parseTranslationMap(_header);
+        if (_translationMap.empty()) {
             qWarning() << "Header missing frame type map, invalid file";
             reset();
             return;
         }
+    }
 
-        // Update the loaded headers with the frame data
-        _frames.reserve(parsedFrameHeaders.size());
-        for (auto& frameHeader : parsedFrameHeaders) {
-            if (!translationMap.contains(frameHeader.type)) {
-                continue;
-            }
-            frameHeader.type = translationMap[frameHeader.type];
-            _frames.push_back(frameHeader);
+    auto version = _header.object()[FORMAT_VERSION].toInt(1);
+    if (version > CHUNKED_FORMAT_VERSION) {
+        qWarning() << "Unsupported clip version " << version;
+        reset();
+        return;
+    }
+
+    if (version == CHUNKED_FORMAT_VERSION) {
+        if (!parseChunkIndex(headerEnd)) {
+            qWarning() << "Invalid chunk index, invalid file";
+            reset();
+        }
+        return;
+    }
+
+    // Version 1 clips are a sequence of individually compressed frames, index them all
+    auto parsedFrameHeaders = parseFrameHeaders(data, size);
+    parsedFrameHeaders.pop_front();
+
+    // Update the loaded headers with the frame data
+    _frames.reserve(parsedFrameHeaders.size());
+    for (auto& frameHeader : parsedFrameHeaders) {
+        if (!_translationMap.contains(frameHeader.type)) {
+            continue;
+        }
+        frameHeader.type = _translationMap[frameHeader.type];
+        _frames.push_back(frameHeader);
+    }
+}
+
+bool PointerClip::parseChunkIndex(size_t headerEnd) {
+    if (_size < sizeof(ChunkTrailer)) {
+        return false;
+    }
+
+    ChunkTrailer trailer;
+    memcpy(&trailer, _data + _size - sizeof(ChunkTrailer), sizeof(ChunkTrailer));
+    quint64 indexSize = (quint64)trailer.chunkCount * sizeof(ChunkIndexEntry);
+    if (trailer.magic != CHUNK_TRAILER_MAGIC || trailer.indexOffset > _size ||
+        trailer.indexOffset + indexSize + sizeof(ChunkTrailer) != _size) {
+        return false;
+    }
+
+    _chunks.resize(trailer.chunkCount);
+    if (indexSize != 0) {
+        memcpy(_chunks.data(), _data + trailer.indexOffset, indexSize);
+    }
+
+    // The lookups rely on chunks being contiguous and sorted by time
+    size_t frameCount = 0;
+    Frame::Time lastTime = 0;
+    for (const auto& chunk : _chunks) {
+        if (chunk.firstFrame != frameCount || 0 == chunk.frameCount || chunk.startTime < lastTime ||
+            chunk.endTime < chunk.startTime || chunk.offset < headerEnd || chunk.offset > trailer.indexOffset ||
+            chunk.storedSize > trailer.indexOffset - chunk.offset) {
+            _chunks.clear();
+            return false;
         }
+        frameCount += chunk.frameCount;
+        lastTime = chunk.endTime;
+    }
+    _chunkedFrameCount = frameCount;
+    qDebug(recordingLog) << "Indexed " << _chunks.size() << " chunks of " << frameCount << " frames";
+    return true;
+}
+
+size_t PointerClip::frameCount() const {
+    Locker lock(_mutex);
+    if (_chunks.empty()) {
+        return ArrayClip::frameCount();
+    }
+    return _chunkedFrameCount;
+}
+
+// Internal only function, needs no locking
+size_t PointerClip::findChunk(size_t frameIndex) const {
+    auto itr = std::upper_bound(_chunks.begin(), _chunks.end(), frameIndex,
+        [](size_t index, const ChunkIndexEntry& chunk)->bool {
+            return index < chunk.firstFrame;
+        });
+    return (itr - _chunks.begin()) - 1;
+}
+
+// Internal only function, needs no locking
+bool PointerClip::loadChunk(size_t chunkIndex) const {
+    if (chunkIndex == _loadedChunk) {
+        return true;
+    }
+
+    _loadedChunk = INVALID_CHUNK;
+    _chunkFrames.clear();
+    const auto& chunk = _chunks[chunkIndex];
+    // No copy of the stored data, it is only read and outlives the clip's use of it
+    QByteArray storedData = QByteArray::fromRawData((const char*)_data + chunk.offset, chunk.storedSize);
+    _chunkData = chunk.compressed ? qUncompress(storedData) : storedData;
+    if ((uint32_t)_chunkData.size() != chunk.rawSize) {
+        qCWarning(recordingLog) << "Unable to decode chunk " << chunkIndex;
+        _chunkData.clear();
+        return false;
+    }
+
+    auto start = (const uchar*)_chunkData.constData();
+    auto current = start;
+    auto end = start + _chunkData.size();
+    _chunkFrames.reserve(chunk.frameCount);
+    while (_chunkFrames.size() < chunk.frameCount && (size_t)(end - current) >= CHUNK_FRAME_HEADER_SIZE) {
+        ChunkFrameHeader header;
+        memcpy(&(header.type), current, sizeof(FrameType));
+        current += sizeof(FrameType);
+        memcpy(&(header.timeOffset), current, sizeof(Frame::Time));
+        current += sizeof(Frame::Time);
+        memcpy(&(header.size), current, sizeof(uint32_t));
+        current += sizeof(uint32_t);
+        if ((size_t)(end - current) < header.size) {
+            break;
+        }
+        header.dataOffset = (uint32_t)(current - start);
+        // Frames of types this build doesn't know are kept, so the index stays valid, but nothing handles them
+        header.type = _translationMap.value(header.type, Frame::TYPE_INVALID);
+        current += header.size;
+        _chunkFrames.push_back(header);
     }
 
+    if (_chunkFrames.size() != chunk.frameCount) {
+        qCWarning(recordingLog) << "Truncated chunk " << chunkIndex;
+        _chunkFrames.clear();
+        _chunkData.clear();
+        return false;
+    }
+    _loadedChunk = chunkIndex;
+    return true;
+}
+
+// Internal only function, needs no locking
+size_t PointerClip::findFrame(Frame::Time offset) const {
+    if (_chunks.empty()) {
+        return ArrayClip::findFrame(offset);
+    }
+
+    // The first chunk that ends at or after offset holds the frame
+    auto itr = std::lower_bound(_chunks.begin(), _chunks.end(), offset,
+        [](const ChunkIndexEntry& chunk, Frame::Time time)->bool {
+            return chunk.endTime < time;
+        });
+    if (itr == _chunks.end()) {
+        return _chunkedFrameCount;
+    }
+    if (itr->startTime >= offset) {
+        return itr->firstFrame;
+    }
+
+    size_t chunkIndex = itr - _chunks.begin();
+    if (!loadChunk(chunkIndex)) {
+        return itr->firstFrame;
+    }
+    auto frameItr = std::lower_bound(_chunkFrames.begin(), _chunkFrames.end(), offset,
+        [](const ChunkFrameHeader& header, Frame::Time time)->bool {
+            return header.timeOffset < time;
+        });
+    return itr->firstFrame + (frameItr - _chunkFrames.begin());
+}
+
+// Internal only function, needs no locking
+Frame::Time PointerClip::frameTime(size_t frameIndex) const {
+    if (_chunks.empty()) {
+        return ArrayClip::frameTime(frameIndex);
+    }
+
+    const auto chunkIndex = findChunk(frameIndex);
+    const auto& chunk = _chunks[chunkIndex];
+    // The index has the times of the chunk ends, no need to decode for those
+    if (frameIndex == chunk.firstFrame) {
+        return chunk.startTime;
+    }
+    if (frameIndex == chunk.firstFrame + chunk.frameCount - 1) {
+        return chunk.endTime;
+    }
+    if (!loadChunk(chunkIndex)) {
+        return chunk.startTime;
+    }
+    return _chunkFrames[frameIndex - chunk.firstFrame].timeOffset;
 }
 
 // Internal only function, needs no locking
 FrameConstPointer PointerClip::readFrame(size_t frameIndex) const {
     FramePointer result;
+    if (!_chunks.empty()) {
+        if (frameIndex < _chunkedFrameCount) {
+            const auto chunkIndex = findChunk(frameIndex);
+            if (loadChunk(chunkIndex)) {
+                const auto& header = _chunkFrames[frameIndex - _chunks[chunkIndex].firstFrame];
+                result = std::make_shared<Frame>();
+                result->type = header.type;
+                result->timeOffset = header.timeOffset;
+                result->data = QByteArray(_chunkData.constData() + header.dataOffset, header.size);
+            }
+        }
+        return result;
+    }
+
     if (frameIndex < _frames.size()) {
         result = std::make_shared<Frame>();
         const auto& header = _frames[frameIndex];
@@ -15,8 +15,10 @@
 #include <mutex>
 
 #include <QtCore/QJsonDocument>
+#include <QtCore/QMap>
 
 #include "../Frame.h"
+#include "ChunkIndex.h"
 
 namespace recording {
 
@@ -29,6 +31,13 @@ struct PointerFrameHeader : public FrameHeader {
 
 using PointerFrameHeaderList = std::list<PointerFrameHeader>;
 
+struct ChunkFrameHeader : public FrameHeader {
+    uint32_t size { 0 };
+    uint32_t dataOffset { 0 };
+};
+
+// Reads clips from memory.  Version 1 clips are indexed frame by frame up front, version 2 clips only read their
+// chunk index, and decode the chunk being played on demand.
 class PointerClip : public ArrayClip<PointerFrameHeader> {
 public:
     using Pointer = std::shared_ptr<PointerClip>;
@@ -37,6 +46,7 @@ public:
     PointerClip(uchar* data, size_t size) { init(data, size); }
 
     void init(uchar* data, size_t size);
+    virtual size_t frameCount() const override;
     virtual void addFrame(FrameConstPointer) override;
     const QJsonDocument& getHeader() const {
         return _header;
@@ -46,11 +56,29 @@ public:
     static const qint64 MINIMUM_FRAME_SIZE = sizeof(FrameType) + sizeof(Frame::Time) + sizeof(FrameSize);
 protected:
     void reset() override;
+    virtual size_t findFrame(Frame::Time offset) const override;
+    virtual Frame::Time frameTime(size_t index) const override;
     virtual FrameConstPointer readFrame(size_t index) const override;
+
+    // The chunks have to lie between the end of the file header and the index
+    bool parseChunkIndex(size_t headerEnd);
+    size_t findChunk(size_t frameIndex) const;
+    bool loadChunk(size_t chunkIndex) const;
+
     QJsonDocument _header;
     uchar* _data { nullptr };
     size_t _size { 0 };
     bool _compressed { true };
+    QMap<FrameType, FrameType> _translationMap;
+
+    std::vector<ChunkIndexEntry> _chunks;
+    size_t _chunkedFrameCount { 0 };
+
+    // The one decoded chunk of a version 2 clip, the frame headers point into _chunkData
+    static const size_t INVALID_CHUNK = (size_t)-1;
+    mutable size_t _loadedChunk { INVALID_CHUNK };
+    mutable QByteArray _chunkData;
+    mutable std::vector<ChunkFrameHeader> _chunkFrames;
 };
 
 }
@@ -1134,7 +1134,11 @@ void Model::setURL(const QUrl& url) {
 
     auto resource = DependencyManager::get<ModelCache>()->getGeometryResource(url);
     if (resource) {
-        resource->setLoadPriority(this, _loadingPriority);
+        if (_loadingPriorityOperator) {
+            resource->setLoadPriorityOperator(this, _loadingPriorityOperator);
+        } else {
+            resource->setLoadPriority(this, _loadingPriority);
+        }
         _renderWatcher.setResource(resource);
     }
     onInvalidate();
@@ -1400,6 +1404,10 @@ void Model::updateClusterMatrices() {
 
     _needsUpdateClusterMatrices = false;
     const FBXGeometry& geometry = getFBXGeometry();
+    if (!_useDualQuaternionSkinning) {
+        // the meshes share joints, compute all of their matrices at once
+        _rig.getJointTransforms(_jointTransforms);
+    }
     for (int i = 0; i < (int) _meshStates.size(); i++) {
         MeshState& state = _meshStates[i];
         const FBXMesh& mesh = geometry.meshes.at(i);
@@ -1411,9 +1419,10 @@ void Model::updateClusterMatrices() {
                 Transform clusterTransform;
                 Transform::mult(clusterTransform, jointTransform, cluster.inverseBindTransform);
                 state.clusterDualQuaternions[j] = Model::TransformDualQuaternion(clusterTransform);
+            } else if (cluster.jointIndex >= 0 && cluster.jointIndex < (int)_jointTransforms.size()) {
+                glm_mat4u_mul(_jointTransforms[cluster.jointIndex], cluster.inverseBindMatrix, state.clusterMatrices[j]);
             } else {
-                auto jointMatrix = _rig.getJointTransform(cluster.jointIndex);
-                glm_mat4u_mul(jointMatrix, cluster.inverseBindMatrix, state.clusterMatrices[j]);
+                state.clusterMatrices[j] = cluster.inverseBindMatrix;
             }
         }
     }
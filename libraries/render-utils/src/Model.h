@@ -254,6 +254,8 @@ public:
     void setCollisionMesh(graphics::MeshPointer mesh);
 
     void setLoadingPriority(float priority) { _loadingPriority = priority; }
+    // Takes precedence over the fixed priority, for owners that move relative to the camera
+    void setLoadingPriorityOperator(std::function<float()> priorityOperator) { _loadingPriorityOperator = priorityOperator; }
 
     size_t getRenderInfoVertexCount() const { return _renderInfoVertexCount; }
     size_t getRenderInfoTextureSize();
@@ -382,6 +384,7 @@ protected:
     glm::vec3 _registrationPoint = glm::vec3(0.5f); /// the point in model space our center is snapped to
 
     std::vector<MeshState> _meshStates;
+    std::vector<glm::mat4> _jointTransforms; // scratch for updateClusterMatrices()
 
     virtual void initJointStates();
 
@@ -480,6 +483,7 @@ protected:
 
 private:
     float _loadingPriority { 0.0f };
+    std::function<float()> _loadingPriorityOperator;
 
     void calculateTextureInfo();
 
@@ -12,6 +12,8 @@
 #include <zlib.h>
 #include "Gzip.h"
 
+#include <QIODevice>
+
 const int GZIP_WINDOWS_BIT = 31;
 const int GZIP_CHUNK_SIZE = 4096;
 const int DEFAULT_MEM_LEVEL = 8;
@@ -86,6 +88,60 @@ bool gunzip(QByteArray source, QByteArray &destination) {
     return status == Z_STREAM_END;
 }
 
+bool gunzip(QIODevice& source, const std::function<bool(const char* data, int size)>& sink) {
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    strm.avail_in = 0;
+    strm.next_in = Z_NULL;
+
+    int status = inflateInit2(&strm, GZIP_WINDOWS_BIT);
+
+    if (status != Z_OK) {
+        return false;
+    }
+
+    char in[GZIP_CHUNK_SIZE];
+    while (status != Z_STREAM_END) {
+        qint64 chunkSize = source.read(in, GZIP_CHUNK_SIZE);
+        if (chunkSize <= 0) {
+            // truncated or unreadable
+            break;
+        }
+
+        strm.next_in = (unsigned char*)in;
+        strm.avail_in = (uInt)chunkSize;
+
+        do {
+            char out[GZIP_CHUNK_SIZE];
+
+            strm.next_out = (unsigned char*)out;
+            strm.avail_out = GZIP_CHUNK_SIZE;
+
+            status = inflate(&strm, Z_NO_FLUSH);
+
+            switch (status) {
+                case Z_NEED_DICT:
+                case Z_DATA_ERROR:
+                case Z_MEM_ERROR:
+                case Z_STREAM_ERROR:
+                    inflateEnd(&strm);
+                    return false;
+            }
+
+            int available = (GZIP_CHUNK_SIZE - strm.avail_out);
+            if (available > 0 && !sink(out, available)) {
+                inflateEnd(&strm);
+                return false;
+            }
+        } while (strm.avail_out == 0 && status != Z_STREAM_END);
+    }
+
+    inflateEnd(&strm);
+    return status == Z_STREAM_END;
+}
+
 bool gzip(QByteArray source, QByteArray &destination, int compressionLevel) {
     destination.clear();
     if (source.length() == 0) {
@@ -12,8 +12,12 @@
 #ifndef GZIP_H
 #define GZIP_H
 
+#include <functional>
+
 #include <QByteArray>
 
+class QIODevice;
+
 // The compression level must be Z_DEFAULT_COMPRESSION (-1), or between 0 and
 // 9: 1 gives best speed, 9 gives best compression, 0 gives no
 // compression at all (the input data is simply copied a block at a
@@ -24,4 +28,8 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel = -1)
 
 bool gunzip(QByteArray source, QByteArray &destination);
 
+// inflates source a block at a time and hands each block to sink, so the whole content never has to be
+// in memory.  Returning false from sink stops the inflation.
+bool gunzip(QIODevice& source, const std::function<bool(const char* data, int size)>& sink);
+
 #endif
@@ -0,0 +1,98 @@
+//
+//  ContentDefinedChunker.cpp
+//  libraries/shared/src/shared
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ContentDefinedChunker.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+const int ContentDefinedChunker::MIN_CHUNK_SIZE;
+const int ContentDefinedChunker::AVERAGE_CHUNK_SIZE;
+const int ContentDefinedChunker::MAX_CHUNK_SIZE;
+
+// the gear table has to be the same on every run, or the same content would be split differently
+static std::array<uint64_t, 256> makeGearTable() {
+    std::array<uint64_t, 256> table;
+    uint64_t state = 0x2545f4914f6cdd1dULL;
+    for (auto& value : table) {
+        // splitmix64
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        value = z ^ (z >> 31);
+    }
+    return table;
+}
+
+static const std::array<uint64_t, 256> GEAR = makeGearTable();
+
+int ContentDefinedChunker::findBoundary(const char* data, int size) {
+    if (size <= MIN_CHUNK_SIZE) {
+        return size;
+    }
+
+    // normalized chunking: a cut is harder to find before the average size and easier after it,
+    // which keeps most chunks close to the average.  The top bits of the fingerprint depend on the
+    // last 64 bytes so those are the ones tested.
+    const uint64_t HARD_MASK = ~0ULL << (64 - 18);
+    const uint64_t EASY_MASK = ~0ULL << (64 - 14);
+
+    auto bytes = reinterpret_cast<const uint8_t*>(data);
+    int normalSize = std::min(AVERAGE_CHUNK_SIZE, size);
+    int maxSize = std::min(MAX_CHUNK_SIZE, size);
+    uint64_t fingerprint = 0;
+    int i = MIN_CHUNK_SIZE;
+    for (; i < normalSize; ++i) {
+        fingerprint = (fingerprint << 1) + GEAR[bytes[i]];
+        if (!(fingerprint & HARD_MASK)) {
+            return i + 1;
+        }
+    }
+    for (; i < maxSize; ++i) {
+        fingerprint = (fingerprint << 1) + GEAR[bytes[i]];
+        if (!(fingerprint & EASY_MASK)) {
+            return i + 1;
+        }
+    }
+    return maxSize;
+}
+
+bool ContentDefinedChunker::append(const char* data, int size) {
+    // a boundary is only final once MAX_CHUNK_SIZE bytes are available, or the data has ended, so the
+    // buffer is topped up to that and no further
+    while (size > 0) {
+        int count = std::min(size, MAX_CHUNK_SIZE - _buffer.size());
+        _buffer.append(data, count);
+        data += count;
+        size -= count;
+        if (_buffer.size() == MAX_CHUNK_SIZE) {
+            int chunkSize = findBoundary(_buffer.constData(), _buffer.size());
+            if (!_handler(_buffer.left(chunkSize))) {
+                _buffer.clear();
+                return false;
+            }
+            _buffer.remove(0, chunkSize);
+        }
+    }
+    return true;
+}
+
+bool ContentDefinedChunker::finish() {
+    int offset = 0;
+    bool success = true;
+    while (success && offset < _buffer.size()) {
+        int chunkSize = findBoundary(_buffer.constData() + offset, _buffer.size() - offset);
+        success = _handler(_buffer.mid(offset, chunkSize));
+        offset += chunkSize;
+    }
+    _buffer.clear();
+    return success;
+}
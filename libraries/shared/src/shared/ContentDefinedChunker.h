@@ -0,0 +1,50 @@
+//
+//  ContentDefinedChunker.h
+//  libraries/shared/src/shared
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_Shared_ContentDefinedChunker_h
+#define hifi_Shared_ContentDefinedChunker_h
+
+#include <functional>
+
+#include <QtCore/QByteArray>
+
+// Splits data into chunks whose boundaries depend on the content around them, picked with a rolling gear hash.
+// An insertion or deletion only changes the chunks around it, so two versions of the same file share most of
+// their chunks.  Data can be fed a block at a time, it never buffers more than MAX_CHUNK_SIZE.
+class ContentDefinedChunker {
+public:
+    static const int MIN_CHUNK_SIZE = 16 * 1024;
+    static const int AVERAGE_CHUNK_SIZE = 64 * 1024;
+    static const int MAX_CHUNK_SIZE = 256 * 1024;
+
+    // returning false from the handler stops the chunker
+    using ChunkHandler = std::function<bool(const QByteArray& chunk)>;
+
+    ContentDefinedChunker(ChunkHandler handler) : _handler(handler) {}
+
+    // hands every chunk that is complete to the handler, returns false if the handler failed
+    bool append(const char* data, int size);
+
+    // hands what is left to the handler, the chunker can then be reused
+    bool finish();
+
+    // drops what is left without handing it out
+    void reset() { _buffer.clear(); }
+
+    // returns the size of the first chunk of data
+    static int findBoundary(const char* data, int size);
+
+private:
+    ChunkHandler _handler;
+    QByteArray _buffer;
+};
+
+#endif // hifi_Shared_ContentDefinedChunker_h
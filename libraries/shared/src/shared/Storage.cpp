@@ -8,6 +8,8 @@
 
 #include "Storage.h"
 
+#include <atomic>
+
 #include <QtCore/QFileInfo>
 #include <QtCore/QDebug>
 #include <QtCore/QLoggingCategory>
@@ -16,6 +18,22 @@ Q_LOGGING_CATEGORY(storagelogging, "hifi.core.storage")
 
 using namespace storage;
 
+static std::atomic<uint64_t> memoryStorageAllocationCount { 0 };
+static std::atomic<uint64_t> memoryStorageAllocatedBytes { 0 };
+static std::atomic<uint64_t> fileStorageMappingCount { 0 };
+
+uint64_t storage::getMemoryStorageAllocationCount() {
+    return memoryStorageAllocationCount.load();
+}
+
+uint64_t storage::getMemoryStorageAllocatedBytes() {
+    return memoryStorageAllocatedBytes.load();
+}
+
+uint64_t storage::getFileStorageMappingCount() {
+    return fileStorageMappingCount.load();
+}
+
 ViewStorage::ViewStorage(const storage::StoragePointer& owner, size_t size, const uint8_t* data)
     : _owner(owner), _size(size), _data(data) {}
 
@@ -41,6 +59,8 @@ StoragePointer Storage::toFileStorage(const QString& filename) const {
 }
 
 MemoryStorage::MemoryStorage(size_t size, const uint8_t* data) {
+    ++memoryStorageAllocationCount;
+    memoryStorageAllocatedBytes += size;
     _data.resize(size);
     if (data) {
         memcpy(_data.data(), data, size);
@@ -85,6 +105,8 @@ FileStorage::FileStorage(const QString& filename) : _file(filename) {
             qCDebug(storagelogging) << "Failed to map file, falling back to memory storage " << filename;
             _fallback = _file.readAll();
             _mapped = (uint8_t*)_fallback.data();
+        } else {
+            ++fileStorageMappingCount;
         }
         _valid = true;
     } else {
@@ -80,12 +80,19 @@ namespace storage {
         uint8_t* mutableData() override { throw std::runtime_error("Cannot modify ViewStorage");  }
         size_t size() const override { return _size; }
         operator bool() const override { return *_owner; }
+        const storage::StoragePointer& getOwner() const { return _owner; }
     private:
         const storage::StoragePointer _owner;
         const size_t _size;
         const uint8_t* _data;
     };
 
+    // Process wide counts of the buffers allocated by MemoryStorage and the files mapped by FileStorage,
+    // to profile how much copying a data path does
+    uint64_t getMemoryStorageAllocationCount();
+    uint64_t getMemoryStorageAllocatedBytes();
+    uint64_t getFileStorageMappingCount();
+
 }
 
 #endif // hifi_Storage_h
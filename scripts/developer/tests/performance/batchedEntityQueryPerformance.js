@@ -0,0 +1,166 @@
+//
+//  batchedEntityQueryPerformance.js
+//  scripts/developer/tests/performance
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+//  Compares the per-query cost of Entities.findRayIntersection, Entities.findEntities and Entities.findEntitiesInBox
+//  called once per query against their batched forms (findRayIntersections, findEntitiesInSpheres and
+//  findEntitiesInBoxes), and checks that both give the same answers.  For best results run this in an otherwise
+//  empty domain.
+//
+
+var NUM_ENTITIES_ON_SIDE = 20;
+var STRIDE = 1.0;
+var WIDTH = 0.5;
+var LIFETIME = 60;
+var NUM_QUERIES = 2000;
+var BATCH_SIZES = [1, 16, 64, 256, 2000];
+var SEARCH_RADIUS = 1.5;
+
+var center = Vec3.sum(MyAvatar.position, Vec3.multiply(NUM_ENTITIES_ON_SIDE, Quat.getFront(Camera.getOrientation())));
+var corner = Vec3.subtract(center, { x: NUM_ENTITIES_ON_SIDE * STRIDE / 2, y: 0, z: NUM_ENTITIES_ON_SIDE * STRIDE / 2 });
+var entityIDs = [];
+
+function createEntities() {
+    for (var i = 0; i < NUM_ENTITIES_ON_SIDE; i++) {
+        for (var j = 0; j < NUM_ENTITIES_ON_SIDE; j++) {
+            entityIDs.push(Entities.addEntity({
+                type: "Box",
+                name: "batchedEntityQueryPerformance-" + i + "." + j,
+                position: Vec3.sum(corner, { x: i * STRIDE, y: 0, z: j * STRIDE }),
+                dimensions: { x: WIDTH, y: WIDTH, z: WIDTH },
+                color: { red: 255 * i / NUM_ENTITIES_ON_SIDE, green: 255 * j / NUM_ENTITIES_ON_SIDE, blue: 128 },
+                lifetime: LIFETIME
+            }));
+        }
+    }
+}
+
+function randomPoint() {
+    return Vec3.sum(corner, {
+        x: Math.random() * NUM_ENTITIES_ON_SIDE * STRIDE,
+        y: 0,
+        z: Math.random() * NUM_ENTITIES_ON_SIDE * STRIDE
+    });
+}
+
+function createQueries() {
+    var queries = { rays: [], centers: [], radii: [], corners: [], dimensions: [] };
+    for (var i = 0; i < NUM_QUERIES; i++) {
+        var point = randomPoint();
+        queries.rays.push({ origin: Vec3.sum(point, { x: 0, y: 5, z: 0 }), direction: Vec3.UNIT_NEG_Y });
+        queries.centers.push(point);
+        queries.radii.push(SEARCH_RADIUS);
+        queries.corners.push(Vec3.subtract(point, { x: SEARCH_RADIUS, y: SEARCH_RADIUS, z: SEARCH_RADIUS }));
+        queries.dimensions.push({ x: 2 * SEARCH_RADIUS, y: 2 * SEARCH_RADIUS, z: 2 * SEARCH_RADIUS });
+    }
+    return queries;
+}
+
+function sameIDs(a, b) {
+    if (a.length !== b.length) {
+        return false;
+    }
+    var sortedA = a.slice().sort();
+    var sortedB = b.slice().sort();
+    for (var i = 0; i < sortedA.length; i++) {
+        if (sortedA[i] !== sortedB[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+function report(name, batchSize, elapsed, mismatches) {
+    var usecsPerQuery = (1000 * elapsed / NUM_QUERIES).toFixed(2);
+    print(name + " batch:" + batchSize + " " + usecsPerQuery + " usecs/query" +
+        (mismatches > 0 ? " MISMATCHES:" + mismatches : ""));
+}
+
+function runBenchmark() {
+    var queries = createQueries();
+    var i, start;
+
+    // one call per query
+    var singleRays = [];
+    start = Date.now();
+    for (i = 0; i < NUM_QUERIES; i++) {
+        singleRays.push(Entities.findRayIntersection(queries.rays[i]));
+    }
+    report("findRayIntersection", 1, Date.now() - start, 0);
+
+    var singleSpheres = [];
+    start = Date.now();
+    for (i = 0; i < NUM_QUERIES; i++) {
+        singleSpheres.push(Entities.findEntities(queries.centers[i], queries.radii[i]));
+    }
+    report("findEntities", 1, Date.now() - start, 0);
+
+    var singleBoxes = [];
+    start = Date.now();
+    for (i = 0; i < NUM_QUERIES; i++) {
+        singleBoxes.push(Entities.findEntitiesInBox(queries.corners[i], queries.dimensions[i]));
+    }
+    report("findEntitiesInBox", 1, Date.now() - start, 0);
+
+    // batched calls, results are checked after timing so the comparison isn't measured
+    function timeBatches(name, batchSize, query, matches) {
+        var results = [];
+        var batchStart = Date.now();
+        for (var first = 0; first < NUM_QUERIES; first += batchSize) {
+            results.push(query(first, first + batchSize));
+        }
+        var elapsed = Date.now() - batchStart;
+
+        var mismatches = 0;
+        var index = 0;
+        results.forEach(function (batch) {
+            batch.forEach(function (result) {
+                if (!matches(result, index)) {
+                    mismatches++;
+                }
+                index++;
+            });
+        });
+        report(name, batchSize, elapsed, mismatches);
+    }
+
+    BATCH_SIZES.forEach(function (batchSize) {
+        timeBatches("findRayIntersections", batchSize, function (first, last) {
+            return Entities.findRayIntersections(queries.rays.slice(first, last));
+        }, function (result, index) {
+            return result.entityID === singleRays[index].entityID;
+        });
+
+        timeBatches("findEntitiesInSpheres", batchSize, function (first, last) {
+            return Entities.findEntitiesInSpheres(queries.centers.slice(first, last), queries.radii.slice(first, last));
+        }, function (result, index) {
+            return sameIDs(result, singleSpheres[index]);
+        });
+
+        timeBatches("findEntitiesInBoxes", batchSize, function (first, last) {
+            return Entities.findEntitiesInBoxes(queries.corners.slice(first, last), queries.dimensions.slice(first, last));
+        }, function (result, index) {
+            return sameIDs(result, singleBoxes[index]);
+        });
+    });
+}
+
+function cleanup() {
+    entityIDs.forEach(function (entityID) {
+        Entities.deleteEntity(entityID);
+    });
+}
+
+Script.scriptEnding.connect(cleanup);
+
+createEntities();
+// give the entities a moment to land in the local tree before measuring
+Script.setTimeout(function () {
+    runBenchmark();
+    Script.stop();
+}, 2000);
@@ -289,6 +289,82 @@ void AnimInverseKinematicsTests::testSingleChain() {
     }
 }
 
+void AnimInverseKinematicsTests::testConvergentSolver() {
+
+    AnimContext context(false, false, false, glm::mat4(), glm::mat4());
+
+    FBXGeometry geometry;
+    makeTestFBXJoints(geometry);
+
+    AnimSkeleton::Pointer skeletonPtr = std::make_shared<AnimSkeleton>(geometry);
+    AnimInverseKinematics ikDoll("doll");
+    ikDoll.setSkeleton(skeletonPtr);
+    ikDoll.setSolverMode(AnimInverseKinematics::SolverMode::Convergent);
+
+    // A------>B------>C------>D
+    AnimPose pose;
+    pose.scale() = glm::vec3(1.0f);
+    pose.rot() = identity;
+    pose.trans() = origin;
+
+    AnimPoseVec underPoses;
+    underPoses.push_back(pose);
+    pose.trans() = xAxis;
+    for (int i = 1; i < (int)geometry.joints.size(); ++i) {
+        underPoses.push_back(pose);
+    }
+    ikDoll.loadPoses(underPoses);
+
+    glm::vec3 targetPosition(2.0f, 1.0f, 0.0f);
+    AnimVariantMap varMap;
+    varMap.set("positionD", targetPosition);
+    varMap.set("rotationD", quaterTurnAroundZ);
+    varMap.set("targetTypeD", (int)IKTarget::Type::RotationAndPosition);
+    varMap.set("poleVectorEnabledD", false);
+
+    const float ERROR_THRESHOLD = 0.01f;
+    std::vector<float> flexCoefficients = {1.0f, 1.0f, 1.0f, 1.0f};
+    ikDoll.setTargetVars(QString("D"), QString("positionD"), QString("rotationD"), QString("targetTypeD"),
+                         QString("weightD"), 1.0f, flexCoefficients, QString("poleVectorEnabledD"),
+                         QString("poleReferenceVectorD"), QString("poleVectorD"), ERROR_THRESHOLD);
+    AnimNode::Triggers triggers;
+    float dt = 1.0f;
+
+    // the solver stops iterating once the target is within its threshold
+    const int NUM_FRAMES = 10;
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        ikDoll.overlay(varMap, context, dt, triggers, underPoses);
+    }
+    QVERIFY(ikDoll.getMaxErrorOnLastSolve() <= ERROR_THRESHOLD);
+    QVERIFY(ikDoll.getNumIterationsOnLastSolve() < 16);
+
+    // nothing moved, so the previous solution is reused without solving
+    AnimPoseVec solution = ikDoll.overlay(varMap, context, dt, triggers, underPoses);
+    QCOMPARE(ikDoll.getNumIterationsOnLastSolve(), 0);
+    const AnimPoseVec& relativePoses = ikDoll.overlay(varMap, context, dt, triggers, underPoses);
+    QCOMPARE(ikDoll.getNumIterationsOnLastSolve(), 0);
+    for (size_t i = 0; i < solution.size(); i++) {
+        QCOMPARE_QUATS(relativePoses[i].rot(), solution[i].rot(), EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(relativePoses[i].trans(), solution[i].trans(), EPSILON);
+    }
+
+    // drawing the targets solves every frame, and turning it off solves once more to remove the markers
+    AnimContext debugContext(true, false, false, glm::mat4(), glm::mat4());
+    ikDoll.overlay(varMap, debugContext, dt, triggers, underPoses);
+    QVERIFY(ikDoll.getNumIterationsOnLastSolve() > 0);
+    ikDoll.overlay(varMap, context, dt, triggers, underPoses);
+    QVERIFY(ikDoll.getNumIterationsOnLastSolve() > 0);
+    ikDoll.overlay(varMap, context, dt, triggers, underPoses);
+    QCOMPARE(ikDoll.getNumIterationsOnLastSolve(), 0);
+
+    // moving the target solves again, warm started from the previous solution
+    targetPosition = glm::vec3(2.0f, 0.9f, 0.1f);
+    varMap.set("positionD", targetPosition);
+    ikDoll.overlay(varMap, context, dt, triggers, underPoses);
+    QVERIFY(ikDoll.getNumIterationsOnLastSolve() > 0);
+    QVERIFY(ikDoll.getMaxErrorOnLastSolve() <= ERROR_THRESHOLD);
+}
+
 void AnimInverseKinematicsTests::testBar() {
     // test AnimPose math
     // TODO: move this to other test file
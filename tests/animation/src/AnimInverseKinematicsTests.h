@@ -21,6 +21,7 @@ class AnimInverseKinematicsTests : public QObject {
     Q_OBJECT
 private slots:
     void testSingleChain();
+    void testConvergentSolver();
     void testBar();
 };
 
@@ -8,18 +8,29 @@
 //
 
 #include "AnimTests.h"
+
+#include <iostream>
+
+#include <glm/gtx/transform.hpp>
+#include <tbb/parallel_for.h>
+
 #include <AnimNodeLoader.h>
 #include <AnimClip.h>
+#include <AnimCompressedClip.h>
 #include <AnimBlendLinear.h>
 #include <AnimationLogging.h>
 #include <AnimVariant.h>
 #include <AnimExpression.h>
 #include <AnimUtil.h>
+#include <AnimPoseBuffer.h>
+#include <AnimSkeleton.h>
+#include <Rig.h>
 #include <NodeList.h>
 #include <AddressManager.h>
 #include <AccountManager.h>
 #include <ResourceManager.h>
 #include <StatTracker.h>
+#include <SharedUtil.h>
 #include <../QTestExtensions.h>
 
 QTEST_MAIN(AnimTests)
@@ -442,6 +453,391 @@ void AnimTests::testAnimPose() {
     }
 }
 
+// a pose that varies with index, with a uniform scale so the pose buffer doesn't fall back to the scalar code
+static AnimPose makeTestPose(int index) {
+    float t = (float)index;
+    glm::vec3 axis = glm::normalize(glm::vec3(sinf(t) + 1.5f, cosf(2.0f * t), sinf(3.0f * t)));
+    glm::quat rot = glm::angleAxis(0.7f * t, axis);
+    if (index % 3 == 0) {
+        rot = -rot;
+    }
+    return AnimPose(glm::vec3(1.0f + 0.1f * (index % 4)), rot, glm::vec3(0.1f * t, -0.2f * cosf(t), 0.3f));
+}
+
+static void comparePoses(const AnimPose& actual, const AnimPose& expected) {
+    const float EPSILON = 0.001f;
+    QCOMPARE_WITH_ABS_ERROR(actual.scale(), expected.scale(), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(actual.trans(), expected.trans(), EPSILON);
+
+    // q and -q are the same rotation
+    QCOMPARE_WITH_ABS_ERROR(fabsf(glm::dot(actual.rot(), expected.rot())), 1.0f, EPSILON);
+}
+
+void AnimTests::testPoseBufferBlend() {
+    const int NUM_POSES = 11; // not a multiple of the padding
+    AnimPoseVec a, b;
+    for (int i = 0; i < NUM_POSES; i++) {
+        a.push_back(makeTestPose(i));
+        b.push_back(makeTestPose(2 * i + 5));
+    }
+
+    AnimPoseBuffer aBuffer, bBuffer, resultBuffer;
+    aBuffer.load(a);
+    bBuffer.load(b);
+
+    for (float alpha : { 0.0f, 0.25f, 0.5f, 1.0f }) {
+        AnimPoseVec expected(NUM_POSES);
+        ::blend(NUM_POSES, a.data(), b.data(), alpha, expected.data());
+
+        AnimPoseBuffer::blend(aBuffer, bBuffer, alpha, resultBuffer);
+        QCOMPARE(resultBuffer.size(), (size_t)NUM_POSES);
+        for (int i = 0; i < NUM_POSES; i++) {
+            comparePoses(resultBuffer.get(i), expected[i]);
+        }
+    }
+}
+
+// a hierarchy with several roots and branches of different lengths
+static std::vector<FBXJoint> makeBranchingJoints() {
+    static const int PARENT_INDICES[] = { -1, 0, 1, 2, 1, 4, 5, 6, 0, 8, -1, 10, 3, 12, 12, 9, 15, 7, 2 };
+    std::vector<FBXJoint> joints;
+    for (int parentIndex : PARENT_INDICES) {
+        FBXJoint joint;
+        joint.name = QString("joint%1").arg(joints.size());
+        joint.parentIndex = parentIndex;
+        joint.translation = glm::vec3(0.0f, 0.1f, 0.0f);
+        joint.preTransform = glm::mat4();
+        joint.preRotation = glm::quat();
+        joint.rotation = glm::quat();
+        joint.postRotation = glm::quat();
+        joint.postTransform = glm::mat4();
+        joints.push_back(joint);
+    }
+    return joints;
+}
+
+void AnimTests::testPoseBufferAbsolute() {
+    AnimSkeleton skeleton(makeBranchingJoints());
+    const int numJoints = skeleton.getNumJoints();
+    QCOMPARE(skeleton.getHierarchy().isValid, true);
+
+    AnimPoseVec relativePoses;
+    for (int i = 0; i < numJoints; i++) {
+        relativePoses.push_back(makeTestPose(i));
+    }
+
+    // the scalar code, with matrices
+    const AnimPose rootPose(glm::vec3(2.0f), glm::angleAxis(0.5f, glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(1.0f, 2.0f, 3.0f));
+    AnimPoseVec expected(numJoints);
+    for (int i = 0; i < numJoints; i++) {
+        int parentIndex = skeleton.getParentIndex(i);
+        expected[i] = (parentIndex == -1 ? rootPose : expected[parentIndex]) * relativePoses[i];
+    }
+
+    AnimPoseBuffer buffer;
+    buffer.load(relativePoses);
+    QCOMPARE(buffer.hasUniformScale(), true);
+    buffer.convertRelativeToAbsolute(skeleton.getHierarchy(), rootPose);
+    for (int i = 0; i < numJoints; i++) {
+        comparePoses(buffer.get(i), expected[i]);
+    }
+
+    // the skeleton goes through the buffer too
+    AnimPoseVec absolutePoses = relativePoses;
+    skeleton.convertRelativePosesToAbsolute(absolutePoses);
+    for (int i = 0; i < numJoints; i++) {
+        int parentIndex = skeleton.getParentIndex(i);
+        AnimPose parentPose = parentIndex == -1 ? AnimPose::identity : absolutePoses[parentIndex];
+        comparePoses(absolutePoses[i], parentPose * relativePoses[i]);
+    }
+}
+
+void AnimTests::testPoseBufferMatrices() {
+    const int NUM_POSES = 13;
+    const float EPSILON = 0.001f;
+    AnimPoseVec poses;
+    for (int i = 0; i < NUM_POSES; i++) {
+        poses.push_back(makeTestPose(i));
+    }
+    poses.push_back(AnimPose(glm::vec3(2.0f, 0.5f, -1.5f), glm::quat(), glm::vec3(1.0f)));
+
+    AnimPoseBuffer buffer;
+    buffer.load(poses);
+    std::vector<glm::mat4> matrices(poses.size());
+    buffer.computeMatrices(matrices.data());
+    for (size_t i = 0; i < poses.size(); i++) {
+        QCOMPARE_WITH_ABS_ERROR(matrices[i], (glm::mat4)poses[i], EPSILON);
+    }
+}
+
+void AnimTests::testRigAnimLOD() {
+    Rig rig;
+    QCOMPARE((int)rig.getAnimLOD(), (int)Rig::AnimLOD::Full);
+    QCOMPARE(rig.isAnimLODUpdateDue(), true);
+
+    const float REDUCED_PERIOD = 1.0f / Rig::REDUCED_ANIM_LOD_HZ;
+    rig.setAnimLOD(Rig::AnimLOD::Reduced);
+    rig.accumulateAnimLODTime(0.6f * REDUCED_PERIOD);
+    QCOMPARE(rig.isAnimLODUpdateDue(), false);
+    rig.accumulateAnimLODTime(0.6f * REDUCED_PERIOD);
+    QCOMPARE(rig.isAnimLODUpdateDue(), true);
+
+    rig.setAnimLOD(Rig::AnimLOD::Frozen);
+    rig.accumulateAnimLODTime(10.0f);
+    QCOMPARE(rig.isAnimLODUpdateDue(), false);
+
+    // computing the poses restarts the count
+    rig.setAnimLOD(Rig::AnimLOD::Reduced);
+    rig.computeExternalPoses(glm::mat4());
+    QCOMPARE(rig.isAnimLODUpdateDue(), false);
+}
+
+// Moves the root along x by the time it has been evaluated for, and records the context it was evaluated with
+class AnimLODTestNode : public AnimNode {
+public:
+    AnimLODTestNode() : AnimNode(AnimNode::Type::Clip, "lodTest") {}
+
+    const AnimPoseVec& evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt,
+                                Triggers& triggersOut) override {
+        _time += dt;
+        _numEvaluations++;
+        _enableIK = context.getEnableIK();
+        _poses = _skeleton->getRelativeDefaultPoses();
+        _poses[0].trans() = glm::vec3(_time, 0.0f, 0.0f);
+        return _poses;
+    }
+
+    float _time { 0.0f };
+    int _numEvaluations { 0 };
+    bool _enableIK { true };
+
+protected:
+    const AnimPoseVec& getPosesInternal() const override { return _poses; }
+
+    AnimPoseVec _poses;
+};
+
+class AnimLODTestRig : public Rig {
+public:
+    void setAnimNode(const std::shared_ptr<AnimNode>& node) {
+        _animNode = node;
+        _animNode->setSkeleton(_animSkeleton);
+    }
+};
+
+static float getRootTranslationX(const Rig& rig) {
+    glm::vec3 translation;
+    rig.getJointTranslation(0, translation);
+    return translation.x;
+}
+
+// Hips with a Spine above it
+static FBXGeometry makeTwoJointGeometry() {
+    const float PI = (float)M_PI;
+    FBXGeometry geometry;
+    FBXJoint joint;
+    joint.isFree = false;
+    joint.parentIndex = -1;
+    joint.distanceToParent = 1.0f;
+    joint.translation = glm::vec3();
+    joint.preTransform = glm::mat4();
+    joint.preRotation = glm::quat();
+    joint.rotation = glm::quat();
+    joint.postRotation = glm::quat();
+    joint.postTransform = glm::mat4();
+    joint.transform = glm::mat4();
+    joint.rotationMin = glm::vec3(-PI);
+    joint.rotationMax = glm::vec3(PI);
+    joint.inverseDefaultRotation = glm::quat();
+    joint.inverseBindRotation = glm::quat();
+    joint.bindTransform = glm::mat4();
+    joint.isSkeletonJoint = true;
+    joint.hasGeometricOffset = false;
+    joint.name = "Hips";
+    geometry.joints.push_back(joint);
+    joint.name = "Spine";
+    joint.parentIndex = 0;
+    joint.translation = glm::vec3(0.0f, 1.0f, 0.0f);
+    geometry.joints.push_back(joint);
+    return geometry;
+}
+
+void AnimTests::testRigReducedAnimLOD() {
+    FBXGeometry geometry = makeTwoJointGeometry();
+    AnimLODTestRig rig;
+    rig.initJointStates(geometry, glm::mat4());
+    auto node = std::make_shared<AnimLODTestNode>();
+    rig.setAnimNode(node);
+
+    const float EPSILON = 0.0001f;
+    const float REDUCED_PERIOD = 1.0f / Rig::REDUCED_ANIM_LOD_HZ;
+    const float START_TIME = 0.01f;
+    rig.updateAnimations(START_TIME, glm::mat4(), glm::mat4());
+    QCOMPARE(node->_numEvaluations, 1);
+    QCOMPARE(node->_enableIK, true);
+    QCOMPARE_WITH_ABS_ERROR(getRootTranslationX(rig), START_TIME, EPSILON);
+
+    // the first update at reduced LOD evaluates the graph, without IK, and stays on the poses it had
+    const float STEP = 0.25f * REDUCED_PERIOD;
+    rig.setAnimLOD(Rig::AnimLOD::Reduced);
+    rig.updateAnimations(STEP, glm::mat4(), glm::mat4());
+    QCOMPARE(node->_numEvaluations, 2);
+    QCOMPARE(node->_enableIK, false);
+    QCOMPARE_WITH_ABS_ERROR(getRootTranslationX(rig), START_TIME, EPSILON);
+
+    // the updates until the next evaluation interpolate towards the evaluated poses
+    for (int i = 1; i < 4; i++) {
+        rig.updateAnimations(STEP, glm::mat4(), glm::mat4());
+        QCOMPARE(node->_numEvaluations, 2);
+        QCOMPARE_WITH_ABS_ERROR(getRootTranslationX(rig), START_TIME + 0.25f * (float)i * STEP, EPSILON);
+    }
+
+    // the next evaluation catches up with the skipped time, and is interpolated to from where the rig is
+    float lastX = getRootTranslationX(rig);
+    rig.updateAnimations(2.0f * STEP, glm::mat4(), glm::mat4());
+    QCOMPARE(node->_numEvaluations, 3);
+    QCOMPARE(node->_enableIK, false);
+    QCOMPARE_WITH_ABS_ERROR(node->_time, START_TIME + 6.0f * STEP, EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(getRootTranslationX(rig), lastX, EPSILON);
+    rig.updateAnimations(2.0f * STEP, glm::mat4(), glm::mat4());
+    QCOMPARE(node->_numEvaluations, 3);
+    QCOMPARE_WITH_ABS_ERROR(getRootTranslationX(rig), lastX + 0.5f * (node->_time - lastX), EPSILON);
+
+    // back at full LOD every update evaluates with IK
+    rig.setAnimLOD(Rig::AnimLOD::Full);
+    rig.updateAnimations(STEP, glm::mat4(), glm::mat4());
+    QCOMPARE(node->_numEvaluations, 4);
+    QCOMPARE(node->_enableIK, true);
+    QCOMPARE_WITH_ABS_ERROR(getRootTranslationX(rig), node->_time, EPSILON);
+}
+
+// smooth motion on every joint, with the translation of the root only
+static std::vector<AnimPoseVec> makeTestClipFrames(int numFrames, int numJoints) {
+    std::vector<AnimPoseVec> frames(numFrames);
+    for (int frame = 0; frame < numFrames; frame++) {
+        for (int joint = 0; joint < numJoints; joint++) {
+            float t = (float)frame / 30.0f;
+            glm::vec3 axis = glm::normalize(glm::vec3(1.0f, (float)(joint % 3), (float)(joint % 5) - 2.0f));
+            glm::quat rot = glm::angleAxis(sinf(2.0f * t + (float)joint), axis);
+            glm::vec3 trans(0.0f, 10.0f, 0.0f);
+            if (joint == 0) {
+                trans += glm::vec3(5.0f * sinf(t), 2.0f * sinf(4.0f * t), 20.0f * t);
+            }
+            frames[frame].push_back(AnimPose(glm::vec3(1.0f), rot, trans));
+        }
+    }
+    return frames;
+}
+
+void AnimTests::testCompressedClip() {
+    const int NUM_FRAMES = 120;
+    const int NUM_JOINTS = 20;
+    auto frames = makeTestClipFrames(NUM_FRAMES, NUM_JOINTS);
+
+    AnimCompressedClip::Tolerance tolerance;
+    AnimCompressedClip clip;
+    QCOMPARE(clip.compress(frames, tolerance), true);
+    QCOMPARE(clip.getNumFrames(), NUM_FRAMES);
+    QCOMPARE(clip.getNumJoints(), NUM_JOINTS);
+    QVERIFY(clip.getMemorySize() < NUM_FRAMES * NUM_JOINTS * sizeof(AnimPose));
+
+    float rootLength = 0.0f;
+    for (auto& poses : frames) {
+        rootLength = std::max(rootLength, glm::length(poses[0].trans()));
+    }
+
+    // every frame is within the tolerance, give or take the rounding of the decoder
+    const float EPSILON = 0.0001f;
+    const float maxRotationDistance = 2.0f * sinf(0.25f * tolerance.rotation) + EPSILON;
+    AnimPoseVec poses;
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        clip.decodeFrame(frame, poses);
+        for (int joint = 0; joint < NUM_JOINTS; joint++) {
+            const AnimPose& expected = frames[frame][joint];
+            glm::vec4 rot(poses[joint].rot().x, poses[joint].rot().y, poses[joint].rot().z, poses[joint].rot().w);
+            glm::vec4 expectedRot(expected.rot().x, expected.rot().y, expected.rot().z, expected.rot().w);
+            QVERIFY(std::min(glm::distance(rot, expectedRot), glm::distance(rot, -expectedRot)) <= maxRotationDistance);
+            float boneLength = joint == 0 ? rootLength : 10.0f;
+            QVERIFY(glm::distance(poses[joint].trans(), expected.trans()) <= tolerance.translation * boneLength + EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(poses[joint].scale(), expected.scale(), EPSILON);
+        }
+    }
+
+    // between frames the clip interpolates like AnimClip did
+    AnimPoseVec expected(NUM_JOINTS);
+    ::blend(NUM_JOINTS, frames[10].data(), frames[11].data(), 0.25f, expected.data());
+    clip.sample(10.25f, poses.data());
+    for (int joint = 0; joint < NUM_JOINTS; joint++) {
+        QCOMPARE_WITH_ABS_ERROR(fabsf(glm::dot(poses[joint].rot(), expected[joint].rot())), 1.0f, 0.001f);
+        QCOMPARE_WITH_ABS_ERROR(poses[joint].trans(), expected[joint].trans(), 0.01f);
+    }
+}
+
+void AnimTests::testClipBuilder() {
+    auto skeleton = std::make_shared<AnimSkeleton>(makeTwoJointGeometry());
+    const AnimCompressedClip::Tolerance tolerance;
+
+    // the mirror of a clip is built from its frames
+    const int NUM_FRAMES = 60;
+    auto source = std::make_shared<AnimClipFrames>();
+    source->uncompressedAnim = makeTestClipFrames(NUM_FRAMES, skeleton->getNumJoints());
+    source->numFrames = NUM_FRAMES;
+    source->numJoints = skeleton->getNumJoints();
+    auto frames = std::make_shared<AnimClipFrames>();
+    AnimClipBuilder builder(source, skeleton, "testClipBuilder", tolerance, frames);
+    builder.setAutoDelete(false);
+    builder.run();
+    QCOMPARE((bool)frames->isBuilt, true);
+    QCOMPARE(frames->hasMirror, true);
+    QCOMPARE(frames->numFrames, NUM_FRAMES);
+    QCOMPARE(frames->numJoints, skeleton->getNumJoints());
+    QCOMPARE(frames->mirrorAnim.getNumFrames(), NUM_FRAMES);
+    QVERIFY(frames->uncompressedMirrorAnim.empty());
+
+    // builders sharing the skeleton on several threads mirror the same as one on its own
+    const int NUM_BUILDERS = 8;
+    std::vector<std::shared_ptr<AnimClipFrames>> parallelFrames;
+    for (int i = 0; i < NUM_BUILDERS; i++) {
+        parallelFrames.push_back(std::make_shared<AnimClipFrames>());
+    }
+    tbb::parallel_for(0, NUM_BUILDERS, [&](int i) {
+        AnimClipBuilder parallelBuilder(source, skeleton, "testClipBuilder", tolerance, parallelFrames[i]);
+        parallelBuilder.setAutoDelete(false);
+        parallelBuilder.run();
+    });
+    AnimPoseVec expectedMirror, mirror;
+    for (auto& parallel : parallelFrames) {
+        QCOMPARE((bool)parallel->isBuilt, true);
+        QCOMPARE(parallel->mirrorAnim.getNumFrames(), NUM_FRAMES);
+        for (int frame = 0; frame < NUM_FRAMES; frame++) {
+            frames->mirrorAnim.decodeFrame(frame, expectedMirror);
+            parallel->mirrorAnim.decodeFrame(frame, mirror);
+            for (int joint = 0; joint < skeleton->getNumJoints(); joint++) {
+                QCOMPARE_WITH_ABS_ERROR(mirror[joint].trans(), expectedMirror[joint].trans(), 0.0001f);
+                QCOMPARE_WITH_ABS_ERROR(fabsf(glm::dot(mirror[joint].rot(), expectedMirror[joint].rot())), 1.0f, 0.0001f);
+            }
+        }
+    }
+
+    // clips too long to compress are kept uncompressed, mirror included
+    const int NUM_LONG_FRAMES = 70000;
+    auto longSource = std::make_shared<AnimClipFrames>();
+    longSource->uncompressedAnim = makeTestClipFrames(NUM_LONG_FRAMES, skeleton->getNumJoints());
+    longSource->numFrames = NUM_LONG_FRAMES;
+    longSource->numJoints = skeleton->getNumJoints();
+    auto longFrames = std::make_shared<AnimClipFrames>();
+    AnimClipBuilder longBuilder(longSource, skeleton, "testClipBuilder", tolerance, longFrames);
+    longBuilder.setAutoDelete(false);
+    longBuilder.run();
+    QCOMPARE((bool)longFrames->isBuilt, true);
+    QCOMPARE(longFrames->anim.isEmpty(), true);
+    QCOMPARE(longFrames->mirrorAnim.isEmpty(), true);
+    QCOMPARE((int)longFrames->uncompressedAnim.size(), NUM_LONG_FRAMES);
+    QCOMPARE((int)longFrames->uncompressedMirrorAnim.size(), NUM_LONG_FRAMES);
+    QCOMPARE_WITH_ABS_ERROR(longFrames->uncompressedAnim[NUM_LONG_FRAMES - 1][1].trans(),
+                            longSource->uncompressedAnim[NUM_LONG_FRAMES - 1][1].trans(), 0.0001f);
+}
+
 void AnimTests::testExpressionTokenizer() {
     QString str = "(10 +  x) >= 20.1 && (y != !z)";
     AnimExpression e("x");
@@ -672,3 +1068,165 @@ void AnimTests::testExpressionEvaluator() {
 }
 
 
+
+#ifdef MANUAL_TEST
+// a skeleton with the joint names of the default avatar, enough for its animations to drive it
+static void makeHumanoidFBXGeometry(FBXGeometry& geometry) {
+    struct JointDesc {
+        const char* name;
+        const char* parentName;
+        glm::vec3 translation;
+    };
+    static const JointDesc JOINTS[] = {
+        { "Hips", nullptr, glm::vec3(0.0f, 1.0f, 0.0f) },
+        { "Spine", "Hips", glm::vec3(0.0f, 0.1f, 0.0f) },
+        { "Spine1", "Spine", glm::vec3(0.0f, 0.1f, 0.0f) },
+        { "Spine2", "Spine1", glm::vec3(0.0f, 0.1f, 0.0f) },
+        { "Neck", "Spine2", glm::vec3(0.0f, 0.15f, 0.0f) },
+        { "Head", "Neck", glm::vec3(0.0f, 0.1f, 0.0f) },
+        { "LeftEye", "Head", glm::vec3(0.03f, 0.07f, 0.08f) },
+        { "RightEye", "Head", glm::vec3(-0.03f, 0.07f, 0.08f) },
+        { "LeftShoulder", "Spine2", glm::vec3(0.05f, 0.1f, 0.0f) },
+        { "LeftArm", "LeftShoulder", glm::vec3(0.12f, 0.0f, 0.0f) },
+        { "LeftForeArm", "LeftArm", glm::vec3(0.27f, 0.0f, 0.0f) },
+        { "LeftHand", "LeftForeArm", glm::vec3(0.25f, 0.0f, 0.0f) },
+        { "RightShoulder", "Spine2", glm::vec3(-0.05f, 0.1f, 0.0f) },
+        { "RightArm", "RightShoulder", glm::vec3(-0.12f, 0.0f, 0.0f) },
+        { "RightForeArm", "RightArm", glm::vec3(-0.27f, 0.0f, 0.0f) },
+        { "RightHand", "RightForeArm", glm::vec3(-0.25f, 0.0f, 0.0f) },
+        { "LeftUpLeg", "Hips", glm::vec3(0.1f, -0.05f, 0.0f) },
+        { "LeftLeg", "LeftUpLeg", glm::vec3(0.0f, -0.45f, 0.0f) },
+        { "LeftFoot", "LeftLeg", glm::vec3(0.0f, -0.42f, 0.0f) },
+        { "LeftToeBase", "LeftFoot", glm::vec3(0.0f, -0.05f, 0.12f) },
+        { "RightUpLeg", "Hips", glm::vec3(-0.1f, -0.05f, 0.0f) },
+        { "RightLeg", "RightUpLeg", glm::vec3(0.0f, -0.45f, 0.0f) },
+        { "RightFoot", "RightLeg", glm::vec3(0.0f, -0.42f, 0.0f) },
+        { "RightToeBase", "RightFoot", glm::vec3(0.0f, -0.05f, 0.12f) }
+    };
+
+    FBXJoint joint;
+    joint.isFree = false;
+    joint.distanceToParent = 0.0f;
+    joint.preTransform = glm::mat4();
+    joint.preRotation = glm::quat();
+    joint.rotation = glm::quat();
+    joint.postRotation = glm::quat();
+    joint.postTransform = glm::mat4();
+    joint.rotationMin = glm::vec3(-(float)M_PI);
+    joint.rotationMax = glm::vec3((float)M_PI);
+    joint.inverseDefaultRotation = glm::quat();
+    joint.inverseBindRotation = glm::quat();
+    joint.isSkeletonJoint = true;
+
+    for (auto& desc : JOINTS) {
+        joint.name = desc.name;
+        joint.parentIndex = desc.parentName ? geometry.getJointIndex(desc.parentName) : -1;
+        joint.translation = desc.translation;
+        glm::mat4 parentTransform = joint.parentIndex >= 0 ? geometry.joints[joint.parentIndex].transform : glm::mat4();
+        joint.transform = parentTransform * glm::translate(joint.translation);
+        joint.bindTransform = joint.transform;
+        geometry.joints.push_back(joint);
+        geometry.jointIndices[joint.name] = geometry.joints.size();
+    }
+    geometry.rootJointIndex = geometry.getJointIndex("Hips");
+    geometry.leftEyeJointIndex = geometry.getJointIndex("LeftEye");
+    geometry.rightEyeJointIndex = geometry.getJointIndex("RightEye");
+}
+
+// Evaluates many copies of the default avatar-animation.json graph, one after the other and then spread over the
+// TBB workers, the way other avatars' rigs are updated, and prints the cost per avatar.
+void AnimTests::benchmarkRigs() {
+    const QUrl graphUrl = QUrl::fromLocalFile(QFINDTESTDATA("../../../interface/resources/avatar/avatar-animation.json"));
+    const int NUM_RIGS = 200;
+    const int NUM_FRAMES = 100;
+    const float DELTA_TIME = 1.0f / 90.0f;
+    const int LOAD_TIMEOUT = 10000; // msec
+
+    FBXGeometry geometry;
+    makeHumanoidFBXGeometry(geometry);
+
+    std::vector<std::unique_ptr<Rig>> rigs;
+    int numLoaded = 0;
+    for (int i = 0; i < NUM_RIGS; ++i) {
+        rigs.emplace_back(new Rig());
+        Rig* rig = rigs.back().get();
+        rig->initJointStates(geometry, glm::mat4());
+        connect(rig, &Rig::onLoadComplete, [&numLoaded] { ++numLoaded; });
+        rig->initAnimGraph(graphUrl);
+    }
+
+    // let the graphs, then their clips, load
+    QElapsedTimer loadTimer;
+    loadTimer.start();
+    while (numLoaded < NUM_RIGS && loadTimer.elapsed() < LOAD_TIMEOUT) {
+        QCoreApplication::processEvents();
+    }
+    QVERIFY(numLoaded == NUM_RIGS);
+    const int CLIP_LOAD_WAIT = 2000; // msec
+    QTest::qWait(CLIP_LOAD_WAIT);
+
+    // the first evaluation copies the loaded clips into the nodes
+    for (auto& rig : rigs) {
+        rig->updateAnimations(DELTA_TIME, glm::mat4(), glm::mat4());
+    }
+
+    uint64_t startTime = usecTimestampNow();
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        for (auto& rig : rigs) {
+            rig->updateAnimations(DELTA_TIME, glm::mat4(), glm::mat4());
+        }
+    }
+    uint64_t serialTime = usecTimestampNow() - startTime;
+
+    startTime = usecTimestampNow();
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, rigs.size()), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                rigs[i]->updateAnimations(DELTA_TIME, glm::mat4(), glm::mat4());
+            }
+        });
+    }
+    uint64_t parallelTime = usecTimestampNow() - startTime;
+
+    const float NUM_UPDATES = (float)(NUM_RIGS * NUM_FRAMES);
+    std::cout << "[numRigs, numFrames] = [" << NUM_RIGS << ", " << NUM_FRAMES << "]" << std::endl;
+    std::cout << "serial usec per avatar = " << (float)serialTime / NUM_UPDATES << std::endl;
+    std::cout << "parallel usec per avatar = " << (float)parallelTime / NUM_UPDATES << std::endl;
+}
+
+// Compares the memory and the evaluation cost of a clip's frames, stored as they were before and compressed
+void AnimTests::benchmarkCompressedClip() {
+    const int NUM_FRAMES = 300;
+    const int NUM_JOINTS = 60;
+    const int NUM_EVALUATIONS = 100000;
+    auto frames = makeTestClipFrames(NUM_FRAMES, NUM_JOINTS);
+
+    AnimCompressedClip clip;
+    uint64_t start = usecTimestampNow();
+    clip.compress(frames, AnimCompressedClip::Tolerance());
+    uint64_t compressTime = usecTimestampNow() - start;
+
+    size_t uncompressedSize = NUM_FRAMES * (sizeof(AnimPoseVec) + NUM_JOINTS * sizeof(AnimPose));
+    std::cout << "[numFrames, numJoints] = [" << NUM_FRAMES << ", " << NUM_JOINTS << "]" << std::endl;
+    std::cout << "uncompressed bytes = " << uncompressedSize << std::endl;
+    std::cout << "compressed bytes = " << clip.getMemorySize() << ", in usec = " << compressTime << std::endl;
+
+    AnimPoseVec poses(NUM_JOINTS);
+    start = usecTimestampNow();
+    for (int i = 0; i < NUM_EVALUATIONS; i++) {
+        float frame = fmodf(0.37f * (float)i, (float)(NUM_FRAMES - 1));
+        int index = (int)frame;
+        ::blend(NUM_JOINTS, frames[index].data(), frames[index + 1].data(), frame - (float)index, poses.data());
+    }
+    uint64_t uncompressedTime = usecTimestampNow() - start;
+
+    start = usecTimestampNow();
+    for (int i = 0; i < NUM_EVALUATIONS; i++) {
+        clip.sample(fmodf(0.37f * (float)i, (float)(NUM_FRAMES - 1)), poses.data());
+    }
+    uint64_t compressedTime = usecTimestampNow() - start;
+
+    std::cout << "uncompressed usec per evaluation = " << (float)uncompressedTime / NUM_EVALUATIONS << std::endl;
+    std::cout << "compressed usec per evaluation = " << (float)compressedTime / NUM_EVALUATIONS << std::endl;
+}
+#endif // MANUAL_TEST
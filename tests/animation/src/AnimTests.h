@@ -13,6 +13,8 @@
 #include <QtTest/QtTest>
 #include <glm/glm.hpp>
 
+//#define MANUAL_TEST
+
 class AnimTests : public QObject {
     Q_OBJECT
 public:
@@ -27,9 +29,20 @@ private slots:
     void testVariant();
     void testAccumulateTime();
     void testAnimPose();
+    void testPoseBufferBlend();
+    void testPoseBufferAbsolute();
+    void testPoseBufferMatrices();
+    void testRigAnimLOD();
+    void testRigReducedAnimLOD();
+    void testCompressedClip();
+    void testClipBuilder();
     void testExpressionTokenizer();
     void testExpressionParser();
     void testExpressionEvaluator();
+#ifdef MANUAL_TEST
+    void benchmarkRigs();
+    void benchmarkCompressedClip();
+#endif // MANUAL_TEST
 };
 
 #endif // hifi_AnimTests_h
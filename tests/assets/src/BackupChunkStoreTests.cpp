@@ -0,0 +1,160 @@
+//
+//  BackupChunkStoreTests.cpp
+//  tests/assets/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BackupChunkStoreTests.h"
+
+#include <random>
+
+#include <QtCore/QTemporaryDir>
+
+#include <quazip5/quazip.h>
+
+#include "BackupChunkStore.h"
+
+QTEST_MAIN(BackupChunkStoreTests)
+
+static const QString MANIFEST_NAME = "models.json.gz.chunks";
+
+static QByteArray randomData(int size, unsigned int seed) {
+    std::mt19937 generator(seed);
+    QByteArray data;
+    data.resize(size);
+    for (int i = 0; i < size; ++i) {
+        data[i] = (char)(generator() & 0xff);
+    }
+    return data;
+}
+
+static int numChunkFiles(const QTemporaryDir& directory) {
+    return QDir(directory.path() + "/chunks").entryList(QDir::Files).size();
+}
+
+// writes data a block at a time into a new backup zip
+static bool writeBackup(BackupChunkStore& store, const QString& zipPath, const QByteArray& data) {
+    QuaZip zip { zipPath };
+    if (!zip.open(QuaZip::mdCreate)) {
+        return false;
+    }
+    store.beginFile();
+    const int BLOCK_SIZE = 10000;
+    for (int offset = 0; offset < data.size(); offset += BLOCK_SIZE) {
+        if (!store.append(data.constData() + offset, std::min(BLOCK_SIZE, data.size() - offset))) {
+            return false;
+        }
+    }
+    bool success = store.endFile(QFileInfo(zipPath).fileName(), zip, MANIFEST_NAME);
+    zip.close();
+    return success && zip.getZipError() == UNZ_OK;
+}
+
+static bool readBackup(BackupChunkStore& store, const QString& zipPath, QByteArray& data) {
+    QuaZip zip { zipPath };
+    return zip.open(QuaZip::mdUnzip) && store.readFile(zip, MANIFEST_NAME, data);
+}
+
+static bool loadBackup(BackupChunkStore& store, const QString& zipPath) {
+    QuaZip zip { zipPath };
+    return zip.open(QuaZip::mdUnzip) && store.loadBackup(QFileInfo(zipPath).fileName(), zip, MANIFEST_NAME);
+}
+
+void BackupChunkStoreTests::testWriteAndRead() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    BackupChunkStore store { directory.path() };
+
+    auto data = randomData(1024 * 1024 + 5, 1);
+    auto zipPath = directory.filePath("backup-1.zip");
+    QVERIFY(writeBackup(store, zipPath, data));
+
+    QByteArray read;
+    QVERIFY(store.readFile("backup-1.zip", MANIFEST_NAME, read));
+    QCOMPARE(read, data);
+    QVERIFY(readBackup(store, zipPath, read));
+    QCOMPARE(read, data);
+    QVERIFY(!store.readFile("backup-2.zip", MANIFEST_NAME, read));
+}
+
+void BackupChunkStoreTests::testSharedChunks() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    BackupChunkStore store { directory.path() };
+
+    auto data = randomData(2 * 1024 * 1024, 2);
+    QVERIFY(writeBackup(store, directory.filePath("backup-1.zip"), data));
+    int firstChunks = numChunkFiles(directory);
+    QVERIFY(firstChunks > 1);
+
+    // a backup after a small edit only adds the chunks around it
+    auto edited = data;
+    edited.replace(data.size() / 2, 10, randomData(10, 3));
+    QVERIFY(writeBackup(store, directory.filePath("backup-2.zip"), edited));
+    QVERIFY(numChunkFiles(directory) - firstChunks <= 2);
+
+    QByteArray read;
+    QVERIFY(readBackup(store, directory.filePath("backup-1.zip"), read));
+    QCOMPARE(read, data);
+    QVERIFY(readBackup(store, directory.filePath("backup-2.zip"), read));
+    QCOMPARE(read, edited);
+}
+
+void BackupChunkStoreTests::testReleaseBackup() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    auto data = randomData(2 * 1024 * 1024, 4);
+    auto edited = data;
+    edited.append(randomData(100 * 1000, 5));
+    {
+        BackupChunkStore store { directory.path() };
+        QVERIFY(writeBackup(store, directory.filePath("backup-1.zip"), data));
+        QVERIFY(writeBackup(store, directory.filePath("backup-2.zip"), edited));
+    }
+
+    // the references come back from the backups on disk
+    BackupChunkStore store { directory.path() };
+    QVERIFY(loadBackup(store, directory.filePath("backup-1.zip")));
+    QVERIFY(loadBackup(store, directory.filePath("backup-2.zip")));
+    int numChunks = numChunkFiles(directory);
+
+    // deleting the older backup keeps the chunks the newer one shares with it
+    store.releaseBackup("backup-1.zip");
+    QVERIFY(numChunkFiles(directory) <= numChunks);
+    QByteArray read;
+    QVERIFY(readBackup(store, directory.filePath("backup-2.zip"), read));
+    QCOMPARE(read, edited);
+
+    store.releaseBackup("backup-2.zip");
+    QCOMPARE(numChunkFiles(directory), 0);
+}
+
+void BackupChunkStoreTests::testMissingChunks() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    auto zipPath = directory.filePath("backup-1.zip");
+    {
+        BackupChunkStore store { directory.path() };
+        QVERIFY(writeBackup(store, zipPath, randomData(1024 * 1024, 6)));
+    }
+    auto chunks = QDir(directory.path() + "/chunks").entryInfoList(QDir::Files);
+    QVERIFY(!chunks.isEmpty());
+    QVERIFY(QFile::remove(chunks.first().absoluteFilePath()));
+
+    BackupChunkStore store { directory.path() };
+    QVERIFY(!loadBackup(store, zipPath));
+    QVERIFY(store.isMissingChunks("backup-1.zip"));
+    QByteArray read;
+    QVERIFY(!readBackup(store, zipPath, read));
+
+    // chunks no loaded backup refers to are cleaned up
+    QFile stray { directory.path() + "/chunks/stray" };
+    QVERIFY(stray.open(QIODevice::WriteOnly));
+    stray.close();
+    store.removeUnreferencedChunks();
+    QVERIFY(!QFile::exists(directory.path() + "/chunks/stray"));
+}
@@ -0,0 +1,26 @@
+//
+//  BackupChunkStoreTests.h
+//  tests/assets/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BackupChunkStoreTests_h
+#define hifi_BackupChunkStoreTests_h
+
+#include <QtTest/QtTest>
+
+class BackupChunkStoreTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testWriteAndRead();
+    void testSharedChunks();
+    void testReleaseBackup();
+    void testMissingChunks();
+};
+
+#endif // hifi_BackupChunkStoreTests_h
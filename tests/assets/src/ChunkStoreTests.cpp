@@ -0,0 +1,162 @@
+//
+//  ChunkStoreTests.cpp
+//  tests/assets/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ChunkStoreTests.h"
+
+#include <random>
+
+#include <QtCore/QTemporaryDir>
+
+#include <shared/ContentDefinedChunker.h>
+
+#include "ChunkStore.h"
+
+QTEST_MAIN(ChunkStoreTests)
+
+static QByteArray randomData(int size, unsigned int seed) {
+    std::mt19937 generator(seed);
+    QByteArray data;
+    data.resize(size);
+    for (int i = 0; i < size; ++i) {
+        data[i] = (char)(generator() & 0xff);
+    }
+    return data;
+}
+
+static AssetUtils::AssetHash hashOf(const QByteArray& data) {
+    return QString(AssetUtils::hashData(data).toHex());
+}
+
+static QByteArray readAll(const ChunkStore& store, const QByteArray& content) {
+    QByteArray data;
+    if (!store.read(hashOf(content), 0, content.size(), data)) {
+        return QByteArray();
+    }
+    return data;
+}
+
+void ChunkStoreTests::testChunking() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    ChunkStore store { QDir(directory.path()) };
+    QVERIFY(store.load());
+
+    // small content is a single chunk, large content is split within the chunk size limits
+    QByteArray small = randomData(ContentDefinedChunker::MIN_CHUNK_SIZE / 2, 1);
+    QVERIFY(store.add(hashOf(small), small));
+    QCOMPARE(store.getNumChunks(), 1);
+
+    const int LARGE_SIZE = 2 * 1024 * 1024;
+    QByteArray large = randomData(LARGE_SIZE, 2);
+    QVERIFY(store.add(hashOf(large), large));
+    int largeChunks = store.getNumChunks() - 1;
+    QVERIFY(largeChunks >= LARGE_SIZE / ContentDefinedChunker::MAX_CHUNK_SIZE);
+    QVERIFY(largeChunks <= LARGE_SIZE / ContentDefinedChunker::MIN_CHUNK_SIZE);
+
+    QCOMPARE(store.getNumAssets(), 2);
+    QCOMPARE(store.getAssetBytes(), (qint64)(small.size() + large.size()));
+    QCOMPARE(store.getStoredBytes(), store.getAssetBytes());
+    qint64 size;
+    QVERIFY(store.getSize(hashOf(large), size));
+    QCOMPARE(size, (qint64)LARGE_SIZE);
+    QCOMPARE(readAll(store, small), small);
+    QCOMPARE(readAll(store, large), large);
+}
+
+void ChunkStoreTests::testDedup() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    ChunkStore store { QDir(directory.path()) };
+    QVERIFY(store.load());
+
+    const int SIZE = 2 * 1024 * 1024;
+    QByteArray original = randomData(SIZE, 3);
+    QVERIFY(store.add(hashOf(original), original));
+    int originalChunks = store.getNumChunks();
+    qint64 originalStored = store.getStoredBytes();
+
+    // adding the same content again changes nothing
+    QVERIFY(store.add(hashOf(original), original));
+    QCOMPARE(store.getNumAssets(), 1);
+    QCOMPARE(store.getNumChunks(), originalChunks);
+
+    // an edit in the middle only adds the chunks around it
+    QByteArray edited = original;
+    edited.insert(SIZE / 2, randomData(100, 4));
+    QVERIFY(store.add(hashOf(edited), edited));
+    QCOMPARE(store.getNumAssets(), 2);
+    QVERIFY(store.getNumChunks() - originalChunks <= 3);
+    QVERIFY(store.getStoredBytes() - originalStored < 3 * ContentDefinedChunker::MAX_CHUNK_SIZE);
+    QCOMPARE(store.getAssetBytes(), (qint64)(original.size() + edited.size()));
+    QCOMPARE(readAll(store, edited), edited);
+}
+
+void ChunkStoreTests::testRangeReads() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    ChunkStore store { QDir(directory.path()) };
+    QVERIFY(store.load());
+
+    const int SIZE = 1024 * 1024 + 17;
+    QByteArray content = randomData(SIZE, 5);
+    auto hash = hashOf(content);
+    QVERIFY(store.add(hash, content));
+
+    // ranges within a chunk, across chunk boundaries and at either end
+    std::vector<std::pair<qint64, qint64>> ranges {
+        { 0, 1 }, { 0, SIZE }, { SIZE - 1, 1 }, { 100, 1000 },
+        { ContentDefinedChunker::MAX_CHUNK_SIZE - 10, 2 * ContentDefinedChunker::MAX_CHUNK_SIZE }, { 12345, 0 }
+    };
+    for (auto& range : ranges) {
+        QByteArray data;
+        QVERIFY(store.read(hash, range.first, range.second, data));
+        QCOMPARE(data, content.mid((int)range.first, (int)range.second));
+    }
+
+    // repeated reads come from the cached manifest and give the same bytes
+    QByteArray again;
+    QVERIFY(store.read(hash, 100, 1000, again));
+    QCOMPARE(again, content.mid(100, 1000));
+
+    // out of range or unknown
+    QByteArray data;
+    QVERIFY(!store.read(hash, -1, 10, data));
+    QVERIFY(!store.read(hash, SIZE - 5, 10, data));
+    QVERIFY(!store.read(hashOf("unknown"), 0, 1, data));
+}
+
+void ChunkStoreTests::testRemoveAndReload() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QByteArray first = randomData(1024 * 1024, 6);
+    QByteArray second = first;
+    second.append(randomData(1024, 7));
+    {
+        ChunkStore store { QDir(directory.path()) };
+        QVERIFY(store.load());
+        QVERIFY(store.add(hashOf(first), first));
+        QVERIFY(store.add(hashOf(second), second));
+        QVERIFY(store.remove(hashOf(first)));
+        QVERIFY(!store.contains(hashOf(first)));
+        // the shared chunks are still there for the other asset
+        QCOMPARE(readAll(store, second), second);
+    }
+
+    // the reference counts are rebuilt from the manifests
+    ChunkStore store { QDir(directory.path()) };
+    QVERIFY(store.load());
+    QCOMPARE(store.getNumAssets(), 1);
+    QCOMPARE(store.getAssetBytes(), (qint64)second.size());
+    QCOMPARE(store.getStoredBytes(), (qint64)second.size());
+    QCOMPARE(readAll(store, second), second);
+    QVERIFY(store.remove(hashOf(second)));
+    QCOMPARE(store.getNumChunks(), 0);
+    QCOMPARE(store.getStoredBytes(), (qint64)0);
+}
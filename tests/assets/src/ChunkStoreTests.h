@@ -0,0 +1,26 @@
+//
+//  ChunkStoreTests.h
+//  tests/assets/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ChunkStoreTests_h
+#define hifi_ChunkStoreTests_h
+
+#include <QtTest/QtTest>
+
+class ChunkStoreTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testChunking();
+    void testDedup();
+    void testRangeReads();
+    void testRemoveAndReload();
+};
+
+#endif // hifi_ChunkStoreTests_h
@@ -0,0 +1,116 @@
+//
+//  MeshOptimizerTest.cpp
+//  tests/baking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MeshOptimizerTest.h"
+
+#include <algorithm>
+#include <array>
+#include <random>
+
+#include <MeshOptimizer.h>
+
+QTEST_MAIN(MeshOptimizerTest)
+
+static const int GRID_SIZE = 64;
+
+// a GRID_SIZE x GRID_SIZE grid of quads with its triangles shuffled
+static QVector<int> makeShuffledGrid() {
+    std::vector<std::array<int, 3>> triangles;
+    for (int y = 0; y < GRID_SIZE; ++y) {
+        for (int x = 0; x < GRID_SIZE; ++x) {
+            int corner = y * (GRID_SIZE + 1) + x;
+            triangles.push_back({ { corner, corner + 1, corner + GRID_SIZE + 1 } });
+            triangles.push_back({ { corner + 1, corner + GRID_SIZE + 2, corner + GRID_SIZE + 1 } });
+        }
+    }
+    std::mt19937 random(42);
+    std::shuffle(triangles.begin(), triangles.end(), random);
+
+    QVector<int> indices;
+    for (const auto& triangle : triangles) {
+        indices << triangle[0] << triangle[1] << triangle[2];
+    }
+    return indices;
+}
+
+static QVector<int> sortedTriangles(const QVector<int>& indices) {
+    std::vector<std::array<int, 3>> triangles;
+    for (int i = 0; i < indices.size(); i += 3) {
+        triangles.push_back({ { indices[i], indices[i + 1], indices[i + 2] } });
+    }
+    std::sort(triangles.begin(), triangles.end());
+
+    QVector<int> sorted;
+    for (const auto& triangle : triangles) {
+        sorted << triangle[0] << triangle[1] << triangle[2];
+    }
+    return sorted;
+}
+
+void MeshOptimizerTest::testCacheMisses() {
+    // every vertex misses once with 4 entries, with 3 the fourth triangle has pushed the first one out
+    QVector<int> indices { 0, 1, 2, 2, 1, 3, 0, 1, 2 };
+    QCOMPARE(MeshOptimizer::countCacheMisses(indices, 4, 4), 4);
+    QCOMPARE(MeshOptimizer::countCacheMisses(indices, 4, 3), 7);
+}
+
+void MeshOptimizerTest::testVertexCache() {
+    const int numVertices = (GRID_SIZE + 1) * (GRID_SIZE + 1);
+    auto indices = makeShuffledGrid();
+
+    auto order = MeshOptimizer::optimizeVertexCache(indices, numVertices);
+    QCOMPARE(order.size(), indices.size() / 3);
+
+    QVector<int> optimized;
+    for (int triangle : order) {
+        optimized << indices[triangle * 3] << indices[triangle * 3 + 1] << indices[triangle * 3 + 2];
+    }
+    QCOMPARE(sortedTriangles(optimized), sortedTriangles(indices));
+
+    float acmrBefore = (float)MeshOptimizer::countCacheMisses(indices, numVertices) / order.size();
+    float acmrAfter = (float)MeshOptimizer::countCacheMisses(optimized, numVertices) / order.size();
+    QVERIFY(acmrBefore > 2.0f);
+    QVERIFY(acmrAfter < 0.8f);
+}
+
+void MeshOptimizerTest::testOptimizeMesh() {
+    FBXMesh mesh;
+    for (int y = 0; y <= GRID_SIZE; ++y) {
+        for (int x = 0; x <= GRID_SIZE; ++x) {
+            mesh.vertices << glm::vec3(x, y, 0.0f);
+            mesh.normals << glm::vec3(0.0f, 0.0f, 1.0f);
+        }
+    }
+    // a duplicate of every vertex, which the optimizer has to treat as the same one
+    const int numVertices = mesh.vertices.size();
+    mesh.vertices += mesh.vertices;
+    mesh.normals += mesh.normals;
+
+    auto indices = makeShuffledGrid();
+    for (int i = 0; i < indices.size(); i += 2) {
+        indices[i] += numVertices;
+    }
+    FBXMeshPart part;
+    part.triangleIndices = indices;
+    mesh.parts << part;
+
+    auto stats = MeshOptimizer::optimizeMesh(mesh, false);
+    QCOMPARE(stats.numTriangles, indices.size() / 3);
+    QVERIFY(stats.getACMRAfter() < stats.getACMRBefore());
+    QVERIFY(stats.getACMRAfter() < 0.8f);
+    QCOMPARE(sortedTriangles(mesh.parts[0].triangleIndices), sortedTriangles(indices));
+
+    // invalid index lists are left alone
+    QVector<int> partial { 0, 1 };
+    mesh.parts[0].triangleIndices = partial;
+    stats = MeshOptimizer::optimizeMesh(mesh, false);
+    QCOMPARE(stats.numTriangles, 0);
+    QCOMPARE(mesh.parts[0].triangleIndices, partial);
+}
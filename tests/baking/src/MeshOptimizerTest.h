@@ -0,0 +1,25 @@
+//
+//  MeshOptimizerTest.h
+//  tests/baking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MeshOptimizerTest_h
+#define hifi_MeshOptimizerTest_h
+
+#include <QtTest/QtTest>
+
+class MeshOptimizerTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testCacheMisses();
+    void testVertexCache();
+    void testOptimizeMesh();
+};
+
+#endif // hifi_MeshOptimizerTest_h
@@ -0,0 +1,101 @@
+//
+//  TextureBakerTest.cpp
+//  tests/baking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureBakerTest.h"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QTemporaryDir>
+#include <QtGui/QImage>
+
+#include <TextureBaker.h>
+
+QTEST_MAIN(TextureBakerTest)
+
+static QByteArray readFile(const QString& path) {
+    QFile file { path };
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+void TextureBakerTest::cleanup() {
+    TextureBaker::setBakedTextureCacheDirectory(QString());
+    TextureBaker::setSupercompressionEnabled(false);
+}
+
+void TextureBakerTest::testCacheKey() {
+    QByteArray image = "image content";
+    QString key = TextureBaker::getBakedTextureCacheFileName(image, image::TextureUsage::DEFAULT_TEXTURE);
+    QVERIFY(key.endsWith(BAKED_TEXTURE_EXT));
+    QCOMPARE(TextureBaker::getBakedTextureCacheFileName(image, image::TextureUsage::DEFAULT_TEXTURE), key);
+
+    // other content, usage or compression can't share a baked texture
+    QVERIFY(TextureBaker::getBakedTextureCacheFileName("other content", image::TextureUsage::DEFAULT_TEXTURE) != key);
+    QVERIFY(TextureBaker::getBakedTextureCacheFileName(image, image::TextureUsage::NORMAL_TEXTURE) != key);
+    TextureBaker::setSupercompressionEnabled(true);
+    QVERIFY(TextureBaker::getBakedTextureCacheFileName(image, image::TextureUsage::DEFAULT_TEXTURE) != key);
+}
+
+void TextureBakerTest::testCacheHitSkipsEncode() {
+    QTemporaryDir cacheDir;
+    QTemporaryDir outputDir;
+    QVERIFY(cacheDir.isValid());
+    QVERIFY(outputDir.isValid());
+    TextureBaker::setBakedTextureCacheDirectory(cacheDir.path());
+
+    // not an image, so the baker could only succeed by taking the cached result instead of encoding it
+    QByteArray original = "not an image";
+    QByteArray cachedKTX = "cached baked texture";
+    QFile cachedFile { QDir(cacheDir.path()).absoluteFilePath(
+        TextureBaker::getBakedTextureCacheFileName(original, image::TextureUsage::DEFAULT_TEXTURE)) };
+    QVERIFY(cachedFile.open(QIODevice::WriteOnly));
+    QCOMPARE(cachedFile.write(cachedKTX), (qint64)cachedKTX.size());
+    cachedFile.close();
+
+    TextureBaker baker(QUrl("file:///embedded/texture.png"), image::TextureUsage::DEFAULT_TEXTURE,
+                       QDir(outputDir.path()), "texture.ktx", original);
+    baker.bake();
+
+    QVERIFY(baker.isFinished());
+    QVERIFY(!baker.hasErrors());
+    QCOMPARE((int)baker.getOutputFiles().size(), 1);
+    QCOMPARE(readFile(baker.getDestinationFilePath()), cachedKTX);
+    // the original is still around for the model baker to save a copy of
+    QCOMPARE(baker.getOriginalTexture(), original);
+}
+
+void TextureBakerTest::testBakeAddsToCache() {
+    QTemporaryDir cacheDir;
+    QTemporaryDir outputDir;
+    QVERIFY(cacheDir.isValid());
+    QVERIFY(outputDir.isValid());
+    TextureBaker::setBakedTextureCacheDirectory(cacheDir.path());
+
+    QImage image(16, 16, QImage::Format_ARGB32);
+    image.fill(QColor(255, 128, 0));
+    QByteArray original;
+    QBuffer buffer { &original };
+    buffer.open(QIODevice::WriteOnly);
+    QVERIFY(image.save(&buffer, "PNG"));
+
+    TextureBaker baker(QUrl("file:///embedded/orange.png"), image::TextureUsage::DEFAULT_TEXTURE,
+                       QDir(outputDir.path()), "orange.ktx", original);
+    baker.bake();
+    QVERIFY(baker.isFinished());
+    QVERIFY(!baker.hasErrors());
+
+    // the cache now holds exactly what the bake wrote
+    QString cachedFilePath = QDir(cacheDir.path()).absoluteFilePath(
+        TextureBaker::getBakedTextureCacheFileName(original, image::TextureUsage::DEFAULT_TEXTURE));
+    QByteArray baked = readFile(baker.getDestinationFilePath());
+    QVERIFY(!baked.isEmpty());
+    QCOMPARE(readFile(cachedFilePath), baked);
+}
@@ -0,0 +1,26 @@
+//
+//  TextureBakerTest.h
+//  tests/baking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TextureBakerTest_h
+#define hifi_TextureBakerTest_h
+
+#include <QtTest/QtTest>
+
+class TextureBakerTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void cleanup();
+    void testCacheKey();
+    void testCacheHitSkipsEncode();
+    void testBakeAddsToCache();
+};
+
+#endif // hifi_TextureBakerTest_h
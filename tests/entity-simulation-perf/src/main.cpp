@@ -0,0 +1,75 @@
+//
+//  main.cpp
+//  tests/entity-simulation-perf/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Reports the average EntityTree::update() time of a SimpleEntitySimulation for increasing entity counts.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <QCoreApplication>
+#include <QDebug>
+
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+#include <SharedUtil.h>
+#include <SimpleEntitySimulation.h>
+
+const int NUM_TICKS = 100;
+
+// measures the average EntityTree::update() time with a SimpleEntitySimulation driving numEntities boxes,
+// half of them moving and a quarter of them mortal (with lifetimes long enough not to expire during the run)
+void benchmarkSimulationTick(int numEntities) {
+    EntityTreePointer tree = EntityTreePointer(new EntityTree(true));
+    tree->createRootElement();
+    SimpleEntitySimulationPointer simulation { new SimpleEntitySimulation() };
+    simulation->setEntityTree(tree);
+    tree->setSimulation(simulation);
+
+    const float WORLD_SIZE = 100.0f;
+    for (int i = 0; i < numEntities; ++i) {
+        EntityItemProperties properties;
+        properties.setType(EntityTypes::Box);
+        properties.setPosition(glm::vec3(randFloat(), randFloat(), randFloat()) * WORLD_SIZE);
+        properties.setDimensions(glm::vec3(0.1f));
+        if (i % 2 == 0) {
+            properties.setVelocity(glm::vec3(randFloatInRange(-1.0f, 1.0f), 0.0f, randFloatInRange(-1.0f, 1.0f)));
+            properties.setDamping(0.0f);
+        }
+        if (i % 4 == 0) {
+            properties.setLifetime(randFloatInRange(60.0f, 120.0f));
+        }
+        tree->withWriteLock([&] {
+            tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+        });
+    }
+
+    quint64 total = 0;
+    for (int i = 0; i < NUM_TICKS; ++i) {
+        quint64 start = usecTimestampNow();
+        tree->update(true);
+        total += usecTimestampNow() - start;
+    }
+    qDebug() << "simulation tick with" << numEntities << "entities:" << (total / NUM_TICKS) << "usecs";
+
+    // break the tree <-> simulation back pointers so both are released
+    tree->setSimulation(nullptr);
+    simulation->setEntityTree(nullptr);
+    tree->eraseAllOctreeElements();
+}
+
+int main(int argc, char** argv) {
+    setupHifiApplication("Entity Simulation Perf Test");
+
+    QCoreApplication app(argc, argv);
+    DependencyManager::set<NodeList>(NodeType::Unassigned);
+
+    for (int numEntities : { 1000, 4000, 16000, 64000 }) {
+        benchmarkSimulationTick(numEntities);
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+//
+//  FBXReaderTests.cpp
+//  tests/fbx/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXReaderTests.h"
+
+#include <memory>
+
+#include <FBXReader.h>
+#include <FBXSerializer.h>
+
+QTEST_GUILESS_MAIN(FBXReaderTests)
+
+static const QString FIXTURE_URL { "skinned-ribbon.fbx" };
+
+static std::unique_ptr<FBXGeometry> readFixtureGeometry(bool parallel) {
+    setParallelFBXMeshProcessingEnabled(parallel);
+    QFile file { QFINDTESTDATA("data/skinned-ribbon.fbx") };
+    if (!file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    return std::unique_ptr<FBXGeometry>(readFBX(&file, QVariantHash(), FIXTURE_URL));
+}
+
+void FBXReaderTests::cleanup() {
+    setParallelFBXMeshProcessingEnabled(true);
+}
+
+void FBXReaderTests::readFixture() {
+    // the fixture has to exercise what the mesh phases touch for the comparison below to mean something
+    auto geometry = readFixtureGeometry(true);
+    QVERIFY(geometry);
+
+    QCOMPARE(geometry->joints.size(), 4);
+    int hipsIndex = geometry->getJointIndex("Hips");
+    int spineIndex = geometry->getJointIndex("Spine");
+    QVERIFY(hipsIndex != -1 && spineIndex != -1);
+    QCOMPARE(geometry->joints[spineIndex].parentIndex, hipsIndex);
+
+    QCOMPARE(geometry->meshes.size(), 2);
+    const FBXMesh& ribbon = geometry->meshes[0];
+    QCOMPARE(ribbon.clusters.size(), 2);
+    QSet<int> clusterJoints { ribbon.clusters[0].jointIndex, ribbon.clusters[1].jointIndex };
+    QVERIFY(clusterJoints == QSet<int>({ hipsIndex, spineIndex }));
+    QCOMPARE(ribbon.clusterIndices.size(), ribbon.vertices.size() * 4);
+    QCOMPARE(ribbon.clusterWeights.size(), ribbon.vertices.size() * 4);
+    QCOMPARE(ribbon.blendshapes.size(), 1);
+    QVERIFY(!ribbon.blendshapes[0].indices.isEmpty());
+
+    const FBXMesh& screen = geometry->meshes[1];
+    QCOMPARE(screen.clusters.size(), 1);
+    QVERIFY(screen.clusterIndices.isEmpty());
+
+    QCOMPARE(geometry->animationFrames.size(), 4);
+    QVERIFY(geometry->animationFrames[0].rotations[spineIndex] != geometry->animationFrames[1].rotations[spineIndex]);
+
+    QCOMPARE(geometry->blendshapeChannelNames.size(), 1);
+    QVERIFY(geometry->materials.contains("401"));
+    const FBXTexture& texture = geometry->materials["401"].albedoTexture;
+    QCOMPARE(texture.filename, QByteArray("textures/screen.png"));
+    QVERIFY(!texture.content.isEmpty());
+}
+
+void FBXReaderTests::parallelMatchesSerial() {
+    auto serial = readFixtureGeometry(false);
+    auto parallel = readFixtureGeometry(true);
+    QVERIFY(serial && parallel);
+
+    QCOMPARE(parallel->meshes.size(), serial->meshes.size());
+    for (int i = 0; i < serial->meshes.size(); ++i) {
+        const FBXMesh& serialMesh = serial->meshes[i];
+        const FBXMesh& parallelMesh = parallel->meshes[i];
+        QCOMPARE(parallelMesh.meshIndex, serialMesh.meshIndex);
+        QVERIFY(parallelMesh.vertices == serialMesh.vertices);
+        QVERIFY(parallelMesh.normals == serialMesh.normals);
+        QVERIFY(parallelMesh.tangents == serialMesh.tangents);
+        QVERIFY(parallelMesh.texCoords == serialMesh.texCoords);
+        QVERIFY(parallelMesh.clusterIndices == serialMesh.clusterIndices);
+        QVERIFY(parallelMesh.clusterWeights == serialMesh.clusterWeights);
+        QVERIFY(parallelMesh.meshExtents.minimum == serialMesh.meshExtents.minimum);
+        QVERIFY(parallelMesh.meshExtents.maximum == serialMesh.meshExtents.maximum);
+        QCOMPARE(parallelMesh.blendshapes.size(), serialMesh.blendshapes.size());
+        for (int j = 0; j < serialMesh.blendshapes.size(); ++j) {
+            QVERIFY(parallelMesh.blendshapes[j].indices == serialMesh.blendshapes[j].indices);
+            QVERIFY(parallelMesh.blendshapes[j].vertices == serialMesh.blendshapes[j].vertices);
+            QVERIFY(parallelMesh.blendshapes[j].tangents == serialMesh.blendshapes[j].tangents);
+        }
+    }
+
+    // the joint shapes gather points from every mesh, in mesh order
+    QCOMPARE(parallel->joints.size(), serial->joints.size());
+    for (int i = 0; i < serial->joints.size(); ++i) {
+        QVERIFY(parallel->joints[i].shapeInfo.points == serial->joints[i].shapeInfo.points);
+        QVERIFY(parallel->joints[i].bindTransform == serial->joints[i].bindTransform);
+    }
+
+    // and everything else that is kept of the geometry, gpu meshes included
+    QCOMPARE(FBXSerializer::serialize(*parallel), FBXSerializer::serialize(*serial));
+}
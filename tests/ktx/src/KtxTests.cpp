@@ -140,6 +140,78 @@ void KtxTests::testKtxSerialization() {
     testTexture->setKtxBacking(TEST_IMAGE_KTX.fileName().toStdString());
 }
 
+void KtxTests::testKtxSupercompression() {
+    const QString TEST_IMAGE = getRootPath() + "/scripts/developer/tests/cube_texture.png";
+    QImage image(TEST_IMAGE);
+    gpu::TexturePointer testTexture = image::TextureUsage::process2DTextureColorFromImage(image, TEST_IMAGE.toStdString(), true);
+    auto ktxMemory = gpu::Texture::serialize(*testTexture);
+    QVERIFY(ktxMemory.get());
+
+    auto compressedStorage = ktx::KTX::supercompress(*ktxMemory);
+    QVERIFY(compressedStorage.get());
+    QVERIFY(compressedStorage->size() < ktxMemory->getStorage()->size());
+    QVERIFY(ktx::KTX::validate(compressedStorage));
+
+    // reading it back gives the original file, without the supercompression key
+    auto ktxFile = ktx::KTX::create(compressedStorage);
+    QVERIFY(ktxFile.get());
+    QVERIFY(ktxFile->isValid());
+    QVERIFY(!ktx::KTX::isSupercompressed(ktxFile->_keyValues));
+    const auto& memStorage = ktxMemory->getStorage();
+    const auto& fileStorage = ktxFile->getStorage();
+    QCOMPARE(fileStorage->size(), memStorage->size());
+    QVERIFY(0 == memcmp(memStorage->data(), fileStorage->data(), memStorage->size()));
+    QVERIFY(ktx::KTX::validate(fileStorage));
+
+    // the index locates every level, and each one inflates on its own
+    auto compressedHeader = reinterpret_cast<const ktx::Header*>(compressedStorage->data());
+    auto keyValues = ktx::KTX::parseKeyValues(compressedHeader->bytesOfKeyValueData, compressedStorage->data() + sizeof(ktx::Header));
+    auto compressedImages = ktx::KTX::getSupercompressedImages(*compressedHeader, keyValues);
+    QCOMPARE(compressedImages.size(), ktxMemory->_images.size());
+    auto imagesStart = compressedStorage->data() + sizeof(ktx::Header) + compressedHeader->bytesOfKeyValueData;
+    for (size_t i = 0; i < compressedImages.size(); ++i) {
+        const auto& original = ktxMemory->_images[i];
+        std::vector<uint8_t> level(original._imageSize);
+        QVERIFY(ktx::KTX::decompressImage(imagesStart + compressedImages[i]._imageOffset + ktx::IMAGE_SIZE_WIDTH,
+                                          compressedImages[i]._imageSize, level.data(), level.size()));
+        QVERIFY(0 == memcmp(level.data(), original._faceBytes[0], level.size()));
+        // the wrong size is an error rather than a partial level
+        QVERIFY(!ktx::KTX::decompressImage(imagesStart + compressedImages[i]._imageOffset + ktx::IMAGE_SIZE_WIDTH,
+                                           compressedImages[i]._imageSize, level.data(), level.size() - 1));
+    }
+
+    // truncating the last level makes it invalid
+    auto truncated = std::make_shared<storage::MemoryStorage>(compressedStorage->size() - 4, compressedStorage->data());
+    QVERIFY(!ktx::KTX::validate(truncated));
+    QVERIFY(!ktx::KTX::create(truncated).get());
+}
+
+void KtxTests::testHeldKtxViews() {
+    QTemporaryFile mappedFile;
+    QVERIFY(mappedFile.open());
+    mappedFile.write(QByteArray(4096, 'k'));
+    mappedFile.close();
+
+    auto file = std::make_shared<storage::FileStorage>(mappedFile.fileName());
+    std::weak_ptr<storage::FileStorage> weakFile = file;
+    QVERIFY(file->size() == 4096);
+
+    // a view of a view, as queued transfers make of a mip
+    auto view = file->createView(1024, 1024)->createView(512, 256);
+    file.reset();
+    gpu::Texture::KtxStorage::holdKtxView(view);
+
+    // the held file stays in the open file list across frames
+    gpu::Texture::KtxStorage::releaseOpenKtxFiles();
+    gpu::Texture::KtxStorage::releaseKtxView(view);
+    view.reset();
+    QVERIFY(!weakFile.expired());
+
+    // and is closed by the first release once the view is done with
+    gpu::Texture::KtxStorage::releaseOpenKtxFiles();
+    QVERIFY(weakFile.expired());
+}
+
 #if 0
 
 static const QString TEST_FOLDER { "H:/ktx_cacheold" };
@@ -0,0 +1,330 @@
+//
+//  GeometryFileCacheTests.cpp
+//  tests/model-networking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GeometryFileCacheTests.h"
+
+#include <QElapsedTimer>
+
+#include <AssetUtils.h>
+#include <FBXReader.h>
+#include <FBXSerializer.h>
+#include <OBJReader.h>
+#include <model-networking/GeometryFileCache.h>
+
+QTEST_GUILESS_MAIN(GeometryFileCacheTests)
+
+static const QString TEST_URL { "grid.obj" };
+static const QString FBX_TEST_URL { "skinned-ribbon.fbx" };
+
+// A grid of quads with texture coordinates and normals
+static QByteArray makeGridOBJ(int size) {
+    QByteArray obj;
+    QTextStream stream(&obj);
+    for (int y = 0; y <= size; ++y) {
+        for (int x = 0; x <= size; ++x) {
+            stream << "v " << x << " " << y << " 0\n";
+            stream << "vt " << (float)x / size << " " << (float)y / size << "\n";
+        }
+    }
+    stream << "vn 0 0 1\n";
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            // OBJ indices are 1-based
+            int a = y * (size + 1) + x + 1;
+            int b = a + 1;
+            int c = b + size + 1;
+            int d = a + size + 1;
+            stream << "f " << a << "/" << a << "/1 " << b << "/" << b << "/1 "
+                << c << "/" << c << "/1 " << d << "/" << d << "/1\n";
+        }
+    }
+    stream.flush();
+    return obj;
+}
+
+static FBXGeometry::Pointer parseOBJ(QByteArray& obj) {
+    return OBJReader().readOBJ(obj, QVariantHash(), true);
+}
+
+// The skinned fixture of the FBX reader tests: clusters, a blendshape, animation frames and an embedded texture
+static FBXGeometry::Pointer readFBXFixture(QByteArray& content) {
+    QFile file { QFINDTESTDATA("../../fbx/src/data/skinned-ribbon.fbx") };
+    if (!file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    content = file.readAll();
+    return FBXGeometry::Pointer(readFBX(content, QVariantHash(), FBX_TEST_URL));
+}
+
+static GeometryFileCache::Key getKey(const QByteArray& content) {
+    return GeometryFileCache::getKey(QString(AssetUtils::hashData(content).toHex()), QVariantHash());
+}
+
+static std::shared_ptr<GeometryFileCache> makeGeometryFileCache(const QString& location) {
+    auto cache = std::make_shared<GeometryFileCache>(location.toStdString(), "hfg");
+    cache->initialize();
+    return cache;
+}
+
+static QByteArray getViewBytes(const gpu::BufferView& view) {
+    if (!view._buffer) {
+        return QByteArray();
+    }
+    return QByteArray(reinterpret_cast<const char*>(view._buffer->getData() + view._offset), (int)view._size);
+}
+
+void GeometryFileCacheTests::roundTrip() {
+    QByteArray obj = makeGridOBJ(16);
+    auto geometry = parseOBJ(obj);
+    QVERIFY(geometry && !geometry->meshes.isEmpty());
+
+    auto cache = makeGeometryFileCache(_testDir.path() + "/roundTrip");
+    auto key = getKey(obj);
+    QVERIFY(!cache->readGeometry(key, TEST_URL));
+    QVERIFY(cache->writeGeometry(key, *geometry));
+    auto cached = cache->readGeometry(key, TEST_URL);
+    QVERIFY(cached);
+
+    QCOMPARE(cached->originalURL, TEST_URL);
+    QCOMPARE(cached->joints.size(), geometry->joints.size());
+    QCOMPARE(cached->joints[0].name, geometry->joints[0].name);
+    QVERIFY(cached->jointIndices == geometry->jointIndices);
+    QVERIFY(cached->meshExtents.minimum == geometry->meshExtents.minimum);
+    QVERIFY(cached->meshExtents.maximum == geometry->meshExtents.maximum);
+
+    QCOMPARE(cached->meshes.size(), geometry->meshes.size());
+    for (int i = 0; i < geometry->meshes.size(); ++i) {
+        const FBXMesh& mesh = geometry->meshes[i];
+        const FBXMesh& cachedMesh = cached->meshes[i];
+        QVERIFY(cachedMesh.vertices == mesh.vertices);
+        QVERIFY(cachedMesh.normals == mesh.normals);
+        QVERIFY(cachedMesh.texCoords == mesh.texCoords);
+        QCOMPARE(cachedMesh.parts.size(), mesh.parts.size());
+        for (int j = 0; j < mesh.parts.size(); ++j) {
+            QVERIFY(cachedMesh.parts[j].quadTrianglesIndices == mesh.parts[j].quadTrianglesIndices);
+            QVERIFY(cachedMesh.parts[j].triangleIndices == mesh.parts[j].triangleIndices);
+            QCOMPARE(cachedMesh.parts[j].materialID, mesh.parts[j].materialID);
+        }
+
+        // the gpu mesh comes back as it was built
+        QVERIFY(mesh._mesh && cachedMesh._mesh);
+        QCOMPARE(getViewBytes(cachedMesh._mesh->getVertexBuffer()), getViewBytes(mesh._mesh->getVertexBuffer()));
+        QCOMPARE(getViewBytes(cachedMesh._mesh->getIndexBuffer()), getViewBytes(mesh._mesh->getIndexBuffer()));
+        QCOMPARE(getViewBytes(cachedMesh._mesh->getPartBuffer()), getViewBytes(mesh._mesh->getPartBuffer()));
+        QCOMPARE(cachedMesh._mesh->getNumAttributes(), mesh._mesh->getNumAttributes());
+        for (int slot = 0; slot < gpu::Stream::NUM_INPUT_SLOTS; ++slot) {
+            auto view = mesh._mesh->getAttributeBuffer(slot);
+            auto cachedView = cachedMesh._mesh->getAttributeBuffer(slot);
+            QCOMPARE(getViewBytes(cachedView), getViewBytes(view));
+            QCOMPARE(cachedView._stride, view._stride);
+            QVERIFY(cachedView._element == view._element);
+        }
+    }
+
+    QVERIFY(cached->materials.keys().toSet() == geometry->materials.keys().toSet());
+    for (const auto& material : geometry->materials) {
+        const auto& cachedMaterial = cached->materials[material.materialID];
+        QCOMPARE(cachedMaterial.name, material.name);
+        QVERIFY(cachedMaterial.diffuseColor == material.diffuseColor);
+        QVERIFY(material._material && cachedMaterial._material);
+        QVERIFY(cachedMaterial._material->getAlbedo(false) == material._material->getAlbedo(false));
+        QCOMPARE(cachedMaterial._material->getRoughness(), material._material->getRoughness());
+        QCOMPARE(cachedMaterial._material->getMetallic(), material._material->getMetallic());
+        QCOMPARE(cachedMaterial._material->getOpacity(), material._material->getOpacity());
+        QCOMPARE(cachedMaterial._material->isUnlit(), material._material->isUnlit());
+    }
+}
+
+void GeometryFileCacheTests::fbxRoundTrip() {
+    QByteArray fbx;
+    auto geometry = readFBXFixture(fbx);
+    QVERIFY(geometry);
+    QVERIFY(!geometry->animationFrames.isEmpty());
+
+    auto cache = makeGeometryFileCache(_testDir.path() + "/fbxRoundTrip");
+    auto key = getKey(fbx);
+    QVERIFY(cache->writeGeometry(key, *geometry));
+    auto cached = cache->readGeometry(key, FBX_TEST_URL);
+    QVERIFY(cached);
+
+    QCOMPARE(cached->joints.size(), geometry->joints.size());
+    for (int i = 0; i < geometry->joints.size(); ++i) {
+        QCOMPARE(cached->joints[i].name, geometry->joints[i].name);
+        QCOMPARE(cached->joints[i].parentIndex, geometry->joints[i].parentIndex);
+        QVERIFY(cached->joints[i].bindTransform == geometry->joints[i].bindTransform);
+        QVERIFY(cached->joints[i].shapeInfo.points == geometry->joints[i].shapeInfo.points);
+    }
+    QVERIFY(cached->jointIndices == geometry->jointIndices);
+
+    QCOMPARE(cached->meshes.size(), geometry->meshes.size());
+    for (int i = 0; i < geometry->meshes.size(); ++i) {
+        const FBXMesh& mesh = geometry->meshes[i];
+        const FBXMesh& cachedMesh = cached->meshes[i];
+        QCOMPARE(cachedMesh.clusters.size(), mesh.clusters.size());
+        for (int j = 0; j < mesh.clusters.size(); ++j) {
+            QCOMPARE(cachedMesh.clusters[j].jointIndex, mesh.clusters[j].jointIndex);
+            QVERIFY(cachedMesh.clusters[j].inverseBindMatrix == mesh.clusters[j].inverseBindMatrix);
+        }
+        QVERIFY(cachedMesh.clusterIndices == mesh.clusterIndices);
+        QVERIFY(cachedMesh.clusterWeights == mesh.clusterWeights);
+        QCOMPARE(cachedMesh.blendshapes.size(), mesh.blendshapes.size());
+        for (int j = 0; j < mesh.blendshapes.size(); ++j) {
+            QVERIFY(cachedMesh.blendshapes[j].indices == mesh.blendshapes[j].indices);
+            QVERIFY(cachedMesh.blendshapes[j].vertices == mesh.blendshapes[j].vertices);
+            QVERIFY(cachedMesh.blendshapes[j].normals == mesh.blendshapes[j].normals);
+        }
+        QVERIFY(cachedMesh._mesh);
+        QCOMPARE(getViewBytes(cachedMesh._mesh->getVertexBuffer()), getViewBytes(mesh._mesh->getVertexBuffer()));
+    }
+    QVERIFY(cached->blendshapeChannelNames == geometry->blendshapeChannelNames);
+
+    QCOMPARE(cached->animationFrames.size(), geometry->animationFrames.size());
+    for (int i = 0; i < geometry->animationFrames.size(); ++i) {
+        QVERIFY(cached->animationFrames[i].rotations == geometry->animationFrames[i].rotations);
+        QVERIFY(cached->animationFrames[i].translations == geometry->animationFrames[i].translations);
+    }
+
+    QVERIFY(cached->materials.keys().toSet() == geometry->materials.keys().toSet());
+    for (const auto& material : geometry->materials) {
+        const FBXTexture& texture = material.albedoTexture;
+        const FBXTexture& cachedTexture = cached->materials[material.materialID].albedoTexture;
+        QCOMPARE(cachedTexture.filename, texture.filename);
+        QCOMPARE(cachedTexture.content, texture.content);
+    }
+    QVERIFY(!cached->materials["401"].albedoTexture.content.isEmpty());
+}
+
+void GeometryFileCacheTests::corruptEntries() {
+    QByteArray obj = makeGridOBJ(4);
+    auto geometry = parseOBJ(obj);
+    QVERIFY(geometry);
+    QByteArray data = FBXSerializer::serialize(*geometry);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data.constData());
+    QVERIFY(FBXSerializer::deserialize(bytes, data.size(), TEST_URL));
+
+    for (int size : { 0, 4, 8, data.size() / 3, data.size() / 2, data.size() - 1 }) {
+        QVERIFY(!FBXSerializer::deserialize(bytes, size, TEST_URL));
+    }
+
+    // a truncated entry reads as a miss
+    auto cache = makeGeometryFileCache(_testDir.path() + "/corruptEntries");
+    auto key = getKey(obj);
+    QVERIFY(cache->writeFile(data.constData(), GeometryFileCache::Metadata(key, data.size() / 2)));
+    QVERIFY(!cache->readGeometry(key, TEST_URL));
+}
+
+void GeometryFileCacheTests::jointIndicesOutOfRange() {
+    QByteArray fbx;
+    auto geometry = readFBXFixture(fbx);
+    QVERIFY(geometry);
+    int numJoints = geometry->joints.size();
+    auto deserialize = [](const FBXGeometry& geometry) {
+        QByteArray data = FBXSerializer::serialize(geometry);
+        return FBXSerializer::deserialize(reinterpret_cast<const uint8_t*>(data.constData()), data.size(), FBX_TEST_URL);
+    };
+    QVERIFY(deserialize(*geometry));
+
+    FBXGeometry badCluster = *geometry;
+    badCluster.meshes[0].clusters[0].jointIndex = numJoints;
+    QVERIFY(!deserialize(badCluster));
+
+    FBXGeometry badParent = *geometry;
+    badParent.joints[0].parentIndex = numJoints;
+    QVERIFY(!deserialize(badParent));
+
+    FBXGeometry badHead = *geometry;
+    badHead.headJointIndex = -2;
+    QVERIFY(!deserialize(badHead));
+
+    FBXGeometry badName = *geometry;
+    badName.jointIndices.insert("Hips", numJoints + 1);
+    QVERIFY(!deserialize(badName));
+
+    // a joint count the rest of the file can't hold is rejected without allocating the joints
+    FBXGeometry unnamed = *geometry;
+    unnamed.author.clear();
+    unnamed.applicationName.clear();
+    QByteArray data = FBXSerializer::serialize(unnamed);
+    // magic, version, then two empty strings of a 64 bit size each
+    const int JOINT_COUNT_OFFSET = 8 + 2 * sizeof(uint64_t);
+    QCOMPARE(*reinterpret_cast<const uint32_t*>(data.constData() + JOINT_COUNT_OFFSET), (uint32_t)numJoints);
+    uint32_t hugeCount = 0x10000000;
+    memcpy(data.data() + JOINT_COUNT_OFFSET, &hugeCount, sizeof(hugeCount));
+    QVERIFY(!FBXSerializer::deserialize(reinterpret_cast<const uint8_t*>(data.constData()), data.size(), FBX_TEST_URL));
+}
+
+void GeometryFileCacheTests::mappingKeys() {
+    const QString contentHash { "0123456789abcdef" };
+
+    // the order the keys went in doesn't matter
+    QVariantHash scaleFirst;
+    scaleFirst.insert("scale", 1.0);
+    scaleFirst.insert("texdir", "textures");
+    QVariantHash texdirFirst;
+    texdirFirst.insert("texdir", "textures");
+    texdirFirst.insert("scale", 1.0);
+    QCOMPARE(GeometryFileCache::getKey(contentHash, scaleFirst), GeometryFileCache::getKey(contentHash, texdirFirst));
+
+    // but every value of a key inserted more than once does, at the top and in the sections
+    QVariantHash leftArm;
+    leftArm.insertMulti("freeJoint", "LeftArm");
+    leftArm.insertMulti("freeJoint", "RightArm");
+    QVariantHash leftForeArm;
+    leftForeArm.insertMulti("freeJoint", "LeftForeArm");
+    leftForeArm.insertMulti("freeJoint", "RightArm");
+    QVERIFY(GeometryFileCache::getKey(contentHash, leftArm) != GeometryFileCache::getKey(contentHash, leftForeArm));
+
+    QVariantHash hipsJoints;
+    hipsJoints.insertMulti("jointRoot", "Hips");
+    hipsJoints.insertMulti("jointRoot", "Spine");
+    QVariantHash pelvisJoints;
+    pelvisJoints.insertMulti("jointRoot", "Pelvis");
+    pelvisJoints.insertMulti("jointRoot", "Spine");
+    QVariantHash hipsMapping;
+    hipsMapping.insert("joint", hipsJoints);
+    QVariantHash pelvisMapping;
+    pelvisMapping.insert("joint", pelvisJoints);
+    QVERIFY(GeometryFileCache::getKey(contentHash, hipsMapping) != GeometryFileCache::getKey(contentHash, pelvisMapping));
+}
+
+void GeometryFileCacheTests::warmAndColdLoads() {
+    const int NUM_LOADS = 10;
+    QByteArray fbx;
+    QVERIFY(readFBXFixture(fbx));
+    auto cache = makeGeometryFileCache(_testDir.path() + "/warmAndColdLoads");
+
+    // A cold load is the first time the content is seen: it is hashed, parsed and written to the cache.
+    // A warm load hashes the content and reads the geometry back from the cache.
+    qint64 coldNSecs = 0;
+    qint64 warmNSecs = 0;
+    QElapsedTimer timer;
+    for (int i = 0; i < NUM_LOADS; ++i) {
+        cache->wipe();
+
+        timer.start();
+        FBXGeometry::Pointer geometry(readFBX(fbx, QVariantHash(), FBX_TEST_URL));
+        QVERIFY(cache->writeGeometry(getKey(fbx), *geometry));
+        coldNSecs += timer.nsecsElapsed();
+
+        timer.start();
+        auto cached = cache->readGeometry(getKey(fbx), FBX_TEST_URL);
+        warmNSecs += timer.nsecsElapsed();
+
+        QVERIFY(cached);
+        QCOMPARE(cached->meshes.size(), geometry->meshes.size());
+        QCOMPARE(cached->meshes[0].vertices.size(), geometry->meshes[0].vertices.size());
+        QCOMPARE(cached->joints.size(), geometry->joints.size());
+    }
+
+    double coldMSecs = (double)coldNSecs / 1.0e6 / NUM_LOADS;
+    double warmMSecs = (double)warmNSecs / 1.0e6 / NUM_LOADS;
+    qDebug().noquote() << QString("%1, %2 bytes: cold load %3 ms, warm load %4 ms")
+        .arg(FBX_TEST_URL).arg(fbx.size()).arg(coldMSecs, 0, 'f', 2).arg(warmMSecs, 0, 'f', 2);
+}
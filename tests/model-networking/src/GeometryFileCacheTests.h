@@ -0,0 +1,31 @@
+//
+//  GeometryFileCacheTests.h
+//  tests/model-networking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_GeometryFileCacheTests_h
+#define hifi_GeometryFileCacheTests_h
+
+#include <QtTest/QtTest>
+#include <QtCore/QTemporaryDir>
+
+class GeometryFileCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    void roundTrip();
+    void fbxRoundTrip();
+    void corruptEntries();
+    void jointIndicesOutOfRange();
+    void mappingKeys();
+    void warmAndColdLoads();
+
+private:
+    QTemporaryDir _testDir;
+};
+
+#endif // hifi_GeometryFileCacheTests_h
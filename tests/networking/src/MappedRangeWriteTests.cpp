@@ -0,0 +1,104 @@
+//
+//  MappedRangeWriteTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MappedRangeWriteTests.h"
+
+#include <QtCore/QTemporaryFile>
+
+#include <ByteRange.h>
+#include <NLPacketList.h>
+
+QTEST_MAIN(MappedRangeWriteTests)
+
+static ByteRange makeRange(int64_t fromInclusive, int64_t toExclusive) {
+    ByteRange range;
+    range.fromInclusive = fromInclusive;
+    range.toExclusive = toExclusive;
+    return range;
+}
+
+void MappedRangeWriteTests::rangeOffsetTest() {
+    const int64_t FILE_SIZE = 1000;
+
+    // unset covers the whole file
+    ByteRange range = makeRange(0, 0);
+    range.fixupRange(FILE_SIZE);
+    QCOMPARE(range.offset(FILE_SIZE), (int64_t)0);
+    QCOMPARE(range.size(), FILE_SIZE);
+
+    // open ended from an offset
+    range = makeRange(100, 0);
+    range.fixupRange(FILE_SIZE);
+    QCOMPARE(range.offset(FILE_SIZE), (int64_t)100);
+    QCOMPARE(range.size(), (int64_t)900);
+
+    // the last bytes of the file
+    range = makeRange(-250, 0);
+    range.fixupRange(FILE_SIZE);
+    QCOMPARE(range.offset(FILE_SIZE), (int64_t)750);
+    QCOMPARE(range.size(), (int64_t)250);
+
+    // a tail longer than the file is the whole file
+    range = makeRange(-2000, 0);
+    range.fixupRange(FILE_SIZE);
+    QCOMPARE(range.offset(FILE_SIZE), (int64_t)0);
+    QCOMPARE(range.size(), FILE_SIZE);
+}
+
+void MappedRangeWriteTests::mappedRangeReplyTest() {
+    // several packets worth of data that doesn't repeat on packet boundaries
+    const int64_t FILE_SIZE = 5 * udt::Packet::maxPayloadSize(true) + 123;
+    QByteArray contents;
+    contents.reserve((int)FILE_SIZE);
+    for (int64_t i = 0; i < FILE_SIZE; ++i) {
+        contents.append((char)((i * 7 + i / 251) & 0xff));
+    }
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE((int64_t)file.write(contents), FILE_SIZE);
+    QVERIFY(file.flush());
+    uchar* mapped = file.map(0, FILE_SIZE);
+    QVERIFY(mapped);
+
+    const int64_t packetSize = udt::Packet::maxPayloadSize(true);
+    std::vector<ByteRange> ranges {
+        makeRange(0, 0),
+        makeRange(1, 2),
+        makeRange(packetSize - 10, 3 * packetSize + 10),
+        makeRange(2 * packetSize, 0),
+        makeRange(-(packetSize + 1), 0)
+    };
+
+    for (auto range : ranges) {
+        range.fixupRange(FILE_SIZE);
+        int64_t offset = range.offset(FILE_SIZE);
+        int64_t size = range.size();
+        QVERIFY(offset >= 0 && offset + size <= FILE_SIZE);
+
+        // the same layout as the asset server's AssetGetReply, with the data written from the mapping
+        auto packetList = NLPacketList::create(PacketType::AssetGetReply, QByteArray(), true, true);
+        packetList->writePrimitive(size);
+        packetList->write(reinterpret_cast<const char*>(mapped) + offset, size);
+        packetList->closeCurrentPacket();
+
+        QByteArray message = packetList->getMessage();
+        QCOMPARE((int64_t)message.size(), (int64_t)sizeof(size) + size);
+        int64_t writtenSize;
+        memcpy(&writtenSize, message.constData(), sizeof(writtenSize));
+        QCOMPARE(writtenSize, size);
+        QCOMPARE(message.mid((int)sizeof(size)), contents.mid((int)offset, (int)size));
+        if (size > packetSize) {
+            QVERIFY(packetList->getNumPackets() > 1);
+        }
+    }
+
+    file.unmap(mapped);
+}
@@ -0,0 +1,26 @@
+//
+//  MappedRangeWriteTests.h
+//  tests/networking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MappedRangeWriteTests_h
+#define hifi_MappedRangeWriteTests_h
+
+#include <QtTest/QtTest>
+
+class MappedRangeWriteTests : public QObject {
+    Q_OBJECT
+private slots:
+    // byte ranges resolve to the same offsets the asset server reads from
+    void rangeOffsetTest();
+
+    // a range written straight from a memory mapped file comes out of the reply packets intact
+    void mappedRangeReplyTest();
+};
+
+#endif // hifi_MappedRangeWriteTests_h
@@ -17,6 +17,17 @@
 
 QTEST_MAIN(ResourceTests)
 
+// a resource whose next request size the test picks
+class SizedResource : public Resource {
+public:
+    SizedResource(const QUrl& url) : Resource(url) {}
+
+    qint64 expectedSize { 0 };
+
+protected:
+    qint64 evalExpectedRequestSize() const override { return expectedSize; }
+};
+
 void ResourceTests::initTestCase() {
 
     auto resourceCacheSharedItems = DependencyManager::set<ResourceCacheSharedItems>();
@@ -82,3 +93,114 @@ void ResourceTests::downloadAgain() {
 
     QVERIFY(resource->isLoaded());
 }
+
+void ResourceTests::pendingRequestOrder() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    auto createResource = [](const QString& url) {
+        auto pending = QSharedPointer<Resource>::create(QUrl(url));
+        pending->setSelf(pending);
+        return pending;
+    };
+
+    QObject owner;
+    auto nearModel = createResource("http://example.com/near.fbx");
+    auto farModel = createResource("atp:/far.fbx");
+    auto sound = createResource("http://example.com/sound.wav");
+    float distanceToNearModel = 1.0f;
+    nearModel->setLoadPriorityOperator(&owner, [&] { return 1.0f / distanceToNearModel; });
+    farModel->setLoadPriority(&owner, 0.5f);
+    sound->setLoadPriority(&owner, -7.0f);
+
+    // one more than what the download tests may have left running
+    ResourceRequestLimits limits;
+    for (size_t i = 0; i < limits.size(); i++) {
+        limits[i] = sharedItems->getLoadingRequestsCount((ResourceRequestBackend)i) + 1;
+    }
+
+    // the priority of the near model is evaluated when it is set and on every update of the pending requests
+    sharedItems->appendPendingRequest(nearModel, ResourceRequestBackend::HTTP);
+    sharedItems->appendPendingRequest(farModel, ResourceRequestBackend::ATP);
+    QCOMPARE(sharedItems->getHighestPendingRequest(limits), nearModel);
+    sharedItems->appendPendingRequest(nearModel, ResourceRequestBackend::HTTP);
+    distanceToNearModel = 4.0f;
+    QCOMPARE(nearModel->getLoadPriority(), 1.0f);
+    sharedItems->updatePendingRequestPriorities();
+    QCOMPARE(nearModel->getLoadPriority(), 0.25f);
+    QCOMPARE(sharedItems->getHighestPendingRequest(limits), farModel);
+    QCOMPARE(sharedItems->getHighestPendingRequest(limits), nearModel);
+
+    // a full backend holds its requests back without blocking the others
+    sharedItems->appendActiveRequest(nearModel, ResourceRequestBackend::HTTP);
+    sharedItems->appendPendingRequest(sound, ResourceRequestBackend::HTTP);
+    sharedItems->appendPendingRequest(farModel, ResourceRequestBackend::ATP);
+    QCOMPARE(sharedItems->getHighestPendingRequest(limits), farModel);
+    QVERIFY(sharedItems->getHighestPendingRequest(limits).isNull());
+    sharedItems->removeRequest(nearModel);
+    QCOMPARE(sharedItems->getHighestPendingRequest(limits), sound);
+
+    // the bigger download goes second between equals
+    QCOMPARE(ResourceCacheSharedItems::evalRequestScore(1.0f, 0), 1.0f);
+    QVERIFY(ResourceCacheSharedItems::evalRequestScore(1.0f, 1024) > ResourceCacheSharedItems::evalRequestScore(1.0f, 1024 * 1024));
+
+    // the expected sizes are estimated along with the priorities, never by the threads picking the requests
+    auto smallTexture = QSharedPointer<SizedResource>::create(QUrl("http://example.com/small.ktx"));
+    auto bigTexture = QSharedPointer<SizedResource>::create(QUrl("http://example.com/big.ktx"));
+    QSharedPointer<Resource> smallResource = smallTexture;
+    QSharedPointer<Resource> bigResource = bigTexture;
+    smallResource->setSelf(smallResource);
+    bigResource->setSelf(bigResource);
+    smallResource->setLoadPriority(&owner, 1.0f);
+    bigResource->setLoadPriority(&owner, 1.0f);
+    smallTexture->expectedSize = 1024;
+    bigTexture->expectedSize = 1024 * 1024;
+    QCOMPARE(bigResource->getExpectedRequestSize(), (qint64)0);
+    sharedItems->appendPendingRequest(smallResource, ResourceRequestBackend::HTTP);
+    sharedItems->appendPendingRequest(bigResource, ResourceRequestBackend::HTTP);
+    sharedItems->updatePendingRequestPriorities();
+    QCOMPARE(bigResource->getExpectedRequestSize(), (qint64)(1024 * 1024));
+    QCOMPARE(sharedItems->getHighestPendingRequest(limits), smallResource);
+    QCOMPARE(sharedItems->getHighestPendingRequest(limits), bigResource);
+}
+
+void ResourceTests::unusedResourceLRU() {
+    const int NUM_RESOURCES = 100;
+    ResourceLRU lru;
+    QList<QSharedPointer<Resource>> resources;
+    for (int i = 0; i < NUM_RESOURCES; i++) {
+        auto unused = QSharedPointer<Resource>::create(QUrl(QString("http://example.com/%1.fbx").arg(i)));
+        unused->setSelf(unused);
+        resources.append(unused);
+        lru.push(unused);
+    }
+    QCOMPARE(lru.getCount(), (size_t)NUM_RESOURCES);
+
+    // the list holds the resources
+    QWeakPointer<Resource> weakFirst = resources[0];
+    resources[0].clear();
+    QVERIFY(!weakFirst.isNull());
+
+    // reusing a resource makes it the most recently used when it is released again
+    QCOMPARE(lru.remove(resources[1].data()), resources[1]);
+    QVERIFY(lru.remove(resources[1].data()).isNull());
+    lru.push(resources[1]);
+
+    QCOMPARE(lru.popOldest().data(), weakFirst.data());
+    QVERIFY(weakFirst.isNull());
+    for (int i = 2; i < NUM_RESOURCES; i++) {
+        QCOMPARE(lru.popOldest(), resources[i]);
+    }
+    QCOMPARE(lru.popOldest(), resources[1]);
+    QVERIFY(lru.popOldest().isNull());
+    QCOMPARE(lru.getCount(), (size_t)0);
+    QCOMPARE(lru.getBytes(), (qint64)0);
+
+    for (int i = 1; i < NUM_RESOURCES; i++) {
+        lru.push(resources[i]);
+    }
+    auto removed = lru.removeIf([](const Resource& resource) {
+        return resource.getURL().fileName().startsWith("1");
+    });
+    QCOMPARE(removed.size(), 11);
+    QCOMPARE(lru.getCount(), (size_t)(NUM_RESOURCES - 1 - 11));
+    QCOMPARE(lru.removeIf().size(), NUM_RESOURCES - 1 - 11);
+}
@@ -18,6 +18,8 @@ private slots:
     void initTestCase();
     void downloadFirst();
     void downloadAgain();
+    void pendingRequestOrder();
+    void unusedResourceLRU();
 };
 
 #endif // hifi_ResourceTests_h
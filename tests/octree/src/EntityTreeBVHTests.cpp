@@ -0,0 +1,170 @@
+//
+//  EntityTreeBVHTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeBVHTests.h"
+
+#include <random>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <AddressManager.h>
+#include <EntityTree.h>
+#include <GLMHelpers.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <ViewFrustum.h>
+
+QTEST_MAIN(EntityTreeBVHTests)
+
+const int NUM_ENTITIES = 500;
+const int NUM_QUERIES = 50;
+const float SCENE_HALF_SIZE = 50.0f;
+
+// the results of a fixed set of queries, with entities sorted by ID so both paths compare equal
+class QueryResults {
+public:
+    std::vector<std::vector<QUuid>> spheres;
+    std::vector<std::vector<QUuid>> cubes;
+    std::vector<std::vector<QUuid>> boxes;
+    std::vector<std::vector<QUuid>> frustums;
+    std::vector<QUuid> closest;
+    std::vector<QUuid> rayHits;
+    std::vector<float> rayDistances;
+};
+
+static std::vector<QUuid> sortedIDs(const QVector<EntityItemPointer>& entities) {
+    std::vector<QUuid> ids;
+    for (auto& entity : entities) {
+        ids.push_back(entity->getID());
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+static QueryResults runQueries(const EntityTreePointer& tree) {
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> position(-SCENE_HALF_SIZE, SCENE_HALF_SIZE);
+    std::uniform_real_distribution<float> size(1.0f, 20.0f);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    QueryResults results;
+    for (int i = 0; i < NUM_QUERIES; ++i) {
+        glm::vec3 center(position(generator), position(generator), position(generator));
+        float radius = size(generator);
+        glm::vec3 direction(unit(generator), unit(generator), unit(generator));
+        if (glm::length(direction) < EPSILON) {
+            direction = Vectors::UNIT_X;
+        }
+        direction = glm::normalize(direction);
+
+        ViewFrustum frustum;
+        frustum.setProjection(glm::perspective(PI / 3.0f, 1.5f, 0.1f, 2.0f * radius));
+        frustum.setPosition(center);
+        frustum.setOrientation(rotationBetween(Vectors::FRONT, direction));
+        frustum.setCenterRadius(1.0f);
+        frustum.calculate();
+
+        tree->withReadLock([&] {
+            QVector<EntityItemPointer> found;
+            tree->findEntities(center, radius, found);
+            results.spheres.push_back(sortedIDs(found));
+
+            found.clear();
+            tree->findEntities(AACube(center - glm::vec3(radius), 2.0f * radius), found);
+            results.cubes.push_back(sortedIDs(found));
+
+            found.clear();
+            tree->findEntities(AABox(center, glm::vec3(radius, 0.5f * radius, 2.0f * radius)), found);
+            results.boxes.push_back(sortedIDs(found));
+
+            found.clear();
+            tree->findEntities(frustum, found);
+            results.frustums.push_back(sortedIDs(found));
+        });
+
+        EntityItemPointer closest = tree->findClosestEntity(center, radius);
+        results.closest.push_back(closest ? closest->getID() : QUuid());
+
+        OctreeElementPointer element;
+        float distance = FLT_MAX;
+        BoxFace face;
+        glm::vec3 surfaceNormal;
+        QVariantMap extraInfo;
+        EntityItemID hit = tree->findRayIntersection(center, direction, QVector<EntityItemID>(), QVector<EntityItemID>(),
+            false, false, false, element, distance, face, surfaceNormal, extraInfo, Octree::Lock);
+        results.rayHits.push_back(hit);
+        results.rayDistances.push_back(hit.isNull() ? 0.0f : distance);
+    }
+    return results;
+}
+
+static void compareResults(const QueryResults& octree, const QueryResults& bvh) {
+    QCOMPARE(bvh.spheres, octree.spheres);
+    QCOMPARE(bvh.cubes, octree.cubes);
+    QCOMPARE(bvh.boxes, octree.boxes);
+    QCOMPARE(bvh.frustums, octree.frustums);
+    QCOMPARE(bvh.closest, octree.closest);
+    QCOMPARE(bvh.rayHits, octree.rayHits);
+    for (size_t i = 0; i < octree.rayDistances.size(); ++i) {
+        QVERIFY(fabsf(bvh.rayDistances[i] - octree.rayDistances[i]) < 1.0e-4f);
+    }
+}
+
+void EntityTreeBVHTests::initTestCase() {
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::Agent);
+}
+
+void EntityTreeBVHTests::testQueriesMatchOctree() {
+    auto tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(true);
+
+    std::mt19937 generator(5678);
+    std::uniform_real_distribution<float> position(-SCENE_HALF_SIZE, SCENE_HALF_SIZE);
+    std::uniform_real_distribution<float> dimension(0.1f, 3.0f);
+
+    std::vector<EntityItemID> ids;
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        EntityItemProperties properties;
+        properties.setType(EntityTypes::Box);
+        properties.setPosition(glm::vec3(position(generator), position(generator), position(generator)));
+        properties.setDimensions(glm::vec3(dimension(generator), dimension(generator), dimension(generator)));
+        EntityItemID id(QUuid::createUuid());
+        QVERIFY(tree->addEntity(id, properties));
+        ids.push_back(id);
+    }
+
+    // a freshly built BVH
+    QueryResults octreeResults = runQueries(tree);
+    tree->setUseBVH(true);
+    compareResults(octreeResults, runQueries(tree));
+
+    // entities that move, are added and are deleted while the BVH is live
+    for (int i = 0; i < NUM_ENTITIES / 4; ++i) {
+        EntityItemProperties properties;
+        properties.setPosition(glm::vec3(position(generator), position(generator), position(generator)));
+        QVERIFY(tree->updateEntity(ids[i], properties));
+    }
+    for (int i = 0; i < NUM_ENTITIES / 10; ++i) {
+        EntityItemProperties properties;
+        properties.setType(EntityTypes::Box);
+        properties.setPosition(glm::vec3(position(generator), position(generator), position(generator)));
+        properties.setDimensions(glm::vec3(dimension(generator)));
+        QVERIFY(tree->addEntity(EntityItemID(QUuid::createUuid()), properties));
+    }
+    for (int i = NUM_ENTITIES - NUM_ENTITIES / 10; i < NUM_ENTITIES; ++i) {
+        tree->deleteEntity(ids[i], true, true);
+    }
+
+    QueryResults bvhResults = runQueries(tree);
+    tree->setUseBVH(false);
+    compareResults(runQueries(tree), bvhResults);
+}
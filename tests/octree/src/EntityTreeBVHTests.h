@@ -0,0 +1,24 @@
+//
+//  EntityTreeBVHTests.h
+//  tests/octree/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeBVHTests_h
+#define hifi_EntityTreeBVHTests_h
+
+#include <QtTest/QtTest>
+
+class EntityTreeBVHTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testQueriesMatchOctree();
+};
+
+#endif // hifi_EntityTreeBVHTests_h
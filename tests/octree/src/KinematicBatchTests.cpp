@@ -0,0 +1,157 @@
+//
+//  KinematicBatchTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "KinematicBatchTests.h"
+
+#include <AddressManager.h>
+#include <EntityTree.h>
+#include <KinematicBatch.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SimulationFlags.h>
+
+#include "../QTestExtensions.h"
+#include "../GLMTestUtils.h"
+
+QTEST_MAIN(KinematicBatchTests)
+
+const quint64 STEP_USECS = USECS_PER_SECOND / 60;
+const int NUM_STEPS = 30;
+const float EPSILON_TOLERANCE = 1.0e-5f;
+
+void KinematicBatchTests::initTestCase() {
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::Agent);
+}
+
+void KinematicBatchTests::testBatchMatchesScalarStep() {
+    auto tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(true);
+
+    std::vector<EntityItemProperties> cases;
+    {
+        // linear damping
+        EntityItemProperties properties;
+        properties.setVelocity(glm::vec3(1.0f, 0.5f, -2.0f));
+        properties.setDamping(0.3f);
+        cases.push_back(properties);
+    }
+    {
+        // gravity without damping
+        EntityItemProperties properties;
+        properties.setVelocity(glm::vec3(0.0f, 3.0f, 1.0f));
+        properties.setAcceleration(glm::vec3(0.0f, -9.8f, 0.0f));
+        properties.setGravity(glm::vec3(0.0f, -9.8f, 0.0f));
+        properties.setDamping(0.0f);
+        cases.push_back(properties);
+    }
+    {
+        // acceleration and damping together
+        EntityItemProperties properties;
+        properties.setVelocity(glm::vec3(-0.5f, 0.0f, 0.25f));
+        properties.setAcceleration(glm::vec3(0.5f, 0.1f, -0.3f));
+        properties.setDamping(0.1f);
+        cases.push_back(properties);
+    }
+    {
+        // too slow to keep moving
+        EntityItemProperties properties;
+        properties.setVelocity(glm::vec3(0.0005f, 0.0f, 0.0f));
+        properties.setDamping(0.0f);
+        cases.push_back(properties);
+    }
+    {
+        // slow with an acceleration too small to get it going
+        EntityItemProperties properties;
+        properties.setVelocity(glm::vec3(0.0f, 0.0005f, 0.0f));
+        properties.setAcceleration(glm::vec3(0.0f, 0.02f, 0.0f));
+        properties.setDamping(0.0f);
+        cases.push_back(properties);
+    }
+    {
+        // spinning with angular damping while translating
+        EntityItemProperties properties;
+        properties.setVelocity(glm::vec3(0.2f, 0.0f, 0.0f));
+        properties.setAngularVelocity(glm::vec3(0.0f, 2.0f, 0.5f));
+        properties.setAngularDamping(0.2f);
+        properties.setDamping(0.0f);
+        cases.push_back(properties);
+    }
+    {
+        // spin that damps below the threshold
+        EntityItemProperties properties;
+        properties.setAngularVelocity(glm::vec3(0.01f, 0.0f, 0.0f));
+        properties.setAngularDamping(0.9f);
+        cases.push_back(properties);
+    }
+
+    // each case gets one entity stepped by EntityItem::stepKinematicMotion() and one stepped by the batch
+    std::vector<EntityItemPointer> scalarEntities;
+    std::vector<EntityItemPointer> batchEntities;
+    tree->withWriteLock([&] {
+        for (size_t i = 0; i < cases.size(); ++i) {
+            EntityItemProperties properties = cases[i];
+            properties.setType(EntityTypes::Box);
+            properties.setPosition(glm::vec3((float)i, 1.0f, 2.0f));
+            properties.setDimensions(glm::vec3(0.1f));
+            scalarEntities.push_back(tree->addEntity(EntityItemID(QUuid::createUuid()), properties));
+            batchEntities.push_back(tree->addEntity(EntityItemID(QUuid::createUuid()), properties));
+        }
+    });
+    for (size_t i = 0; i < cases.size(); ++i) {
+        QVERIFY(scalarEntities[i]);
+        QVERIFY(batchEntities[i]);
+    }
+
+    quint64 now = usecTimestampNow();
+    for (auto& entity : batchEntities) {
+        entity->setLastSimulated(now);
+    }
+
+    KinematicBatch batch;
+    for (int step = 0; step < NUM_STEPS; ++step) {
+        now += STEP_USECS;
+        float timeElapsed = (float)STEP_USECS / (float)USECS_PER_SECOND;
+
+        int numMoving = 0;
+        for (size_t i = 0; i < cases.size(); ++i) {
+            if (scalarEntities[i]->stepKinematicMotion(timeElapsed)) {
+                ++numMoving;
+            } else {
+                QVERIFY(scalarEntities[i]->getVelocity() == Vectors::ZERO);
+                QVERIFY(scalarEntities[i]->getAngularVelocity() == Vectors::ZERO);
+            }
+            batchEntities[i]->clearDirtyFlags();
+            batch.add(batchEntities[i], now);
+            if (batchEntities[i]->getDirtyFlags() & Simulation::DIRTY_MOTION_TYPE) {
+                // the batch leaves stopped entities out, as the scalar step reports them not moving
+                QVERIFY(batchEntities[i]->getVelocity() == Vectors::ZERO);
+                QVERIFY(batchEntities[i]->getAngularVelocity() == Vectors::ZERO);
+            }
+        }
+        QCOMPARE(batch.size(), numMoving);
+        batch.integrate();
+        batch.apply(now);
+        batch.clear();
+
+        for (size_t i = 0; i < cases.size(); ++i) {
+            QCOMPARE_WITH_ABS_ERROR(batchEntities[i]->getLocalPosition(), scalarEntities[i]->getLocalPosition(),
+                EPSILON_TOLERANCE);
+            QCOMPARE_WITH_ABS_ERROR(batchEntities[i]->getLocalVelocity(), scalarEntities[i]->getLocalVelocity(),
+                EPSILON_TOLERANCE);
+            QCOMPARE_WITH_ABS_ERROR(batchEntities[i]->getLocalAngularVelocity(),
+                scalarEntities[i]->getLocalAngularVelocity(), EPSILON_TOLERANCE);
+            QCOMPARE_QUATS(batchEntities[i]->getLocalOrientation(), scalarEntities[i]->getLocalOrientation(),
+                EPSILON_TOLERANCE);
+            QCOMPARE(batchEntities[i]->getLastSimulated(), now);
+        }
+    }
+}
@@ -0,0 +1,24 @@
+//
+//  KinematicBatchTests.h
+//  tests/octree/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_KinematicBatchTests_h
+#define hifi_KinematicBatchTests_h
+
+#include <QtTest/QtTest>
+
+class KinematicBatchTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testBatchMatchesScalarStep();
+};
+
+#endif // hifi_KinematicBatchTests_h
@@ -0,0 +1,165 @@
+//
+//  OctreeEditSchedulerTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeEditSchedulerTests.h"
+
+#include <set>
+
+#include <NumericalConstants.h>
+#include <OctreeEditScheduler.h>
+
+QTEST_GUILESS_MAIN(OctreeEditSchedulerTests)
+
+const quint64 NOW = 10 * USECS_PER_SECOND;
+
+// an edit that sets the properties in mask
+class TestEditRecord : public OctreeEditRecord {
+public:
+    virtual bool isSupersededBy(const OctreeEditRecord& other) const override {
+        uint32_t otherMask = static_cast<const TestEditRecord&>(other).mask;
+        return (mask & otherMask) == mask;
+    }
+
+    uint32_t mask { 0 };
+};
+
+static OctreeEditScheduler::Edit makeEdit(const QUuid& senderID, const QUuid& targetID, uint32_t mask) {
+    auto record = std::make_shared<TestEditRecord>();
+    record->targetID = targetID;
+    record->mask = mask;
+    OctreeEditScheduler::Edit edit;
+    edit.senderID = senderID;
+    edit.record = record;
+    return edit;
+}
+
+static OctreeEditScheduler::Edit makeErase(const QUuid& senderID) {
+    OctreeEditScheduler::Edit edit;
+    edit.senderID = senderID;
+    return edit;
+}
+
+static std::vector<size_t> applyOrder(const OctreeEditScheduler::Plan& plan, const std::set<size_t>& altered) {
+    std::vector<size_t> order;
+    for (size_t index : plan.editsToApply) {
+        OctreeEditScheduler::applyMerged(plan, index, [&](size_t applyIndex) {
+            order.push_back(applyIndex);
+            return altered.count(applyIndex) == 0;
+        });
+    }
+    return order;
+}
+
+void OctreeEditSchedulerTests::mergeOrder() {
+    QUuid sender = QUuid::createUuid();
+    QUuid target = QUuid::createUuid();
+    std::vector<OctreeEditScheduler::Edit> edits {
+        makeEdit(sender, target, 0x1),
+        makeEdit(sender, target, 0x3),
+        makeEdit(sender, target, 0x3)
+    };
+
+    OctreeEditScheduler scheduler;
+    OctreeEditScheduler::Plan plan = scheduler.schedule(edits, QUuid(), NOW);
+    QCOMPARE(plan.editsToApply, std::vector<size_t>({ 2 }));
+    QCOMPARE(plan.editsMerged, 2);
+    QVERIFY(plan.deferredEdits.empty());
+
+    // the newest edit stands in for the others when the tree takes it as sent
+    QCOMPARE(applyOrder(plan, {}), std::vector<size_t>({ 2 }));
+
+    // otherwise the merged edits go in the order they were sent and the newest goes again last
+    QCOMPARE(applyOrder(plan, { 2 }), std::vector<size_t>({ 2, 0, 1, 2 }));
+}
+
+void OctreeEditSchedulerTests::mergeAcrossSendersAndErases() {
+    QUuid sender = QUuid::createUuid();
+    QUuid otherSender = QUuid::createUuid();
+    QUuid target = QUuid::createUuid();
+    std::vector<OctreeEditScheduler::Edit> edits {
+        makeEdit(sender, target, 0x1),
+        makeEdit(otherSender, target, 0x1),
+        makeEdit(sender, target, 0x1),
+        makeErase(sender),
+        makeEdit(sender, target, 0x1),
+        makeEdit(sender, target, 0x2)
+    };
+
+    // edits from another sender, across an erase or that don't overwrite everything are all applied
+    OctreeEditScheduler scheduler;
+    OctreeEditScheduler::Plan plan = scheduler.schedule(edits, QUuid(), NOW);
+    QCOMPARE(plan.editsToApply, std::vector<size_t>({ 0, 1, 2, 3, 4, 5 }));
+    QCOMPARE(plan.editsMerged, 0);
+}
+
+void OctreeEditSchedulerTests::rateLimitOrder() {
+    QUuid sender = QUuid::createUuid();
+    QUuid otherSender = QUuid::createUuid();
+    QUuid target = QUuid::createUuid();
+    QUuid otherTarget = QUuid::createUuid();
+    std::vector<OctreeEditScheduler::Edit> edits {
+        makeEdit(sender, target, 0x1),
+        makeEdit(sender, target, 0x2),
+        makeEdit(sender, otherTarget, 0x1),
+        makeEdit(sender, target, 0x4),
+        makeEdit(otherSender, target, 0x8),
+        makeErase(sender),
+        makeEdit(otherSender, target, 0x10)
+    };
+
+    OctreeEditScheduler scheduler;
+    scheduler.setMaxEditsPerSecond(1, 0);
+    OctreeEditScheduler::Plan plan = scheduler.schedule(edits, QUuid(), NOW);
+
+    // the second edit to target is held back and the third waits behind it, until the erase from the same sender
+    // takes them ahead of itself. The other sender's edits to target are over the cap and go to the next batch.
+    QCOMPARE(plan.editsToApply, std::vector<size_t>({ 0, 2, 1, 3, 5 }));
+    QCOMPARE(plan.deferredEdits, std::vector<size_t>({ 4, 6 }));
+    QCOMPARE(plan.editsRateLimited, 4);
+
+    // a flushed sender skips the caps for the whole pass
+    OctreeEditScheduler flushScheduler;
+    flushScheduler.setMaxEditsPerSecond(1, 0);
+    plan = flushScheduler.schedule(edits, otherSender, NOW);
+    QCOMPARE(plan.editsToApply, std::vector<size_t>({ 0, 2, 4, 1, 3, 5, 6 }));
+    QVERIFY(plan.deferredEdits.empty());
+}
+
+void OctreeEditSchedulerTests::deferredEditsKeepMergedChain() {
+    QUuid sender = QUuid::createUuid();
+    QUuid target = QUuid::createUuid();
+    std::vector<OctreeEditScheduler::Edit> edits {
+        makeEdit(sender, target, 0x1),
+        makeEdit(sender, target, 0x2),
+        makeEdit(sender, target, 0x6),
+        makeEdit(sender, target, 0x6)
+    };
+
+    OctreeEditScheduler scheduler;
+    scheduler.setMaxEditsPerSecond(1, 0);
+    OctreeEditScheduler::Plan plan = scheduler.schedule(edits, QUuid(), NOW);
+    QCOMPARE(plan.editsToApply, std::vector<size_t>({ 0 }));
+    QCOMPARE(plan.editsMerged, 2);
+    QCOMPARE(plan.editsRateLimited, 1);
+
+    // the held back edit takes the edits merged into it along, oldest first
+    QCOMPARE(plan.deferredEdits, std::vector<size_t>({ 1, 2, 3 }));
+
+    // on the next pass they merge again, without being counted twice
+    std::vector<OctreeEditScheduler::Edit> deferred;
+    for (size_t index : plan.deferredEdits) {
+        deferred.push_back(edits[index]);
+        deferred.back().counted = true;
+    }
+    plan = scheduler.schedule(deferred, QUuid(), NOW + USECS_PER_SECOND);
+    QCOMPARE(plan.editsToApply, std::vector<size_t>({ 2 }));
+    QCOMPARE(plan.editsMerged, 0);
+    QCOMPARE(applyOrder(plan, { 2 }), std::vector<size_t>({ 2, 0, 1, 2 }));
+}
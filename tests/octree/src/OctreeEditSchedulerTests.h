@@ -0,0 +1,26 @@
+//
+//  OctreeEditSchedulerTests.h
+//  tests/octree/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeEditSchedulerTests_h
+#define hifi_OctreeEditSchedulerTests_h
+
+#include <QtTest/QtTest>
+
+class OctreeEditSchedulerTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void mergeOrder();
+    void mergeAcrossSendersAndErases();
+    void rateLimitOrder();
+    void deferredEditsKeepMergedChain();
+};
+
+#endif // hifi_OctreeEditSchedulerTests_h
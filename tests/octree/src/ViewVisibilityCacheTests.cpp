@@ -0,0 +1,73 @@
+//
+//  ViewVisibilityCacheTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ViewVisibilityCacheTests.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <DiffTraversal.h>
+#include <NumericalConstants.h>
+#include <ViewVisibilityCache.h>
+
+QTEST_MAIN(ViewVisibilityCacheTests)
+
+static DiffTraversal::View makeView(const ViewVisibilityCachePointer& cache, const glm::vec3& position, float lodScaleFactor) {
+    DiffTraversal::View view;
+    view.viewFrustum.setProjection(glm::perspective(PI / 2.0f, 1.0f, 0.1f, 100.0f));
+    view.viewFrustum.setPosition(position);
+    view.viewFrustum.setOrientation(glm::quat());
+    view.viewFrustum.setCenterRadius(1.0f);
+    view.viewFrustum.calculate();
+    view.lodScaleFactor = lodScaleFactor;
+    view.visibilityCache = cache;
+    view.visibility = cache->getEntry(cache->computeKey(view.viewFrustum, lodScaleFactor));
+    view.visibilityTolerance = cache->computeTolerance(view.viewFrustum);
+    return view;
+}
+
+void ViewVisibilityCacheTests::testTwoViewsInOneBucket() {
+    auto cache = std::make_shared<ViewVisibilityCache>();
+    const float LOD_SCALE_FACTOR = 0.25f;
+
+    // both positions are in the same 0.25 m bucket, B is 0.23 m to the right of A
+    DiffTraversal::View viewA = makeView(cache, glm::vec3(0.01f), LOD_SCALE_FACTOR);
+    DiffTraversal::View viewB = makeView(cache, glm::vec3(0.24f, 0.01f, 0.01f), LOD_SCALE_FACTOR);
+    QVERIFY(viewA.visibility == viewB.visibility);
+
+    // a cube just past the right edge of A that B sees
+    AACube edgeCube(glm::vec3(10.08f, 0.0f, -10.05f), 0.05f);
+    QCOMPARE((int)viewA.computeExactVisibility(edgeCube), (int)ViewFrustum::OUTSIDE);
+    QVERIFY(viewB.computeExactVisibility(edgeCube) != ViewFrustum::OUTSIDE);
+
+    // classified by A first, B must still get its own answer
+    QCOMPARE((int)viewA.computeElementVisibility(edgeCube), (int)ViewFrustum::OUTSIDE);
+    QCOMPARE((int)viewB.computeElementVisibility(edgeCube), (int)viewB.computeExactVisibility(edgeCube));
+
+    // shared answers agree with the exact ones for cubes all around both views
+    const int NUM_CUBES_PER_AXIS = 24;
+    const float CUBE_SCALE = 0.5f;
+    int numShared = 0;
+    for (int i = 0; i < NUM_CUBES_PER_AXIS; ++i) {
+        for (int j = 0; j < NUM_CUBES_PER_AXIS; ++j) {
+            for (int k = 0; k < NUM_CUBES_PER_AXIS; ++k) {
+                glm::vec3 corner = glm::vec3(i, j, k) * (2.0f * CUBE_SCALE) - glm::vec3(12.0f, 12.0f, 20.0f);
+                AACube cube(corner, CUBE_SCALE);
+                viewA.computeElementVisibility(cube);
+                if (viewA.computeSharedVisibility(cube) != ViewFrustum::INTERSECT) {
+                    ++numShared;
+                }
+                QCOMPARE((int)viewB.computeElementVisibility(cube), (int)viewB.computeExactVisibility(cube));
+            }
+        }
+    }
+
+    // and most of them could be shared
+    QVERIFY(numShared > NUM_CUBES_PER_AXIS * NUM_CUBES_PER_AXIS * NUM_CUBES_PER_AXIS / 2);
+}
@@ -0,0 +1,23 @@
+//
+//  ViewVisibilityCacheTests.h
+//  tests/octree/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ViewVisibilityCacheTests_h
+#define hifi_ViewVisibilityCacheTests_h
+
+#include <QtTest/QtTest>
+
+class ViewVisibilityCacheTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testTwoViewsInOneBucket();
+};
+
+#endif // hifi_ViewVisibilityCacheTests_h
@@ -2,6 +2,8 @@
 #include <QtTest/QtTest>
 #include <QtCore/QTemporaryFile>
 #include <QtCore/QString>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
 
 #ifdef Q_OS_WIN32
 #include <Windows.h>
@@ -99,10 +101,122 @@ void testClipOrdering() {
     Q_UNUSED(lastFrameTimeOffset); // FIXME - Unix build not yet upgraded to Qt 5.5.1 we can remove this once it is
 }
 
+void testChunkedSeek() {
+    // Ten seconds at 90 Hz spans several keyframe intervals
+    auto writeClip = Clip::newClip();
+    for (int i = 0; i < 900; ++i) {
+        QByteArray data(100 + (i % 7) * 50, (char)i);
+        // Frame times are in milliseconds
+        writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, (float)(i * 1000 / 90), data));
+    }
+
+    QTemporaryFile file;
+    QString fileName;
+    if (file.open()) {
+        fileName = file.fileName();
+        file.close();
+    }
+    Clip::toFile(fileName, writeClip);
+    auto readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() == writeClip->frameCount());
+    QVERIFY(readClip->duration() == writeClip->duration());
+
+    // Seek to frame times, times between frames and past the end, in and out of order
+    for (float seconds : { 0.0f, 5.5f, 1.0f, 9.99f, 3.3333f, 2.0f, 20.0f, 0.01f }) {
+        readClip->seek(seconds);
+        writeClip->seek(seconds);
+        QVERIFY(readClip->positionFrameTime() == writeClip->positionFrameTime());
+        for (int i = 0; i < 100; ++i) {
+            auto readFrame = readClip->nextFrame();
+            auto writeFrame = writeClip->nextFrame();
+            QVERIFY((bool)readFrame == (bool)writeFrame);
+            if (!readFrame) {
+                break;
+            }
+            QVERIFY(readFrame->type == writeFrame->type);
+            QVERIFY(readFrame->timeOffset == writeFrame->timeOffset);
+            QVERIFY(readFrame->data == writeFrame->data);
+        }
+    }
+
+    // Uncompressed chunks read back the same
+    QFile uncompressedFile(fileName);
+    if (uncompressedFile.open(QFile::Truncate | QFile::WriteOnly)) {
+        writeClip->write(uncompressedFile, false);
+        uncompressedFile.close();
+    }
+    readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() == writeClip->frameCount());
+    readClip->seek(7.0f);
+    writeClip->seek(7.0f);
+    QVERIFY(readClip->nextFrame()->data == writeClip->nextFrame()->data);
+}
+
+// Version 1 clips, written before the chunked layout, are a header frame without a version followed by
+// individually compressed frames with 16 bit sizes
+void appendVersion1Frame(QByteArray& clipData, FrameType type, Frame::Time timeOffset, const QByteArray& data) {
+    FrameSize dataSize = data.size();
+    clipData.append((const char*)&type, sizeof(FrameType));
+    clipData.append((const char*)&timeOffset, sizeof(Frame::Time));
+    clipData.append((const char*)&dataSize, sizeof(FrameSize));
+    clipData.append(data);
+}
+
+void testVersion1Clip() {
+    QJsonObject frameTypeObj;
+    frameTypeObj[TEST_NAME] = TEST_FRAME_TYPE;
+    QJsonObject rootObject;
+    rootObject.insert(Clip::FRAME_TYPE_MAP, frameTypeObj);
+    rootObject.insert(Clip::FRAME_COMREPSSION_FLAG, true);
+    QByteArray clipData;
+    appendVersion1Frame(clipData, Frame::TYPE_HEADER, 0, QJsonDocument(rootObject).toBinaryData());
+
+    auto expectedClip = Clip::newClip();
+    for (int i = 0; i < 300; ++i) {
+        QByteArray data(100 + (i % 7) * 50, (char)i);
+        Frame::Time timeOffset = i * 1000 / 90;
+        appendVersion1Frame(clipData, TEST_FRAME_TYPE, timeOffset, qCompress(data));
+        expectedClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, (float)timeOffset, data));
+    }
+
+    QTemporaryFile file;
+    QString fileName;
+    if (file.open()) {
+        fileName = file.fileName();
+        file.write(clipData);
+        file.close();
+    }
+    auto readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() == expectedClip->frameCount());
+    QVERIFY(readClip->duration() == expectedClip->duration());
+
+    for (float seconds : { 0.0f, 2.5f, 1.0f, 3.0f }) {
+        readClip->seek(seconds);
+        expectedClip->seek(seconds);
+        QVERIFY(readClip->positionFrameTime() == expectedClip->positionFrameTime());
+        for (int i = 0; i < 50; ++i) {
+            auto readFrame = readClip->nextFrame();
+            auto expectedFrame = expectedClip->nextFrame();
+            QVERIFY((bool)readFrame == (bool)expectedFrame);
+            if (!readFrame) {
+                break;
+            }
+            QVERIFY(readFrame->type == expectedFrame->type);
+            QVERIFY(readFrame->timeOffset == expectedFrame->timeOffset);
+            QVERIFY(readFrame->data == expectedFrame->data);
+        }
+    }
+}
+
 int main(int, const char**) {
     setupHifiApplication("Recording Test");
 
     testFrameTypeRegistration();
     testFilePersist();
     testClipOrdering();
+    testChunkedSeek();
+    testVersion1Clip();
 }
@@ -42,6 +42,7 @@
 
 #include "GLIHelpers.h"
 #include <shared/RateCounter.h>
+#include <shared/Storage.h>
 #include <AssetClient.h>
 #include <PathUtils.h>
 
@@ -236,6 +237,19 @@ public:
         for (const auto& p : sortedHighFrames) {
             qDebug() << "Long frame " << p.first << " " << p.second;
         }
+
+        // mip loads from KTX files should map them rather than copy them into memory
+        static uint64_t lastAllocations = 0;
+        static uint64_t lastAllocatedBytes = 0;
+        static uint64_t lastMappings = 0;
+        auto allocations = storage::getMemoryStorageAllocationCount();
+        auto allocatedBytes = storage::getMemoryStorageAllocatedBytes();
+        auto mappings = storage::getFileStorageMappingCount();
+        qDebug() << "Storage allocations " << allocations - lastAllocations << " (" << allocatedBytes - lastAllocatedBytes
+            << " bytes), file mappings " << mappings - lastMappings;
+        lastAllocations = allocations;
+        lastAllocatedBytes = allocatedBytes;
+        lastMappings = mappings;
     }
 
 
@@ -0,0 +1,135 @@
+//
+// ContentDefinedChunkerTests.cpp
+// tests/shared/src
+//
+// Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ContentDefinedChunkerTests.h"
+
+#include <random>
+
+#include <QtCore/QSet>
+
+#include <shared/ContentDefinedChunker.h>
+
+QTEST_MAIN(ContentDefinedChunkerTests)
+
+static QByteArray randomData(int size, unsigned int seed) {
+    std::mt19937 generator(seed);
+    QByteArray data;
+    data.resize(size);
+    for (int i = 0; i < size; ++i) {
+        data[i] = (char)(generator() & 0xff);
+    }
+    return data;
+}
+
+static QVector<QByteArray> split(const QByteArray& data, int blockSize) {
+    QVector<QByteArray> chunks;
+    ContentDefinedChunker chunker([&](const QByteArray& chunk) {
+        chunks.push_back(chunk);
+        return true;
+    });
+    for (int offset = 0; offset < data.size(); offset += blockSize) {
+        chunker.append(data.constData() + offset, std::min(blockSize, data.size() - offset));
+    }
+    chunker.finish();
+    return chunks;
+}
+
+void ContentDefinedChunkerTests::chunkSizesTest() {
+    const int SIZE = 8 * 1024 * 1024;
+    auto data = randomData(SIZE, 1);
+    auto chunks = split(data, SIZE);
+
+    QByteArray joined;
+    for (int i = 0; i < chunks.size(); ++i) {
+        QVERIFY(chunks[i].size() <= ContentDefinedChunker::MAX_CHUNK_SIZE);
+        if (i < chunks.size() - 1) {
+            QVERIFY(chunks[i].size() >= ContentDefinedChunker::MIN_CHUNK_SIZE);
+        }
+        joined.append(chunks[i]);
+    }
+    QCOMPARE(joined, data);
+
+    // the sizes gather around the average
+    int averageSize = SIZE / chunks.size();
+    QVERIFY(averageSize > ContentDefinedChunker::AVERAGE_CHUNK_SIZE / 2);
+    QVERIFY(averageSize < ContentDefinedChunker::AVERAGE_CHUNK_SIZE * 2);
+
+    // data with no boundaries is cut at the maximum, short data is a single chunk
+    auto zeros = split(QByteArray(ContentDefinedChunker::MAX_CHUNK_SIZE * 2 + 10, 0), SIZE);
+    QCOMPARE(zeros.size(), 3);
+    QCOMPARE(zeros[0].size(), (int)ContentDefinedChunker::MAX_CHUNK_SIZE);
+    QCOMPARE(zeros[2].size(), 10);
+    QCOMPARE(split(randomData(100, 2), SIZE).size(), 1);
+    QCOMPARE(split(QByteArray(), SIZE).size(), 0);
+}
+
+void ContentDefinedChunkerTests::blockSizeTest() {
+    // how the data is fed in doesn't change where it is cut
+    auto data = randomData(2 * 1024 * 1024 + 3, 3);
+    auto expected = split(data, data.size());
+    QCOMPARE(split(data, 1000), expected);
+    QCOMPARE(split(data, ContentDefinedChunker::MAX_CHUNK_SIZE), expected);
+    QCOMPARE(split(data, ContentDefinedChunker::MAX_CHUNK_SIZE + 1), expected);
+
+    // the chunker only ever holds on to one maximum size chunk of what it is given
+    int maxPending = 0;
+    int handed = 0;
+    int appended = 0;
+    ContentDefinedChunker chunker([&](const QByteArray& chunk) {
+        handed += chunk.size();
+        return true;
+    });
+    for (int offset = 0; offset < data.size(); offset += 100 * 1000) {
+        int size = std::min(100 * 1000, data.size() - offset);
+        chunker.append(data.constData() + offset, size);
+        appended += size;
+        maxPending = std::max(maxPending, appended - handed);
+    }
+    QVERIFY(maxPending < ContentDefinedChunker::MAX_CHUNK_SIZE);
+}
+
+void ContentDefinedChunkerTests::insertionTest() {
+    auto data = randomData(4 * 1024 * 1024, 4);
+    auto original = split(data, data.size());
+    QSet<QByteArray> originalChunks;
+    for (const auto& chunk : original) {
+        originalChunks.insert(chunk);
+    }
+
+    // inserting or removing bytes only changes the chunks around the edit
+    auto inserted = data;
+    inserted.insert(data.size() / 3, randomData(37, 5));
+    auto removed = data;
+    removed.remove(data.size() / 2, 1000);
+    for (const auto& edited : { inserted, removed }) {
+        int numChanged = 0;
+        for (const auto& chunk : split(edited, 64 * 1024)) {
+            if (!originalChunks.contains(chunk)) {
+                ++numChanged;
+            }
+        }
+        QVERIFY(numChanged <= 2);
+    }
+}
+
+void ContentDefinedChunkerTests::handlerFailureTest() {
+    int numChunks = 0;
+    ContentDefinedChunker chunker([&](const QByteArray&) {
+        return ++numChunks < 2;
+    });
+    auto data = randomData(2 * 1024 * 1024, 6);
+    QVERIFY(!chunker.append(data.constData(), data.size()));
+    QCOMPARE(numChunks, 2);
+
+    // what was left is dropped
+    numChunks = 0;
+    QVERIFY(chunker.finish());
+    QCOMPARE(numChunks, 0);
+}
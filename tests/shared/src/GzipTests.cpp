@@ -0,0 +1,81 @@
+//
+// GzipTests.cpp
+// tests/shared/src
+//
+// Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GzipTests.h"
+
+#include <random>
+
+#include <QtCore/QBuffer>
+
+#include <Gzip.h>
+
+QTEST_MAIN(GzipTests)
+
+// compressible, but not so much that it fits in a single block
+static QByteArray testData(int size) {
+    std::mt19937 generator(1);
+    QByteArray data;
+    data.resize(size);
+    for (int i = 0; i < size; ++i) {
+        data[i] = (char)('a' + generator() % 16);
+    }
+    return data;
+}
+
+static bool streamingGunzip(const QByteArray& compressed, QByteArray& data) {
+    QBuffer buffer;
+    buffer.setData(compressed);
+    buffer.open(QIODevice::ReadOnly);
+    data.clear();
+    return gunzip(buffer, [&](const char* block, int size) {
+        data.append(block, size);
+        return true;
+    });
+}
+
+void GzipTests::streamingGunzipTest() {
+    for (int size : { 1, 1000, 5 * 1024 * 1024 }) {
+        auto data = testData(size);
+        QByteArray compressed;
+        QVERIFY(gzip(data, compressed));
+
+        QByteArray streamed;
+        QVERIFY(streamingGunzip(compressed, streamed));
+        QCOMPARE(streamed, data);
+
+        QByteArray whole;
+        QVERIFY(gunzip(compressed, whole));
+        QCOMPARE(streamed, whole);
+    }
+}
+
+void GzipTests::truncatedGunzipTest() {
+    QByteArray compressed;
+    QVERIFY(gzip(testData(1024 * 1024), compressed));
+
+    QByteArray data;
+    QVERIFY(!streamingGunzip(compressed.left(compressed.size() / 2), data));
+    QVERIFY(!streamingGunzip(QByteArray(), data));
+    QVERIFY(!streamingGunzip(QByteArray("not gzip data"), data));
+}
+
+void GzipTests::sinkFailureTest() {
+    QByteArray compressed;
+    QVERIFY(gzip(testData(1024 * 1024), compressed));
+
+    QBuffer buffer;
+    buffer.setData(compressed);
+    buffer.open(QIODevice::ReadOnly);
+    int numBlocks = 0;
+    QVERIFY(!gunzip(buffer, [&](const char*, int) {
+        return ++numBlocks < 3;
+    }));
+    QCOMPARE(numBlocks, 3);
+}
@@ -9,6 +9,8 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+
 #include <QDataStream>
 #include <QTextStream>
 #include <QThread>
@@ -18,6 +20,7 @@
 
 #include <NetworkLogging.h>
 #include <NetworkingConstants.h>
+#include <NumericalConstants.h>
 #include <SharedLogging.h>
 #include <AddressManager.h>
 #include <DependencyManager.h>
@@ -57,6 +60,12 @@ ATPClientApp::ATPClientApp(int argc, char* argv[]) :
     const QCommandLineOption listenPortOption("listenPort", "listen port", QString::number(INVALID_PORT));
     parser.addOption(listenPortOption);
 
+    const QCommandLineOption repeatOption("n", "download the asset this many times, bypassing the local cache, and report throughput", "count");
+    parser.addOption(repeatOption);
+
+    const QCommandLineOption concurrencyOption("j", "number of downloads in flight when repeating", "8");
+    parser.addOption(concurrencyOption);
+
     if (!parser.parse(QCoreApplication::arguments())) {
         qCritical() << parser.errorText() << endl;
         parser.showHelp();
@@ -125,6 +134,14 @@ ATPClientApp::ATPClientApp(int argc, char* argv[]) :
         _listenPort = parser.value(listenPortOption).toInt();
     }
 
+    if (parser.isSet(repeatOption)) {
+        _downloadRepeat = parser.value(repeatOption).toInt();
+    }
+
+    if (parser.isSet(concurrencyOption)) {
+        _downloadConcurrency = std::max(parser.value(concurrencyOption).toInt(), 1);
+    }
+
     _domainServerAddress = QString("127.0.0.1") + ":" + QString::number(domainPort);
     if (parser.isSet(domainAddressOption)) {
         _domainServerAddress = parser.value(domainAddressOption);
@@ -197,7 +214,10 @@ ATPClientApp::ATPClientApp(int argc, char* argv[]) :
     }
 
     auto assetClient = DependencyManager::set<AssetClient>();
-    assetClient->initCaching();
+    if (_downloadRepeat == 0) {
+        // repeated downloads measure the server, so they must not be answered from the local cache
+        assetClient->initCaching();
+    }
 
     if (_verbose) {
         qDebug() << "domain-server address is" << _domainServerAddress;
@@ -205,7 +225,7 @@ ATPClientApp::ATPClientApp(int argc, char* argv[]) :
 
     DependencyManager::get<AddressManager>()->handleLookupString(_domainServerAddress, false);
 
-    QTimer* _timeoutTimer = new QTimer(this);
+    _timeoutTimer = new QTimer(this);
     _timeoutTimer->setSingleShot(true);
     connect(_timeoutTimer, &QTimer::timeout, this, &ATPClientApp::timedOut);
     _timeoutTimer->start(TIMEOUT_MILLISECONDS);
@@ -351,7 +371,11 @@ void ATPClientApp::lookupAsset() {
             qDebug() << "not found: " << request->getErrorString();
         } else if (result == GetMappingRequest::NoError) {
             qDebug() << "found, hash is " << request->getHash();
-            download(request->getHash());
+            if (_downloadRepeat > 0) {
+                benchmarkDownload(request->getHash());
+            } else {
+                download(request->getHash());
+            }
         } else {
             qDebug() << "error -- " << request->getError() << " -- " << request->getErrorString();
         }
@@ -390,6 +414,48 @@ void ATPClientApp::download(AssetUtils::AssetHash hash) {
     assetRequest->start();
 }
 
+void ATPClientApp::benchmarkDownload(AssetUtils::AssetHash hash) {
+    // the run can take longer than the usual timeout
+    _timeoutTimer->stop();
+
+    _downloadTimer.start();
+    int numToStart = std::min(_downloadConcurrency, _downloadRepeat);
+    for (int i = 0; i < numToStart; i++) {
+        startBenchmarkDownload(hash);
+    }
+}
+
+void ATPClientApp::startBenchmarkDownload(AssetUtils::AssetHash hash) {
+    ++_downloadsStarted;
+    auto assetRequest = new AssetRequest(hash);
+
+    connect(assetRequest, &AssetRequest::finished, this, [this, hash](AssetRequest* request) mutable {
+        Q_ASSERT(request->getState() == AssetRequest::Finished);
+
+        if (request->getError() == AssetRequest::Error::NoError) {
+            _bytesDownloaded += request->getData().size();
+        } else {
+            ++_downloadErrors;
+        }
+        request->deleteLater();
+        ++_downloadsFinished;
+
+        if (_downloadsStarted < _downloadRepeat) {
+            startBenchmarkDownload(hash);
+        } else if (_downloadsFinished == _downloadRepeat) {
+            const float BYTES_PER_MEGABYTE = 1024.0f * 1024.0f;
+            float seconds = (float)_downloadTimer.elapsed() / (float)MSECS_PER_SECOND;
+            float megabytes = (float)_bytesDownloaded / BYTES_PER_MEGABYTE;
+            qDebug() << "downloaded" << _downloadsFinished << "times with" << _downloadConcurrency << "in flight:"
+                << megabytes << "MB in" << seconds << "s =" << (megabytes / seconds) << "MB/s,"
+                << (_downloadsFinished / seconds) << "downloads/s," << _downloadErrors << "errors";
+            finish(_downloadErrors > 0 ? 1 : 0);
+        }
+    });
+
+    assetRequest->start();
+}
+
 void ATPClientApp::finish(int exitCode) {
     auto nodeList = DependencyManager::get<NodeList>();
 
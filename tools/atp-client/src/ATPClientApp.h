@@ -14,6 +14,7 @@
 #define hifi_ATPClientApp_h
 
 #include <QCoreApplication>
+#include <QElapsedTimer>
 #include <udt/Constants.h>
 #include <udt/Socket.h>
 #include <ReceivedMessage.h>
@@ -46,6 +47,8 @@ private:
     void lookupAsset();
     void listAssets();
     void download(AssetUtils::AssetHash hash);
+    void benchmarkDownload(AssetUtils::AssetHash hash);
+    void startBenchmarkDownload(AssetUtils::AssetHash hash);
     void finish(int exitCode);
     bool _verbose;
 
@@ -55,6 +58,15 @@ private:
 
     int _listenPort { INVALID_PORT };
 
+    // repeated downloads for measuring asset-server throughput
+    int _downloadRepeat { 0 };
+    int _downloadConcurrency { 8 };
+    int _downloadsStarted { 0 };
+    int _downloadsFinished { 0 };
+    int _downloadErrors { 0 };
+    qint64 _bytesDownloaded { 0 };
+    QElapsedTimer _downloadTimer;
+
     QString _domainServerAddress;
 
     QString _username;
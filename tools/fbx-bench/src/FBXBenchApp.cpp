@@ -0,0 +1,108 @@
+//
+//  FBXBenchApp.cpp
+//  tools/fbx-bench/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXBenchApp.h"
+
+#include <algorithm>
+#include <memory>
+
+#include <QBuffer>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+
+#include <FBXReader.h>
+
+FBXBenchApp::FBXBenchApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity FBX Loading Benchmark");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+    parser.addPositionalArgument("files", "FBX files to load", "model.fbx [...]");
+
+    const QCommandLineOption iterationsOption("n", "iterations per file (default 3)", "iterations", "3");
+    parser.addOption(iterationsOption);
+
+    const QCommandLineOption parallelOnlyOption("parallel-only", "skip the single threaded runs");
+    parser.addOption(parallelOnlyOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption) || parser.positionalArguments().isEmpty()) {
+        parser.showHelp();
+        return;
+    }
+
+    const int iterations = std::max(1, parser.value(iterationsOption).toInt());
+    const bool parallelOnly = parser.isSet(parallelOnlyOption);
+
+    // the node parse is serial, the mesh phases run on the workers, "other" is the scene graph, materials and skeleton
+    qInfo().noquote() << QString("%1 %2 %3 %4 %5 %6 %7 %8")
+        .arg("file", -24).arg("threads", -9).arg("meshes", 7).arg("nodes ms", 10).arg("extract ms", 11)
+        .arg("process ms", 11).arg("other ms", 10).arg("total ms", 10);
+
+    for (const auto& filename : parser.positionalArguments()) {
+        QFile file(filename);
+        if (!file.open(QIODevice::ReadOnly)) {
+            qCritical() << "Failed to open file " << filename;
+            _returnCode = 2;
+            continue;
+        }
+        const QByteArray content = file.readAll();
+        const QString name = QFileInfo(filename).fileName();
+
+        for (bool parallel : { false, true }) {
+            if (!parallel && parallelOnly) {
+                continue;
+            }
+            setParallelFBXMeshProcessingEnabled(parallel);
+
+            int numMeshes = 0;
+            qint64 nodeNSecs = 0;
+            qint64 geometryNSecs = 0;
+            quint64 extractionUsecs = 0;
+            quint64 processingUsecs = 0;
+            for (int i = 0; i < iterations; ++i) {
+                QBuffer buffer;
+                buffer.setData(content);
+                buffer.open(QIODevice::ReadOnly);
+
+                FBXReader reader;
+                QElapsedTimer timer;
+                timer.start();
+                reader._rootNode = FBXReader::parseFBX(&buffer);
+                nodeNSecs += timer.nsecsElapsed();
+
+                timer.restart();
+                std::unique_ptr<FBXGeometry> geometry(reader.extractFBXGeometry(QVariantHash(), filename));
+                geometryNSecs += timer.nsecsElapsed();
+                extractionUsecs += reader.getMeshExtractionUsecs();
+                processingUsecs += reader.getMeshProcessingUsecs();
+                numMeshes = geometry ? geometry->meshes.size() : 0;
+            }
+
+            double nodeMSecs = (double)nodeNSecs / 1.0e6 / iterations;
+            double geometryMSecs = (double)geometryNSecs / 1.0e6 / iterations;
+            double extractionMSecs = (double)extractionUsecs / 1.0e3 / iterations;
+            double processingMSecs = (double)processingUsecs / 1.0e3 / iterations;
+            double otherMSecs = std::max(0.0, geometryMSecs - extractionMSecs - processingMSecs);
+            qInfo().noquote() << QString("%1 %2 %3 %4 %5 %6 %7 %8")
+                .arg(name.left(24), -24).arg(parallel ? "parallel" : "single", -9).arg(numMeshes, 7)
+                .arg(nodeMSecs, 10, 'f', 1).arg(extractionMSecs, 11, 'f', 1).arg(processingMSecs, 11, 'f', 1)
+                .arg(otherMSecs, 10, 'f', 1).arg(nodeMSecs + geometryMSecs, 10, 'f', 1);
+        }
+    }
+}
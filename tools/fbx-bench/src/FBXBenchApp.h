@@ -0,0 +1,29 @@
+//
+//  FBXBenchApp.h
+//  tools/fbx-bench/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FBXBenchApp_h
+#define hifi_FBXBenchApp_h
+
+#include <QCoreApplication>
+
+// Loads FBX files the way ModelCache and the oven do, with and without parallel mesh processing, and reports
+// how long each phase of the load takes.
+class FBXBenchApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    FBXBenchApp(int argc, char* argv[]);
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    int _returnCode { 0 };
+};
+
+#endif // hifi_FBXBenchApp_h
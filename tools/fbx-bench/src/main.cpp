@@ -0,0 +1,20 @@
+//
+//  main.cpp
+//  tools/fbx-bench/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <SharedUtil.h>
+
+#include "FBXBenchApp.h"
+
+int main(int argc, char* argv[]) {
+    setupHifiApplication("FBX Bench");
+
+    FBXBenchApp app(argc, argv);
+    return app.getReturnCode();
+}
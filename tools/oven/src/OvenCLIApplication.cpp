@@ -12,6 +12,9 @@
 #include <QtCore/QCommandLineParser>
 #include <QtCore/QUrl>
 
+#include <ModelBaker.h>
+#include <TextureBaker.h>
+
 #include "BakerCLI.h"
 
 #include "OvenCLIApplication.h"
@@ -19,6 +22,9 @@
 static const QString CLI_INPUT_PARAMETER = "i";
 static const QString CLI_OUTPUT_PARAMETER = "o";
 static const QString CLI_TYPE_PARAMETER = "t";
+static const QString CLI_SUPERCOMPRESS_PARAMETER = "supercompress";
+static const QString CLI_NO_MESH_OPTIMIZATION_PARAMETER = "no-mesh-optimization";
+static const QString CLI_TEXTURE_CACHE_PARAMETER = "texture-cache";
 
 OvenCLIApplication::OvenCLIApplication(int argc, char* argv[]) :
     QCoreApplication(argc, argv)
@@ -29,12 +35,21 @@ OvenCLIApplication::OvenCLIApplication(int argc, char* argv[]) :
     parser.addOptions({
         { CLI_INPUT_PARAMETER, "Path to file that you would like to bake.", "input" },
         { CLI_OUTPUT_PARAMETER, "Path to folder that will be used as output.", "output" },
-        { CLI_TYPE_PARAMETER, "Type of asset.", "type" }
+        { CLI_TYPE_PARAMETER, "Type of asset.", "type" },
+        { CLI_SUPERCOMPRESS_PARAMETER, "Supercompress baked textures, older clients can't load them." },
+        { CLI_NO_MESH_OPTIMIZATION_PARAMETER, "Keep the triangle order of baked meshes, they stay smaller but render slower." },
+        { CLI_TEXTURE_CACHE_PARAMETER, "Folder of baked textures to reuse and add to.", "directory" }
     });
 
     parser.addHelpOption();
     parser.process(*this);
 
+    TextureBaker::setSupercompressionEnabled(parser.isSet(CLI_SUPERCOMPRESS_PARAMETER));
+    ModelBaker::setMeshOptimizationEnabled(!parser.isSet(CLI_NO_MESH_OPTIMIZATION_PARAMETER));
+    if (parser.isSet(CLI_TEXTURE_CACHE_PARAMETER)) {
+        TextureBaker::setBakedTextureCacheDirectory(parser.value(CLI_TEXTURE_CACHE_PARAMETER));
+    }
+
     if (parser.isSet(CLI_INPUT_PARAMETER) && parser.isSet(CLI_OUTPUT_PARAMETER)) {
         BakerCLI* cli = new BakerCLI(this);
         QUrl inputUrl(QDir::fromNativeSeparators(parser.value(CLI_INPUT_PARAMETER)));
@@ -0,0 +1,142 @@
+//
+//  TextureBenchApp.cpp
+//  tools/texture-bench/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureBenchApp.h"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+
+#include <image/Image.h>
+
+static QString formatName(const gpu::Element& format) {
+    static const std::vector<std::pair<gpu::Element, QString>> NAMES {
+        { gpu::Element::COLOR_COMPRESSED_BCX_SRGB, "BC1" },
+        { gpu::Element::COLOR_COMPRESSED_BCX_SRGBA_MASK, "BC1a" },
+        { gpu::Element::COLOR_COMPRESSED_BCX_SRGBA, "BC3" },
+        { gpu::Element::COLOR_COMPRESSED_BCX_RED, "BC4" },
+        { gpu::Element::COLOR_COMPRESSED_BCX_XY, "BC5" },
+        { gpu::Element::COLOR_COMPRESSED_BCX_HDR_RGB, "BC6H" },
+        { gpu::Element::COLOR_COMPRESSED_BCX_SRGBA_HIGH, "BC7" },
+        { gpu::Element::COLOR_SBGRA_32, "SBGRA8" },
+        { gpu::Element::COLOR_SRGBA_32, "SRGBA8" },
+        { gpu::Element::COLOR_BGRA_32, "BGRA8" },
+        { gpu::Element::COLOR_RGBA_32, "RGBA8" },
+        { gpu::Element::COLOR_R_8, "R8" },
+        { gpu::Element::VEC2NU8_XY, "RG8" },
+        { gpu::Element::COLOR_R11G11B10, "R11G11B10F" },
+        { gpu::Element::COLOR_RGB9E5, "RGB9E5" }
+    };
+    for (const auto& name : NAMES) {
+        if (name.first == format) {
+            return name.second;
+        }
+    }
+    return "other";
+}
+
+TextureBenchApp::TextureBenchApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity Texture Processing Benchmark");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption inputFilenameOption("i", "input image", "filename.png");
+    parser.addOption(inputFilenameOption);
+
+    const QCommandLineOption iterationsOption("n", "iterations per format (default 3)", "iterations", "3");
+    parser.addOption(iterationsOption);
+
+    const QCommandLineOption parallelOnlyOption("parallel-only", "skip the single threaded runs");
+    parser.addOption(parallelOnlyOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    QString inputFilename = parser.value(inputFilenameOption);
+    QFile file(inputFilename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Failed to open file " << inputFilename;
+        _returnCode = 2;
+        return;
+    }
+    const QByteArray content = file.readAll();
+    const int iterations = std::max(1, parser.value(iterationsOption).toInt());
+    const bool parallelOnly = parser.isSet(parallelOnlyOption);
+
+    struct Case {
+        QString name;
+        image::TextureUsage::Type type;
+        std::function<void(bool)> setCompressionEnabled;
+    };
+    const std::vector<Case> CASES {
+        { "color", image::TextureUsage::ALBEDO_TEXTURE, image::setColorTexturesCompressionEnabled },
+        { "normal", image::TextureUsage::NORMAL_TEXTURE, image::setNormalTexturesCompressionEnabled },
+        { "bump", image::TextureUsage::BUMP_TEXTURE, image::setNormalTexturesCompressionEnabled },
+        { "grayscale", image::TextureUsage::ROUGHNESS_TEXTURE, image::setGrayscaleTexturesCompressionEnabled },
+        { "cube", image::TextureUsage::CUBE_TEXTURE, image::setCubeTexturesCompressionEnabled }
+    };
+
+    qInfo().noquote() << QString("%1 %2 %3 %4 %5")
+        .arg("texture", -10).arg("format", -12).arg("threads", -9).arg("ms", 10).arg("MP/s", 10);
+
+    for (const auto& benchCase : CASES) {
+        for (bool compressed : { false, true }) {
+            benchCase.setCompressionEnabled(compressed);
+
+            for (bool parallel : { false, true }) {
+                if (!parallel && parallelOnly) {
+                    continue;
+                }
+                image::setParallelTextureProcessingEnabled(parallel);
+
+                QString format;
+                double megapixels = 0.0;
+                qint64 elapsedNSecs = 0;
+                for (int i = 0; i < iterations; ++i) {
+                    QByteArray data = content;
+                    QElapsedTimer timer;
+                    timer.start();
+                    auto texture = image::processImage(std::move(data), inputFilename.toStdString(),
+                                                       ABSOLUTE_MAX_TEXTURE_NUM_PIXELS, benchCase.type);
+                    elapsedNSecs += timer.nsecsElapsed();
+                    if (!texture) {
+                        break;
+                    }
+                    format = formatName(texture->getStoredMipFormat());
+                    megapixels = (double)texture->getWidth() * texture->getHeight() * texture->getNumFaces() / 1.0e6;
+                }
+
+                if (format.isEmpty()) {
+                    qInfo().noquote() << QString("%1 unsupported by this image").arg(benchCase.name, -10);
+                    break;
+                }
+
+                double seconds = (double)elapsedNSecs / 1.0e9 / iterations;
+                qInfo().noquote() << QString("%1 %2 %3 %4 %5")
+                    .arg(benchCase.name, -10).arg(format, -12).arg(parallel ? "parallel" : "single", -9)
+                    .arg(seconds * 1000.0, 10, 'f', 1).arg(megapixels / seconds, 10, 'f', 2);
+            }
+        }
+    }
+}
@@ -0,0 +1,29 @@
+//
+//  TextureBenchApp.h
+//  tools/texture-bench/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TextureBenchApp_h
+#define hifi_TextureBenchApp_h
+
+#include <QCoreApplication>
+
+// Runs an image through image::processImage for each texture type, compressed and not, with and
+// without parallel processing, and reports the throughput in megapixels per second for each format.
+class TextureBenchApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    TextureBenchApp(int argc, char* argv[]);
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    int _returnCode { 0 };
+};
+
+#endif // hifi_TextureBenchApp_h
@@ -0,0 +1,20 @@
+//
+//  main.cpp
+//  tools/texture-bench/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <SharedUtil.h>
+
+#include "TextureBenchApp.h"
+
+int main(int argc, char* argv[]) {
+    setupHifiApplication("Texture Bench");
+
+    TextureBenchApp app(argc, argv);
+    return app.getReturnCode();
+}